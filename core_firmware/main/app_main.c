@@ -1,25 +1,43 @@
 #include "app_main.h"
 
+#include <stdint.h>
+#include <stdlib.h>
+
 #include "esp_check.h"
 #include "esp_err.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "link/core_host_link.h"
+#include "link/core_link_publish.h"
 #include "nvs_flash.h"
 #include "sdkconfig.h"
 #include "state/core_state_manager.h"
 
 static const char *TAG = "simulrepile_core";
 
+static core_link_state_frame_t *s_publish_frame = NULL;
+static SemaphoreHandle_t s_publish_lock = NULL;
+static core_link_publish_scheduler_t s_publish_scheduler;
+static TaskHandle_t s_publish_task = NULL;
+
 static void handshake_task(void *ctx);
 static void state_update_task(void *ctx);
 static void state_publish_task(void *ctx);
 static void handle_display_ready(const core_host_display_info_t *info, void *ctx);
 static void handle_state_request(void *ctx);
-static void handle_touch_event(const core_link_touch_event_t *event, void *ctx);
+static void handle_touch_event(const core_link_touch_event_t *event, const core_host_display_info_t *display,
+                               void *ctx);
 static esp_err_t handle_command(core_link_command_opcode_t opcode, const char *argument, uint8_t *out_count, void *ctx);
-static void publish_snapshot(void);
+#if CONFIG_CORE_STATE_HISTORY
+static size_t handle_history_request(const core_link_history_request_t *request, uint8_t *out, size_t capacity,
+                                     void *ctx);
+#endif
+static void *alloc_state_frame(void);
+static void publish_snapshot(bool force);
 
 esp_err_t app_initialize(void)
 {
@@ -32,26 +50,65 @@ esp_err_t app_initialize(void)
 
     core_state_manager_init();
 
+    s_publish_frame = alloc_state_frame();
+    ESP_RETURN_ON_FALSE(s_publish_frame, ESP_ERR_NO_MEM, TAG, "state frame alloc failed");
+    core_link_state_frame_init(s_publish_frame, CORE_LINK_MAX_TERRARIUMS);
+    core_link_state_frame_t *published = alloc_state_frame();
+    ESP_RETURN_ON_FALSE(published, ESP_ERR_NO_MEM, TAG, "published frame alloc failed");
+    const core_link_publish_policy_t policy = {
+        .deadband = CORE_LINK_PUBLISH_DEADBANDS_DEFAULT,
+        .min_interval_ms = CONFIG_CORE_APP_STATE_PUBLISH_MIN_INTERVAL_MS,
+        .max_interval_ms = CONFIG_CORE_APP_STATE_PUBLISH_MAX_INTERVAL_MS,
+        .alert_health_below_pct = CONFIG_CORE_APP_ALERT_HEALTH_PCT,
+        .alert_hydration_below_pct = CONFIG_CORE_APP_ALERT_HYDRATION_PCT,
+        .alert_stress_above_pct = CONFIG_CORE_APP_ALERT_STRESS_PCT,
+    };
+    core_link_publish_init(&s_publish_scheduler, &policy, published, CORE_LINK_MAX_TERRARIUMS);
+    s_publish_lock = xSemaphoreCreateMutex();
+    ESP_RETURN_ON_FALSE(s_publish_lock, ESP_ERR_NO_MEM, TAG, "publish lock alloc failed");
+
     core_host_link_config_t link_cfg = {
         .uart_port = CONFIG_CORE_APP_LINK_UART_PORT,
         .tx_gpio = CONFIG_CORE_APP_LINK_UART_TX_PIN,
         .rx_gpio = CONFIG_CORE_APP_LINK_UART_RX_PIN,
         .baud_rate = CONFIG_CORE_APP_LINK_UART_BAUD,
+#if CONFIG_CORE_APP_LINK_BAUD_AUTO
+        .baud_rate_max = CONFIG_CORE_APP_LINK_UART_BAUD_MAX,
+#endif
         .task_stack_size = 4096,
         .task_priority = 6,
         .handshake_timeout_ticks = pdMS_TO_TICKS(CONFIG_CORE_APP_HANDSHAKE_TIMEOUT_MS),
     };
 
     ESP_ERROR_CHECK(core_host_link_init(&link_cfg));
+#if CONFIG_CORE_APP_LINK_DISPLAY_COUNT >= 2
+    const core_host_display_config_t display2_cfg = {
+        .uart_port = CONFIG_CORE_APP_LINK_DISPLAY2_UART_PORT,
+        .tx_gpio = CONFIG_CORE_APP_LINK_DISPLAY2_UART_TX_PIN,
+        .rx_gpio = CONFIG_CORE_APP_LINK_DISPLAY2_UART_RX_PIN,
+    };
+    ESP_ERROR_CHECK(core_host_link_add_display(&display2_cfg));
+#endif
+#if CONFIG_CORE_APP_LINK_DISPLAY_COUNT >= 3
+    const core_host_display_config_t display3_cfg = {
+        .uart_port = CONFIG_CORE_APP_LINK_DISPLAY3_UART_PORT,
+        .tx_gpio = CONFIG_CORE_APP_LINK_DISPLAY3_UART_TX_PIN,
+        .rx_gpio = CONFIG_CORE_APP_LINK_DISPLAY3_UART_RX_PIN,
+    };
+    ESP_ERROR_CHECK(core_host_link_add_display(&display3_cfg));
+#endif
     ESP_ERROR_CHECK(core_host_link_register_display_ready_cb(handle_display_ready, NULL));
     ESP_ERROR_CHECK(core_host_link_register_request_cb(handle_state_request, NULL));
     ESP_ERROR_CHECK(core_host_link_register_touch_cb(handle_touch_event, NULL));
     ESP_ERROR_CHECK(core_host_link_register_command_cb(handle_command, NULL));
+#if CONFIG_CORE_STATE_HISTORY
+    ESP_ERROR_CHECK(core_host_link_register_history_cb(handle_history_request, NULL));
+#endif
     ESP_ERROR_CHECK(core_host_link_start());
 
     xTaskCreatePinnedToCore(handshake_task, "core_handshake", 3072, NULL, 7, NULL, 0);
+    xTaskCreatePinnedToCore(state_publish_task, "core_state_publish", 4096, NULL, 5, &s_publish_task, 1);
     xTaskCreatePinnedToCore(state_update_task, "core_state_update", 4096, NULL, 5, NULL, 1);
-    xTaskCreatePinnedToCore(state_publish_task, "core_state_publish", 4096, NULL, 5, NULL, 1);
 
     ESP_LOGI(TAG, "Core firmware initialized");
     return ESP_OK;
@@ -62,40 +119,72 @@ void app_main(void)
     ESP_ERROR_CHECK(app_initialize());
 }
 
+// HELLO goes through the TX queues: a backlog behind a streaming display only
+// delays it to the next pass.
+static void send_hello_or_log(void)
+{
+    esp_err_t err = core_host_link_send_hello();
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "HELLO not sent (%s), retrying", esp_err_to_name(err));
+    }
+}
+
 static void handshake_task(void *ctx)
 {
     (void)ctx;
     while (!core_host_link_is_handshake_complete()) {
-        ESP_ERROR_CHECK(core_host_link_send_hello());
+        send_hello_or_log();
         vTaskDelay(pdMS_TO_TICKS(CONFIG_CORE_APP_HANDSHAKE_RETRY_MS));
     }
     ESP_LOGI(TAG, "Handshake complete (peer protocol v%u)", core_host_link_get_peer_version());
     if (core_host_link_wait_for_display_ready(pdMS_TO_TICKS(CONFIG_CORE_APP_HANDSHAKE_TIMEOUT_MS)) != ESP_OK) {
         ESP_LOGW(TAG, "Display ready timeout");
     }
-    publish_snapshot();
+    publish_snapshot(true);
+    // Displays powered up later still answer HELLO; their DISPLAY_READY triggers a publication.
+    while (core_host_link_is_handshake_pending()) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_CORE_APP_HANDSHAKE_RETRY_MS));
+        send_hello_or_log();
+    }
     vTaskDelete(NULL);
 }
 
 static void state_update_task(void *ctx)
 {
     (void)ctx;
-    const TickType_t period = pdMS_TO_TICKS(100);
+    const TickType_t period = pdMS_TO_TICKS(CONFIG_CORE_APP_STATE_STEP_MS);
+    const int64_t max_catchup_us = (int64_t)CONFIG_CORE_APP_STATE_MAX_CATCHUP_MS * 1000;
+    TickType_t wake = xTaskGetTickCount();
+    int64_t last_us = esp_timer_get_time();
     while (true) {
-        core_state_manager_update(0.1f);
-        vTaskDelay(period);
+        vTaskDelayUntil(&wake, period);
+        // The real time elapsed drives the fixed-step model: a late wake-up runs
+        // the missed steps now instead of dropping them.
+        int64_t now_us = esp_timer_get_time();
+        int64_t elapsed_us = now_us - last_us;
+        last_us = now_us;
+        if (elapsed_us > max_catchup_us) {
+            ESP_LOGW(TAG, "State update stalled for %lld ms, catching up %d ms only", (long long)(elapsed_us / 1000),
+                     CONFIG_CORE_APP_STATE_MAX_CATCHUP_MS);
+            elapsed_us = max_catchup_us;
+        }
+        if (core_state_manager_advance((double)elapsed_us / 1000000.0) > 0) {
+            // Every simulation step is a chance for a significant change.
+            xTaskNotifyGive(s_publish_task);
+        }
     }
 }
 
 static void state_publish_task(void *ctx)
 {
     (void)ctx;
-    const TickType_t period = pdMS_TO_TICKS(CONFIG_CORE_APP_STATE_PUBLISH_INTERVAL_MS);
+    // Woken after each state update; the timeout only matters if updates stall.
+    const TickType_t max_wait = pdMS_TO_TICKS(CONFIG_CORE_APP_STATE_PUBLISH_MAX_INTERVAL_MS);
     while (true) {
+        ulTaskNotifyTake(pdTRUE, max_wait);
         if (core_host_link_is_display_ready()) {
-            publish_snapshot();
+            publish_snapshot(false);
         }
-        vTaskDelay(period);
     }
 }
 
@@ -105,19 +194,20 @@ static void handle_display_ready(const core_host_display_info_t *info, void *ctx
     if (info) {
         ESP_LOGI(TAG, "Display ready at %ux%u (protocol v%u)", info->width, info->height, info->protocol_version);
     }
-    publish_snapshot();
+    publish_snapshot(true);
 }
 
 static void handle_state_request(void *ctx)
 {
     (void)ctx;
-    publish_snapshot();
+    publish_snapshot(true);
 }
 
-static void handle_touch_event(const core_link_touch_event_t *event, void *ctx)
+static void handle_touch_event(const core_link_touch_event_t *event, const core_host_display_info_t *display,
+                               void *ctx)
 {
     (void)ctx;
-    core_state_manager_apply_touch(event);
+    core_state_manager_apply_touch(event, display->width);
 }
 
 static esp_err_t handle_command(core_link_command_opcode_t opcode, const char *argument, uint8_t *out_count, void *ctx)
@@ -128,29 +218,79 @@ static esp_err_t handle_command(core_link_command_opcode_t opcode, const char *a
     switch (opcode) {
         case CORE_LINK_CMD_RELOAD_PROFILES: {
             const char *path = (argument && argument[0] != '\0') ? argument : NULL;
-            status = core_state_manager_reload_profiles(path);
-            if (status == ESP_OK || status == ESP_ERR_NOT_FOUND) {
-                publish_snapshot();
+            core_state_reload_changes_t changes;
+            status = core_state_manager_reload_profiles_diff(path, &changes);
+            // Surviving terrariums keep their state and IDs: the displays' baselines
+            // still match and only the changed fields go out as a delta.
+            if ((status == ESP_OK || status == ESP_ERR_NOT_FOUND) &&
+                (changes.added || changes.removed || changes.modified)) {
+                publish_snapshot(true);
             }
             break;
         }
+        case CORE_LINK_CMD_FEED_TERRARIUM: {
+            char *end = NULL;
+            unsigned long id = argument ? strtoul(argument, &end, 10) : 0;
+            if (!argument || end == argument || *end != '\0' || id > UINT8_MAX) {
+                status = ESP_ERR_INVALID_ARG;
+                break;
+            }
+            status = core_state_manager_feed((uint8_t)id);
+            break;
+        }
         default:
             ESP_LOGW(TAG, "Unhandled command opcode 0x%02X", opcode);
             break;
     }
 
     if (out_count) {
-        *out_count = (uint8_t)core_state_manager_get_terrarium_count();
+        size_t count = core_state_manager_get_terrarium_count();
+        *out_count = (uint8_t)(count > CORE_LINK_MAX_TERRARIUMS ? CORE_LINK_MAX_TERRARIUMS : count);
     }
 
     return status;
 }
 
-static void publish_snapshot(void)
+#if CONFIG_CORE_STATE_HISTORY
+static size_t handle_history_request(const core_link_history_request_t *request, uint8_t *out, size_t capacity,
+                                     void *ctx)
+{
+    (void)ctx;
+    return core_state_manager_read_history(request, out, capacity);
+}
+#endif
+
+static void *alloc_state_frame(void)
 {
-    core_link_state_frame_t frame = {0};
-    core_state_manager_build_frame(&frame);
-    esp_err_t err = core_host_link_send_state(&frame);
+    // Sized for the link maximum so more terrariums never need a larger buffer.
+    size_t frame_size = CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS);
+    void *frame = heap_caps_calloc(1, frame_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!frame) {
+        frame = heap_caps_calloc(1, frame_size, MALLOC_CAP_8BIT);
+    }
+    return frame;
+}
+
+static void publish_snapshot(bool force)
+{
+    // Called from the publish task and from link callbacks; they share one frame.
+    xSemaphoreTake(s_publish_lock, portMAX_DELAY);
+    core_state_manager_build_frame(s_publish_frame);
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    core_link_publish_reason_t reason = force ? CORE_LINK_PUBLISH_FORCED
+                                              : core_link_publish_evaluate(&s_publish_scheduler, s_publish_frame, now_ms);
+    esp_err_t err = ESP_OK;
+    if (reason != CORE_LINK_PUBLISH_NONE) {
+        err = core_host_link_send_state(s_publish_frame);
+        if (err == ESP_OK) {
+            core_link_publish_mark_published(&s_publish_scheduler, s_publish_frame, now_ms);
+        }
+    }
+    xSemaphoreGive(s_publish_lock);
+
+    if (reason == CORE_LINK_PUBLISH_ALERT) {
+        ESP_LOGI(TAG, "Alert threshold crossed, state published immediately");
+    }
     if (err != ESP_OK) {
         ESP_LOGW(TAG, "Failed to send state frame: %s", esp_err_to_name(err));
     }
@@ -1,40 +1,91 @@
 #include "link/core_host_link.h"
 
-#include <math.h>
+#include <stddef.h>
 #include <string.h>
 
-#include "driver/uart.h"
+#include "compression_if.h"
 #include "esp_check.h"
 #include "esp_err.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/event_groups.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "freertos/timers.h"
+#include "link/core_link_baseline.h"
+#include "link/core_link_baud.h"
+#include "link/core_link_compact.h"
+#include "link/core_link_fields.h"
+#include "link/core_link_fragment.h"
+#include "link/core_link_history.h"
+#include "link/core_link_name_table.h"
+#include "link/core_link_stats.h"
+#include "link/core_link_stream.h"
+#include "link/core_link_subscription.h"
+#include "link/core_link_touch.h"
+#include "link/core_link_transport.h"
+#ifdef ESP_PLATFORM
+#include "link/core_link_transport_uart.h"
+#endif
+#include "link/core_link_tx_queue.h"
 #include "sdkconfig.h"
 
-#define CORE_LINK_SOF 0xA5
-#define CORE_LINK_MAX_PAYLOAD 512
-#define CORE_HOST_EVENT_HANDSHAKE BIT0
-#define CORE_HOST_EVENT_DISPLAY_READY BIT1
+#define CORE_HOST_MAX_DISPLAYS CONFIG_CORE_APP_LINK_DISPLAY_COUNT
+// Two bits per display in one event group.
+#define CORE_HOST_EVENT_HANDSHAKE(index) (BIT0 << (2U * (index)))
+#define CORE_HOST_EVENT_DISPLAY_READY(index) (BIT1 << (2U * (index)))
+#define CORE_HOST_RX_RING_SIZE 2048
+#define CORE_HOST_RX_STALL_MS 50U
+// Deep enough to replay every fragment of a full 64-terrarium transfer.
+#define CORE_HOST_RETX_HISTORY 24
+// Holds a full fragmented transfer plus its NAME_TABLE chunks without blocking.
+#define CORE_HOST_TX_SLOTS 32
+#define CORE_HOST_TX_TASK_STACK 3072
+#define CORE_HOST_TX_ENQUEUE_TIMEOUT_TICKS pdMS_TO_TICKS(200)
+#define CORE_HOST_LINK_CAPABILITIES \
+    (CORE_LINK_CAP_HOST | CORE_LINK_CAP_FRAME_V2 | CORE_LINK_CAP_COMPACT_STATE | CORE_LINK_CAP_FRAGMENTS | \
+     CORE_LINK_CAP_NAME_TABLE | CORE_LINK_CAP_LINK_STATS | CORE_LINK_CAP_TOUCH_BATCH)
+#if CONFIG_CORE_APP_LINK_FULL_COMPRESSED
+#define CORE_HOST_LINK_CAPABILITIES_EXT \
+    (CORE_LINK_CAP_EXT_SAMPLE_TIME | CORE_LINK_CAP_EXT_FULL_COMPRESSED | CORE_LINK_CAP_EXT_REQUEST_ID | \
+     CORE_LINK_CAP_EXT_SUBSCRIBE)
+#else
+#define CORE_HOST_LINK_CAPABILITIES_EXT \
+    (CORE_LINK_CAP_EXT_SAMPLE_TIME | CORE_LINK_CAP_EXT_REQUEST_ID | CORE_LINK_CAP_EXT_SUBSCRIBE)
+#endif
 
 #define CORE_HOST_WATCHDOG_PERIOD_MS 250
 #define CORE_HOST_WATCHDOG_PERIOD_TICKS pdMS_TO_TICKS(CORE_HOST_WATCHDOG_PERIOD_MS)
 #define CORE_HOST_STATE_TIMEOUT_TICKS pdMS_TO_TICKS(CONFIG_CORE_APP_LINK_STATE_TIMEOUT_MS)
 #define CORE_HOST_PING_TIMEOUT_TICKS pdMS_TO_TICKS(CONFIG_CORE_APP_LINK_PING_TIMEOUT_MS)
+#define CORE_HOST_STATS_PERIOD_TICKS pdMS_TO_TICKS(CONFIG_CORE_APP_LINK_STATS_INTERVAL_MS)
+#define CORE_HOST_BAUD_WINDOW_TICKS pdMS_TO_TICKS(CONFIG_CORE_APP_LINK_BAUD_WINDOW_MS)
+#define CORE_HOST_BAUD_SWITCH_TIMEOUT_TICKS pdMS_TO_TICKS(CORE_LINK_BAUD_SWITCH_TIMEOUT_MS)
+// A skipped publication still rearms the publisher's keepalive, so the display can wait
+// this long plus CORE_APP_STATE_PUBLISH_MAX_INTERVAL_MS: keep the sum under its watchdog.
+#define CORE_HOST_SUBSCRIBE_MAX_INTERVAL_MS (CONFIG_CORE_APP_STATE_PUBLISH_MAX_INTERVAL_MS / 2)
+
+// What an encoded state payload depends on besides the publication itself.
+#define CORE_HOST_ENCODE_COMPACT 0x01U
+#define CORE_HOST_ENCODE_NAME_TABLE 0x02U
+#define CORE_HOST_ENCODE_SAMPLE_TIME 0x04U
 
 static const char *TAG = "core_host_link";
 
 typedef struct __attribute__((packed)) {
-    uint8_t sof;
-    uint8_t type;
-    uint16_t length;
-} core_link_frame_header_t;
+    uint8_t protocol_version;
+    uint8_t capabilities;
+    uint8_t capabilities_ext;
+    uint16_t baud_mask; /* avec CORE_LINK_CAP_EXT_BAUD_SWITCH */
+} core_link_hello_ack_payload_t;
 
 typedef struct __attribute__((packed)) {
     uint8_t protocol_version;
     uint8_t capabilities;
-} core_link_hello_ack_payload_t;
+    uint8_t capabilities_ext;
+    uint16_t baud_mask;
+} core_link_hello_payload_t;
 
 typedef struct __attribute__((packed)) {
     uint16_t width;
@@ -42,49 +93,108 @@ typedef struct __attribute__((packed)) {
     uint8_t protocol_version;
 } core_link_display_ready_payload_t;
 
-typedef struct __attribute__((packed)) {
-    uint32_t epoch_seconds;
-    uint8_t terrarium_count;
-} core_link_state_header_wire_t;
-
-typedef struct __attribute__((packed)) {
-    uint8_t terrarium_id;
-    char scientific_name[CORE_LINK_NAME_MAX_LEN + 1];
-    char common_name[CORE_LINK_NAME_MAX_LEN + 1];
-    float temp_day_c;
-    float temp_night_c;
-    float humidity_day_pct;
-    float humidity_night_pct;
-    float lux_day;
-    float lux_night;
-    float hydration_pct;
-    float stress_pct;
-    float health_pct;
-    uint32_t last_feeding_timestamp;
-    float activity_score;
-} core_link_snapshot_wire_t;
-
-typedef struct __attribute__((packed)) {
-    uint32_t epoch_seconds;
+typedef struct {
+    bool used;
+    uint8_t type;
+    uint16_t seq;
+    uint16_t length;
+    uint8_t payload[CORE_LINK_MAX_PAYLOAD];
+} core_host_retx_entry_t;
+
+// Identifies the payload last encoded into a shared buffer, so displays with the same
+// capabilities (and, for deltas, the same baseline) reuse it within one publication.
+typedef struct {
+    bool valid;
+    uint32_t publication;
+    uint32_t baseline; /* publication the display's baseline copies; deltas only */
+    uint8_t flags;     /* CORE_HOST_ENCODE_* */
     uint8_t terrarium_count;
-    uint8_t changed_count;
-} core_link_state_delta_header_wire_t;
-
-typedef struct __attribute__((packed)) {
-    uint8_t terrarium_id;
-    core_link_delta_field_mask_t field_mask;
-} core_link_state_delta_entry_wire_t;
+    core_link_msg_type_t type;
+    size_t length;
+    bool any_change;
+} core_host_encoded_t;
+
+// Everything one display owns: its UART and tasks, handshake, delta baseline,
+// subscription and baud negotiation. Baselines, resync flags and the negotiated
+// state encoding sit under s_state_lock.
+typedef struct {
+    uint8_t index;
+    core_link_transport_t transport;
+#ifdef ESP_PLATFORM
+    core_link_uart_transport_t uart_transport;
+#endif
+    TaskHandle_t rx_task;
+    TaskHandle_t tx_task;
+    uint8_t peer_version;
+    core_host_display_info_t display_info;
+    TickType_t last_activity_tick;
+    TickType_t last_ping_tick;
+    TickType_t last_stats_tick;
+    bool ping_in_flight;
+    bool display_alive;
+    bool watchdog_triggered;
+    core_link_state_frame_t *last_sent_state;
+    core_link_state_frame_t *tx_state;
+    uint32_t baseline_publication; /* 0 : baseline filtered by a subscription */
+    uint8_t fragment_transfer_id;
+    bool clamp_warned;
+    bool last_state_valid;
+    bool force_next_full;
+    bool refresh_due;
+    uint32_t delta_since_full;
+    uint32_t last_full_epoch;
+    bool supports_delta;
+    bool frame_v2;
+    bool compact_state;
+    bool fragments;
+    bool names_valid;
+    bool name_table;
+    bool name_table_valid;
+    uint8_t names_sent;
+    bool link_stats;
+    bool touch_batch;
+    bool sample_time;
+    bool full_compressed;
+    bool request_id;
+    core_link_subscription_t subscription;
+    TickType_t subscription_interval_ticks;
+    TickType_t last_state_sent_tick;
+    core_link_baseline_t full_baseline;
+    bool full_plain_next;
+    uint16_t tx_seq;
+    SemaphoreHandle_t retx_lock;
+    core_host_retx_entry_t *retx_history;
+    size_t retx_next;
+    core_link_tx_queue_t tx_queue;
+    SemaphoreHandle_t tx_free;
+    core_link_stats_t stats;
+    // Baud negotiation: the policy runs in the watchdog timer, the ACK lands in the RX task.
+    core_link_baud_policy_t baud;
+    bool baud_enabled;
+    bool baud_switch;
+    SemaphoreHandle_t transport_lock;
+    uint32_t link_baud;
+    volatile uint32_t baud_switch_bps;
+    bool baud_probe_active;
+    uint8_t baud_probe_index;
+    TickType_t baud_probe_tick;
+    TickType_t baud_window_tick;
+    uint32_t baud_window_errors;
+    bool baud_pong_pending;
+    // HISTORY_CHUNK being built; RX task only.
+    uint8_t history_chunk[CORE_LINK_MAX_PAYLOAD];
+    uint8_t rx_storage[CORE_LINK_STREAM_STORAGE_SIZE(CORE_HOST_RX_RING_SIZE)];
+} core_host_peer_t;
 
-#define CORE_HOST_DELTA_FLOAT_EPSILON (0.0005f)
 #define CORE_HOST_MAX_DELTAS_BEFORE_FULL 20U
-#define CORE_HOST_FULL_REFRESH_SECONDS 30U
+// Publications are change-driven: keep the periodic rebase under the display's
+// 12 s STATE_FULL watchdog even when few deltas go out.
+#define CORE_HOST_FULL_REFRESH_SECONDS 10U
 
 static core_host_link_config_t s_config;
 static bool s_initialized = false;
 static bool s_started = false;
-static uint8_t s_peer_version = 0;
 static EventGroupHandle_t s_events = NULL;
-static TaskHandle_t s_rx_task = NULL;
 static core_host_display_ready_cb_t s_display_cb = NULL;
 static void *s_display_ctx = NULL;
 static core_host_request_state_cb_t s_request_cb = NULL;
@@ -93,34 +203,87 @@ static core_host_touch_cb_t s_touch_cb = NULL;
 static void *s_touch_ctx = NULL;
 static core_host_command_cb_t s_command_cb = NULL;
 static void *s_command_ctx = NULL;
-static core_host_display_info_t s_display_info = {0};
+static core_host_history_cb_t s_history_cb = NULL;
+static void *s_history_ctx = NULL;
 static TimerHandle_t s_watchdog_timer = NULL;
-static TickType_t s_last_activity_tick = 0;
-static TickType_t s_last_ping_tick = 0;
-static bool s_ping_in_flight = false;
-static bool s_display_alive = false;
-static bool s_watchdog_triggered = false;
-static core_link_state_frame_t s_last_sent_state = {0};
-static bool s_last_state_valid = false;
-static bool s_force_next_full = true;
-static uint32_t s_delta_since_full = 0;
-static uint32_t s_last_full_epoch = 0;
-static bool s_peer_supports_delta = false;
-
-static uint8_t checksum_compute(uint8_t type, uint16_t length, const uint8_t *payload);
-static esp_err_t uart_send_frame(core_link_msg_type_t type, const void *payload, uint16_t length);
+static core_host_peer_t s_peers[CORE_HOST_MAX_DISPLAYS];
+static size_t s_peer_count = 0;
+// One spinlock for every display: the sections it covers are a few pointer moves.
+static portMUX_TYPE s_tx_queue_lock = portMUX_INITIALIZER_UNLOCKED;
+static portMUX_TYPE s_baud_lock = portMUX_INITIALIZER_UNLOCKED;
+// Shared by all displays and guarded by s_state_lock: each publication is copied and
+// its names interned once, then encoded per display only where their baselines differ.
+static SemaphoreHandle_t s_state_lock = NULL;
+static core_link_state_frame_t *s_publish_state = NULL;
+static uint32_t s_publication = 0;
+static uint8_t *s_state_payload = NULL;
+static uint8_t *s_full_payload = NULL;
+static uint8_t *s_full_diff = NULL;
+static uint8_t s_fragment_payload[CORE_LINK_MAX_PAYLOAD];
+static core_host_encoded_t s_delta_encoded;
+static core_host_encoded_t s_full_encoded;
+static core_link_name_table_t *s_name_table = NULL;
+
+static esp_err_t open_display(core_host_peer_t *peer, const core_host_display_config_t *config);
+static esp_err_t send_frame(core_host_peer_t *peer, core_link_msg_type_t type, const void *payload, uint16_t length);
+static esp_err_t send_frame_seq(core_host_peer_t *peer, core_link_msg_type_t type, uint16_t seq, const void *payload,
+                                uint16_t length, core_link_tx_priority_t priority);
+static esp_err_t tx_enqueue(core_host_peer_t *peer, core_link_msg_type_t type, bool frame_v2, uint16_t seq,
+                            const void *payload, uint16_t length, core_link_tx_priority_t priority);
+static void tx_task(void *arg);
+static esp_err_t send_sequenced_frame(core_host_peer_t *peer, core_link_msg_type_t type, const void *payload,
+                                      uint16_t length);
+static void reset_retransmit_history(core_host_peer_t *peer, bool frame_v2);
+static void handle_nak(core_host_peer_t *peer, const uint8_t *payload, uint16_t length);
 static void rx_task(void *arg);
-static void handle_frame(core_link_msg_type_t type, const uint8_t *payload, uint16_t length);
-static void update_display_alive(bool alive);
+static void handle_frame(core_host_peer_t *peer, core_link_msg_type_t type, const uint8_t *payload, uint16_t length);
+static bool peer_is_ready(const core_host_peer_t *peer);
+static bool peer_has_handshake(const core_host_peer_t *peer);
+static esp_err_t send_hello(core_host_peer_t *peer);
+static esp_err_t send_ping(core_host_peer_t *peer);
+static void update_display_alive(core_host_peer_t *peer, bool alive);
 static void watchdog_timer_cb(TimerHandle_t timer);
-static esp_err_t send_state_full(const core_link_state_frame_t *frame);
-static esp_err_t send_state_delta(const core_link_state_frame_t *frame, bool *out_any_change);
-static const core_link_terrarium_snapshot_t *find_previous_snapshot(uint8_t terrarium_id);
-static void store_last_state(const core_link_state_frame_t *frame);
-static void schedule_full_frame(void);
-static bool ensure_baseline_compatible(const core_link_state_frame_t *frame);
-static bool float_field_changed(float a, float b);
+static void watchdog_peer(core_host_peer_t *peer, TickType_t now);
+static void publish_link_stats(core_host_peer_t *peer);
+static void *alloc_link_buffer(size_t size);
+static esp_err_t prepare_publication(const core_link_state_frame_t *frame);
+static esp_err_t send_state_locked(core_host_peer_t *peer);
+static esp_err_t send_state_payload(core_host_peer_t *peer, core_link_msg_type_t type, const uint8_t *payload,
+                                    size_t length);
+static esp_err_t send_state_full(core_host_peer_t *peer, const core_link_state_frame_t *frame);
+static esp_err_t encode_state_full(const core_host_peer_t *peer, const core_link_state_frame_t *frame,
+                                   size_t *out_length);
+static esp_err_t encode_state_full_compact(const core_host_peer_t *peer, const core_link_state_frame_t *frame,
+                                           size_t *out_length);
+static esp_err_t send_full_payload(core_host_peer_t *peer, core_link_msg_type_t type, const uint8_t *payload,
+                                   size_t length);
+static esp_err_t send_state_delta(core_host_peer_t *peer, const core_link_state_frame_t *frame, bool filtered,
+                                  bool refresh, bool *out_any_change);
+static uint8_t encode_flags(const core_host_peer_t *peer);
+static bool encoded_matches(const core_host_encoded_t *encoded, const core_host_encoded_t *key);
+static const core_link_terrarium_snapshot_t *find_previous_snapshot(const core_host_peer_t *peer,
+                                                                    uint8_t terrarium_id);
+static void store_last_state(core_host_peer_t *peer, bool filtered);
+static void schedule_full_frame_locked(core_host_peer_t *peer, bool names);
+static void schedule_full_frame(core_host_peer_t *peer);
+static void schedule_full_frame_with_names(core_host_peer_t *peer);
+static esp_err_t sync_name_table(core_host_peer_t *peer);
+static bool intern_frame_names(core_link_state_frame_t *frame);
+static void reset_name_table(void);
+static core_link_delta_field_mask_t name_fields(const core_host_peer_t *peer, core_link_delta_field_mask_t mask);
+static bool ensure_baseline_compatible(const core_host_peer_t *peer, const core_link_state_frame_t *frame);
 static bool string_field_changed(const char *a, const char *b);
+static uint8_t local_capabilities_ext(const core_host_peer_t *peer);
+static void set_peer_baud(core_host_peer_t *peer, uint16_t peer_mask);
+static void apply_link_baud(core_host_peer_t *peer, uint32_t bits_per_second);
+static void baud_tick(core_host_peer_t *peer, TickType_t now);
+static void baud_fall_back(core_host_peer_t *peer);
+static void handle_baud_switch_ack(core_host_peer_t *peer, const uint8_t *payload, uint16_t length);
+static bool apply_subscription(const core_host_peer_t *peer, core_link_state_frame_t *frame);
+static void set_subscription(core_host_peer_t *peer, const core_link_subscription_t *sub);
+static void reset_subscription(core_host_peer_t *peer);
+static void handle_subscribe(core_host_peer_t *peer, const uint8_t *payload, uint16_t length);
+static void handle_history_request(core_host_peer_t *peer, const uint8_t *payload, uint16_t length);
 
 esp_err_t core_host_link_init(const core_host_link_config_t *config)
 {
@@ -137,43 +300,181 @@ esp_err_t core_host_link_init(const core_host_link_config_t *config)
         s_config.task_priority = 5;
     }
 
-    uart_config_t uart_cfg = {
-        .baud_rate = s_config.baud_rate,
-        .data_bits = UART_DATA_8_BITS,
-        .parity = UART_PARITY_DISABLE,
-        .stop_bits = UART_STOP_BITS_1,
-        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
-        .source_clk = UART_SCLK_REF_TICK,
-    };
-
-    ESP_RETURN_ON_ERROR(uart_driver_install(s_config.uart_port, CORE_LINK_MAX_PAYLOAD * 2, 0, 0, NULL, 0), TAG, "uart_driver_install failed");
-    ESP_RETURN_ON_ERROR(uart_param_config(s_config.uart_port, &uart_cfg), TAG, "uart_param_config failed");
-    ESP_RETURN_ON_ERROR(uart_set_pin(s_config.uart_port, s_config.tx_gpio, s_config.rx_gpio, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE), TAG, "uart_set_pin failed");
-
     if (!s_events) {
         s_events = xEventGroupCreate();
         ESP_RETURN_ON_FALSE(s_events, ESP_ERR_NO_MEM, TAG, "event group alloc failed");
     }
 
+    if (!s_state_lock) {
+        s_state_lock = xSemaphoreCreateMutex();
+        ESP_RETURN_ON_FALSE(s_state_lock, ESP_ERR_NO_MEM, TAG, "state lock alloc failed");
+    }
+
+    // State buffers scale with CORE_LINK_MAX_TERRARIUMS and live in PSRAM when available.
+    if (!s_publish_state) {
+        s_publish_state = alloc_link_buffer(CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS));
+        ESP_RETURN_ON_FALSE(s_publish_state, ESP_ERR_NO_MEM, TAG, "state frame alloc failed");
+        core_link_state_frame_init(s_publish_state, CORE_LINK_MAX_TERRARIUMS);
+    }
+    if (!s_state_payload) {
+        s_state_payload = alloc_link_buffer(CORE_LINK_STATE_BUFFER_SIZE);
+        ESP_RETURN_ON_FALSE(s_state_payload, ESP_ERR_NO_MEM, TAG, "state payload alloc failed");
+    }
+    if (!s_full_payload) {
+        s_full_payload = alloc_link_buffer(CORE_LINK_STATE_BUFFER_SIZE);
+        ESP_RETURN_ON_FALSE(s_full_payload, ESP_ERR_NO_MEM, TAG, "full payload alloc failed");
+    }
+    if (!s_full_diff) {
+        s_full_diff = alloc_link_buffer(CORE_LINK_STATE_BUFFER_SIZE);
+        ESP_RETURN_ON_FALSE(s_full_diff, ESP_ERR_NO_MEM, TAG, "full diff alloc failed");
+    }
+    if (!s_name_table) {
+        s_name_table = alloc_link_buffer(sizeof(*s_name_table));
+        ESP_RETURN_ON_FALSE(s_name_table, ESP_ERR_NO_MEM, TAG, "name table alloc failed");
+        core_link_name_table_reset(s_name_table, 1);
+    }
+
     if (!s_watchdog_timer) {
         s_watchdog_timer = xTimerCreate("core_host_wd", CORE_HOST_WATCHDOG_PERIOD_TICKS, pdTRUE, NULL, watchdog_timer_cb);
         ESP_RETURN_ON_FALSE(s_watchdog_timer, ESP_ERR_NO_MEM, TAG, "watchdog timer alloc failed");
     }
 
-    TickType_t now = xTaskGetTickCount();
-    s_last_activity_tick = now;
-    s_last_ping_tick = now;
-    s_ping_in_flight = false;
-    s_display_alive = false;
-    s_watchdog_triggered = false;
-    s_last_state_valid = false;
-    s_force_next_full = true;
-    s_delta_since_full = 0;
-    s_last_full_epoch = 0;
-    s_peer_supports_delta = false;
+    s_publication = 0;
+    s_delta_encoded.valid = false;
+    s_full_encoded.valid = false;
+
+    core_host_display_config_t display_cfg = {
+        .uart_port = s_config.uart_port,
+        .tx_gpio = s_config.tx_gpio,
+        .rx_gpio = s_config.rx_gpio,
+        .transport = s_config.transport,
+    };
+    ESP_RETURN_ON_ERROR(open_display(&s_peers[0], &display_cfg), TAG, "display 0 init failed");
+    s_peer_count = 1;
 
     s_initialized = true;
-    ESP_LOGI(TAG, "UART host ready on port %d (TX=%d RX=%d @ %d bps)", s_config.uart_port, s_config.tx_gpio, s_config.rx_gpio, s_config.baud_rate);
+    return ESP_OK;
+}
+
+esp_err_t core_host_link_add_display(const core_host_display_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(config, ESP_ERR_INVALID_ARG, TAG, "config is null");
+    ESP_RETURN_ON_FALSE(s_initialized, ESP_ERR_INVALID_STATE, TAG, "core_host_link_init not called");
+    ESP_RETURN_ON_FALSE(!s_started, ESP_ERR_INVALID_STATE, TAG, "displays must be added before core_host_link_start");
+    ESP_RETURN_ON_FALSE(s_peer_count < CORE_HOST_MAX_DISPLAYS, ESP_ERR_INVALID_SIZE, TAG,
+                        "CONFIG_CORE_APP_LINK_DISPLAY_COUNT (%d) displays already open", CORE_HOST_MAX_DISPLAYS);
+
+    core_host_peer_t *peer = &s_peers[s_peer_count];
+    ESP_RETURN_ON_ERROR(open_display(peer, config), TAG, "display %u init failed", (unsigned)s_peer_count);
+    s_peer_count++;
+    return ESP_OK;
+}
+
+static esp_err_t open_display(core_host_peer_t *peer, const core_host_display_config_t *config)
+{
+    // A failed attempt may have left its allocations behind: reuse them on retry.
+    peer->index = (uint8_t)(peer - s_peers);
+    if (config->transport) {
+        peer->transport = *config->transport;
+    } else {
+#ifdef ESP_PLATFORM
+        core_link_uart_transport_config_t uart_cfg = {
+            .uart_port = config->uart_port,
+            .tx_gpio = config->tx_gpio,
+            .rx_gpio = config->rx_gpio,
+            .baud_rate = s_config.baud_rate,
+            .rx_buffer_size = CORE_LINK_MAX_PAYLOAD * 2,
+        };
+        ESP_RETURN_ON_ERROR(core_link_transport_uart_open(&peer->transport, &peer->uart_transport, &uart_cfg), TAG,
+                            "UART transport init failed");
+#else
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_ARG, TAG, "no transport configured");
+#endif
+    }
+
+    if (!peer->transport_lock) {
+        peer->transport_lock = xSemaphoreCreateMutex();
+        ESP_RETURN_ON_FALSE(peer->transport_lock, ESP_ERR_NO_MEM, TAG, "transport lock alloc failed");
+    }
+
+    if (!peer->retx_lock) {
+        peer->retx_lock = xSemaphoreCreateMutex();
+        ESP_RETURN_ON_FALSE(peer->retx_lock, ESP_ERR_NO_MEM, TAG, "retransmit lock alloc failed");
+    }
+
+    if (!peer->tx_free) {
+        core_link_tx_slot_t *slots = alloc_link_buffer(CORE_HOST_TX_SLOTS * sizeof(core_link_tx_slot_t));
+        ESP_RETURN_ON_FALSE(slots, ESP_ERR_NO_MEM, TAG, "tx queue alloc failed");
+        core_link_tx_queue_init(&peer->tx_queue, slots, CORE_HOST_TX_SLOTS);
+        peer->tx_free = xSemaphoreCreateCounting(CORE_HOST_TX_SLOTS, CORE_HOST_TX_SLOTS);
+        ESP_RETURN_ON_FALSE(peer->tx_free, ESP_ERR_NO_MEM, TAG, "tx semaphore alloc failed");
+    }
+
+    if (!peer->retx_history) {
+        peer->retx_history = alloc_link_buffer(CORE_HOST_RETX_HISTORY * sizeof(core_host_retx_entry_t));
+        ESP_RETURN_ON_FALSE(peer->retx_history, ESP_ERR_NO_MEM, TAG, "retransmit history alloc failed");
+    }
+    if (!peer->last_sent_state) {
+        peer->last_sent_state = alloc_link_buffer(CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS));
+        ESP_RETURN_ON_FALSE(peer->last_sent_state, ESP_ERR_NO_MEM, TAG, "state baseline alloc failed");
+        core_link_state_frame_init(peer->last_sent_state, CORE_LINK_MAX_TERRARIUMS);
+    }
+    if (!peer->tx_state) {
+        peer->tx_state = alloc_link_buffer(CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS));
+        ESP_RETURN_ON_FALSE(peer->tx_state, ESP_ERR_NO_MEM, TAG, "state frame alloc failed");
+        core_link_state_frame_init(peer->tx_state, CORE_LINK_MAX_TERRARIUMS);
+    }
+    if (!peer->full_baseline.buffer) {
+        uint8_t *baseline = alloc_link_buffer(CORE_LINK_STATE_BUFFER_SIZE);
+        ESP_RETURN_ON_FALSE(baseline, ESP_ERR_NO_MEM, TAG, "full baseline alloc failed");
+        core_link_baseline_init(&peer->full_baseline, baseline, CORE_LINK_STATE_BUFFER_SIZE);
+    }
+
+    TickType_t now = xTaskGetTickCount();
+    peer->last_activity_tick = now;
+    peer->last_ping_tick = now;
+    peer->ping_in_flight = false;
+    peer->display_alive = false;
+    peer->watchdog_triggered = false;
+    peer->last_state_valid = false;
+    peer->baseline_publication = 0;
+    peer->force_next_full = true;
+    peer->refresh_due = false;
+    peer->delta_since_full = 0;
+    peer->last_full_epoch = 0;
+    peer->supports_delta = false;
+    peer->compact_state = false;
+    peer->fragments = false;
+    peer->names_valid = false;
+    peer->name_table = false;
+    peer->name_table_valid = false;
+    peer->link_stats = false;
+    peer->touch_batch = false;
+    peer->sample_time = false;
+    peer->full_compressed = false;
+    peer->request_id = false;
+    core_link_subscription_all(&peer->subscription);
+    peer->subscription_interval_ticks = 0;
+    peer->full_plain_next = true;
+    peer->last_stats_tick = now;
+    core_link_stats_reset(&peer->stats);
+    peer->link_baud = (uint32_t)s_config.baud_rate;
+    core_link_stats_set(&peer->stats, CORE_LINK_STAT_BAUD_RATE, peer->link_baud);
+    // Negotiation needs a table rate to fall back to and a transport able to switch.
+    peer->baud_enabled = s_config.baud_rate_max > s_config.baud_rate && peer->transport.ops->set_baud &&
+                         core_link_baud_policy_init(&peer->baud, (uint32_t)s_config.baud_rate,
+                                                    (uint32_t)s_config.baud_rate_max,
+                                                    CONFIG_CORE_APP_LINK_BAUD_ERROR_THRESHOLD);
+    if (s_config.baud_rate_max > s_config.baud_rate && !peer->baud_enabled) {
+        ESP_LOGW(TAG, "Baud negotiation disabled: %d bps is not a standard rate or the transport is fixed",
+                 s_config.baud_rate);
+    }
+    peer->baud_switch = false;
+    peer->baud_probe_active = false;
+    reset_retransmit_history(peer, false);
+
+    ESP_LOGI(TAG, "Display %u: UART host ready on port %d (TX=%d RX=%d @ %d bps)", peer->index, config->uart_port,
+             config->tx_gpio, config->rx_gpio, s_config.baud_rate);
     return ESP_OK;
 }
 
@@ -184,8 +485,19 @@ esp_err_t core_host_link_start(void)
         return ESP_OK;
     }
 
-    BaseType_t task_ok = xTaskCreatePinnedToCore(rx_task, "core_host_link_rx", s_config.task_stack_size, NULL, s_config.task_priority, &s_rx_task, 0);
-    ESP_RETURN_ON_FALSE(task_ok == pdPASS, ESP_ERR_NO_MEM, TAG, "rx task creation failed");
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        core_host_peer_t *peer = &s_peers[i];
+        if (!peer->tx_task) {
+            BaseType_t tx_ok = xTaskCreatePinnedToCore(tx_task, "core_host_link_tx", CORE_HOST_TX_TASK_STACK, peer,
+                                                       s_config.task_priority, &peer->tx_task, 0);
+            ESP_RETURN_ON_FALSE(tx_ok == pdPASS, ESP_ERR_NO_MEM, TAG, "tx task creation failed");
+        }
+        if (!peer->rx_task) {
+            BaseType_t task_ok = xTaskCreatePinnedToCore(rx_task, "core_host_link_rx", s_config.task_stack_size, peer,
+                                                         s_config.task_priority, &peer->rx_task, 0);
+            ESP_RETURN_ON_FALSE(task_ok == pdPASS, ESP_ERR_NO_MEM, TAG, "rx task creation failed");
+        }
+    }
     if (s_watchdog_timer && !xTimerIsTimerActive(s_watchdog_timer)) {
         ESP_RETURN_ON_FALSE(xTimerStart(s_watchdog_timer, 0) == pdPASS, ESP_FAIL, TAG, "watchdog timer start failed");
     }
@@ -193,82 +505,355 @@ esp_err_t core_host_link_start(void)
     return ESP_OK;
 }
 
+static esp_err_t send_hello(core_host_peer_t *peer)
+{
+    // Older displays only read the version byte and ignore the capabilities.
+    core_link_hello_payload_t payload = {
+        .protocol_version = CORE_LINK_PROTOCOL_VERSION,
+        .capabilities = CORE_HOST_LINK_CAPABILITIES,
+        .capabilities_ext = local_capabilities_ext(peer),
+        .baud_mask = peer->baud_enabled ? peer->baud.local_mask : 0,
+    };
+    return send_frame(peer, CORE_LINK_MSG_HELLO, &payload, sizeof(payload));
+}
+
 esp_err_t core_host_link_send_hello(void)
 {
-    uint8_t payload = CORE_LINK_PROTOCOL_VERSION;
-    return uart_send_frame(CORE_LINK_MSG_HELLO, &payload, sizeof(payload));
+    esp_err_t result = ESP_OK;
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        if (peer_has_handshake(&s_peers[i])) {
+            continue;
+        }
+        esp_err_t err = send_hello(&s_peers[i]);
+        if (result == ESP_OK) {
+            result = err;
+        }
+    }
+    return result;
 }
 
 esp_err_t core_host_link_send_state(const core_link_state_frame_t *frame)
 {
     ESP_RETURN_ON_FALSE(frame, ESP_ERR_INVALID_ARG, TAG, "frame null");
+    ESP_RETURN_ON_FALSE(s_initialized, ESP_ERR_INVALID_STATE, TAG, "core_host_link_init not called");
     ESP_RETURN_ON_FALSE(core_host_link_is_display_ready(), ESP_ERR_INVALID_STATE, TAG, "display not ready");
 
-    core_link_state_frame_t sanitized = {0};
+    // Publications come from several tasks and share the baselines and payload buffers.
+    xSemaphoreTake(s_state_lock, portMAX_DELAY);
+    esp_err_t result = prepare_publication(frame);
+    if (result == ESP_OK) {
+        // A display that fails keeps its baseline and catches up on the next publication;
+        // the caller only sees an error when none of them took this one.
+        result = ESP_ERR_INVALID_STATE;
+        for (size_t i = 0; i < s_peer_count; ++i) {
+            core_host_peer_t *peer = &s_peers[i];
+            if (!peer_is_ready(peer)) {
+                continue;
+            }
+            esp_err_t err = send_state_locked(peer);
+            if (err == ESP_OK || result != ESP_OK) {
+                result = err;
+            }
+        }
+    }
+    xSemaphoreGive(s_state_lock);
+    return result;
+}
+
+static void *alloc_link_buffer(size_t size)
+{
+    void *buffer = heap_caps_calloc(1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!buffer) {
+        buffer = heap_caps_calloc(1, size, MALLOC_CAP_8BIT);
+    }
+    return buffer;
+}
+
+static esp_err_t prepare_publication(const core_link_state_frame_t *frame)
+{
+    core_link_state_frame_t *next = s_publish_state;
     uint8_t count = frame->terrarium_count;
     if (count > CORE_LINK_MAX_TERRARIUMS) {
-        ESP_LOGW(TAG, "Clamping terrarium count from %u to %u", count, CORE_LINK_MAX_TERRARIUMS);
         count = CORE_LINK_MAX_TERRARIUMS;
     }
+    next->epoch_seconds = frame->epoch_seconds;
+    next->sample_us = frame->sample_us;
+    next->terrarium_count = count;
+    memcpy(next->terrariums, frame->terrariums, (size_t)count * sizeof(next->terrariums[0]));
+
+    // 0 marks a baseline that no longer matches any publication.
+    if (++s_publication == 0) {
+        s_publication = 1;
+    }
+    s_delta_encoded.valid = false;
+    s_full_encoded.valid = false;
 
-    sanitized.epoch_seconds = frame->epoch_seconds;
-    sanitized.terrarium_count = count;
-    for (uint8_t i = 0; i < count; ++i) {
-        sanitized.terrariums[i] = frame->terrariums[i];
+    bool names = false;
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        names = names || (peer_is_ready(&s_peers[i]) && s_peers[i].name_table);
+    }
+    if (names && !intern_frame_names(next)) {
+        // Names left over from earlier frames (species renamed by a profile
+        // reload, say) filled the table: start a new generation holding only
+        // the live ones.
+        reset_name_table();
+        if (!intern_frame_names(next)) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t send_state_locked(core_host_peer_t *peer)
+{
+    // The display asked for a slower cadence: resyncs and scheduled refreshes still go out.
+    TickType_t now = xTaskGetTickCount();
+    if (peer->subscription_interval_ticks > 0 && peer->last_state_valid && !peer->force_next_full &&
+        !peer->refresh_due && now - peer->last_state_sent_tick < peer->subscription_interval_ticks) {
+        return ESP_OK;
+    }
+
+    uint8_t limit = peer->fragments ? CORE_LINK_MAX_TERRARIUMS : CORE_LINK_LEGACY_MAX_TERRARIUMS;
+    uint8_t count = s_publish_state->terrarium_count;
+    if (count > limit) {
+        if (!peer->clamp_warned) {
+            ESP_LOGW(TAG, "Display %u: clamping terrarium count from %u to %u%s", peer->index, count, limit,
+                     peer->fragments ? "" : " (peer lacks STATE_FRAGMENT)");
+            peer->clamp_warned = true;
+        }
+        count = limit;
     }
 
-    bool require_full = s_force_next_full || !s_last_state_valid || !s_peer_supports_delta;
+    core_link_state_frame_t *next = peer->tx_state;
+    next->epoch_seconds = s_publish_state->epoch_seconds;
+    next->sample_us = s_publish_state->sample_us;
+    next->terrarium_count = count;
+    memcpy(next->terrariums, s_publish_state->terrariums, (size_t)count * sizeof(next->terrariums[0]));
+
+    if (peer->name_table) {
+        esp_err_t names_err = sync_name_table(peer);
+        if (names_err != ESP_OK) {
+            return names_err;
+        }
+    }
+
+    // Resyncs (force_next_full) always get the whole frame. The periodic refresh only
+    // does under the default subscription: otherwise it is a delta resending every
+    // subscribed field, and nothing the display left out of its view.
+    bool narrowed = !core_link_subscription_is_all(&peer->subscription);
+    bool require_full = peer->force_next_full || !peer->last_state_valid || !peer->supports_delta ||
+                        (peer->refresh_due && !narrowed);
     if (!require_full) {
-        require_full = !ensure_baseline_compatible(&sanitized);
+        require_full = !ensure_baseline_compatible(peer, next);
     }
 
     esp_err_t err = ESP_FAIL;
     if (!require_full) {
         bool any_change = false;
-        err = send_state_delta(&sanitized, &any_change);
+        bool refresh = peer->refresh_due;
+        bool filtered = apply_subscription(peer, next);
+        err = send_state_delta(peer, next, filtered, refresh, &any_change);
         if (err == ESP_OK) {
-            store_last_state(&sanitized);
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_STATE_DELTA, 1);
+            store_last_state(peer, filtered);
+            peer->last_state_sent_tick = now;
+            if (refresh) {
+                peer->refresh_due = false;
+                peer->last_full_epoch = next->epoch_seconds;
+                peer->delta_since_full = 0;
+                return ESP_OK;
+            }
             if (any_change) {
-                s_delta_since_full++;
-                if (s_delta_since_full >= CORE_HOST_MAX_DELTAS_BEFORE_FULL) {
-                    s_force_next_full = true;
-                    s_delta_since_full = 0;
+                peer->delta_since_full++;
+                if (peer->delta_since_full >= CORE_HOST_MAX_DELTAS_BEFORE_FULL) {
+                    peer->refresh_due = true;
+                    peer->delta_since_full = 0;
                 }
             }
-            if (s_last_full_epoch != 0 && sanitized.epoch_seconds >= s_last_full_epoch) {
-                uint32_t elapsed = sanitized.epoch_seconds - s_last_full_epoch;
+            if (peer->last_full_epoch != 0 && next->epoch_seconds >= peer->last_full_epoch) {
+                uint32_t elapsed = next->epoch_seconds - peer->last_full_epoch;
                 if (elapsed >= CORE_HOST_FULL_REFRESH_SECONDS) {
-                    s_force_next_full = true;
+                    peer->refresh_due = true;
                 }
-            } else if (s_last_full_epoch != 0) {
-                s_force_next_full = true;
+            } else if (peer->last_full_epoch != 0) {
+                peer->refresh_due = true;
             }
             return ESP_OK;
         }
 
-        ESP_LOGW(TAG, "STATE_DELTA encode failed (%s), falling back to STATE_FULL", esp_err_to_name(err));
+        ESP_LOGW(TAG, "Display %u: STATE_DELTA encode failed (%s), falling back to STATE_FULL", peer->index,
+                 esp_err_to_name(err));
         require_full = true;
     }
 
     if (require_full) {
-        err = send_state_full(&sanitized);
+        err = send_state_full(peer, next);
+        if (err == ESP_OK) {
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_STATE_FULL, 1);
+            store_last_state(peer, false);
+            peer->last_state_sent_tick = now;
+            peer->last_full_epoch = next->epoch_seconds;
+            peer->delta_since_full = 0;
+            peer->force_next_full = false;
+            peer->refresh_due = false;
+        }
+    }
+
+    return err;
+}
+
+static uint8_t encode_flags(const core_host_peer_t *peer)
+{
+    return (uint8_t)((peer->compact_state ? CORE_HOST_ENCODE_COMPACT : 0U) |
+                     (peer->name_table ? CORE_HOST_ENCODE_NAME_TABLE : 0U) |
+                     (peer->sample_time ? CORE_HOST_ENCODE_SAMPLE_TIME : 0U));
+}
+
+static bool encoded_matches(const core_host_encoded_t *encoded, const core_host_encoded_t *key)
+{
+    return encoded->valid && encoded->publication == key->publication && encoded->baseline == key->baseline &&
+           encoded->flags == key->flags && encoded->terrarium_count == key->terrarium_count &&
+           encoded->type == key->type;
+}
+
+// The state buffers are sized for the trailer on top of CORE_LINK_STATE_MAX_PAYLOAD.
+static size_t append_sample_time(const core_host_peer_t *peer, uint8_t *buffer, size_t length,
+                                 const core_link_state_frame_t *frame)
+{
+    if (!peer->sample_time) {
+        return length;
+    }
+    core_link_put_le64(buffer + length, (uint64_t)frame->sample_us);
+    return length + CORE_LINK_SAMPLE_TIME_SIZE;
+}
+
+static esp_err_t send_state_payload(core_host_peer_t *peer, core_link_msg_type_t type, const uint8_t *payload,
+                                    size_t length)
+{
+    if (length <= CORE_LINK_MAX_PAYLOAD) {
+        return send_sequenced_frame(peer, type, payload, (uint16_t)length);
+    }
+    if (!peer->fragments) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    size_t count = core_link_fragment_count(length);
+    if (count == 0) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // Each fragment takes its own sequence number, so a lost one is replayed by NAK
+    // like any other state frame.
+    uint8_t transfer_id = ++peer->fragment_transfer_id;
+    for (size_t i = 0; i < count; ++i) {
+        size_t written = core_link_fragment_build(s_fragment_payload, sizeof(s_fragment_payload), (uint8_t)type,
+                                                  transfer_id, payload, length, (uint8_t)i);
+        if (written == 0) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        esp_err_t err = send_sequenced_frame(peer, CORE_LINK_MSG_STATE_FRAGMENT, s_fragment_payload, (uint16_t)written);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+// Periodic refreshes go out XORed against the previous STATE_FULL payload, which the
+// display keeps byte for byte; anything it may not hold forces a plain frame.
+static esp_err_t send_full_payload(core_host_peer_t *peer, core_link_msg_type_t type, const uint8_t *payload,
+                                   size_t length)
+{
+    if (!peer->full_compressed) {
+        return send_state_payload(peer, type, payload, length);
+    }
+
+    bool compress = !peer->full_plain_next && peer->full_baseline.valid;
+    peer->full_plain_next = false;
+    core_link_full_compressed_header_t header = {
+        .inner_type = (uint8_t)type,
+        .codec = COMPRESSION_CODEC_RLE,
+        .baseline_crc = peer->full_baseline.crc,
+        .length = (uint16_t)length,
+    };
+    if (compress) {
+        memcpy(s_full_diff, payload, length);
+        core_link_baseline_xor(&peer->full_baseline, s_full_diff, length);
+    }
+    if (!core_link_baseline_store(&peer->full_baseline, payload, length)) {
+        return send_state_payload(peer, type, payload, length);
+    }
+    header.crc = peer->full_baseline.crc;
+
+    // `payload` is the shared s_full_payload: the compressed frame goes to s_state_payload,
+    // which then no longer holds the delta other displays might have reused.
+    size_t produced = 0;
+    if (compress && length > CORE_LINK_FULL_COMPRESSED_HEADER_SIZE) {
+        s_delta_encoded.valid = false;
+    }
+    if (compress && length > CORE_LINK_FULL_COMPRESSED_HEADER_SIZE &&
+        compression_if_compress(COMPRESSION_CODEC_RLE, s_full_diff, length,
+                                s_state_payload + CORE_LINK_FULL_COMPRESSED_HEADER_SIZE,
+                                length - CORE_LINK_FULL_COMPRESSED_HEADER_SIZE - 1U, &produced) == ESP_OK) {
+        core_link_full_compressed_header_write(s_state_payload, &header);
+        size_t compressed = CORE_LINK_FULL_COMPRESSED_HEADER_SIZE + produced;
+        esp_err_t err = send_state_payload(peer, CORE_LINK_MSG_STATE_FULL_COMPRESSED, s_state_payload, compressed);
         if (err == ESP_OK) {
-            store_last_state(&sanitized);
-            s_last_full_epoch = sanitized.epoch_seconds;
-            s_delta_since_full = 0;
-            s_force_next_full = false;
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_FULL_COMPRESSED, 1);
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_FULL_BYTES_SAVED, (uint32_t)(length - compressed));
+        } else {
+            core_link_baseline_reset(&peer->full_baseline);
         }
+        return err;
     }
 
+    // No gain (or nothing to diff against): the plain payload goes out as is.
+    esp_err_t err = send_state_payload(peer, type, payload, length);
+    if (err != ESP_OK) {
+        core_link_baseline_reset(&peer->full_baseline);
+    }
     return err;
 }
 
-static esp_err_t send_state_full(const core_link_state_frame_t *frame)
+static esp_err_t send_state_full(core_host_peer_t *peer, const core_link_state_frame_t *frame)
 {
     if (!frame) {
         return ESP_ERR_INVALID_ARG;
     }
 
+    // A full frame only depends on the publication and the capabilities, except compact
+    // frames that leave out names this display already holds.
+    core_host_encoded_t key = {
+        .valid = true,
+        .publication = s_publication,
+        .flags = encode_flags(peer),
+        .terrarium_count = frame->terrarium_count,
+        .type = peer->compact_state ? CORE_LINK_MSG_STATE_FULL_COMPACT : CORE_LINK_MSG_STATE_FULL,
+    };
+    bool shareable = !peer->compact_state || peer->name_table || !peer->names_valid;
+    if (!shareable || !encoded_matches(&s_full_encoded, &key)) {
+        s_full_encoded.valid = false;
+        size_t length = 0;
+        esp_err_t err = peer->compact_state ? encode_state_full_compact(peer, frame, &length)
+                                            : encode_state_full(peer, frame, &length);
+        if (err != ESP_OK) {
+            return err;
+        }
+        key.length = length;
+        key.valid = shareable;
+        s_full_encoded = key;
+    }
+
+    esp_err_t err = send_full_payload(peer, key.type, s_full_payload, s_full_encoded.length);
+    if (err == ESP_OK && peer->compact_state) {
+        peer->names_valid = true;
+    }
+    return err;
+}
+
+static esp_err_t encode_state_full(const core_host_peer_t *peer, const core_link_state_frame_t *frame,
+                                   size_t *out_length)
+{
     uint8_t count = frame->terrarium_count;
     core_link_state_header_wire_t header = {
         .epoch_seconds = frame->epoch_seconds,
@@ -276,41 +861,71 @@ static esp_err_t send_state_full(const core_link_state_frame_t *frame)
     };
 
     size_t payload_size = sizeof(header) + count * sizeof(core_link_snapshot_wire_t);
-    if (payload_size > CORE_LINK_MAX_PAYLOAD) {
+    if (payload_size > CORE_LINK_STATE_MAX_PAYLOAD) {
         return ESP_ERR_INVALID_SIZE;
     }
 
-    uint8_t buffer[CORE_LINK_MAX_PAYLOAD];
+    uint8_t *buffer = s_full_payload;
     memcpy(buffer, &header, sizeof(header));
     uint8_t *cursor = buffer + sizeof(header);
 
     for (uint8_t i = 0; i < count; ++i) {
+        core_link_fields_to_wire((core_link_snapshot_wire_t *)cursor, &frame->terrariums[i]);
+        cursor += sizeof(core_link_snapshot_wire_t);
+    }
+
+    *out_length = append_sample_time(peer, buffer, payload_size, frame);
+    return ESP_OK;
+}
+
+static esp_err_t encode_state_full_compact(const core_host_peer_t *peer, const core_link_state_frame_t *frame,
+                                           size_t *out_length)
+{
+    uint8_t *buffer = s_full_payload;
+    core_link_state_header_wire_t header = {
+        .epoch_seconds = frame->epoch_seconds,
+        .terrarium_count = frame->terrarium_count,
+    };
+    memcpy(buffer, &header, sizeof(header));
+    size_t offset = sizeof(header);
+
+    for (uint8_t i = 0; i < frame->terrarium_count; ++i) {
         const core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
-        core_link_snapshot_wire_t wire = {0};
-        wire.terrarium_id = snap->terrarium_id;
-        strncpy(wire.scientific_name, snap->scientific_name, CORE_LINK_NAME_MAX_LEN);
-        wire.scientific_name[CORE_LINK_NAME_MAX_LEN] = '\0';
-        strncpy(wire.common_name, snap->common_name, CORE_LINK_NAME_MAX_LEN);
-        wire.common_name[CORE_LINK_NAME_MAX_LEN] = '\0';
-        wire.temp_day_c = snap->temp_day_c;
-        wire.temp_night_c = snap->temp_night_c;
-        wire.humidity_day_pct = snap->humidity_day_pct;
-        wire.humidity_night_pct = snap->humidity_night_pct;
-        wire.lux_day = snap->lux_day;
-        wire.lux_night = snap->lux_night;
-        wire.hydration_pct = snap->hydration_pct;
-        wire.stress_pct = snap->stress_pct;
-        wire.health_pct = snap->health_pct;
-        wire.last_feeding_timestamp = snap->last_feeding_timestamp;
-        wire.activity_score = snap->activity_score;
-        memcpy(cursor, &wire, sizeof(wire));
-        cursor += sizeof(wire);
-    }
-
-    return uart_send_frame(CORE_LINK_MSG_STATE_FULL, buffer, payload_size);
-}
-
-static esp_err_t send_state_delta(const core_link_state_frame_t *frame, bool *out_any_change)
+        const core_link_terrarium_snapshot_t *prev = find_previous_snapshot(peer, snap->terrarium_id);
+
+        // Names only travel when the display may not know them yet; with the name
+        // table they are always referenced by ID so the frame stays self-contained.
+        core_link_delta_field_mask_t mask = CORE_LINK_DELTA_FIELD_ALL;
+        if (peer->name_table) {
+            mask = name_fields(peer, mask);
+        } else if (peer->names_valid && prev && !string_field_changed(snap->scientific_name, prev->scientific_name) &&
+            !string_field_changed(snap->common_name, prev->common_name)) {
+            mask &= (core_link_delta_field_mask_t)~CORE_LINK_DELTA_FIELD_NAMES;
+        }
+
+        if (offset + sizeof(core_link_state_delta_entry_wire_t) > CORE_LINK_STATE_MAX_PAYLOAD) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        core_link_state_delta_entry_wire_t entry = {
+            .terrarium_id = snap->terrarium_id,
+            .field_mask = mask,
+        };
+        memcpy(buffer + offset, &entry, sizeof(entry));
+        offset += sizeof(entry);
+
+        size_t written = core_link_compact_encode_fields(buffer + offset, CORE_LINK_STATE_MAX_PAYLOAD - offset, mask, snap);
+        if (written == 0) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        offset += written;
+    }
+
+    *out_length = append_sample_time(peer, buffer, offset, frame);
+    return ESP_OK;
+}
+
+static esp_err_t send_state_delta(core_host_peer_t *peer, const core_link_state_frame_t *frame, bool filtered,
+                                  bool refresh, bool *out_any_change)
 {
     if (out_any_change) {
         *out_any_change = false;
@@ -319,7 +934,25 @@ static esp_err_t send_state_delta(const core_link_state_frame_t *frame, bool *ou
         return ESP_ERR_INVALID_ARG;
     }
 
-    uint8_t buffer[CORE_LINK_MAX_PAYLOAD];
+    // Displays whose baselines copy the same publication get the same delta: the first
+    // one encodes it, the others only queue it.
+    core_host_encoded_t key = {
+        .valid = true,
+        .publication = s_publication,
+        .baseline = filtered ? 0 : peer->baseline_publication,
+        .flags = encode_flags(peer),
+        .terrarium_count = frame->terrarium_count,
+        .type = peer->compact_state ? CORE_LINK_MSG_STATE_DELTA_COMPACT : CORE_LINK_MSG_STATE_DELTA,
+    };
+    if (key.baseline != 0 && encoded_matches(&s_delta_encoded, &key)) {
+        if (out_any_change) {
+            *out_any_change = s_delta_encoded.any_change;
+        }
+        return send_state_payload(peer, key.type, s_state_payload, s_delta_encoded.length);
+    }
+    s_delta_encoded.valid = false;
+
+    uint8_t *buffer = s_state_payload;
     core_link_state_delta_header_wire_t header = {
         .epoch_seconds = frame->epoch_seconds,
         .terrarium_count = frame->terrarium_count,
@@ -331,159 +964,35 @@ static esp_err_t send_state_delta(const core_link_state_frame_t *frame, bool *ou
 
     for (uint8_t i = 0; i < frame->terrarium_count; ++i) {
         const core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
-        const core_link_terrarium_snapshot_t *prev = find_previous_snapshot(snap->terrarium_id);
+        const core_link_terrarium_snapshot_t *prev = find_previous_snapshot(peer, snap->terrarium_id);
         if (!prev) {
             return ESP_ERR_INVALID_STATE;
         }
 
-        core_link_delta_field_mask_t mask = 0;
-        if (string_field_changed(snap->scientific_name, prev->scientific_name)) {
-            mask |= CORE_LINK_DELTA_FIELD_SCIENTIFIC_NAME;
-        }
-        if (string_field_changed(snap->common_name, prev->common_name)) {
-            mask |= CORE_LINK_DELTA_FIELD_COMMON_NAME;
-        }
-        if (float_field_changed(snap->temp_day_c, prev->temp_day_c)) {
-            mask |= CORE_LINK_DELTA_FIELD_TEMP_DAY;
-        }
-        if (float_field_changed(snap->temp_night_c, prev->temp_night_c)) {
-            mask |= CORE_LINK_DELTA_FIELD_TEMP_NIGHT;
-        }
-        if (float_field_changed(snap->humidity_day_pct, prev->humidity_day_pct)) {
-            mask |= CORE_LINK_DELTA_FIELD_HUMIDITY_DAY;
-        }
-        if (float_field_changed(snap->humidity_night_pct, prev->humidity_night_pct)) {
-            mask |= CORE_LINK_DELTA_FIELD_HUMIDITY_NIGHT;
-        }
-        if (float_field_changed(snap->lux_day, prev->lux_day)) {
-            mask |= CORE_LINK_DELTA_FIELD_LUX_DAY;
-        }
-        if (float_field_changed(snap->lux_night, prev->lux_night)) {
-            mask |= CORE_LINK_DELTA_FIELD_LUX_NIGHT;
-        }
-        if (float_field_changed(snap->hydration_pct, prev->hydration_pct)) {
-            mask |= CORE_LINK_DELTA_FIELD_HYDRATION;
-        }
-        if (float_field_changed(snap->stress_pct, prev->stress_pct)) {
-            mask |= CORE_LINK_DELTA_FIELD_STRESS;
-        }
-        if (float_field_changed(snap->health_pct, prev->health_pct)) {
-            mask |= CORE_LINK_DELTA_FIELD_HEALTH;
-        }
-        if (snap->last_feeding_timestamp != prev->last_feeding_timestamp) {
-            mask |= CORE_LINK_DELTA_FIELD_LAST_FEED;
-        }
-        if (float_field_changed(snap->activity_score, prev->activity_score)) {
-            mask |= CORE_LINK_DELTA_FIELD_ACTIVITY;
-        }
-
+        // Both encodings share the change test: a field only counts as changed once it
+        // moves by a full wire step, not on float noise. A refresh resends the subscribed
+        // fields whether they moved or not.
+        core_link_delta_field_mask_t mask =
+            name_fields(peer, refresh ? core_link_subscription_mask(&peer->subscription, snap->terrarium_id)
+                                      : core_link_compact_diff_mask(snap, prev));
         if (!mask) {
             continue;
         }
 
-        if (offset + sizeof(core_link_state_delta_entry_wire_t) > CORE_LINK_MAX_PAYLOAD) {
+        // One size check per entry: the table predicts the field bytes from the mask.
+        size_t fields = peer->compact_state ? core_link_compact_fields_size(mask, snap) : core_link_fields_v1_size(mask);
+        if (offset + sizeof(core_link_state_delta_entry_wire_t) + fields > CORE_LINK_STATE_MAX_PAYLOAD) {
             return ESP_ERR_INVALID_SIZE;
         }
-
         core_link_state_delta_entry_wire_t entry = {
             .terrarium_id = snap->terrarium_id,
             .field_mask = mask,
         };
         memcpy(buffer + offset, &entry, sizeof(entry));
         offset += sizeof(entry);
-
-        if (mask & CORE_LINK_DELTA_FIELD_SCIENTIFIC_NAME) {
-            if (offset + CORE_LINK_DELTA_STRING_BYTES > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, snap->scientific_name, CORE_LINK_DELTA_STRING_BYTES);
-            offset += CORE_LINK_DELTA_STRING_BYTES;
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_COMMON_NAME) {
-            if (offset + CORE_LINK_DELTA_STRING_BYTES > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, snap->common_name, CORE_LINK_DELTA_STRING_BYTES);
-            offset += CORE_LINK_DELTA_STRING_BYTES;
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_TEMP_DAY) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->temp_day_c, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_TEMP_NIGHT) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->temp_night_c, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_HUMIDITY_DAY) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->humidity_day_pct, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_HUMIDITY_NIGHT) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->humidity_night_pct, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_LUX_DAY) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->lux_day, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_LUX_NIGHT) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->lux_night, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_HYDRATION) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->hydration_pct, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_STRESS) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->stress_pct, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_HEALTH) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->health_pct, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_LAST_FEED) {
-            if (offset + sizeof(uint32_t) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->last_feeding_timestamp, sizeof(uint32_t));
-            offset += sizeof(uint32_t);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_ACTIVITY) {
-            if (offset + sizeof(float) > CORE_LINK_MAX_PAYLOAD) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(buffer + offset, &snap->activity_score, sizeof(float));
-            offset += sizeof(float);
-        }
-
+        uint8_t *out = buffer + offset;
+        offset += peer->compact_state ? core_link_compact_encode_fields(out, fields, mask, snap)
+                                       : core_link_fields_v1_encode(out, fields, mask, snap);
         ++changed;
     }
 
@@ -492,53 +1001,149 @@ static esp_err_t send_state_delta(const core_link_state_frame_t *frame, bool *ou
         *out_any_change = changed > 0;
     }
 
-    size_t payload_length = offset;
-    return uart_send_frame(CORE_LINK_MSG_STATE_DELTA, buffer, payload_length);
+    size_t payload_length = append_sample_time(peer, buffer, offset, frame);
+    if (key.baseline != 0) {
+        key.length = payload_length;
+        key.any_change = changed > 0;
+        s_delta_encoded = key;
+    }
+    return send_state_payload(peer, key.type, buffer, payload_length);
 }
 
-static const core_link_terrarium_snapshot_t *find_previous_snapshot(uint8_t terrarium_id)
+static const core_link_terrarium_snapshot_t *find_previous_snapshot(const core_host_peer_t *peer,
+                                                                    uint8_t terrarium_id)
 {
-    if (!s_last_state_valid) {
+    if (!peer->last_state_valid) {
         return NULL;
     }
 
-    for (uint8_t i = 0; i < s_last_sent_state.terrarium_count; ++i) {
-        if (s_last_sent_state.terrariums[i].terrarium_id == terrarium_id) {
-            return &s_last_sent_state.terrariums[i];
+    const core_link_state_frame_t *sent = peer->last_sent_state;
+    for (uint8_t i = 0; i < sent->terrarium_count; ++i) {
+        if (sent->terrariums[i].terrarium_id == terrarium_id) {
+            return &sent->terrariums[i];
         }
     }
 
     return NULL;
 }
 
-static void store_last_state(const core_link_state_frame_t *frame)
+static void store_last_state(core_host_peer_t *peer, bool filtered)
 {
-    if (!frame) {
-        return;
+    // The frame just sent becomes the baseline; the old baseline is reused for the next one.
+    core_link_state_frame_t *previous = peer->last_sent_state;
+    peer->last_sent_state = peer->tx_state;
+    peer->tx_state = previous;
+    peer->last_state_valid = true;
+    // Unfiltered, the baseline is an exact copy of this publication.
+    peer->baseline_publication = filtered ? 0 : s_publication;
+}
+
+// Outside the periodic refresh, the display may not hold our last STATE_FULL.
+// Caller holds s_state_lock: send_state_locked() reads these flags and clears
+// force_next_full under it, so an unlocked write could be lost mid-encode.
+static void schedule_full_frame_locked(core_host_peer_t *peer, bool names)
+{
+    if (names) {
+        peer->names_valid = false;
+        peer->name_table_valid = false;
+    }
+    peer->full_plain_next = true;
+    peer->force_next_full = true;
+}
+
+// RX tasks and the watchdog timer ask for resyncs from outside any publication.
+static void schedule_full_frame(core_host_peer_t *peer)
+{
+    xSemaphoreTake(s_state_lock, portMAX_DELAY);
+    schedule_full_frame_locked(peer, false);
+    xSemaphoreGive(s_state_lock);
+}
+
+static void schedule_full_frame_with_names(core_host_peer_t *peer)
+{
+    xSemaphoreTake(s_state_lock, portMAX_DELAY);
+    schedule_full_frame_locked(peer, true);
+    xSemaphoreGive(s_state_lock);
+}
+
+static esp_err_t sync_name_table(core_host_peer_t *peer)
+{
+    bool reset = !peer->name_table_valid;
+    if (reset) {
+        // IDs in the display baseline belong to the previous table.
+        peer->names_sent = 0;
+        peer->force_next_full = true;
+    } else if (peer->names_sent >= s_name_table->count) {
+        return ESP_OK;
+    }
+
+    // Only entries the display has not seen yet go out; the fragment scratch
+    // buffer is free here since both paths run under s_state_lock.
+    uint8_t next_id = peer->names_sent;
+    do {
+        size_t written = core_link_name_table_encode(s_name_table, &next_id, reset, s_fragment_payload,
+                                                     sizeof(s_fragment_payload));
+        if (written == 0) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        esp_err_t err = send_sequenced_frame(peer, CORE_LINK_MSG_NAME_TABLE, s_fragment_payload, (uint16_t)written);
+        if (err != ESP_OK) {
+            return err;
+        }
+        reset = false;
+    } while (next_id < s_name_table->count);
+
+    peer->names_sent = next_id;
+    peer->name_table_valid = true;
+    return ESP_OK;
+}
+
+static bool intern_frame_names(core_link_state_frame_t *frame)
+{
+    for (uint8_t i = 0; i < frame->terrarium_count; ++i) {
+        core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
+        snap->name_ids[0] = core_link_name_table_intern(s_name_table, snap->scientific_name);
+        snap->name_ids[1] = core_link_name_table_intern(s_name_table, snap->common_name);
+        if (snap->name_ids[0] == CORE_LINK_NAME_ID_NONE || snap->name_ids[1] == CORE_LINK_NAME_ID_NONE) {
+            return false;
+        }
     }
+    return true;
+}
 
-    memset(&s_last_sent_state, 0, sizeof(s_last_sent_state));
-    memcpy(&s_last_sent_state, frame, sizeof(*frame));
-    s_last_state_valid = true;
+// Every display holds a copy of the one table: a new generation resends it to all.
+static void reset_name_table(void)
+{
+    core_link_name_table_reset(s_name_table, (uint8_t)(s_name_table->generation + 1U));
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        s_peers[i].names_sent = 0;
+        s_peers[i].name_table_valid = false;
+    }
 }
 
-static void schedule_full_frame(void)
+static core_link_delta_field_mask_t name_fields(const core_host_peer_t *peer, core_link_delta_field_mask_t mask)
 {
-    s_force_next_full = true;
+    if (!peer->name_table) {
+        return mask & (core_link_delta_field_mask_t)~CORE_LINK_DELTA_FIELD_NAME_IDS;
+    }
+    if (mask & (CORE_LINK_DELTA_FIELD_NAMES | CORE_LINK_DELTA_FIELD_NAME_IDS)) {
+        mask = (core_link_delta_field_mask_t)((mask & ~CORE_LINK_DELTA_FIELD_NAMES) | CORE_LINK_DELTA_FIELD_NAME_IDS);
+    }
+    return mask;
 }
 
-static bool ensure_baseline_compatible(const core_link_state_frame_t *frame)
+static bool ensure_baseline_compatible(const core_host_peer_t *peer, const core_link_state_frame_t *frame)
 {
-    if (!frame || !s_last_state_valid) {
+    if (!frame || !peer->last_state_valid) {
         return false;
     }
 
-    if (frame->terrarium_count != s_last_sent_state.terrarium_count) {
+    if (frame->terrarium_count != peer->last_sent_state->terrarium_count) {
         return false;
     }
 
     for (uint8_t i = 0; i < frame->terrarium_count; ++i) {
-        if (!find_previous_snapshot(frame->terrariums[i].terrarium_id)) {
+        if (!find_previous_snapshot(peer, frame->terrariums[i].terrarium_id)) {
             return false;
         }
     }
@@ -546,9 +1151,165 @@ static bool ensure_baseline_compatible(const core_link_state_frame_t *frame)
     return true;
 }
 
-static bool float_field_changed(float a, float b)
+// Unsubscribed fields keep the value the display already holds, so neither deltas nor
+// refreshes carry them; only a resync STATE_FULL brings them up to date.
+static bool apply_subscription(const core_host_peer_t *peer, core_link_state_frame_t *frame)
+{
+    const core_link_subscription_t *sub = &peer->subscription;
+    if (core_link_subscription_is_all(sub)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < frame->terrarium_count; ++i) {
+        core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
+        const core_link_terrarium_snapshot_t *sent = find_previous_snapshot(peer, snap->terrarium_id);
+        if (sent) {
+            core_link_subscription_filter(sub, snap, sent);
+        }
+    }
+    return true;
+}
+
+static void set_subscription(core_host_peer_t *peer, const core_link_subscription_t *sub)
+{
+    if (!s_state_lock) {
+        return;
+    }
+    uint32_t interval_ms = sub->min_interval_ms;
+    if (interval_ms > CORE_HOST_SUBSCRIBE_MAX_INTERVAL_MS) {
+        interval_ms = CORE_HOST_SUBSCRIBE_MAX_INTERVAL_MS;
+    }
+    xSemaphoreTake(s_state_lock, portMAX_DELAY);
+    peer->subscription = *sub;
+    peer->subscription_interval_ticks = pdMS_TO_TICKS(interval_ms);
+    xSemaphoreGive(s_state_lock);
+}
+
+static void reset_subscription(core_host_peer_t *peer)
+{
+    core_link_subscription_t all;
+    core_link_subscription_all(&all);
+    set_subscription(peer, &all);
+}
+
+static void handle_subscribe(core_host_peer_t *peer, const uint8_t *payload, uint16_t length)
+{
+    core_link_subscription_t sub;
+    if (!core_link_subscription_decode(payload, length, &sub)) {
+        ESP_LOGW(TAG, "Display %u: malformed SUBSCRIBE (%u bytes)", peer->index, length);
+        return;
+    }
+    ESP_LOGI(TAG, "Display %u subscription: fields=0x%04X terrariums=%s interval=%u ms", peer->index, sub.field_mask,
+             sub.all_terrariums ? "all" : "listed", sub.min_interval_ms);
+    set_subscription(peer, &sub);
+}
+
+static void handle_history_request(core_host_peer_t *peer, const uint8_t *payload, uint16_t length)
+{
+    core_link_history_request_t request;
+    if (!core_link_history_request_decode(payload, length, &request)) {
+        ESP_LOGW(TAG, "Display %u: malformed HISTORY_REQUEST (%u bytes)", peer->index, length);
+        return;
+    }
+    size_t chunk_len = 0;
+    if (s_history_cb) {
+        chunk_len = s_history_cb(&request, peer->history_chunk, sizeof(peer->history_chunk), s_history_ctx);
+    }
+    if (chunk_len == 0) {
+        core_link_history_chunk_t unavailable = {
+            .terrarium_id = request.terrarium_id,
+            .tier = request.tier,
+            .status = CORE_LINK_HISTORY_UNAVAILABLE,
+        };
+        chunk_len = core_link_history_chunk_encode_header(&unavailable, peer->history_chunk,
+                                                          sizeof(peer->history_chunk));
+    }
+    // One chunk per request, in the BULK class: the display paces the transfer
+    // and state frames always go first.
+    esp_err_t err = send_frame(peer, CORE_LINK_MSG_HISTORY_CHUNK, peer->history_chunk, (uint16_t)chunk_len);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Display %u: failed to send HISTORY_CHUNK: %s", peer->index, esp_err_to_name(err));
+    }
+}
+
+static void reset_retransmit_history(core_host_peer_t *peer, bool frame_v2)
+{
+    if (peer->retx_lock) {
+        xSemaphoreTake(peer->retx_lock, portMAX_DELAY);
+    }
+    peer->frame_v2 = frame_v2;
+    peer->tx_seq = 0;
+    peer->retx_next = 0;
+    for (size_t i = 0; peer->retx_history && i < CORE_HOST_RETX_HISTORY; ++i) {
+        peer->retx_history[i].used = false;
+    }
+    if (peer->retx_lock) {
+        xSemaphoreGive(peer->retx_lock);
+    }
+}
+
+static esp_err_t send_sequenced_frame(core_host_peer_t *peer, core_link_msg_type_t type, const void *payload,
+                                      uint16_t length)
 {
-    return fabsf(a - b) > CORE_HOST_DELTA_FLOAT_EPSILON;
+    if (!peer->frame_v2) {
+        return send_frame(peer, type, payload, length);
+    }
+
+    xSemaphoreTake(peer->retx_lock, portMAX_DELAY);
+    peer->tx_seq = core_link_seq_next(peer->tx_seq);
+    uint16_t seq = peer->tx_seq;
+    core_host_retx_entry_t *entry = &peer->retx_history[peer->retx_next];
+    peer->retx_next = (peer->retx_next + 1U) % CORE_HOST_RETX_HISTORY;
+    entry->used = true;
+    entry->type = (uint8_t)type;
+    entry->seq = seq;
+    entry->length = length;
+    memcpy(entry->payload, payload, length);
+    // Queued under the lock so sequence numbers enter the STATE class in order.
+    esp_err_t err = send_frame_seq(peer, type, seq, payload, length, CORE_LINK_TX_PRIO_STATE);
+    xSemaphoreGive(peer->retx_lock);
+    return err;
+}
+
+static void handle_nak(core_host_peer_t *peer, const uint8_t *payload, uint16_t length)
+{
+    if (!peer->frame_v2 || length < 1) {
+        return;
+    }
+    uint8_t count = payload[0];
+    if (count > CORE_LINK_NAK_MAX_SEQS || length < 1U + count * sizeof(uint16_t)) {
+        ESP_LOGW(TAG, "Display %u: malformed NAK (%u bytes)", peer->index, length);
+        return;
+    }
+    core_link_stats_add(&peer->stats, CORE_LINK_STAT_NAKS, 1);
+
+    bool missing = false;
+    for (uint8_t i = 0; i < count; ++i) {
+        uint16_t seq = (uint16_t)(payload[1 + i * 2] | ((uint16_t)payload[2 + i * 2] << 8));
+        bool resent = false;
+        xSemaphoreTake(peer->retx_lock, portMAX_DELAY);
+        for (size_t n = 0; n < CORE_HOST_RETX_HISTORY; ++n) {
+            const core_host_retx_entry_t *entry = &peer->retx_history[n];
+            if (entry->used && entry->seq == seq) {
+                // Jumps ahead of pending state frames: the display parks only a few out-of-order frames.
+                send_frame_seq(peer, (core_link_msg_type_t)entry->type, entry->seq, entry->payload, entry->length,
+                               CORE_LINK_TX_PRIO_PING);
+                resent = true;
+                break;
+            }
+        }
+        xSemaphoreGive(peer->retx_lock);
+        if (resent) {
+            ESP_LOGD(TAG, "Display %u: retransmitted seq %u", peer->index, seq);
+        } else {
+            missing = true;
+        }
+    }
+
+    if (missing) {
+        // Too old to replay: the next publication rebases the display instead.
+        ESP_LOGW(TAG, "Display %u: NAK for expired sequence, scheduling STATE_FULL", peer->index);
+        schedule_full_frame(peer);
+    }
 }
 
 static bool string_field_changed(const char *a, const char *b)
@@ -559,20 +1320,123 @@ static bool string_field_changed(const char *a, const char *b)
     return strncmp(a, b, CORE_LINK_DELTA_STRING_BYTES) != 0;
 }
 
+static esp_err_t send_ping(core_host_peer_t *peer)
+{
+    // The display echoes the payload: the PONG carries our send time back.
+    uint32_t now_us = (uint32_t)esp_timer_get_time();
+    uint8_t payload[CORE_LINK_PING_TIMESTAMP_SIZE] = {
+        (uint8_t)now_us, (uint8_t)(now_us >> 8), (uint8_t)(now_us >> 16), (uint8_t)(now_us >> 24),
+    };
+    return send_frame(peer, CORE_LINK_MSG_PING, payload, sizeof(payload));
+}
+
 esp_err_t core_host_link_send_ping(void)
 {
-    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000ULL);
-    return uart_send_frame(CORE_LINK_MSG_PING, &now_ms, sizeof(now_ms));
+    esp_err_t result = ESP_ERR_INVALID_STATE;
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        if (!peer_has_handshake(&s_peers[i])) {
+            continue;
+        }
+        esp_err_t err = send_ping(&s_peers[i]);
+        if (err == ESP_OK || result != ESP_OK) {
+            result = err;
+        }
+    }
+    return result;
+}
+
+static void reply_pong(core_host_peer_t *peer, const uint8_t *payload, uint16_t length)
+{
+    if (length != CORE_LINK_PING_TIMESTAMP_SIZE) {
+        send_frame(peer, CORE_LINK_MSG_PONG, payload, length);
+        return;
+    }
+    // Timestamped PING: append our clock so the display can estimate offset and drift.
+    uint8_t reply[CORE_LINK_PING_TIMESTAMP_SIZE + CORE_LINK_PONG_CLOCK_SIZE];
+    memcpy(reply, payload, CORE_LINK_PING_TIMESTAMP_SIZE);
+    core_link_put_le64(reply + CORE_LINK_PING_TIMESTAMP_SIZE, (uint64_t)esp_timer_get_time());
+    send_frame(peer, CORE_LINK_MSG_PONG, reply, sizeof(reply));
+}
+
+static void handle_pong(core_host_peer_t *peer, const uint8_t *payload, uint16_t length)
+{
+    peer->baud_pong_pending = false;
+    if (length < CORE_LINK_PING_TIMESTAMP_SIZE) {
+        return;
+    }
+    uint32_t sent_us = (uint32_t)payload[0] | ((uint32_t)payload[1] << 8) | ((uint32_t)payload[2] << 16) |
+                       ((uint32_t)payload[3] << 24);
+    core_link_stats_record_rtt(&peer->stats, (uint32_t)esp_timer_get_time() - sent_us);
+}
+
+esp_err_t core_host_link_get_link_stats(core_link_stats_snapshot_t *out_stats)
+{
+    return core_host_link_get_link_stats_for(0, out_stats);
+}
+
+esp_err_t core_host_link_get_link_stats_for(size_t display, core_link_stats_snapshot_t *out_stats)
+{
+    ESP_RETURN_ON_FALSE(out_stats, ESP_ERR_INVALID_ARG, TAG, "stats null");
+    ESP_RETURN_ON_FALSE(s_initialized, ESP_ERR_INVALID_STATE, TAG, "core_host_link_init not called");
+    ESP_RETURN_ON_FALSE(display < s_peer_count, ESP_ERR_INVALID_ARG, TAG, "no display %u", (unsigned)display);
+    core_link_stats_snapshot(&s_peers[display].stats, (uint32_t)(esp_timer_get_time() / 1000LL), out_stats);
+    return ESP_OK;
+}
+
+static void publish_link_stats(core_host_peer_t *peer)
+{
+    // Also probes the round trip so the report carries fresh RTT samples.
+    send_ping(peer);
+    if (!peer->link_stats) {
+        return;
+    }
+    core_link_stats_snapshot_t snapshot;
+    core_link_stats_snapshot(&peer->stats, (uint32_t)(esp_timer_get_time() / 1000LL), &snapshot);
+    uint8_t payload[CORE_LINK_STATS_PAYLOAD_SIZE];
+    size_t length = core_link_stats_encode(&snapshot, payload, sizeof(payload));
+    if (length > 0) {
+        send_frame(peer, CORE_LINK_MSG_LINK_STATS, payload, (uint16_t)length);
+    }
+}
+
+static EventBits_t display_bits(bool ready)
+{
+    EventBits_t bits = 0;
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        bits |= ready ? CORE_HOST_EVENT_DISPLAY_READY(i) : CORE_HOST_EVENT_HANDSHAKE(i);
+    }
+    return bits;
+}
+
+static bool peer_has_handshake(const core_host_peer_t *peer)
+{
+    return s_events && (xEventGroupGetBits(s_events) & CORE_HOST_EVENT_HANDSHAKE(peer->index)) != 0;
+}
+
+static bool peer_is_ready(const core_host_peer_t *peer)
+{
+    EventBits_t mask = CORE_HOST_EVENT_HANDSHAKE(peer->index) | CORE_HOST_EVENT_DISPLAY_READY(peer->index);
+    return s_events && (xEventGroupGetBits(s_events) & mask) == mask;
 }
 
 esp_err_t core_host_link_wait_for_display_ready(TickType_t ticks_to_wait)
 {
     ESP_RETURN_ON_FALSE(s_started, ESP_ERR_INVALID_STATE, TAG, "core_host_link_start not called");
-    EventBits_t bits = xEventGroupWaitBits(s_events, CORE_HOST_EVENT_HANDSHAKE | CORE_HOST_EVENT_DISPLAY_READY, pdFALSE, pdTRUE, ticks_to_wait);
-    if ((bits & (CORE_HOST_EVENT_HANDSHAKE | CORE_HOST_EVENT_DISPLAY_READY)) != (CORE_HOST_EVENT_HANDSHAKE | CORE_HOST_EVENT_DISPLAY_READY)) {
-        return ESP_ERR_TIMEOUT;
+    TickType_t start = xTaskGetTickCount();
+    while (true) {
+        if (core_host_link_is_display_ready()) {
+            return ESP_OK;
+        }
+        TickType_t waited = xTaskGetTickCount() - start;
+        if (waited >= ticks_to_wait) {
+            return ESP_ERR_TIMEOUT;
+        }
+        // Any display will do; a DISPLAY_READY bit without its handshake sends us round again.
+        xEventGroupWaitBits(s_events, display_bits(true), pdFALSE, pdFALSE, ticks_to_wait - waited);
+        if (!core_host_link_is_display_ready() && ticks_to_wait - waited > CORE_HOST_WATCHDOG_PERIOD_TICKS) {
+            vTaskDelay(CORE_HOST_WATCHDOG_PERIOD_TICKS);
+        }
     }
-    return ESP_OK;
 }
 
 bool core_host_link_is_handshake_complete(void)
@@ -581,26 +1445,51 @@ bool core_host_link_is_handshake_complete(void)
         return false;
     }
     EventBits_t bits = xEventGroupGetBits(s_events);
-    return (bits & CORE_HOST_EVENT_HANDSHAKE) != 0;
+    return (bits & display_bits(false)) != 0;
 }
 
-bool core_host_link_is_display_ready(void)
+bool core_host_link_is_handshake_pending(void)
 {
     if (!s_events) {
         return false;
     }
-    EventBits_t bits = xEventGroupGetBits(s_events);
-    return (bits & CORE_HOST_EVENT_DISPLAY_READY) != 0;
+    EventBits_t mask = display_bits(false);
+    return (xEventGroupGetBits(s_events) & mask) != mask;
+}
+
+bool core_host_link_is_display_ready(void)
+{
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        if (peer_is_ready(&s_peers[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t core_host_link_get_display_count(void)
+{
+    return s_peer_count;
 }
 
 uint8_t core_host_link_get_peer_version(void)
 {
-    return s_peer_version;
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        if (peer_has_handshake(&s_peers[i])) {
+            return s_peers[i].peer_version;
+        }
+    }
+    return 0;
 }
 
 const core_host_display_info_t *core_host_link_get_display_info(void)
 {
-    return core_host_link_is_display_ready() ? &s_display_info : NULL;
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        if (peer_is_ready(&s_peers[i])) {
+            return &s_peers[i].display_info;
+        }
+    }
+    return NULL;
 }
 
 esp_err_t core_host_link_register_display_ready_cb(core_host_display_ready_cb_t cb, void *ctx)
@@ -631,62 +1520,301 @@ esp_err_t core_host_link_register_command_cb(core_host_command_cb_t cb, void *ct
     return ESP_OK;
 }
 
-static uint8_t checksum_compute(uint8_t type, uint16_t length, const uint8_t *payload)
+esp_err_t core_host_link_register_history_cb(core_host_history_cb_t cb, void *ctx)
 {
-    uint32_t sum = type + (length & 0xFF) + (length >> 8);
-    if (payload && length) {
-        for (uint16_t i = 0; i < length; ++i) {
-            sum += payload[i];
-        }
-    }
-    return (uint8_t)(sum & 0xFF);
+    s_history_cb = cb;
+    s_history_ctx = ctx;
+    return ESP_OK;
+}
+
+static esp_err_t send_frame(core_host_peer_t *peer, core_link_msg_type_t type, const void *payload, uint16_t length)
+{
+    return tx_enqueue(peer, type, peer->frame_v2, 0, payload, length, core_link_tx_priority_for(type));
+}
+
+static esp_err_t send_frame_seq(core_host_peer_t *peer, core_link_msg_type_t type, uint16_t seq, const void *payload,
+                                uint16_t length, core_link_tx_priority_t priority)
+{
+    return tx_enqueue(peer, type, true, seq, payload, length, priority);
 }
 
-static esp_err_t uart_send_frame(core_link_msg_type_t type, const void *payload, uint16_t length)
+static esp_err_t tx_enqueue(core_host_peer_t *peer, core_link_msg_type_t type, bool frame_v2, uint16_t seq,
+                            const void *payload, uint16_t length, core_link_tx_priority_t priority)
 {
     ESP_RETURN_ON_FALSE(s_started, ESP_ERR_INVALID_STATE, TAG, "link not started");
-    core_link_frame_header_t header = {
-        .sof = CORE_LINK_SOF,
-        .type = (uint8_t)type,
-        .length = length,
-    };
-    uint8_t checksum = checksum_compute(header.type, header.length, payload);
+    // The timer service task (watchdog ping) must never block on a full queue.
+    TickType_t wait = xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle() ? 0 : CORE_HOST_TX_ENQUEUE_TIMEOUT_TICKS;
+    if (xSemaphoreTake(peer->tx_free, wait) != pdTRUE) {
+        portENTER_CRITICAL(&s_tx_queue_lock);
+        core_link_tx_queue_note_drop(&peer->tx_queue, priority);
+        portEXIT_CRITICAL(&s_tx_queue_lock);
+        core_link_stats_add(&peer->stats, CORE_LINK_STAT_TX_DROPPED, 1);
+        ESP_LOGW(TAG, "Display %u: TX queue full, dropping frame 0x%02x", peer->index, (unsigned)type);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    portENTER_CRITICAL(&s_tx_queue_lock);
+    core_link_tx_slot_t *slot = core_link_tx_queue_acquire(&peer->tx_queue);
+    portEXIT_CRITICAL(&s_tx_queue_lock);
+    if (!slot) {
+        xSemaphoreGive(peer->tx_free);
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Serialised outside the critical section, straight into the buffer the TX task writes.
+    size_t written = frame_v2 ? core_link_frame_encode_v2(slot->data, sizeof(slot->data), (uint8_t)type, seq, payload, length)
+                              : core_link_frame_encode(slot->data, sizeof(slot->data), (uint8_t)type, payload, length);
+    portENTER_CRITICAL(&s_tx_queue_lock);
+    if (written == 0) {
+        core_link_tx_queue_abort(&peer->tx_queue, slot);
+    } else {
+        slot->length = (uint16_t)written;
+        core_link_tx_queue_push(&peer->tx_queue, slot, priority, esp_timer_get_time());
+    }
+    portEXIT_CRITICAL(&s_tx_queue_lock);
+    if (written == 0) {
+        xSemaphoreGive(peer->tx_free);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    xTaskNotifyGive(peer->tx_task);
+    return ESP_OK;
+}
 
-    uart_write_bytes(s_config.uart_port, (const char *)&header, sizeof(header));
-    if (payload && length > 0) {
-        uart_write_bytes(s_config.uart_port, (const char *)payload, length);
+static void tx_task(void *arg)
+{
+    core_host_peer_t *peer = arg;
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (true) {
+            portENTER_CRITICAL(&s_tx_queue_lock);
+            core_link_tx_slot_t *slot = core_link_tx_queue_pop(&peer->tx_queue);
+            portEXIT_CRITICAL(&s_tx_queue_lock);
+            if (!slot) {
+                break;
+            }
+            // Sole writer of this display's UART: one contiguous write per frame.
+            xSemaphoreTake(peer->transport_lock, portMAX_DELAY);
+            core_link_transport_write(&peer->transport, slot->data, slot->length);
+            bool switch_failed = false;
+            if (slot->data[1] == CORE_LINK_MSG_BAUD_SWITCH && peer->baud_switch_bps != 0) {
+                // The announcement leaves at the old rate, everything behind it at the new one.
+                if (core_link_transport_set_baud(&peer->transport, peer->baud_switch_bps) == 0) {
+                    peer->link_baud = peer->baud_switch_bps;
+                } else {
+                    switch_failed = true;
+                }
+            }
+            xSemaphoreGive(peer->transport_lock);
+            if (switch_failed) {
+                // The UART kept its rate but the display is moving: both meet again at the start rate.
+                ESP_LOGW(TAG, "Display %u: UART refused %u bps", peer->index, (unsigned)peer->baud_switch_bps);
+                baud_fall_back(peer);
+            }
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_FRAMES_TX, 1);
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_BYTES_TX, slot->length);
+            portENTER_CRITICAL(&s_tx_queue_lock);
+            core_link_tx_queue_complete(&peer->tx_queue, slot, esp_timer_get_time());
+            portEXIT_CRITICAL(&s_tx_queue_lock);
+            xSemaphoreGive(peer->tx_free);
+        }
     }
-    uart_write_bytes(s_config.uart_port, (const char *)&checksum, sizeof(checksum));
+}
+
+esp_err_t core_host_link_get_tx_stats(core_link_tx_stats_t *out_stats)
+{
+    return core_host_link_get_tx_stats_for(0, out_stats);
+}
+
+esp_err_t core_host_link_get_tx_stats_for(size_t display, core_link_tx_stats_t *out_stats)
+{
+    ESP_RETURN_ON_FALSE(out_stats, ESP_ERR_INVALID_ARG, TAG, "stats null");
+    ESP_RETURN_ON_FALSE(s_initialized, ESP_ERR_INVALID_STATE, TAG, "core_host_link_init not called");
+    ESP_RETURN_ON_FALSE(display < s_peer_count, ESP_ERR_INVALID_ARG, TAG, "no display %u", (unsigned)display);
+    portENTER_CRITICAL(&s_tx_queue_lock);
+    *out_stats = s_peers[display].tx_queue.stats;
+    portEXIT_CRITICAL(&s_tx_queue_lock);
     return ESP_OK;
 }
 
-static void update_display_alive(bool alive)
+static uint8_t local_capabilities_ext(const core_host_peer_t *peer)
+{
+    return CORE_HOST_LINK_CAPABILITIES_EXT | (peer->baud_enabled ? CORE_LINK_CAP_EXT_BAUD_SWITCH : 0) |
+           (s_history_cb ? CORE_LINK_CAP_EXT_HISTORY : 0);
+}
+
+static uint32_t baud_error_count(const core_host_peer_t *peer)
+{
+    // Both ends corrupt the same way on a marginal line: our bad headers and the display's NAKs.
+    return core_link_stats_get(&peer->stats, CORE_LINK_STAT_CHECKSUM_ERRORS) +
+           core_link_stats_get(&peer->stats, CORE_LINK_STAT_NAKS);
+}
+
+static void apply_link_baud(core_host_peer_t *peer, uint32_t bits_per_second)
+{
+    xSemaphoreTake(peer->transport_lock, portMAX_DELAY);
+    if (core_link_transport_set_baud(&peer->transport, bits_per_second) == 0) {
+        peer->link_baud = bits_per_second;
+    }
+    xSemaphoreGive(peer->transport_lock);
+    core_link_stats_set(&peer->stats, CORE_LINK_STAT_BAUD_RATE, peer->link_baud);
+}
+
+static void set_peer_baud(core_host_peer_t *peer, uint16_t peer_mask)
+{
+    if (!peer->baud_enabled) {
+        return;
+    }
+    portENTER_CRITICAL(&s_baud_lock);
+    core_link_baud_policy_set_peer(&peer->baud, peer_mask);
+    // A display re-sending HELLO at a negotiated rate keeps that rate.
+    uint8_t index = core_link_baud_index(peer->link_baud);
+    if (index != CORE_LINK_BAUD_INDEX_NONE && (peer->baud.common_mask & (1U << index))) {
+        core_link_baud_policy_commit(&peer->baud, index);
+    }
+    peer->baud_switch = peer->baud.common_mask != 0;
+    peer->baud_probe_active = false;
+    peer->baud_pong_pending = false;
+    peer->baud_window_tick = xTaskGetTickCount();
+    peer->baud_window_errors = baud_error_count(peer);
+    portEXIT_CRITICAL(&s_baud_lock);
+}
+
+static void baud_fall_back(core_host_peer_t *peer)
+{
+    if (!peer->baud_enabled) {
+        return;
+    }
+    portENTER_CRITICAL(&s_baud_lock);
+    core_link_baud_policy_fall_back(&peer->baud);
+    peer->baud_probe_active = false;
+    peer->baud_pong_pending = false;
+    uint32_t start = core_link_baud_policy_rate(&peer->baud);
+    portEXIT_CRITICAL(&s_baud_lock);
+    if (peer->link_baud != start) {
+        // The display does the same when its own watchdog fires: both meet at the start rate.
+        ESP_LOGW(TAG, "Display %u: link lost at %u bps, falling back to %u bps", peer->index,
+                 (unsigned)peer->link_baud, (unsigned)start);
+        apply_link_baud(peer, start);
+        core_link_stats_add(&peer->stats, CORE_LINK_STAT_BAUD_SWITCHES, 1);
+    }
+}
+
+static void baud_tick(core_host_peer_t *peer, TickType_t now)
+{
+    if (!peer->baud_switch) {
+        return;
+    }
+    uint32_t revert_bps = 0;
+    uint32_t errors = 0;
+    uint8_t target = 0;
+    core_link_baud_action_t action = CORE_LINK_BAUD_HOLD;
+    bool window_closed = false;
+    portENTER_CRITICAL(&s_baud_lock);
+    if (peer->baud_probe_active) {
+        if (now - peer->baud_probe_tick >= CORE_HOST_BAUD_SWITCH_TIMEOUT_TICKS) {
+            peer->baud_probe_active = false;
+            core_link_baud_policy_failed(&peer->baud, peer->baud_probe_index);
+            revert_bps = core_link_baud_policy_rate(&peer->baud);
+            target = peer->baud_probe_index;
+            peer->baud_window_tick = now;
+            peer->baud_window_errors = baud_error_count(peer);
+        }
+    } else if (now - peer->baud_window_tick >= CORE_HOST_BAUD_WINDOW_TICKS) {
+        // An unanswered probe PING from the previous window counts as one error.
+        uint32_t total = baud_error_count(peer);
+        errors = total - peer->baud_window_errors + (peer->baud_pong_pending ? 1U : 0U);
+        peer->baud_window_errors = total;
+        peer->baud_window_tick = now;
+        window_closed = true;
+        action = core_link_baud_policy_evaluate(&peer->baud, errors, &target);
+        if (action != CORE_LINK_BAUD_HOLD) {
+            peer->baud_probe_active = true;
+            peer->baud_probe_index = target;
+            peer->baud_probe_tick = now;
+            peer->baud_switch_bps = core_link_baud_rate(target);
+        }
+    }
+    portEXIT_CRITICAL(&s_baud_lock);
+
+    if (revert_bps != 0) {
+        ESP_LOGW(TAG, "Display %u did not confirm %u bps, back to %u bps", peer->index,
+                 (unsigned)core_link_baud_rate(target), (unsigned)revert_bps);
+        apply_link_baud(peer, revert_bps);
+        return;
+    }
+    if (action != CORE_LINK_BAUD_HOLD) {
+        uint32_t bps = core_link_baud_rate(target);
+        uint8_t payload[CORE_LINK_BAUD_SWITCH_PAYLOAD_SIZE] = {
+            target, (uint8_t)bps, (uint8_t)(bps >> 8), (uint8_t)(bps >> 16), (uint8_t)(bps >> 24),
+        };
+        ESP_LOGI(TAG, "Display %u: %s from %u to %u bps (%u link errors in the last window)", peer->index,
+                 action == CORE_LINK_BAUD_STEP_UP ? "stepping up" : "stepping down", (unsigned)peer->link_baud,
+                 (unsigned)bps, (unsigned)errors);
+        if (send_frame(peer, CORE_LINK_MSG_BAUD_SWITCH, payload, sizeof(payload)) != ESP_OK) {
+            portENTER_CRITICAL(&s_baud_lock);
+            peer->baud_probe_active = false;
+            portEXIT_CRITICAL(&s_baud_lock);
+        }
+    } else if (window_closed) {
+        peer->baud_pong_pending = true;
+        send_ping(peer);
+    }
+}
+
+static void handle_baud_switch_ack(core_host_peer_t *peer, const uint8_t *payload, uint16_t length)
+{
+    if (length < CORE_LINK_BAUD_SWITCH_PAYLOAD_SIZE) {
+        return;
+    }
+    bool confirmed = false;
+    portENTER_CRITICAL(&s_baud_lock);
+    if (peer->baud_probe_active && payload[0] == peer->baud_probe_index) {
+        // The ACK itself travelled at the new rate: that is the probe.
+        peer->baud_probe_active = false;
+        core_link_baud_policy_commit(&peer->baud, payload[0]);
+        peer->baud_window_tick = xTaskGetTickCount();
+        peer->baud_window_errors = baud_error_count(peer);
+        confirmed = true;
+    }
+    portEXIT_CRITICAL(&s_baud_lock);
+    if (!confirmed) {
+        ESP_LOGW(TAG, "Display %u: ignoring stale BAUD_SWITCH_ACK for rate #%u", peer->index, payload[0]);
+        return;
+    }
+    uint32_t bps = core_link_baud_rate(payload[0]);
+    core_link_stats_set(&peer->stats, CORE_LINK_STAT_BAUD_RATE, bps);
+    core_link_stats_add(&peer->stats, CORE_LINK_STAT_BAUD_SWITCHES, 1);
+    ESP_LOGI(TAG, "Display %u confirmed %u bps", peer->index, (unsigned)bps);
+}
+
+static void update_display_alive(core_host_peer_t *peer, bool alive)
 {
     if (alive) {
-        if (!s_display_alive) {
-            if (s_watchdog_triggered) {
-                ESP_LOGI(TAG, "Display link restored, waiting for DISPLAY_READY");
+        if (!peer->display_alive) {
+            if (peer->watchdog_triggered) {
+                ESP_LOGI(TAG, "Display %u link restored, waiting for DISPLAY_READY", peer->index);
             }
-            s_display_alive = true;
+            peer->display_alive = true;
         }
-        s_watchdog_triggered = false;
-        s_ping_in_flight = false;
+        peer->watchdog_triggered = false;
+        peer->ping_in_flight = false;
         return;
     }
 
-    if (!s_display_alive) {
+    if (!peer->display_alive) {
         return;
     }
 
-    if (!s_watchdog_triggered) {
-        ESP_LOGE(TAG, "Display watchdog expired, marking panel offline");
+    if (!peer->watchdog_triggered) {
+        ESP_LOGE(TAG, "Display %u watchdog expired, marking panel offline", peer->index);
     }
-    s_watchdog_triggered = true;
-    s_display_alive = false;
-    s_ping_in_flight = false;
-    schedule_full_frame();
+    peer->watchdog_triggered = true;
+    peer->display_alive = false;
+    peer->ping_in_flight = false;
+    baud_fall_back(peer);
+    schedule_full_frame_with_names(peer);
     if (s_events) {
-        xEventGroupClearBits(s_events, CORE_HOST_EVENT_DISPLAY_READY);
+        xEventGroupClearBits(s_events, CORE_HOST_EVENT_DISPLAY_READY(peer->index));
     }
 }
 
@@ -697,103 +1825,180 @@ static void watchdog_timer_cb(TimerHandle_t timer)
         return;
     }
 
+    TickType_t now = xTaskGetTickCount();
+    for (size_t i = 0; i < s_peer_count; ++i) {
+        watchdog_peer(&s_peers[i], now);
+    }
+}
+
+static void watchdog_peer(core_host_peer_t *peer, TickType_t now)
+{
     EventBits_t bits = xEventGroupGetBits(s_events);
-    if ((bits & CORE_HOST_EVENT_HANDSHAKE) == 0 || !s_display_alive) {
+    if ((bits & CORE_HOST_EVENT_HANDSHAKE(peer->index)) == 0 || !peer->display_alive) {
         return;
     }
 
-    TickType_t now = xTaskGetTickCount();
-    TickType_t elapsed = now - s_last_activity_tick;
+    bool ready = (bits & CORE_HOST_EVENT_DISPLAY_READY(peer->index)) != 0;
+    if (CORE_HOST_STATS_PERIOD_TICKS > 0 && ready && now - peer->last_stats_tick >= CORE_HOST_STATS_PERIOD_TICKS) {
+        peer->last_stats_tick = now;
+        publish_link_stats(peer);
+    }
+    if (ready) {
+        baud_tick(peer, now);
+    }
+
+    TickType_t elapsed = now - peer->last_activity_tick;
     if (elapsed < CORE_HOST_STATE_TIMEOUT_TICKS) {
         return;
     }
 
-    if (!s_ping_in_flight) {
-        esp_err_t err = core_host_link_send_ping();
+    if (!peer->ping_in_flight) {
+        esp_err_t err = send_ping(peer);
         if (err == ESP_OK) {
-            s_ping_in_flight = true;
-            s_last_ping_tick = now;
-            ESP_LOGW(TAG, "No DISPLAY activity for %d ms, sending ping", CONFIG_CORE_APP_LINK_STATE_TIMEOUT_MS);
+            peer->ping_in_flight = true;
+            peer->last_ping_tick = now;
+            ESP_LOGW(TAG, "No activity from display %u for %d ms, sending ping", peer->index,
+                     CONFIG_CORE_APP_LINK_STATE_TIMEOUT_MS);
         } else {
-            ESP_LOGE(TAG, "Failed to send watchdog ping: %s", esp_err_to_name(err));
+            ESP_LOGE(TAG, "Failed to send watchdog ping to display %u: %s", peer->index, esp_err_to_name(err));
         }
         return;
     }
 
-    TickType_t ping_elapsed = now - s_last_ping_tick;
+    TickType_t ping_elapsed = now - peer->last_ping_tick;
     if (ping_elapsed >= CORE_HOST_PING_TIMEOUT_TICKS) {
-        ESP_LOGE(TAG, "Ping timeout after %d ms, marking display offline", CONFIG_CORE_APP_LINK_PING_TIMEOUT_MS);
-        update_display_alive(false);
+        ESP_LOGE(TAG, "Ping timeout after %d ms, marking display %u offline", CONFIG_CORE_APP_LINK_PING_TIMEOUT_MS,
+                 peer->index);
+        update_display_alive(peer, false);
     }
 }
 
-static void handle_frame(core_link_msg_type_t type, const uint8_t *payload, uint16_t length)
+static void handle_frame(core_host_peer_t *peer, core_link_msg_type_t type, const uint8_t *payload, uint16_t length)
 {
-    s_last_activity_tick = xTaskGetTickCount();
-    update_display_alive(true);
+    peer->last_activity_tick = xTaskGetTickCount();
+    update_display_alive(peer, true);
     switch (type) {
         case CORE_LINK_MSG_HELLO_ACK:
-            if (length >= sizeof(core_link_hello_ack_payload_t)) {
-                core_link_hello_ack_payload_t ack;
-                memcpy(&ack, payload, sizeof(ack));
-                s_peer_version = ack.protocol_version;
-                s_peer_supports_delta = (ack.protocol_version >= CORE_LINK_PROTOCOL_VERSION);
-                if (!s_peer_supports_delta) {
-                    ESP_LOGW(TAG, "Peer protocol v%u does not advertise STATE_DELTA support, forcing full frames", s_peer_version);
-                    schedule_full_frame();
+            // A new handshake starts unfiltered; the display follows up with its SUBSCRIBE.
+            reset_subscription(peer);
+            if (length >= offsetof(core_link_hello_ack_payload_t, capabilities_ext)) {
+                // Older displays stop after the first capability byte.
+                core_link_hello_ack_payload_t ack = {0};
+                memcpy(&ack, payload, length < sizeof(ack) ? length : sizeof(ack));
+                // A publication may be encoding with the old capabilities.
+                xSemaphoreTake(s_state_lock, portMAX_DELAY);
+                peer->peer_version = ack.protocol_version;
+                peer->supports_delta = (ack.protocol_version >= CORE_LINK_PROTOCOL_VERSION);
+                bool frame_v2 = (ack.capabilities & CORE_LINK_CAP_FRAME_V2) != 0;
+                if (frame_v2 != peer->frame_v2) {
+                    ESP_LOGI(TAG, "Display %u %s sequenced v2 frames", peer->index,
+                             frame_v2 ? "accepts" : "does not accept");
+                }
+                peer->compact_state = (ack.capabilities & CORE_LINK_CAP_COMPACT_STATE) != 0;
+                peer->fragments = (ack.capabilities & CORE_LINK_CAP_FRAGMENTS) != 0;
+                peer->name_table = peer->compact_state && (ack.capabilities & CORE_LINK_CAP_NAME_TABLE) != 0;
+                peer->link_stats = (ack.capabilities & CORE_LINK_CAP_LINK_STATS) != 0;
+                peer->touch_batch = (ack.capabilities & CORE_LINK_CAP_TOUCH_BATCH) != 0;
+                peer->sample_time = (ack.capabilities_ext & CORE_LINK_CAP_EXT_SAMPLE_TIME) != 0;
+                peer->full_compressed = (CORE_HOST_LINK_CAPABILITIES_EXT & ack.capabilities_ext &
+                                         CORE_LINK_CAP_EXT_FULL_COMPRESSED) != 0;
+                peer->request_id = (ack.capabilities_ext & CORE_LINK_CAP_EXT_REQUEST_ID) != 0;
+                set_peer_baud(peer, (ack.capabilities_ext & CORE_LINK_CAP_EXT_BAUD_SWITCH) ? ack.baud_mask : 0);
+                peer->clamp_warned = false;
+                reset_retransmit_history(peer, frame_v2);
+                schedule_full_frame_locked(peer, true);
+                xSemaphoreGive(s_state_lock);
+                if (!peer->supports_delta) {
+                    ESP_LOGW(TAG, "Display %u protocol v%u does not advertise STATE_DELTA support, forcing full frames",
+                             peer->index, peer->peer_version);
                 }
             } else {
-                s_peer_version = 0;
-                s_peer_supports_delta = false;
+                xSemaphoreTake(s_state_lock, portMAX_DELAY);
+                peer->peer_version = 0;
+                peer->supports_delta = false;
+                peer->compact_state = false;
+                peer->fragments = false;
+                peer->name_table = false;
+                peer->link_stats = false;
+                peer->touch_batch = false;
+                peer->sample_time = false;
+                peer->full_compressed = false;
+                peer->request_id = false;
+                set_peer_baud(peer, 0);
+                reset_retransmit_history(peer, false);
+                xSemaphoreGive(s_state_lock);
             }
-            if (!core_host_link_is_handshake_complete()) {
-                xEventGroupSetBits(s_events, CORE_HOST_EVENT_HANDSHAKE);
-                ESP_LOGI(TAG, "Handshake acknowledged (peer protocol v%u)", s_peer_version);
+            if (!peer_has_handshake(peer)) {
+                xEventGroupSetBits(s_events, CORE_HOST_EVENT_HANDSHAKE(peer->index));
+                ESP_LOGI(TAG, "Display %u handshake acknowledged (peer protocol v%u)", peer->index, peer->peer_version);
             }
             break;
         case CORE_LINK_MSG_DISPLAY_READY:
             if (length >= sizeof(core_link_display_ready_payload_t)) {
                 core_link_display_ready_payload_t info;
                 memcpy(&info, payload, sizeof(info));
-                s_display_info.width = info.width;
-                s_display_info.height = info.height;
-                s_display_info.protocol_version = info.protocol_version;
-                xEventGroupSetBits(s_events, CORE_HOST_EVENT_DISPLAY_READY);
-                schedule_full_frame();
-                ESP_LOGI(TAG, "Display ready: %ux%u (protocol v%u)", info.width, info.height, info.protocol_version);
+                peer->display_info.width = info.width;
+                peer->display_info.height = info.height;
+                peer->display_info.protocol_version = info.protocol_version;
+                peer->display_info.index = peer->index;
+                xEventGroupSetBits(s_events, CORE_HOST_EVENT_DISPLAY_READY(peer->index));
+                schedule_full_frame_with_names(peer);
+                ESP_LOGI(TAG, "Display %u ready: %ux%u (protocol v%u)", peer->index, info.width, info.height,
+                         info.protocol_version);
                 if (s_display_cb) {
-                    s_display_cb(&s_display_info, s_display_ctx);
+                    s_display_cb(&peer->display_info, s_display_ctx);
                 }
             }
             break;
         case CORE_LINK_MSG_REQUEST_STATE:
-            schedule_full_frame();
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_RESYNCS, 1);
+            // Displays that still hold the name table only need a new baseline.
+            if (length == 0 || (payload[0] & CORE_LINK_REQUEST_STATE_NAMES)) {
+                schedule_full_frame_with_names(peer);
+            } else {
+                schedule_full_frame(peer);
+            }
             if (s_request_cb) {
                 s_request_cb(s_request_ctx);
             }
             break;
         case CORE_LINK_MSG_TOUCH_EVENT:
-            if (length >= sizeof(core_link_touch_event_t) && s_touch_cb) {
+            if (peer->touch_batch) {
+                core_link_touch_event_t events[CORE_LINK_TOUCH_BATCH_MAX];
+                size_t count = core_link_touch_batch_decode(payload, length, events, CORE_LINK_TOUCH_BATCH_MAX);
+                if (count == 0) {
+                    ESP_LOGW(TAG, "Display %u: malformed TOUCH_EVENT batch (%u bytes)", peer->index, length);
+                }
+                for (size_t i = 0; i < count && s_touch_cb; ++i) {
+                    s_touch_cb(&events[i], &peer->display_info, s_touch_ctx);
+                }
+            } else if (length >= sizeof(core_link_touch_event_t) && s_touch_cb) {
                 core_link_touch_event_t event;
                 memcpy(&event, payload, sizeof(event));
-                s_touch_cb(&event, s_touch_ctx);
+                s_touch_cb(&event, &peer->display_info, s_touch_ctx);
             }
             break;
         case CORE_LINK_MSG_COMMAND: {
             if (length < 1) {
-                ESP_LOGW(TAG, "Command frame too short");
+                ESP_LOGW(TAG, "Display %u: command frame too short", peer->index);
                 break;
             }
 
             uint8_t opcode = payload[0];
+            size_t header_len = 1;
+            uint16_t request_id = CORE_LINK_REQUEST_ID_NONE;
+            if (peer->request_id && length >= 1 + CORE_LINK_REQUEST_ID_SIZE) {
+                request_id = (uint16_t)(payload[1] | (payload[2] << 8));
+                header_len += CORE_LINK_REQUEST_ID_SIZE;
+            }
             const char *argument_ptr = NULL;
             char argument[CORE_LINK_COMMAND_MAX_ARG_LEN] = {0};
-            if (length > 1) {
-                size_t arg_len = length - 1;
+            if (length > header_len) {
+                size_t arg_len = length - header_len;
                 if (arg_len >= sizeof(argument)) {
                     arg_len = sizeof(argument) - 1;
                 }
-                memcpy(argument, payload + 1, arg_len);
+                memcpy(argument, payload + header_len, arg_len);
                 argument[arg_len] = '\0';
                 argument_ptr = argument;
             }
@@ -801,8 +2006,8 @@ static void handle_frame(core_link_msg_type_t type, const uint8_t *payload, uint
             uint8_t terrarium_count = 0;
             esp_err_t status = ESP_ERR_NOT_SUPPORTED;
             if (s_command_cb) {
-                ESP_LOGI(TAG, "Command opcode=0x%02X arg=%s", opcode,
-                         argument_ptr && argument_ptr[0] ? argument_ptr : "<default>");
+                ESP_LOGI(TAG, "Display %u command opcode=0x%02X id=%u arg=%s", peer->index, opcode,
+                         (unsigned)request_id, argument_ptr && argument_ptr[0] ? argument_ptr : "<default>");
                 status = s_command_cb((core_link_command_opcode_t)opcode, argument_ptr, &terrarium_count, s_command_ctx);
             }
 
@@ -815,86 +2020,116 @@ static void handle_frame(core_link_msg_type_t type, const uint8_t *payload, uint
                 .status = (int32_t)status,
                 .terrarium_count = terrarium_count,
             };
-            esp_err_t ack_err = uart_send_frame(CORE_LINK_MSG_COMMAND_ACK, &ack, sizeof(ack));
+            uint8_t ack_payload[sizeof(ack) + CORE_LINK_REQUEST_ID_SIZE];
+            memcpy(ack_payload, &ack, sizeof(ack));
+            size_t ack_len = sizeof(ack);
+            if (peer->request_id) {
+                ack_payload[ack_len++] = (uint8_t)request_id;
+                ack_payload[ack_len++] = (uint8_t)(request_id >> 8);
+            }
+            // Only the display that asked waits for the ACK.
+            esp_err_t ack_err = send_frame(peer, CORE_LINK_MSG_COMMAND_ACK, ack_payload, (uint16_t)ack_len);
             if (ack_err != ESP_OK) {
-                ESP_LOGW(TAG, "Failed to send command ACK: %s", esp_err_to_name(ack_err));
+                ESP_LOGW(TAG, "Display %u: failed to send command ACK: %s", peer->index, esp_err_to_name(ack_err));
             }
             break;
         }
+        case CORE_LINK_MSG_NAK:
+            handle_nak(peer, payload, length);
+            break;
         case CORE_LINK_MSG_PING:
-            uart_send_frame(CORE_LINK_MSG_PONG, payload, length);
+            reply_pong(peer, payload, length);
             break;
         case CORE_LINK_MSG_PONG:
-            ESP_LOGV(TAG, "PONG received");
+            ESP_LOGV(TAG, "PONG received from display %u", peer->index);
+            handle_pong(peer, payload, length);
+            break;
+        case CORE_LINK_MSG_SUBSCRIBE:
+            handle_subscribe(peer, payload, length);
+            break;
+        case CORE_LINK_MSG_HISTORY_REQUEST:
+            handle_history_request(peer, payload, length);
+            break;
+        case CORE_LINK_MSG_BAUD_SWITCH_ACK:
+            handle_baud_switch_ack(peer, payload, length);
             break;
         case CORE_LINK_MSG_HELLO:
             // Display may unexpectedly send HELLO if it rebooted; respond with ACK.
             {
                 core_link_hello_ack_payload_t ack = {
                     .protocol_version = CORE_LINK_PROTOCOL_VERSION,
-                    .capabilities = 0x02, // host controller
+                    .capabilities = CORE_HOST_LINK_CAPABILITIES,
+                    .capabilities_ext = local_capabilities_ext(peer),
+                    .baud_mask = peer->baud_enabled ? peer->baud.local_mask : 0,
                 };
-                uart_send_frame(CORE_LINK_MSG_HELLO_ACK, &ack, sizeof(ack));
+                uint8_t peer_caps = length >= 2 ? payload[1] : 0;
+                uint8_t peer_caps_ext = length >= 3 ? payload[2] : 0;
+                uint16_t peer_baud_mask = length >= 3 + CORE_LINK_HELLO_BAUD_MASK_SIZE
+                                              ? (uint16_t)(payload[3] | (payload[4] << 8))
+                                              : 0;
+                reset_retransmit_history(peer, false);
+                reset_subscription(peer);
+                send_frame(peer, CORE_LINK_MSG_HELLO_ACK, &ack, sizeof(ack));
+                xSemaphoreTake(s_state_lock, portMAX_DELAY);
+                peer->compact_state = (peer_caps & CORE_LINK_CAP_COMPACT_STATE) != 0;
+                peer->fragments = (peer_caps & CORE_LINK_CAP_FRAGMENTS) != 0;
+                peer->name_table = peer->compact_state && (peer_caps & CORE_LINK_CAP_NAME_TABLE) != 0;
+                peer->link_stats = (peer_caps & CORE_LINK_CAP_LINK_STATS) != 0;
+                peer->touch_batch = (peer_caps & CORE_LINK_CAP_TOUCH_BATCH) != 0;
+                peer->sample_time = (peer_caps_ext & CORE_LINK_CAP_EXT_SAMPLE_TIME) != 0;
+                peer->full_compressed = (CORE_HOST_LINK_CAPABILITIES_EXT & peer_caps_ext &
+                                         CORE_LINK_CAP_EXT_FULL_COMPRESSED) != 0;
+                peer->request_id = (peer_caps_ext & CORE_LINK_CAP_EXT_REQUEST_ID) != 0;
+                set_peer_baud(peer, (peer_caps_ext & CORE_LINK_CAP_EXT_BAUD_SWITCH) ? peer_baud_mask : 0);
+                peer->clamp_warned = false;
+                reset_retransmit_history(peer, (peer_caps & CORE_LINK_CAP_FRAME_V2) != 0);
+                schedule_full_frame_locked(peer, true);
+                xSemaphoreGive(s_state_lock);
             }
-            if (!core_host_link_is_handshake_complete()) {
-                xEventGroupSetBits(s_events, CORE_HOST_EVENT_HANDSHAKE);
+            if (!peer_has_handshake(peer)) {
+                xEventGroupSetBits(s_events, CORE_HOST_EVENT_HANDSHAKE(peer->index));
             }
             break;
         default:
-            ESP_LOGW(TAG, "Unhandled frame type 0x%02X", type);
+            ESP_LOGW(TAG, "Display %u: unhandled frame type 0x%02X", peer->index, type);
             break;
     }
 }
 
 static void rx_task(void *arg)
 {
-    uint8_t header_buf[sizeof(core_link_frame_header_t)];
-    uint8_t payload_buf[CORE_LINK_MAX_PAYLOAD];
+    core_host_peer_t *peer = arg;
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, peer->rx_storage, sizeof(peer->rx_storage));
+    uint32_t reported_errors = 0;
 
     while (true) {
-        int read = uart_read_bytes(s_config.uart_port, header_buf, 1, portMAX_DELAY);
-        if (read != 1) {
-            continue;
-        }
-        if (header_buf[0] != CORE_LINK_SOF) {
-            continue;
-        }
-
-        int remaining = uart_read_bytes(s_config.uart_port, header_buf + 1, sizeof(core_link_frame_header_t) - 1, pdMS_TO_TICKS(50));
-        if (remaining != (int)(sizeof(core_link_frame_header_t) - 1)) {
-            continue;
+        uint8_t *window = NULL;
+        size_t room = core_link_stream_write_window(&stream, &window);
+
+        // The transport drains a whole burst per call; a partial frame only waits for its stall timeout.
+        uint32_t wait_ms = core_link_stream_buffered(&stream) > 0 ? CORE_HOST_RX_STALL_MS : CORE_LINK_TRANSPORT_WAIT_FOREVER;
+        int got = (room > 0) ? core_link_transport_read(&peer->transport, window, room, wait_ms) : 0;
+        if (got > 0) {
+            core_link_stream_commit(&stream, (size_t)got);
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_BYTES_RX, (uint32_t)got);
+        } else if (core_link_stream_buffered(&stream) > 0) {
+            // Partial frame stalled: discard its SOF and rescan the bytes behind it.
+            core_link_stream_skip_partial(&stream);
         }
 
-        core_link_frame_header_t header;
-        memcpy(&header, header_buf, sizeof(header));
-
-        if (header.length > CORE_LINK_MAX_PAYLOAD) {
-            ESP_LOGW(TAG, "Frame payload too large: %u", header.length);
-            uart_flush_input(s_config.uart_port);
-            continue;
+        core_link_stream_frame_t frame;
+        while (core_link_stream_next(&stream, &frame)) {
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_FRAMES_RX, 1);
+            handle_frame(peer, (core_link_msg_type_t)frame.type, frame.payload, frame.length);
         }
 
-        if (header.length > 0) {
-            int got = uart_read_bytes(s_config.uart_port, payload_buf, header.length, pdMS_TO_TICKS(50));
-            if (got != header.length) {
-                ESP_LOGW(TAG, "Failed to read payload (%d/%u)", got, header.length);
-                continue;
-            }
+        uint32_t errors = stream.stats.checksum_errors + stream.stats.oversize_errors;
+        if (errors != reported_errors) {
+            ESP_LOGW(TAG, "Display %u: dropped %u corrupted frame header(s) (%u bytes skipped so far)", peer->index,
+                     (unsigned)(errors - reported_errors), (unsigned)stream.stats.bytes_skipped);
+            core_link_stats_add(&peer->stats, CORE_LINK_STAT_CHECKSUM_ERRORS, errors - reported_errors);
+            reported_errors = errors;
         }
-
-        uint8_t rx_checksum = 0;
-        int chk = uart_read_bytes(s_config.uart_port, &rx_checksum, 1, pdMS_TO_TICKS(20));
-        if (chk != 1) {
-            ESP_LOGW(TAG, "Missing checksum byte");
-            continue;
-        }
-
-        uint8_t computed = checksum_compute(header.type, header.length, payload_buf);
-        if (computed != rx_checksum) {
-            ESP_LOGW(TAG, "Checksum mismatch (got 0x%02X expected 0x%02X)", rx_checksum, computed);
-            continue;
-        }
-
-        handle_frame((core_link_msg_type_t)header.type, payload_buf, header.length);
     }
 }
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "freertos/FreeRTOS.h"
 
 #include "esp_err.h"
+#include "link/core_link_history.h"
 #include "link/core_link_protocol.h"
+#include "link/core_link_stats.h"
+#include "link/core_link_transport.h"
+#include "link/core_link_tx_queue.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,38 +21,91 @@ typedef struct {
     uint16_t width;
     uint16_t height;
     uint8_t protocol_version;
+    uint8_t index; /* afficheur d'origine, dans l'ordre d'ajout (0 : celui de init) */
 } core_host_display_info_t;
 
 typedef void (*core_host_display_ready_cb_t)(const core_host_display_info_t *info, void *ctx);
 typedef void (*core_host_request_state_cb_t)(void *ctx);
-typedef void (*core_host_touch_cb_t)(const core_link_touch_event_t *event, void *ctx);
+/* `display` : afficheur d'origine, dont la largeur sert à situer le contact. */
+typedef void (*core_host_touch_cb_t)(const core_link_touch_event_t *event, const core_host_display_info_t *display,
+                                     void *ctx);
 typedef esp_err_t (*core_host_command_cb_t)(core_link_command_opcode_t opcode, const char *argument,
                                             uint8_t *out_terrarium_count, void *ctx);
+/* Écrit dans `out` la réponse HISTORY_CHUNK à `request` ; 0 : historique indisponible. */
+typedef size_t (*core_host_history_cb_t)(const core_link_history_request_t *request, uint8_t *out, size_t capacity,
+                                         void *ctx);
 
 typedef struct {
     int uart_port;
     int tx_gpio;
     int rx_gpio;
-    int baud_rate;
+    int baud_rate;      /* débit de démarrage et de repli */
+    int baud_rate_max;  /* plafond de la négociation (≤ baud_rate : débit fixe) */
     int task_stack_size;
     int task_priority;
     TickType_t handshake_timeout_ticks;
+    const core_link_transport_t *transport; /* NULL : UART décrite par les champs ci-dessus */
 } core_host_link_config_t;
 
+/* Afficheur supplémentaire : mêmes débits et tâches que celui de core_host_link_config_t. */
+typedef struct {
+    int uart_port;
+    int tx_gpio;
+    int rx_gpio;
+    const core_link_transport_t *transport; /* NULL : UART décrite par les champs ci-dessus */
+} core_host_display_config_t;
+
 esp_err_t core_host_link_init(const core_host_link_config_t *config);
+/**
+ * \brief Ajoute un afficheur, entre core_host_link_init et core_host_link_start.
+ *
+ * Chaque afficheur a son transport, sa poignée de main, sa base de delta et son
+ * abonnement ; une publication est encodée une fois puis déclinée par afficheur.
+ * Au plus CONFIG_CORE_APP_LINK_DISPLAY_COUNT afficheurs, init compris.
+ */
+esp_err_t core_host_link_add_display(const core_host_display_config_t *config);
 esp_err_t core_host_link_start(void);
 esp_err_t core_host_link_send_hello(void);
 esp_err_t core_host_link_send_state(const core_link_state_frame_t *frame);
 esp_err_t core_host_link_send_ping(void);
 esp_err_t core_host_link_wait_for_display_ready(TickType_t ticks_to_wait);
+/* Avec plusieurs afficheurs, « complete » et « ready » valent pour au moins l'un d'eux. */
 bool core_host_link_is_handshake_complete(void);
+/** Au moins un afficheur n'a pas encore répondu au HELLO. */
+bool core_host_link_is_handshake_pending(void);
 bool core_host_link_is_display_ready(void);
+size_t core_host_link_get_display_count(void);
+/** Version du premier afficheur ayant répondu au HELLO. */
 uint8_t core_host_link_get_peer_version(void);
+/** Premier afficheur prêt ; chaque afficheur se signale aussi par le callback DISPLAY_READY. */
 const core_host_display_info_t *core_host_link_get_display_info(void);
 esp_err_t core_host_link_register_display_ready_cb(core_host_display_ready_cb_t cb, void *ctx);
 esp_err_t core_host_link_register_request_cb(core_host_request_state_cb_t cb, void *ctx);
 esp_err_t core_host_link_register_touch_cb(core_host_touch_cb_t cb, void *ctx);
 esp_err_t core_host_link_register_command_cb(core_host_command_cb_t cb, void *ctx);
+/**
+ * \brief Sert les HISTORY_REQUEST des afficheurs.
+ *
+ * À enregistrer avant core_host_link_start : la capacité
+ * CORE_LINK_CAP_EXT_HISTORY n'est annoncée dans le HELLO qu'avec un callback.
+ * Chaque requête reçoit un seul HISTORY_CHUNK, émis dans la classe BULK.
+ */
+esp_err_t core_host_link_register_history_cb(core_host_history_cb_t cb, void *ctx);
+/** Profondeur de la file d'émission et latence d'envoi par classe de priorité (afficheur 0). */
+esp_err_t core_host_link_get_tx_stats(core_link_tx_stats_t *out_stats);
+/**
+ * \brief Comme core_host_link_get_tx_stats, pour l'afficheur d'indice `display`.
+ * @return ESP_ERR_INVALID_ARG si `display` >= core_host_link_get_display_count().
+ */
+esp_err_t core_host_link_get_tx_stats_for(size_t display, core_link_tx_stats_t *out_stats);
+/**
+ * \brief Compteurs de télémétrie du cœur (trames, octets, erreurs, RTT) vers l'afficheur 0.
+ *
+ * Chaque afficheur reçoit les siens toutes les CONFIG_CORE_APP_LINK_STATS_INTERVAL_MS.
+ */
+esp_err_t core_host_link_get_link_stats(core_link_stats_snapshot_t *out_stats);
+/** Comme core_host_link_get_link_stats, pour l'afficheur d'indice `display`. */
+esp_err_t core_host_link_get_link_stats_for(size_t display, core_link_stats_snapshot_t *out_stats);
 
 #ifdef __cplusplus
 }
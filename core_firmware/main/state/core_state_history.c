@@ -0,0 +1,245 @@
+#include "state/core_state_history.h"
+
+#include <math.h>
+#include <string.h>
+
+#define METRICS CORE_LINK_HISTORY_METRIC_COUNT
+
+// Open bucket of one tier for one slot.
+typedef struct {
+    float min[METRICS];
+    float max[METRICS];
+    float sum[METRICS];
+    uint32_t samples;
+} history_accum_t;
+
+static history_accum_t *accum_of(const core_state_history_t *history, size_t slot, size_t tier)
+{
+    return (history_accum_t *)(history->storage + slot * history->slot_bytes) + tier;
+}
+
+static core_link_history_bucket_t *ring_of(const core_state_history_t *history, size_t slot, size_t tier)
+{
+    return (core_link_history_bucket_t *)(history->storage + slot * history->slot_bytes + history->ring_offset[tier]);
+}
+
+static void reset_accum(history_accum_t *accum)
+{
+    for (size_t m = 0; m < METRICS; ++m) {
+        accum->min[m] = INFINITY;
+        accum->max[m] = -INFINITY;
+        accum->sum[m] = 0.0f;
+    }
+    accum->samples = 0;
+}
+
+static void reset_slot(core_state_history_t *history, size_t slot)
+{
+    memset(history->storage + slot * history->slot_bytes, 0, history->slot_bytes);
+    for (size_t t = 0; t < CORE_STATE_HISTORY_TIERS; ++t) {
+        reset_accum(accum_of(history, slot, t));
+    }
+}
+
+size_t core_state_history_storage_size(const uint16_t depth[CORE_STATE_HISTORY_TIERS], size_t capacity)
+{
+    size_t slot_bytes = CORE_STATE_HISTORY_TIERS * sizeof(history_accum_t);
+    for (size_t t = 0; t < CORE_STATE_HISTORY_TIERS; ++t) {
+        slot_bytes += depth[t] * sizeof(core_link_history_bucket_t);
+    }
+    // Keeps the next slot's accumulators aligned for their floats.
+    slot_bytes = (slot_bytes + 3U) & ~(size_t)3U;
+    return slot_bytes * capacity;
+}
+
+void core_state_history_init(core_state_history_t *history, void *storage,
+                             const uint16_t depth[CORE_STATE_HISTORY_TIERS], size_t capacity,
+                             const core_state_history_t *clock)
+{
+    memset(history, 0, sizeof(*history));
+    history->capacity = storage ? capacity : 0;
+    history->storage = storage;
+    history->slot_bytes = capacity ? core_state_history_storage_size(depth, capacity) / capacity : 0;
+    size_t offset = CORE_STATE_HISTORY_TIERS * sizeof(history_accum_t);
+    for (size_t t = 0; t < CORE_STATE_HISTORY_TIERS; ++t) {
+        history->depth[t] = depth[t];
+        history->ring_offset[t] = offset;
+        offset += depth[t] * sizeof(core_link_history_bucket_t);
+    }
+    if (clock) {
+        history->started = clock->started;
+        memcpy(history->open, clock->open, sizeof(history->open));
+        memcpy(history->newest, clock->newest, sizeof(history->newest));
+        memcpy(history->filled, clock->filled, sizeof(history->filled));
+    }
+    for (size_t slot = 0; slot < history->capacity; ++slot) {
+        reset_slot(history, slot);
+    }
+}
+
+void core_state_history_move_slot(core_state_history_t *dst, size_t dst_slot, const core_state_history_t *src,
+                                  size_t src_slot)
+{
+    if (dst_slot >= dst->capacity || src_slot >= src->capacity || dst->slot_bytes != src->slot_bytes) {
+        return;
+    }
+    memcpy(dst->storage + dst_slot * dst->slot_bytes, src->storage + src_slot * src->slot_bytes, dst->slot_bytes);
+}
+
+static void finalize(const history_accum_t *accum, core_link_history_bucket_t *bucket)
+{
+    memset(bucket, 0, sizeof(*bucket));
+    if (accum->samples == 0) {
+        return;
+    }
+    bucket->samples = accum->samples > UINT16_MAX ? UINT16_MAX : (uint16_t)accum->samples;
+    float inv = 1.0f / (float)accum->samples;
+    for (size_t m = 0; m < METRICS; ++m) {
+        bucket->min[m] = core_link_history_quantize(m, accum->min[m]);
+        bucket->max[m] = core_link_history_quantize(m, accum->max[m]);
+        bucket->mean[m] = core_link_history_quantize(m, accum->sum[m] * inv);
+    }
+}
+
+static void fold(const history_accum_t *from, history_accum_t *into)
+{
+    for (size_t m = 0; m < METRICS; ++m) {
+        into->min[m] = fminf(into->min[m], from->min[m]);
+        into->max[m] = fmaxf(into->max[m], from->max[m]);
+        into->sum[m] += from->sum[m];
+    }
+    into->samples += from->samples;
+}
+
+// Closes the open bucket of `tier`, then pushes `elapsed - 1` empty ones for the
+// buckets skipped over. Runs once per bucket, not per step. A gap longer than
+// the ring only wipes it: the closed bucket would be pushed out anyway.
+static void close_tier(core_state_history_t *history, size_t tier, uint32_t elapsed)
+{
+    uint16_t depth = history->depth[tier];
+    bool keep = elapsed <= depth;
+    uint32_t pushes = keep ? elapsed : depth;
+    for (uint32_t n = 0; n < pushes; ++n) {
+        history->newest[tier] = (uint16_t)((history->newest[tier] + 1U) % depth);
+        if (history->filled[tier] < depth) {
+            ++history->filled[tier];
+        }
+        for (size_t slot = 0; slot < history->capacity; ++slot) {
+            core_link_history_bucket_t *bucket = &ring_of(history, slot, tier)[history->newest[tier]];
+            if (n > 0 || !keep) {
+                memset(bucket, 0, sizeof(*bucket));
+            }
+        }
+    }
+    for (size_t slot = 0; slot < history->capacity; ++slot) {
+        history_accum_t *accum = accum_of(history, slot, tier);
+        if (keep) {
+            size_t position = (history->newest[tier] + depth - (elapsed - 1U)) % depth;
+            finalize(accum, &ring_of(history, slot, tier)[position]);
+        }
+        if (tier + 1U < CORE_STATE_HISTORY_TIERS) {
+            fold(accum, accum + 1);
+        }
+        reset_accum(accum);
+    }
+}
+
+void core_state_history_record(core_state_history_t *history, const core_state_soa_t *soa, uint32_t epoch)
+{
+    if (history->capacity == 0) {
+        return;
+    }
+    if (!history->started) {
+        for (size_t t = 0; t < CORE_STATE_HISTORY_TIERS; ++t) {
+            history->open[t] = epoch / core_link_history_tier_seconds((uint8_t)t);
+        }
+        history->started = true;
+    }
+    // Coarser buckets are whole multiples of finer ones: a tier can only roll
+    // over together with the tier below, after it has folded its last bucket.
+    for (size_t t = 0; t < CORE_STATE_HISTORY_TIERS; ++t) {
+        uint32_t bucket = epoch / core_link_history_tier_seconds((uint8_t)t);
+        if (bucket <= history->open[t]) {
+            break; /* same bucket, or the clock stepped back */
+        }
+        close_tier(history, t, bucket - history->open[t]);
+        history->open[t] = bucket;
+    }
+
+    const float *values[METRICS] = {
+        soa->temp_day, soa->temp_night, soa->humidity_day, soa->humidity_night, soa->lux_day,
+        soa->lux_night, soa->hydration,  soa->stress,       soa->health,         soa->activity,
+    };
+    size_t count = soa->count < history->capacity ? soa->count : history->capacity;
+    for (size_t slot = 0; slot < count; ++slot) {
+        history_accum_t *accum = accum_of(history, slot, 0);
+        for (size_t m = 0; m < METRICS; ++m) {
+            float value = values[m][slot];
+            accum->min[m] = fminf(accum->min[m], value);
+            accum->max[m] = fmaxf(accum->max[m], value);
+            accum->sum[m] += value;
+        }
+        ++accum->samples;
+    }
+}
+
+bool core_state_history_bucket(const core_state_history_t *history, size_t slot, uint8_t tier, size_t index,
+                               core_link_history_bucket_t *bucket)
+{
+    if (slot >= history->capacity || tier >= CORE_STATE_HISTORY_TIERS || index >= history->filled[tier]) {
+        return false;
+    }
+    uint16_t depth = history->depth[tier];
+    size_t position = (history->newest[tier] + depth - index % depth) % depth;
+    *bucket = ring_of(history, slot, tier)[position];
+    return true;
+}
+
+size_t core_state_history_encode_chunk(const core_state_history_t *history, size_t slot,
+                                       const core_link_history_request_t *request, uint8_t *out, size_t capacity)
+{
+    core_link_history_chunk_t chunk = {
+        .terrarium_id = request->terrarium_id,
+        .tier = request->tier,
+        .status = CORE_LINK_HISTORY_OK,
+        .field_mask = request->field_mask & CORE_LINK_HISTORY_FIELDS,
+    };
+    if (capacity < CORE_LINK_HISTORY_CHUNK_HEADER_SIZE) {
+        return 0;
+    }
+    uint32_t seconds = core_link_history_tier_seconds(request->tier);
+    if (history->capacity == 0 || seconds == 0) {
+        chunk.status = CORE_LINK_HISTORY_UNAVAILABLE;
+    } else if (slot >= history->capacity) {
+        chunk.status = CORE_LINK_HISTORY_UNKNOWN_TERRARIUM;
+    }
+    if (chunk.status != CORE_LINK_HISTORY_OK) {
+        return core_link_history_chunk_encode_header(&chunk, out, capacity);
+    }
+
+    // Skip the buckets that end after `before_epoch`.
+    uint32_t newest_end = history->open[request->tier] * seconds;
+    size_t first = 0;
+    if (request->before_epoch != 0 && request->before_epoch < newest_end) {
+        first = (newest_end - request->before_epoch + seconds - 1U) / seconds;
+    }
+    uint64_t skipped_s = (uint64_t)first * seconds;
+    chunk.end_epoch = skipped_s < newest_end ? newest_end - (uint32_t)skipped_s : 0;
+
+    size_t length = CORE_LINK_HISTORY_CHUNK_HEADER_SIZE;
+    core_link_history_bucket_t bucket;
+    while (chunk.count < request->max_buckets &&
+           core_state_history_bucket(history, slot, request->tier, first + chunk.count, &bucket)) {
+        size_t written = core_link_history_bucket_encode(chunk.field_mask, &bucket, &out[length], capacity - length);
+        if (written == 0) {
+            break;
+        }
+        length += written;
+        ++chunk.count;
+    }
+    if (first + chunk.count < history->filled[request->tier]) {
+        chunk.flags |= CORE_LINK_HISTORY_FLAG_MORE;
+    }
+    core_link_history_chunk_encode_header(&chunk, out, capacity);
+    return length;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_history.h"
+#include "state/core_state_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Historique multi-résolution des métriques des terrariums, sans dépendance
+ * ESP-IDF, en mémoire fixe allouée par l'appelant.
+ *
+ * Chaque emplacement possède un anneau de seaux par palier (minute, quart
+ * d'heure, six heures ; core_link_history.h) et un accumulateur min/max/somme
+ * pour le seau ouvert. Un pas ne touche que l'accumulateur minute ; à la
+ * fermeture d'un seau, son accumulateur est replié dans celui du palier
+ * supérieur, si bien que les moyennes longues restent exactes et que le coût
+ * par pas est constant. Les seaux sont alignés sur l'epoch simulée, commune
+ * à tous les emplacements : un seul jeu d'indices d'anneau par palier.
+ */
+
+#define CORE_STATE_HISTORY_TIERS CORE_LINK_HISTORY_TIER_COUNT
+
+typedef struct {
+    size_t capacity;   /* emplacements historisés */
+    size_t slot_bytes; /* accumulateurs puis anneaux d'un emplacement */
+    uint16_t depth[CORE_STATE_HISTORY_TIERS];
+    size_t ring_offset[CORE_STATE_HISTORY_TIERS];
+    uint8_t *storage;
+    /* Horloge commune. */
+    bool started;
+    uint32_t open[CORE_STATE_HISTORY_TIERS];   /* numéro (epoch / durée) du seau ouvert */
+    uint16_t newest[CORE_STATE_HISTORY_TIERS]; /* position du dernier seau fermé */
+    uint16_t filled[CORE_STATE_HISTORY_TIERS]; /* seaux fermés disponibles */
+} core_state_history_t;
+
+/** Octets à fournir à core_state_history_init() ; `depth` ≥ 1 par palier. */
+size_t core_state_history_storage_size(const uint16_t depth[CORE_STATE_HISTORY_TIERS], size_t capacity);
+
+/**
+ * \brief Prépare un historique vide de `capacity` emplacements dans `storage`
+ * (aligné sur 4 octets).
+ *
+ * `clock`, s'il n'est pas NULL, est l'historique remplacé (même `depth`) :
+ * son horloge est reprise pour que core_state_history_move_slot() puisse y
+ * prendre des emplacements. `storage` peut être NULL si `capacity` vaut 0.
+ */
+void core_state_history_init(core_state_history_t *history, void *storage,
+                             const uint16_t depth[CORE_STATE_HISTORY_TIERS], size_t capacity,
+                             const core_state_history_t *clock);
+
+/** Copie l'historique de l'emplacement `src_slot` de `src` dans `dst_slot` de `dst`. */
+void core_state_history_move_slot(core_state_history_t *dst, size_t dst_slot, const core_state_history_t *src,
+                                  size_t src_slot);
+
+/**
+ * \brief Verse l'état du pas daté `epoch` dans l'historique.
+ *
+ * Les emplacements [0, min(capacity, soa->count)) sont échantillonnés. Un
+ * saut de l'epoch au-delà d'un seau laisse des seaux vides (0 échantillon).
+ */
+void core_state_history_record(core_state_history_t *history, const core_state_soa_t *soa, uint32_t epoch);
+
+/**
+ * \brief Seau fermé `index` (0 : le plus récent) du palier `tier`.
+ * @return false au-delà des seaux disponibles.
+ */
+bool core_state_history_bucket(const core_state_history_t *history, size_t slot, uint8_t tier, size_t index,
+                               core_link_history_bucket_t *bucket);
+
+/**
+ * \brief Sérialise la réponse HISTORY_CHUNK à `request` pour l'emplacement `slot`.
+ *
+ * Autant de seaux que `capacity` et `request->max_buckets` le permettent ; le
+ * seau ouvert n'est jamais transmis. Un `slot` hors capacité donne le statut
+ * CORE_LINK_HISTORY_UNKNOWN_TERRARIUM.
+ *
+ * @return Longueur de la charge, 0 si `capacity` ne contient pas l'en-tête.
+ */
+size_t core_state_history_encode_chunk(const core_state_history_t *history, size_t slot,
+                                       const core_link_history_request_t *request, uint8_t *out, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+#include "state/core_state_index.h"
+
+#include <string.h>
+
+size_t core_state_index_build(core_state_index_t *index, const core_state_soa_t *soa)
+{
+    memset(index->slots, 0xFF, sizeof(index->slots));
+    size_t shadowed = 0;
+    // Indices above 0xFFFE cannot be stored; CORE_STATE_MAX_TERRARIUMS stays far below.
+    for (size_t i = 0; i < soa->count && i < CORE_STATE_INDEX_NONE; ++i) {
+        uint16_t *slot = &index->slots[soa->info[i].id];
+        if (*slot != CORE_STATE_INDEX_NONE) {
+            ++shadowed;
+            continue;
+        }
+        *slot = (uint16_t)i;
+    }
+    return shadowed;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "state/core_state_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Table identifiant → indice d'emplacement, sans dépendance ESP-IDF.
+ *
+ * Les identifiants tiennent sur un octet dans le protocole : une table directe
+ * de 256 entrées (512 octets) répond en O(1) sans collision ni sonde, quelle
+ * que soit la capacité du pool. Elle est reconstruite à chaque remplacement
+ * du pool, sous le même verrou que lui.
+ */
+
+#define CORE_STATE_INDEX_NONE 0xFFFFU
+
+typedef struct {
+    uint16_t slots[256];
+} core_state_index_t;
+
+/**
+ * \brief Indexe les `soa->count` emplacements de `soa`.
+ *
+ * En cas de doublon, le premier emplacement portant l'identifiant l'emporte.
+ *
+ * @return Nombre d'emplacements masqués par un doublon.
+ */
+size_t core_state_index_build(core_state_index_t *index, const core_state_soa_t *soa);
+
+/** Indice de l'emplacement `id`, ou CORE_STATE_INDEX_NONE. */
+static inline uint16_t core_state_index_find(const core_state_index_t *index, uint8_t id)
+{
+    return index->slots[id];
+}
+
+#ifdef __cplusplus
+}
+#endif
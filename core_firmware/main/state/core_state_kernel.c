@@ -0,0 +1,328 @@
+#include "state/core_state_kernel.h"
+
+#include <math.h>
+#include <string.h>
+
+#define CORE_STATE_ALIGN 16U
+#define CORE_STATE_FLOAT_ARRAYS 26U
+
+#define CORE_STATE_TWO_PI 6.283185307179586
+
+// Angular speed and phase multipliers of each oscillator, see core_state_osc_t.
+static const float s_osc_speed[CORE_STATE_OSC_COUNT] = {1.0f, 0.7f, 0.55f, 1.4f};
+static const float s_osc_phase[CORE_STATE_OSC_COUNT] = {1.0f, 1.2f, 1.0f, 1.0f};
+
+static inline float clampf(float value, float min, float max)
+{
+    value = value < min ? min : value;
+    return value > max ? max : value;
+}
+
+// Rotates the phasor (re, im) by theta. theta stays below ~0.15 rad
+// (CORE_STATE_OSC_MAX_ADVANCE_S), where the fifth-order series is off by < 1e-7
+// in modulus and < 1e-8 rad in phase per step.
+static inline void osc_advance(float *re, float *im, float theta)
+{
+    float theta2 = theta * theta;
+    float c = 1.0f - theta2 * (0.5f - theta2 * (1.0f / 24.0f));
+    float s = theta * (1.0f - theta2 * ((1.0f / 6.0f) - theta2 * (1.0f / 120.0f)));
+    float r = *re;
+    float m = *im;
+    *re = r * c - m * s;
+    *im = r * s + m * c;
+}
+
+static size_t padded_capacity(size_t capacity)
+{
+    size_t lanes = CORE_STATE_ALIGN / sizeof(float);
+    return (capacity + lanes - 1U) / lanes * lanes;
+}
+
+static size_t info_bytes(size_t capacity)
+{
+    size_t bytes = capacity * sizeof(core_state_slot_info_t);
+    return (bytes + CORE_STATE_ALIGN - 1U) / CORE_STATE_ALIGN * CORE_STATE_ALIGN;
+}
+
+size_t core_state_soa_storage_size(size_t capacity)
+{
+    // Named float arrays, the u32 feeding timestamps and the phasors, each padded to whole vectors.
+    size_t arrays = CORE_STATE_FLOAT_ARRAYS + 1U + 2U * CORE_STATE_OSC_COUNT;
+    return info_bytes(capacity) + arrays * padded_capacity(capacity) * sizeof(float);
+}
+
+void core_state_soa_init(core_state_soa_t *soa, void *storage, size_t capacity)
+{
+    memset(soa, 0, sizeof(*soa));
+    soa->capacity = capacity;
+    uint8_t *cursor = storage;
+    soa->info = (core_state_slot_info_t *)cursor;
+    cursor += info_bytes(capacity);
+
+    size_t stride = padded_capacity(capacity) * sizeof(float);
+    float **arrays[CORE_STATE_FLOAT_ARRAYS] = {
+        &soa->cycle_speed,       &soa->phase_offset,    &soa->base_temp_day,      &soa->base_temp_night,
+        &soa->base_humidity_day, &soa->base_humidity_night, &soa->base_lux_day,   &soa->base_lux_night,
+        &soa->target_hydration,  &soa->target_stress,   &soa->target_health,      &soa->hydration_floor,
+        &soa->stress_wave_amp,   &soa->feeding_interval_s, &soa->feeding_inv_interval, &soa->feeding_recovery,
+        &soa->temp_day,          &soa->temp_night,      &soa->humidity_day,       &soa->humidity_night,
+        &soa->lux_day,           &soa->lux_night,       &soa->hydration,          &soa->stress,
+        &soa->health,            &soa->activity,
+    };
+    for (size_t i = 0; i < CORE_STATE_FLOAT_ARRAYS; ++i) {
+        *arrays[i] = (float *)cursor;
+        cursor += stride;
+    }
+    soa->last_feeding = (uint32_t *)cursor;
+    cursor += stride;
+    for (size_t k = 0; k < CORE_STATE_OSC_COUNT; ++k) {
+        soa->osc_re[k] = (float *)cursor;
+        soa->osc_im[k] = (float *)(cursor + stride);
+        cursor += 2U * stride;
+    }
+}
+
+void core_state_soa_store(core_state_soa_t *soa, size_t index, const core_state_slot_t *slot)
+{
+    core_state_slot_info_t *info = &soa->info[index];
+    info->id = slot->id;
+    memcpy(info->scientific_name, slot->scientific_name, sizeof(info->scientific_name));
+    memcpy(info->common_name, slot->common_name, sizeof(info->common_name));
+    info->feeding_interval_hours = slot->feeding_interval_hours;
+    info->feeding_intake_pct = slot->feeding_intake_pct;
+    info->enrichment_factor = slot->enrichment_factor;
+
+    soa->cycle_speed[index] = slot->cycle_speed;
+    soa->phase_offset[index] = slot->phase_offset;
+    soa->base_temp_day[index] = slot->base_temp_day;
+    soa->base_temp_night[index] = slot->base_temp_night;
+    soa->base_humidity_day[index] = slot->base_humidity_day;
+    soa->base_humidity_night[index] = slot->base_humidity_night;
+    soa->base_lux_day[index] = slot->base_lux_day;
+    soa->base_lux_night[index] = slot->base_lux_night;
+    soa->target_hydration[index] = slot->target_hydration_pct;
+    soa->target_stress[index] = slot->target_stress_pct;
+    soa->target_health[index] = slot->target_health_pct;
+
+    // Everything the step derives from the profile alone is computed once here.
+    float enrichment = fmaxf(slot->enrichment_factor, 0.5f);
+    float hydration_span = fmaxf(5.0f, 12.0f / enrichment);
+    float interval_s = slot->feeding_interval_hours * 3600.0f;
+    soa->hydration_floor[index] =
+        clampf(slot->target_hydration_pct - hydration_span, 0.0f, slot->target_hydration_pct);
+    soa->stress_wave_amp[index] = 6.0f / enrichment;
+    soa->feeding_interval_s[index] = interval_s;
+    soa->feeding_inv_interval[index] = 1.0f / interval_s;
+    soa->feeding_recovery[index] = fminf(slot->feeding_intake_pct * 0.12f, 10.0f);
+
+    soa->temp_day[index] = slot->current_temp_day;
+    soa->temp_night[index] = slot->current_temp_night;
+    soa->humidity_day[index] = slot->current_humidity_day;
+    soa->humidity_night[index] = slot->current_humidity_night;
+    soa->lux_day[index] = slot->current_lux_day;
+    soa->lux_night[index] = slot->current_lux_night;
+    soa->hydration[index] = slot->hydration_pct;
+    soa->stress[index] = slot->stress_pct;
+    soa->health[index] = slot->health_pct;
+    soa->activity[index] = slot->activity_score;
+    soa->last_feeding[index] = slot->last_feeding_timestamp;
+    core_state_soa_anchor(soa, index, index + 1U, 0.0);
+}
+
+void core_state_soa_load(const core_state_soa_t *soa, size_t index, core_state_slot_t *slot)
+{
+    const core_state_slot_info_t *info = &soa->info[index];
+    memset(slot, 0, sizeof(*slot));
+    slot->id = info->id;
+    memcpy(slot->scientific_name, info->scientific_name, sizeof(slot->scientific_name));
+    memcpy(slot->common_name, info->common_name, sizeof(slot->common_name));
+    slot->feeding_interval_hours = info->feeding_interval_hours;
+    slot->feeding_intake_pct = info->feeding_intake_pct;
+    slot->enrichment_factor = info->enrichment_factor;
+
+    slot->cycle_speed = soa->cycle_speed[index];
+    slot->phase_offset = soa->phase_offset[index];
+    slot->base_temp_day = soa->base_temp_day[index];
+    slot->base_temp_night = soa->base_temp_night[index];
+    slot->base_humidity_day = soa->base_humidity_day[index];
+    slot->base_humidity_night = soa->base_humidity_night[index];
+    slot->base_lux_day = soa->base_lux_day[index];
+    slot->base_lux_night = soa->base_lux_night[index];
+    slot->target_hydration_pct = soa->target_hydration[index];
+    slot->target_stress_pct = soa->target_stress[index];
+    slot->target_health_pct = soa->target_health[index];
+    slot->current_temp_day = soa->temp_day[index];
+    slot->current_temp_night = soa->temp_night[index];
+    slot->current_humidity_day = soa->humidity_day[index];
+    slot->current_humidity_night = soa->humidity_night[index];
+    slot->current_lux_day = soa->lux_day[index];
+    slot->current_lux_night = soa->lux_night[index];
+    slot->hydration_pct = soa->hydration[index];
+    slot->stress_pct = soa->stress[index];
+    slot->health_pct = soa->health[index];
+    slot->activity_score = soa->activity[index];
+    slot->last_feeding_timestamp = soa->last_feeding[index];
+}
+
+void core_state_soa_anchor(core_state_soa_t *soa, size_t begin, size_t end, double time_s)
+{
+    if (end > soa->capacity) {
+        end = soa->capacity;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        double angle = (double)soa->cycle_speed[i] * time_s;
+        for (size_t k = 0; k < CORE_STATE_OSC_COUNT; ++k) {
+            double phase =
+                fmod(angle * s_osc_speed[k], CORE_STATE_TWO_PI) + (double)soa->phase_offset[i] * s_osc_phase[k];
+            soa->osc_re[k][i] = (float)cos(phase);
+            soa->osc_im[k][i] = (float)sin(phase);
+        }
+    }
+}
+
+void core_state_kernel_advance_waves(core_state_soa_t *soa, size_t begin, size_t end, float advance_s)
+{
+    if (end > soa->count) {
+        end = soa->count;
+    }
+    const float *restrict cycle_speed = soa->cycle_speed;
+    float *restrict climate_re = soa->osc_re[CORE_STATE_OSC_CLIMATE];
+    float *restrict climate_im = soa->osc_im[CORE_STATE_OSC_CLIMATE];
+    float *restrict humidity_re = soa->osc_re[CORE_STATE_OSC_HUMIDITY];
+    float *restrict humidity_im = soa->osc_im[CORE_STATE_OSC_HUMIDITY];
+    float *restrict stress_re = soa->osc_re[CORE_STATE_OSC_STRESS];
+    float *restrict stress_im = soa->osc_im[CORE_STATE_OSC_STRESS];
+    float *restrict activity_re = soa->osc_re[CORE_STATE_OSC_ACTIVITY];
+    float *restrict activity_im = soa->osc_im[CORE_STATE_OSC_ACTIVITY];
+
+    // One small rotation per oscillator replaces a sine of the absolute time.
+#pragma GCC ivdep
+    for (size_t i = begin; i < end; ++i) {
+        float theta = cycle_speed[i] * advance_s;
+        float climate_r = climate_re[i], climate_i = climate_im[i];
+        float humidity_r = humidity_re[i], humidity_i = humidity_im[i];
+        float stress_r = stress_re[i], stress_i = stress_im[i];
+        float activity_r = activity_re[i], activity_i = activity_im[i];
+        osc_advance(&climate_r, &climate_i, theta * s_osc_speed[CORE_STATE_OSC_CLIMATE]);
+        osc_advance(&humidity_r, &humidity_i, theta * s_osc_speed[CORE_STATE_OSC_HUMIDITY]);
+        osc_advance(&stress_r, &stress_i, theta * s_osc_speed[CORE_STATE_OSC_STRESS]);
+        osc_advance(&activity_r, &activity_i, theta * s_osc_speed[CORE_STATE_OSC_ACTIVITY]);
+        climate_re[i] = climate_r;
+        climate_im[i] = climate_i;
+        humidity_re[i] = humidity_r;
+        humidity_im[i] = humidity_i;
+        stress_re[i] = stress_r;
+        stress_im[i] = stress_i;
+        activity_re[i] = activity_r;
+        activity_im[i] = activity_i;
+    }
+}
+
+void core_state_kernel_update(core_state_soa_t *soa, size_t begin, size_t end, const core_state_step_t *step)
+{
+    if (end > soa->count) {
+        end = soa->count;
+    }
+    core_state_kernel_advance_waves(soa, begin, end, step->advance_s);
+
+    const uint32_t now = step->now_epoch;
+    const float hydration_smooth = fminf(step->delta_seconds * 0.8f, 1.0f);
+    const float stress_smooth = fminf(step->delta_seconds * 0.6f, 1.0f);
+    const float health_smooth = fminf(step->delta_seconds * 0.5f, 1.0f);
+
+    // Restrict-qualified locals: the arrays never alias, which the compiler cannot prove on its own.
+    const float *restrict base_temp_day = soa->base_temp_day;
+    const float *restrict base_temp_night = soa->base_temp_night;
+    const float *restrict base_humidity_day = soa->base_humidity_day;
+    const float *restrict base_humidity_night = soa->base_humidity_night;
+    const float *restrict base_lux_day = soa->base_lux_day;
+    const float *restrict base_lux_night = soa->base_lux_night;
+    const float *restrict target_hydration = soa->target_hydration;
+    const float *restrict target_stress = soa->target_stress;
+    const float *restrict target_health = soa->target_health;
+    const float *restrict hydration_floor = soa->hydration_floor;
+    const float *restrict stress_wave_amp = soa->stress_wave_amp;
+    const float *restrict feeding_interval_s = soa->feeding_interval_s;
+    const float *restrict feeding_inv_interval = soa->feeding_inv_interval;
+    const float *restrict feeding_recovery = soa->feeding_recovery;
+    float *restrict temp_day = soa->temp_day;
+    float *restrict temp_night = soa->temp_night;
+    float *restrict humidity_day = soa->humidity_day;
+    float *restrict humidity_night = soa->humidity_night;
+    float *restrict lux_day = soa->lux_day;
+    float *restrict lux_night = soa->lux_night;
+    float *restrict hydration = soa->hydration;
+    float *restrict stress = soa->stress;
+    float *restrict health = soa->health;
+    float *restrict activity = soa->activity;
+    uint32_t *restrict last_feeding = soa->last_feeding;
+    const float *restrict climate_im = soa->osc_im[CORE_STATE_OSC_CLIMATE];
+    const float *restrict humidity_re = soa->osc_re[CORE_STATE_OSC_HUMIDITY];
+    const float *restrict stress_re = soa->osc_re[CORE_STATE_OSC_STRESS];
+    const float *restrict activity_im = soa->osc_im[CORE_STATE_OSC_ACTIVITY];
+
+    // Both outcomes of every condition are computed and blended: no branch
+    // depends on slot data. GCC ignores restrict on locals, hence ivdep.
+#pragma GCC ivdep
+    for (size_t i = begin; i < end; ++i) {
+        float wave = climate_im[i];
+        float wave_secondary = humidity_re[i];
+
+        temp_day[i] = base_temp_day[i] + wave * 1.8f;
+        temp_night[i] = base_temp_night[i] + wave * 1.0f;
+        humidity_day[i] = clampf(base_humidity_day[i] + wave_secondary * 6.0f, 30.0f, 95.0f);
+        humidity_night[i] = clampf(base_humidity_night[i] + wave_secondary * 4.0f, 40.0f, 98.0f);
+        lux_day[i] = clampf(base_lux_day[i] + wave * 80.0f, 50.0f, 900.0f);
+        lux_night[i] = clampf(base_lux_night[i] + (wave_secondary + 1.0f) * 2.0f, 0.0f, 20.0f);
+
+        // Hydration drains towards its floor over a feeding interval; a meal restores it.
+        uint32_t last = last_feeding[i];
+        float elapsed = (float)(int32_t)(now - last);
+        elapsed = elapsed > 0.0f ? elapsed : 0.0f; /* clock stepped back */
+        float fed = elapsed >= feeding_interval_s[i] ? 1.0f : 0.0f;
+        float hydration_target = target_hydration[i];
+        float stress_target = target_stress[i];
+        float recovery = feeding_recovery[i];
+        float desired_hydration =
+            hydration_target - (hydration_target - hydration_floor[i]) * (elapsed * feeding_inv_interval[i]);
+        float h = hydration[i];
+        float h_fed = hydration_target + recovery;
+        float h_drift = h + (desired_hydration - h) * hydration_smooth;
+        h = clampf(h_drift + fed * (h_fed - h_drift), 0.0f, 100.0f);
+        last_feeding[i] = fed > 0.0f ? now : last;
+
+        float s = stress[i];
+        s += fed * (clampf(stress_target - recovery * 0.6f, 0.0f, 100.0f) - s);
+        float stress_wave = stress_re[i] * stress_wave_amp[i];
+        float desired_stress = clampf(stress_target + stress_wave, 0.0f, 100.0f);
+        s = clampf(s + (desired_stress - s) * stress_smooth, 0.0f, 100.0f);
+
+        float activity_variation = 0.15f * activity_im[i];
+        activity[i] = clampf(0.6f - s * 0.0035f + h * 0.0025f + activity_variation, 0.0f, 1.0f);
+
+        float health_offset = (h - hydration_target) * 0.2f - (s - stress_target) * 0.25f;
+        float desired_health = clampf(target_health[i] + health_offset, 0.0f, 100.0f);
+        float g = health[i];
+        health[i] = clampf(g + (desired_health - g) * health_smooth, 0.0f, 100.0f);
+        hydration[i] = h;
+        stress[i] = s;
+    }
+}
+
+void core_state_kernel_renormalize(core_state_soa_t *soa, size_t begin, size_t end)
+{
+    if (end > soa->count) {
+        end = soa->count;
+    }
+    for (size_t k = 0; k < CORE_STATE_OSC_COUNT; ++k) {
+        float *restrict re = soa->osc_re[k];
+        float *restrict im = soa->osc_im[k];
+        // One Newton step towards 1 / |z|: between calls the modulus drifts by far less than 1e-3.
+#pragma GCC ivdep
+        for (size_t i = begin; i < end; ++i) {
+            float gain = 1.5f - 0.5f * (re[i] * re[i] + im[i] * im[i]);
+            re[i] *= gain;
+            im[i] *= gain;
+        }
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Noyau de simulation des terrariums, sans dépendance ESP-IDF.
+ *
+ * L'état est rangé en structure de tableaux (SoA) : une boucle de mise à jour
+ * parcourt des flottants contigus, sans branche ni appel à sinf/cosf, et se
+ * vectorise sur l'hôte. Les noms et paramètres bruts, inutiles au pas de
+ * simulation, restent à part (core_state_slot_info_t).
+ *
+ * Les ondes de chaque emplacement sont des phaseurs (cos θ, sin θ) tournés d'un
+ * petit angle à chaque pas, sans temps absolu en flottant. La dérive d'arrondi
+ * est corrigée par core_state_kernel_renormalize() (module) et par
+ * core_state_soa_anchor() (phase exacte, recalculée en double).
+ */
+
+/* Écart maximal entre deux pas pour core_state_kernel_update() ; au-delà, ancrer. */
+#define CORE_STATE_OSC_MAX_ADVANCE_S 1.0f
+
+/* Oscillateurs d'un emplacement, pour a = cycle_speed * t et p = phase_offset. */
+typedef enum {
+    CORE_STATE_OSC_CLIMATE,  /* sin(a + p) : températures, lux de jour */
+    CORE_STATE_OSC_HUMIDITY, /* cos(0,7a + 1,2p) : humidités, lux de nuit */
+    CORE_STATE_OSC_STRESS,   /* cos(0,55a + p) */
+    CORE_STATE_OSC_ACTIVITY, /* sin(1,4a + p) */
+    CORE_STATE_OSC_COUNT,
+} core_state_osc_t;
+
+/* Description d'un emplacement telle que chargée depuis un profil. */
+typedef struct {
+    uint8_t id;
+    char scientific_name[CORE_LINK_NAME_MAX_LEN + 1];
+    char common_name[CORE_LINK_NAME_MAX_LEN + 1];
+    float base_temp_day;
+    float base_temp_night;
+    float base_humidity_day;
+    float base_humidity_night;
+    float base_lux_day;
+    float base_lux_night;
+    float current_temp_day;
+    float current_temp_night;
+    float current_humidity_day;
+    float current_humidity_night;
+    float current_lux_day;
+    float current_lux_night;
+    float hydration_pct;
+    float stress_pct;
+    float health_pct;
+    float activity_score;
+    float target_hydration_pct;
+    float target_stress_pct;
+    float target_health_pct;
+    float feeding_interval_hours;
+    float feeding_intake_pct;
+    float cycle_speed;
+    float phase_offset;
+    float enrichment_factor;
+    uint32_t last_feeding_timestamp;
+} core_state_slot_t;
+
+/* Partie froide d'un emplacement : lue à la publication et au rechargement. */
+typedef struct {
+    uint8_t id;
+    char scientific_name[CORE_LINK_NAME_MAX_LEN + 1];
+    char common_name[CORE_LINK_NAME_MAX_LEN + 1];
+    float feeding_interval_hours;
+    float feeding_intake_pct;
+    float enrichment_factor;
+} core_state_slot_info_t;
+
+typedef struct {
+    size_t capacity;
+    size_t count;
+    core_state_slot_info_t *info;
+    /* Entrées de phase et consignes. */
+    float *cycle_speed;
+    float *phase_offset;
+    float *base_temp_day;
+    float *base_temp_night;
+    float *base_humidity_day;
+    float *base_humidity_night;
+    float *base_lux_day;
+    float *base_lux_night;
+    float *target_hydration;
+    float *target_stress;
+    float *target_health;
+    /* Constantes dérivées du profil au chargement. */
+    float *hydration_floor;     /* plancher d'hydratation entre deux repas */
+    float *stress_wave_amp;
+    float *feeding_interval_s;  /* > 0 */
+    float *feeding_inv_interval;
+    float *feeding_recovery;
+    /* Sorties et état dynamique. */
+    float *temp_day;
+    float *temp_night;
+    float *humidity_day;
+    float *humidity_night;
+    float *lux_day;
+    float *lux_night;
+    float *hydration;
+    float *stress;
+    float *health;
+    float *activity;
+    uint32_t *last_feeding;
+    /* Phaseurs, de module 1 à l'arrondi près. */
+    float *osc_re[CORE_STATE_OSC_COUNT];
+    float *osc_im[CORE_STATE_OSC_COUNT];
+} core_state_soa_t;
+
+/* Paramètres communs d'un pas de simulation. */
+typedef struct {
+    float advance_s;     /* temps écoulé depuis le pas précédent, ≤ CORE_STATE_OSC_MAX_ADVANCE_S */
+    float delta_seconds; /* pas nominal, pour le lissage */
+    uint32_t now_epoch;
+} core_state_step_t;
+
+/** Octets à fournir à core_state_soa_init() pour `capacity` emplacements. */
+size_t core_state_soa_storage_size(size_t capacity);
+
+/** Découpe `storage` (aligné sur 16 octets, mis à zéro) en tableaux ; `count` vaut 0. */
+void core_state_soa_init(core_state_soa_t *soa, void *storage, size_t capacity);
+
+/**
+ * \brief Range l'emplacement `slot` à l'indice `index` (< capacity).
+ *
+ * `slot` doit avoir reçu ses valeurs par défaut : intervalle de repas > 0,
+ * consignes et métriques finies.
+ */
+void core_state_soa_store(core_state_soa_t *soa, size_t index, const core_state_slot_t *slot);
+
+/** Reconstitue l'emplacement `index` (tests, rechargement). */
+void core_state_soa_load(const core_state_soa_t *soa, size_t index, core_state_slot_t *slot);
+
+/**
+ * \brief Recale les phaseurs de [begin, end) sur leur phase exacte à `time_s`.
+ *
+ * Calcul en double avec cos/sin : réservé au chargement, aux reprises après un
+ * long arrêt et à un recalage tournant de quelques emplacements par pas.
+ * core_state_soa_store() place les phaseurs à t = 0.
+ */
+void core_state_soa_anchor(core_state_soa_t *soa, size_t begin, size_t end, double time_s);
+
+/** Tourne les phaseurs de [begin, end) de `advance_s` secondes (inclus dans core_state_kernel_update()). */
+void core_state_kernel_advance_waves(core_state_soa_t *soa, size_t begin, size_t end, float advance_s);
+
+/** Avance les emplacements [begin, end) d'un pas. */
+void core_state_kernel_update(core_state_soa_t *soa, size_t begin, size_t end, const core_state_step_t *step);
+
+/** Ramène le module des phaseurs de [begin, end) à 1 (à appeler tous les quelques pas). */
+void core_state_kernel_renormalize(core_state_soa_t *soa, size_t begin, size_t end);
+
+#ifdef __cplusplus
+}
+#endif
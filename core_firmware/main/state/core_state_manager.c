@@ -1,64 +1,70 @@
 #include "state/core_state_manager.h"
 
-#include <dirent.h>
-#include <errno.h>
 #include <math.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <strings.h>
 
-#include "cJSON.h"
 #include "esp_err.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "sdkconfig.h"
-
-#define CORE_STATE_TERRARIUM_COUNT CORE_LINK_MAX_TERRARIUMS
+#include "state/core_state_history.h"
+#include "state/core_state_index.h"
+#include "state/core_state_kernel.h"
+#include "state/core_state_profiles.h"
+#include "state/core_state_sim.h"
+#include "state/core_state_snapshot.h"
+
+#define CORE_STATE_TERRARIUM_COUNT CONFIG_CORE_STATE_MAX_TERRARIUMS
 #define PROFILE_PATH_MAX 256
-
-_Static_assert(CORE_STATE_TERRARIUM_COUNT <= CORE_LINK_MAX_TERRARIUMS,
-               "State manager terrarium capacity must not exceed link payload");
-
-typedef struct {
-    uint8_t id;
-    char scientific_name[CORE_LINK_NAME_MAX_LEN + 1];
-    char common_name[CORE_LINK_NAME_MAX_LEN + 1];
-    float base_temp_day;
-    float base_temp_night;
-    float base_humidity_day;
-    float base_humidity_night;
-    float base_lux_day;
-    float base_lux_night;
-    float current_temp_day;
-    float current_temp_night;
-    float current_humidity_day;
-    float current_humidity_night;
-    float current_lux_day;
-    float current_lux_night;
-    float hydration_pct;
-    float stress_pct;
-    float health_pct;
-    float activity_score;
-    float target_hydration_pct;
-    float target_stress_pct;
-    float target_health_pct;
-    float feeding_interval_hours;
-    float feeding_intake_pct;
-    float cycle_speed;
-    float phase_offset;
-    float enrichment_factor;
-    uint32_t last_feeding_timestamp;
-} core_state_slot_t;
+#define CORE_STATE_SNAPSHOT_CAPACITY \
+    (CORE_STATE_TERRARIUM_COUNT < CORE_LINK_MAX_TERRARIUMS ? CORE_STATE_TERRARIUM_COUNT : CORE_LINK_MAX_TERRARIUMS)
+
+#if CONFIG_CORE_STATE_HISTORY
+static const uint16_t k_history_depth[CORE_STATE_HISTORY_TIERS] = {
+    CONFIG_CORE_STATE_HISTORY_MINUTES,
+    CONFIG_CORE_STATE_HISTORY_QUARTERS,
+    CONFIG_CORE_STATE_HISTORY_SIX_HOURS,
+};
+#else
+static const uint16_t k_history_depth[CORE_STATE_HISTORY_TIERS] = {1, 1, 1};
+#endif
 
 static const char *TAG = "core_state_mgr";
 
-static core_state_slot_t s_slots[CORE_STATE_TERRARIUM_COUNT];
-static size_t s_slot_count;
-static portMUX_TYPE s_slots_lock = portMUX_INITIALIZER_UNLOCKED;
+// Writers (simulation steps, touch, reload) are serialized by a mutex: it never
+// masks interrupts, and readers never take it. They copy the last finished step
+// from the seqlock snapshot instead.
+static SemaphoreHandle_t s_writer_lock;
+// Structure-of-arrays state, sized to the loaded profiles; the block behind it
+// is swapped whole on reload, together with the ID index.
+static core_state_soa_t s_soa;
+static void *s_soa_storage;
+static core_state_index_t s_index;
+// Downsampled metrics of the published slots, swapped with the pool. They have
+// their own short lock so that HISTORY_REQUEST (link RX tasks) never waits on
+// s_writer_lock: the writer takes it only to record a step or swap the history,
+// and requests resolve IDs through a copy of the index published with it.
+static SemaphoreHandle_t s_history_lock;
+static core_state_history_t s_history;
+static void *s_history_storage;
+static core_state_index_t s_history_index;
+// Simulated time, in whole fixed steps.
+static core_state_sim_t s_sim;
 static char s_profile_base_path[PROFILE_PATH_MAX];
+// Reloads are serialized apart from the writers: parsing runs outside s_writer_lock.
+static SemaphoreHandle_t s_reload_lock;
+// Files behind the running profiles; a hot reload only re-reads those that changed.
+static core_state_profile_cache_t *s_profiles;
+static char s_profiles_dir[PROFILE_PATH_MAX];
+static core_state_snapshot_t s_snapshot;
+static atomic_size_t s_terrarium_count;
 
 typedef struct {
     const char *scientific_name;
@@ -140,21 +146,34 @@ static inline float clampf(float value, float min, float max)
     return value;
 }
 
-static uint32_t current_epoch_seconds(void)
+static void *alloc_state_buffer(size_t size)
 {
-    uint64_t now_us = esp_timer_get_time();
-    return (uint32_t)(CONFIG_CORE_APP_STATE_BASE_EPOCH + (now_us / 1000000ULL));
+    // Aligned for the vectorized kernel; PSRAM first, 1024 slots take ~190 KiB.
+    void *buffer = heap_caps_aligned_calloc(16, 1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!buffer) {
+        buffer = heap_caps_aligned_calloc(16, 1, size, MALLOC_CAP_8BIT);
+    }
+    return buffer;
+}
+
+// The pool holds exactly `count` slots; CORE_STATE_MAX_TERRARIUMS only bounds the listing.
+static void *alloc_pool(core_state_soa_t *soa, size_t count)
+{
+    void *storage = alloc_state_buffer(core_state_soa_storage_size(count));
+    if (storage) {
+        core_state_soa_init(soa, storage, count);
+    }
+    return storage;
 }
 
 static void apply_slot_defaults(core_state_slot_t *slot, size_t idx, uint32_t now_epoch)
 {
-    static const float default_cycle_speed[CORE_STATE_TERRARIUM_COUNT] = {0.03f, 0.045f, 0.038f, 0.033f};
-    static const float default_phase_offset[CORE_STATE_TERRARIUM_COUNT] = {0.0f, 1.1f, 2.4f, 3.1f};
-    static const float default_enrichment[CORE_STATE_TERRARIUM_COUNT] = {1.0f, 1.3f, 0.8f, 1.1f};
+    static const float default_cycle_speed[] = {0.03f, 0.045f, 0.038f, 0.033f};
+    static const float default_phase_offset[] = {0.0f, 1.1f, 2.4f, 3.1f};
+    static const float default_enrichment[] = {1.0f, 1.3f, 0.8f, 1.1f};
 
-    if (idx >= CORE_STATE_TERRARIUM_COUNT) {
-        idx = CORE_STATE_TERRARIUM_COUNT - 1;
-    }
+    // Large installs cycle through the four default temperaments.
+    idx %= sizeof(default_cycle_speed) / sizeof(default_cycle_speed[0]);
 
     slot->current_temp_day = slot->base_temp_day;
     slot->current_temp_night = slot->base_temp_night;
@@ -224,283 +243,104 @@ static void apply_slot_defaults(core_state_slot_t *slot, size_t idx, uint32_t no
     }
 }
 
-static bool has_json_extension(const char *name)
+static const core_state_profile_cache_t *previous_profiles(const char *directory)
 {
-    if (!name) {
-        return false;
-    }
-    size_t len = strlen(name);
-    return (len >= 5 && strcasecmp(&name[len - 5], ".json") == 0);
+    return (s_profiles && strcmp(s_profiles_dir, directory) == 0) ? s_profiles : NULL;
 }
 
-static esp_err_t read_file_to_buffer(const char *path, char **out_buffer, size_t *out_size)
+// On success, *out_storage receives the block behind `soa` and *out_profiles the
+// files read, for the next reload.
+static esp_err_t load_profiles_from_directory(const char *directory, core_state_soa_t *soa, void **out_storage,
+                                              uint32_t now_epoch, core_state_profile_cache_t **out_profiles)
 {
-    if (!path || !out_buffer || !out_size) {
+    if (!directory || !soa) {
         return ESP_ERR_INVALID_ARG;
     }
 
-    FILE *file = fopen(path, "rb");
-    if (!file) {
-        ESP_LOGW(TAG, "Failed to open profile %s: errno=%d", path, errno);
-        return ESP_FAIL;
-    }
-
-    if (fseek(file, 0L, SEEK_END) != 0) {
-        fclose(file);
-        return ESP_FAIL;
-    }
-    long length = ftell(file);
-    if (length < 0) {
-        fclose(file);
-        return ESP_FAIL;
-    }
-    if (fseek(file, 0L, SEEK_SET) != 0) {
-        fclose(file);
-        return ESP_FAIL;
+    const char *cache_path = NULL;
+#if CONFIG_CORE_STATE_PROFILE_CACHE
+    char cache_path_buf[PROFILE_PATH_MAX];
+    if (core_state_profiles_cache_path(directory, cache_path_buf, sizeof(cache_path_buf))) {
+        cache_path = cache_path_buf;
     }
-
-    char *buffer = (char *)malloc((size_t)length + 1);
-    if (!buffer) {
-        fclose(file);
+#endif
+    core_state_profile_cache_t *cache = alloc_state_buffer(CORE_STATE_PROFILE_CACHE_SIZE(CORE_STATE_TERRARIUM_COUNT));
+    if (!cache) {
         return ESP_ERR_NO_MEM;
     }
 
-    size_t read = fread(buffer, 1, (size_t)length, file);
-    fclose(file);
-    if (read != (size_t)length) {
-        free(buffer);
-        return ESP_FAIL;
+    int64_t start_us = esp_timer_get_time();
+    core_state_profiles_stats_t stats;
+    core_state_profiles_status_t status =
+        core_state_profiles_load(directory, cache_path, previous_profiles(directory), cache,
+                                 CORE_STATE_TERRARIUM_COUNT, &stats);
+    ESP_LOGD(TAG, "Scanned %zu profile(s) in %s in %lld us, %zu unchanged (%s)", stats.files, directory,
+             (long long)(esp_timer_get_time() - start_us), stats.reused,
+             stats.cache_hit ? "cache hit" : (stats.cache_written ? "cache rebuilt" : "no cache"));
+    if (stats.truncated) {
+        ESP_LOGW(TAG, "Profile limit reached while scanning %s", directory);
     }
-    buffer[length] = '\0';
-
-    *out_buffer = buffer;
-    *out_size = (size_t)length;
-    return ESP_OK;
-}
-
-static float json_get_number(const cJSON *object, const char *key, float default_value)
-{
-    const cJSON *node = cJSON_GetObjectItemCaseSensitive(object, key);
-    if (cJSON_IsNumber(node)) {
-        return (float)node->valuedouble;
+    if (stats.skipped > 0) {
+        ESP_LOGW(TAG, "Skipped %zu profile(s) in %s: name too long or unreadable", stats.skipped, directory);
     }
-    return default_value;
-}
-
-static void json_copy_string(const cJSON *object, const char *key, char *dest, size_t dest_size, const char *fallback)
-{
-    if (!dest || dest_size == 0) {
-        return;
-    }
-
-    const cJSON *node = cJSON_GetObjectItemCaseSensitive(object, key);
-    if (cJSON_IsString(node) && node->valuestring) {
-        strlcpy(dest, node->valuestring, dest_size);
-    } else if (fallback) {
-        strlcpy(dest, fallback, dest_size);
-    } else {
-        dest[0] = '\0';
+    if (status == CORE_STATE_PROFILES_NOT_FOUND || status == CORE_STATE_PROFILES_IO_ERROR) {
+        heap_caps_free(cache);
+        return (status == CORE_STATE_PROFILES_NOT_FOUND) ? ESP_ERR_NOT_FOUND : ESP_FAIL;
     }
-}
 
-static bool parse_profile_from_json(const char *path, core_state_slot_t *slot, size_t idx)
-{
-    char *buffer = NULL;
-    size_t size = 0;
-    esp_err_t err = read_file_to_buffer(path, &buffer, &size);
-    if (err != ESP_OK) {
-        return false;
-    }
-
-    cJSON *root = cJSON_ParseWithLength(buffer, size);
-    free(buffer);
-    if (!root) {
-        ESP_LOGW(TAG, "Invalid JSON in %s", path);
-        return false;
-    }
-
-    memset(slot, 0, sizeof(*slot));
-    slot->id = (uint8_t)idx;
-    slot->cycle_speed = NAN;
-    slot->phase_offset = NAN;
-    slot->enrichment_factor = NAN;
-    slot->hydration_pct = NAN;
-    slot->stress_pct = NAN;
-    slot->health_pct = NAN;
-    slot->activity_score = NAN;
-    slot->target_hydration_pct = NAN;
-    slot->target_stress_pct = NAN;
-    slot->target_health_pct = NAN;
-    slot->feeding_interval_hours = NAN;
-    slot->feeding_intake_pct = NAN;
-
-    json_copy_string(root, "scientific_name", slot->scientific_name, sizeof(slot->scientific_name), "Unknown species");
-    json_copy_string(root, "common_name", slot->common_name, sizeof(slot->common_name), "Terrarium");
-
-    const cJSON *environment = cJSON_GetObjectItemCaseSensitive(root, "environment");
-    if (cJSON_IsObject(environment)) {
-        slot->base_temp_day = json_get_number(environment, "temp_day_c", 0.0f);
-        slot->base_temp_night = json_get_number(environment, "temp_night_c", 0.0f);
-        slot->base_humidity_day = json_get_number(environment, "humidity_day_pct", 0.0f);
-        slot->base_humidity_night = json_get_number(environment, "humidity_night_pct", 0.0f);
-        slot->base_lux_day = json_get_number(environment, "lux_day", 0.0f);
-        slot->base_lux_night = json_get_number(environment, "lux_night", 0.0f);
-    }
-
-    const cJSON *id_node = cJSON_GetObjectItemCaseSensitive(root, "id");
-    if (cJSON_IsNumber(id_node) && id_node->valuedouble >= 0.0) {
-        slot->id = (uint8_t)id_node->valuedouble;
-    }
-
-    slot->cycle_speed = json_get_number(root, "cycle_speed", slot->cycle_speed);
-    slot->phase_offset = json_get_number(root, "phase_offset", slot->phase_offset);
-    slot->enrichment_factor = json_get_number(root, "enrichment_factor", slot->enrichment_factor);
-    slot->hydration_pct = json_get_number(root, "hydration_pct", slot->hydration_pct);
-    slot->stress_pct = json_get_number(root, "stress_pct", slot->stress_pct);
-    slot->health_pct = json_get_number(root, "health_pct", slot->health_pct);
-    slot->activity_score = json_get_number(root, "activity_score", slot->activity_score);
-
-    if (isfinite(slot->hydration_pct)) {
-        slot->target_hydration_pct = slot->hydration_pct;
-    }
-    if (isfinite(slot->stress_pct)) {
-        slot->target_stress_pct = slot->stress_pct;
-    }
-    if (isfinite(slot->health_pct)) {
-        slot->target_health_pct = slot->health_pct;
-    }
-
-    const cJSON *feeding_node = cJSON_GetObjectItemCaseSensitive(root, "last_feeding_timestamp");
-    if (cJSON_IsNumber(feeding_node) && feeding_node->valuedouble >= 0.0) {
-        slot->last_feeding_timestamp = (uint32_t)feeding_node->valuedouble;
-    }
-
-    const cJSON *metrics = cJSON_GetObjectItemCaseSensitive(root, "metrics");
-    if (cJSON_IsObject(metrics)) {
-        float hydration = json_get_number(metrics, "hydration_pct", slot->hydration_pct);
-        if (isfinite(hydration)) {
-            slot->hydration_pct = hydration;
-            slot->target_hydration_pct = hydration;
-        }
-
-        float stress = json_get_number(metrics, "stress_pct", slot->stress_pct);
-        if (isfinite(stress)) {
-            slot->stress_pct = stress;
-            slot->target_stress_pct = stress;
-        }
-
-        float health = json_get_number(metrics, "health_pct", slot->health_pct);
-        if (isfinite(health)) {
-            slot->health_pct = health;
-            slot->target_health_pct = health;
-        }
-
-        float activity = json_get_number(metrics, "activity_score", slot->activity_score);
-        if (isfinite(activity)) {
-            slot->activity_score = activity;
-        }
-
-        const cJSON *feeding = cJSON_GetObjectItemCaseSensitive(metrics, "feeding");
-        if (cJSON_IsObject(feeding)) {
-            slot->feeding_interval_hours = json_get_number(feeding, "interval_hours", slot->feeding_interval_hours);
-            slot->feeding_intake_pct = json_get_number(feeding, "intake_pct", slot->feeding_intake_pct);
-            const cJSON *feed_ts = cJSON_GetObjectItemCaseSensitive(feeding, "last_timestamp");
-            if (cJSON_IsNumber(feed_ts) && feed_ts->valuedouble >= 0.0) {
-                slot->last_feeding_timestamp = (uint32_t)feed_ts->valuedouble;
-            }
-        }
-    }
-
-    cJSON_Delete(root);
-
-    if (slot->base_temp_day == 0.0f && slot->base_temp_night == 0.0f) {
-        ESP_LOGW(TAG, "Profile %s missing temperature data", path);
-    }
-
-    return true;
-}
-
-typedef struct {
-    char path[PROFILE_PATH_MAX];
-} profile_path_t;
-
-static int compare_profile_paths(const void *lhs, const void *rhs)
-{
-    const profile_path_t *a = (const profile_path_t *)lhs;
-    const profile_path_t *b = (const profile_path_t *)rhs;
-    return strcasecmp(a->path, b->path);
-}
-
-static esp_err_t load_profiles_from_directory(const char *directory, core_state_slot_t *slots, size_t *out_count)
-{
-    if (!directory || !slots || !out_count) {
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    DIR *dir = opendir(directory);
-    if (!dir) {
-        return (errno == ENOENT) ? ESP_ERR_NOT_FOUND : ESP_FAIL;
-    }
-
-    profile_path_t candidates[CORE_STATE_TERRARIUM_COUNT] = {0};
-    size_t candidate_count = 0;
-    struct dirent *entry = NULL;
-    while ((entry = readdir(dir)) != NULL) {
-        if (entry->d_name[0] == '.') {
-            continue;
-        }
-        if (!has_json_extension(entry->d_name)) {
-            continue;
-        }
-        if (candidate_count >= CORE_STATE_TERRARIUM_COUNT) {
-            ESP_LOGW(TAG, "Profile limit reached while scanning %s", directory);
-            break;
-        }
-
-        int written = snprintf(candidates[candidate_count].path, PROFILE_PATH_MAX, "%s/%s", directory, entry->d_name);
-        if (written <= 0 || written >= PROFILE_PATH_MAX) {
-            ESP_LOGW(TAG, "Profile path too long: %s/%s", directory, entry->d_name);
-            continue;
-        }
-        ++candidate_count;
+    if (stats.valid == 0) {
+        heap_caps_free(cache);
+        return ESP_ERR_INVALID_STATE;
     }
-    closedir(dir);
-
-    if (candidate_count == 0) {
-        return ESP_ERR_NOT_FOUND;
+    // Kept for the next reload: trimmed to the files actually listed.
+    size_t listed_size = CORE_STATE_PROFILE_CACHE_SIZE(cache->count);
+    core_state_profile_cache_t *profiles = alloc_state_buffer(listed_size);
+    void *storage = profiles ? alloc_pool(soa, stats.valid) : NULL;
+    if (!storage) {
+        heap_caps_free(profiles);
+        heap_caps_free(cache);
+        return ESP_ERR_NO_MEM;
     }
-
-    qsort(candidates, candidate_count, sizeof(profile_path_t), compare_profile_paths);
+    memcpy(profiles, cache, listed_size);
+    heap_caps_free(cache);
 
     size_t loaded = 0;
-    uint32_t now_epoch = current_epoch_seconds();
-    for (size_t i = 0; i < candidate_count; ++i) {
-        if (loaded >= CORE_STATE_TERRARIUM_COUNT) {
-            break;
-        }
-
-        if (!parse_profile_from_json(candidates[i].path, &slots[loaded], loaded)) {
+    for (size_t i = 0; i < profiles->count; ++i) {
+        const core_state_profile_entry_t *entry = &profiles->entries[i];
+        if (!entry->valid) {
+            ESP_LOGW(TAG, "Invalid JSON in %s/%s", directory, entry->name);
             continue;
         }
-        apply_slot_defaults(&slots[loaded], loaded, now_epoch);
+        core_state_slot_t slot = entry->slot;
+        if (slot.base_temp_day == 0.0f && slot.base_temp_night == 0.0f) {
+            ESP_LOGW(TAG, "Profile %s/%s missing temperature data", directory, entry->name);
+        }
+        // Defaults follow the ID, which survives reloads, rather than the position.
+        apply_slot_defaults(&slot, slot.id, now_epoch);
+        core_state_soa_store(soa, loaded, &slot);
         ++loaded;
     }
 
-    if (loaded == 0) {
-        return ESP_ERR_INVALID_STATE;
-    }
-
-    *out_count = loaded;
+    soa->count = loaded;
+    *out_storage = storage;
+    *out_profiles = profiles;
     return ESP_OK;
 }
 
-static void load_builtin_profiles(core_state_slot_t *slots, size_t *out_count)
+static void *load_builtin_profiles(core_state_soa_t *soa, uint32_t now_epoch)
 {
     size_t builtin_count = sizeof(s_builtin_profiles) / sizeof(s_builtin_profiles[0]);
-    uint32_t now_epoch = current_epoch_seconds();
+    if (builtin_count > CORE_STATE_TERRARIUM_COUNT) {
+        builtin_count = CORE_STATE_TERRARIUM_COUNT;
+    }
+    void *storage = alloc_pool(soa, builtin_count);
+    if (!storage) {
+        return NULL;
+    }
     size_t count = 0;
-    for (size_t i = 0; i < builtin_count && i < CORE_STATE_TERRARIUM_COUNT; ++i) {
-        core_state_slot_t *slot = &slots[i];
+    for (size_t i = 0; i < builtin_count; ++i) {
+        core_state_slot_t profile;
+        core_state_slot_t *slot = &profile;
         memset(slot, 0, sizeof(*slot));
         slot->id = (uint8_t)i;
         strlcpy(slot->scientific_name, s_builtin_profiles[i].scientific_name, sizeof(slot->scientific_name));
@@ -515,20 +355,142 @@ static void load_builtin_profiles(core_state_slot_t *slots, size_t *out_count)
         slot->phase_offset = s_builtin_profiles[i].phase_offset;
         slot->enrichment_factor = s_builtin_profiles[i].enrichment_factor;
         apply_slot_defaults(slot, i, now_epoch);
+        core_state_soa_store(soa, i, slot);
         ++count;
     }
 
-    *out_count = count;
+    soa->count = count;
+    return storage;
+}
+
+// Profile parameters only: the runtime fields differ between any two instants.
+static bool same_profile(const core_state_slot_t *a, const core_state_slot_t *b)
+{
+    return strcmp(a->scientific_name, b->scientific_name) == 0 && strcmp(a->common_name, b->common_name) == 0 &&
+           a->base_temp_day == b->base_temp_day && a->base_temp_night == b->base_temp_night &&
+           a->base_humidity_day == b->base_humidity_day && a->base_humidity_night == b->base_humidity_night &&
+           a->base_lux_day == b->base_lux_day && a->base_lux_night == b->base_lux_night &&
+           a->cycle_speed == b->cycle_speed && a->phase_offset == b->phase_offset &&
+           a->enrichment_factor == b->enrichment_factor && a->feeding_interval_hours == b->feeding_interval_hours &&
+           a->feeding_intake_pct == b->feeding_intake_pct && a->target_hydration_pct == b->target_hydration_pct &&
+           a->target_stress_pct == b->target_stress_pct && a->target_health_pct == b->target_health_pct;
+}
+
+static void mark_id(uint32_t *ids, uint8_t id)
+{
+    ids[id / 32U] |= 1UL << (id % 32U);
+}
+
+static bool id_marked(const uint32_t *ids, uint8_t id)
+{
+    return (ids[id / 32U] >> (id % 32U)) & 1U;
+}
+
+// Terrariums whose ID survives the reload keep their runtime state; their profile
+// only replaces the parameters. `prev_index` indexes `prev`; the caller holds
+// s_writer_lock.
+static void carry_over_runtime(core_state_soa_t *next, const core_state_soa_t *prev,
+                               const core_state_index_t *prev_index, core_state_reload_changes_t *changes)
+{
+    uint32_t claimed[8] = {0};
+
+    memset(changes, 0, sizeof(*changes));
+    for (size_t j = 0; j < next->count; ++j) {
+        uint8_t id = next->info[j].id;
+        uint16_t i = core_state_index_find(prev_index, id);
+        if (i == CORE_STATE_INDEX_NONE || id_marked(claimed, id)) {
+            mark_id(changes->added_ids, id);
+            ++changes->added;
+            continue;
+        }
+        mark_id(claimed, id);
+
+        core_state_slot_t old;
+        core_state_slot_t slot;
+        core_state_soa_load(prev, i, &old);
+        core_state_soa_load(next, j, &slot);
+        if (same_profile(&old, &slot)) {
+            ++changes->unchanged;
+        } else {
+            mark_id(changes->modified_ids, id);
+            ++changes->modified;
+        }
+        slot.current_temp_day = old.current_temp_day;
+        slot.current_temp_night = old.current_temp_night;
+        slot.current_humidity_day = old.current_humidity_day;
+        slot.current_humidity_night = old.current_humidity_night;
+        slot.current_lux_day = old.current_lux_day;
+        slot.current_lux_night = old.current_lux_night;
+        slot.hydration_pct = old.hydration_pct;
+        slot.stress_pct = old.stress_pct;
+        slot.health_pct = old.health_pct;
+        slot.activity_score = old.activity_score;
+        slot.last_feeding_timestamp = old.last_feeding_timestamp;
+        core_state_soa_store(next, j, &slot);
+    }
+
+    for (size_t n = 0; n < 256U; ++n) {
+        uint8_t id = (uint8_t)n;
+        if (core_state_index_find(prev_index, id) != CORE_STATE_INDEX_NONE && !id_marked(claimed, id)) {
+            mark_id(changes->removed_ids, id);
+            ++changes->removed;
+        }
+    }
+}
+
+// Publishes the state after the last step; the caller holds s_writer_lock.
+static void publish_snapshot(void)
+{
+    core_link_state_frame_t *frame = core_state_snapshot_begin(&s_snapshot);
+    size_t count = s_soa.count;
+    if (count > frame->terrarium_capacity) {
+        count = frame->terrarium_capacity;
+    }
+    frame->epoch_seconds = core_state_sim_epoch(&s_sim);
+    frame->sample_us = esp_timer_get_time();
+    frame->terrarium_count = (uint8_t)count;
+
+    for (size_t i = 0; i < count; ++i) {
+        core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
+        const core_state_slot_info_t *info = &s_soa.info[i];
+
+        snap->terrarium_id = info->id;
+        memcpy(snap->scientific_name, info->scientific_name, sizeof(snap->scientific_name));
+        snap->scientific_name[CORE_LINK_NAME_MAX_LEN] = '\0';
+        memcpy(snap->common_name, info->common_name, sizeof(snap->common_name));
+        snap->common_name[CORE_LINK_NAME_MAX_LEN] = '\0';
+
+        snap->temp_day_c = s_soa.temp_day[i];
+        snap->temp_night_c = s_soa.temp_night[i];
+        snap->humidity_day_pct = s_soa.humidity_day[i];
+        snap->humidity_night_pct = s_soa.humidity_night[i];
+        snap->lux_day = s_soa.lux_day[i];
+        snap->lux_night = s_soa.lux_night[i];
+        snap->hydration_pct = s_soa.hydration[i];
+        snap->stress_pct = s_soa.stress[i];
+        snap->health_pct = s_soa.health[i];
+        snap->last_feeding_timestamp = s_soa.last_feeding[i];
+        snap->activity_score = s_soa.activity[i];
+    }
+    core_state_snapshot_publish(&s_snapshot);
+    atomic_store_explicit(&s_terrarium_count, s_soa.count, memory_order_relaxed);
 }
 
 esp_err_t core_state_manager_reload_profiles(const char *base_path)
 {
-    core_state_slot_t new_slots[CORE_STATE_TERRARIUM_COUNT];
-    memset(new_slots, 0, sizeof(new_slots));
-    size_t new_count = 0;
-    esp_err_t err = ESP_FAIL;
-    bool base_path_applied = false;
+    return core_state_manager_reload_profiles_diff(base_path, NULL);
+}
+
+esp_err_t core_state_manager_reload_profiles_diff(const char *base_path, core_state_reload_changes_t *changes)
+{
+    if (!s_writer_lock || !s_reload_lock) {
+        return ESP_ERR_INVALID_STATE;
+    }
 
+    xSemaphoreTake(s_reload_lock, portMAX_DELAY);
+    // Profiles are parsed outside the lock, against the simulated epoch of now.
+    xSemaphoreTake(s_writer_lock, portMAX_DELAY);
+    uint32_t now_epoch = core_state_sim_epoch(&s_sim);
     char preferred[PROFILE_PATH_MAX] = {0};
     if (base_path && base_path[0] != '\0') {
         strlcpy(preferred, base_path, sizeof(preferred));
@@ -537,9 +499,18 @@ esp_err_t core_state_manager_reload_profiles(const char *base_path)
     } else {
         strlcpy(preferred, CONFIG_CORE_STATE_PROFILE_BASE_PATH, sizeof(preferred));
     }
+    xSemaphoreGive(s_writer_lock);
+
+    core_state_soa_t new_soa = {0};
+    void *new_storage = NULL;
+    size_t new_count = 0;
+    esp_err_t err = ESP_FAIL;
+    bool base_path_applied = false;
+    core_state_profile_cache_t *new_profiles = NULL;
 
     if (preferred[0] != '\0') {
-        err = load_profiles_from_directory(preferred, new_slots, &new_count);
+        err = load_profiles_from_directory(preferred, &new_soa, &new_storage, now_epoch, &new_profiles);
+        new_count = new_soa.count;
         if (err == ESP_OK && new_count > 0) {
             base_path_applied = true;
             ESP_LOGI(TAG, "Loaded %zu profile(s) from %s", new_count, preferred);
@@ -549,7 +520,9 @@ esp_err_t core_state_manager_reload_profiles(const char *base_path)
     if ((!base_path_applied || new_count == 0) && strlen(CONFIG_CORE_STATE_PROFILE_SPIFFS_PATH) > 0) {
         char fallback[PROFILE_PATH_MAX];
         strlcpy(fallback, CONFIG_CORE_STATE_PROFILE_SPIFFS_PATH, sizeof(fallback));
-        esp_err_t fallback_err = load_profiles_from_directory(fallback, new_slots, &new_count);
+        esp_err_t fallback_err =
+            load_profiles_from_directory(fallback, &new_soa, &new_storage, now_epoch, &new_profiles);
+        new_count = new_soa.count;
         if (fallback_err == ESP_OK && new_count > 0) {
             base_path_applied = true;
             err = ESP_OK;
@@ -561,29 +534,111 @@ esp_err_t core_state_manager_reload_profiles(const char *base_path)
     }
 
     if (!base_path_applied || new_count == 0) {
-        load_builtin_profiles(new_slots, &new_count);
+        new_storage = load_builtin_profiles(&new_soa, now_epoch);
+        if (!new_storage) {
+            xSemaphoreGive(s_reload_lock);
+            return ESP_ERR_NO_MEM;
+        }
+        new_count = new_soa.count;
         err = (new_count > 0) ? ESP_ERR_NOT_FOUND : ESP_FAIL;
         ESP_LOGW(TAG, "Falling back to built-in profiles (%zu)", new_count);
     }
 
-    portENTER_CRITICAL(&s_slots_lock);
-    memset(s_slots, 0, sizeof(s_slots));
-    if (new_count > 0) {
-        memcpy(s_slots, new_slots, new_count * sizeof(core_state_slot_t));
+    // History follows the published slots only.
+    size_t history_slots = 0;
+    void *history_storage = NULL;
+#if CONFIG_CORE_STATE_HISTORY
+    history_slots = new_count < CORE_STATE_SNAPSHOT_CAPACITY ? new_count : CORE_STATE_SNAPSHOT_CAPACITY;
+    if (history_slots > 0) {
+        history_storage = alloc_state_buffer(core_state_history_storage_size(k_history_depth, history_slots));
+        if (!history_storage) {
+            ESP_LOGW(TAG, "Out of memory for the history of %zu terrarium(s); history disabled", history_slots);
+            history_slots = 0;
+        }
     }
-    s_slot_count = new_count;
+#endif
+
+    // Phasors start at the simulated instant the running ones were advanced to;
+    // no step can slip in between while the lock is held.
+    core_state_reload_changes_t diff;
+    xSemaphoreTake(s_writer_lock, portMAX_DELAY);
+    carry_over_runtime(&new_soa, &s_soa, &s_index, &diff);
+    // Surviving terrariums keep their history, matched by ID like their state.
+    core_state_history_t new_history;
+    core_state_history_init(&new_history, history_storage, k_history_depth, history_slots, &s_history);
+    for (size_t i = 0; i < history_slots; ++i) {
+        uint16_t prev = core_state_index_find(&s_index, new_soa.info[i].id);
+        if (prev != CORE_STATE_INDEX_NONE) {
+            core_state_history_move_slot(&new_history, i, &s_history, prev);
+        }
+    }
+    core_state_soa_anchor(&new_soa, 0, new_count, core_state_sim_time_s(&s_sim));
+    void *old_storage = s_soa_storage;
+    s_soa = new_soa;
+    s_soa_storage = new_storage;
+    size_t shadowed = core_state_index_build(&s_index, &s_soa);
+    void *old_history_storage = s_history_storage;
+    xSemaphoreTake(s_history_lock, portMAX_DELAY);
+    s_history = new_history;
+    s_history_storage = history_storage;
+    s_history_index = s_index;
+    xSemaphoreGive(s_history_lock);
     if (base_path_applied && preferred[0] != '\0') {
         strlcpy(s_profile_base_path, preferred, sizeof(s_profile_base_path));
     }
-    portEXIT_CRITICAL(&s_slots_lock);
+    publish_snapshot();
+    xSemaphoreGive(s_writer_lock);
+
+    heap_caps_free(old_storage);
+    heap_caps_free(old_history_storage);
+    heap_caps_free(s_profiles);
+    s_profiles = new_profiles;
+    strlcpy(s_profiles_dir, new_profiles ? preferred : "", sizeof(s_profiles_dir));
+    xSemaphoreGive(s_reload_lock);
 
+    if (shadowed > 0) {
+        ESP_LOGW(TAG, "%zu terrarium(s) share an ID with an earlier one and cannot be addressed by ID", shadowed);
+    }
+    ESP_LOGI(TAG, "Profile reload: %u added, %u removed, %u modified, %u unchanged", diff.added, diff.removed,
+             diff.modified, diff.unchanged);
+    if (changes) {
+        *changes = diff;
+    }
     return err;
 }
 
 void core_state_manager_init(void)
 {
-    memset(s_slots, 0, sizeof(s_slots));
-    s_slot_count = 0;
+    size_t frame_size = CORE_LINK_STATE_FRAME_SIZE(CORE_STATE_SNAPSHOT_CAPACITY);
+    core_link_state_frame_t *frames[2] = {alloc_state_buffer(frame_size), alloc_state_buffer(frame_size)};
+    s_writer_lock = xSemaphoreCreateMutex();
+    s_reload_lock = xSemaphoreCreateMutex();
+    s_history_lock = xSemaphoreCreateMutex();
+    if (!frames[0] || !frames[1] || !s_writer_lock || !s_reload_lock || !s_history_lock) {
+        ESP_LOGE(TAG, "Out of memory for the state snapshot");
+        heap_caps_free(frames[0]);
+        heap_caps_free(frames[1]);
+        if (s_writer_lock) {
+            vSemaphoreDelete(s_writer_lock);
+            s_writer_lock = NULL;
+        }
+        if (s_reload_lock) {
+            vSemaphoreDelete(s_reload_lock);
+            s_reload_lock = NULL;
+        }
+        if (s_history_lock) {
+            vSemaphoreDelete(s_history_lock);
+            s_history_lock = NULL;
+        }
+        return;
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        core_link_state_frame_init(frames[i], CORE_STATE_SNAPSHOT_CAPACITY);
+    }
+    core_state_snapshot_init(&s_snapshot, frames[0], frames[1]);
+    core_state_sim_init(&s_sim, CONFIG_CORE_APP_STATE_STEP_MS, CONFIG_CORE_APP_STATE_BASE_EPOCH);
+    core_state_index_build(&s_index, &s_soa);
+    s_history_index = s_index;
     strlcpy(s_profile_base_path, CONFIG_CORE_STATE_PROFILE_BASE_PATH, sizeof(s_profile_base_path));
 
     esp_err_t err = core_state_manager_reload_profiles(NULL);
@@ -591,171 +646,128 @@ void core_state_manager_init(void)
         ESP_LOGW(TAG, "Profile reload completed with status %s", esp_err_to_name(err));
     }
 
-    portENTER_CRITICAL(&s_slots_lock);
-    size_t count = s_slot_count;
-    portEXIT_CRITICAL(&s_slots_lock);
-    ESP_LOGI(TAG, "Core state manager initialized (%zu terrariums)", count);
+    size_t count = core_state_manager_get_terrarium_count();
+    ESP_LOGI(TAG, "Core state manager initialized (%zu terrariums, capacity %d)", count, CORE_STATE_TERRARIUM_COUNT);
 }
 
-void core_state_manager_update(float delta_seconds)
+uint32_t core_state_manager_advance(double seconds)
 {
-    float time_s = (float)(esp_timer_get_time() / 1000000.0);
-    uint32_t now_epoch = current_epoch_seconds();
-
-    portENTER_CRITICAL(&s_slots_lock);
-    for (size_t i = 0; i < s_slot_count; ++i) {
-        core_state_slot_t *slot = &s_slots[i];
-        float wave = sinf(time_s * slot->cycle_speed + slot->phase_offset);
-        float wave_secondary = cosf(time_s * slot->cycle_speed * 0.7f + slot->phase_offset * 1.2f);
-
-        slot->current_temp_day = slot->base_temp_day + wave * 1.8f;
-        slot->current_temp_night = slot->base_temp_night + wave * 1.0f;
-        slot->current_humidity_day = clampf(slot->base_humidity_day + wave_secondary * 6.0f, 30.0f, 95.0f);
-        slot->current_humidity_night = clampf(slot->base_humidity_night + wave_secondary * 4.0f, 40.0f, 98.0f);
-        slot->current_lux_day = clampf(slot->base_lux_day + wave * 80.0f, 50.0f, 900.0f);
-        slot->current_lux_night = clampf(slot->base_lux_night + (wave_secondary + 1.0f) * 2.0f, 0.0f, 20.0f);
-
-        float enrichment = fmaxf(slot->enrichment_factor, 0.5f);
-        float hydration_target = isfinite(slot->target_hydration_pct) ? slot->target_hydration_pct : slot->hydration_pct;
-        float stress_target = isfinite(slot->target_stress_pct) ? slot->target_stress_pct : slot->stress_pct;
-        float health_target = isfinite(slot->target_health_pct) ? slot->target_health_pct : slot->health_pct;
-        float hydration_span = fmaxf(5.0f, 12.0f / enrichment);
-
-        float interval_hours = slot->feeding_interval_hours;
-        float interval_seconds = (interval_hours > 0.0f) ? interval_hours * 3600.0f : 0.0f;
-        float elapsed_seconds = 0.0f;
-        if (interval_seconds > 0.0f && now_epoch >= slot->last_feeding_timestamp) {
-            elapsed_seconds = (float)(now_epoch - slot->last_feeding_timestamp);
+    if (!s_writer_lock || !(seconds > 0.0)) {
+        return 0;
+    }
+
+    xSemaphoreTake(s_writer_lock, portMAX_DELAY);
+    core_state_sim_add_time(&s_sim, (uint64_t)(seconds * 1000000.0 + 0.5));
+    xSemaphoreGive(s_writer_lock);
+
+    // The lock is released between steps so that a long catch-up or fast-forward
+    // lets touch events and reloads through.
+    uint32_t steps = 0;
+    while (true) {
+        core_state_sim_tick_t tick;
+        xSemaphoreTake(s_writer_lock, portMAX_DELAY);
+        bool due = core_state_sim_next(&s_sim, &tick);
+        if (due) {
+            core_state_sim_apply(&tick, &s_soa, 0, s_soa.count);
+            xSemaphoreTake(s_history_lock, portMAX_DELAY);
+            core_state_history_record(&s_history, &s_soa, tick.step.now_epoch);
+            xSemaphoreGive(s_history_lock);
         }
-
-        if (interval_seconds > 0.0f) {
-            if (elapsed_seconds >= interval_seconds) {
-                slot->last_feeding_timestamp = now_epoch;
-                float recovery = fminf(slot->feeding_intake_pct * 0.12f, 10.0f);
-                slot->hydration_pct = clampf(hydration_target + recovery, 0.0f, 100.0f);
-                slot->stress_pct = clampf(stress_target - recovery * 0.6f, 0.0f, 100.0f);
-                elapsed_seconds = 0.0f;
-            } else {
-                float progress = elapsed_seconds / interval_seconds;
-                float min_hydration = clampf(hydration_target - hydration_span, 0.0f, hydration_target);
-                float desired_hydration = hydration_target - (hydration_target - min_hydration) * progress;
-                float hydration_smooth = fminf(delta_seconds * 0.8f, 1.0f);
-                slot->hydration_pct += (desired_hydration - slot->hydration_pct) * hydration_smooth;
-            }
-        } else {
-            float hydration_wave = sinf(time_s * slot->cycle_speed * 0.8f + slot->phase_offset) * (hydration_span * 0.25f);
-            float desired_hydration = hydration_target + hydration_wave;
-            float hydration_smooth = fminf(delta_seconds * 0.8f, 1.0f);
-            slot->hydration_pct += (desired_hydration - slot->hydration_pct) * hydration_smooth;
+        xSemaphoreGive(s_writer_lock);
+        if (!due) {
+            break;
         }
-        slot->hydration_pct = clampf(slot->hydration_pct, 0.0f, 100.0f);
-
-        float stress_wave = cosf(time_s * slot->cycle_speed * 0.55f + slot->phase_offset) * (6.0f / enrichment);
-        float desired_stress = clampf(stress_target + stress_wave, 0.0f, 100.0f);
-        float stress_smooth = fminf(delta_seconds * 0.6f, 1.0f);
-        slot->stress_pct += (desired_stress - slot->stress_pct) * stress_smooth;
-        slot->stress_pct = clampf(slot->stress_pct, 0.0f, 100.0f);
-
-        float activity_base = 0.6f - slot->stress_pct * 0.0035f + slot->hydration_pct * 0.0025f;
-        float activity_variation = 0.15f * sinf(time_s * slot->cycle_speed * 1.4f + slot->phase_offset);
-        slot->activity_score = clampf(activity_base + activity_variation, 0.0f, 1.0f);
+        ++steps;
+    }
 
-        float health_offset = (slot->hydration_pct - hydration_target) * 0.2f - (slot->stress_pct - stress_target) * 0.25f;
-        float desired_health = clampf(health_target + health_offset, 0.0f, 100.0f);
-        float health_smooth = fminf(delta_seconds * 0.5f, 1.0f);
-        slot->health_pct += (desired_health - slot->health_pct) * health_smooth;
-        slot->health_pct = clampf(slot->health_pct, 0.0f, 100.0f);
+    if (steps > 0) {
+        xSemaphoreTake(s_writer_lock, portMAX_DELAY);
+        publish_snapshot();
+        xSemaphoreGive(s_writer_lock);
     }
-    portEXIT_CRITICAL(&s_slots_lock);
+    return steps;
 }
 
-void core_state_manager_apply_touch(const core_link_touch_event_t *event)
+void core_state_manager_apply_touch(const core_link_touch_event_t *event, uint16_t screen_width)
 {
-    if (!event) {
+    if (!event || !s_writer_lock || screen_width == 0) {
         return;
     }
 
-    portENTER_CRITICAL(&s_slots_lock);
-    if (s_slot_count == 0) {
-        portEXIT_CRITICAL(&s_slots_lock);
+    xSemaphoreTake(s_writer_lock, portMAX_DELAY);
+    // One band per terrarium the display shows, not per slot of the pool.
+    size_t count = s_soa.count < CORE_STATE_SNAPSHOT_CAPACITY ? s_soa.count : CORE_STATE_SNAPSHOT_CAPACITY;
+    if (count == 0) {
+        xSemaphoreGive(s_writer_lock);
         return;
     }
 
-    const uint16_t width = 1024;
-    size_t count = s_slot_count;
-    uint16_t zone = (count > 0) ? (width / count) : width;
-    size_t idx = zone > 0 ? (event->x / zone) : 0;
+    size_t idx = ((size_t)event->x * count) / screen_width;
     if (idx >= count) {
         idx = count - 1;
     }
 
-    core_state_slot_t *slot = &s_slots[idx];
     if (event->type == CORE_LINK_TOUCH_DOWN) {
-        slot->stress_pct = clampf(slot->stress_pct - (float)CONFIG_CORE_APP_TOUCH_RELIEF_DELTA, 0.0f, 80.0f);
-        slot->activity_score = clampf(slot->activity_score + 0.1f, 0.0f, 1.0f);
+        s_soa.stress[idx] = clampf(s_soa.stress[idx] - (float)CONFIG_CORE_APP_TOUCH_RELIEF_DELTA, 0.0f, 80.0f);
+        s_soa.activity[idx] = clampf(s_soa.activity[idx] + 0.1f, 0.0f, 1.0f);
     } else if (event->type == CORE_LINK_TOUCH_MOVE) {
-        slot->activity_score = clampf(slot->activity_score + 0.02f, 0.0f, 1.0f);
+        s_soa.activity[idx] = clampf(s_soa.activity[idx] + 0.02f, 0.0f, 1.0f);
     }
-    portEXIT_CRITICAL(&s_slots_lock);
+    // Visible right away rather than after the next step.
+    publish_snapshot();
+    xSemaphoreGive(s_writer_lock);
 }
 
-void core_state_manager_build_frame(core_link_state_frame_t *frame)
+esp_err_t core_state_manager_feed(uint8_t terrarium_id)
 {
-    if (!frame) {
-        return;
-    }
-
-    core_state_slot_t snapshot[CORE_STATE_TERRARIUM_COUNT];
-    memset(snapshot, 0, sizeof(snapshot));
-    size_t count = 0;
-
-    portENTER_CRITICAL(&s_slots_lock);
-    if (s_slot_count > 0) {
-        count = s_slot_count;
-        if (count > CORE_STATE_TERRARIUM_COUNT) {
-            count = CORE_STATE_TERRARIUM_COUNT;
-        }
-        memcpy(snapshot, s_slots, count * sizeof(core_state_slot_t));
+    if (!s_writer_lock) {
+        return ESP_ERR_INVALID_STATE;
     }
-    portEXIT_CRITICAL(&s_slots_lock);
 
-    memset(frame, 0, sizeof(*frame));
-    frame->epoch_seconds = current_epoch_seconds();
-    size_t serialized = count;
-    if (serialized > CORE_LINK_MAX_TERRARIUMS) {
-        serialized = CORE_LINK_MAX_TERRARIUMS;
+    xSemaphoreTake(s_writer_lock, portMAX_DELAY);
+    uint16_t idx = core_state_index_find(&s_index, terrarium_id);
+    if (idx != CORE_STATE_INDEX_NONE) {
+        // A full interval ago: the kernel serves the meal on the next step, as if due.
+        uint32_t interval_s = (uint32_t)s_soa.feeding_interval_s[idx];
+        s_soa.last_feeding[idx] = core_state_sim_epoch(&s_sim) - interval_s - 1U;
     }
-    frame->terrarium_count = (uint8_t)serialized;
-
-    for (uint8_t i = 0; i < frame->terrarium_count; ++i) {
-        core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
-        const core_state_slot_t *slot = &snapshot[i];
+    xSemaphoreGive(s_writer_lock);
+    return (idx != CORE_STATE_INDEX_NONE) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
 
-        snap->terrarium_id = slot->id;
-        strncpy(snap->scientific_name, slot->scientific_name, CORE_LINK_NAME_MAX_LEN);
-        snap->scientific_name[CORE_LINK_NAME_MAX_LEN] = '\0';
-        strncpy(snap->common_name, slot->common_name, CORE_LINK_NAME_MAX_LEN);
-        snap->common_name[CORE_LINK_NAME_MAX_LEN] = '\0';
+size_t core_state_manager_read_history(const core_link_history_request_t *request, uint8_t *out, size_t capacity)
+{
+    if (!request || !out) {
+        return 0;
+    }
+    if (!s_history_lock) {
+        // Nothing recorded yet: an empty history answers UNAVAILABLE.
+        return core_state_history_encode_chunk(&s_history, SIZE_MAX, request, out, capacity);
+    }
+
+    // The chunk copies at most `capacity` bytes of already quantized buckets: the
+    // writer waits for one payload at worst, never for the whole ring.
+    xSemaphoreTake(s_history_lock, portMAX_DELAY);
+    uint16_t idx = core_state_index_find(&s_history_index, request->terrarium_id);
+    size_t slot = (idx != CORE_STATE_INDEX_NONE) ? idx : SIZE_MAX;
+    size_t length = core_state_history_encode_chunk(&s_history, slot, request, out, capacity);
+    xSemaphoreGive(s_history_lock);
+    return length;
+}
 
-        snap->temp_day_c = slot->current_temp_day;
-        snap->temp_night_c = slot->current_temp_night;
-        snap->humidity_day_pct = slot->current_humidity_day;
-        snap->humidity_night_pct = slot->current_humidity_night;
-        snap->lux_day = slot->current_lux_day;
-        snap->lux_night = slot->current_lux_night;
-        snap->hydration_pct = slot->hydration_pct;
-        snap->stress_pct = slot->stress_pct;
-        snap->health_pct = slot->health_pct;
-        snap->last_feeding_timestamp = slot->last_feeding_timestamp;
-        snap->activity_score = slot->activity_score;
+void core_state_manager_build_frame(core_link_state_frame_t *frame)
+{
+    if (!frame) {
+        return;
+    }
+    if (!s_writer_lock) {
+        frame->terrarium_count = 0;
+        return;
     }
+    core_state_snapshot_read(&s_snapshot, frame);
 }
 
 size_t core_state_manager_get_terrarium_count(void)
 {
-    size_t count;
-    portENTER_CRITICAL(&s_slots_lock);
-    count = s_slot_count;
-    portEXIT_CRITICAL(&s_slots_lock);
-    return count;
+    return atomic_load_explicit(&s_terrarium_count, memory_order_relaxed);
 }
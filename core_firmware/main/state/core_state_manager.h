@@ -1,8 +1,10 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "esp_err.h"
+#include "link/core_link_history.h"
 #include "link/core_link_protocol.h"
 
 #ifdef __cplusplus
@@ -53,6 +55,11 @@ extern "C" {
  * `last_feeding_timestamp`) restent prises en charge pour assurer la
  * rétrocompatibilité.
  *
+ * Sans clé `id`, un fichier garde d'un rechargement à l'autre l'identifiant
+ * qu'il a reçu (le plus petit libre lors de son apparition). Les identifiants
+ * tiennent sur un octet : au-delà de 256 profils, les doublons ne sont
+ * joignables que par leur position.
+ *
  * Clés optionnelles supplémentaires :
  * - `feeding_interval_hours` (racine ou `metrics.feeding.interval_hours`) pour
  *   ajuster la fréquence de nourrissage simulée.
@@ -68,9 +75,81 @@ extern "C" {
  */
 esp_err_t core_state_manager_reload_profiles(const char *base_path);
 
+/*
+ * Bilan d'un rechargement par identifiant de terrarium : bit n (mot n / 32)
+ * de chaque masque pour l'identifiant n.
+ */
+typedef struct {
+    uint16_t added;
+    uint16_t removed;
+    uint16_t modified;
+    uint16_t unchanged;
+    uint32_t added_ids[8];
+    uint32_t removed_ids[8];
+    uint32_t modified_ids[8];
+} core_state_reload_changes_t;
+
+/**
+ * \brief core_state_manager_reload_profiles() avec le bilan des changements.
+ *
+ * Seuls les fichiers dont la date ou la taille a changé depuis le chargement
+ * précédent du même répertoire sont relus. Un terrarium dont l'identifiant
+ * existait déjà garde son état courant (hydratation, stress, santé, activité,
+ * dernier repas) : le profil n'en remplace que les paramètres, et il compte
+ * comme modifié si ceux-ci diffèrent. Les métriques de départ d'un profil ne
+ * s'appliquent donc qu'aux nouveaux identifiants.
+ *
+ * @param changes Bilan du rechargement, ou NULL.
+ */
+esp_err_t core_state_manager_reload_profiles_diff(const char *base_path, core_state_reload_changes_t *changes);
+
 void core_state_manager_init(void);
-void core_state_manager_update(float delta_seconds);
-void core_state_manager_apply_touch(const core_link_touch_event_t *event);
+
+/**
+ * \brief Avance la simulation de `seconds` secondes, par pas fixes.
+ *
+ * Le modèle ne lit aucune horloge : son temps est un nombre entier de pas de
+ * `CONFIG_CORE_APP_STATE_STEP_MS` (voir state/core_state_sim.h). Tous les pas
+ * dus sont exécutés à pleine vitesse, ce qui rattrape un appelant en retard
+ * comme une avance rapide de plusieurs jours ; le reliquat inférieur à un pas
+ * est reporté à l'appel suivant.
+ *
+ * @return Nombre de pas exécutés.
+ */
+uint32_t core_state_manager_advance(double seconds);
+
+/**
+ * \brief Applique un contact tactile au terrarium sous le doigt.
+ *
+ * L'écran est partagé en bandes verticales égales, une par terrarium publié,
+ * dans l'ordre des trames d'état.
+ *
+ * @param screen_width Largeur annoncée par l'afficheur d'origine (DISPLAY_READY) ;
+ *                     0 ignore l'événement.
+ */
+void core_state_manager_apply_touch(const core_link_touch_event_t *event, uint16_t screen_width);
+
+/**
+ * \brief Sert un repas au terrarium `terrarium_id` au prochain pas de simulation.
+ *
+ * @return ESP_ERR_NOT_FOUND si aucun terrarium ne porte cet identifiant.
+ */
+esp_err_t core_state_manager_feed(uint8_t terrarium_id);
+
+/**
+ * \brief Sérialise la réponse HISTORY_CHUNK à `request`.
+ *
+ * Seuls les terrariums publiés dans les trames d'état sont historisés. Un
+ * identifiant inconnu donne le statut CORE_LINK_HISTORY_UNKNOWN_TERRARIUM,
+ * un historique désactivé (CONFIG_CORE_STATE_HISTORY) ou sans mémoire le
+ * statut CORE_LINK_HISTORY_UNAVAILABLE. L'historique d'un terrarium survit
+ * au rechargement des profils tant que son identifiant reste publié.
+ *
+ * @return Longueur de la charge écrite dans `out`, 0 si `capacity` ne contient
+ *         pas l'en-tête.
+ */
+size_t core_state_manager_read_history(const core_link_history_request_t *request, uint8_t *out, size_t capacity);
+
 void core_state_manager_build_frame(core_link_state_frame_t *frame);
 size_t core_state_manager_get_terrarium_count(void);
 
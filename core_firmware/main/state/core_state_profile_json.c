@@ -0,0 +1,540 @@
+#include "state/core_state_profile_json.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    STATE_VALUE,
+    STATE_ARRAY_FIRST,
+    STATE_OBJECT_FIRST,
+    STATE_KEY,
+    STATE_COLON,
+    STATE_AFTER_VALUE,
+    STATE_STRING,
+    STATE_ESCAPE,
+    STATE_UNICODE,
+    STATE_SURROGATE_BACKSLASH,
+    STATE_SURROGATE_U,
+    STATE_NUMBER,
+    STATE_LITERAL,
+    STATE_DONE,
+    STATE_ERROR,
+};
+
+enum {
+    CTX_NONE,
+    CTX_ROOT,
+    CTX_ENVIRONMENT,
+    CTX_METRICS,
+    CTX_FEEDING,
+};
+
+// Fields of the schema; bit n of `seen` and `numeric` is field n.
+enum {
+    F_SCIENTIFIC_NAME,
+    F_COMMON_NAME,
+    F_ENVIRONMENT,
+    F_METRICS,
+    F_ID,
+    F_CYCLE_SPEED,
+    F_PHASE_OFFSET,
+    F_ENRICHMENT,
+    F_HYDRATION,
+    F_STRESS,
+    F_HEALTH,
+    F_ACTIVITY,
+    F_LAST_FEEDING,
+    F_FEEDING_INTERVAL,
+    F_FEEDING_INTAKE,
+    F_TEMP_DAY,
+    F_TEMP_NIGHT,
+    F_HUMIDITY_DAY,
+    F_HUMIDITY_NIGHT,
+    F_LUX_DAY,
+    F_LUX_NIGHT,
+    F_METRICS_HYDRATION,
+    F_METRICS_STRESS,
+    F_METRICS_HEALTH,
+    F_METRICS_ACTIVITY,
+    F_METRICS_FEEDING,
+    F_FEEDING_HOURS,
+    F_FEEDING_PCT,
+    F_FEEDING_LAST,
+    F_COUNT,
+    F_NONE = 0xFF,
+};
+
+_Static_assert(F_COUNT == CORE_STATE_PROFILE_JSON_FIELD_COUNT, "field count out of sync with the header");
+_Static_assert(F_COUNT <= 32, "seen/numeric are 32-bit masks");
+
+typedef struct {
+    uint8_t context;
+    uint8_t field;
+    const char *key;
+} key_entry_t;
+
+static const key_entry_t s_keys[] = {
+    {CTX_ROOT, F_SCIENTIFIC_NAME, "scientific_name"},
+    {CTX_ROOT, F_COMMON_NAME, "common_name"},
+    {CTX_ROOT, F_ENVIRONMENT, "environment"},
+    {CTX_ROOT, F_METRICS, "metrics"},
+    {CTX_ROOT, F_ID, "id"},
+    {CTX_ROOT, F_CYCLE_SPEED, "cycle_speed"},
+    {CTX_ROOT, F_PHASE_OFFSET, "phase_offset"},
+    {CTX_ROOT, F_ENRICHMENT, "enrichment_factor"},
+    {CTX_ROOT, F_HYDRATION, "hydration_pct"},
+    {CTX_ROOT, F_STRESS, "stress_pct"},
+    {CTX_ROOT, F_HEALTH, "health_pct"},
+    {CTX_ROOT, F_ACTIVITY, "activity_score"},
+    {CTX_ROOT, F_LAST_FEEDING, "last_feeding_timestamp"},
+    {CTX_ROOT, F_FEEDING_INTERVAL, "feeding_interval_hours"},
+    {CTX_ROOT, F_FEEDING_INTAKE, "feeding_intake_pct"},
+    {CTX_ENVIRONMENT, F_TEMP_DAY, "temp_day_c"},
+    {CTX_ENVIRONMENT, F_TEMP_NIGHT, "temp_night_c"},
+    {CTX_ENVIRONMENT, F_HUMIDITY_DAY, "humidity_day_pct"},
+    {CTX_ENVIRONMENT, F_HUMIDITY_NIGHT, "humidity_night_pct"},
+    {CTX_ENVIRONMENT, F_LUX_DAY, "lux_day"},
+    {CTX_ENVIRONMENT, F_LUX_NIGHT, "lux_night"},
+    {CTX_METRICS, F_METRICS_HYDRATION, "hydration_pct"},
+    {CTX_METRICS, F_METRICS_STRESS, "stress_pct"},
+    {CTX_METRICS, F_METRICS_HEALTH, "health_pct"},
+    {CTX_METRICS, F_METRICS_ACTIVITY, "activity_score"},
+    {CTX_METRICS, F_METRICS_FEEDING, "feeding"},
+    {CTX_FEEDING, F_FEEDING_HOURS, "interval_hours"},
+    {CTX_FEEDING, F_FEEDING_PCT, "intake_pct"},
+    {CTX_FEEDING, F_FEEDING_LAST, "last_timestamp"},
+};
+
+static const char *const s_literals[] = {"true", "false", "null"};
+
+static uint8_t lookup_key(uint8_t context, const core_state_profile_json_t *parser)
+{
+    if (context == CTX_NONE || parser->token_truncated) {
+        return F_NONE;
+    }
+    for (size_t i = 0; i < sizeof(s_keys) / sizeof(s_keys[0]); ++i) {
+        if (s_keys[i].context == context && strcmp(s_keys[i].key, parser->token) == 0) {
+            return s_keys[i].field;
+        }
+    }
+    return F_NONE;
+}
+
+// Context of an object opened as the value of `field`.
+static uint8_t child_context(uint8_t field)
+{
+    switch (field) {
+        case F_ENVIRONMENT:
+            return CTX_ENVIRONMENT;
+        case F_METRICS:
+            return CTX_METRICS;
+        case F_METRICS_FEEDING:
+            return CTX_FEEDING;
+        default:
+            return CTX_NONE;
+    }
+}
+
+static void copy_name(char *dest, size_t dest_size, const char *src)
+{
+    size_t len = strlen(src);
+    if (len >= dest_size) {
+        len = dest_size - 1U;
+    }
+    memcpy(dest, src, len);
+    dest[len] = '\0';
+}
+
+static void token_append(core_state_profile_json_t *parser, char c)
+{
+    if (parser->token_len < CORE_STATE_PROFILE_JSON_TOKEN_MAX) {
+        parser->token[parser->token_len++] = c;
+        parser->token[parser->token_len] = '\0';
+    } else {
+        parser->token_truncated = true;
+    }
+}
+
+static void token_append_utf8(core_state_profile_json_t *parser, uint32_t cp)
+{
+    if (cp < 0x80U) {
+        token_append(parser, (char)cp);
+    } else if (cp < 0x800U) {
+        token_append(parser, (char)(0xC0U | (cp >> 6)));
+        token_append(parser, (char)(0x80U | (cp & 0x3FU)));
+    } else if (cp < 0x10000U) {
+        token_append(parser, (char)(0xE0U | (cp >> 12)));
+        token_append(parser, (char)(0x80U | ((cp >> 6) & 0x3FU)));
+        token_append(parser, (char)(0x80U | (cp & 0x3FU)));
+    } else {
+        token_append(parser, (char)(0xF0U | (cp >> 18)));
+        token_append(parser, (char)(0x80U | ((cp >> 12) & 0x3FU)));
+        token_append(parser, (char)(0x80U | ((cp >> 6) & 0x3FU)));
+        token_append(parser, (char)(0x80U | (cp & 0x3FU)));
+    }
+}
+
+static void token_reset(core_state_profile_json_t *parser)
+{
+    parser->token_len = 0;
+    parser->token[0] = '\0';
+    parser->token_truncated = false;
+}
+
+static bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool top_is_array(const core_state_profile_json_t *parser)
+{
+    return (parser->array_levels >> (parser->depth - 1U)) & 1U;
+}
+
+static void value_done(core_state_profile_json_t *parser)
+{
+    parser->state = parser->depth == 0 ? STATE_DONE : STATE_AFTER_VALUE;
+}
+
+static bool push(core_state_profile_json_t *parser, bool array, uint8_t context)
+{
+    if (parser->depth >= CORE_STATE_PROFILE_JSON_MAX_DEPTH) {
+        return false;
+    }
+    uint32_t bit = 1UL << parser->depth;
+    parser->array_levels = array ? (parser->array_levels | bit) : (parser->array_levels & ~bit);
+    parser->context[parser->depth] = context;
+    parser->field[parser->depth] = F_NONE;
+    parser->depth++;
+    parser->state = array ? STATE_ARRAY_FIRST : STATE_OBJECT_FIRST;
+    return true;
+}
+
+static bool pop(core_state_profile_json_t *parser, bool array)
+{
+    if (parser->depth == 0 || top_is_array(parser) != array) {
+        return false;
+    }
+    parser->depth--;
+    value_done(parser);
+    return true;
+}
+
+static bool number_done(core_state_profile_json_t *parser)
+{
+    char *end = NULL;
+    double value = strtod(parser->token, &end);
+    if (parser->token_truncated || end != parser->token + parser->token_len) {
+        return false;
+    }
+    if (parser->value_field != F_NONE) {
+        parser->numbers[parser->value_field] = value;
+        parser->numeric |= 1UL << parser->value_field;
+    }
+    value_done(parser);
+    return true;
+}
+
+static void string_done(core_state_profile_json_t *parser)
+{
+    if (parser->token_is_key) {
+        uint8_t level = (uint8_t)(parser->depth - 1U);
+        parser->field[level] = lookup_key(parser->context[level], parser);
+        parser->state = STATE_COLON;
+        return;
+    }
+    if (parser->value_field == F_SCIENTIFIC_NAME) {
+        copy_name(parser->scientific_name, sizeof(parser->scientific_name), parser->token);
+        parser->has_scientific_name = true;
+    } else if (parser->value_field == F_COMMON_NAME) {
+        copy_name(parser->common_name, sizeof(parser->common_name), parser->token);
+        parser->has_common_name = true;
+    }
+    value_done(parser);
+}
+
+static bool begin_value(core_state_profile_json_t *parser, char c)
+{
+    // Only the first occurrence of a key counts, whatever its type (as cJSON).
+    uint8_t field = F_NONE;
+    uint8_t parent_context = CTX_NONE;
+    if (parser->depth > 0 && !top_is_array(parser)) {
+        field = parser->field[parser->depth - 1U];
+        parent_context = parser->context[parser->depth - 1U];
+    }
+    if (field != F_NONE) {
+        if (parser->seen & (1UL << field)) {
+            field = F_NONE;
+        } else {
+            parser->seen |= 1UL << field;
+        }
+    }
+    parser->value_field = field;
+
+    switch (c) {
+        case '{':
+            return push(parser, false, parser->depth == 0 ? CTX_ROOT : (parent_context ? child_context(field) : CTX_NONE));
+        case '[':
+            return push(parser, true, CTX_NONE);
+        case '"':
+            token_reset(parser);
+            parser->token_is_key = false;
+            parser->state = STATE_STRING;
+            return true;
+        case 't':
+        case 'f':
+        case 'n':
+            parser->literal = c == 't' ? 0 : (c == 'f' ? 1 : 2);
+            parser->literal_pos = 1;
+            parser->state = STATE_LITERAL;
+            return true;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                token_reset(parser);
+                token_append(parser, c);
+                parser->state = STATE_NUMBER;
+                return true;
+            }
+            return false;
+    }
+}
+
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+static bool unicode_done(core_state_profile_json_t *parser)
+{
+    uint32_t cp = parser->unicode;
+    if (parser->high_surrogate) {
+        if (cp < 0xDC00U || cp > 0xDFFFU) {
+            return false;
+        }
+        cp = 0x10000U + ((parser->high_surrogate - 0xD800U) << 10) + (cp - 0xDC00U);
+        parser->high_surrogate = 0;
+    } else if (cp >= 0xD800U && cp <= 0xDBFFU) {
+        parser->high_surrogate = cp;
+        parser->state = STATE_SURROGATE_BACKSLASH;
+        return true;
+    } else if (cp >= 0xDC00U && cp <= 0xDFFFU) {
+        return false;
+    }
+    token_append_utf8(parser, cp);
+    parser->state = STATE_STRING;
+    return true;
+}
+
+static bool step(core_state_profile_json_t *parser, char c)
+{
+    switch (parser->state) {
+        case STATE_VALUE:
+            return is_space(c) || begin_value(parser, c);
+        case STATE_ARRAY_FIRST:
+            if (is_space(c)) {
+                return true;
+            }
+            return c == ']' ? pop(parser, true) : begin_value(parser, c);
+        case STATE_OBJECT_FIRST:
+        case STATE_KEY:
+            if (is_space(c)) {
+                return true;
+            }
+            if (c == '}' && parser->state == STATE_OBJECT_FIRST) {
+                return pop(parser, false);
+            }
+            if (c != '"') {
+                return false;
+            }
+            token_reset(parser);
+            parser->token_is_key = true;
+            parser->state = STATE_STRING;
+            return true;
+        case STATE_COLON:
+            if (is_space(c)) {
+                return true;
+            }
+            if (c != ':') {
+                return false;
+            }
+            parser->state = STATE_VALUE;
+            return true;
+        case STATE_AFTER_VALUE:
+            if (is_space(c)) {
+                return true;
+            }
+            if (c == ',') {
+                parser->state = top_is_array(parser) ? STATE_VALUE : STATE_KEY;
+                return true;
+            }
+            if (c == '}' || c == ']') {
+                return pop(parser, c == ']');
+            }
+            return false;
+        case STATE_STRING:
+            if (c == '"') {
+                string_done(parser);
+            } else if (c == '\\') {
+                parser->state = STATE_ESCAPE;
+            } else {
+                token_append(parser, c);
+            }
+            return true;
+        case STATE_ESCAPE: {
+            static const char escapes[] = "\"\"\\\\//b\bf\fn\nr\rt\t";
+            if (c == 'u') {
+                parser->unicode = 0;
+                parser->unicode_digits = 0;
+                parser->state = STATE_UNICODE;
+                return true;
+            }
+            for (size_t i = 0; escapes[i] != '\0'; i += 2) {
+                if (escapes[i] == c) {
+                    token_append(parser, escapes[i + 1]);
+                    parser->state = STATE_STRING;
+                    return true;
+                }
+            }
+            return false;
+        }
+        case STATE_UNICODE: {
+            int digit = hex_value(c);
+            if (digit < 0) {
+                return false;
+            }
+            parser->unicode = (parser->unicode << 4) | (uint32_t)digit;
+            return ++parser->unicode_digits < 4 || unicode_done(parser);
+        }
+        case STATE_SURROGATE_BACKSLASH:
+            parser->state = STATE_SURROGATE_U;
+            return c == '\\';
+        case STATE_SURROGATE_U:
+            parser->unicode = 0;
+            parser->unicode_digits = 0;
+            parser->state = STATE_UNICODE;
+            return c == 'u';
+        case STATE_NUMBER:
+            if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+                token_append(parser, c);
+                return true;
+            }
+            // The terminator belongs to the enclosing container.
+            return number_done(parser) && step(parser, c);
+        case STATE_LITERAL: {
+            const char *literal = s_literals[parser->literal];
+            if (c != literal[parser->literal_pos]) {
+                return false;
+            }
+            if (literal[++parser->literal_pos] == '\0') {
+                value_done(parser);
+            }
+            return true;
+        }
+        case STATE_DONE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void core_state_profile_json_init(core_state_profile_json_t *parser)
+{
+    memset(parser, 0, sizeof(*parser));
+    parser->state = STATE_VALUE;
+    parser->value_field = F_NONE;
+}
+
+bool core_state_profile_json_feed(core_state_profile_json_t *parser, const char *data, size_t length)
+{
+    for (size_t i = 0; i < length && parser->state != STATE_DONE; ++i) {
+        if (!step(parser, data[i])) {
+            parser->state = STATE_ERROR;
+            return false;
+        }
+    }
+    return parser->state != STATE_ERROR;
+}
+
+static bool has_number(const core_state_profile_json_t *parser, uint8_t field)
+{
+    return (parser->numeric >> field) & 1U;
+}
+
+static float number_or(const core_state_profile_json_t *parser, uint8_t field, float fallback)
+{
+    return has_number(parser, field) ? (float)parser->numbers[field] : fallback;
+}
+
+bool core_state_profile_json_finish(core_state_profile_json_t *parser, core_state_slot_t *slot, size_t index)
+{
+    if (parser->state == STATE_NUMBER && parser->depth == 0 && !number_done(parser)) {
+        parser->state = STATE_ERROR;
+    }
+    if (parser->state != STATE_DONE) {
+        return false;
+    }
+
+    memset(slot, 0, sizeof(*slot));
+    slot->id = (uint8_t)index;
+    copy_name(slot->scientific_name, sizeof(slot->scientific_name),
+              parser->has_scientific_name ? parser->scientific_name : "Unknown species");
+    copy_name(slot->common_name, sizeof(slot->common_name), parser->has_common_name ? parser->common_name : "Terrarium");
+
+    slot->base_temp_day = number_or(parser, F_TEMP_DAY, 0.0f);
+    slot->base_temp_night = number_or(parser, F_TEMP_NIGHT, 0.0f);
+    slot->base_humidity_day = number_or(parser, F_HUMIDITY_DAY, 0.0f);
+    slot->base_humidity_night = number_or(parser, F_HUMIDITY_NIGHT, 0.0f);
+    slot->base_lux_day = number_or(parser, F_LUX_DAY, 0.0f);
+    slot->base_lux_night = number_or(parser, F_LUX_NIGHT, 0.0f);
+
+    if (has_number(parser, F_ID) && parser->numbers[F_ID] >= 0.0) {
+        slot->id = (uint8_t)parser->numbers[F_ID];
+    }
+    slot->cycle_speed = number_or(parser, F_CYCLE_SPEED, NAN);
+    slot->phase_offset = number_or(parser, F_PHASE_OFFSET, NAN);
+    slot->enrichment_factor = number_or(parser, F_ENRICHMENT, NAN);
+    slot->feeding_interval_hours = number_or(parser, F_FEEDING_INTERVAL, NAN);
+    slot->feeding_intake_pct = number_or(parser, F_FEEDING_INTAKE, NAN);
+    if (has_number(parser, F_LAST_FEEDING) && parser->numbers[F_LAST_FEEDING] >= 0.0) {
+        slot->last_feeding_timestamp = (uint32_t)parser->numbers[F_LAST_FEEDING];
+    }
+
+    // metrics.* override the legacy root keys; a finite start value is also the target.
+    slot->hydration_pct = number_or(parser, F_METRICS_HYDRATION, number_or(parser, F_HYDRATION, NAN));
+    slot->stress_pct = number_or(parser, F_METRICS_STRESS, number_or(parser, F_STRESS, NAN));
+    slot->health_pct = number_or(parser, F_METRICS_HEALTH, number_or(parser, F_HEALTH, NAN));
+    slot->activity_score = number_or(parser, F_METRICS_ACTIVITY, number_or(parser, F_ACTIVITY, NAN));
+    slot->target_hydration_pct = isfinite(slot->hydration_pct) ? slot->hydration_pct : NAN;
+    slot->target_stress_pct = isfinite(slot->stress_pct) ? slot->stress_pct : NAN;
+    slot->target_health_pct = isfinite(slot->health_pct) ? slot->health_pct : NAN;
+
+    slot->feeding_interval_hours = number_or(parser, F_FEEDING_HOURS, slot->feeding_interval_hours);
+    slot->feeding_intake_pct = number_or(parser, F_FEEDING_PCT, slot->feeding_intake_pct);
+    if (has_number(parser, F_FEEDING_LAST) && parser->numbers[F_FEEDING_LAST] >= 0.0) {
+        slot->last_feeding_timestamp = (uint32_t)parser->numbers[F_FEEDING_LAST];
+    }
+    return true;
+}
+
+bool core_state_profile_json_has_id(const core_state_profile_json_t *parser)
+{
+    return has_number(parser, F_ID) && parser->numbers[F_ID] >= 0.0;
+}
+
+bool core_state_profile_json_parse(const char *json, size_t length, core_state_slot_t *slot, size_t index)
+{
+    core_state_profile_json_t parser;
+    core_state_profile_json_init(&parser);
+    return core_state_profile_json_feed(&parser, json, length) &&
+           core_state_profile_json_finish(&parser, slot, index);
+}
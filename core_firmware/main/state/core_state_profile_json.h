@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "state/core_state_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Analyseur JSON en flux du schéma des profils terrarium (voir
+ * core_state_manager_reload_profiles()), sans allocation : le texte est
+ * fourni par morceaux de taille quelconque, seuls les champs du schéma sont
+ * retenus et le reste est validé puis ignoré.
+ *
+ * Le résultat est celui de l'ancienne analyse cJSON : première occurrence
+ * d'une clé dupliquée, valeurs de `metrics` prioritaires sur celles de la
+ * racine, NAN pour une métrique absente (core_state_manager complète ensuite
+ * les valeurs par défaut). Comme cJSON, ce qui suit la valeur racine est
+ * ignoré.
+ */
+
+/* Imbrication maximale, y compris dans les clés inconnues. */
+#define CORE_STATE_PROFILE_JSON_MAX_DEPTH 32
+/* Octets retenus d'une chaîne ou d'un nombre ; une chaîne plus longue est tronquée. */
+#define CORE_STATE_PROFILE_JSON_TOKEN_MAX 63
+/* Champs du schéma suivis par l'analyseur. */
+#define CORE_STATE_PROFILE_JSON_FIELD_COUNT 29
+
+typedef struct {
+    uint8_t state;
+    uint8_t depth;
+    uint32_t array_levels; /* bit n : le niveau n est un tableau */
+    uint8_t context[CORE_STATE_PROFILE_JSON_MAX_DEPTH];
+    uint8_t field[CORE_STATE_PROFILE_JSON_MAX_DEPTH]; /* clé en cours de chaque objet */
+    uint8_t value_field; /* champ recevant la valeur en cours, s'il en est la première occurrence */
+    bool token_is_key;
+    bool token_truncated;
+    uint8_t literal;
+    uint8_t literal_pos;
+    uint8_t unicode_digits;
+    uint32_t unicode;
+    uint32_t high_surrogate;
+    size_t token_len;
+    char token[CORE_STATE_PROFILE_JSON_TOKEN_MAX + 1];
+    /* Champs rencontrés (première occurrence) et valeurs numériques retenues. */
+    uint32_t seen;
+    uint32_t numeric;
+    double numbers[CORE_STATE_PROFILE_JSON_FIELD_COUNT];
+    char scientific_name[CORE_LINK_NAME_MAX_LEN + 1];
+    char common_name[CORE_LINK_NAME_MAX_LEN + 1];
+    bool has_scientific_name;
+    bool has_common_name;
+} core_state_profile_json_t;
+
+void core_state_profile_json_init(core_state_profile_json_t *parser);
+
+/**
+ * \brief Analyse `length` octets supplémentaires.
+ *
+ * @return false dès que le texte n'est plus du JSON valide.
+ */
+bool core_state_profile_json_feed(core_state_profile_json_t *parser, const char *data, size_t length);
+
+/**
+ * \brief Termine l'analyse et remplit `slot`.
+ *
+ * `index` sert d'identifiant lorsque le profil n'en donne pas.
+ *
+ * @return false si le texte était invalide ou incomplet (`slot` inchangé).
+ */
+bool core_state_profile_json_finish(core_state_profile_json_t *parser, core_state_slot_t *slot, size_t index);
+
+/** Le profil fixe-t-il son identifiant (`id` numérique ≥ 0) ? Après core_state_profile_json_finish(). */
+bool core_state_profile_json_has_id(const core_state_profile_json_t *parser);
+
+/** Analyse un texte complet en une fois. */
+bool core_state_profile_json_parse(const char *json, size_t length, core_state_slot_t *slot, size_t index);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,306 @@
+#include "state/core_state_profiles.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "state/core_state_profile_json.h"
+
+#define PROFILE_PATH_MAX 256
+// Read granularity of a profile; the parser keeps no reference to it.
+#define PROFILE_CHUNK 256
+
+bool core_state_profiles_cache_path(const char *directory, char *dest, size_t dest_size)
+{
+    size_t len = strlen(directory);
+    while (len > 1 && directory[len - 1] == '/') {
+        --len;
+    }
+    int written = snprintf(dest, dest_size, "%.*s.bin", (int)len, directory);
+    return written > 0 && (size_t)written < dest_size;
+}
+
+uint32_t core_state_profiles_crc32(uint32_t crc, const void *data, size_t length)
+{
+    // Nibble table: 64 bytes of flash instead of 1 KiB.
+    static const uint32_t table[16] = {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL,
+        0x4DB26158UL, 0x5005713CUL, 0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+        0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+    };
+    const uint8_t *bytes = data;
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ table[crc & 0x0FU];
+        crc = (crc >> 4) ^ table[crc & 0x0FU];
+    }
+    return ~crc;
+}
+
+static bool has_json_extension(const char *name)
+{
+    size_t len = strlen(name);
+    return (len >= 5 && strcasecmp(&name[len - 5], ".json") == 0);
+}
+
+static bool is_candidate(const char *name)
+{
+    return name[0] != '.' && has_json_extension(name) && strlen(name) < CORE_STATE_PROFILE_NAME_MAX;
+}
+
+static bool stat_profile(const char *directory, const char *name, int64_t *mtime, uint32_t *size)
+{
+    char path[PROFILE_PATH_MAX];
+    int written = snprintf(path, sizeof(path), "%s/%s", directory, name);
+    struct stat st;
+    if (written <= 0 || (size_t)written >= sizeof(path) || stat(path, &st) != 0) {
+        return false;
+    }
+    *mtime = (int64_t)st.st_mtime;
+    *size = (uint32_t)st.st_size;
+    return true;
+}
+
+static int compare_entries(const void *lhs, const void *rhs)
+{
+    const core_state_profile_entry_t *a = lhs;
+    const core_state_profile_entry_t *b = rhs;
+    return strcasecmp(a->name, b->name);
+}
+
+static uint32_t entries_crc(const core_state_profile_cache_t *cache)
+{
+    return core_state_profiles_crc32(0, cache->entries, cache->count * sizeof(cache->entries[0]));
+}
+
+// Reads the cache in one go and checks it against the directory, file by file.
+static bool load_cache(const char *directory, const char *cache_path, core_state_profile_cache_t *cache,
+                       size_t capacity)
+{
+    int fd = open(cache_path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(*cache) &&
+              (size_t)st.st_size <= CORE_STATE_PROFILE_CACHE_SIZE(capacity) &&
+              read(fd, cache, (size_t)st.st_size) == (ssize_t)st.st_size;
+    close(fd);
+    if (!ok || cache->magic != CORE_STATE_PROFILE_CACHE_MAGIC || cache->version != CORE_STATE_PROFILE_CACHE_VERSION ||
+        cache->entry_size != sizeof(cache->entries[0]) || cache->count > capacity ||
+        (size_t)st.st_size != CORE_STATE_PROFILE_CACHE_SIZE(cache->count) || cache->crc32 != entries_crc(cache)) {
+        return false;
+    }
+
+    DIR *dir = opendir(directory);
+    if (!dir) {
+        return false;
+    }
+    size_t seen = 0;
+    struct dirent *entry = NULL;
+    while (ok && (entry = readdir(dir)) != NULL) {
+        if (!is_candidate(entry->d_name)) {
+            continue;
+        }
+        core_state_profile_entry_t key;
+        memcpy(key.name, entry->d_name, strlen(entry->d_name) + 1U);
+        const core_state_profile_entry_t *cached =
+            bsearch(&key, cache->entries, cache->count, sizeof(key), compare_entries);
+        ok = ++seen <= cache->count && cached && strcmp(cached->name, key.name) == 0 &&
+             stat_profile(directory, key.name, &key.mtime, &key.size) && cached->mtime == key.mtime &&
+             cached->size == key.size;
+    }
+    closedir(dir);
+    return ok && seen == cache->count;
+}
+
+static bool parse_profile(const char *directory, core_state_profile_entry_t *entry)
+{
+    char path[PROFILE_PATH_MAX];
+    int written = snprintf(path, sizeof(path), "%s/%s", directory, entry->name);
+    if (written <= 0 || (size_t)written >= sizeof(path)) {
+        return false;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    core_state_profile_json_t parser;
+    core_state_profile_json_init(&parser);
+    char chunk[PROFILE_CHUNK];
+    bool ok = true;
+    ssize_t got;
+    while (ok && (got = read(fd, chunk, sizeof(chunk))) > 0) {
+        ok = core_state_profile_json_feed(&parser, chunk, (size_t)got);
+    }
+    close(fd);
+    if (!ok || got != 0 || !core_state_profile_json_finish(&parser, &entry->slot, 0)) {
+        return false;
+    }
+    entry->has_id = core_state_profile_json_has_id(&parser);
+    return true;
+}
+
+// Same file, same stamp: the previous result stands.
+static bool reuse_previous(const core_state_profile_cache_t *previous, core_state_profile_entry_t *entry)
+{
+    if (!previous) {
+        return false;
+    }
+    const core_state_profile_entry_t *old =
+        bsearch(entry, previous->entries, previous->count, sizeof(*entry), compare_entries);
+    if (!old || strcmp(old->name, entry->name) != 0 || old->mtime != entry->mtime || old->size != entry->size) {
+        return false;
+    }
+    entry->valid = old->valid;
+    entry->has_id = old->has_id;
+    entry->slot = old->slot;
+    return true;
+}
+
+static void mark_id(uint32_t *ids, uint8_t id)
+{
+    ids[id / 32U] |= 1UL << (id % 32U);
+}
+
+static bool id_marked(const uint32_t *ids, uint8_t id)
+{
+    return (ids[id / 32U] >> (id % 32U)) & 1U;
+}
+
+// Numbers the profiles without an "id" key. Each keeps the ID it had under the
+// same file name in `previous`, unless a profile now claims it explicitly; the
+// others take the lowest IDs left, so that adding a file renumbers nothing.
+static void assign_ids(core_state_profile_cache_t *cache, const core_state_profile_cache_t *previous)
+{
+    enum { AWAITING_ID = 2 }; /* valid, numbered by the last pass */
+    uint32_t used[256 / 32] = {0};
+    for (size_t i = 0; i < cache->count; ++i) {
+        if (cache->entries[i].valid && cache->entries[i].has_id) {
+            mark_id(used, cache->entries[i].slot.id);
+        }
+    }
+    for (size_t i = 0; i < cache->count; ++i) {
+        core_state_profile_entry_t *entry = &cache->entries[i];
+        if (!entry->valid || entry->has_id) {
+            continue;
+        }
+        const core_state_profile_entry_t *old =
+            previous ? bsearch(entry, previous->entries, previous->count, sizeof(*entry), compare_entries) : NULL;
+        if (old && old->valid && strcmp(old->name, entry->name) == 0 && !id_marked(used, old->slot.id)) {
+            entry->slot.id = old->slot.id;
+            mark_id(used, entry->slot.id);
+        } else {
+            entry->valid = AWAITING_ID;
+        }
+    }
+    unsigned next = 0;
+    for (size_t i = 0; i < cache->count; ++i) {
+        core_state_profile_entry_t *entry = &cache->entries[i];
+        if (entry->valid != AWAITING_ID) {
+            continue;
+        }
+        while (next < 256U && id_marked(used, (uint8_t)next)) {
+            ++next;
+        }
+        // Past 256 profiles IDs repeat; the manager reports the shadowed ones.
+        entry->slot.id = (uint8_t)(next < 256U ? next : i);
+        if (next < 256U) {
+            mark_id(used, entry->slot.id);
+        }
+        entry->valid = 1;
+    }
+}
+
+static bool write_cache(const char *cache_path, const core_state_profile_cache_t *cache)
+{
+    int fd = open(cache_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t size = CORE_STATE_PROFILE_CACHE_SIZE(cache->count);
+    bool ok = write(fd, cache, size) == (ssize_t)size;
+    ok = close(fd) == 0 && ok;
+    if (!ok) {
+        unlink(cache_path);
+    }
+    return ok;
+}
+
+core_state_profiles_status_t core_state_profiles_load(const char *directory, const char *cache_path,
+                                                      const core_state_profile_cache_t *previous,
+                                                      core_state_profile_cache_t *cache, size_t capacity,
+                                                      core_state_profiles_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+
+    if (cache_path && load_cache(directory, cache_path, cache, capacity)) {
+        stats->cache_hit = true;
+        stats->files = cache->count;
+        for (size_t i = 0; i < cache->count; ++i) {
+            stats->valid += cache->entries[i].valid;
+        }
+        return stats->valid > 0 ? CORE_STATE_PROFILES_OK : CORE_STATE_PROFILES_EMPTY;
+    }
+
+    DIR *dir = opendir(directory);
+    if (!dir) {
+        return (errno == ENOENT) ? CORE_STATE_PROFILES_NOT_FOUND : CORE_STATE_PROFILES_IO_ERROR;
+    }
+    // Zeroed so that padding, and therefore the CRC, is deterministic.
+    memset(cache, 0, sizeof(*cache));
+    struct dirent *dirent = NULL;
+    while ((dirent = readdir(dir)) != NULL) {
+        if (dirent->d_name[0] == '.' || !has_json_extension(dirent->d_name)) {
+            continue;
+        }
+        if (cache->count >= capacity) {
+            stats->truncated = true;
+            break;
+        }
+        core_state_profile_entry_t *entry = &cache->entries[cache->count];
+        memset(entry, 0, sizeof(*entry));
+        if (!is_candidate(dirent->d_name) || !stat_profile(directory, dirent->d_name, &entry->mtime, &entry->size)) {
+            ++stats->skipped;
+            continue;
+        }
+        memcpy(entry->name, dirent->d_name, strlen(dirent->d_name) + 1U);
+        ++cache->count;
+    }
+    closedir(dir);
+
+    stats->files = cache->count;
+    if (cache->count == 0) {
+        return CORE_STATE_PROFILES_NOT_FOUND;
+    }
+    qsort(cache->entries, cache->count, sizeof(cache->entries[0]), compare_entries);
+
+    for (size_t i = 0; i < cache->count; ++i) {
+        core_state_profile_entry_t *entry = &cache->entries[i];
+        if (reuse_previous(previous, entry)) {
+            ++stats->reused;
+        } else if (!parse_profile(directory, entry)) {
+            memset(&entry->slot, 0, sizeof(entry->slot));
+        } else {
+            entry->valid = 1;
+        }
+        stats->valid += entry->valid;
+    }
+    assign_ids(cache, previous);
+
+    if (cache_path && !stats->truncated) {
+        cache->magic = CORE_STATE_PROFILE_CACHE_MAGIC;
+        cache->version = CORE_STATE_PROFILE_CACHE_VERSION;
+        cache->entry_size = sizeof(cache->entries[0]);
+        cache->crc32 = entries_crc(cache);
+        stats->cache_written = write_cache(cache_path, cache);
+    }
+    return stats->valid > 0 ? CORE_STATE_PROFILES_OK : CORE_STATE_PROFILES_EMPTY;
+}
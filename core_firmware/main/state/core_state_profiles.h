@@ -0,0 +1,104 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "state/core_state_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Chargement d'un répertoire de profils `*.json`, sans dépendance ESP-IDF.
+ *
+ * Les profils analysés sont conservés dans un cache binaire (voir
+ * core_state_profiles_cache_path()) : date de modification et taille de
+ * chaque fichier source, profils bruts (avant valeurs par défaut) et CRC-32.
+ * Au démarrage suivant, si le répertoire n'a pas changé, le cache est relu
+ * d'une seule lecture et aucun JSON n'est analysé. Sinon les fichiers sont
+ * relus par blocs sur la pile (core_state_profile_json.h) et le cache est
+ * réécrit ; un cache tronqué par une coupure échoue au CRC et est reconstruit.
+ * Lors d'un rechargement à chaud, le résultat précédent évite aussi de relire
+ * les fichiers dont la date et la taille n'ont pas changé.
+ */
+
+/* Nom de fichier retenu (extension comprise) ; un nom plus long est ignoré. */
+#define CORE_STATE_PROFILE_NAME_MAX 64
+#define CORE_STATE_PROFILE_CACHE_MAGIC 0x43505343UL /* "CSPC" */
+#define CORE_STATE_PROFILE_CACHE_VERSION 2U
+
+typedef struct {
+    char name[CORE_STATE_PROFILE_NAME_MAX];
+    int64_t mtime;
+    uint32_t size;
+    uint8_t valid;  /* 0 : JSON invalide ou illisible, `slot` à ignorer */
+    uint8_t has_id; /* `slot.id` vient du profil, sinon attribué au chargement */
+    core_state_slot_t slot;
+} core_state_profile_entry_t;
+
+/* Image du fichier cache ; l'en-tête et les entrées sont lus en un bloc. */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entry_size;
+    uint32_t count;
+    uint32_t crc32; /* des `count` entrées */
+    core_state_profile_entry_t entries[];
+} core_state_profile_cache_t;
+
+#define CORE_STATE_PROFILE_CACHE_SIZE(capacity) \
+    (sizeof(core_state_profile_cache_t) + (size_t)(capacity) * sizeof(core_state_profile_entry_t))
+
+typedef enum {
+    CORE_STATE_PROFILES_OK,
+    CORE_STATE_PROFILES_NOT_FOUND, /* répertoire absent ou sans `*.json` */
+    CORE_STATE_PROFILES_EMPTY,     /* aucun profil valide */
+    CORE_STATE_PROFILES_IO_ERROR,
+} core_state_profiles_status_t;
+
+typedef struct {
+    size_t files;      /* fichiers `*.json` retenus */
+    size_t valid;      /* profils valides, dans l'ordre des entrées */
+    size_t skipped;    /* noms trop longs ou fichiers introuvables au stat() */
+    size_t reused;     /* entrées reprises de `previous` sans relire le fichier */
+    bool truncated;    /* plus de fichiers que `capacity` : cache non écrit */
+    bool cache_hit;
+    bool cache_written;
+} core_state_profiles_stats_t;
+
+/**
+ * \brief Chemin du cache d'un répertoire : `<directory>.bin`, à côté de lui.
+ *
+ * @return false si `dest_size` est insuffisant.
+ */
+bool core_state_profiles_cache_path(const char *directory, char *dest, size_t dest_size);
+
+/**
+ * \brief Charge les profils de `directory` dans `cache->entries`.
+ *
+ * Les entrées sont triées par nom (sans casse). `cache` doit offrir
+ * CORE_STATE_PROFILE_CACHE_SIZE(capacity) octets. `cache_path` NULL désactive
+ * le cache.
+ *
+ * `previous`, s'il n'est pas NULL, est le résultat d'un chargement antérieur du
+ * même répertoire (distinct de `cache`) : lorsque le cache doit être
+ * reconstruit, un fichier de même nom, date et taille y est repris tel quel.
+ *
+ * Un profil sans clé `id` garde l'identifiant qu'avait le fichier de même nom
+ * dans `previous`, sauf si un autre profil le revendique explicitement ; les
+ * autres reçoivent les plus petits identifiants libres, dans l'ordre des noms.
+ * Ajouter ou retirer un fichier ne renumérote donc pas les autres.
+ */
+core_state_profiles_status_t core_state_profiles_load(const char *directory, const char *cache_path,
+                                                      const core_state_profile_cache_t *previous,
+                                                      core_state_profile_cache_t *cache, size_t capacity,
+                                                      core_state_profiles_stats_t *stats);
+
+/** CRC-32 (IEEE 802.3) de `length` octets, chaînable depuis `crc` = 0. */
+uint32_t core_state_profiles_crc32(uint32_t crc, const void *data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
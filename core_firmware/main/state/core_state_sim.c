@@ -0,0 +1,74 @@
+#include "state/core_state_sim.h"
+
+#include <string.h>
+
+void core_state_sim_init(core_state_sim_t *sim, uint32_t step_ms, uint32_t base_epoch)
+{
+    const uint32_t max_step_ms = (uint32_t)(CORE_STATE_OSC_MAX_ADVANCE_S * 1000.0f);
+    if (step_ms == 0U) {
+        step_ms = 1U;
+    } else if (step_ms > max_step_ms) {
+        step_ms = max_step_ms;
+    }
+    memset(sim, 0, sizeof(*sim));
+    sim->step_us = step_ms * 1000U;
+    sim->base_epoch = base_epoch;
+}
+
+void core_state_sim_add_time(core_state_sim_t *sim, uint64_t elapsed_us)
+{
+    sim->pending_us += elapsed_us;
+}
+
+uint64_t core_state_sim_pending_steps(const core_state_sim_t *sim)
+{
+    return sim->pending_us / sim->step_us;
+}
+
+bool core_state_sim_next(core_state_sim_t *sim, core_state_sim_tick_t *tick)
+{
+    if (sim->pending_us < sim->step_us) {
+        return false;
+    }
+    sim->pending_us -= sim->step_us;
+    ++sim->steps;
+
+    // Every input is derived from the step index alone, never from a clock.
+    float step_s = (float)sim->step_us * 1e-6f;
+    tick->step.advance_s = step_s;
+    tick->step.delta_seconds = step_s;
+    tick->step.now_epoch = core_state_sim_epoch(sim);
+    tick->renormalize = (sim->steps % CORE_STATE_SIM_RENORM_STEPS) == 0U;
+
+    // Rounding drift is bounded by re-anchoring each slot once per period.
+    tick->anchor_first = (size_t)(sim->steps % CORE_STATE_SIM_ANCHOR_PERIOD);
+    tick->anchor_time_s = core_state_sim_time_s(sim);
+    return true;
+}
+
+void core_state_sim_apply(const core_state_sim_tick_t *tick, core_state_soa_t *soa, size_t begin, size_t end)
+{
+    core_state_kernel_update(soa, begin, end, &tick->step);
+    if (tick->renormalize) {
+        core_state_kernel_renormalize(soa, begin, end);
+    }
+    if (end > soa->count) {
+        end = soa->count;
+    }
+    // First slot of [begin, end) congruent to anchor_first, then every period.
+    size_t slot = begin + (tick->anchor_first + CORE_STATE_SIM_ANCHOR_PERIOD - begin % CORE_STATE_SIM_ANCHOR_PERIOD) %
+                              CORE_STATE_SIM_ANCHOR_PERIOD;
+    for (; slot < end; slot += CORE_STATE_SIM_ANCHOR_PERIOD) {
+        core_state_soa_anchor(soa, slot, slot + 1U, tick->anchor_time_s);
+    }
+}
+
+double core_state_sim_time_s(const core_state_sim_t *sim)
+{
+    return (double)(sim->steps * sim->step_us) / 1000000.0;
+}
+
+uint32_t core_state_sim_epoch(const core_state_sim_t *sim)
+{
+    return sim->base_epoch + (uint32_t)(sim->steps * sim->step_us / 1000000U);
+}
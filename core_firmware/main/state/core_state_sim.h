@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "state/core_state_kernel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Intégrateur à pas fixe du modèle des terrariums, sans dépendance ESP-IDF.
+ *
+ * Le temps simulé est un nombre entier de pas : l'appelant y verse le temps
+ * écoulé (core_state_sim_add_time()), le reliquat inférieur à un pas est
+ * conservé et chaque pas dû est dépilé par core_state_sim_next(). Les entrées
+ * du noyau (durée du pas, epoch, renormalisation, recalage tournant des
+ * phaseurs) ne dépendent que du rang du pas : la même durée totale, versée en
+ * une fois ou par morceaux, donne le même état au bit près. Aucun pas n'est
+ * perdu quand l'appelant prend du retard ; il est rattrapé à l'appel suivant.
+ */
+
+/* Pas entre deux renormalisations des phaseurs. */
+#define CORE_STATE_SIM_RENORM_STEPS 32U
+/*
+ * Pas entre deux recalages d'un même emplacement sur sa phase exacte (51 s à
+ * 100 ms) : au pas n sont recalés les emplacements i ≡ n (mod période), soit au
+ * plus deux par pas jusqu'à 1024 emplacements.
+ */
+#define CORE_STATE_SIM_ANCHOR_PERIOD 512U
+
+typedef struct {
+    uint32_t step_us;
+    uint32_t base_epoch;
+    uint64_t steps;      /* pas effectués depuis l'origine */
+    uint64_t pending_us; /* temps versé et pas encore simulé */
+} core_state_sim_t;
+
+/* Entrées d'un pas, appliquées tranche par tranche par core_state_sim_apply(). */
+typedef struct {
+    core_state_step_t step;
+    bool renormalize;
+    size_t anchor_first; /* < CORE_STATE_SIM_ANCHOR_PERIOD */
+    double anchor_time_s;
+} core_state_sim_tick_t;
+
+/**
+ * \brief Remet le temps simulé à l'origine.
+ *
+ * `step_ms` est borné à [1, CORE_STATE_OSC_MAX_ADVANCE_S] ; `base_epoch` est
+ * l'epoch Unix du temps simulé 0.
+ */
+void core_state_sim_init(core_state_sim_t *sim, uint32_t step_ms, uint32_t base_epoch);
+
+/** Verse `elapsed_us` microsecondes à simuler. */
+void core_state_sim_add_time(core_state_sim_t *sim, uint64_t elapsed_us);
+
+/** Nombre de pas dus et pas encore dépilés. */
+uint64_t core_state_sim_pending_steps(const core_state_sim_t *sim);
+
+/**
+ * \brief Dépile le prochain pas dû.
+ *
+ * @return false sans pas dû (`tick` inchangé).
+ */
+bool core_state_sim_next(core_state_sim_t *sim, core_state_sim_tick_t *tick);
+
+/**
+ * \brief Applique `tick` aux emplacements [begin, end) de `soa`.
+ *
+ * Les emplacements sont indépendants : appliquer un pas tranche par tranche,
+ * dans n'importe quel découpage, donne le même résultat qu'en une fois.
+ */
+void core_state_sim_apply(const core_state_sim_tick_t *tick, core_state_soa_t *soa, size_t begin, size_t end);
+
+/** Temps simulé écoulé, en secondes (instant où les phaseurs sont recalés). */
+double core_state_sim_time_s(const core_state_sim_t *sim);
+
+/** Epoch Unix simulée, à la seconde. */
+uint32_t core_state_sim_epoch(const core_state_sim_t *sim);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,54 @@
+#include "state/core_state_snapshot.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+void core_state_snapshot_init(core_state_snapshot_t *snapshot, core_link_state_frame_t *first,
+                              core_link_state_frame_t *second)
+{
+    snapshot->buffers[0] = first;
+    snapshot->buffers[1] = second;
+    atomic_init(&snapshot->seq, 0);
+}
+
+core_link_state_frame_t *core_state_snapshot_begin(core_state_snapshot_t *snapshot)
+{
+    uint32_t seq = (uint32_t)atomic_load_explicit(&snapshot->seq, memory_order_relaxed);
+    // The buffer about to be rewritten was published as seq - 1. Its readers must
+    // see the newer sequence once they can see any of the stores below.
+    atomic_thread_fence(memory_order_release);
+    return snapshot->buffers[(seq + 1U) & 1U];
+}
+
+void core_state_snapshot_publish(core_state_snapshot_t *snapshot)
+{
+    uint32_t seq = (uint32_t)atomic_load_explicit(&snapshot->seq, memory_order_relaxed);
+    atomic_store_explicit(&snapshot->seq, seq + 1U, memory_order_release);
+}
+
+uint32_t core_state_snapshot_read(const core_state_snapshot_t *snapshot, core_link_state_frame_t *dst)
+{
+    while (true) {
+        uint32_t seq = (uint32_t)atomic_load_explicit(&snapshot->seq, memory_order_acquire);
+        const core_link_state_frame_t *src = snapshot->buffers[seq & 1U];
+
+        // A torn count is bounded by both capacities; the retry discards the copy.
+        size_t count = src->terrarium_count;
+        if (count > src->terrarium_capacity) {
+            count = src->terrarium_capacity;
+        }
+        if (count > dst->terrarium_capacity) {
+            count = dst->terrarium_capacity;
+        }
+        dst->epoch_seconds = src->epoch_seconds;
+        dst->sample_us = src->sample_us;
+        dst->name_generation = src->name_generation;
+        dst->terrarium_count = (uint8_t)count;
+        memcpy(dst->terrariums, src->terrariums, count * sizeof(src->terrariums[0]));
+
+        atomic_thread_fence(memory_order_acquire);
+        if ((uint32_t)atomic_load_explicit(&snapshot->seq, memory_order_relaxed) == seq) {
+            return seq;
+        }
+    }
+}
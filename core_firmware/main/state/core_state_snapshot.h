@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Publication de l'état simulé par double tampon et compteur de séquence
+ * (seqlock), sans dépendance ESP-IDF.
+ *
+ * L'écrivain unique remplit le tampon non publié puis incrémente le compteur :
+ * il ne s'arrête jamais pour un lecteur. Un lecteur copie le tampon désigné
+ * par le compteur et recommence si celui-ci a changé pendant la copie : toute
+ * publication tombée pendant une copie la fait refaire, même si le tampon lu
+ * n'a pas encore été réécrit (begin() ne touche pas au compteur, le lecteur ne
+ * peut pas distinguer les deux cas). Le double tampon sert à l'écrivain, qui
+ * n'attend jamais la fin d'une lecture ; une copie est bien plus courte qu'un
+ * pas, si bien que les relectures restent rares.
+ */
+
+typedef struct {
+    atomic_uint_least32_t seq; /* publications ; tampon publié = seq & 1 */
+    core_link_state_frame_t *buffers[2];
+} core_state_snapshot_t;
+
+/**
+ * \brief Prépare la publication sur deux trames initialisées de même capacité.
+ *
+ * Tant que rien n'est publié, les lecteurs obtiennent `first` (vide).
+ */
+void core_state_snapshot_init(core_state_snapshot_t *snapshot, core_link_state_frame_t *first,
+                              core_link_state_frame_t *second);
+
+/** Trame à remplir pour la prochaine publication (écrivain). */
+core_link_state_frame_t *core_state_snapshot_begin(core_state_snapshot_t *snapshot);
+
+/** Publie la trame obtenue par core_state_snapshot_begin() (écrivain). */
+void core_state_snapshot_publish(core_state_snapshot_t *snapshot);
+
+/**
+ * \brief Copie la dernière publication dans `dst`, tronquée à sa capacité.
+ *
+ * Sûr depuis n'importe quelle tâche, en parallèle de l'écrivain.
+ *
+ * @return Numéro de la publication copiée (0 avant la première).
+ */
+uint32_t core_state_snapshot_read(const core_state_snapshot_t *snapshot, core_link_state_frame_t *dst);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Référence d'un STATE_FULL_COMPRESSED : la dernière charge STATE_FULL /
+ * STATE_FULL_COMPACT complète (horodatage compris) émise par le cœur ou
+ * appliquée par l'afficheur. Les deux extrémités en gardent une copie octet
+ * pour octet ; le CRC-16 de la copie, transmis dans l'en-tête, permet à
+ * l'afficheur de vérifier qu'il tient bien celle du cœur avant de s'en servir.
+ */
+typedef struct {
+    uint8_t *buffer;
+    size_t capacity;
+    size_t length;
+    uint16_t crc;
+    bool valid;
+} core_link_baseline_t;
+
+/* En-tête d'une charge STATE_FULL_COMPRESSED (voir core_link_protocol.h). */
+typedef struct {
+    uint8_t inner_type;    /* STATE_FULL ou STATE_FULL_COMPACT */
+    uint8_t codec;         /* compression_codec_t */
+    uint16_t baseline_crc; /* CRC-16 de la référence */
+    uint16_t length;       /* taille de la charge reconstruite */
+    uint16_t crc;          /* CRC-16 de la charge reconstruite */
+} core_link_full_compressed_header_t;
+
+void core_link_baseline_init(core_link_baseline_t *baseline, uint8_t *buffer, size_t capacity);
+void core_link_baseline_reset(core_link_baseline_t *baseline);
+
+/** Copie `payload` comme nouvelle référence ; false (et référence invalidée) si elle ne tient pas. */
+bool core_link_baseline_store(core_link_baseline_t *baseline, const uint8_t *payload, size_t length);
+
+/**
+ * \brief XOR en place de `data` avec la référence, complétée par des zéros.
+ *
+ * L'opération est sa propre inverse : appliquée à une charge, elle donne la
+ * différence à compresser ; appliquée à la différence, elle rend la charge.
+ */
+void core_link_baseline_xor(const core_link_baseline_t *baseline, uint8_t *data, size_t length);
+
+void core_link_full_compressed_header_write(uint8_t *out, const core_link_full_compressed_header_t *header);
+
+/** false si la charge est plus courte que l'en-tête ou si `inner_type` n'est pas un STATE_FULL. */
+bool core_link_full_compressed_header_read(const uint8_t *payload, size_t length,
+                                           core_link_full_compressed_header_t *out);
+
+#ifdef __cplusplus
+}
+#endif
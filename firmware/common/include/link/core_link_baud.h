@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Négociation du débit UART (capacité CORE_LINK_CAP_EXT_BAUD_SWITCH). Les
+ * deux extrémités démarrent au débit sûr configuré et s'annoncent dans
+ * HELLO / HELLO_ACK un masque des débits qu'elles acceptent (bit i =
+ * core_link_baud_rate(i)). Le cœur, maître de la négociation, découpe le
+ * temps en fenêtres et compte dans chacune les erreurs du lien (en-têtes
+ * corrompus, NAK reçus, PONG manquants) :
+ *
+ * - CORE_LINK_BAUD_CLEAN_WINDOWS fenêtres consécutives sous le seuil :
+ *   montée au débit commun suivant ;
+ * - une fenêtre au seuil ou au-delà : descente au débit commun précédent,
+ *   et plafond sous le débit abandonné pendant
+ *   CORE_LINK_BAUD_PENALTY_WINDOWS fenêtres (idem après un essai raté).
+ *
+ * Le module ne fait que décider ; le basculement (BAUD_SWITCH) et l'essai
+ * au nouveau débit sont à la charge de l'appelant. Une instance n'est
+ * manipulée que par une seule tâche.
+ */
+
+#define CORE_LINK_BAUD_RATE_COUNT 11
+#define CORE_LINK_BAUD_INDEX_NONE 0xFF
+#define CORE_LINK_BAUD_CLEAN_WINDOWS 3
+#define CORE_LINK_BAUD_PENALTY_WINDOWS 12
+
+typedef enum {
+    CORE_LINK_BAUD_HOLD = 0,
+    CORE_LINK_BAUD_STEP_UP,
+    CORE_LINK_BAUD_STEP_DOWN,
+} core_link_baud_action_t;
+
+typedef struct {
+    uint16_t local_mask;  /* débits acceptés localement */
+    uint16_t common_mask; /* intersection avec le pair, 0 tant qu'il n'a rien annoncé */
+    uint8_t start_index;  /* débit sûr, point de départ et de repli */
+    uint8_t current_index;
+    uint8_t ceiling_index; /* plus haut débit autorisé pour l'instant */
+    uint8_t clean_windows;
+    uint16_t penalty_windows;
+    uint32_t error_threshold;
+} core_link_baud_policy_t;
+
+/** Débit (bit/s) de l'entrée `index` de la table, 0 hors table. */
+uint32_t core_link_baud_rate(uint8_t index);
+
+/** Entrée de la table égale à `bits_per_second`, CORE_LINK_BAUD_INDEX_NONE sinon. */
+uint8_t core_link_baud_index(uint32_t bits_per_second);
+
+/** Masque des débits de la table compris entre `min_bps` et `max_bps`. */
+uint16_t core_link_baud_mask(uint32_t min_bps, uint32_t max_bps);
+
+/**
+ * \brief Prépare une politique au débit sûr `start_bps`, plafonnée à `max_bps`.
+ * @return false si `start_bps` n'appartient pas à la table.
+ */
+bool core_link_baud_policy_init(core_link_baud_policy_t *policy, uint32_t start_bps, uint32_t max_bps,
+                                uint32_t error_threshold);
+
+/** Nouveau handshake : retient les débits communs (0 : pas de négociation) et revient au débit sûr. */
+void core_link_baud_policy_set_peer(core_link_baud_policy_t *policy, uint16_t peer_mask);
+
+/** Perte du lien : retour au débit sûr ; le débit perdu est écarté un temps. */
+void core_link_baud_policy_fall_back(core_link_baud_policy_t *policy);
+
+/**
+ * \brief Clôt une fenêtre ayant compté `errors` erreurs.
+ * @param out_index Débit visé si l'action n'est pas CORE_LINK_BAUD_HOLD.
+ */
+core_link_baud_action_t core_link_baud_policy_evaluate(core_link_baud_policy_t *policy, uint32_t errors,
+                                                       uint8_t *out_index);
+
+/** Le basculement vers `index` a été confirmé par le pair. */
+void core_link_baud_policy_commit(core_link_baud_policy_t *policy, uint8_t index);
+
+/** L'essai de `index` a échoué : le débit courant reste en place et `index` est écarté un temps. */
+void core_link_baud_policy_failed(core_link_baud_policy_t *policy, uint8_t index);
+
+static inline uint32_t core_link_baud_policy_rate(const core_link_baud_policy_t *policy)
+{
+    return core_link_baud_rate(policy->current_index);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Synchronisation d'horloge façon NTP entre les deux cartes. L'afficheur
+ * horodate chaque PING avec son horloge (t1) ; le cœur répond par un PONG
+ * portant en plus sa propre horloge (t2) ; à la réception (t4) :
+ *
+ *   aller-retour = t4 - t1        décalage = t2 - (t1 + t4) / 2
+ *
+ * L'erreur sur un décalage est bornée par la moitié de son aller-retour.
+ * Les CORE_LINK_CLOCK_SAMPLES derniers échantillons sont conservés ; ceux
+ * dont l'aller-retour dépasse de plus de CORE_LINK_CLOCK_RTT_SLACK_US le
+ * minimum de la fenêtre (file d'émission chargée, rafale UART) sont écartés.
+ * Une régression linéaire sur les autres donne le décalage et sa dérive
+ * (écart de fréquence des quartz) dès que la fenêtre couvre
+ * CORE_LINK_CLOCK_DRIFT_SPAN_US ; avant cela, l'échantillon d'aller-retour
+ * minimal fait foi et la dérive est tenue pour nulle.
+ *
+ * Toutes les horloges sont en µs, sur 64 bits (esp_timer_get_time()).
+ * Une instance n'est manipulée que par une seule tâche.
+ */
+
+#define CORE_LINK_CLOCK_SAMPLES 16
+#define CORE_LINK_CLOCK_RTT_SLACK_US 2000U
+#define CORE_LINK_CLOCK_DRIFT_SPAN_US 10000000LL
+/* Au-delà, l'estimation est rejetée : deux quartz ne divergent pas de 0,1 %. */
+#define CORE_LINK_CLOCK_DRIFT_MAX_PPB 1000000
+
+typedef struct {
+    int64_t local_us;  /* milieu de l'aller-retour, horloge locale */
+    int64_t offset_us; /* horloge du pair - horloge locale */
+    uint32_t rtt_us;
+} core_link_clock_sample_t;
+
+typedef struct {
+    core_link_clock_sample_t samples[CORE_LINK_CLOCK_SAMPLES];
+    size_t count;
+    size_t next;
+    /* Estimation courante : décalage `ref_offset_us` à `ref_local_us`, dérive `drift_ppb`. */
+    bool synced;
+    int64_t ref_local_us;
+    int64_t ref_offset_us;
+    int32_t drift_ppb;
+    uint32_t min_rtt_us;
+    size_t used;
+} core_link_clock_t;
+
+typedef struct {
+    bool synced;
+    int64_t offset_us;   /* horloge du pair - horloge locale, à l'instant demandé */
+    int32_t drift_ppb;   /* > 0 : l'horloge du pair avance plus vite */
+    uint32_t min_rtt_us; /* le double de l'incertitude sur `offset_us` */
+    size_t samples;      /* échantillons retenus par le filtre */
+} core_link_clock_estimate_t;
+
+void core_link_clock_reset(core_link_clock_t *clock);
+
+/**
+ * \brief Ajoute un échange PING→PONG et recalcule l'estimation.
+ * @return false si l'échange est incohérent (t4 antérieur à t1).
+ */
+bool core_link_clock_add_sample(core_link_clock_t *clock, int64_t t1_local_us, int64_t t2_remote_us,
+                                int64_t t4_local_us);
+
+/** Décalage estimé (pair - local) à l'instant local `local_us` ; 0 hors synchronisation. */
+int64_t core_link_clock_offset_at(const core_link_clock_t *clock, int64_t local_us);
+
+/**
+ * \brief Convertit une date du pair dans l'horloge locale.
+ * @return false tant qu'aucun échange n'a abouti.
+ */
+bool core_link_clock_to_local(const core_link_clock_t *clock, int64_t remote_us, int64_t *out_local_us);
+
+void core_link_clock_get(const core_link_clock_t *clock, int64_t now_local_us, core_link_clock_estimate_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Encodage compact des instantanés Core Link (capacité
+ * `CORE_LINK_CAP_COMPACT_STATE`). Les champs sélectionnés par un masque
+ * `CORE_LINK_DELTA_FIELD_*` sont sérialisés dans l'ordre croissant des bits,
+ * quantifiés selon la table d'échelle de core_link_protocol.h.
+ *
+ * STATE_FULL_COMPACT et STATE_DELTA_COMPACT partagent la même disposition
+ * d'entrées (identifiant + masque + champs) ; une trame complète porte tous
+ * les champs numériques et n'inclut les noms que lorsque le cœur les sait
+ * inconnus de l'afficheur. Avec CORE_LINK_CAP_NAME_TABLE, les noms sont
+ * remplacés par CORE_LINK_DELTA_FIELD_NAME_IDS (voir core_link_name_table.h).
+ */
+
+/** Taille sérialisée des champs de `mask` pour `snap`. */
+size_t core_link_compact_fields_size(core_link_delta_field_mask_t mask, const core_link_terrarium_snapshot_t *snap);
+
+/**
+ * \brief Sérialise les champs de `mask`.
+ * @return Nombre d'octets écrits, 0 si `capacity` est insuffisant.
+ */
+size_t core_link_compact_encode_fields(uint8_t *out, size_t capacity, core_link_delta_field_mask_t mask,
+                                       const core_link_terrarium_snapshot_t *snap);
+
+/**
+ * \brief Applique à `snap` les champs de `mask` lus à partir de `*offset`.
+ *
+ * `*offset` avance au-delà des champs consommés.
+ * @return false si la charge utile est tronquée (`snap` peut être partiellement modifié).
+ */
+bool core_link_compact_decode_fields(const uint8_t *payload, size_t length, size_t *offset,
+                                     core_link_delta_field_mask_t mask, core_link_terrarium_snapshot_t *snap);
+
+/**
+ * \brief Masque des champs dont la valeur quantifiée diffère entre `snap` et `prev`.
+ *
+ * Une variation inférieure à la résolution de l'encodage ne produit pas de delta.
+ */
+core_link_delta_field_mask_t core_link_compact_diff_mask(const core_link_terrarium_snapshot_t *snap,
+                                                         const core_link_terrarium_snapshot_t *prev);
+
+#ifdef __cplusplus
+}
+#endif
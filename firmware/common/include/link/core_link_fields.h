@@ -0,0 +1,139 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Table unique des champs d'un instantané terrarium, partagée par le cœur et
+ * l'afficheur. Chaque ligne X(bit, membre, v1, compact, échelle) décrit :
+ *
+ * - bit     : suffixe de CORE_LINK_DELTA_FIELD_* (l'ordre des lignes est
+ *             l'ordre des bits, donc l'ordre de sérialisation) ;
+ * - membre  : champ de core_link_terrarium_snapshot_t ;
+ * - v1      : représentation STATE_FULL / STATE_DELTA (NAME : 33 octets fixes,
+ *             F32 / U32 : 4 octets, ordre natif) ;
+ * - compact : représentation STATE_*_COMPACT (NAME : longueur + octets,
+ *             I16 / U16 / U8 quantifiés, U32 petit-boutiste) ;
+ * - échelle : facteur de quantification compact (voir core_link_protocol.h).
+ *
+ * Les codecs v1 (core_link_fields.c) et compact (core_link_compact.c), la
+ * structure v1 sur le fil, les prédictions de taille et le calcul du masque
+ * de différences sont tous générés à partir de cette table : ajouter un champ
+ * revient à ajouter une ligne (et un bit). CORE_LINK_DELTA_FIELD_NAME_IDS,
+ * propre à l'encodage compact, n'y figure pas.
+ */
+#define CORE_LINK_SNAPSHOT_FIELDS(X)                                                  \
+    X(SCIENTIFIC_NAME, scientific_name, NAME, NAME, 0.0f)                             \
+    X(COMMON_NAME, common_name, NAME, NAME, 0.0f)                                     \
+    X(TEMP_DAY, temp_day_c, F32, I16, CORE_LINK_Q_TEMP_SCALE)                         \
+    X(TEMP_NIGHT, temp_night_c, F32, I16, CORE_LINK_Q_TEMP_SCALE)                     \
+    X(HUMIDITY_DAY, humidity_day_pct, F32, U16, CORE_LINK_Q_PCT_SCALE)                \
+    X(HUMIDITY_NIGHT, humidity_night_pct, F32, U16, CORE_LINK_Q_PCT_SCALE)            \
+    X(LUX_DAY, lux_day, F32, U16, CORE_LINK_Q_LUX_SCALE)                              \
+    X(LUX_NIGHT, lux_night, F32, U16, CORE_LINK_Q_LUX_SCALE)                          \
+    X(HYDRATION, hydration_pct, F32, U16, CORE_LINK_Q_PCT_SCALE)                      \
+    X(STRESS, stress_pct, F32, U16, CORE_LINK_Q_PCT_SCALE)                            \
+    X(HEALTH, health_pct, F32, U16, CORE_LINK_Q_PCT_SCALE)                            \
+    X(LAST_FEED, last_feeding_timestamp, U32, U32, 0.0f)                              \
+    X(ACTIVITY, activity_score, F32, U8, CORE_LINK_Q_ACTIVITY_SCALE)
+
+/* Tailles sur le fil par représentation (NAME compact : variable, hors table). */
+#define CORE_LINK_FIELD_V1_SIZE_NAME CORE_LINK_DELTA_STRING_BYTES
+#define CORE_LINK_FIELD_V1_SIZE_F32 4U
+#define CORE_LINK_FIELD_V1_SIZE_U32 4U
+#define CORE_LINK_FIELD_COMPACT_SIZE_NAME 0U
+#define CORE_LINK_FIELD_COMPACT_SIZE_I16 2U
+#define CORE_LINK_FIELD_COMPACT_SIZE_U16 2U
+#define CORE_LINK_FIELD_COMPACT_SIZE_U8 1U
+#define CORE_LINK_FIELD_COMPACT_SIZE_U32 4U
+
+#define CORE_LINK_FIELD_V1_MEMBER_NAME(member) char member[CORE_LINK_DELTA_STRING_BYTES];
+#define CORE_LINK_FIELD_V1_MEMBER_F32(member) float member;
+#define CORE_LINK_FIELD_V1_MEMBER_U32(member) uint32_t member;
+#define CORE_LINK_FIELD_V1_MEMBER(bit, member, v1, compact, scale) CORE_LINK_FIELD_V1_MEMBER_##v1(member)
+
+/* En-tête STATE_FULL / STATE_FULL_COMPACT. */
+typedef struct __attribute__((packed)) {
+    uint32_t epoch_seconds;
+    uint8_t terrarium_count;
+} core_link_state_header_wire_t;
+
+/* Entrée STATE_FULL v1 : identifiant puis tous les champs de la table. */
+typedef struct __attribute__((packed)) {
+    uint8_t terrarium_id;
+    CORE_LINK_SNAPSHOT_FIELDS(CORE_LINK_FIELD_V1_MEMBER)
+} core_link_snapshot_wire_t;
+
+/* En-tête STATE_DELTA / STATE_DELTA_COMPACT. */
+typedef struct __attribute__((packed)) {
+    uint32_t epoch_seconds;
+    uint8_t terrarium_count;
+    uint8_t changed_count;
+} core_link_state_delta_header_wire_t;
+
+/* Entrée STATE_DELTA*, STATE_FULL_COMPACT : suivie des champs de `field_mask`. */
+typedef struct __attribute__((packed)) {
+    uint8_t terrarium_id;
+    core_link_delta_field_mask_t field_mask;
+} core_link_state_delta_entry_wire_t;
+
+#define CORE_LINK_FIELD_V1_SIZE_OF(bit, member, v1, compact, scale) \
+    +((mask & CORE_LINK_DELTA_FIELD_##bit) ? CORE_LINK_FIELD_V1_SIZE_##v1 : 0U)
+#define CORE_LINK_FIELD_COMPACT_SIZE_OF(bit, member, v1, compact, scale) \
+    +((mask & CORE_LINK_DELTA_FIELD_##bit) ? CORE_LINK_FIELD_COMPACT_SIZE_##compact : 0U)
+
+/** Taille v1 des champs de `mask` (constante pour un masque constant). */
+static inline size_t core_link_fields_v1_size(core_link_delta_field_mask_t mask)
+{
+    return 0U CORE_LINK_SNAPSHOT_FIELDS(CORE_LINK_FIELD_V1_SIZE_OF);
+}
+
+/** Taille compacte des champs de `mask` hors noms en ligne (NAME_IDS compris). */
+static inline size_t core_link_fields_compact_fixed_size(core_link_delta_field_mask_t mask)
+{
+    return 0U CORE_LINK_SNAPSHOT_FIELDS(CORE_LINK_FIELD_COMPACT_SIZE_OF) +
+           ((mask & CORE_LINK_DELTA_FIELD_NAME_IDS) ? 2U : 0U);
+}
+
+/**
+ * \brief Sérialise en v1 les champs de `mask` (bits hors table ignorés).
+ * @return Nombre d'octets écrits, 0 si `capacity` est insuffisant.
+ */
+size_t core_link_fields_v1_encode(uint8_t *out, size_t capacity, core_link_delta_field_mask_t mask,
+                                  const core_link_terrarium_snapshot_t *snap);
+
+/**
+ * \brief Applique à `snap` les champs v1 de `mask` lus à partir de `*offset`.
+ *
+ * Une seule vérification de longueur couvre tous les champs ; les noms reçus
+ * sont terminés et `*offset` avance au-delà des champs consommés.
+ * @return false si la charge utile est tronquée (`snap` n'est alors pas modifié).
+ */
+bool core_link_fields_v1_decode(const uint8_t *payload, size_t length, size_t *offset,
+                                core_link_delta_field_mask_t mask, core_link_terrarium_snapshot_t *snap);
+
+/** Entrée STATE_FULL v1 complète (core_link_snapshot_wire_t) pour `snap`. */
+void core_link_fields_to_wire(core_link_snapshot_wire_t *wire, const core_link_terrarium_snapshot_t *snap);
+
+/** Instantané décrit par une entrée STATE_FULL v1 (identifiants de noms remis à NONE). */
+void core_link_fields_from_wire(core_link_terrarium_snapshot_t *snap, const core_link_snapshot_wire_t *wire);
+
+/**
+ * \brief Recopie dans `dst` les champs de `mask` pris dans `src`.
+ *
+ * Un nom recopié emporte son identifiant (name_ids) ; CORE_LINK_DELTA_FIELD_NAME_IDS
+ * seul n'est pas un champ de la table et reste ignoré.
+ */
+void core_link_fields_copy(core_link_terrarium_snapshot_t *dst, const core_link_terrarium_snapshot_t *src,
+                           core_link_delta_field_mask_t mask);
+
+#ifdef __cplusplus
+}
+#endif
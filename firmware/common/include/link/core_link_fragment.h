@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+#include "link/core_link_stream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Octets de charge d'origine transportés par un STATE_FRAGMENT. */
+#define CORE_LINK_FRAGMENT_DATA_MAX (CORE_LINK_MAX_PAYLOAD - CORE_LINK_FRAGMENT_HEADER_SIZE)
+
+/** Nombre de fragments nécessaires pour `length` octets (0 si > 255 fragments). */
+size_t core_link_fragment_count(size_t length);
+
+/**
+ * \brief Construit la charge du fragment `index` de `data`.
+ *
+ * @return Taille de la charge STATE_FRAGMENT écrite dans `out`, 0 si `index`
+ *         est hors plage ou si `out_size` est insuffisant.
+ */
+size_t core_link_fragment_build(uint8_t *out, size_t out_size, uint8_t inner_type, uint8_t transfer_id,
+                                const uint8_t *data, size_t length, uint8_t index);
+
+typedef enum {
+    CORE_LINK_REASSEMBLY_PENDING = 0,
+    CORE_LINK_REASSEMBLY_COMPLETE,
+    CORE_LINK_REASSEMBLY_ERROR,
+} core_link_reassembly_status_t;
+
+/*
+ * Réassemblage côté afficheur. Les fragments doivent arriver dans l'ordre (la
+ * couche de séquencement v2 réordonne et fait rejouer les pertes) ; un trou,
+ * un changement de `transfer_id` en cours de route ou un dépassement de
+ * `capacity` abandonne le transfert avec CORE_LINK_REASSEMBLY_ERROR. Un
+ * fragment d'index 0 redémarre toujours un transfert.
+ */
+typedef struct {
+    uint8_t *buffer;
+    size_t capacity;
+    size_t length;
+    uint8_t inner_type;
+    uint8_t transfer_id;
+    uint8_t next_index;
+    uint8_t count;
+    bool active;
+} core_link_reassembly_t;
+
+void core_link_reassembly_init(core_link_reassembly_t *reassembly, uint8_t *buffer, size_t capacity);
+void core_link_reassembly_reset(core_link_reassembly_t *reassembly);
+
+/**
+ * \brief Ajoute une charge STATE_FRAGMENT.
+ *
+ * Sur CORE_LINK_REASSEMBLY_COMPLETE, `buffer`/`length`/`inner_type` décrivent la
+ * charge reconstituée jusqu'au prochain appel.
+ */
+core_link_reassembly_status_t core_link_reassembly_push(core_link_reassembly_t *reassembly, const uint8_t *payload,
+                                                        size_t length);
+
+#ifdef __cplusplus
+}
+#endif
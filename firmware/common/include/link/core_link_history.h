@@ -0,0 +1,113 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Historique sous-échantillonné des métriques d'un terrarium (messages
+ * HISTORY_REQUEST / HISTORY_CHUNK). Le cœur tient par terrarium trois anneaux
+ * de seaux min/max/moyenne ; l'afficheur en demande une fenêtre, un morceau
+ * à la fois. Les valeurs voyagent quantifiées comme l'encodage compact et se
+ * relisent avec core_link_history_value().
+ */
+
+typedef enum {
+    CORE_LINK_HISTORY_TIER_MINUTE = 0,  /* seaux de 60 s */
+    CORE_LINK_HISTORY_TIER_QUARTER = 1, /* seaux de 15 min */
+    CORE_LINK_HISTORY_TIER_SIX_HOURS = 2,
+    CORE_LINK_HISTORY_TIER_COUNT,
+} core_link_history_tier_t;
+
+typedef enum {
+    CORE_LINK_HISTORY_OK = 0,
+    CORE_LINK_HISTORY_UNKNOWN_TERRARIUM = 1, /* identifiant absent ou non publié */
+    CORE_LINK_HISTORY_UNAVAILABLE = 2,       /* historique désactivé ou palier inconnu */
+} core_link_history_status_t;
+
+/* Métriques historisées : tous les champs numériques sauf l'horodatage de repas. */
+#define CORE_LINK_HISTORY_FIELDS \
+    (CORE_LINK_DELTA_FIELD_ALL & ~(CORE_LINK_DELTA_FIELD_NAMES | CORE_LINK_DELTA_FIELD_LAST_FEED))
+#define CORE_LINK_HISTORY_METRIC_COUNT 10U
+
+#define CORE_LINK_HISTORY_FLAG_MORE 0x01U /* des seaux plus anciens restent à lire */
+
+/* Seau décodé, indexé par métrique (rang du champ parmi CORE_LINK_HISTORY_FIELDS). */
+typedef struct {
+    uint16_t samples; /* 0 : aucune mesure, valeurs à ignorer */
+    uint16_t min[CORE_LINK_HISTORY_METRIC_COUNT];
+    uint16_t max[CORE_LINK_HISTORY_METRIC_COUNT];
+    uint16_t mean[CORE_LINK_HISTORY_METRIC_COUNT];
+} core_link_history_bucket_t;
+
+typedef struct {
+    uint8_t terrarium_id;
+    uint8_t tier;
+    core_link_delta_field_mask_t field_mask;
+    uint32_t before_epoch; /* seaux finissant au plus tard à cet instant ; 0 : les plus récents */
+    uint8_t max_buckets;
+} core_link_history_request_t;
+
+/* En-tête d'un HISTORY_CHUNK ; `data` pointe dans la charge reçue. */
+typedef struct {
+    uint8_t terrarium_id;
+    uint8_t tier;
+    uint8_t status;
+    core_link_delta_field_mask_t field_mask;
+    uint32_t end_epoch; /* fin du seau 0 ; le seau k couvre [fin - (k+1)·durée, fin - k·durée) */
+    uint8_t count;
+    uint8_t flags;
+    const uint8_t *data;
+} core_link_history_chunk_t;
+
+/** Durée d'un seau du palier `tier`, en secondes (0 si inconnu). */
+uint32_t core_link_history_tier_seconds(uint8_t tier);
+
+/** Champ CORE_LINK_DELTA_FIELD_* de la métrique `metric`. */
+core_link_delta_field_mask_t core_link_history_metric_field(size_t metric);
+
+/** Quantifie `value` pour la métrique `metric` (table d'échelle de core_link_protocol.h). */
+uint16_t core_link_history_quantize(size_t metric, float value);
+
+/** Valeur réelle d'une quantité transmise pour la métrique `metric`. */
+float core_link_history_value(size_t metric, uint16_t raw);
+
+/** Taille sérialisée d'un seau portant les champs `field_mask`. */
+size_t core_link_history_bucket_size(core_link_delta_field_mask_t field_mask);
+
+size_t core_link_history_request_encode(const core_link_history_request_t *request, uint8_t *out, size_t capacity);
+
+/** Décode une charge HISTORY_REQUEST ; les champs hors historique sont écartés du masque. */
+bool core_link_history_request_decode(const uint8_t *payload, size_t length, core_link_history_request_t *request);
+
+/**
+ * \brief Sérialise l'en-tête d'un HISTORY_CHUNK (CORE_LINK_HISTORY_CHUNK_HEADER_SIZE octets).
+ *
+ * Les seaux se placent à la suite avec core_link_history_bucket_encode() ;
+ * l'en-tête peut être écrit en dernier, une fois `count` connu.
+ */
+size_t core_link_history_chunk_encode_header(const core_link_history_chunk_t *chunk, uint8_t *out, size_t capacity);
+
+/**
+ * \brief Sérialise les champs `field_mask` de `bucket`.
+ * @return Octets écrits, 0 si `capacity` ne suffit pas.
+ */
+size_t core_link_history_bucket_encode(core_link_delta_field_mask_t field_mask, const core_link_history_bucket_t *bucket,
+                                       uint8_t *out, size_t capacity);
+
+/** Décode l'en-tête d'un HISTORY_CHUNK et vérifie que ses `count` seaux sont présents. */
+bool core_link_history_chunk_decode(const uint8_t *payload, size_t length, core_link_history_chunk_t *chunk);
+
+/** Seau `index` (< chunk->count) d'un HISTORY_CHUNK décodé ; les champs absents valent 0. */
+void core_link_history_chunk_bucket(const core_link_history_chunk_t *chunk, size_t index,
+                                    core_link_history_bucket_t *bucket);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Table de noms internés (capacité CORE_LINK_CAP_NAME_TABLE). Le cœur attribue
+ * à chaque nom distinct un identifiant stable jusqu'au prochain
+ * CORE_LINK_CMD_RELOAD_PROFILES ; l'afficheur reconstruit la même table à
+ * partir des messages NAME_TABLE et résout les identifiants portés par les
+ * instantanés (CORE_LINK_DELTA_FIELD_NAME_IDS).
+ */
+typedef struct {
+    uint8_t generation;
+    uint8_t count;
+    bool present[CORE_LINK_NAME_TABLE_MAX];
+    uint32_t hashes[CORE_LINK_NAME_TABLE_MAX];
+    char names[CORE_LINK_NAME_TABLE_MAX][CORE_LINK_NAME_MAX_LEN + 1];
+} core_link_name_table_t;
+
+void core_link_name_table_reset(core_link_name_table_t *table, uint8_t generation);
+
+/**
+ * \brief Renvoie l'identifiant de `name`, en l'ajoutant si nécessaire.
+ * @return CORE_LINK_NAME_ID_NONE si la table est pleine.
+ */
+uint8_t core_link_name_table_intern(core_link_name_table_t *table, const char *name);
+
+/** Nom associé à `id`, NULL s'il est inconnu. */
+const char *core_link_name_table_lookup(const core_link_name_table_t *table, uint8_t id);
+
+/**
+ * \brief Sérialise une charge NAME_TABLE à partir de l'entrée `*next_id`.
+ *
+ * Ajoute autant d'entrées que `capacity` le permet et avance `*next_id`.
+ * `reset` demande à l'afficheur de vider sa table avant de l'appliquer.
+ * @return Nombre d'octets écrits (0 si `capacity` ne contient pas l'en-tête).
+ */
+size_t core_link_name_table_encode(const core_link_name_table_t *table, uint8_t *next_id, bool reset, uint8_t *out,
+                                   size_t capacity);
+
+/**
+ * \brief Applique une charge NAME_TABLE reçue.
+ *
+ * Une charge sans CORE_LINK_NAME_TABLE_FLAG_RESET doit porter la génération
+ * courante. `*out_reset` indique si la table a été vidée.
+ * @return false si la charge est malformée ou d'une autre génération.
+ */
+bool core_link_name_table_apply(core_link_name_table_t *table, const uint8_t *payload, size_t length, bool *out_reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Table des commandes en vol côté afficheur. Chaque COMMAND émise y reçoit
+ * un identifiant (jamais CORE_LINK_REQUEST_ID_NONE), une échéance et un
+ * rappel de fin ; l'acquittement, l'échéance ou la perte du lien retirent
+ * l'entrée, que l'appelant complète ensuite hors de tout verrou. Les temps
+ * sont des ticks 32 bits comparés modulo 2^32.
+ *
+ * La table n'est pas protégée : l'appelant la sérialise.
+ */
+
+#define CORE_LINK_PENDING_MAX 8
+
+/** Fin d'une commande ; `status` est un esp_err_t (ESP_ERR_TIMEOUT à l'échéance). */
+typedef void (*core_link_pending_cb_t)(core_link_command_opcode_t opcode, int status, uint8_t terrarium_count,
+                                       void *ctx);
+
+typedef struct {
+    bool used;
+    uint8_t opcode;
+    uint16_t request_id;
+    uint32_t serial; /* ordre d'émission, pour les acquittements sans identifiant */
+    uint32_t deadline;
+    core_link_pending_cb_t cb;
+    void *ctx;
+} core_link_pending_entry_t;
+
+typedef struct {
+    core_link_pending_entry_t entries[CORE_LINK_PENDING_MAX];
+    uint16_t next_id;
+    uint32_t next_serial;
+} core_link_pending_t;
+
+void core_link_pending_init(core_link_pending_t *table);
+
+/**
+ * \brief Réserve une entrée expirant à `now + timeout`.
+ * @return Identifiant attribué, CORE_LINK_REQUEST_ID_NONE si la table est pleine.
+ */
+uint16_t core_link_pending_add(core_link_pending_t *table, uint8_t opcode, uint32_t now, uint32_t timeout,
+                               core_link_pending_cb_t cb, void *ctx);
+
+/** Retire l'entrée `request_id` ; false si elle n'est plus en vol. */
+bool core_link_pending_take(core_link_pending_t *table, uint16_t request_id, core_link_pending_entry_t *out_entry);
+
+/** Retire la plus ancienne entrée d'opcode `opcode` (pair sans identifiants). */
+bool core_link_pending_take_opcode(core_link_pending_t *table, uint8_t opcode, core_link_pending_entry_t *out_entry);
+
+/** Retire une entrée dont l'échéance est atteinte à `now` ; à rappeler jusqu'à false. */
+bool core_link_pending_take_expired(core_link_pending_t *table, uint32_t now, core_link_pending_entry_t *out_entry);
+
+/** Retire une entrée quelconque (perte du lien) ; à rappeler jusqu'à false. */
+bool core_link_pending_take_any(core_link_pending_t *table, core_link_pending_entry_t *out_entry);
+
+size_t core_link_pending_count(const core_link_pending_t *table);
+
+#ifdef __cplusplus
+}
+#endif
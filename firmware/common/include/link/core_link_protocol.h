@@ -1,34 +1,73 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define CORE_LINK_PROTOCOL_VERSION 1
-#define CORE_LINK_MAX_TERRARIUMS 4
+#define CORE_LINK_MAX_TERRARIUMS 64
+/* Plafond des pairs sans CORE_LINK_CAP_FRAGMENTS (trame d'état ≤ 512 octets). */
+#define CORE_LINK_LEGACY_MAX_TERRARIUMS 4
 #define CORE_LINK_NAME_MAX_LEN 31
 #define CORE_LINK_COMMAND_MAX_ARG_LEN 192
 
+/* Capacités annoncées dans HELLO (octet 1) et HELLO_ACK (octet 1). */
+#define CORE_LINK_CAP_DISPLAY 0x01
+#define CORE_LINK_CAP_HOST 0x02
+#define CORE_LINK_CAP_FRAME_V2 0x04 /* trames séquencées + CRC-16, NAK/retransmission */
+#define CORE_LINK_CAP_COMPACT_STATE 0x08 /* STATE_*_COMPACT (valeurs quantifiées) */
+#define CORE_LINK_CAP_FRAGMENTS 0x10 /* STATE_FRAGMENT, au-delà de CORE_LINK_LEGACY_MAX_TERRARIUMS */
+#define CORE_LINK_CAP_NAME_TABLE 0x20 /* NAME_TABLE + CORE_LINK_DELTA_FIELD_NAME_IDS (requiert COMPACT_STATE) */
+#define CORE_LINK_CAP_LINK_STATS 0x40 /* LINK_STATS : télémétrie du cœur (voir core_link_stats.h) */
+#define CORE_LINK_CAP_TOUCH_BATCH 0x80 /* TOUCH_EVENT en lot (voir ci-dessous) */
+
+/* Capacités étendues : octet 2 de HELLO / HELLO_ACK, absent chez les pairs
+ * plus anciens (qui ne lisent que les deux premiers octets). */
+#define CORE_LINK_CAP_EXT_SAMPLE_TIME 0x01 /* horodatage µs des instantanés (voir ci-dessous) */
+#define CORE_LINK_CAP_EXT_FULL_COMPRESSED 0x02 /* STATE_FULL_COMPRESSED (voir ci-dessous) */
+#define CORE_LINK_CAP_EXT_BAUD_SWITCH 0x04 /* débit UART négocié (voir ci-dessous) */
+#define CORE_LINK_CAP_EXT_REQUEST_ID 0x08 /* COMMAND / COMMAND_ACK identifiés (voir ci-dessous) */
+#define CORE_LINK_CAP_EXT_SUBSCRIBE 0x10 /* abonnement de l'afficheur (voir ci-dessous) */
+#define CORE_LINK_CAP_EXT_HISTORY 0x20 /* HISTORY_REQUEST / HISTORY_CHUNK (voir ci-dessous) */
+
+/* Nombre maximal de séquences manquantes listées dans un NAK. */
+#define CORE_LINK_NAK_MAX_SEQS 8
+
 typedef enum {
     CORE_LINK_MSG_HELLO = 0x01,
     CORE_LINK_MSG_HELLO_ACK = 0x02,
     CORE_LINK_MSG_REQUEST_STATE = 0x03,
     CORE_LINK_MSG_STATE_FULL = 0x10,
     CORE_LINK_MSG_STATE_DELTA = 0x11,
+    CORE_LINK_MSG_NAK = 0x12,
+    CORE_LINK_MSG_STATE_FULL_COMPACT = 0x13,
+    CORE_LINK_MSG_STATE_DELTA_COMPACT = 0x14,
+    CORE_LINK_MSG_STATE_FRAGMENT = 0x15,
+    CORE_LINK_MSG_NAME_TABLE = 0x16,
+    CORE_LINK_MSG_STATE_FULL_COMPRESSED = 0x17,
     CORE_LINK_MSG_COMMAND = 0x30,
     CORE_LINK_MSG_COMMAND_ACK = 0x31,
     CORE_LINK_MSG_PING = 0x1F,
     CORE_LINK_MSG_PONG = 0x20,
+    CORE_LINK_MSG_LINK_STATS = 0x21,
+    CORE_LINK_MSG_BAUD_SWITCH = 0x22,
+    CORE_LINK_MSG_HISTORY_CHUNK = 0x23,
     CORE_LINK_MSG_TOUCH_EVENT = 0x80,
     CORE_LINK_MSG_DISPLAY_READY = 0x81,
+    CORE_LINK_MSG_BAUD_SWITCH_ACK = 0x82,
+    CORE_LINK_MSG_SUBSCRIBE = 0x83,
+    CORE_LINK_MSG_HISTORY_REQUEST = 0x84,
     CORE_LINK_MSG_ERROR = 0xFE,
 } core_link_msg_type_t;
 
 typedef enum {
     CORE_LINK_CMD_RELOAD_PROFILES = 0x01,
+    CORE_LINK_CMD_FEED_TERRARIUM = 0x02, /* argument : identifiant décimal du terrarium */
 } core_link_command_opcode_t;
 
 typedef enum {
@@ -41,6 +80,9 @@ typedef struct {
     uint8_t terrarium_id;
     char scientific_name[CORE_LINK_NAME_MAX_LEN + 1];
     char common_name[CORE_LINK_NAME_MAX_LEN + 1];
+    /* Identifiants NAME_TABLE des deux noms ([0] scientifique, [1] commun),
+     * CORE_LINK_NAME_ID_NONE hors négociation CORE_LINK_CAP_NAME_TABLE. */
+    uint8_t name_ids[2];
     float temp_day_c;
     float temp_night_c;
     float humidity_day_pct;
@@ -54,12 +96,28 @@ typedef struct {
     float activity_score;
 } core_link_terrarium_snapshot_t;
 
+/*
+ * Instantané d'état de taille variable : `terrarium_capacity` entrées suivent
+ * l'en-tête. Allouer avec CORE_LINK_STATE_FRAME_SIZE() puis initialiser avec
+ * core_link_state_frame_init() ; ne jamais copier la structure par valeur.
+ */
 typedef struct {
     uint32_t epoch_seconds;
+    /* Instant (µs, esp_timer) du pas de simulation dont les valeurs sont issues,
+     * dans l'horloge de la carte qui détient la trame : l'afficheur le convertit
+     * à la réception. 0 = inconnu. */
+    int64_t sample_us;
     uint8_t terrarium_count;
-    core_link_terrarium_snapshot_t terrariums[CORE_LINK_MAX_TERRARIUMS];
+    uint8_t terrarium_capacity;
+    /* Génération locale de la table de noms : tant qu'elle ne change pas, un
+     * même `name_ids` désigne le même nom (0 = identifiants non utilisés). */
+    uint16_t name_generation;
+    core_link_terrarium_snapshot_t terrariums[];
 } core_link_state_frame_t;
 
+#define CORE_LINK_STATE_FRAME_SIZE(capacity) \
+    (sizeof(core_link_state_frame_t) + (size_t)(capacity) * sizeof(core_link_terrarium_snapshot_t))
+
 typedef uint16_t core_link_delta_field_mask_t;
 
 enum {
@@ -76,10 +134,76 @@ enum {
     CORE_LINK_DELTA_FIELD_HEALTH = 0x0400,
     CORE_LINK_DELTA_FIELD_LAST_FEED = 0x0800,
     CORE_LINK_DELTA_FIELD_ACTIVITY = 0x1000,
+    /* Remplace SCIENTIFIC_NAME/COMMON_NAME par deux identifiants NAME_TABLE (u8). */
+    CORE_LINK_DELTA_FIELD_NAME_IDS = 0x2000,
 };
 
+#define CORE_LINK_DELTA_FIELD_NAMES (CORE_LINK_DELTA_FIELD_SCIENTIFIC_NAME | CORE_LINK_DELTA_FIELD_COMMON_NAME)
+#define CORE_LINK_DELTA_FIELD_ALL 0x1FFF
+
+/*
+ * Table d'échelle de l'encodage compact (STATE_FULL_COMPACT / STATE_DELTA_COMPACT).
+ * Valeur transmise = arrondi(valeur × échelle), saturée au type indiqué ;
+ * le décodeur divise par la même échelle. Les noms sont transmis sous la forme
+ * longueur (u8) + octets, sans terminateur ; l'horodatage de repas reste un u32.
+ *
+ *   champ                       type    échelle   résolution   plage
+ *   temp_day_c / temp_night_c   int16   100       0,01 °C      ±327 °C
+ *   humidity_*_pct              uint16  10        0,1 %        0..6553 %
+ *   lux_day / lux_night         uint16  1         1 lx         0..65535 lx
+ *   hydration/stress/health     uint16  10        0,1 %        0..6553 %
+ *   activity_score              uint8   250       0,004        0..1,02
+ */
+#define CORE_LINK_Q_TEMP_SCALE 100.0f
+#define CORE_LINK_Q_PCT_SCALE 10.0f
+#define CORE_LINK_Q_LUX_SCALE 1.0f
+#define CORE_LINK_Q_ACTIVITY_SCALE 250.0f
+
 #define CORE_LINK_DELTA_STRING_BYTES (CORE_LINK_NAME_MAX_LEN + 1)
 
+/*
+ * Taille maximale d'une charge STATE_* avant fragmentation : le pire cas est un
+ * STATE_DELTA v1 où chaque terrarium change tous ses champs
+ * (en-tête 6 octets, entrée 3 octets + 2 noms + 11 valeurs de 4 octets).
+ */
+#define CORE_LINK_STATE_MAX_PAYLOAD \
+    (6U + CORE_LINK_MAX_TERRARIUMS * (3U + 2U * CORE_LINK_DELTA_STRING_BYTES + 11U * 4U))
+
+/*
+ * STATE_FRAGMENT (capacité CORE_LINK_CAP_FRAGMENTS) : une charge STATE_*
+ * dépassant CORE_LINK_MAX_PAYLOAD est découpée en `count` fragments émis dans
+ * l'ordre, chacun séquencé (v2) et donc rejouable par NAK. Charge utile :
+ * cet en-tête puis jusqu'à CORE_LINK_FRAGMENT_DATA_MAX octets de la charge
+ * d'origine. `transfer_id` change à chaque transfert pour qu'un fragment
+ * isolé d'un transfert abandonné ne soit jamais recollé au suivant.
+ */
+typedef struct {
+    uint8_t inner_type;
+    uint8_t transfer_id;
+    uint8_t index;
+    uint8_t count;
+} core_link_fragment_header_t;
+
+#define CORE_LINK_FRAGMENT_HEADER_SIZE 4U
+
+/*
+ * NAME_TABLE (capacité CORE_LINK_CAP_NAME_TABLE) : le cœur interne chaque nom
+ * distinct et ne l'envoie qu'une fois ; les instantanés portent ensuite
+ * CORE_LINK_DELTA_FIELD_NAME_IDS. Les identifiants restent valides jusqu'au
+ * prochain CORE_LINK_CMD_RELOAD_PROFILES, qui ouvre une nouvelle génération.
+ * Charge utile : generation (u8), flags (u8), count (u8) puis `count` entrées
+ * {id u8, longueur u8, octets}. Séquencée comme un STATE_DELTA et appliquée
+ * de manière idempotente ; une table trop grande part en plusieurs messages,
+ * seul le premier portant CORE_LINK_NAME_TABLE_FLAG_RESET.
+ */
+#define CORE_LINK_NAME_TABLE_MAX (2U * CORE_LINK_MAX_TERRARIUMS)
+#define CORE_LINK_NAME_ID_NONE 0xFF
+#define CORE_LINK_NAME_TABLE_FLAG_RESET 0x01
+
+/* REQUEST_STATE, octet 0 (optionnel) : l'afficheur a perdu sa table de noms.
+ * Une requête sans charge utile (afficheur ancien) vaut ce drapeau. */
+#define CORE_LINK_REQUEST_STATE_NAMES 0x01
+
 typedef struct {
     core_link_touch_type_t type;
     uint8_t point_id;
@@ -87,6 +211,13 @@ typedef struct {
     uint16_t y;
 } core_link_touch_event_t;
 
+/*
+ * TOUCH_EVENT en lot (capacité CORE_LINK_CAP_TOUCH_BATCH annoncée par les
+ * deux extrémités) : count (u8) puis `count` entrées {point_id u8, type u8,
+ * x LE16, y LE16}, à appliquer dans l'ordre. Sans la capacité, chaque
+ * événement part seul sous la forme d'un core_link_touch_event_t brut.
+ */
+
 typedef struct {
     uint8_t opcode;
     char argument[CORE_LINK_COMMAND_MAX_ARG_LEN];
@@ -98,6 +229,158 @@ typedef struct {
     uint8_t terrarium_count;
 } core_link_command_ack_payload_t;
 
+/*
+ * Commandes identifiées (capacité CORE_LINK_CAP_EXT_REQUEST_ID annoncée par
+ * les deux extrémités) : COMMAND porte opcode (u8), request_id (LE16) puis
+ * l'argument ; COMMAND_ACK ajoute request_id (LE16) après
+ * core_link_command_ack_payload_t. L'afficheur garde plusieurs commandes en
+ * vol (voir core_link_pending.h) et le cœur les acquitte dans l'ordre
+ * d'arrivée. Sans la capacité, un acquittement revient à la plus ancienne
+ * commande en attente de même opcode.
+ */
+#define CORE_LINK_REQUEST_ID_NONE 0U
+#define CORE_LINK_REQUEST_ID_SIZE 2U
+
+/*
+ * NAK (trames v2 uniquement) : l'afficheur liste les séquences STATE_FULL /
+ * STATE_DELTA manquantes ; le cœur ne retransmet que ces trames, ou un
+ * STATE_FULL si elles ne sont plus dans son historique.
+ * Charge utile : count (u8) puis `count` séquences LE16.
+ */
+typedef struct {
+    uint8_t count;
+    uint16_t seqs[CORE_LINK_NAK_MAX_SEQS];
+} core_link_nak_payload_t;
+
+/*
+ * PING : charge facultative renvoyée telle quelle dans le PONG. Les deux
+ * extrémités y placent leur horloge (LE32, µs) pour mesurer l'aller-retour.
+ * Le cœur ajoute à l'écho d'un PING horodaté sa propre horloge au moment de
+ * répondre (LE64, µs) : l'afficheur en déduit décalage et dérive entre les
+ * deux cartes (voir core_link_clock.h). Un afficheur plus ancien ne lit que
+ * les quatre premiers octets.
+ */
+#define CORE_LINK_PING_TIMESTAMP_SIZE 4U
+#define CORE_LINK_PONG_CLOCK_SIZE 8U
+
+/*
+ * Avec CORE_LINK_CAP_EXT_SAMPLE_TIME annoncée par les deux extrémités, toute
+ * charge STATE_FULL / STATE_DELTA (compacte ou non, avant fragmentation) se
+ * termine par `sample_us` en LE64, horloge du cœur. Les décodeurs ignorant
+ * déjà les octets en excès, l'extension ne change aucune disposition.
+ */
+#define CORE_LINK_SAMPLE_TIME_SIZE 8U
+/* Tampon d'une charge STATE_* complète, horodatage compris. */
+#define CORE_LINK_STATE_BUFFER_SIZE (CORE_LINK_STATE_MAX_PAYLOAD + CORE_LINK_SAMPLE_TIME_SIZE)
+
+/*
+ * STATE_FULL_COMPRESSED (capacité CORE_LINK_CAP_EXT_FULL_COMPRESSED) : un
+ * rafraîchissement périodique STATE_FULL / STATE_FULL_COMPACT dont la charge,
+ * combinée par XOR à celle du précédent STATE_FULL, est compressée. Charge
+ * utile : inner_type (u8), codec (u8, compression_codec_t), CRC-16 de la
+ * référence (LE16), taille puis CRC-16 de la charge reconstruite (LE16 ×2),
+ * puis les données compressées. Séquencée et fragmentable comme un STATE_DELTA,
+ * elle ne rebase pas la séquence : sans la bonne référence, l'afficheur
+ * répond par REQUEST_STATE, auquel le cœur répond toujours par un STATE_FULL
+ * non compressé. Voir core_link_baseline.h.
+ */
+#define CORE_LINK_FULL_COMPRESSED_HEADER_SIZE 8U
+
+/*
+ * Débit négocié (capacité CORE_LINK_CAP_EXT_BAUD_SWITCH, voir
+ * core_link_baud.h). HELLO et HELLO_ACK portent alors, après l'octet de
+ * capacités étendues, le masque LE16 des débits acceptés. Pour changer de
+ * débit, le cœur émet BAUD_SWITCH (index de la table, u8 ; débit, LE32) puis
+ * bascule dès la trame partie ; l'afficheur bascule à sa réception et répond
+ * BAUD_SWITCH_ACK (même charge) au nouveau débit. Sans cet acquittement
+ * (cœur) ou sans trame valide (afficheur) dans les
+ * CORE_LINK_BAUD_SWITCH_TIMEOUT_MS, chacun revient au débit précédent. Une
+ * perte du lien ramène les deux extrémités au débit de démarrage.
+ */
+#define CORE_LINK_HELLO_BAUD_MASK_SIZE 2U
+#define CORE_LINK_BAUD_SWITCH_PAYLOAD_SIZE 5U
+#define CORE_LINK_BAUD_SWITCH_TIMEOUT_MS 1000U
+
+/*
+ * SUBSCRIBE (afficheur → cœur, capacité CORE_LINK_CAP_EXT_SUBSCRIBE annoncée
+ * par le cœur) : ce que la vue courante affiche. Charge utile : champs
+ * (core_link_delta_field_mask_t, LE16), intervalle minimal entre deux trames
+ * d'état (LE16, ms, 0 : chaque publication), nombre d'identifiants (u8,
+ * CORE_LINK_SUBSCRIBE_ALL : tous les terrariums) puis les identifiants.
+ * Les STATE_DELTA ne portent plus que les champs abonnés des terrariums
+ * abonnés ; les STATE_FULL restent complets et rattrapent le reste. Chaque
+ * poignée de main rétablit l'abonnement complet : l'afficheur renvoie le sien
+ * après HELLO_ACK. Voir core_link_subscription.h.
+ */
+#define CORE_LINK_SUBSCRIBE_ALL 0xFFU
+#define CORE_LINK_SUBSCRIBE_HEADER_SIZE 5U
+
+/*
+ * Historique d'un terrarium (capacité CORE_LINK_CAP_EXT_HISTORY annoncée par
+ * le cœur), par seaux d'une minute, d'un quart d'heure ou de six heures.
+ * HISTORY_REQUEST (afficheur → cœur) : terrarium (u8), palier (u8), champs
+ * (core_link_delta_field_mask_t, LE16), `before_epoch` (LE32, 0 : maintenant)
+ * et nombre maximal de seaux (u8). Le cœur répond par un unique HISTORY_CHUNK :
+ * terrarium (u8), palier (u8), statut (u8), champs retenus (LE16), fin du
+ * premier seau (LE32), nombre de seaux (u8), drapeaux (u8) puis les seaux, du
+ * plus récent au plus ancien. Chaque seau porte son nombre d'échantillons
+ * (LE16, 0 : aucune mesure) puis, pour chaque champ dans l'ordre croissant des
+ * bits, minimum, maximum et moyenne (LE16 ×3) quantifiés selon la table
+ * d'échelle ci-dessus. L'afficheur pagine en reprenant `before_epoch` au début
+ * du dernier seau reçu. HISTORY_CHUNK part dans la classe d'émission la moins
+ * prioritaire : il ne retarde jamais une trame d'état. Voir core_link_history.h.
+ */
+#define CORE_LINK_HISTORY_REQUEST_SIZE 9U
+#define CORE_LINK_HISTORY_CHUNK_HEADER_SIZE 11U
+
+static inline void core_link_put_le64(uint8_t *out, uint64_t value)
+{
+    for (size_t i = 0; i < 8; ++i) {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static inline uint64_t core_link_get_le64(const uint8_t *in)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        value |= (uint64_t)in[i] << (8 * i);
+    }
+    return value;
+}
+
+static inline bool core_link_msg_is_state_full(uint8_t type)
+{
+    return type == CORE_LINK_MSG_STATE_FULL || type == CORE_LINK_MSG_STATE_FULL_COMPACT;
+}
+
+static inline bool core_link_msg_is_state(uint8_t type)
+{
+    return core_link_msg_is_state_full(type) || type == CORE_LINK_MSG_STATE_DELTA ||
+           type == CORE_LINK_MSG_STATE_DELTA_COMPACT || type == CORE_LINK_MSG_STATE_FRAGMENT ||
+           type == CORE_LINK_MSG_NAME_TABLE || type == CORE_LINK_MSG_STATE_FULL_COMPRESSED;
+}
+
+static inline void core_link_state_frame_init(core_link_state_frame_t *frame, uint8_t capacity)
+{
+    memset(frame, 0, CORE_LINK_STATE_FRAME_SIZE(capacity));
+    frame->terrarium_capacity = capacity;
+}
+
+/** Copie `src` dans `dst` ; false si `dst` est trop petit. */
+static inline bool core_link_state_frame_copy(core_link_state_frame_t *dst, const core_link_state_frame_t *src)
+{
+    if (src->terrarium_count > dst->terrarium_capacity) {
+        return false;
+    }
+    dst->epoch_seconds = src->epoch_seconds;
+    dst->sample_us = src->sample_us;
+    dst->terrarium_count = src->terrarium_count;
+    dst->name_generation = src->name_generation;
+    memcpy(dst->terrariums, src->terrariums, (size_t)src->terrarium_count * sizeof(src->terrariums[0]));
+    return true;
+}
+
 #ifdef __cplusplus
 }
 #endif
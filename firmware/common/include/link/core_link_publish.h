@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Ordonnanceur de publication d'état piloté par les changements. Chaque
+ * instantané candidat est comparé à la dernière trame effectivement publiée :
+ *
+ *  - une variation dépassant la bande morte d'un champ (cumulée depuis la
+ *    dernière publication, une dérive lente finit donc par partir) publie dès
+ *    que `min_interval_ms` est écoulé ;
+ *  - un seuil d'alerte franchi (dans un sens ou dans l'autre) publie
+ *    immédiatement, sans attendre `min_interval_ms` ;
+ *  - sans changement significatif, une trame de maintien part au bout de
+ *    `max_interval_ms` pour nourrir le chien de garde de l'afficheur.
+ *
+ * Un changement de structure (nombre de terrariums, identifiant, nom, repas)
+ * est toujours significatif. Le module ne dépend d'aucune horloge : l'appelant
+ * fournit le temps en millisecondes.
+ */
+
+typedef struct {
+    float temp_c;
+    float humidity_pct;
+    float lux;
+    float vitals_pct; /* hydratation, stress, santé */
+    float activity;
+} core_link_publish_deadbands_t;
+
+typedef struct {
+    core_link_publish_deadbands_t deadband;
+    uint32_t min_interval_ms;
+    uint32_t max_interval_ms;
+    float alert_health_below_pct;
+    float alert_hydration_below_pct;
+    float alert_stress_above_pct;
+} core_link_publish_policy_t;
+
+/* Bandes mortes par défaut : quelques pas de quantification compacte. */
+#define CORE_LINK_PUBLISH_DEADBANDS_DEFAULT \
+    {                                       \
+        .temp_c = 0.1f,                     \
+        .humidity_pct = 0.5f,               \
+        .lux = 10.0f,                       \
+        .vitals_pct = 0.5f,                 \
+        .activity = 0.02f,                  \
+    }
+
+typedef enum {
+    CORE_LINK_PUBLISH_NONE = 0,
+    CORE_LINK_PUBLISH_CHANGE,    /* bande morte dépassée */
+    CORE_LINK_PUBLISH_ALERT,     /* seuil d'alerte franchi */
+    CORE_LINK_PUBLISH_HEARTBEAT, /* max_interval_ms écoulé */
+    CORE_LINK_PUBLISH_FORCED,    /* aucune référence (démarrage, resynchronisation) */
+} core_link_publish_reason_t;
+
+typedef struct {
+    core_link_publish_policy_t policy;
+    core_link_state_frame_t *reference;
+    bool reference_valid;
+    uint32_t last_publish_ms;
+} core_link_publish_scheduler_t;
+
+/**
+ * \brief Initialise l'ordonnanceur.
+ *
+ * `reference` est fourni par l'appelant (CORE_LINK_STATE_FRAME_SIZE(capacité))
+ * et reçoit une copie de chaque trame publiée.
+ */
+void core_link_publish_init(core_link_publish_scheduler_t *sched, const core_link_publish_policy_t *policy,
+                            core_link_state_frame_t *reference, uint8_t capacity);
+
+/** Indique si `frame` doit être publiée à `now_ms`, et pourquoi. */
+core_link_publish_reason_t core_link_publish_evaluate(const core_link_publish_scheduler_t *sched,
+                                                      const core_link_state_frame_t *frame, uint32_t now_ms);
+
+/** Enregistre `frame` comme dernière trame publiée. */
+void core_link_publish_mark_published(core_link_publish_scheduler_t *sched, const core_link_state_frame_t *frame,
+                                      uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Compteurs de télémétrie d'une extrémité du Core Link. Chaque tâche
+ * (réception, émission, chien de garde, applicatif) incrémente ses compteurs
+ * par opérations atomiques relâchées, sans verrou ; un lecteur obtient un
+ * instantané cohérent compteur par compteur via core_link_stats_snapshot().
+ *
+ * Les allers-retours PING→PONG alimentent un histogramme à seaux log2 :
+ * le seau i compte les RTT dans [2^i, 2^(i+1)) µs, le dernier seau absorbant
+ * tout ce qui dépasse. Un second histogramme, de même découpage, mesure sur
+ * l'afficheur la latence de bout en bout d'une valeur : de son échantillon
+ * dans core_state_manager_advance() jusqu'au flush LVGL qui l'affiche.
+ */
+
+typedef enum {
+    CORE_LINK_STAT_FRAMES_TX = 0,
+    CORE_LINK_STAT_FRAMES_RX,
+    CORE_LINK_STAT_BYTES_TX,
+    CORE_LINK_STAT_BYTES_RX,
+    CORE_LINK_STAT_CHECKSUM_ERRORS, /* en-têtes corrompus ou surdimensionnés écartés */
+    CORE_LINK_STAT_STATE_FULL,      /* STATE_FULL émis (cœur) ou appliqués (afficheur) */
+    CORE_LINK_STAT_STATE_DELTA,     /* STATE_DELTA émis (cœur) ou appliqués (afficheur) */
+    CORE_LINK_STAT_RESYNCS,         /* resynchronisations complètes demandées */
+    CORE_LINK_STAT_NAKS,            /* NAK émis (afficheur) ou reçus (cœur) */
+    CORE_LINK_STAT_TX_DROPPED,      /* trames abandonnées, file d'émission pleine */
+    CORE_LINK_STAT_FULL_COMPRESSED, /* dont STATE_FULL partis / reçus en STATE_FULL_COMPRESSED */
+    CORE_LINK_STAT_FULL_BYTES_SAVED, /* octets de charge épargnés par ces derniers */
+    CORE_LINK_STAT_BAUD_SWITCHES,   /* changements de débit UART confirmés, replis compris */
+    CORE_LINK_STAT_BAUD_RATE,       /* jauge : débit UART courant (bit/s), pas un cumul */
+    CORE_LINK_STAT_COUNT,
+} core_link_stat_id_t;
+
+#define CORE_LINK_RTT_BUCKETS 20 /* dernier seau : RTT ≥ 2^19 µs (≈ 524 ms) */
+
+typedef struct {
+    atomic_uint_least32_t counters[CORE_LINK_STAT_COUNT];
+    atomic_uint_least32_t rtt_buckets[CORE_LINK_RTT_BUCKETS];
+    atomic_uint_least32_t rtt_last_us;
+    atomic_uint_least32_t rtt_max_us;
+    atomic_uint_least32_t latency_buckets[CORE_LINK_RTT_BUCKETS];
+    atomic_uint_least32_t latency_last_us;
+    atomic_uint_least32_t latency_max_us;
+} core_link_stats_t;
+
+typedef struct {
+    uint32_t uptime_ms; /* horloge locale de l'instantané, pour le calcul des débits */
+    uint32_t counters[CORE_LINK_STAT_COUNT];
+    uint32_t rtt_buckets[CORE_LINK_RTT_BUCKETS];
+    uint32_t rtt_last_us;
+    uint32_t rtt_max_us;
+    uint32_t latency_buckets[CORE_LINK_RTT_BUCKETS];
+    uint32_t latency_last_us;
+    uint32_t latency_max_us;
+} core_link_stats_snapshot_t;
+
+/*
+ * LINK_STATS (capacité CORE_LINK_CAP_LINK_STATS) : le cœur publie
+ * périodiquement ses compteurs vers l'afficheur. Charge utile :
+ * counter_count (u8), bucket_count (u8), uptime_ms, rtt_last_us, rtt_max_us,
+ * `counter_count` compteurs puis `bucket_count` seaux, tous en LE32. Le
+ * décodeur ignore les entrées qu'il ne connaît pas et laisse à zéro celles
+ * que l'émetteur n'envoie pas. La latence d'affichage, propre à l'afficheur,
+ * ne circule pas.
+ */
+#define CORE_LINK_STATS_PAYLOAD_SIZE (2U + 4U * (3U + CORE_LINK_STAT_COUNT + CORE_LINK_RTT_BUCKETS))
+
+void core_link_stats_reset(core_link_stats_t *stats);
+
+static inline void core_link_stats_add(core_link_stats_t *stats, core_link_stat_id_t id, uint32_t amount)
+{
+    atomic_fetch_add_explicit(&stats->counters[id], amount, memory_order_relaxed);
+}
+
+static inline void core_link_stats_set(core_link_stats_t *stats, core_link_stat_id_t id, uint32_t value)
+{
+    atomic_store_explicit(&stats->counters[id], value, memory_order_relaxed);
+}
+
+static inline uint32_t core_link_stats_get(const core_link_stats_t *stats, core_link_stat_id_t id)
+{
+    return (uint32_t)atomic_load_explicit(&stats->counters[id], memory_order_relaxed);
+}
+
+/** Seau log2 d'un aller-retour de `rtt_us` microsecondes. */
+size_t core_link_stats_rtt_bucket(uint32_t rtt_us);
+
+/** Enregistre un aller-retour PING→PONG. */
+void core_link_stats_record_rtt(core_link_stats_t *stats, uint32_t rtt_us);
+
+/** Enregistre la latence échantillon → pixel d'une valeur affichée. */
+void core_link_stats_record_latency(core_link_stats_t *stats, uint32_t latency_us);
+
+/** Copie les compteurs dans `out`, daté de `uptime_ms`. */
+void core_link_stats_snapshot(const core_link_stats_t *stats, uint32_t uptime_ms, core_link_stats_snapshot_t *out);
+
+/** Nombre d'allers-retours enregistrés dans l'histogramme. */
+uint32_t core_link_stats_rtt_samples(const core_link_stats_snapshot_t *snapshot);
+
+/**
+ * \brief Borne haute (µs) du seau contenant le centile `percent` des RTT.
+ * @return 0 si aucun aller-retour n'a été mesuré.
+ */
+uint32_t core_link_stats_rtt_percentile_us(const core_link_stats_snapshot_t *snapshot, unsigned percent);
+
+/** Nombre de latences d'affichage enregistrées. */
+uint32_t core_link_stats_latency_samples(const core_link_stats_snapshot_t *snapshot);
+
+/** Équivalent de core_link_stats_rtt_percentile_us() pour la latence d'affichage. */
+uint32_t core_link_stats_latency_percentile_us(const core_link_stats_snapshot_t *snapshot, unsigned percent);
+
+/**
+ * \brief Débit par seconde du compteur `id` entre deux instantanés.
+ * @return 0 si `cur` n'est pas postérieur à `prev`.
+ */
+uint32_t core_link_stats_rate(const core_link_stats_snapshot_t *prev, const core_link_stats_snapshot_t *cur,
+                              core_link_stat_id_t id);
+
+/**
+ * \brief Sérialise une charge LINK_STATS.
+ * @return Nombre d'octets écrits, 0 si `capacity` < CORE_LINK_STATS_PAYLOAD_SIZE.
+ */
+size_t core_link_stats_encode(const core_link_stats_snapshot_t *snapshot, uint8_t *out, size_t capacity);
+
+/** Décode une charge LINK_STATS ; false si elle est tronquée. */
+bool core_link_stats_decode(const uint8_t *payload, size_t length, core_link_stats_snapshot_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Analyseur de trames Core Link en flux continu, partagé par l'afficheur et
+ * le DevKitC. Les octets UART sont lus par gros blocs directement dans un
+ * tampon circulaire ; les trames complètes sont exposées sans recopie (la
+ * charge utile pointe dans le tampon) et la resynchronisation sur SOF ne
+ * jette que l'octet fautif, jamais les trames valides qui suivent.
+ *
+ * Deux formats coexistent sur le fil et sont reconnus par leur SOF :
+ * - v1 : SOF (0xA5) | type | longueur (LE16) | charge utile | somme 8 bits ;
+ * - v2 : SOF (0xA6) | type | longueur (LE16) | séquence (LE16) | charge utile |
+ *        CRC-16/CCITT (LE16, calculé du type à la fin de la charge utile).
+ * Le format v2 n'est émis qu'après négociation (`CORE_LINK_CAP_FRAME_V2`).
+ * Une séquence nulle désigne une trame non séquencée.
+ */
+
+#define CORE_LINK_SOF 0xA5
+#define CORE_LINK_SOF_V2 0xA6
+#define CORE_LINK_MAX_PAYLOAD 512
+#define CORE_LINK_FRAME_HEADER_SIZE 4U
+#define CORE_LINK_FRAME_TRAILER_SIZE 1U
+#define CORE_LINK_FRAME_OVERHEAD (CORE_LINK_FRAME_HEADER_SIZE + CORE_LINK_FRAME_TRAILER_SIZE)
+#define CORE_LINK_FRAME_V2_HEADER_SIZE 6U
+#define CORE_LINK_FRAME_V2_TRAILER_SIZE 2U
+#define CORE_LINK_FRAME_V2_OVERHEAD (CORE_LINK_FRAME_V2_HEADER_SIZE + CORE_LINK_FRAME_V2_TRAILER_SIZE)
+#define CORE_LINK_FRAME_MAX_SIZE (CORE_LINK_MAX_PAYLOAD + CORE_LINK_FRAME_V2_OVERHEAD)
+
+/**
+ * Taille du stockage à fournir à core_link_stream_init() pour un anneau de
+ * `capacity` octets : une zone de débordement d'une trame maximale suit
+ * l'anneau afin de rendre contiguë une trame qui chevauche la fin du tampon.
+ */
+#define CORE_LINK_STREAM_STORAGE_SIZE(capacity) ((capacity) + CORE_LINK_FRAME_MAX_SIZE)
+
+typedef struct {
+    uint32_t frames;
+    uint32_t bytes_in;
+    uint32_t bytes_skipped;
+    uint32_t checksum_errors;
+    uint32_t oversize_errors;
+    uint32_t wrapped_frames;
+} core_link_stream_stats_t;
+
+typedef struct {
+    uint8_t version;
+    uint8_t type;
+    uint16_t seq;
+    uint16_t length;
+    const uint8_t *payload;
+} core_link_stream_frame_t;
+
+typedef struct {
+    uint8_t *storage;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    size_t pending_release;
+    core_link_stream_stats_t stats;
+} core_link_stream_t;
+
+/**
+ * \brief Initialise un flux sur un stockage fourni par l'appelant.
+ *
+ * @param storage_size Taille totale du stockage, au moins
+ *                     `CORE_LINK_STREAM_STORAGE_SIZE(CORE_LINK_FRAME_MAX_SIZE)`.
+ * @return false si le stockage est trop petit.
+ */
+bool core_link_stream_init(core_link_stream_t *stream, uint8_t *storage, size_t storage_size);
+void core_link_stream_reset(core_link_stream_t *stream);
+
+/**
+ * \brief Fenêtre contiguë libre dans laquelle le pilote UART peut écrire.
+ *
+ * Les octets écrits doivent ensuite être validés par core_link_stream_commit().
+ * @return Nombre d'octets disponibles à partir de `*out_window` (0 si plein).
+ */
+size_t core_link_stream_write_window(core_link_stream_t *stream, uint8_t **out_window);
+void core_link_stream_commit(core_link_stream_t *stream, size_t length);
+
+/** Copie `length` octets dans l'anneau ; renvoie le nombre d'octets acceptés. */
+size_t core_link_stream_push(core_link_stream_t *stream, const uint8_t *data, size_t length);
+
+/**
+ * \brief Extrait la prochaine trame valide.
+ *
+ * La vue retournée reste valide jusqu'à l'appel suivant de
+ * core_link_stream_next() ou core_link_stream_reset().
+ * @return true si `out_frame` a été renseignée, false s'il faut plus d'octets.
+ */
+bool core_link_stream_next(core_link_stream_t *stream, core_link_stream_frame_t *out_frame);
+
+/**
+ * \brief Abandonne le SOF en tête lorsqu'une trame partielle n'avance plus.
+ *
+ * Seul le premier octet est écarté : les octets suivants sont réanalysés.
+ */
+void core_link_stream_skip_partial(core_link_stream_t *stream);
+size_t core_link_stream_buffered(const core_link_stream_t *stream);
+
+uint8_t core_link_frame_checksum(uint8_t type, uint16_t length, const uint8_t *payload);
+uint16_t core_link_crc16_update(uint16_t crc, const uint8_t *data, size_t length);
+
+/** CRC-16/CCITT-FALSE d'une trame v2 (type, longueur, séquence, charge utile). */
+uint16_t core_link_frame_crc16(uint8_t type, uint16_t length, uint16_t seq, const uint8_t *payload);
+
+/**
+ * \brief Sérialise une trame v1 complète (en-tête, charge utile, somme).
+ * @return Taille écrite, ou 0 si `out_size` est insuffisant.
+ */
+size_t core_link_frame_encode(uint8_t *out, size_t out_size, uint8_t type, const void *payload, uint16_t length);
+
+/** Variante v2 de core_link_frame_encode() (séquence + CRC-16). */
+size_t core_link_frame_encode_v2(uint8_t *out, size_t out_size, uint8_t type, uint16_t seq, const void *payload,
+                                 uint16_t length);
+
+/** Numéro de séquence suivant (la valeur 0 est réservée aux trames non séquencées). */
+static inline uint16_t core_link_seq_next(uint16_t seq)
+{
+    uint16_t next = (uint16_t)(seq + 1U);
+    return next == 0 ? 1 : next;
+}
+
+/** Distance signée `a - b` dans l'espace des séquences (0 exclu). */
+static inline int32_t core_link_seq_diff(uint16_t a, uint16_t b)
+{
+    int32_t diff = (int32_t)a - (int32_t)b;
+    if (diff > 32767) {
+        diff -= 65535;
+    } else if (diff < -32767) {
+        diff += 65535;
+    }
+    return diff;
+}
+
+#ifdef __cplusplus
+}
+#endif
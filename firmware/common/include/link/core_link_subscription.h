@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Abonnement de l'afficheur (message SUBSCRIBE) : terrariums et champs que la
+ * vue courante affiche, et cadence souhaitée. L'afficheur le construit et
+ * l'encode ; le cœur le décode et en filtre ses STATE_DELTA : un champ hors
+ * abonnement garde dans la trame la valeur déjà envoyée, il ne compte donc
+ * jamais comme modifié. Tant que l'abonnement restreint la vue, le
+ * rafraîchissement périodique part lui aussi en STATE_DELTA limité aux champs
+ * abonnés ; seules les resynchronisations (REQUEST_STATE, trame perdue)
+ * renvoient un STATE_FULL complet. Élargir l'abonnement suffit à faire
+ * repartir les écarts accumulés dans le delta suivant, sans resynchronisation.
+ */
+typedef struct {
+    core_link_delta_field_mask_t field_mask;
+    uint16_t min_interval_ms; /* 0 : chaque publication */
+    bool all_terrariums;
+    uint32_t terrarium_bits[8]; /* identifiants abonnés (u8), si !all_terrariums */
+} core_link_subscription_t;
+
+/** Abonnement par défaut : tous les champs de tous les terrariums, sans limite de cadence. */
+void core_link_subscription_all(core_link_subscription_t *sub);
+
+/** Abonnement vide (aucun terrarium), cadence `min_interval_ms` : le reste est ajouté ensuite. */
+void core_link_subscription_none(core_link_subscription_t *sub, core_link_delta_field_mask_t field_mask,
+                                 uint16_t min_interval_ms);
+
+void core_link_subscription_add_terrarium(core_link_subscription_t *sub, uint8_t terrarium_id);
+
+/** Vrai pour l'abonnement par défaut, qui ne filtre rien. */
+static inline bool core_link_subscription_is_all(const core_link_subscription_t *sub)
+{
+    return sub->all_terrariums && sub->field_mask == CORE_LINK_DELTA_FIELD_ALL;
+}
+
+/** Champs abonnés pour `terrarium_id` (0 s'il n'est pas abonné). */
+static inline core_link_delta_field_mask_t core_link_subscription_mask(const core_link_subscription_t *sub,
+                                                                       uint8_t terrarium_id)
+{
+    if (!sub->all_terrariums && !(sub->terrarium_bits[terrarium_id >> 5] & (1UL << (terrarium_id & 31U)))) {
+        return 0;
+    }
+    return sub->field_mask;
+}
+
+/**
+ * \brief Sérialise la charge SUBSCRIBE.
+ * @return Octets écrits, 0 si `capacity` ne suffit pas.
+ */
+size_t core_link_subscription_encode(const core_link_subscription_t *sub, uint8_t *out, size_t capacity);
+
+/** Décode une charge SUBSCRIBE ; `sub` n'est pas modifié si elle est invalide. */
+bool core_link_subscription_decode(const uint8_t *payload, size_t length, core_link_subscription_t *sub);
+
+/**
+ * \brief Fige dans `snap` les champs hors abonnement à leur valeur de `sent`.
+ *
+ * `sent` est l'instantané du même terrarium déjà connu de l'afficheur.
+ */
+void core_link_subscription_filter(const core_link_subscription_t *sub, core_link_terrarium_snapshot_t *snap,
+                                   const core_link_terrarium_snapshot_t *sent);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Coalescence des contacts tactiles côté afficheur. Chaque point
+ * (0..CORE_LINK_TOUCH_MAX_POINTS-1) dispose d'un emplacement « dernière
+ * valeur » ; le producteur (tâche tactile, un échantillon I2C à la fois) y
+ * écrit la position puis marque le point dans un bitmap atomique, sans
+ * verrou ni section critique. Le consommateur (tâche de dispatch) vide le
+ * bitmap et reconstruit les transitions DOWN/MOVE/UP à transmettre : les
+ * positions intermédiaires d'un même glissé sont fusionnées, mais un appui
+ * ou un relâchement n'est jamais perdu (un tap complet entre deux passages
+ * donne DOWN puis UP).
+ *
+ * Un seul producteur et un seul consommateur par table.
+ */
+
+#define CORE_LINK_TOUCH_MAX_POINTS 5
+/* Pire cas par point et par passage : UP, DOWN puis UP. */
+#define CORE_LINK_TOUCH_BATCH_MAX (3U * CORE_LINK_TOUCH_MAX_POINTS)
+#define CORE_LINK_TOUCH_BATCH_ENTRY_SIZE 6U
+#define CORE_LINK_TOUCH_BATCH_PAYLOAD_MAX (1U + CORE_LINK_TOUCH_BATCH_MAX * CORE_LINK_TOUCH_BATCH_ENTRY_SIZE)
+
+typedef struct {
+    /* Partagé producteur/consommateur. */
+    atomic_uint_least32_t coords[CORE_LINK_TOUCH_MAX_POINTS]; /* x | y << 16 */
+    atomic_uint_least32_t active;       /* bitmap : contact en cours vu par le producteur */
+    atomic_uint_least32_t down_pending; /* bitmap : appui survenu depuis le dernier passage */
+    atomic_uint_least32_t up_pending;   /* bitmap : relâchement survenu depuis le dernier passage */
+    atomic_uint_least32_t dirty;        /* bitmap : points à examiner */
+    atomic_bool reset_pending;
+    /* Réservé au consommateur : dernier événement transmis par point. */
+    core_link_touch_event_t last_sent[CORE_LINK_TOUCH_MAX_POINTS];
+    uint32_t last_sent_valid;
+} core_link_touch_slots_t;
+
+/** Remet la table à zéro ; à n'appeler qu'avant le démarrage des deux tâches. */
+void core_link_touch_slots_init(core_link_touch_slots_t *slots);
+
+/**
+ * \brief Oublie les contacts en cours (perte de liaison).
+ *
+ * Sûr depuis n'importe quelle tâche : l'état du consommateur est effacé à
+ * son prochain passage.
+ */
+void core_link_touch_slots_reset(core_link_touch_slots_t *slots);
+
+/**
+ * \brief Enregistre un échantillon tactile (producteur).
+ *
+ * Normalise le type : un DOWN sur un point déjà actif devient un MOVE, un
+ * MOVE sur un point inactif devient un DOWN, un UP sans contact est ignoré.
+ * @return true si le consommateur doit être réveillé.
+ */
+bool core_link_touch_slots_update(core_link_touch_slots_t *slots, const core_link_touch_event_t *event);
+
+/**
+ * \brief Construit les événements à transmettre (consommateur).
+ *
+ * Vide le bitmap des points modifiés et écrit au plus `capacity` événements
+ * dans `out`, dans l'ordre des points. Les positions identiques au dernier
+ * envoi sont écartées.
+ * @return Nombre d'événements écrits.
+ */
+size_t core_link_touch_slots_collect(core_link_touch_slots_t *slots, core_link_touch_event_t *out, size_t capacity);
+
+/**
+ * \brief Sérialise un lot TOUCH_EVENT (capacité CORE_LINK_CAP_TOUCH_BATCH).
+ * @return Nombre d'octets écrits, 0 si `capacity` est insuffisant.
+ */
+size_t core_link_touch_batch_encode(const core_link_touch_event_t *events, size_t count, uint8_t *out, size_t capacity);
+
+/**
+ * \brief Décode un lot TOUCH_EVENT.
+ * @return Nombre d'événements décodés, 0 si la charge est malformée.
+ */
+size_t core_link_touch_batch_decode(const uint8_t *payload, size_t length, core_link_touch_event_t *out,
+                                    size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
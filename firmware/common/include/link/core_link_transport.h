@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Transport d'octets sous le Core Link. core_link.c et core_host_link.c ne
+ * parlent qu'à cette table de fonctions : l'UART ESP-IDF en production
+ * (core_link_transport_uart.h), un descripteur POSIX (pty ou socketpair) pour
+ * faire tourner les deux extrémités dans un même processus Linux
+ * (core_link_transport_posix.h, utilisé par `link_bench`).
+ */
+
+/** Attente infinie pour core_link_transport_ops_t::read. */
+#define CORE_LINK_TRANSPORT_WAIT_FOREVER UINT32_MAX
+
+typedef struct {
+    /**
+     * \brief Écrit une trame complète d'un bloc.
+     * @return Nombre d'octets écrits, négatif en cas d'erreur.
+     */
+    int (*write)(void *ctx, const uint8_t *data, size_t length);
+    /**
+     * \brief Attend au plus `timeout_ms` qu'un octet arrive, puis rend tout ce
+     * qui est déjà reçu (au plus `capacity` octets) sans attendre davantage.
+     * @return Nombre d'octets lus, 0 à l'expiration, négatif en cas d'erreur.
+     */
+    int (*read)(void *ctx, uint8_t *data, size_t capacity, uint32_t timeout_ms);
+    /**
+     * \brief Change le débit après avoir laissé partir les octets déjà écrits.
+     * Facultatif (NULL : débit fixe). Appelé par la tâche qui écrit, ou sous
+     * le même verrou qu'elle.
+     * @return 0 en cas de succès, négatif sinon.
+     */
+    int (*set_baud)(void *ctx, uint32_t bits_per_second);
+} core_link_transport_ops_t;
+
+typedef struct {
+    const core_link_transport_ops_t *ops;
+    void *ctx;
+} core_link_transport_t;
+
+static inline int core_link_transport_write(const core_link_transport_t *transport, const uint8_t *data, size_t length)
+{
+    return transport->ops->write(transport->ctx, data, length);
+}
+
+static inline int core_link_transport_read(const core_link_transport_t *transport, uint8_t *data, size_t capacity,
+                                           uint32_t timeout_ms)
+{
+    return transport->ops->read(transport->ctx, data, capacity, timeout_ms);
+}
+
+static inline int core_link_transport_set_baud(const core_link_transport_t *transport, uint32_t bits_per_second)
+{
+    return transport->ops->set_baud ? transport->ops->set_baud(transport->ctx, bits_per_second) : -1;
+}
+
+#ifdef __cplusplus
+}
+#endif
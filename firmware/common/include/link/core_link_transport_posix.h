@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "link/core_link_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Transport Core Link sur un descripteur POSIX (Linux). Une paire pty ou
+ * socketpair relie l'afficheur et le cœur dans un même processus ; le
+ * cadencement optionnel retarde chaque écriture du temps qu'elle occuperait
+ * sur une UART 8N1 au débit donné, pour des mesures comparables au matériel.
+ */
+
+typedef enum {
+    CORE_LINK_POSIX_SOCKETPAIR,
+    CORE_LINK_POSIX_PTY,
+} core_link_posix_pair_kind_t;
+
+typedef struct {
+    int fd;
+    uint32_t bits_per_second; /* 0 : pas de cadencement */
+    int64_t wire_free_us;
+} core_link_posix_transport_t;
+
+/** Prépare `out` sur un descripteur déjà ouvert (bloquant). */
+bool core_link_transport_posix_open(core_link_transport_t *out, core_link_posix_transport_t *state, int fd,
+                                    uint32_t bits_per_second);
+
+/** Crée deux extrémités reliées ; ce qu'écrit `a` est lu par `b` et inversement. */
+bool core_link_transport_posix_pair(core_link_posix_pair_kind_t kind, uint32_t bits_per_second,
+                                    core_link_transport_t *a, core_link_posix_transport_t *a_state,
+                                    core_link_transport_t *b, core_link_posix_transport_t *b_state);
+
+void core_link_transport_posix_close(core_link_posix_transport_t *state);
+
+#ifdef __cplusplus
+}
+#endif
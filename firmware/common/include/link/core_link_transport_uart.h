@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "esp_err.h"
+#include "link/core_link_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Transport Core Link sur le pilote UART ESP-IDF (8N1, sans contrôle de flux). */
+
+typedef struct {
+    int uart_port;
+    int tx_gpio;
+    int rx_gpio;
+    int baud_rate;
+    size_t rx_buffer_size;
+} core_link_uart_transport_config_t;
+
+typedef struct {
+    int uart_port;
+} core_link_uart_transport_t;
+
+/**
+ * \brief Installe le pilote UART et prépare `out` pour l'utiliser.
+ *
+ * `uart` doit survivre au transport (il en est le contexte).
+ */
+esp_err_t core_link_transport_uart_open(core_link_transport_t *out, core_link_uart_transport_t *uart,
+                                        const core_link_uart_transport_config_t *config);
+
+#ifdef __cplusplus
+}
+#endif
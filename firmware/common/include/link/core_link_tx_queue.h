@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "link/core_link_protocol.h"
+#include "link/core_link_stream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * File d'émission à priorités du Core Link. Les producteurs (tâche RX,
+ * minuterie de chien de garde, tâche tactile, tâches applicatives) déposent
+ * des trames déjà sérialisées dans des emplacements de taille fixe ; une
+ * unique tâche d'émission les retire par ordre de classe puis d'arrivée et
+ * les écrit d'un seul bloc sur l'UART.
+ *
+ * L'ordre FIFO est garanti au sein d'une classe : les trames séquencées d'état
+ * restent ordonnées entre elles. Le module n'est pas verrouillé ; l'appelant
+ * sérialise les accès et fournit l'horloge en microsecondes.
+ */
+
+typedef enum {
+    CORE_LINK_TX_PRIO_URGENT = 0, /* tactile, acquittements, NAK, poignée de main */
+    CORE_LINK_TX_PRIO_PING,       /* PING/PONG et retransmissions */
+    CORE_LINK_TX_PRIO_STATE,      /* trames d'état séquencées */
+    CORE_LINK_TX_PRIO_BULK,       /* commandes et transferts volumineux */
+    CORE_LINK_TX_PRIO_COUNT,
+} core_link_tx_priority_t;
+
+typedef struct core_link_tx_slot {
+    struct core_link_tx_slot *next;
+    int64_t enqueued_us;
+    uint16_t length;
+    uint8_t priority;
+    uint8_t data[CORE_LINK_FRAME_MAX_SIZE];
+} core_link_tx_slot_t;
+
+typedef struct {
+    uint32_t enqueued;
+    uint32_t sent;
+    uint32_t dropped;
+    uint16_t depth;
+    uint16_t max_depth;
+    uint32_t max_latency_us;
+    uint64_t total_latency_us;
+} core_link_tx_class_stats_t;
+
+typedef struct {
+    core_link_tx_class_stats_t classes[CORE_LINK_TX_PRIO_COUNT];
+    uint16_t depth;     /* emplacements occupés, toutes classes */
+    uint16_t max_depth;
+    uint16_t capacity;
+    uint32_t bytes_sent;
+} core_link_tx_stats_t;
+
+typedef struct {
+    core_link_tx_slot_t *slots;
+    size_t capacity;
+    core_link_tx_slot_t *free_list;
+    core_link_tx_slot_t *head[CORE_LINK_TX_PRIO_COUNT];
+    core_link_tx_slot_t *tail[CORE_LINK_TX_PRIO_COUNT];
+    core_link_tx_stats_t stats;
+} core_link_tx_queue_t;
+
+/** Initialise la file sur `capacity` emplacements fournis par l'appelant. */
+void core_link_tx_queue_init(core_link_tx_queue_t *queue, core_link_tx_slot_t *slots, size_t capacity);
+
+/**
+ * \brief Réserve un emplacement libre pour y sérialiser une trame.
+ * @return NULL si la file est pleine.
+ */
+core_link_tx_slot_t *core_link_tx_queue_acquire(core_link_tx_queue_t *queue);
+
+/** Rend un emplacement réservé sans l'émettre (échec de sérialisation). */
+void core_link_tx_queue_abort(core_link_tx_queue_t *queue, core_link_tx_slot_t *slot);
+
+/**
+ * \brief Publie un emplacement rempli (`slot->length` octets) dans sa classe.
+ *
+ * `now_us` date la mise en file : la latence mesurée couvre l'attente et l'écriture.
+ */
+void core_link_tx_queue_push(core_link_tx_queue_t *queue, core_link_tx_slot_t *slot, core_link_tx_priority_t priority,
+                             int64_t now_us);
+
+/**
+ * \brief Retire la trame la plus prioritaire.
+ *
+ * L'emplacement reste réservé jusqu'à core_link_tx_queue_complete().
+ * @return NULL si la file est vide.
+ */
+core_link_tx_slot_t *core_link_tx_queue_pop(core_link_tx_queue_t *queue);
+
+/** Libère un emplacement émis et met à jour les métriques de latence. */
+void core_link_tx_queue_complete(core_link_tx_queue_t *queue, core_link_tx_slot_t *slot, int64_t now_us);
+
+/** Comptabilise une trame abandonnée faute d'emplacement. */
+void core_link_tx_queue_note_drop(core_link_tx_queue_t *queue, core_link_tx_priority_t priority);
+
+/** Classe d'émission par défaut d'un type de message. */
+core_link_tx_priority_t core_link_tx_priority_for(core_link_msg_type_t type);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,67 @@
+#include "link/core_link_baseline.h"
+
+#include <string.h>
+
+#include "link/core_link_stream.h"
+
+void core_link_baseline_init(core_link_baseline_t *baseline, uint8_t *buffer, size_t capacity)
+{
+    baseline->buffer = buffer;
+    baseline->capacity = capacity;
+    core_link_baseline_reset(baseline);
+}
+
+void core_link_baseline_reset(core_link_baseline_t *baseline)
+{
+    baseline->length = 0;
+    baseline->crc = 0;
+    baseline->valid = false;
+}
+
+bool core_link_baseline_store(core_link_baseline_t *baseline, const uint8_t *payload, size_t length)
+{
+    if (!baseline->buffer || length > baseline->capacity || length > UINT16_MAX) {
+        core_link_baseline_reset(baseline);
+        return false;
+    }
+    memcpy(baseline->buffer, payload, length);
+    baseline->length = length;
+    baseline->crc = core_link_crc16_update(0xFFFF, payload, length);
+    baseline->valid = true;
+    return true;
+}
+
+void core_link_baseline_xor(const core_link_baseline_t *baseline, uint8_t *data, size_t length)
+{
+    // Bytes past the end of the reference XOR with zero: they stay as they are.
+    size_t common = length < baseline->length ? length : baseline->length;
+    for (size_t i = 0; i < common; ++i) {
+        data[i] ^= baseline->buffer[i];
+    }
+}
+
+void core_link_full_compressed_header_write(uint8_t *out, const core_link_full_compressed_header_t *header)
+{
+    out[0] = header->inner_type;
+    out[1] = header->codec;
+    out[2] = (uint8_t)header->baseline_crc;
+    out[3] = (uint8_t)(header->baseline_crc >> 8);
+    out[4] = (uint8_t)header->length;
+    out[5] = (uint8_t)(header->length >> 8);
+    out[6] = (uint8_t)header->crc;
+    out[7] = (uint8_t)(header->crc >> 8);
+}
+
+bool core_link_full_compressed_header_read(const uint8_t *payload, size_t length,
+                                           core_link_full_compressed_header_t *out)
+{
+    if (!payload || length < CORE_LINK_FULL_COMPRESSED_HEADER_SIZE || !core_link_msg_is_state_full(payload[0])) {
+        return false;
+    }
+    out->inner_type = payload[0];
+    out->codec = payload[1];
+    out->baseline_crc = (uint16_t)(payload[2] | (payload[3] << 8));
+    out->length = (uint16_t)(payload[4] | (payload[5] << 8));
+    out->crc = (uint16_t)(payload[6] | (payload[7] << 8));
+    return true;
+}
@@ -0,0 +1,146 @@
+#include "link/core_link_baud.h"
+
+#include <string.h>
+
+// Standard UART rates, slowest first; the ESP32-S3 UART tops out at 5 Mbit/s.
+static const uint32_t s_rates[CORE_LINK_BAUD_RATE_COUNT] = {
+    115200, 230400, 460800, 921600, 1000000, 1500000, 2000000, 2500000, 3000000, 4000000, 5000000,
+};
+
+uint32_t core_link_baud_rate(uint8_t index)
+{
+    return index < CORE_LINK_BAUD_RATE_COUNT ? s_rates[index] : 0;
+}
+
+uint8_t core_link_baud_index(uint32_t bits_per_second)
+{
+    for (uint8_t i = 0; i < CORE_LINK_BAUD_RATE_COUNT; ++i) {
+        if (s_rates[i] == bits_per_second) {
+            return i;
+        }
+    }
+    return CORE_LINK_BAUD_INDEX_NONE;
+}
+
+uint16_t core_link_baud_mask(uint32_t min_bps, uint32_t max_bps)
+{
+    uint16_t mask = 0;
+    for (uint8_t i = 0; i < CORE_LINK_BAUD_RATE_COUNT; ++i) {
+        if (s_rates[i] >= min_bps && s_rates[i] <= max_bps) {
+            mask |= (uint16_t)(1U << i);
+        }
+    }
+    return mask;
+}
+
+static void lift_penalty(core_link_baud_policy_t *policy)
+{
+    policy->penalty_windows = 0;
+    policy->ceiling_index = CORE_LINK_BAUD_RATE_COUNT - 1;
+}
+
+static void impose_ceiling(core_link_baud_policy_t *policy, uint8_t ceiling)
+{
+    policy->ceiling_index = ceiling < policy->start_index ? policy->start_index : ceiling;
+    policy->penalty_windows = CORE_LINK_BAUD_PENALTY_WINDOWS;
+}
+
+bool core_link_baud_policy_init(core_link_baud_policy_t *policy, uint32_t start_bps, uint32_t max_bps,
+                                uint32_t error_threshold)
+{
+    memset(policy, 0, sizeof(*policy));
+    uint8_t start = core_link_baud_index(start_bps);
+    if (start == CORE_LINK_BAUD_INDEX_NONE) {
+        return false;
+    }
+    policy->start_index = start;
+    policy->current_index = start;
+    policy->local_mask = core_link_baud_mask(start_bps, max_bps < start_bps ? start_bps : max_bps);
+    policy->error_threshold = error_threshold > 0 ? error_threshold : 1;
+    lift_penalty(policy);
+    return true;
+}
+
+void core_link_baud_policy_set_peer(core_link_baud_policy_t *policy, uint16_t peer_mask)
+{
+    uint16_t common = policy->local_mask & peer_mask;
+    // Without the safe rate in common there is nothing to fall back to: stay put.
+    policy->common_mask = (common & (1U << policy->start_index)) ? common : 0;
+    policy->current_index = policy->start_index;
+    policy->clean_windows = 0;
+    lift_penalty(policy);
+}
+
+void core_link_baud_policy_fall_back(core_link_baud_policy_t *policy)
+{
+    uint8_t lost = policy->current_index;
+    policy->current_index = policy->start_index;
+    policy->clean_windows = 0;
+    if (lost > policy->start_index) {
+        impose_ceiling(policy, (uint8_t)(lost - 1));
+    }
+}
+
+static uint8_t next_common(const core_link_baud_policy_t *policy, uint8_t from, int direction, uint8_t limit)
+{
+    int index = (int)from + direction;
+    while (index >= (int)policy->start_index && index <= (int)limit) {
+        if (policy->common_mask & (1U << index)) {
+            return (uint8_t)index;
+        }
+        index += direction;
+    }
+    return CORE_LINK_BAUD_INDEX_NONE;
+}
+
+core_link_baud_action_t core_link_baud_policy_evaluate(core_link_baud_policy_t *policy, uint32_t errors,
+                                                       uint8_t *out_index)
+{
+    if (policy->common_mask == 0) {
+        return CORE_LINK_BAUD_HOLD;
+    }
+    if (policy->penalty_windows > 0 && --policy->penalty_windows == 0) {
+        lift_penalty(policy);
+    }
+
+    if (errors >= policy->error_threshold) {
+        policy->clean_windows = 0;
+        uint8_t lower = next_common(policy, policy->current_index, -1, policy->current_index);
+        if (lower == CORE_LINK_BAUD_INDEX_NONE) {
+            return CORE_LINK_BAUD_HOLD;
+        }
+        impose_ceiling(policy, lower);
+        *out_index = lower;
+        return CORE_LINK_BAUD_STEP_DOWN;
+    }
+
+    if (policy->clean_windows < CORE_LINK_BAUD_CLEAN_WINDOWS) {
+        ++policy->clean_windows;
+    }
+    if (policy->clean_windows < CORE_LINK_BAUD_CLEAN_WINDOWS) {
+        return CORE_LINK_BAUD_HOLD;
+    }
+    uint8_t higher = next_common(policy, policy->current_index, 1, policy->ceiling_index);
+    if (higher == CORE_LINK_BAUD_INDEX_NONE) {
+        return CORE_LINK_BAUD_HOLD;
+    }
+    policy->clean_windows = 0;
+    *out_index = higher;
+    return CORE_LINK_BAUD_STEP_UP;
+}
+
+void core_link_baud_policy_commit(core_link_baud_policy_t *policy, uint8_t index)
+{
+    if (index < CORE_LINK_BAUD_RATE_COUNT) {
+        policy->current_index = index;
+    }
+    policy->clean_windows = 0;
+}
+
+void core_link_baud_policy_failed(core_link_baud_policy_t *policy, uint8_t index)
+{
+    policy->clean_windows = 0;
+    if (index > policy->current_index) {
+        impose_ceiling(policy, policy->current_index);
+    }
+}
@@ -0,0 +1,131 @@
+#include "link/core_link_clock.h"
+
+#include <string.h>
+
+void core_link_clock_reset(core_link_clock_t *clock)
+{
+    memset(clock, 0, sizeof(*clock));
+}
+
+static void clock_estimate(core_link_clock_t *clock)
+{
+    uint32_t min_rtt = UINT32_MAX;
+    const core_link_clock_sample_t *best = NULL;
+    for (size_t i = 0; i < clock->count; ++i) {
+        if (clock->samples[i].rtt_us < min_rtt) {
+            min_rtt = clock->samples[i].rtt_us;
+            best = &clock->samples[i];
+        }
+    }
+    if (!best) {
+        return;
+    }
+
+    // Popcorn filter: only exchanges close to the fastest one say much about the offset.
+    uint64_t limit = (uint64_t)min_rtt + CORE_LINK_CLOCK_RTT_SLACK_US;
+    int64_t x0 = best->local_us;
+    int64_t y0 = best->offset_us;
+    int64_t sum_x = 0;
+    int64_t sum_y = 0;
+    int64_t min_x = INT64_MAX;
+    int64_t max_x = INT64_MIN;
+    size_t used = 0;
+    for (size_t i = 0; i < clock->count; ++i) {
+        const core_link_clock_sample_t *sample = &clock->samples[i];
+        if (sample->rtt_us > limit) {
+            continue;
+        }
+        // Relative to the best sample: absolute clocks and offsets may be hours of µs.
+        int64_t x = sample->local_us - x0;
+        sum_x += x;
+        sum_y += sample->offset_us - y0;
+        min_x = x < min_x ? x : min_x;
+        max_x = x > max_x ? x : max_x;
+        ++used;
+    }
+
+    clock->synced = true;
+    clock->min_rtt_us = min_rtt;
+    clock->used = used;
+    clock->ref_local_us = best->local_us;
+    clock->ref_offset_us = best->offset_us;
+    clock->drift_ppb = 0;
+    if (used < 3 || max_x - min_x < CORE_LINK_CLOCK_DRIFT_SPAN_US) {
+        return;
+    }
+
+    int64_t mean_x = sum_x / (int64_t)used;
+    int64_t mean_y = sum_y / (int64_t)used;
+    int64_t sxx = 0;
+    int64_t sxy = 0;
+    for (size_t i = 0; i < clock->count; ++i) {
+        const core_link_clock_sample_t *sample = &clock->samples[i];
+        if (sample->rtt_us > limit) {
+            continue;
+        }
+        int64_t dx = sample->local_us - x0 - mean_x;
+        int64_t dy = sample->offset_us - y0 - mean_y;
+        sxx += dx * dx;
+        sxy += dx * dy;
+    }
+    if (sxx <= 0) {
+        return;
+    }
+    // One division per PONG: double is fine even without a hardware double unit.
+    double slope_ppb = (double)sxy / (double)sxx * 1e9;
+    if (slope_ppb > CORE_LINK_CLOCK_DRIFT_MAX_PPB || slope_ppb < -CORE_LINK_CLOCK_DRIFT_MAX_PPB) {
+        return;
+    }
+    clock->ref_local_us = x0 + mean_x;
+    clock->ref_offset_us = y0 + mean_y;
+    clock->drift_ppb = (int32_t)(slope_ppb + (slope_ppb >= 0 ? 0.5 : -0.5));
+}
+
+bool core_link_clock_add_sample(core_link_clock_t *clock, int64_t t1_local_us, int64_t t2_remote_us,
+                                int64_t t4_local_us)
+{
+    if (t4_local_us < t1_local_us || t4_local_us - t1_local_us > UINT32_MAX) {
+        return false;
+    }
+    int64_t midpoint = t1_local_us + (t4_local_us - t1_local_us) / 2;
+    core_link_clock_sample_t *slot = &clock->samples[clock->next];
+    slot->local_us = midpoint;
+    slot->offset_us = t2_remote_us - midpoint;
+    slot->rtt_us = (uint32_t)(t4_local_us - t1_local_us);
+    clock->next = (clock->next + 1) % CORE_LINK_CLOCK_SAMPLES;
+    if (clock->count < CORE_LINK_CLOCK_SAMPLES) {
+        ++clock->count;
+    }
+    clock_estimate(clock);
+    return true;
+}
+
+int64_t core_link_clock_offset_at(const core_link_clock_t *clock, int64_t local_us)
+{
+    if (!clock->synced) {
+        return 0;
+    }
+    int64_t elapsed = local_us - clock->ref_local_us;
+    return clock->ref_offset_us + elapsed * clock->drift_ppb / 1000000000LL;
+}
+
+bool core_link_clock_to_local(const core_link_clock_t *clock, int64_t remote_us, int64_t *out_local_us)
+{
+    if (!clock->synced || !out_local_us) {
+        return false;
+    }
+    // The offset depends on the local instant we are solving for: one refinement step
+    // is enough, the residual is drift × (offset error), far below a microsecond.
+    int64_t guess = remote_us - clock->ref_offset_us;
+    *out_local_us = remote_us - core_link_clock_offset_at(clock, guess);
+    return true;
+}
+
+void core_link_clock_get(const core_link_clock_t *clock, int64_t now_local_us, core_link_clock_estimate_t *out)
+{
+    out->synced = clock->synced;
+    out->offset_us = core_link_clock_offset_at(clock, now_local_us);
+    out->drift_ppb = clock->drift_ppb;
+    out->min_rtt_us = clock->min_rtt_us;
+    out->samples = clock->used;
+}
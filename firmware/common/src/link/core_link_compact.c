@@ -0,0 +1,172 @@
+#include "link/core_link_compact.h"
+#include "link/core_link_fields.h"
+
+#include <math.h>
+#include <string.h>
+
+static int32_t quantize(float value, float scale, int32_t min, int32_t max)
+{
+    if (!isfinite(value)) {
+        return 0;
+    }
+    float scaled = value * scale;
+    if (scaled <= (float)min) {
+        return min;
+    }
+    if (scaled >= (float)max) {
+        return max;
+    }
+    return (int32_t)lroundf(scaled);
+}
+
+#define Q_I16(value, scale) quantize(value, scale, INT16_MIN, INT16_MAX)
+#define Q_U16(value, scale) quantize(value, scale, 0, UINT16_MAX)
+#define Q_U8(value, scale) quantize(value, scale, 0, UINT8_MAX)
+
+static size_t name_length(const char *name)
+{
+    size_t len = strnlen(name, CORE_LINK_NAME_MAX_LEN + 1);
+    return len > CORE_LINK_NAME_MAX_LEN ? CORE_LINK_NAME_MAX_LEN : len;
+}
+
+static inline uint8_t *put_u16(uint8_t *cursor, uint16_t value)
+{
+    cursor[0] = (uint8_t)value;
+    cursor[1] = (uint8_t)(value >> 8);
+    return cursor + 2;
+}
+
+static inline uint16_t get_u16(const uint8_t *raw)
+{
+    return (uint16_t)(raw[0] | (raw[1] << 8));
+}
+
+/* Expansions de CORE_LINK_SNAPSHOT_FIELDS (core_link_fields.h), une par représentation compacte. */
+
+#define NAME_SIZE_OF(bit, member, v1, compact, scale) NAME_SIZE_##compact(bit, member)
+#define NAME_SIZE_NAME(bit, member) \
+    +((mask & CORE_LINK_DELTA_FIELD_##bit) ? 1U + (snap ? name_length(snap->member) : 0U) : 0U)
+#define NAME_SIZE_I16(bit, member)
+#define NAME_SIZE_U16(bit, member)
+#define NAME_SIZE_U8(bit, member)
+#define NAME_SIZE_U32(bit, member)
+
+#define PUT_NAME(member, scale)                   \
+    {                                             \
+        size_t len = name_length(snap->member);   \
+        *cursor++ = (uint8_t)len;                 \
+        memcpy(cursor, snap->member, len);        \
+        cursor += len;                            \
+    }
+#define PUT_I16(member, scale) cursor = put_u16(cursor, (uint16_t)Q_I16(snap->member, scale));
+#define PUT_U16(member, scale) cursor = put_u16(cursor, (uint16_t)Q_U16(snap->member, scale));
+#define PUT_U8(member, scale) *cursor++ = (uint8_t)Q_U8(snap->member, scale);
+#define PUT_U32(member, scale)                            \
+    cursor = put_u16(cursor, (uint16_t)snap->member);     \
+    cursor = put_u16(cursor, (uint16_t)(snap->member >> 16));
+#define PUT_FIELD(bit, member, v1, compact, scale) \
+    if (mask & CORE_LINK_DELTA_FIELD_##bit) {      \
+        PUT_##compact(member, scale)               \
+    }
+
+// Names lead the bit order, so they are the only variable-length part and are
+// checked one by one; the fixed-size block after them is checked once.
+#define READ_NAME_FIELD(bit, member, v1, compact, scale) READ_NAME_##compact(bit, member)
+#define READ_NAME_NAME(bit, member)                                        \
+    if (mask & CORE_LINK_DELTA_FIELD_##bit) {                              \
+        if (pos >= length) {                                               \
+            return false;                                                  \
+        }                                                                  \
+        size_t len = payload[pos++];                                       \
+        if (len > CORE_LINK_NAME_MAX_LEN || len > length - pos) {          \
+            return false;                                                  \
+        }                                                                  \
+        memcpy(snap->member, payload + pos, len);                          \
+        snap->member[len] = '\0';                                          \
+        pos += len;                                                        \
+    }
+#define READ_NAME_I16(bit, member)
+#define READ_NAME_U16(bit, member)
+#define READ_NAME_U8(bit, member)
+#define READ_NAME_U32(bit, member)
+
+#define GET_NAME(member, scale)
+#define GET_I16(member, scale) snap->member = (float)(int16_t)get_u16(raw) / scale;
+#define GET_U16(member, scale) snap->member = (float)get_u16(raw) / scale;
+#define GET_U8(member, scale) snap->member = (float)raw[0] / scale;
+#define GET_U32(member, scale) snap->member = (uint32_t)get_u16(raw) | ((uint32_t)get_u16(raw + 2) << 16);
+#define GET_FIELD(bit, member, v1, compact, scale)     \
+    if (mask & CORE_LINK_DELTA_FIELD_##bit) {          \
+        GET_##compact(member, scale)                   \
+        raw += CORE_LINK_FIELD_COMPACT_SIZE_##compact; \
+    }
+
+#define CHANGED_NAME(member, scale) strncmp(snap->member, prev->member, CORE_LINK_NAME_MAX_LEN + 1) != 0
+#define CHANGED_I16(member, scale) Q_I16(snap->member, scale) != Q_I16(prev->member, scale)
+#define CHANGED_U16(member, scale) Q_U16(snap->member, scale) != Q_U16(prev->member, scale)
+#define CHANGED_U8(member, scale) Q_U8(snap->member, scale) != Q_U8(prev->member, scale)
+#define CHANGED_U32(member, scale) snap->member != prev->member
+#define DIFF_FIELD(bit, member, v1, compact, scale) \
+    if (CHANGED_##compact(member, scale)) {         \
+        mask |= CORE_LINK_DELTA_FIELD_##bit;        \
+    }
+
+size_t core_link_compact_fields_size(core_link_delta_field_mask_t mask, const core_link_terrarium_snapshot_t *snap)
+{
+    return core_link_fields_compact_fixed_size(mask) CORE_LINK_SNAPSHOT_FIELDS(NAME_SIZE_OF);
+}
+
+size_t core_link_compact_encode_fields(uint8_t *out, size_t capacity, core_link_delta_field_mask_t mask,
+                                       const core_link_terrarium_snapshot_t *snap)
+{
+    if (!out || !snap || core_link_compact_fields_size(mask, snap) > capacity) {
+        return 0;
+    }
+
+    uint8_t *cursor = out;
+    CORE_LINK_SNAPSHOT_FIELDS(PUT_FIELD)
+    if (mask & CORE_LINK_DELTA_FIELD_NAME_IDS) {
+        memcpy(cursor, snap->name_ids, 2);
+        cursor += 2;
+    }
+    return (size_t)(cursor - out);
+}
+
+bool core_link_compact_decode_fields(const uint8_t *payload, size_t length, size_t *offset,
+                                     core_link_delta_field_mask_t mask, core_link_terrarium_snapshot_t *snap)
+{
+    if (!payload || !offset || !snap || *offset > length) {
+        return false;
+    }
+
+    size_t pos = *offset;
+    CORE_LINK_SNAPSHOT_FIELDS(READ_NAME_FIELD)
+
+    size_t fixed = core_link_fields_compact_fixed_size(mask);
+    if (fixed > length - pos) {
+        return false;
+    }
+    const uint8_t *raw = payload + pos;
+    CORE_LINK_SNAPSHOT_FIELDS(GET_FIELD)
+    if (mask & CORE_LINK_DELTA_FIELD_NAME_IDS) {
+        memcpy(snap->name_ids, raw, 2);
+    }
+
+    *offset = pos + fixed;
+    return true;
+}
+
+core_link_delta_field_mask_t core_link_compact_diff_mask(const core_link_terrarium_snapshot_t *snap,
+                                                         const core_link_terrarium_snapshot_t *prev)
+{
+    if (!snap || !prev) {
+        return CORE_LINK_DELTA_FIELD_ALL;
+    }
+
+    core_link_delta_field_mask_t mask = 0;
+    CORE_LINK_SNAPSHOT_FIELDS(DIFF_FIELD)
+    if (memcmp(snap->name_ids, prev->name_ids, 2) != 0) {
+        mask |= CORE_LINK_DELTA_FIELD_NAME_IDS;
+    }
+    return mask;
+}
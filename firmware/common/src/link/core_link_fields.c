@@ -0,0 +1,85 @@
+#include "link/core_link_fields.h"
+
+#include <string.h>
+
+#define FIELD_BIT(bit, member, v1, compact, scale) | CORE_LINK_DELTA_FIELD_##bit
+
+_Static_assert((0 CORE_LINK_SNAPSHOT_FIELDS(FIELD_BIT)) == CORE_LINK_DELTA_FIELD_ALL,
+               "CORE_LINK_SNAPSHOT_FIELDS must cover CORE_LINK_DELTA_FIELD_ALL");
+_Static_assert(sizeof(core_link_snapshot_wire_t) == 1U + 2U * CORE_LINK_DELTA_STRING_BYTES + 11U * 4U,
+               "STATE_FULL v1 entry layout changed");
+
+// Each row expands to a fixed-size copy: the compiler sees constant sizes and
+// offsets, and the caller has already checked the whole span once.
+#define V1_PUT(bit, member, v1, compact, scale)                                 \
+    if (mask & CORE_LINK_DELTA_FIELD_##bit) {                                   \
+        memcpy(cursor, &snap->member, CORE_LINK_FIELD_V1_SIZE_##v1);            \
+        cursor += CORE_LINK_FIELD_V1_SIZE_##v1;                                 \
+    }
+
+#define V1_GET_NAME(member)                                                     \
+    memcpy(snap->member, cursor, CORE_LINK_DELTA_STRING_BYTES);                 \
+    snap->member[CORE_LINK_NAME_MAX_LEN] = '\0';
+#define V1_GET_F32(member) memcpy(&snap->member, cursor, sizeof(float));
+#define V1_GET_U32(member) memcpy(&snap->member, cursor, sizeof(uint32_t));
+#define V1_GET(bit, member, v1, compact, scale)                                 \
+    if (mask & CORE_LINK_DELTA_FIELD_##bit) {                                   \
+        V1_GET_##v1(member) cursor += CORE_LINK_FIELD_V1_SIZE_##v1;             \
+    }
+
+#define COPY_FIELD(bit, member, v1, compact, scale)                             \
+    if (mask & CORE_LINK_DELTA_FIELD_##bit) {                                   \
+        memcpy(&dst->member, &src->member, sizeof(dst->member));                \
+    }
+
+size_t core_link_fields_v1_encode(uint8_t *out, size_t capacity, core_link_delta_field_mask_t mask,
+                                  const core_link_terrarium_snapshot_t *snap)
+{
+    size_t size = core_link_fields_v1_size(mask);
+    if (!out || !snap || size > capacity) {
+        return 0;
+    }
+    uint8_t *cursor = out;
+    CORE_LINK_SNAPSHOT_FIELDS(V1_PUT)
+    return size;
+}
+
+bool core_link_fields_v1_decode(const uint8_t *payload, size_t length, size_t *offset,
+                                core_link_delta_field_mask_t mask, core_link_terrarium_snapshot_t *snap)
+{
+    if (!payload || !offset || !snap || *offset > length || core_link_fields_v1_size(mask) > length - *offset) {
+        return false;
+    }
+    const uint8_t *cursor = payload + *offset;
+    CORE_LINK_SNAPSHOT_FIELDS(V1_GET)
+    *offset = (size_t)(cursor - payload);
+    return true;
+}
+
+void core_link_fields_to_wire(core_link_snapshot_wire_t *wire, const core_link_terrarium_snapshot_t *snap)
+{
+    uint8_t *out = (uint8_t *)wire;
+    out[0] = snap->terrarium_id;
+    core_link_fields_v1_encode(out + 1, sizeof(*wire) - 1, CORE_LINK_DELTA_FIELD_ALL, snap);
+}
+
+void core_link_fields_from_wire(core_link_terrarium_snapshot_t *snap, const core_link_snapshot_wire_t *wire)
+{
+    size_t offset = 1;
+    snap->terrarium_id = wire->terrarium_id;
+    snap->name_ids[0] = CORE_LINK_NAME_ID_NONE;
+    snap->name_ids[1] = CORE_LINK_NAME_ID_NONE;
+    core_link_fields_v1_decode((const uint8_t *)wire, sizeof(*wire), &offset, CORE_LINK_DELTA_FIELD_ALL, snap);
+}
+
+void core_link_fields_copy(core_link_terrarium_snapshot_t *dst, const core_link_terrarium_snapshot_t *src,
+                           core_link_delta_field_mask_t mask)
+{
+    CORE_LINK_SNAPSHOT_FIELDS(COPY_FIELD)
+    if (mask & CORE_LINK_DELTA_FIELD_SCIENTIFIC_NAME) {
+        dst->name_ids[0] = src->name_ids[0];
+    }
+    if (mask & CORE_LINK_DELTA_FIELD_COMMON_NAME) {
+        dst->name_ids[1] = src->name_ids[1];
+    }
+}
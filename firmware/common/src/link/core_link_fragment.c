@@ -0,0 +1,107 @@
+#include "link/core_link_fragment.h"
+
+#include <string.h>
+
+size_t core_link_fragment_count(size_t length)
+{
+    size_t count = (length + CORE_LINK_FRAGMENT_DATA_MAX - 1U) / CORE_LINK_FRAGMENT_DATA_MAX;
+    if (count == 0) {
+        count = 1;
+    }
+    return count > UINT8_MAX ? 0 : count;
+}
+
+size_t core_link_fragment_build(uint8_t *out, size_t out_size, uint8_t inner_type, uint8_t transfer_id,
+                                const uint8_t *data, size_t length, uint8_t index)
+{
+    size_t count = core_link_fragment_count(length);
+    if (!out || (!data && length > 0) || count == 0 || index >= count) {
+        return 0;
+    }
+
+    size_t offset = (size_t)index * CORE_LINK_FRAGMENT_DATA_MAX;
+    size_t chunk = length - offset;
+    if (chunk > CORE_LINK_FRAGMENT_DATA_MAX) {
+        chunk = CORE_LINK_FRAGMENT_DATA_MAX;
+    }
+    if (CORE_LINK_FRAGMENT_HEADER_SIZE + chunk > out_size) {
+        return 0;
+    }
+
+    out[0] = inner_type;
+    out[1] = transfer_id;
+    out[2] = index;
+    out[3] = (uint8_t)count;
+    if (chunk > 0) {
+        memcpy(out + CORE_LINK_FRAGMENT_HEADER_SIZE, data + offset, chunk);
+    }
+    return CORE_LINK_FRAGMENT_HEADER_SIZE + chunk;
+}
+
+void core_link_reassembly_init(core_link_reassembly_t *reassembly, uint8_t *buffer, size_t capacity)
+{
+    memset(reassembly, 0, sizeof(*reassembly));
+    reassembly->buffer = buffer;
+    reassembly->capacity = capacity;
+}
+
+void core_link_reassembly_reset(core_link_reassembly_t *reassembly)
+{
+    reassembly->active = false;
+    reassembly->length = 0;
+    reassembly->next_index = 0;
+    reassembly->count = 0;
+}
+
+core_link_reassembly_status_t core_link_reassembly_push(core_link_reassembly_t *reassembly, const uint8_t *payload,
+                                                        size_t length)
+{
+    if (!reassembly || !payload || length < CORE_LINK_FRAGMENT_HEADER_SIZE) {
+        return CORE_LINK_REASSEMBLY_ERROR;
+    }
+
+    core_link_fragment_header_t header = {
+        .inner_type = payload[0],
+        .transfer_id = payload[1],
+        .index = payload[2],
+        .count = payload[3],
+    };
+    const uint8_t *data = payload + CORE_LINK_FRAGMENT_HEADER_SIZE;
+    size_t data_len = length - CORE_LINK_FRAGMENT_HEADER_SIZE;
+
+    if (header.count == 0 || header.index >= header.count || header.inner_type == CORE_LINK_MSG_STATE_FRAGMENT) {
+        core_link_reassembly_reset(reassembly);
+        return CORE_LINK_REASSEMBLY_ERROR;
+    }
+
+    if (header.index == 0) {
+        // A first fragment always starts over, even if a transfer was pending.
+        core_link_reassembly_reset(reassembly);
+        reassembly->active = true;
+        reassembly->inner_type = header.inner_type;
+        reassembly->transfer_id = header.transfer_id;
+        reassembly->count = header.count;
+    } else if (!reassembly->active || header.transfer_id != reassembly->transfer_id ||
+               header.inner_type != reassembly->inner_type || header.count != reassembly->count ||
+               header.index != reassembly->next_index) {
+        core_link_reassembly_reset(reassembly);
+        return CORE_LINK_REASSEMBLY_ERROR;
+    }
+
+    // Every fragment but the last one is full, so a short one ends the transfer early.
+    bool last = header.index + 1U == header.count;
+    if ((!last && data_len != CORE_LINK_FRAGMENT_DATA_MAX) || reassembly->length + data_len > reassembly->capacity) {
+        core_link_reassembly_reset(reassembly);
+        return CORE_LINK_REASSEMBLY_ERROR;
+    }
+
+    memcpy(reassembly->buffer + reassembly->length, data, data_len);
+    reassembly->length += data_len;
+    reassembly->next_index = (uint8_t)(header.index + 1U);
+    if (!last) {
+        return CORE_LINK_REASSEMBLY_PENDING;
+    }
+
+    reassembly->active = false;
+    return CORE_LINK_REASSEMBLY_COMPLETE;
+}
@@ -0,0 +1,190 @@
+#include "link/core_link_history.h"
+
+#include <math.h>
+#include <string.h>
+
+typedef struct {
+    core_link_delta_field_mask_t field;
+    float scale;
+    bool is_signed;
+} history_metric_t;
+
+// Ascending field bits, as on the wire.
+static const history_metric_t k_metrics[CORE_LINK_HISTORY_METRIC_COUNT] = {
+    {CORE_LINK_DELTA_FIELD_TEMP_DAY, CORE_LINK_Q_TEMP_SCALE, true},
+    {CORE_LINK_DELTA_FIELD_TEMP_NIGHT, CORE_LINK_Q_TEMP_SCALE, true},
+    {CORE_LINK_DELTA_FIELD_HUMIDITY_DAY, CORE_LINK_Q_PCT_SCALE, false},
+    {CORE_LINK_DELTA_FIELD_HUMIDITY_NIGHT, CORE_LINK_Q_PCT_SCALE, false},
+    {CORE_LINK_DELTA_FIELD_LUX_DAY, CORE_LINK_Q_LUX_SCALE, false},
+    {CORE_LINK_DELTA_FIELD_LUX_NIGHT, CORE_LINK_Q_LUX_SCALE, false},
+    {CORE_LINK_DELTA_FIELD_HYDRATION, CORE_LINK_Q_PCT_SCALE, false},
+    {CORE_LINK_DELTA_FIELD_STRESS, CORE_LINK_Q_PCT_SCALE, false},
+    {CORE_LINK_DELTA_FIELD_HEALTH, CORE_LINK_Q_PCT_SCALE, false},
+    {CORE_LINK_DELTA_FIELD_ACTIVITY, CORE_LINK_Q_ACTIVITY_SCALE, false},
+};
+
+static const uint32_t k_tier_seconds[CORE_LINK_HISTORY_TIER_COUNT] = {60U, 15U * 60U, 6U * 3600U};
+
+static inline uint8_t *put_u16(uint8_t *cursor, uint16_t value)
+{
+    cursor[0] = (uint8_t)value;
+    cursor[1] = (uint8_t)(value >> 8);
+    return cursor + 2;
+}
+
+static inline uint16_t get_u16(const uint8_t *raw)
+{
+    return (uint16_t)(raw[0] | (raw[1] << 8));
+}
+
+static inline void put_u32(uint8_t *out, uint32_t value)
+{
+    for (size_t i = 0; i < 4; ++i) {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static inline uint32_t get_u32(const uint8_t *in)
+{
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+uint32_t core_link_history_tier_seconds(uint8_t tier)
+{
+    return tier < CORE_LINK_HISTORY_TIER_COUNT ? k_tier_seconds[tier] : 0;
+}
+
+core_link_delta_field_mask_t core_link_history_metric_field(size_t metric)
+{
+    return metric < CORE_LINK_HISTORY_METRIC_COUNT ? k_metrics[metric].field : 0;
+}
+
+uint16_t core_link_history_quantize(size_t metric, float value)
+{
+    const history_metric_t *m = &k_metrics[metric];
+    if (!isfinite(value)) {
+        return 0;
+    }
+    float scaled = value * m->scale;
+    float lo = m->is_signed ? (float)INT16_MIN : 0.0f;
+    float hi = m->is_signed ? (float)INT16_MAX : (float)UINT16_MAX;
+    if (scaled <= lo) {
+        return (uint16_t)(int32_t)lo;
+    }
+    if (scaled >= hi) {
+        return (uint16_t)(int32_t)hi;
+    }
+    return (uint16_t)(int32_t)lroundf(scaled);
+}
+
+float core_link_history_value(size_t metric, uint16_t raw)
+{
+    const history_metric_t *m = &k_metrics[metric];
+    return (m->is_signed ? (float)(int16_t)raw : (float)raw) / m->scale;
+}
+
+size_t core_link_history_bucket_size(core_link_delta_field_mask_t field_mask)
+{
+    size_t fields = 0;
+    for (size_t m = 0; m < CORE_LINK_HISTORY_METRIC_COUNT; ++m) {
+        fields += (field_mask & k_metrics[m].field) != 0;
+    }
+    return 2U + fields * 6U;
+}
+
+size_t core_link_history_request_encode(const core_link_history_request_t *request, uint8_t *out, size_t capacity)
+{
+    if (!request || !out || capacity < CORE_LINK_HISTORY_REQUEST_SIZE) {
+        return 0;
+    }
+    out[0] = request->terrarium_id;
+    out[1] = request->tier;
+    put_u16(&out[2], request->field_mask);
+    put_u32(&out[4], request->before_epoch);
+    out[8] = request->max_buckets;
+    return CORE_LINK_HISTORY_REQUEST_SIZE;
+}
+
+bool core_link_history_request_decode(const uint8_t *payload, size_t length, core_link_history_request_t *request)
+{
+    if (!payload || !request || length < CORE_LINK_HISTORY_REQUEST_SIZE) {
+        return false;
+    }
+    request->terrarium_id = payload[0];
+    request->tier = payload[1];
+    request->field_mask = get_u16(&payload[2]) & CORE_LINK_HISTORY_FIELDS;
+    request->before_epoch = get_u32(&payload[4]);
+    request->max_buckets = payload[8];
+    return true;
+}
+
+size_t core_link_history_chunk_encode_header(const core_link_history_chunk_t *chunk, uint8_t *out, size_t capacity)
+{
+    if (!chunk || !out || capacity < CORE_LINK_HISTORY_CHUNK_HEADER_SIZE) {
+        return 0;
+    }
+    out[0] = chunk->terrarium_id;
+    out[1] = chunk->tier;
+    out[2] = chunk->status;
+    put_u16(&out[3], chunk->field_mask);
+    put_u32(&out[5], chunk->end_epoch);
+    out[9] = chunk->count;
+    out[10] = chunk->flags;
+    return CORE_LINK_HISTORY_CHUNK_HEADER_SIZE;
+}
+
+size_t core_link_history_bucket_encode(core_link_delta_field_mask_t field_mask, const core_link_history_bucket_t *bucket,
+                                       uint8_t *out, size_t capacity)
+{
+    if (!bucket || !out || capacity < core_link_history_bucket_size(field_mask)) {
+        return 0;
+    }
+    uint8_t *cursor = put_u16(out, bucket->samples);
+    for (size_t m = 0; m < CORE_LINK_HISTORY_METRIC_COUNT; ++m) {
+        if (field_mask & k_metrics[m].field) {
+            cursor = put_u16(cursor, bucket->min[m]);
+            cursor = put_u16(cursor, bucket->max[m]);
+            cursor = put_u16(cursor, bucket->mean[m]);
+        }
+    }
+    return (size_t)(cursor - out);
+}
+
+bool core_link_history_chunk_decode(const uint8_t *payload, size_t length, core_link_history_chunk_t *chunk)
+{
+    if (!payload || !chunk || length < CORE_LINK_HISTORY_CHUNK_HEADER_SIZE) {
+        return false;
+    }
+    core_link_history_chunk_t parsed = {
+        .terrarium_id = payload[0],
+        .tier = payload[1],
+        .status = payload[2],
+        .field_mask = get_u16(&payload[3]) & CORE_LINK_HISTORY_FIELDS,
+        .end_epoch = get_u32(&payload[5]),
+        .count = payload[9],
+        .flags = payload[10],
+        .data = &payload[CORE_LINK_HISTORY_CHUNK_HEADER_SIZE],
+    };
+    if (length - CORE_LINK_HISTORY_CHUNK_HEADER_SIZE < parsed.count * core_link_history_bucket_size(parsed.field_mask)) {
+        return false;
+    }
+    *chunk = parsed;
+    return true;
+}
+
+void core_link_history_chunk_bucket(const core_link_history_chunk_t *chunk, size_t index,
+                                    core_link_history_bucket_t *bucket)
+{
+    memset(bucket, 0, sizeof(*bucket));
+    const uint8_t *cursor = chunk->data + index * core_link_history_bucket_size(chunk->field_mask);
+    bucket->samples = get_u16(cursor);
+    cursor += 2;
+    for (size_t m = 0; m < CORE_LINK_HISTORY_METRIC_COUNT; ++m) {
+        if (chunk->field_mask & k_metrics[m].field) {
+            bucket->min[m] = get_u16(cursor);
+            bucket->max[m] = get_u16(cursor + 2);
+            bucket->mean[m] = get_u16(cursor + 4);
+            cursor += 6;
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#include "link/core_link_name_table.h"
+
+#include <string.h>
+
+#define NAME_TABLE_HEADER_SIZE 3U
+
+static uint32_t name_hash(const char *name, size_t len)
+{
+    // FNV-1a: cheap enough to run on every interned name of every publication.
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static size_t name_length(const char *name)
+{
+    return strnlen(name, CORE_LINK_NAME_MAX_LEN);
+}
+
+static void store_name(core_link_name_table_t *table, uint8_t id, const char *name, size_t len)
+{
+    memcpy(table->names[id], name, len);
+    table->names[id][len] = '\0';
+    table->hashes[id] = name_hash(name, len);
+    table->present[id] = true;
+}
+
+void core_link_name_table_reset(core_link_name_table_t *table, uint8_t generation)
+{
+    memset(table->present, 0, sizeof(table->present));
+    table->count = 0;
+    table->generation = generation;
+}
+
+uint8_t core_link_name_table_intern(core_link_name_table_t *table, const char *name)
+{
+    if (!table || !name) {
+        return CORE_LINK_NAME_ID_NONE;
+    }
+
+    size_t len = name_length(name);
+    uint32_t hash = name_hash(name, len);
+    for (uint8_t id = 0; id < table->count; ++id) {
+        if (table->hashes[id] == hash && strncmp(table->names[id], name, len) == 0 && table->names[id][len] == '\0') {
+            return id;
+        }
+    }
+
+    if (table->count >= CORE_LINK_NAME_TABLE_MAX) {
+        return CORE_LINK_NAME_ID_NONE;
+    }
+    uint8_t id = table->count++;
+    store_name(table, id, name, len);
+    return id;
+}
+
+const char *core_link_name_table_lookup(const core_link_name_table_t *table, uint8_t id)
+{
+    if (!table || id >= CORE_LINK_NAME_TABLE_MAX || !table->present[id]) {
+        return NULL;
+    }
+    return table->names[id];
+}
+
+size_t core_link_name_table_encode(const core_link_name_table_t *table, uint8_t *next_id, bool reset, uint8_t *out,
+                                   size_t capacity)
+{
+    if (!table || !next_id || !out || capacity < NAME_TABLE_HEADER_SIZE) {
+        return 0;
+    }
+
+    size_t offset = NAME_TABLE_HEADER_SIZE;
+    uint8_t written = 0;
+    uint8_t id = *next_id;
+    while (id < table->count) {
+        size_t len = name_length(table->names[id]);
+        if (offset + 2U + len > capacity) {
+            break;
+        }
+        out[offset++] = id;
+        out[offset++] = (uint8_t)len;
+        memcpy(out + offset, table->names[id], len);
+        offset += len;
+        ++written;
+        ++id;
+    }
+
+    out[0] = table->generation;
+    out[1] = reset ? CORE_LINK_NAME_TABLE_FLAG_RESET : 0;
+    out[2] = written;
+    *next_id = id;
+    return offset;
+}
+
+bool core_link_name_table_apply(core_link_name_table_t *table, const uint8_t *payload, size_t length, bool *out_reset)
+{
+    if (out_reset) {
+        *out_reset = false;
+    }
+    if (!table || !payload || length < NAME_TABLE_HEADER_SIZE) {
+        return false;
+    }
+
+    uint8_t generation = payload[0];
+    bool reset = (payload[1] & CORE_LINK_NAME_TABLE_FLAG_RESET) != 0;
+    uint8_t count = payload[2];
+    if (!reset && generation != table->generation) {
+        return false;
+    }
+
+    // Validate the whole payload first so a truncated one leaves the table untouched.
+    size_t offset = NAME_TABLE_HEADER_SIZE;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (offset + 2U > length) {
+            return false;
+        }
+        uint8_t id = payload[offset];
+        size_t len = payload[offset + 1];
+        if (id >= CORE_LINK_NAME_TABLE_MAX || len > CORE_LINK_NAME_MAX_LEN || offset + 2U + len > length) {
+            return false;
+        }
+        offset += 2U + len;
+    }
+
+    if (reset) {
+        core_link_name_table_reset(table, generation);
+        if (out_reset) {
+            *out_reset = true;
+        }
+    }
+    offset = NAME_TABLE_HEADER_SIZE;
+    for (uint8_t i = 0; i < count; ++i) {
+        uint8_t id = payload[offset];
+        size_t len = payload[offset + 1];
+        store_name(table, id, (const char *)payload + offset + 2U, len);
+        if (id >= table->count) {
+            table->count = (uint8_t)(id + 1U);
+        }
+        offset += 2U + len;
+    }
+    return true;
+}
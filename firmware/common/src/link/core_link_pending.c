@@ -0,0 +1,119 @@
+#include "link/core_link_pending.h"
+
+#include <string.h>
+
+void core_link_pending_init(core_link_pending_t *table)
+{
+    memset(table, 0, sizeof(*table));
+    table->next_id = 1;
+}
+
+static bool id_in_use(const core_link_pending_t *table, uint16_t request_id)
+{
+    for (size_t i = 0; i < CORE_LINK_PENDING_MAX; ++i) {
+        if (table->entries[i].used && table->entries[i].request_id == request_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint16_t core_link_pending_add(core_link_pending_t *table, uint8_t opcode, uint32_t now, uint32_t timeout,
+                               core_link_pending_cb_t cb, void *ctx)
+{
+    core_link_pending_entry_t *slot = NULL;
+    for (size_t i = 0; i < CORE_LINK_PENDING_MAX; ++i) {
+        if (!table->entries[i].used) {
+            slot = &table->entries[i];
+            break;
+        }
+    }
+    if (!slot) {
+        return CORE_LINK_REQUEST_ID_NONE;
+    }
+
+    // IDs wrap; skip the reserved value and any ID a long-running request still holds.
+    uint16_t id = table->next_id;
+    while (id == CORE_LINK_REQUEST_ID_NONE || id_in_use(table, id)) {
+        ++id;
+    }
+    table->next_id = (uint16_t)(id + 1);
+
+    *slot = (core_link_pending_entry_t){
+        .used = true,
+        .opcode = opcode,
+        .request_id = id,
+        .serial = table->next_serial++,
+        .deadline = now + timeout,
+        .cb = cb,
+        .ctx = ctx,
+    };
+    return id;
+}
+
+static bool take(core_link_pending_entry_t *entry, core_link_pending_entry_t *out_entry)
+{
+    if (out_entry) {
+        *out_entry = *entry;
+    }
+    entry->used = false;
+    return true;
+}
+
+bool core_link_pending_take(core_link_pending_t *table, uint16_t request_id, core_link_pending_entry_t *out_entry)
+{
+    if (request_id == CORE_LINK_REQUEST_ID_NONE) {
+        return false;
+    }
+    for (size_t i = 0; i < CORE_LINK_PENDING_MAX; ++i) {
+        if (table->entries[i].used && table->entries[i].request_id == request_id) {
+            return take(&table->entries[i], out_entry);
+        }
+    }
+    return false;
+}
+
+bool core_link_pending_take_opcode(core_link_pending_t *table, uint8_t opcode, core_link_pending_entry_t *out_entry)
+{
+    core_link_pending_entry_t *oldest = NULL;
+    for (size_t i = 0; i < CORE_LINK_PENDING_MAX; ++i) {
+        core_link_pending_entry_t *entry = &table->entries[i];
+        if (!entry->used || entry->opcode != opcode) {
+            continue;
+        }
+        if (!oldest || (int32_t)(entry->serial - oldest->serial) < 0) {
+            oldest = entry;
+        }
+    }
+    return oldest ? take(oldest, out_entry) : false;
+}
+
+bool core_link_pending_take_expired(core_link_pending_t *table, uint32_t now, core_link_pending_entry_t *out_entry)
+{
+    for (size_t i = 0; i < CORE_LINK_PENDING_MAX; ++i) {
+        core_link_pending_entry_t *entry = &table->entries[i];
+        if (entry->used && (int32_t)(now - entry->deadline) >= 0) {
+            return take(entry, out_entry);
+        }
+    }
+    return false;
+}
+
+bool core_link_pending_take_any(core_link_pending_t *table, core_link_pending_entry_t *out_entry)
+{
+    for (size_t i = 0; i < CORE_LINK_PENDING_MAX; ++i) {
+        if (table->entries[i].used) {
+            return take(&table->entries[i], out_entry);
+        }
+    }
+    return false;
+}
+
+size_t core_link_pending_count(const core_link_pending_t *table)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < CORE_LINK_PENDING_MAX; ++i) {
+        count += table->entries[i].used ? 1U : 0U;
+    }
+    return count;
+}
@@ -0,0 +1,143 @@
+#include "link/core_link_publish.h"
+
+#include <math.h>
+#include <string.h>
+
+typedef struct {
+    size_t offset;
+    size_t deadband_offset;
+} publish_field_t;
+
+#define SNAP_OFFSET(member) offsetof(core_link_terrarium_snapshot_t, member)
+#define BAND_OFFSET(member) offsetof(core_link_publish_deadbands_t, member)
+
+static const publish_field_t s_fields[] = {
+    {SNAP_OFFSET(temp_day_c), BAND_OFFSET(temp_c)},
+    {SNAP_OFFSET(temp_night_c), BAND_OFFSET(temp_c)},
+    {SNAP_OFFSET(humidity_day_pct), BAND_OFFSET(humidity_pct)},
+    {SNAP_OFFSET(humidity_night_pct), BAND_OFFSET(humidity_pct)},
+    {SNAP_OFFSET(lux_day), BAND_OFFSET(lux)},
+    {SNAP_OFFSET(lux_night), BAND_OFFSET(lux)},
+    {SNAP_OFFSET(hydration_pct), BAND_OFFSET(vitals_pct)},
+    {SNAP_OFFSET(stress_pct), BAND_OFFSET(vitals_pct)},
+    {SNAP_OFFSET(health_pct), BAND_OFFSET(vitals_pct)},
+    {SNAP_OFFSET(activity_score), BAND_OFFSET(activity)},
+};
+
+#define PUBLISH_FIELD_COUNT (sizeof(s_fields) / sizeof(s_fields[0]))
+
+static float read_float(const void *base, size_t offset)
+{
+    float value;
+    memcpy(&value, (const uint8_t *)base + offset, sizeof(value));
+    return value;
+}
+
+static bool exceeds_deadband(const core_link_publish_deadbands_t *bands, const core_link_terrarium_snapshot_t *snap,
+                             const core_link_terrarium_snapshot_t *prev)
+{
+    for (size_t i = 0; i < PUBLISH_FIELD_COUNT; ++i) {
+        float a = read_float(snap, s_fields[i].offset);
+        float b = read_float(prev, s_fields[i].offset);
+        float band = read_float(bands, s_fields[i].deadband_offset);
+        // A value turning non-finite (or back) is a change whatever its magnitude.
+        if (!isfinite(a) != !isfinite(b) || fabsf(a - b) >= band) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool structure_changed(const core_link_terrarium_snapshot_t *snap, const core_link_terrarium_snapshot_t *prev)
+{
+    return snap->last_feeding_timestamp != prev->last_feeding_timestamp ||
+           strncmp(snap->scientific_name, prev->scientific_name, sizeof(snap->scientific_name)) != 0 ||
+           strncmp(snap->common_name, prev->common_name, sizeof(snap->common_name)) != 0;
+}
+
+static bool crossed_below(float value, float previous, float threshold)
+{
+    return threshold > 0.0f && ((value < threshold) != (previous < threshold));
+}
+
+static bool crossed_above(float value, float previous, float threshold)
+{
+    return threshold > 0.0f && ((value > threshold) != (previous > threshold));
+}
+
+static bool alert_crossed(const core_link_publish_policy_t *policy, const core_link_terrarium_snapshot_t *snap,
+                          const core_link_terrarium_snapshot_t *prev)
+{
+    return crossed_below(snap->health_pct, prev->health_pct, policy->alert_health_below_pct) ||
+           crossed_below(snap->hydration_pct, prev->hydration_pct, policy->alert_hydration_below_pct) ||
+           crossed_above(snap->stress_pct, prev->stress_pct, policy->alert_stress_above_pct);
+}
+
+static const core_link_terrarium_snapshot_t *find_reference(const core_link_state_frame_t *reference, uint8_t index,
+                                                            uint8_t terrarium_id)
+{
+    // Slots keep their order between publications: try the same index first.
+    if (index < reference->terrarium_count && reference->terrariums[index].terrarium_id == terrarium_id) {
+        return &reference->terrariums[index];
+    }
+    for (uint8_t i = 0; i < reference->terrarium_count; ++i) {
+        if (reference->terrariums[i].terrarium_id == terrarium_id) {
+            return &reference->terrariums[i];
+        }
+    }
+    return NULL;
+}
+
+void core_link_publish_init(core_link_publish_scheduler_t *sched, const core_link_publish_policy_t *policy,
+                            core_link_state_frame_t *reference, uint8_t capacity)
+{
+    memset(sched, 0, sizeof(*sched));
+    sched->policy = *policy;
+    if (sched->policy.max_interval_ms < sched->policy.min_interval_ms) {
+        sched->policy.max_interval_ms = sched->policy.min_interval_ms;
+    }
+    sched->reference = reference;
+    core_link_state_frame_init(reference, capacity);
+}
+
+core_link_publish_reason_t core_link_publish_evaluate(const core_link_publish_scheduler_t *sched,
+                                                      const core_link_state_frame_t *frame, uint32_t now_ms)
+{
+    if (!sched->reference_valid) {
+        return CORE_LINK_PUBLISH_FORCED;
+    }
+
+    const core_link_state_frame_t *reference = sched->reference;
+    uint32_t elapsed = now_ms - sched->last_publish_ms;
+    bool significant = frame->terrarium_count != reference->terrarium_count;
+
+    for (uint8_t i = 0; i < frame->terrarium_count; ++i) {
+        const core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
+        const core_link_terrarium_snapshot_t *prev = find_reference(reference, i, snap->terrarium_id);
+        if (!prev) {
+            significant = true;
+            continue;
+        }
+        if (alert_crossed(&sched->policy, snap, prev)) {
+            return CORE_LINK_PUBLISH_ALERT;
+        }
+        if (!significant) {
+            significant = structure_changed(snap, prev) || exceeds_deadband(&sched->policy.deadband, snap, prev);
+        }
+    }
+
+    if (significant && elapsed >= sched->policy.min_interval_ms) {
+        return CORE_LINK_PUBLISH_CHANGE;
+    }
+    if (elapsed >= sched->policy.max_interval_ms) {
+        return CORE_LINK_PUBLISH_HEARTBEAT;
+    }
+    return CORE_LINK_PUBLISH_NONE;
+}
+
+void core_link_publish_mark_published(core_link_publish_scheduler_t *sched, const core_link_state_frame_t *frame,
+                                      uint32_t now_ms)
+{
+    sched->reference_valid = core_link_state_frame_copy(sched->reference, frame);
+    sched->last_publish_ms = now_ms;
+}
@@ -0,0 +1,208 @@
+#include "link/core_link_stats.h"
+
+#include <string.h>
+
+#define STATS_HEADER_SIZE 2U
+
+static void put_le32(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_le32(const uint8_t *in)
+{
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+static uint32_t load(const atomic_uint_least32_t *value)
+{
+    return (uint32_t)atomic_load_explicit(value, memory_order_relaxed);
+}
+
+void core_link_stats_reset(core_link_stats_t *stats)
+{
+    for (size_t i = 0; i < CORE_LINK_STAT_COUNT; ++i) {
+        atomic_store_explicit(&stats->counters[i], 0, memory_order_relaxed);
+    }
+    for (size_t i = 0; i < CORE_LINK_RTT_BUCKETS; ++i) {
+        atomic_store_explicit(&stats->rtt_buckets[i], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&stats->rtt_last_us, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->rtt_max_us, 0, memory_order_relaxed);
+    for (size_t i = 0; i < CORE_LINK_RTT_BUCKETS; ++i) {
+        atomic_store_explicit(&stats->latency_buckets[i], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&stats->latency_last_us, 0, memory_order_relaxed);
+    atomic_store_explicit(&stats->latency_max_us, 0, memory_order_relaxed);
+}
+
+size_t core_link_stats_rtt_bucket(uint32_t rtt_us)
+{
+    if (rtt_us < 2) {
+        return 0;
+    }
+    size_t bucket = 31U - (size_t)__builtin_clz(rtt_us);
+    return bucket < CORE_LINK_RTT_BUCKETS ? bucket : CORE_LINK_RTT_BUCKETS - 1;
+}
+
+static void histogram_record(atomic_uint_least32_t *buckets, atomic_uint_least32_t *last, atomic_uint_least32_t *max_us,
+                             uint32_t value_us)
+{
+    atomic_fetch_add_explicit(&buckets[core_link_stats_rtt_bucket(value_us)], 1, memory_order_relaxed);
+    atomic_store_explicit(last, value_us, memory_order_relaxed);
+    uint_least32_t max = atomic_load_explicit(max_us, memory_order_relaxed);
+    while (value_us > max &&
+           !atomic_compare_exchange_weak_explicit(max_us, &max, value_us, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+void core_link_stats_record_rtt(core_link_stats_t *stats, uint32_t rtt_us)
+{
+    histogram_record(stats->rtt_buckets, &stats->rtt_last_us, &stats->rtt_max_us, rtt_us);
+}
+
+void core_link_stats_record_latency(core_link_stats_t *stats, uint32_t latency_us)
+{
+    histogram_record(stats->latency_buckets, &stats->latency_last_us, &stats->latency_max_us, latency_us);
+}
+
+void core_link_stats_snapshot(const core_link_stats_t *stats, uint32_t uptime_ms, core_link_stats_snapshot_t *out)
+{
+    out->uptime_ms = uptime_ms;
+    for (size_t i = 0; i < CORE_LINK_STAT_COUNT; ++i) {
+        out->counters[i] = load(&stats->counters[i]);
+    }
+    for (size_t i = 0; i < CORE_LINK_RTT_BUCKETS; ++i) {
+        out->rtt_buckets[i] = load(&stats->rtt_buckets[i]);
+    }
+    out->rtt_last_us = load(&stats->rtt_last_us);
+    out->rtt_max_us = load(&stats->rtt_max_us);
+    for (size_t i = 0; i < CORE_LINK_RTT_BUCKETS; ++i) {
+        out->latency_buckets[i] = load(&stats->latency_buckets[i]);
+    }
+    out->latency_last_us = load(&stats->latency_last_us);
+    out->latency_max_us = load(&stats->latency_max_us);
+}
+
+static uint32_t histogram_samples(const uint32_t *buckets)
+{
+    uint32_t total = 0;
+    for (size_t i = 0; i < CORE_LINK_RTT_BUCKETS; ++i) {
+        total += buckets[i];
+    }
+    return total;
+}
+
+static uint32_t histogram_percentile(const uint32_t *buckets, uint32_t max_us, unsigned percent)
+{
+    uint32_t total = histogram_samples(buckets);
+    if (total == 0) {
+        return 0;
+    }
+    if (percent > 100) {
+        percent = 100;
+    }
+    // Rank of the sample at `percent`, rounded up so p100 lands on the last sample.
+    uint64_t rank = ((uint64_t)total * percent + 99U) / 100U;
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < CORE_LINK_RTT_BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // Never report more than the worst value actually seen (the last bucket is open-ended).
+            uint32_t bound = i + 1 < CORE_LINK_RTT_BUCKETS ? (1U << (i + 1)) : UINT32_MAX;
+            return (max_us != 0 && max_us < bound) ? max_us : bound;
+        }
+    }
+    return max_us;
+}
+
+uint32_t core_link_stats_rtt_samples(const core_link_stats_snapshot_t *snapshot)
+{
+    return histogram_samples(snapshot->rtt_buckets);
+}
+
+uint32_t core_link_stats_rtt_percentile_us(const core_link_stats_snapshot_t *snapshot, unsigned percent)
+{
+    return histogram_percentile(snapshot->rtt_buckets, snapshot->rtt_max_us, percent);
+}
+
+uint32_t core_link_stats_latency_samples(const core_link_stats_snapshot_t *snapshot)
+{
+    return histogram_samples(snapshot->latency_buckets);
+}
+
+uint32_t core_link_stats_latency_percentile_us(const core_link_stats_snapshot_t *snapshot, unsigned percent)
+{
+    return histogram_percentile(snapshot->latency_buckets, snapshot->latency_max_us, percent);
+}
+
+uint32_t core_link_stats_rate(const core_link_stats_snapshot_t *prev, const core_link_stats_snapshot_t *cur,
+                              core_link_stat_id_t id)
+{
+    uint32_t elapsed_ms = cur->uptime_ms - prev->uptime_ms;
+    if (elapsed_ms == 0 || elapsed_ms > INT32_MAX) {
+        return 0;
+    }
+    // Unsigned difference: counters may wrap between the two snapshots.
+    uint32_t delta = cur->counters[id] - prev->counters[id];
+    return (uint32_t)(((uint64_t)delta * 1000U) / elapsed_ms);
+}
+
+size_t core_link_stats_encode(const core_link_stats_snapshot_t *snapshot, uint8_t *out, size_t capacity)
+{
+    if (capacity < CORE_LINK_STATS_PAYLOAD_SIZE) {
+        return 0;
+    }
+    out[0] = CORE_LINK_STAT_COUNT;
+    out[1] = CORE_LINK_RTT_BUCKETS;
+    uint8_t *cursor = out + STATS_HEADER_SIZE;
+    put_le32(cursor, snapshot->uptime_ms);
+    put_le32(cursor + 4, snapshot->rtt_last_us);
+    put_le32(cursor + 8, snapshot->rtt_max_us);
+    cursor += 12;
+    for (size_t i = 0; i < CORE_LINK_STAT_COUNT; ++i, cursor += 4) {
+        put_le32(cursor, snapshot->counters[i]);
+    }
+    for (size_t i = 0; i < CORE_LINK_RTT_BUCKETS; ++i, cursor += 4) {
+        put_le32(cursor, snapshot->rtt_buckets[i]);
+    }
+    return (size_t)(cursor - out);
+}
+
+bool core_link_stats_decode(const uint8_t *payload, size_t length, core_link_stats_snapshot_t *out)
+{
+    if (!payload || length < STATS_HEADER_SIZE + 12U) {
+        return false;
+    }
+    size_t counters = payload[0];
+    size_t buckets = payload[1];
+    if (length < STATS_HEADER_SIZE + 4U * (3U + counters + buckets)) {
+        return false;
+    }
+    memset(out, 0, sizeof(*out));
+    const uint8_t *cursor = payload + STATS_HEADER_SIZE;
+    out->uptime_ms = get_le32(cursor);
+    out->rtt_last_us = get_le32(cursor + 4);
+    out->rtt_max_us = get_le32(cursor + 8);
+    cursor += 12;
+    for (size_t i = 0; i < counters; ++i, cursor += 4) {
+        if (i < CORE_LINK_STAT_COUNT) {
+            out->counters[i] = get_le32(cursor);
+        }
+    }
+    for (size_t i = 0; i < buckets; ++i, cursor += 4) {
+        if (i < CORE_LINK_RTT_BUCKETS) {
+            out->rtt_buckets[i] = get_le32(cursor);
+        } else {
+            // A peer with a finer histogram: fold its tail into our open-ended bucket.
+            out->rtt_buckets[CORE_LINK_RTT_BUCKETS - 1] += get_le32(cursor);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,324 @@
+#include "link/core_link_stream.h"
+
+#include <string.h>
+
+/* CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), one table lookup per byte. */
+static const uint16_t s_crc16_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7, 0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD,
+    0xE1CE, 0xF1EF, 0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6, 0x9339, 0x8318, 0xB37B, 0xA35A,
+    0xD3BD, 0xC39C, 0xF3FF, 0xE3DE, 0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485, 0xA56A, 0xB54B,
+    0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D, 0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC, 0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861,
+    0x2802, 0x3823, 0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B, 0x5AF5, 0x4AD4, 0x7AB7, 0x6A96,
+    0x1A71, 0x0A50, 0x3A33, 0x2A12, 0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A, 0x6CA6, 0x7C87,
+    0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41, 0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70, 0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A,
+    0x9F59, 0x8F78, 0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F, 0x1080, 0x00A1, 0x30C2, 0x20E3,
+    0x5004, 0x4025, 0x7046, 0x6067, 0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E, 0x02B1, 0x1290,
+    0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256, 0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405, 0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E,
+    0xC71D, 0xD73C, 0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634, 0xD94C, 0xC96D, 0xF90E, 0xE92F,
+    0x99C8, 0x89E9, 0xB98A, 0xA9AB, 0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3, 0xCB7D, 0xDB5C,
+    0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A, 0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9, 0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83,
+    0x1CE0, 0x0CC1, 0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8, 0x6E17, 0x7E36, 0x4E55, 0x5E74,
+    0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+static inline uint8_t stream_byte_at(const core_link_stream_t *stream, size_t offset)
+{
+    size_t index = stream->head + offset;
+    if (index >= stream->capacity) {
+        index -= stream->capacity;
+    }
+    return stream->storage[index];
+}
+
+static size_t stream_find_sof(const uint8_t *data, size_t length)
+{
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] == CORE_LINK_SOF || data[i] == CORE_LINK_SOF_V2) {
+            return i;
+        }
+    }
+    return length;
+}
+
+static void stream_advance(core_link_stream_t *stream, size_t length)
+{
+    if (length >= stream->count) {
+        stream->head = 0;
+        stream->count = 0;
+        return;
+    }
+    stream->head += length;
+    if (stream->head >= stream->capacity) {
+        stream->head -= stream->capacity;
+    }
+    stream->count -= length;
+}
+
+static const uint8_t *stream_linearize(core_link_stream_t *stream, size_t length)
+{
+    size_t first = stream->capacity - stream->head;
+    if (length > first) {
+        // The spill area directly follows the ring: copying the wrapped prefix
+        // there makes the frame contiguous without moving the bytes already in place.
+        memcpy(stream->storage + stream->capacity, stream->storage, length - first);
+        stream->stats.wrapped_frames++;
+    }
+    return stream->storage + stream->head;
+}
+
+bool core_link_stream_init(core_link_stream_t *stream, uint8_t *storage, size_t storage_size)
+{
+    if (!stream || !storage || storage_size < CORE_LINK_STREAM_STORAGE_SIZE(CORE_LINK_FRAME_MAX_SIZE)) {
+        return false;
+    }
+    memset(stream, 0, sizeof(*stream));
+    stream->storage = storage;
+    stream->capacity = storage_size - CORE_LINK_FRAME_MAX_SIZE;
+    return true;
+}
+
+void core_link_stream_reset(core_link_stream_t *stream)
+{
+    if (!stream) {
+        return;
+    }
+    stream->head = 0;
+    stream->count = 0;
+    stream->pending_release = 0;
+}
+
+size_t core_link_stream_write_window(core_link_stream_t *stream, uint8_t **out_window)
+{
+    if (!stream || !out_window) {
+        return 0;
+    }
+    if (stream->count >= stream->capacity) {
+        *out_window = NULL;
+        return 0;
+    }
+
+    size_t tail = stream->head + stream->count;
+    if (tail >= stream->capacity) {
+        tail -= stream->capacity;
+        *out_window = stream->storage + tail;
+        return stream->head - tail;
+    }
+    *out_window = stream->storage + tail;
+    return stream->capacity - tail;
+}
+
+void core_link_stream_commit(core_link_stream_t *stream, size_t length)
+{
+    if (!stream) {
+        return;
+    }
+    size_t room = stream->capacity - stream->count;
+    if (length > room) {
+        length = room;
+    }
+    stream->count += length;
+    stream->stats.bytes_in += (uint32_t)length;
+}
+
+size_t core_link_stream_push(core_link_stream_t *stream, const uint8_t *data, size_t length)
+{
+    if (!stream || !data) {
+        return 0;
+    }
+    size_t accepted = 0;
+    while (accepted < length) {
+        uint8_t *window = NULL;
+        size_t room = core_link_stream_write_window(stream, &window);
+        if (room == 0) {
+            break;
+        }
+        size_t chunk = length - accepted;
+        if (chunk > room) {
+            chunk = room;
+        }
+        memcpy(window, data + accepted, chunk);
+        core_link_stream_commit(stream, chunk);
+        accepted += chunk;
+    }
+    return accepted;
+}
+
+bool core_link_stream_next(core_link_stream_t *stream, core_link_stream_frame_t *out_frame)
+{
+    if (!stream || !out_frame) {
+        return false;
+    }
+
+    if (stream->pending_release > 0) {
+        stream_advance(stream, stream->pending_release);
+        stream->pending_release = 0;
+    }
+
+    while (stream->count > 0) {
+        size_t segment = stream->capacity - stream->head;
+        if (segment > stream->count) {
+            segment = stream->count;
+        }
+        const uint8_t *start = stream->storage + stream->head;
+        size_t garbage = stream_find_sof(start, segment);
+        if (garbage > 0) {
+            stream->stats.bytes_skipped += (uint32_t)garbage;
+            stream_advance(stream, garbage);
+            continue;
+        }
+
+        bool v2 = start[0] == CORE_LINK_SOF_V2;
+        size_t header_size = v2 ? CORE_LINK_FRAME_V2_HEADER_SIZE : CORE_LINK_FRAME_HEADER_SIZE;
+        size_t overhead = v2 ? CORE_LINK_FRAME_V2_OVERHEAD : CORE_LINK_FRAME_OVERHEAD;
+        if (stream->count < header_size) {
+            return false;
+        }
+
+        uint16_t length = (uint16_t)(stream_byte_at(stream, 2) | ((uint16_t)stream_byte_at(stream, 3) << 8));
+        if (length > CORE_LINK_MAX_PAYLOAD) {
+            stream->stats.oversize_errors++;
+            stream->stats.bytes_skipped++;
+            stream_advance(stream, 1);
+            continue;
+        }
+
+        size_t total = overhead + length;
+        if (stream->count < total) {
+            return false;
+        }
+
+        const uint8_t *frame = stream_linearize(stream, total);
+        uint8_t type = frame[1];
+        const uint8_t *payload = frame + header_size;
+        uint16_t seq = 0;
+        bool valid;
+        if (v2) {
+            seq = (uint16_t)(frame[4] | ((uint16_t)frame[5] << 8));
+            uint16_t crc = (uint16_t)(payload[length] | ((uint16_t)payload[length + 1] << 8));
+            valid = core_link_crc16_update(0xFFFF, frame + 1, header_size - 1 + length) == crc;
+        } else {
+            valid = core_link_frame_checksum(type, length, payload) == payload[length];
+        }
+        if (!valid) {
+            // Only drop the false SOF: a genuine frame may start inside these bytes.
+            stream->stats.checksum_errors++;
+            stream->stats.bytes_skipped++;
+            stream_advance(stream, 1);
+            continue;
+        }
+
+        out_frame->version = v2 ? 2 : 1;
+        out_frame->type = type;
+        out_frame->seq = seq;
+        out_frame->length = length;
+        out_frame->payload = payload;
+        stream->pending_release = total;
+        stream->stats.frames++;
+        return true;
+    }
+
+    return false;
+}
+
+void core_link_stream_skip_partial(core_link_stream_t *stream)
+{
+    if (!stream || stream->count == 0) {
+        return;
+    }
+    if (stream->pending_release > 0) {
+        stream_advance(stream, stream->pending_release);
+        stream->pending_release = 0;
+        return;
+    }
+    stream->stats.bytes_skipped++;
+    stream_advance(stream, 1);
+}
+
+size_t core_link_stream_buffered(const core_link_stream_t *stream)
+{
+    return stream ? stream->count - stream->pending_release : 0;
+}
+
+uint8_t core_link_frame_checksum(uint8_t type, uint16_t length, const uint8_t *payload)
+{
+    uint32_t sum = type + (length & 0xFF) + (length >> 8);
+    if (payload && length) {
+        for (uint16_t i = 0; i < length; ++i) {
+            sum += payload[i];
+        }
+    }
+    return (uint8_t)(sum & 0xFF);
+}
+
+uint16_t core_link_crc16_update(uint16_t crc, const uint8_t *data, size_t length)
+{
+    if (!data) {
+        return crc;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        crc = (uint16_t)((crc << 8) ^ s_crc16_table[(uint8_t)((crc >> 8) ^ data[i])]);
+    }
+    return crc;
+}
+
+uint16_t core_link_frame_crc16(uint8_t type, uint16_t length, uint16_t seq, const uint8_t *payload)
+{
+    const uint8_t header[5] = {
+        type,
+        (uint8_t)(length & 0xFF),
+        (uint8_t)(length >> 8),
+        (uint8_t)(seq & 0xFF),
+        (uint8_t)(seq >> 8),
+    };
+    uint16_t crc = core_link_crc16_update(0xFFFF, header, sizeof(header));
+    return core_link_crc16_update(crc, payload, length);
+}
+
+size_t core_link_frame_encode(uint8_t *out, size_t out_size, uint8_t type, const void *payload, uint16_t length)
+{
+    size_t total = CORE_LINK_FRAME_OVERHEAD + length;
+    if (!out || out_size < total || length > CORE_LINK_MAX_PAYLOAD) {
+        return 0;
+    }
+    out[0] = CORE_LINK_SOF;
+    out[1] = type;
+    out[2] = (uint8_t)(length & 0xFF);
+    out[3] = (uint8_t)(length >> 8);
+    if (payload && length > 0) {
+        memcpy(out + CORE_LINK_FRAME_HEADER_SIZE, payload, length);
+    } else if (length > 0) {
+        memset(out + CORE_LINK_FRAME_HEADER_SIZE, 0, length);
+    }
+    out[CORE_LINK_FRAME_HEADER_SIZE + length] =
+        core_link_frame_checksum(type, length, out + CORE_LINK_FRAME_HEADER_SIZE);
+    return total;
+}
+
+size_t core_link_frame_encode_v2(uint8_t *out, size_t out_size, uint8_t type, uint16_t seq, const void *payload,
+                                 uint16_t length)
+{
+    size_t total = CORE_LINK_FRAME_V2_OVERHEAD + length;
+    if (!out || out_size < total || length > CORE_LINK_MAX_PAYLOAD) {
+        return 0;
+    }
+    out[0] = CORE_LINK_SOF_V2;
+    out[1] = type;
+    out[2] = (uint8_t)(length & 0xFF);
+    out[3] = (uint8_t)(length >> 8);
+    out[4] = (uint8_t)(seq & 0xFF);
+    out[5] = (uint8_t)(seq >> 8);
+    uint8_t *body = out + CORE_LINK_FRAME_V2_HEADER_SIZE;
+    if (payload && length > 0) {
+        memcpy(body, payload, length);
+    } else if (length > 0) {
+        memset(body, 0, length);
+    }
+    uint16_t crc = core_link_crc16_update(0xFFFF, out + 1, CORE_LINK_FRAME_V2_HEADER_SIZE - 1 + length);
+    body[length] = (uint8_t)(crc & 0xFF);
+    body[length + 1] = (uint8_t)(crc >> 8);
+    return total;
+}
@@ -0,0 +1,90 @@
+#include "link/core_link_subscription.h"
+
+#include <string.h>
+
+#include "link/core_link_fields.h"
+
+void core_link_subscription_all(core_link_subscription_t *sub)
+{
+    memset(sub, 0, sizeof(*sub));
+    sub->field_mask = CORE_LINK_DELTA_FIELD_ALL;
+    sub->all_terrariums = true;
+}
+
+void core_link_subscription_none(core_link_subscription_t *sub, core_link_delta_field_mask_t field_mask,
+                                 uint16_t min_interval_ms)
+{
+    memset(sub, 0, sizeof(*sub));
+    sub->field_mask = field_mask & CORE_LINK_DELTA_FIELD_ALL;
+    sub->min_interval_ms = min_interval_ms;
+}
+
+void core_link_subscription_add_terrarium(core_link_subscription_t *sub, uint8_t terrarium_id)
+{
+    sub->terrarium_bits[terrarium_id >> 5] |= 1UL << (terrarium_id & 31U);
+}
+
+size_t core_link_subscription_encode(const core_link_subscription_t *sub, uint8_t *out, size_t capacity)
+{
+    if (!sub || !out || capacity < CORE_LINK_SUBSCRIBE_HEADER_SIZE) {
+        return 0;
+    }
+    out[0] = (uint8_t)(sub->field_mask & 0xFF);
+    out[1] = (uint8_t)(sub->field_mask >> 8);
+    out[2] = (uint8_t)(sub->min_interval_ms & 0xFF);
+    out[3] = (uint8_t)(sub->min_interval_ms >> 8);
+
+    size_t length = CORE_LINK_SUBSCRIBE_HEADER_SIZE;
+    if (sub->all_terrariums) {
+        out[4] = CORE_LINK_SUBSCRIBE_ALL;
+        return length;
+    }
+    uint8_t count = 0;
+    for (unsigned id = 0; id < 256U; ++id) {
+        if (!(sub->terrarium_bits[id >> 5] & (1UL << (id & 31U)))) {
+            continue;
+        }
+        // The count byte reserves 0xFF for "all": a longer list is rejected.
+        if (length >= capacity || count == CORE_LINK_SUBSCRIBE_ALL - 1U) {
+            return 0;
+        }
+        out[length++] = (uint8_t)id;
+        ++count;
+    }
+    out[4] = count;
+    return length;
+}
+
+bool core_link_subscription_decode(const uint8_t *payload, size_t length, core_link_subscription_t *sub)
+{
+    if (!payload || !sub || length < CORE_LINK_SUBSCRIBE_HEADER_SIZE) {
+        return false;
+    }
+    uint8_t count = payload[4];
+    if (count != CORE_LINK_SUBSCRIBE_ALL && length < CORE_LINK_SUBSCRIBE_HEADER_SIZE + (size_t)count) {
+        return false;
+    }
+
+    core_link_subscription_t parsed;
+    core_link_subscription_none(&parsed, (core_link_delta_field_mask_t)(payload[0] | (payload[1] << 8)),
+                                (uint16_t)(payload[2] | (payload[3] << 8)));
+    if (count == CORE_LINK_SUBSCRIBE_ALL) {
+        parsed.all_terrariums = true;
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            core_link_subscription_add_terrarium(&parsed, payload[CORE_LINK_SUBSCRIBE_HEADER_SIZE + i]);
+        }
+    }
+    *sub = parsed;
+    return true;
+}
+
+void core_link_subscription_filter(const core_link_subscription_t *sub, core_link_terrarium_snapshot_t *snap,
+                                   const core_link_terrarium_snapshot_t *sent)
+{
+    core_link_delta_field_mask_t frozen =
+        CORE_LINK_DELTA_FIELD_ALL & (core_link_delta_field_mask_t)~core_link_subscription_mask(sub, snap->terrarium_id);
+    if (frozen) {
+        core_link_fields_copy(snap, sent, frozen);
+    }
+}
@@ -0,0 +1,169 @@
+#include "link/core_link_touch.h"
+
+#include <string.h>
+
+#define TOUCH_BATCH_HEADER_SIZE 1U
+
+static uint32_t pack_coords(uint16_t x, uint16_t y)
+{
+    return (uint32_t)x | ((uint32_t)y << 16);
+}
+
+void core_link_touch_slots_init(core_link_touch_slots_t *slots)
+{
+    for (size_t i = 0; i < CORE_LINK_TOUCH_MAX_POINTS; ++i) {
+        atomic_init(&slots->coords[i], 0);
+    }
+    atomic_init(&slots->active, 0);
+    atomic_init(&slots->down_pending, 0);
+    atomic_init(&slots->up_pending, 0);
+    atomic_init(&slots->dirty, 0);
+    atomic_init(&slots->reset_pending, false);
+    memset(slots->last_sent, 0, sizeof(slots->last_sent));
+    slots->last_sent_valid = 0;
+}
+
+void core_link_touch_slots_reset(core_link_touch_slots_t *slots)
+{
+    atomic_store_explicit(&slots->active, 0, memory_order_relaxed);
+    atomic_store_explicit(&slots->down_pending, 0, memory_order_relaxed);
+    atomic_store_explicit(&slots->up_pending, 0, memory_order_relaxed);
+    atomic_store_explicit(&slots->dirty, 0, memory_order_relaxed);
+    atomic_store_explicit(&slots->reset_pending, true, memory_order_release);
+}
+
+bool core_link_touch_slots_update(core_link_touch_slots_t *slots, const core_link_touch_event_t *event)
+{
+    if (!event || event->point_id >= CORE_LINK_TOUCH_MAX_POINTS) {
+        return false;
+    }
+    uint8_t id = event->point_id;
+    uint32_t bit = 1U << id;
+    uint32_t coords = pack_coords(event->x, event->y);
+    // Apart from a reset, only this producer writes `active`: the relaxed read is its own last write.
+    bool was_active = (atomic_load_explicit(&slots->active, memory_order_relaxed) & bit) != 0;
+
+    switch (event->type) {
+        case CORE_LINK_TOUCH_DOWN:
+        case CORE_LINK_TOUCH_MOVE:
+            if (was_active && atomic_load_explicit(&slots->coords[id], memory_order_relaxed) == coords) {
+                return false;
+            }
+            atomic_store_explicit(&slots->coords[id], coords, memory_order_relaxed);
+            if (!was_active) {
+                atomic_fetch_or_explicit(&slots->active, bit, memory_order_relaxed);
+                atomic_fetch_or_explicit(&slots->down_pending, bit, memory_order_relaxed);
+            }
+            break;
+        case CORE_LINK_TOUCH_UP:
+            if (!was_active) {
+                return false;
+            }
+            atomic_store_explicit(&slots->coords[id], coords, memory_order_relaxed);
+            atomic_fetch_and_explicit(&slots->active, ~bit, memory_order_relaxed);
+            atomic_fetch_or_explicit(&slots->up_pending, bit, memory_order_relaxed);
+            break;
+        default:
+            return false;
+    }
+    // Publishes the slot: the consumer's acquire on `dirty` sees everything above.
+    atomic_fetch_or_explicit(&slots->dirty, bit, memory_order_release);
+    return true;
+}
+
+static void emit(core_link_touch_slots_t *slots, core_link_touch_event_t *out, size_t *count, uint8_t id,
+                 core_link_touch_type_t type, uint32_t coords)
+{
+    core_link_touch_event_t *event = &out[(*count)++];
+    event->type = type;
+    event->point_id = id;
+    event->x = (uint16_t)(coords & 0xFFFFU);
+    event->y = (uint16_t)(coords >> 16);
+    slots->last_sent[id] = *event;
+    slots->last_sent_valid |= 1U << id;
+}
+
+size_t core_link_touch_slots_collect(core_link_touch_slots_t *slots, core_link_touch_event_t *out, size_t capacity)
+{
+    if (atomic_exchange_explicit(&slots->reset_pending, false, memory_order_acquire)) {
+        memset(slots->last_sent, 0, sizeof(slots->last_sent));
+        slots->last_sent_valid = 0;
+    }
+
+    uint32_t dirty = atomic_exchange_explicit(&slots->dirty, 0, memory_order_acquire);
+    size_t count = 0;
+    for (uint8_t id = 0; id < CORE_LINK_TOUCH_MAX_POINTS; ++id) {
+        uint32_t bit = 1U << id;
+        if ((dirty & bit) == 0) {
+            continue;
+        }
+        if (capacity - count < 3) {
+            // No room for this point's worst case: leave it for the next pass.
+            atomic_fetch_or_explicit(&slots->dirty, dirty & ~(bit - 1U), memory_order_relaxed);
+            break;
+        }
+        bool down = (atomic_fetch_and_explicit(&slots->down_pending, ~bit, memory_order_relaxed) & bit) != 0;
+        bool up = (atomic_fetch_and_explicit(&slots->up_pending, ~bit, memory_order_relaxed) & bit) != 0;
+        bool active = (atomic_load_explicit(&slots->active, memory_order_relaxed) & bit) != 0;
+        uint32_t coords = atomic_load_explicit(&slots->coords[id], memory_order_relaxed);
+        const core_link_touch_event_t *last = &slots->last_sent[id];
+        bool core_active = (slots->last_sent_valid & bit) != 0 && last->type != CORE_LINK_TOUCH_UP;
+
+        // Replay the transitions the core has not seen, then settle on the latest position.
+        if (up && core_active) {
+            emit(slots, out, &count, id, CORE_LINK_TOUCH_UP, coords);
+            core_active = false;
+        }
+        if (down && !core_active) {
+            emit(slots, out, &count, id, CORE_LINK_TOUCH_DOWN, coords);
+            core_active = true;
+        } else if (active && core_active && pack_coords(last->x, last->y) != coords) {
+            emit(slots, out, &count, id, CORE_LINK_TOUCH_MOVE, coords);
+        }
+        if (!active && core_active) {
+            emit(slots, out, &count, id, CORE_LINK_TOUCH_UP, coords);
+        }
+    }
+    return count;
+}
+
+size_t core_link_touch_batch_encode(const core_link_touch_event_t *events, size_t count, uint8_t *out, size_t capacity)
+{
+    if (count > UINT8_MAX || capacity < TOUCH_BATCH_HEADER_SIZE + count * CORE_LINK_TOUCH_BATCH_ENTRY_SIZE) {
+        return 0;
+    }
+    out[0] = (uint8_t)count;
+    uint8_t *cursor = out + TOUCH_BATCH_HEADER_SIZE;
+    for (size_t i = 0; i < count; ++i, cursor += CORE_LINK_TOUCH_BATCH_ENTRY_SIZE) {
+        cursor[0] = events[i].point_id;
+        cursor[1] = (uint8_t)events[i].type;
+        cursor[2] = (uint8_t)events[i].x;
+        cursor[3] = (uint8_t)(events[i].x >> 8);
+        cursor[4] = (uint8_t)events[i].y;
+        cursor[5] = (uint8_t)(events[i].y >> 8);
+    }
+    return (size_t)(cursor - out);
+}
+
+size_t core_link_touch_batch_decode(const uint8_t *payload, size_t length, core_link_touch_event_t *out,
+                                    size_t capacity)
+{
+    if (!payload || length < TOUCH_BATCH_HEADER_SIZE) {
+        return 0;
+    }
+    size_t count = payload[0];
+    if (count > capacity || length < TOUCH_BATCH_HEADER_SIZE + count * CORE_LINK_TOUCH_BATCH_ENTRY_SIZE) {
+        return 0;
+    }
+    const uint8_t *cursor = payload + TOUCH_BATCH_HEADER_SIZE;
+    for (size_t i = 0; i < count; ++i, cursor += CORE_LINK_TOUCH_BATCH_ENTRY_SIZE) {
+        if (cursor[1] > CORE_LINK_TOUCH_UP) {
+            return 0;
+        }
+        out[i].point_id = cursor[0];
+        out[i].type = (core_link_touch_type_t)cursor[1];
+        out[i].x = (uint16_t)(cursor[2] | (cursor[3] << 8));
+        out[i].y = (uint16_t)(cursor[4] | (cursor[5] << 8));
+    }
+    return count;
+}
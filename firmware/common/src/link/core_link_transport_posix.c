@@ -0,0 +1,166 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "link/core_link_transport_posix.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+static int64_t monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sleep_until_us(int64_t deadline_us)
+{
+    int64_t now = monotonic_us();
+    while (now < deadline_us) {
+        int64_t remaining = deadline_us - now;
+        struct timespec ts = {
+            .tv_sec = (time_t)(remaining / 1000000),
+            .tv_nsec = (long)(remaining % 1000000) * 1000,
+        };
+        nanosleep(&ts, NULL);
+        now = monotonic_us();
+    }
+}
+
+static int posix_transport_write(void *ctx, const uint8_t *data, size_t length)
+{
+    core_link_posix_transport_t *state = ctx;
+    if (state->bits_per_second > 0) {
+        // 8N1: ten bit times per byte. Bytes reach the peer once they would have left the wire.
+        int64_t start = monotonic_us();
+        if (state->wire_free_us > start) {
+            start = state->wire_free_us;
+        }
+        state->wire_free_us = start + (int64_t)length * 10 * 1000000 / state->bits_per_second;
+        sleep_until_us(state->wire_free_us);
+    }
+
+    size_t written = 0;
+    while (written < length) {
+        ssize_t n = write(state->fd, data + written, length - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        written += (size_t)n;
+    }
+    return (int)written;
+}
+
+static int posix_transport_read(void *ctx, uint8_t *data, size_t capacity, uint32_t timeout_ms)
+{
+    core_link_posix_transport_t *state = ctx;
+    if (capacity == 0) {
+        return 0;
+    }
+    struct pollfd pfd = {.fd = state->fd, .events = POLLIN};
+    int timeout = timeout_ms == CORE_LINK_TRANSPORT_WAIT_FOREVER ? -1 : (timeout_ms > INT32_MAX ? INT32_MAX : (int)timeout_ms);
+    int ready;
+    do {
+        ready = poll(&pfd, 1, timeout);
+    } while (ready < 0 && errno == EINTR);
+    if (ready <= 0) {
+        return ready;
+    }
+    // A blocking read on a pty or socket returns what is already there.
+    ssize_t n;
+    do {
+        n = read(state->fd, data, capacity);
+    } while (n < 0 && errno == EINTR);
+    return n < 0 ? -1 : (int)n;
+}
+
+static int posix_transport_set_baud(void *ctx, uint32_t bits_per_second)
+{
+    core_link_posix_transport_t *state = ctx;
+    // Only the pacing changes (an unpaced pair stays unpaced): the bytes always get through.
+    if (state->bits_per_second > 0) {
+        state->bits_per_second = bits_per_second;
+    }
+    return 0;
+}
+
+static const core_link_transport_ops_t s_posix_ops = {
+    .write = posix_transport_write,
+    .read = posix_transport_read,
+    .set_baud = posix_transport_set_baud,
+};
+
+bool core_link_transport_posix_open(core_link_transport_t *out, core_link_posix_transport_t *state, int fd,
+                                    uint32_t bits_per_second)
+{
+    if (!out || !state || fd < 0) {
+        return false;
+    }
+    state->fd = fd;
+    state->bits_per_second = bits_per_second;
+    state->wire_free_us = 0;
+    out->ops = &s_posix_ops;
+    out->ctx = state;
+    return true;
+}
+
+static bool open_pty_pair(int fds[2])
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0) {
+        return false;
+    }
+    if (grantpt(master) != 0 || unlockpt(master) != 0) {
+        close(master);
+        return false;
+    }
+    const char *name = ptsname(master);
+    int slave = name ? open(name, O_RDWR | O_NOCTTY) : -1;
+    if (slave < 0) {
+        close(master);
+        return false;
+    }
+    // Raw mode on the slave disables echo and newline translation in both directions.
+    struct termios tio;
+    if (tcgetattr(slave, &tio) != 0) {
+        close(slave);
+        close(master);
+        return false;
+    }
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    fds[0] = master;
+    fds[1] = slave;
+    return true;
+}
+
+bool core_link_transport_posix_pair(core_link_posix_pair_kind_t kind, uint32_t bits_per_second,
+                                    core_link_transport_t *a, core_link_posix_transport_t *a_state,
+                                    core_link_transport_t *b, core_link_posix_transport_t *b_state)
+{
+    int fds[2];
+    bool ok = kind == CORE_LINK_POSIX_PTY ? open_pty_pair(fds) : socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0;
+    if (!ok) {
+        return false;
+    }
+    return core_link_transport_posix_open(a, a_state, fds[0], bits_per_second) &&
+           core_link_transport_posix_open(b, b_state, fds[1], bits_per_second);
+}
+
+void core_link_transport_posix_close(core_link_posix_transport_t *state)
+{
+    if (state && state->fd >= 0) {
+        close(state->fd);
+        state->fd = -1;
+    }
+}
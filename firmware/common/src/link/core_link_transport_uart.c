@@ -0,0 +1,87 @@
+#include "link/core_link_transport_uart.h"
+
+#include "driver/uart.h"
+#include "esp_check.h"
+#include "freertos/FreeRTOS.h"
+
+static const char *TAG = "core_link_uart";
+
+static int uart_transport_write(void *ctx, const uint8_t *data, size_t length)
+{
+    const core_link_uart_transport_t *uart = ctx;
+    return uart_write_bytes(uart->uart_port, (const char *)data, length);
+}
+
+static int uart_transport_read(void *ctx, uint8_t *data, size_t capacity, uint32_t timeout_ms)
+{
+    const core_link_uart_transport_t *uart = ctx;
+    if (capacity == 0) {
+        return 0;
+    }
+
+    size_t buffered = 0;
+    uart_get_buffered_data_len(uart->uart_port, &buffered);
+    int total = 0;
+    if (buffered == 0) {
+        // Idle: block for a single byte, then drain whatever arrived with it.
+        TickType_t wait = timeout_ms == CORE_LINK_TRANSPORT_WAIT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+        int got = uart_read_bytes(uart->uart_port, data, 1, wait);
+        if (got <= 0) {
+            return got;
+        }
+        total = got;
+        uart_get_buffered_data_len(uart->uart_port, &buffered);
+    }
+
+    size_t want = buffered;
+    if (want > capacity - (size_t)total) {
+        want = capacity - (size_t)total;
+    }
+    if (want > 0) {
+        int got = uart_read_bytes(uart->uart_port, data + total, want, 0);
+        if (got > 0) {
+            total += got;
+        }
+    }
+    return total;
+}
+
+static int uart_transport_set_baud(void *ctx, uint32_t bits_per_second)
+{
+    const core_link_uart_transport_t *uart = ctx;
+    // Let the frame already in the FIFO leave at the old rate first.
+    if (uart_wait_tx_done(uart->uart_port, pdMS_TO_TICKS(100)) != ESP_OK) {
+        ESP_LOGW(TAG, "TX not drained before baud change");
+    }
+    return uart_set_baudrate(uart->uart_port, bits_per_second) == ESP_OK ? 0 : -1;
+}
+
+static const core_link_transport_ops_t s_uart_ops = {
+    .write = uart_transport_write,
+    .read = uart_transport_read,
+    .set_baud = uart_transport_set_baud,
+};
+
+esp_err_t core_link_transport_uart_open(core_link_transport_t *out, core_link_uart_transport_t *uart,
+                                        const core_link_uart_transport_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(out && uart && config, ESP_ERR_INVALID_ARG, TAG, "invalid args");
+
+    uart_config_t uart_cfg = {
+        .baud_rate = config->baud_rate,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_REF_TICK,
+    };
+
+    ESP_RETURN_ON_ERROR(uart_driver_install(config->uart_port, config->rx_buffer_size, 0, 0, NULL, 0), TAG, "uart_driver_install failed");
+    ESP_RETURN_ON_ERROR(uart_param_config(config->uart_port, &uart_cfg), TAG, "uart_param_config failed");
+    ESP_RETURN_ON_ERROR(uart_set_pin(config->uart_port, config->tx_gpio, config->rx_gpio, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE), TAG, "uart_set_pin failed");
+
+    uart->uart_port = config->uart_port;
+    out->ops = &s_uart_ops;
+    out->ctx = uart;
+    return ESP_OK;
+}
@@ -0,0 +1,133 @@
+#include "link/core_link_tx_queue.h"
+
+#include <string.h>
+
+void core_link_tx_queue_init(core_link_tx_queue_t *queue, core_link_tx_slot_t *slots, size_t capacity)
+{
+    memset(queue, 0, sizeof(*queue));
+    queue->slots = slots;
+    queue->capacity = capacity;
+    queue->stats.capacity = (uint16_t)(capacity > UINT16_MAX ? UINT16_MAX : capacity);
+    for (size_t i = queue->capacity; i > 0; --i) {
+        core_link_tx_slot_t *slot = &queue->slots[i - 1];
+        slot->next = queue->free_list;
+        queue->free_list = slot;
+    }
+}
+
+core_link_tx_slot_t *core_link_tx_queue_acquire(core_link_tx_queue_t *queue)
+{
+    core_link_tx_slot_t *slot = queue->free_list;
+    if (!slot) {
+        return NULL;
+    }
+    queue->free_list = slot->next;
+    slot->next = NULL;
+    slot->length = 0;
+    // Reserved slots count towards the depth: they are frames about to be queued.
+    queue->stats.depth++;
+    if (queue->stats.depth > queue->stats.max_depth) {
+        queue->stats.max_depth = queue->stats.depth;
+    }
+    return slot;
+}
+
+static void release_slot(core_link_tx_queue_t *queue, core_link_tx_slot_t *slot)
+{
+    slot->next = queue->free_list;
+    queue->free_list = slot;
+    if (queue->stats.depth > 0) {
+        queue->stats.depth--;
+    }
+}
+
+void core_link_tx_queue_abort(core_link_tx_queue_t *queue, core_link_tx_slot_t *slot)
+{
+    if (slot) {
+        release_slot(queue, slot);
+    }
+}
+
+void core_link_tx_queue_push(core_link_tx_queue_t *queue, core_link_tx_slot_t *slot, core_link_tx_priority_t priority,
+                             int64_t now_us)
+{
+    if ((unsigned)priority >= CORE_LINK_TX_PRIO_COUNT) {
+        priority = CORE_LINK_TX_PRIO_BULK;
+    }
+    slot->priority = (uint8_t)priority;
+    slot->enqueued_us = now_us;
+    slot->next = NULL;
+    if (queue->tail[priority]) {
+        queue->tail[priority]->next = slot;
+    } else {
+        queue->head[priority] = slot;
+    }
+    queue->tail[priority] = slot;
+
+    core_link_tx_class_stats_t *stats = &queue->stats.classes[priority];
+    stats->enqueued++;
+    stats->depth++;
+    if (stats->depth > stats->max_depth) {
+        stats->max_depth = stats->depth;
+    }
+}
+
+core_link_tx_slot_t *core_link_tx_queue_pop(core_link_tx_queue_t *queue)
+{
+    for (size_t prio = 0; prio < CORE_LINK_TX_PRIO_COUNT; ++prio) {
+        core_link_tx_slot_t *slot = queue->head[prio];
+        if (!slot) {
+            continue;
+        }
+        queue->head[prio] = slot->next;
+        if (!queue->head[prio]) {
+            queue->tail[prio] = NULL;
+        }
+        slot->next = NULL;
+        queue->stats.classes[prio].depth--;
+        return slot;
+    }
+    return NULL;
+}
+
+void core_link_tx_queue_complete(core_link_tx_queue_t *queue, core_link_tx_slot_t *slot, int64_t now_us)
+{
+    core_link_tx_class_stats_t *stats = &queue->stats.classes[slot->priority];
+    int64_t latency = now_us - slot->enqueued_us;
+    if (latency < 0) {
+        latency = 0;
+    }
+    stats->sent++;
+    stats->total_latency_us += (uint64_t)latency;
+    if ((uint64_t)latency > stats->max_latency_us) {
+        stats->max_latency_us = latency > UINT32_MAX ? UINT32_MAX : (uint32_t)latency;
+    }
+    queue->stats.bytes_sent += slot->length;
+    release_slot(queue, slot);
+}
+
+void core_link_tx_queue_note_drop(core_link_tx_queue_t *queue, core_link_tx_priority_t priority)
+{
+    if ((unsigned)priority < CORE_LINK_TX_PRIO_COUNT) {
+        queue->stats.classes[priority].dropped++;
+    }
+}
+
+core_link_tx_priority_t core_link_tx_priority_for(core_link_msg_type_t type)
+{
+    if (core_link_msg_is_state((uint8_t)type)) {
+        return CORE_LINK_TX_PRIO_STATE;
+    }
+    switch (type) {
+        case CORE_LINK_MSG_PING:
+        case CORE_LINK_MSG_PONG:
+            return CORE_LINK_TX_PRIO_PING;
+        case CORE_LINK_MSG_COMMAND:
+        case CORE_LINK_MSG_ERROR:
+        case CORE_LINK_MSG_LINK_STATS:
+        case CORE_LINK_MSG_HISTORY_CHUNK:
+            return CORE_LINK_TX_PRIO_BULK;
+        default:
+            return CORE_LINK_TX_PRIO_URGENT;
+    }
+}
@@ -1,4 +1,5 @@
 #include "compression_if.h"
+#include "compression_rle.h"
 
 #include <string.h>
 
@@ -12,11 +13,49 @@ esp_err_t compression_if_init(void)
     return ESP_OK;
 }
 
+esp_err_t compression_if_compress(compression_codec_t codec, const uint8_t *input, size_t input_len, uint8_t *output, size_t output_len, size_t *produced)
+{
+    if (!output || !input) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t written = 0;
+    switch (codec) {
+        case COMPRESSION_CODEC_NONE:
+            if (input_len > output_len) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            memcpy(output, input, input_len);
+            written = input_len;
+            break;
+        case COMPRESSION_CODEC_RLE:
+            written = compression_rle_encode(input, input_len, output, output_len);
+            if (written == 0 && input_len > 0) {
+                return ESP_ERR_INVALID_SIZE;
+            }
+            break;
+        default:
+            return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (produced) {
+        *produced = written;
+    }
+    return ESP_OK;
+}
+
 esp_err_t compression_if_decompress(compression_codec_t codec, const uint8_t *input, size_t input_len, uint8_t *output, size_t output_len, size_t *consumed, size_t *produced)
 {
     if (!output || !input) {
         return ESP_ERR_INVALID_ARG;
     }
+    if (codec == COMPRESSION_CODEC_RLE) {
+        if (!compression_rle_decode(input, input_len, output, output_len, produced)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        if (consumed) {
+            *consumed = input_len;
+        }
+        return ESP_OK;
+    }
     size_t copy = input_len < output_len ? input_len : output_len;
     memcpy(output, input, copy);
     if (consumed) {
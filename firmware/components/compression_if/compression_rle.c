@@ -0,0 +1,82 @@
+#include "compression_rle.h"
+
+#include <string.h>
+
+static size_t run_length(const uint8_t *input, size_t remaining)
+{
+    size_t run = 1;
+    while (run < remaining && run < COMPRESSION_RLE_MAX_RUN && input[run] == input[0]) {
+        ++run;
+    }
+    return run;
+}
+
+size_t compression_rle_encode(const uint8_t *input, size_t input_len, uint8_t *output, size_t output_len)
+{
+    size_t in = 0;
+    size_t out = 0;
+    size_t literal_start = 0;
+    size_t literal_len = 0;
+
+    while (in <= input_len) {
+        size_t run = in < input_len ? run_length(input + in, input_len - in) : 0;
+        bool flush = in == input_len || run >= COMPRESSION_RLE_MIN_RUN || literal_len == COMPRESSION_RLE_MAX_LITERAL;
+        if (flush && literal_len > 0) {
+            if (out + 1 + literal_len > output_len) {
+                return 0;
+            }
+            output[out++] = (uint8_t)(literal_len - 1);
+            memcpy(output + out, input + literal_start, literal_len);
+            out += literal_len;
+            literal_len = 0;
+        }
+        if (in == input_len) {
+            break;
+        }
+        if (run >= COMPRESSION_RLE_MIN_RUN) {
+            if (out + 2 > output_len) {
+                return 0;
+            }
+            output[out++] = (uint8_t)(0x80U + run - COMPRESSION_RLE_MIN_RUN);
+            output[out++] = input[in];
+            in += run;
+            continue;
+        }
+        if (literal_len == 0) {
+            literal_start = in;
+        }
+        ++literal_len;
+        ++in;
+    }
+    return out;
+}
+
+bool compression_rle_decode(const uint8_t *input, size_t input_len, uint8_t *output, size_t output_len,
+                            size_t *produced)
+{
+    size_t in = 0;
+    size_t out = 0;
+    while (in < input_len) {
+        uint8_t control = input[in++];
+        if (control < 0x80U) {
+            size_t count = (size_t)control + 1U;
+            if (in + count > input_len || out + count > output_len) {
+                return false;
+            }
+            memcpy(output + out, input + in, count);
+            in += count;
+            out += count;
+        } else {
+            size_t count = (size_t)(control - 0x80U) + COMPRESSION_RLE_MIN_RUN;
+            if (in >= input_len || out + count > output_len) {
+                return false;
+            }
+            memset(output + out, input[in++], count);
+            out += count;
+        }
+    }
+    if (produced) {
+        *produced = out;
+    }
+    return true;
+}
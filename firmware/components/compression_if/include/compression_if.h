@@ -14,9 +14,12 @@ typedef enum {
     COMPRESSION_CODEC_LZ4,
     COMPRESSION_CODEC_HEATSHRINK,
     COMPRESSION_CODEC_MINIZ,
+    COMPRESSION_CODEC_RLE, /* voir compression_rle.h */
 } compression_codec_t;
 
 esp_err_t compression_if_init(void);
+/* ESP_ERR_INVALID_SIZE si le résultat dépasse `output_len` : l'appelant garde alors ses données brutes. */
+esp_err_t compression_if_compress(compression_codec_t codec, const uint8_t *input, size_t input_len, uint8_t *output, size_t output_len, size_t *produced);
 esp_err_t compression_if_decompress(compression_codec_t codec, const uint8_t *input, size_t input_len, uint8_t *output, size_t output_len, size_t *consumed, size_t *produced);
 
 #ifdef __cplusplus
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Codec COMPRESSION_CODEC_RLE, portable (aucune dépendance ESP-IDF) pour être
+ * partagé avec le firmware du cœur et les tests hôtes. Format de type PackBits,
+ * taillé pour des données majoritairement nulles (différences XOR) :
+ *
+ *   0x00..0x7F  n + 1 octets littéraux suivent (1..128)
+ *   0x80..0xFF  l'octet suivant répété n - 0x80 + 3 fois (3..130)
+ *
+ * Pire cas : un octet de contrôle par bloc de 128 littéraux.
+ */
+#define COMPRESSION_RLE_MAX_LITERAL 128U
+#define COMPRESSION_RLE_MIN_RUN 3U
+#define COMPRESSION_RLE_MAX_RUN 130U
+#define COMPRESSION_RLE_WORST_CASE(len) ((len) + ((len) + COMPRESSION_RLE_MAX_LITERAL - 1U) / COMPRESSION_RLE_MAX_LITERAL)
+
+/** Taille encodée, ou 0 si elle dépasse `output_len` (ou si `input_len` est nul). */
+size_t compression_rle_encode(const uint8_t *input, size_t input_len, uint8_t *output, size_t output_len);
+
+/**
+ * \brief Décode tout `input` dans `output`.
+ * @return false si le flux est tronqué ou dépasse `output_len`.
+ */
+bool compression_rle_decode(const uint8_t *input, size_t input_len, uint8_t *output, size_t output_len,
+                            size_t *produced);
+
+#ifdef __cplusplus
+}
+#endif
@@ -15,6 +15,11 @@ void lvgl_port_unlock(void);
 void lvgl_port_invalidate(void);
 void lvgl_port_feed_touch_event(bool pressed, uint16_t x, uint16_t y);
 
+/* Appelé par la tâche de rendu, verrou LVGL tenu, une fois la dernière zone
+ * d'un rafraîchissement envoyée à l'écran. */
+typedef void (*lvgl_port_flush_done_cb_t)(void *ctx);
+void lvgl_port_set_flush_done_cb(lvgl_port_flush_done_cb_t cb, void *ctx);
+
 #ifdef __cplusplus
 }
 #endif
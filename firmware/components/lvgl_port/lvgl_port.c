@@ -43,6 +43,8 @@ static lv_indev_t *s_touch_indev;
 static bool s_initialized;
 static uint8_t *s_framebuffers[2];
 static size_t s_framebuffer_size;
+static lvgl_port_flush_done_cb_t s_flush_done_cb;
+static void *s_flush_done_ctx;
 
 static struct {
     uint16_t x;
@@ -186,6 +188,14 @@ void lvgl_port_invalidate(void)
     }
 }
 
+void lvgl_port_set_flush_done_cb(lvgl_port_flush_done_cb_t cb, void *ctx)
+{
+    lvgl_port_lock();
+    s_flush_done_cb = cb;
+    s_flush_done_ctx = ctx;
+    lvgl_port_unlock();
+}
+
 void lvgl_port_feed_touch_event(bool pressed, uint16_t x, uint16_t y)
 {
     if (!s_touch_queue) {
@@ -264,7 +274,11 @@ static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px
         ESP_LOGE(TAG, "LovyanGFX flush failed");
     }
 
+    bool last = lv_display_flush_is_last(disp);
     lv_display_flush_ready(disp);
+    if (last && s_flush_done_cb) {
+        s_flush_done_cb(s_flush_done_ctx);
+    }
 }
 
 static void lvgl_rounder_cb(lv_display_t *disp, lv_area_t *area)
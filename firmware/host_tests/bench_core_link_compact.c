@@ -0,0 +1,250 @@
+/*
+ * Banc hôte de l'encodage compact : rejoue une journée simulée de publications
+ * du DevKitC (4 terrariums, période CONFIG_CORE_APP_STATE_PUBLISH_INTERVAL_MS
+ * par défaut) et compare le débit UART nécessaire entre l'encodage v1 (floats)
+ * et STATE_*_COMPACT, avec la même politique STATE_FULL que core_host_link.c.
+ * Au-delà de 512 octets, les charges sont comptées fragmentées (STATE_FRAGMENT).
+ *
+ *   bench_core_link_compact [--terrariums N] [--period-ms N] [--hours N]
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "link/core_link_compact.h"
+#include "link/core_link_fields.h"
+#include "link/core_link_fragment.h"
+#include "link/core_link_stream.h"
+
+#define BENCH_V1_FLOAT_EPSILON 0.0005f
+#define BENCH_MAX_DELTAS_BEFORE_FULL 20U
+#define BENCH_FULL_REFRESH_SECONDS 30U
+#define BENCH_STATE_HEADER_SIZE 5U
+#define BENCH_DELTA_HEADER_SIZE 6U
+#define BENCH_ENTRY_HEADER_SIZE 3U
+#define BENCH_V1_SNAPSHOT_SIZE sizeof(core_link_snapshot_wire_t)
+#define BENCH_LINK_BAUD 2000000.0
+#define BENCH_NAME_COUNT 4U
+
+typedef struct {
+    const char *label;
+    bool compact;
+    bool deltas;
+    uint64_t bytes;
+    uint64_t frames;
+    size_t largest_publish;
+    uint64_t full_frames;
+    core_link_terrarium_snapshot_t baseline[CORE_LINK_MAX_TERRARIUMS];
+    uint32_t deltas_since_full;
+    uint32_t last_full_epoch;
+    bool names_sent;
+} bench_encoder_t;
+
+static const char *s_names[BENCH_NAME_COUNT][2] = {
+    {"Python regius", "Python royal"},
+    {"Pogona vitticeps", "Dragon barbu"},
+    {"Correlophus ciliatus", "Gecko \xc3\xa0 cr\xc3\xaate"},
+    {"Eublepharis macularius", "Gecko l\xc3\xa9opard"},
+};
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Même allure que core_state_manager : cycles lents + bruit de capteur. */
+static void simulate(core_link_terrarium_snapshot_t *snap, uint8_t id, double t, uint32_t *rng)
+{
+    *rng = *rng * 1664525u + 1013904223u;
+    float noise = ((float)(*rng >> 8) / 16777216.0f - 0.5f) * 0.02f;
+    float phase = (float)(t * (0.03 + 0.005 * id) * 0.01) + (float)id;
+    snap->terrarium_id = id;
+    strncpy(snap->scientific_name, s_names[id % BENCH_NAME_COUNT][0], CORE_LINK_NAME_MAX_LEN);
+    strncpy(snap->common_name, s_names[id % BENCH_NAME_COUNT][1], CORE_LINK_NAME_MAX_LEN);
+    snap->temp_day_c = 31.0f + 1.5f * sinf(phase) + noise;
+    snap->temp_night_c = 23.0f + 1.0f * cosf(phase) + noise;
+    snap->humidity_day_pct = 60.0f + 4.0f * sinf(phase * 0.7f) + noise;
+    snap->humidity_night_pct = 70.0f + 3.0f * cosf(phase * 0.7f) + noise;
+    snap->lux_day = 400.0f + 40.0f * sinf(phase * 1.3f);
+    snap->lux_night = 5.0f + 0.5f * cosf(phase * 1.3f);
+    snap->hydration_pct = 85.0f + 5.0f * sinf(phase * 0.2f);
+    snap->stress_pct = 20.0f + 6.0f * sinf(phase * 0.4f);
+    snap->health_pct = 92.0f + 2.0f * cosf(phase * 0.1f);
+    snap->activity_score = 0.5f + 0.4f * sinf(phase * 2.0f);
+    if (((uint64_t)t % 21600U) == 0U) {
+        snap->last_feeding_timestamp = 1700000000u + (uint32_t)t;
+    }
+}
+
+static core_link_delta_field_mask_t v1_diff_mask(const core_link_terrarium_snapshot_t *a,
+                                                 const core_link_terrarium_snapshot_t *b)
+{
+    const float fa[] = {a->temp_day_c, a->temp_night_c, a->humidity_day_pct, a->humidity_night_pct, a->lux_day,
+                        a->lux_night, a->hydration_pct, a->stress_pct, a->health_pct};
+    const float fb[] = {b->temp_day_c, b->temp_night_c, b->humidity_day_pct, b->humidity_night_pct, b->lux_day,
+                        b->lux_night, b->hydration_pct, b->stress_pct, b->health_pct};
+    core_link_delta_field_mask_t mask = 0;
+    for (unsigned i = 0; i < 9; ++i) {
+        if (fabsf(fa[i] - fb[i]) > BENCH_V1_FLOAT_EPSILON) {
+            mask |= (core_link_delta_field_mask_t)(CORE_LINK_DELTA_FIELD_TEMP_DAY << i);
+        }
+    }
+    if (strcmp(a->scientific_name, b->scientific_name) != 0) {
+        mask |= CORE_LINK_DELTA_FIELD_SCIENTIFIC_NAME;
+    }
+    if (strcmp(a->common_name, b->common_name) != 0) {
+        mask |= CORE_LINK_DELTA_FIELD_COMMON_NAME;
+    }
+    if (a->last_feeding_timestamp != b->last_feeding_timestamp) {
+        mask |= CORE_LINK_DELTA_FIELD_LAST_FEED;
+    }
+    if (fabsf(a->activity_score - b->activity_score) > BENCH_V1_FLOAT_EPSILON) {
+        mask |= CORE_LINK_DELTA_FIELD_ACTIVITY;
+    }
+    return mask;
+}
+
+/* Octets sur le fil pour une charge STATE_*, fragmentation comprise. */
+static size_t wire_size(size_t payload)
+{
+    if (payload <= CORE_LINK_MAX_PAYLOAD) {
+        return payload + CORE_LINK_FRAME_V2_OVERHEAD;
+    }
+    size_t fragments = core_link_fragment_count(payload);
+    return payload + fragments * (CORE_LINK_FRAGMENT_HEADER_SIZE + CORE_LINK_FRAME_V2_OVERHEAD);
+}
+
+static void publish(bench_encoder_t *enc, const core_link_terrarium_snapshot_t *snaps, uint8_t count, uint32_t epoch)
+{
+    bool full = !enc->deltas || enc->frames == 0 || enc->deltas_since_full >= BENCH_MAX_DELTAS_BEFORE_FULL ||
+                epoch - enc->last_full_epoch >= BENCH_FULL_REFRESH_SECONDS;
+    size_t payload = 0;
+    uint8_t scratch[CORE_LINK_MAX_PAYLOAD];
+
+    if (full) {
+        payload = BENCH_STATE_HEADER_SIZE;
+        for (uint8_t i = 0; i < count; ++i) {
+            if (enc->compact) {
+                core_link_delta_field_mask_t mask = CORE_LINK_DELTA_FIELD_ALL;
+                if (enc->names_sent) {
+                    mask &= (core_link_delta_field_mask_t)~CORE_LINK_DELTA_FIELD_NAMES;
+                }
+                payload += BENCH_ENTRY_HEADER_SIZE + core_link_compact_encode_fields(scratch, sizeof(scratch), mask, &snaps[i]);
+            } else {
+                payload += BENCH_V1_SNAPSHOT_SIZE;
+            }
+        }
+        enc->names_sent = true;
+        enc->deltas_since_full = 0;
+        enc->last_full_epoch = epoch;
+        enc->full_frames++;
+    } else {
+        payload = BENCH_DELTA_HEADER_SIZE;
+        bool any = false;
+        for (uint8_t i = 0; i < count; ++i) {
+            core_link_delta_field_mask_t mask = enc->compact ? core_link_compact_diff_mask(&snaps[i], &enc->baseline[i])
+                                                             : v1_diff_mask(&snaps[i], &enc->baseline[i]);
+            if (!mask) {
+                continue;
+            }
+            any = true;
+            payload += BENCH_ENTRY_HEADER_SIZE;
+            payload += enc->compact ? core_link_compact_encode_fields(scratch, sizeof(scratch), mask, &snaps[i])
+                                    : core_link_fields_v1_size(mask);
+        }
+        if (any) {
+            enc->deltas_since_full++;
+        }
+    }
+    memcpy(enc->baseline, snaps, sizeof(*snaps) * count);
+    size_t wire = wire_size(payload);
+    if (wire > enc->largest_publish) {
+        enc->largest_publish = wire;
+    }
+    enc->bytes += wire;
+    enc->frames++;
+}
+
+static void bench_codec_speed(const core_link_terrarium_snapshot_t *snap)
+{
+    enum { ITERATIONS = 2000000 };
+    uint8_t buffer[128];
+    volatile size_t sink = 0;
+    double t0 = now_seconds();
+    for (unsigned i = 0; i < ITERATIONS; ++i) {
+        sink += core_link_compact_encode_fields(buffer, sizeof(buffer), CORE_LINK_DELTA_FIELD_ALL, snap);
+    }
+    double encode_s = now_seconds() - t0;
+    size_t length = core_link_compact_encode_fields(buffer, sizeof(buffer), CORE_LINK_DELTA_FIELD_ALL, snap);
+    core_link_terrarium_snapshot_t out;
+    t0 = now_seconds();
+    for (unsigned i = 0; i < ITERATIONS; ++i) {
+        size_t offset = 0;
+        sink += core_link_compact_decode_fields(buffer, length, &offset, CORE_LINK_DELTA_FIELD_ALL, &out);
+    }
+    double decode_s = now_seconds() - t0;
+    (void)sink;
+    printf("codec: encode %.1f ns/terrarium, decode %.1f ns/terrarium\n", encode_s * 1e9 / ITERATIONS,
+           decode_s * 1e9 / ITERATIONS);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned terrariums = CORE_LINK_LEGACY_MAX_TERRARIUMS;
+    unsigned period_ms = 500;
+    unsigned hours = 24;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--terrariums") == 0) {
+            terrariums = (unsigned)strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--period-ms") == 0) {
+            period_ms = (unsigned)strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--hours") == 0) {
+            hours = (unsigned)strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    if (terrariums == 0 || terrariums > CORE_LINK_MAX_TERRARIUMS || period_ms == 0) {
+        fprintf(stderr, "invalid arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    static bench_encoder_t encoders[] = {
+        {.label = "v1 full only", .compact = false, .deltas = false},
+        {.label = "v1 full+delta", .compact = false, .deltas = true},
+        {.label = "compact full+delta", .compact = true, .deltas = true},
+    };
+    const size_t encoder_count = sizeof(encoders) / sizeof(encoders[0]);
+
+    core_link_terrarium_snapshot_t snaps[CORE_LINK_MAX_TERRARIUMS];
+    memset(snaps, 0, sizeof(snaps));
+    uint32_t rng = 0xC0FFEEu;
+    uint64_t steps = (uint64_t)hours * 3600000ULL / period_ms;
+    for (uint64_t step = 0; step < steps; ++step) {
+        double t = (double)step * period_ms / 1000.0;
+        for (uint8_t i = 0; i < terrariums; ++i) {
+            simulate(&snaps[i], i, t, &rng);
+        }
+        for (size_t e = 0; e < encoder_count; ++e) {
+            publish(&encoders[e], snaps, (uint8_t)terrariums, (uint32_t)t);
+        }
+    }
+
+    double seconds = (double)hours * 3600.0;
+    printf("%u terrarium(s), publish every %u ms, %u h simulated (v2 framing)\n", terrariums, period_ms, hours);
+    for (size_t e = 0; e < encoder_count; ++e) {
+        const bench_encoder_t *enc = &encoders[e];
+        // 10 bits per byte on the UART (start + 8 data + stop).
+        double burst_ms = (double)enc->largest_publish * 10.0 * 1000.0 / BENCH_LINK_BAUD;
+        printf("   %-20s %8.1f B/s  %6.1f B/frame  (%llu full / %llu frames)  largest %zu B = %.1f ms @ 2 Mbps\n",
+               enc->label, enc->bytes / seconds, (double)enc->bytes / (double)enc->frames,
+               (unsigned long long)enc->full_frames, (unsigned long long)enc->frames, enc->largest_publish, burst_ms);
+    }
+    bench_codec_speed(&snaps[0]);
+    return EXIT_SUCCESS;
+}
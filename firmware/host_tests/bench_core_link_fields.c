@@ -0,0 +1,114 @@
+/*
+ * Microbanc hôte des codecs générés par CORE_LINK_SNAPSHOT_FIELDS : temps
+ * d'encodage et de décodage par terrarium, en v1 et en compact, pour une
+ * entrée complète et pour un delta typique (quelques valeurs numériques).
+ *
+ *   bench_core_link_fields [--iterations N]
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "link/core_link_compact.h"
+#include "link/core_link_fields.h"
+
+typedef size_t (*bench_encode_fn)(uint8_t *out, size_t capacity, core_link_delta_field_mask_t mask,
+                                  const core_link_terrarium_snapshot_t *snap);
+typedef bool (*bench_decode_fn)(const uint8_t *payload, size_t length, size_t *offset,
+                                core_link_delta_field_mask_t mask, core_link_terrarium_snapshot_t *snap);
+
+typedef struct {
+    const char *label;
+    bench_encode_fn encode;
+    bench_decode_fn decode;
+    core_link_delta_field_mask_t mask;
+} bench_case_t;
+
+#define BENCH_DELTA_MASK                                                                        \
+    (CORE_LINK_DELTA_FIELD_TEMP_DAY | CORE_LINK_DELTA_FIELD_HUMIDITY_DAY | CORE_LINK_DELTA_FIELD_HYDRATION | \
+     CORE_LINK_DELTA_FIELD_ACTIVITY)
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void make_snapshot(core_link_terrarium_snapshot_t *snap)
+{
+    memset(snap, 0, sizeof(*snap));
+    snap->terrarium_id = 7;
+    strncpy(snap->scientific_name, "Pogona vitticeps", CORE_LINK_NAME_MAX_LEN);
+    strncpy(snap->common_name, "Dragon barbu", CORE_LINK_NAME_MAX_LEN);
+    snap->temp_day_c = 34.2f;
+    snap->temp_night_c = 22.8f;
+    snap->humidity_day_pct = 38.5f;
+    snap->humidity_night_pct = 52.0f;
+    snap->lux_day = 1200.0f;
+    snap->lux_night = 2.0f;
+    snap->hydration_pct = 86.3f;
+    snap->stress_pct = 14.9f;
+    snap->health_pct = 95.1f;
+    snap->last_feeding_timestamp = 1700000000u;
+    snap->activity_score = 0.61f;
+}
+
+static void run_case(const bench_case_t *c, const core_link_terrarium_snapshot_t *snap, unsigned iterations)
+{
+    uint8_t buffer[160];
+    volatile size_t sink = 0;
+    core_link_terrarium_snapshot_t in = *snap;
+
+    double t0 = now_seconds();
+    for (unsigned i = 0; i < iterations; ++i) {
+        in.temp_day_c += 0.01f; // keep the compiler from hoisting the call
+        sink += c->encode(buffer, sizeof(buffer), c->mask, &in);
+    }
+    double encode_s = now_seconds() - t0;
+
+    size_t length = c->encode(buffer, sizeof(buffer), c->mask, snap);
+    core_link_terrarium_snapshot_t out = *snap;
+    t0 = now_seconds();
+    for (unsigned i = 0; i < iterations; ++i) {
+        size_t offset = 0;
+        sink += c->decode(buffer, length, &offset, c->mask, &out);
+    }
+    double decode_s = now_seconds() - t0;
+    (void)sink;
+
+    printf("   %-16s %3zu B   encode %6.1f ns/terrarium   decode %6.1f ns/terrarium\n", c->label, length,
+           encode_s * 1e9 / iterations, decode_s * 1e9 / iterations);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned iterations = 5000000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--iterations") == 0) {
+            iterations = (unsigned)strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "invalid arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    const bench_case_t cases[] = {
+        {"v1 full", core_link_fields_v1_encode, core_link_fields_v1_decode, CORE_LINK_DELTA_FIELD_ALL},
+        {"v1 delta", core_link_fields_v1_encode, core_link_fields_v1_decode, BENCH_DELTA_MASK},
+        {"compact full", core_link_compact_encode_fields, core_link_compact_decode_fields, CORE_LINK_DELTA_FIELD_ALL},
+        {"compact delta", core_link_compact_encode_fields, core_link_compact_decode_fields, BENCH_DELTA_MASK},
+    };
+
+    core_link_terrarium_snapshot_t snap;
+    make_snapshot(&snap);
+    printf("%u iterations per case\n", iterations);
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        run_case(&cases[i], &snap, iterations);
+    }
+    return EXIT_SUCCESS;
+}
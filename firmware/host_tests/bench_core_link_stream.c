@@ -0,0 +1,319 @@
+/*
+ * Banc hôte du parseur Core Link : rejoue un flux d'octets enregistré (ou un
+ * flux synthétique de rafales STATE_FULL/STATE_DELTA/PING avec corruption et
+ * coupures) à travers l'ancien lecteur octet par octet et le parseur en anneau.
+ *
+ *   bench_core_link_stream [capture.bin ...] [--burst N] [--chunk N]
+ *
+ * Une "rafale" modélise un arrêt du flux plus long que les délais de lecture
+ * de l'ancien rx_task (50 ms) ; `--chunk` est la granularité de livraison du
+ * pilote UART (seuil FIFO).
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "link/core_link_stream.h"
+
+#define BENCH_SYNTH_FRAMES 200000U
+#define BENCH_RING_SIZE 2048
+
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+    size_t pos;
+    size_t burst;
+    size_t chunk;
+    size_t burst_end;
+    uint64_t calls;
+} fake_uart_t;
+
+static uint8_t s_ring_storage[CORE_LINK_STREAM_STORAGE_SIZE(BENCH_RING_SIZE)];
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t xorshift(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static uint8_t *synthesize_stream(size_t *out_length, size_t *out_valid_frames)
+{
+    size_t capacity = (size_t)BENCH_SYNTH_FRAMES * 160U;
+    uint8_t *data = malloc(capacity);
+    if (!data) {
+        return NULL;
+    }
+    uint32_t rng = 0x12345678u;
+    uint8_t payload[CORE_LINK_MAX_PAYLOAD];
+    size_t length = 0;
+    size_t valid = 0;
+    for (unsigned i = 0; i < BENCH_SYNTH_FRAMES; ++i) {
+        uint8_t type = 0x11;
+        uint16_t payload_len = (uint16_t)(24U + xorshift(&rng) % 48U);
+        if (i % 20U == 0U) {
+            type = 0x10;
+            payload_len = 441;
+        } else if (i % 7U == 0U) {
+            type = 0x1F;
+            payload_len = 4;
+        }
+        if (length + CORE_LINK_FRAME_OVERHEAD + payload_len > capacity) {
+            capacity *= 2U;
+            uint8_t *grown = realloc(data, capacity);
+            if (!grown) {
+                free(data);
+                return NULL;
+            }
+            data = grown;
+        }
+        for (uint16_t b = 0; b < payload_len; ++b) {
+            payload[b] = (uint8_t)xorshift(&rng);
+        }
+        size_t written = core_link_frame_encode(data + length, capacity - length, type, payload, payload_len);
+        if (xorshift(&rng) % 1000U == 0U) {
+            data[length + CORE_LINK_FRAME_HEADER_SIZE + payload_len / 2U] ^= 0x5A;
+        } else {
+            ++valid;
+        }
+        length += written;
+    }
+    *out_length = length;
+    *out_valid_frames = valid;
+    return data;
+}
+
+static void fake_uart_init(fake_uart_t *uart, const uint8_t *data, size_t length, size_t burst, size_t chunk)
+{
+    memset(uart, 0, sizeof(*uart));
+    uart->data = data;
+    uart->length = length;
+    uart->burst = burst;
+    uart->chunk = chunk;
+    uart->burst_end = (burst > 0 && burst < length) ? burst : length;
+}
+
+static size_t fake_uart_available(const fake_uart_t *uart)
+{
+    return uart->burst_end - uart->pos;
+}
+
+static void fake_uart_next_burst(fake_uart_t *uart)
+{
+    if (uart->burst == 0) {
+        uart->burst_end = uart->length;
+        return;
+    }
+    uart->burst_end += uart->burst;
+    if (uart->burst_end > uart->length) {
+        uart->burst_end = uart->length;
+    }
+}
+
+/* Same contract as uart_read_bytes(): returns what arrived before the timeout. */
+static int fake_uart_read(fake_uart_t *uart, uint8_t *dst, size_t length, bool wait_forever)
+{
+    uart->calls++;
+    if (uart->pos >= uart->length) {
+        return -1;
+    }
+    size_t available = fake_uart_available(uart);
+    if (available == 0 && wait_forever) {
+        fake_uart_next_burst(uart);
+        available = fake_uart_available(uart);
+    }
+    size_t copy = length < available ? length : available;
+    memcpy(dst, uart->data + uart->pos, copy);
+    uart->pos += copy;
+    if (copy < length) {
+        // Timed out: the stream resumes with the next burst.
+        fake_uart_next_burst(uart);
+    }
+    return (int)copy;
+}
+
+static uint8_t legacy_checksum(uint8_t type, uint16_t length, const uint8_t *payload)
+{
+    return core_link_frame_checksum(type, length, payload);
+}
+
+static size_t run_legacy(fake_uart_t *uart)
+{
+    uint8_t header_buf[CORE_LINK_FRAME_HEADER_SIZE];
+    uint8_t payload_buf[CORE_LINK_MAX_PAYLOAD];
+    size_t frames = 0;
+    while (true) {
+        int read = fake_uart_read(uart, header_buf, 1, true);
+        if (read < 0) {
+            break;
+        }
+        if (read != 1 || header_buf[0] != CORE_LINK_SOF) {
+            continue;
+        }
+        if (fake_uart_read(uart, header_buf + 1, CORE_LINK_FRAME_HEADER_SIZE - 1, false) !=
+            (int)(CORE_LINK_FRAME_HEADER_SIZE - 1)) {
+            continue;
+        }
+        uint16_t length = (uint16_t)(header_buf[2] | (header_buf[3] << 8));
+        if (length > CORE_LINK_MAX_PAYLOAD) {
+            continue;
+        }
+        if (length > 0 && fake_uart_read(uart, payload_buf, length, false) != length) {
+            continue;
+        }
+        uint8_t checksum = 0;
+        if (fake_uart_read(uart, &checksum, 1, false) != 1) {
+            continue;
+        }
+        if (legacy_checksum(header_buf[1], length, payload_buf) != checksum) {
+            continue;
+        }
+        ++frames;
+    }
+    return frames;
+}
+
+static size_t run_stream(fake_uart_t *uart, core_link_stream_stats_t *out_stats)
+{
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, s_ring_storage, sizeof(s_ring_storage));
+    size_t frames = 0;
+    volatile uint8_t sink = 0;
+    while (true) {
+        uint8_t *window = NULL;
+        size_t room = core_link_stream_write_window(&stream, &window);
+        size_t available = fake_uart_available(uart);
+        size_t want = available > 0 ? available : 1;
+        if (uart->chunk > 0 && want > uart->chunk) {
+            want = uart->chunk;
+        }
+        if (want > room) {
+            want = room;
+        }
+        int got = fake_uart_read(uart, window, want, available == 0);
+        if (got < 0) {
+            break;
+        }
+        core_link_stream_commit(&stream, (size_t)got);
+        core_link_stream_frame_t frame;
+        while (core_link_stream_next(&stream, &frame)) {
+            sink ^= frame.type;
+            ++frames;
+        }
+    }
+    (void)sink;
+    *out_stats = stream.stats;
+    return frames;
+}
+
+static void bench_capture(const char *label, const uint8_t *data, size_t length, size_t expected_frames, size_t burst,
+                          size_t chunk)
+{
+    fake_uart_t uart;
+
+    fake_uart_init(&uart, data, length, burst, chunk);
+    double t0 = now_seconds();
+    size_t legacy_frames = run_legacy(&uart);
+    double legacy_s = now_seconds() - t0;
+    uint64_t legacy_calls = uart.calls;
+
+    fake_uart_init(&uart, data, length, burst, chunk);
+    core_link_stream_stats_t stats;
+    t0 = now_seconds();
+    size_t stream_frames = run_stream(&uart, &stats);
+    double stream_s = now_seconds() - t0;
+    uint64_t stream_calls = uart.calls;
+
+    double mib = (double)length / (1024.0 * 1024.0);
+    printf("== %s (%zu bytes, burst=%zu, chunk=%zu)\n", label, length, burst, chunk);
+    if (expected_frames > 0) {
+        printf("   valid frames in capture : %zu\n", expected_frames);
+    }
+    printf("   legacy  : %8zu frames  %6.2f reads/frame  %8.1f MiB/s\n", legacy_frames,
+           legacy_frames ? (double)legacy_calls / (double)legacy_frames : 0.0, mib / legacy_s);
+    printf("   stream  : %8zu frames  %6.2f reads/frame  %8.1f MiB/s  (checksum=%u oversize=%u wrapped=%u skipped=%u)\n",
+           stream_frames, stream_frames ? (double)stream_calls / (double)stream_frames : 0.0, mib / stream_s,
+           (unsigned)stats.checksum_errors, (unsigned)stats.oversize_errors, (unsigned)stats.wrapped_frames,
+           (unsigned)stats.bytes_skipped);
+}
+
+static uint8_t *load_file(const char *path, size_t *out_length)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    fseek(file, 0L, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0L, SEEK_SET);
+    if (length <= 0) {
+        fclose(file);
+        return NULL;
+    }
+    uint8_t *data = malloc((size_t)length);
+    if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *out_length = (size_t)length;
+    return data;
+}
+
+int main(int argc, char **argv)
+{
+    size_t burst = 4096;
+    size_t chunk = 120;
+    int captures = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--burst") == 0 && i + 1 < argc) {
+            burst = (size_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--chunk") == 0 && i + 1 < argc) {
+            chunk = (size_t)strtoul(argv[++i], NULL, 10);
+        }
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--burst") == 0 || strcmp(argv[i], "--chunk") == 0) {
+            ++i;
+            continue;
+        }
+        size_t length = 0;
+        uint8_t *data = load_file(argv[i], &length);
+        if (!data) {
+            fprintf(stderr, "cannot read capture %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        bench_capture(argv[i], data, length, 0, burst, chunk);
+        free(data);
+        ++captures;
+    }
+
+    if (captures == 0) {
+        size_t length = 0;
+        size_t valid = 0;
+        uint8_t *data = synthesize_stream(&length, &valid);
+        if (!data) {
+            return EXIT_FAILURE;
+        }
+        bench_capture("synthetic, continuous", data, length, valid, 0, chunk);
+        bench_capture("synthetic, stalls", data, length, valid, burst, chunk);
+        free(data);
+    }
+    return EXIT_SUCCESS;
+}
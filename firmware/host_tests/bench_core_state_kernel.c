@@ -0,0 +1,138 @@
+/*
+ * Microbanc hôte de la mise à jour des terrariums : boucle d'origine sur un
+ * tableau de core_state_slot_t (sinf/cosf) face au noyau SoA, en emplacements
+ * par microseconde, avec l'écart maximal entre les deux après le même nombre
+ * de pas.
+ *
+ *   bench_core_state_kernel [--slots N] [--steps N]
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "core_state_reference.h"
+#include "state/core_state_kernel.h"
+
+#define BENCH_BASE_EPOCH 1700000000U
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void make_slot(core_state_slot_t *slot, size_t idx)
+{
+    memset(slot, 0, sizeof(*slot));
+    slot->id = (uint8_t)idx;
+    float f = (float)(idx % 13U);
+    slot->base_temp_day = 27.0f + f * 0.5f;
+    slot->base_temp_night = 21.0f + f * 0.3f;
+    slot->base_humidity_day = 45.0f + f * 2.0f;
+    slot->base_humidity_night = 55.0f + f * 2.0f;
+    slot->base_lux_day = 250.0f + f * 30.0f;
+    slot->base_lux_night = 4.0f;
+    slot->hydration_pct = 85.0f;
+    slot->stress_pct = 20.0f + f;
+    slot->health_pct = 92.0f;
+    slot->activity_score = 0.5f;
+    slot->target_hydration_pct = slot->hydration_pct;
+    slot->target_stress_pct = slot->stress_pct;
+    slot->target_health_pct = slot->health_pct;
+    slot->feeding_interval_hours = 0.1f + 0.02f * f;
+    slot->feeding_intake_pct = 75.0f;
+    slot->cycle_speed = 0.03f + 0.001f * f;
+    slot->phase_offset = 0.25f * f;
+    slot->enrichment_factor = 0.8f + 0.05f * f;
+    slot->last_feeding_timestamp = BENCH_BASE_EPOCH - (uint32_t)idx;
+}
+
+int main(int argc, char **argv)
+{
+    size_t slots = 1024;
+    unsigned steps = 20000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--slots") == 0) {
+            slots = (size_t)strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--steps") == 0) {
+            steps = (unsigned)strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    if (slots == 0 || steps == 0) {
+        fprintf(stderr, "invalid arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    core_state_slot_t *aos = calloc(slots, sizeof(core_state_slot_t));
+    size_t size = (core_state_soa_storage_size(slots) + 15U) & ~(size_t)15U;
+    void *storage = aligned_alloc(16, size);
+    if (!aos || !storage) {
+        fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+    memset(storage, 0, size);
+    core_state_soa_t soa;
+    core_state_soa_init(&soa, storage, slots);
+    for (size_t i = 0; i < slots; ++i) {
+        make_slot(&aos[i], i);
+        core_state_soa_store(&soa, i, &aos[i]);
+    }
+    soa.count = slots;
+
+    const float delta = 0.2f;
+    core_state_soa_anchor(&soa, 0, slots, -delta);
+    double t0 = now_seconds();
+    for (unsigned step = 0; step < steps; ++step) {
+        core_state_reference_update(aos, slots, delta * (float)step, delta, BENCH_BASE_EPOCH + step / 5U);
+    }
+    double aos_s = now_seconds() - t0;
+
+    t0 = now_seconds();
+    for (unsigned step = 0; step < steps; ++step) {
+        core_state_step_t kernel_step = {
+            .advance_s = delta,
+            .delta_seconds = delta,
+            .now_epoch = BENCH_BASE_EPOCH + step / 5U,
+        };
+        core_state_kernel_update(&soa, 0, slots, &kernel_step);
+        if (step % 32U == 31U) {
+            core_state_kernel_renormalize(&soa, 0, slots);
+        }
+    }
+    double soa_s = now_seconds() - t0;
+
+    float max_diff = 0.0f;
+    for (size_t i = 0; i < slots; ++i) {
+        core_state_slot_t loaded;
+        core_state_soa_load(&soa, i, &loaded);
+        const float pairs[][2] = {
+            {aos[i].current_temp_day, loaded.current_temp_day},
+            {aos[i].current_humidity_day, loaded.current_humidity_day},
+            {aos[i].current_lux_day, loaded.current_lux_day},
+            {aos[i].hydration_pct, loaded.hydration_pct},
+            {aos[i].stress_pct, loaded.stress_pct},
+            {aos[i].health_pct, loaded.health_pct},
+            {aos[i].activity_score, loaded.activity_score},
+        };
+        for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); ++p) {
+            max_diff = fmaxf(max_diff, fabsf(pairs[p][0] - pairs[p][1]));
+        }
+    }
+
+    double slot_steps = (double)slots * (double)steps;
+    double aos_rate = slot_steps / (aos_s * 1e6);
+    double soa_rate = slot_steps / (soa_s * 1e6);
+    printf("%zu slots x %u steps\n", slots, steps);
+    printf("   AoS sinf/cosf    %7.1f slots/us   %6.1f us/step\n", aos_rate, aos_s * 1e6 / steps);
+    printf("   SoA kernel       %7.1f slots/us   %6.1f us/step\n", soa_rate, soa_s * 1e6 / steps);
+    printf("   speedup x%.2f, max |diff| %.2e\n", soa_rate / aos_rate, (double)max_diff);
+
+    free(storage);
+    free(aos);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+/*
+ * Microbanc hôte des ondes de la simulation : les quatre sinf/cosf d'un temps
+ * absolu en flottant (boucle d'origine) face aux quatre rotations de phaseurs du
+ * noyau, en cycles (TSC sur x86-64) et en nanosecondes par mise à jour
+ * d'emplacement.
+ *
+ *   bench_core_state_oscillator [--slots N] [--steps N]
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#else
+#define BENCH_HAVE_TSC 0
+#endif
+
+#include "state/core_state_kernel.h"
+
+typedef struct {
+    double seconds;
+    uint64_t cycles;
+} bench_time_t;
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t now_cycles(void)
+{
+#if BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// The waves of the original update, without the state they feed.
+static bench_time_t run_libm(const float *cycle_speed, const float *phase_offset, float *sink, size_t slots,
+                             unsigned steps)
+{
+    double t0 = now_seconds();
+    uint64_t c0 = now_cycles();
+    for (unsigned step = 0; step < steps; ++step) {
+        float time_s = 0.1f * (float)step;
+        for (size_t i = 0; i < slots; ++i) {
+            float a = time_s * cycle_speed[i];
+            float p = phase_offset[i];
+            sink[i] += sinf(a + p) + cosf(a * 0.7f + p * 1.2f) + cosf(a * 0.55f + p) + sinf(a * 1.4f + p);
+        }
+    }
+    return (bench_time_t){now_seconds() - t0, now_cycles() - c0};
+}
+
+static bench_time_t run_phasors(core_state_soa_t *soa, unsigned steps)
+{
+    double t0 = now_seconds();
+    uint64_t c0 = now_cycles();
+    for (unsigned i = 0; i < steps; ++i) {
+        core_state_kernel_advance_waves(soa, 0, soa->count, 0.1f);
+        if (i % 32U == 31U) {
+            core_state_kernel_renormalize(soa, 0, soa->count);
+        }
+    }
+    return (bench_time_t){now_seconds() - t0, now_cycles() - c0};
+}
+
+static bench_time_t run_kernel(core_state_soa_t *soa, unsigned steps)
+{
+    core_state_step_t step = {.advance_s = 0.1f, .delta_seconds = 0.1f, .now_epoch = 1700000000U};
+    double t0 = now_seconds();
+    uint64_t c0 = now_cycles();
+    for (unsigned i = 0; i < steps; ++i) {
+        core_state_kernel_update(soa, 0, soa->count, &step);
+    }
+    return (bench_time_t){now_seconds() - t0, now_cycles() - c0};
+}
+
+static void print_row(const char *label, bench_time_t t, double updates)
+{
+    if (BENCH_HAVE_TSC) {
+        printf("   %-22s %7.1f cycles   %6.2f ns   per slot update\n", label, (double)t.cycles / updates,
+               t.seconds * 1e9 / updates);
+    } else {
+        printf("   %-22s %6.2f ns per slot update\n", label, t.seconds * 1e9 / updates);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t slots = 1024;
+    unsigned steps = 20000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--slots") == 0) {
+            slots = (size_t)strtoul(argv[i + 1], NULL, 10);
+        } else if (strcmp(argv[i], "--steps") == 0) {
+            steps = (unsigned)strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    if (slots == 0 || steps == 0) {
+        fprintf(stderr, "invalid arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    size_t size = (core_state_soa_storage_size(slots) + 15U) & ~(size_t)15U;
+    void *storage = aligned_alloc(16, size);
+    float *sink = calloc(slots, sizeof(float));
+    if (!storage || !sink) {
+        fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+    memset(storage, 0, size);
+    core_state_soa_t soa;
+    core_state_soa_init(&soa, storage, slots);
+    for (size_t i = 0; i < slots; ++i) {
+        core_state_slot_t slot;
+        memset(&slot, 0, sizeof(slot));
+        slot.base_temp_day = 30.0f;
+        slot.hydration_pct = slot.target_hydration_pct = 80.0f;
+        slot.stress_pct = slot.target_stress_pct = 20.0f;
+        slot.health_pct = slot.target_health_pct = 90.0f;
+        slot.feeding_interval_hours = 48.0f;
+        slot.feeding_intake_pct = 75.0f;
+        slot.enrichment_factor = 1.0f;
+        slot.cycle_speed = 0.03f + 0.001f * (float)(i % 13U);
+        slot.phase_offset = 0.25f * (float)(i % 13U);
+        core_state_soa_store(&soa, i, &slot);
+    }
+    soa.count = slots;
+
+    double updates = (double)slots * (double)steps;
+    bench_time_t libm = run_libm(soa.cycle_speed, soa.phase_offset, sink, slots, steps);
+    bench_time_t phasors = run_phasors(&soa, steps);
+    bench_time_t kernel = run_kernel(&soa, steps);
+
+    printf("%zu slots x %u steps\n", slots, steps);
+    print_row("4 x sinf/cosf", libm, updates);
+    print_row("4 phasor rotations", phasors, updates);
+    print_row("whole kernel step", kernel, updates);
+    printf("   waves x%.1f cheaper (checksum %.3f)\n", libm.seconds / phasors.seconds, (double)sink[slots / 2U]);
+
+    free(sink);
+    free(storage);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+/*
+ * Banc hôte du chargement des profils au démarrage : pour 4, 64 et 512
+ * profils, analyse en flux de tous les JSON avec écriture du cache (premier
+ * démarrage ou profil modifié) face à la relecture du cache à jour.
+ *
+ *   bench_core_state_profiles [--runs N]
+ */
+
+#define _GNU_SOURCE
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "state/core_state_profiles.h"
+
+static const size_t k_profile_counts[] = {4, 64, 512};
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// A profile as shipped on the SD card, about 600 bytes.
+static void write_profile(const char *dir, size_t index)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "%s/terrarium_%04zu.json", dir, index);
+    FILE *file = fopen(path, "wb");
+    fprintf(file,
+            "{\n"
+            "  \"id\": %zu,\n"
+            "  \"scientific_name\": \"Python regius\",\n"
+            "  \"common_name\": \"Python royal %zu\",\n"
+            "  \"environment\": {\n"
+            "    \"temp_day_c\": %.1f,\n"
+            "    \"temp_night_c\": 24.0,\n"
+            "    \"humidity_day_pct\": 60.0,\n"
+            "    \"humidity_night_pct\": 70.0,\n"
+            "    \"lux_day\": 400.0,\n"
+            "    \"lux_night\": 5.0\n"
+            "  },\n"
+            "  \"cycle_speed\": 0.03,\n"
+            "  \"phase_offset\": %.2f,\n"
+            "  \"enrichment_factor\": 1.0,\n"
+            "  \"notes\": \"Mue observée le 12/03, appétit normal, aucun signe de stress particulier.\",\n"
+            "  \"metrics\": {\n"
+            "    \"hydration_pct\": 82.5,\n"
+            "    \"stress_pct\": 18.0,\n"
+            "    \"health_pct\": 93.0,\n"
+            "    \"activity_score\": 0.55,\n"
+            "    \"feeding\": {\n"
+            "      \"interval_hours\": 72,\n"
+            "      \"intake_pct\": 80,\n"
+            "      \"last_timestamp\": 1704000000\n"
+            "    }\n"
+            "  }\n"
+            "}\n",
+            index % 256U, index, 30.0 + (double)(index % 7U) * 0.5, (double)(index % 13U) * 0.25);
+    fclose(file);
+}
+
+static void remove_dir(const char *dir, const char *cache_path)
+{
+    DIR *handle = opendir(dir);
+    struct dirent *entry = NULL;
+    while (handle && (entry = readdir(handle)) != NULL) {
+        if (entry->d_name[0] != '.') {
+            char path[sizeof(entry->d_name) + 64];
+            snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+            unlink(path);
+        }
+    }
+    if (handle) {
+        closedir(handle);
+    }
+    rmdir(dir);
+    unlink(cache_path);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned runs = 20;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--runs") == 0) {
+            runs = (unsigned)strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+    if (runs == 0) {
+        fprintf(stderr, "invalid arguments\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("profiles   parse + cache write   cache hit   speedup   cache size\n");
+    for (size_t c = 0; c < sizeof(k_profile_counts) / sizeof(k_profile_counts[0]); ++c) {
+        size_t count = k_profile_counts[c];
+        char dir[] = "/tmp/bench_profilesXXXXXX";
+        char cache_path[64];
+        if (!mkdtemp(dir) || !core_state_profiles_cache_path(dir, cache_path, sizeof(cache_path))) {
+            fprintf(stderr, "cannot create a temporary directory\n");
+            return EXIT_FAILURE;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            write_profile(dir, i);
+        }
+        core_state_profile_cache_t *cache = malloc(CORE_STATE_PROFILE_CACHE_SIZE(count));
+        if (!cache) {
+            fprintf(stderr, "out of memory\n");
+            return EXIT_FAILURE;
+        }
+
+        // Best of N: the page cache is warm either way, as on a second boot.
+        core_state_profiles_stats_t stats;
+        double cold = 1e9;
+        double warm = 1e9;
+        for (unsigned run = 0; run < runs; ++run) {
+            unlink(cache_path);
+            double t0 = now_seconds();
+            core_state_profiles_status_t status =
+                core_state_profiles_load(dir, cache_path, NULL, cache, count, &stats);
+            double t1 = now_seconds();
+            if (status != CORE_STATE_PROFILES_OK || stats.cache_hit || stats.valid != count) {
+                fprintf(stderr, "cold load failed (%d)\n", (int)status);
+                return EXIT_FAILURE;
+            }
+            status = core_state_profiles_load(dir, cache_path, NULL, cache, count, &stats);
+            double t2 = now_seconds();
+            if (status != CORE_STATE_PROFILES_OK || !stats.cache_hit || stats.valid != count) {
+                fprintf(stderr, "warm load failed (%d)\n", (int)status);
+                return EXIT_FAILURE;
+            }
+            cold = (t1 - t0) < cold ? (t1 - t0) : cold;
+            warm = (t2 - t1) < warm ? (t2 - t1) : warm;
+        }
+        printf("%8zu   %16.3f ms   %6.3f ms   %6.1fx   %7zu B\n", count, cold * 1e3, warm * 1e3, cold / warm,
+               CORE_STATE_PROFILE_CACHE_SIZE(count));
+
+        free(cache);
+        remove_dir(dir, cache_path);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+#include "core_state_reference.h"
+
+#include <math.h>
+
+static inline float clampf(float value, float min, float max)
+{
+    if (value < min) {
+        return min;
+    }
+    if (value > max) {
+        return max;
+    }
+    return value;
+}
+
+void core_state_reference_update(core_state_slot_t *slots, size_t count, float time_s, float delta_seconds,
+                                 uint32_t now_epoch)
+{
+    for (size_t i = 0; i < count; ++i) {
+        core_state_slot_t *slot = &slots[i];
+        float wave = sinf(time_s * slot->cycle_speed + slot->phase_offset);
+        float wave_secondary = cosf(time_s * slot->cycle_speed * 0.7f + slot->phase_offset * 1.2f);
+
+        slot->current_temp_day = slot->base_temp_day + wave * 1.8f;
+        slot->current_temp_night = slot->base_temp_night + wave * 1.0f;
+        slot->current_humidity_day = clampf(slot->base_humidity_day + wave_secondary * 6.0f, 30.0f, 95.0f);
+        slot->current_humidity_night = clampf(slot->base_humidity_night + wave_secondary * 4.0f, 40.0f, 98.0f);
+        slot->current_lux_day = clampf(slot->base_lux_day + wave * 80.0f, 50.0f, 900.0f);
+        slot->current_lux_night = clampf(slot->base_lux_night + (wave_secondary + 1.0f) * 2.0f, 0.0f, 20.0f);
+
+        float enrichment = fmaxf(slot->enrichment_factor, 0.5f);
+        float hydration_target = isfinite(slot->target_hydration_pct) ? slot->target_hydration_pct : slot->hydration_pct;
+        float stress_target = isfinite(slot->target_stress_pct) ? slot->target_stress_pct : slot->stress_pct;
+        float health_target = isfinite(slot->target_health_pct) ? slot->target_health_pct : slot->health_pct;
+        float hydration_span = fmaxf(5.0f, 12.0f / enrichment);
+
+        float interval_hours = slot->feeding_interval_hours;
+        float interval_seconds = (interval_hours > 0.0f) ? interval_hours * 3600.0f : 0.0f;
+        float elapsed_seconds = 0.0f;
+        if (interval_seconds > 0.0f && now_epoch >= slot->last_feeding_timestamp) {
+            elapsed_seconds = (float)(now_epoch - slot->last_feeding_timestamp);
+        }
+
+        if (interval_seconds > 0.0f) {
+            if (elapsed_seconds >= interval_seconds) {
+                slot->last_feeding_timestamp = now_epoch;
+                float recovery = fminf(slot->feeding_intake_pct * 0.12f, 10.0f);
+                slot->hydration_pct = clampf(hydration_target + recovery, 0.0f, 100.0f);
+                slot->stress_pct = clampf(stress_target - recovery * 0.6f, 0.0f, 100.0f);
+                elapsed_seconds = 0.0f;
+            } else {
+                float progress = elapsed_seconds / interval_seconds;
+                float min_hydration = clampf(hydration_target - hydration_span, 0.0f, hydration_target);
+                float desired_hydration = hydration_target - (hydration_target - min_hydration) * progress;
+                float hydration_smooth = fminf(delta_seconds * 0.8f, 1.0f);
+                slot->hydration_pct += (desired_hydration - slot->hydration_pct) * hydration_smooth;
+            }
+        } else {
+            float hydration_wave = sinf(time_s * slot->cycle_speed * 0.8f + slot->phase_offset) * (hydration_span * 0.25f);
+            float desired_hydration = hydration_target + hydration_wave;
+            float hydration_smooth = fminf(delta_seconds * 0.8f, 1.0f);
+            slot->hydration_pct += (desired_hydration - slot->hydration_pct) * hydration_smooth;
+        }
+        slot->hydration_pct = clampf(slot->hydration_pct, 0.0f, 100.0f);
+
+        float stress_wave = cosf(time_s * slot->cycle_speed * 0.55f + slot->phase_offset) * (6.0f / enrichment);
+        float desired_stress = clampf(stress_target + stress_wave, 0.0f, 100.0f);
+        float stress_smooth = fminf(delta_seconds * 0.6f, 1.0f);
+        slot->stress_pct += (desired_stress - slot->stress_pct) * stress_smooth;
+        slot->stress_pct = clampf(slot->stress_pct, 0.0f, 100.0f);
+
+        float activity_base = 0.6f - slot->stress_pct * 0.0035f + slot->hydration_pct * 0.0025f;
+        float activity_variation = 0.15f * sinf(time_s * slot->cycle_speed * 1.4f + slot->phase_offset);
+        slot->activity_score = clampf(activity_base + activity_variation, 0.0f, 1.0f);
+
+        float health_offset = (slot->hydration_pct - hydration_target) * 0.2f - (slot->stress_pct - stress_target) * 0.25f;
+        float desired_health = clampf(health_target + health_offset, 0.0f, 100.0f);
+        float health_smooth = fminf(delta_seconds * 0.5f, 1.0f);
+        slot->health_pct += (desired_health - slot->health_pct) * health_smooth;
+        slot->health_pct = clampf(slot->health_pct, 0.0f, 100.0f);
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+/*
+ * Boucle de mise à jour d'origine de core_state_manager (tableau de
+ * core_state_slot_t, sinf/cosf), gardée comme référence pour le test et le banc
+ * du noyau SoA.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "state/core_state_kernel.h"
+
+void core_state_reference_update(core_state_slot_t *slots, size_t count, float time_s, float delta_seconds,
+                                 uint32_t now_epoch);
@@ -0,0 +1,42 @@
+#pragma once
+
+/*
+ * Mini-harnais d'assertions pour les tests hôtes (Linux). Les tests Unity
+ * embarqués restent dans les composants `*_tests` ; ces exécutables ne couvrent
+ * que le code portable de `common/`.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int s_host_test_failures;
+
+#define HOST_TEST_ASSERT(cond)                                                              \
+    do {                                                                                    \
+        if (!(cond)) {                                                                      \
+            fprintf(stderr, "%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #cond);    \
+            s_host_test_failures++;                                                         \
+            return;                                                                         \
+        }                                                                                   \
+    } while (0)
+
+#define HOST_TEST_ASSERT_EQ(expected, actual)                                               \
+    do {                                                                                    \
+        long long e_ = (long long)(expected);                                               \
+        long long a_ = (long long)(actual);                                                 \
+        if (e_ != a_) {                                                                     \
+            fprintf(stderr, "%s:%d: %s == %s failed (%lld != %lld)\n", __FILE__, __LINE__,  \
+                    #expected, #actual, e_, a_);                                            \
+            s_host_test_failures++;                                                         \
+            return;                                                                         \
+        }                                                                                   \
+    } while (0)
+
+#define HOST_TEST_RUN(fn)                                                                   \
+    do {                                                                                    \
+        int before_ = s_host_test_failures;                                                 \
+        fn();                                                                               \
+        printf("%s %s\n", s_host_test_failures == before_ ? "PASS" : "FAIL", #fn);          \
+    } while (0)
+
+#define HOST_TEST_EXIT() (s_host_test_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE)
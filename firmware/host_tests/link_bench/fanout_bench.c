@@ -0,0 +1,369 @@
+/*
+ * Banc de diffusion du cœur vers plusieurs afficheurs : core_host_link.c
+ * publie vers 1 à 3 afficheurs scriptés (socketpair non cadencés) qui
+ * répondent au HELLO, renvoient les PING et comptent les octets d'état reçus.
+ *
+ *   fanout_bench [--terrariums N] [--frames N] [--verbose]
+ *
+ * Mesure le temps CPU du thread publieur par core_host_link_send_state à
+ * mesure que les afficheurs rejoignent le lien, dans deux cas : tous abonnés
+ * à tout (les afficheurs partagent l'encodage de chaque publication), puis
+ * chacun abonné à un terrarium différent (un delta encodé par afficheur).
+ * Le coût d'écriture sur les sockets est porté par les tâches TX et n'entre
+ * pas dans la mesure. La file d'émission de chaque afficheur est relevée à
+ * la fin (profondeur maximale, abandons, latence d'envoi).
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "link/core_host_link.h"
+#include "link/core_link_stream.h"
+#include "link/core_link_subscription.h"
+#include "link/core_link_transport_posix.h"
+
+#define BENCH_DISPLAYS 3U
+#define BENCH_DEFAULT_TERRARIUMS 16U
+#define BENCH_DEFAULT_FRAMES 400U
+#define BENCH_WAIT_MS 5000
+#define BENCH_SETTLE_MS 20
+#define BENCH_RX_RING 4096U
+#define BENCH_DISPLAY_CAPS \
+    (CORE_LINK_CAP_DISPLAY | CORE_LINK_CAP_FRAME_V2 | CORE_LINK_CAP_COMPACT_STATE | CORE_LINK_CAP_FRAGMENTS | \
+     CORE_LINK_CAP_NAME_TABLE | CORE_LINK_CAP_TOUCH_BATCH)
+#define BENCH_DISPLAY_CAPS_EXT \
+    (CORE_LINK_CAP_EXT_SAMPLE_TIME | CORE_LINK_CAP_EXT_FULL_COMPRESSED | CORE_LINK_CAP_EXT_SUBSCRIBE)
+
+typedef struct {
+    unsigned terrariums;
+    unsigned frames;
+} bench_options_t;
+
+// Stands in for core_link.c: just enough protocol to keep the core publishing.
+typedef struct {
+    uint8_t index;
+    core_link_transport_t transport;
+    core_link_posix_transport_t transport_state;
+    core_link_transport_t core_transport;
+    core_link_posix_transport_t core_state;
+    pthread_t thread;
+    pthread_mutex_t write_lock;
+    atomic_bool enabled;
+    atomic_uint state_frames;
+    atomic_uint state_bytes;
+    uint8_t rx_storage[CORE_LINK_STREAM_STORAGE_SIZE(BENCH_RX_RING)];
+} scripted_display_t;
+
+static scripted_display_t s_displays[BENCH_DISPLAYS];
+static core_link_state_frame_t *s_core_frame;
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [--terrariums N] [--frames N] [--verbose]\n", argv0);
+}
+
+static bool parse_options(int argc, char **argv, bench_options_t *out)
+{
+    *out = (bench_options_t){
+        .terrariums = BENCH_DEFAULT_TERRARIUMS,
+        .frames = BENCH_DEFAULT_FRAMES,
+    };
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--terrariums") == 0 && i + 1 < argc) {
+            out->terrariums = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            out->frames = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            host_log_level = 3;
+        } else {
+            return false;
+        }
+    }
+    return out->terrariums >= BENCH_DISPLAYS && out->terrariums <= CORE_LINK_MAX_TERRARIUMS && out->frames > 0;
+}
+
+static void fill_snapshot(core_link_terrarium_snapshot_t *snap, uint8_t id)
+{
+    static const char *names[][2] = {
+        {"Python regius", "Python royal"},
+        {"Pogona vitticeps", "Dragon barbu"},
+        {"Correlophus ciliatus", "Gecko a crete"},
+        {"Eublepharis macularius", "Gecko leopard"},
+    };
+    memset(snap, 0, sizeof(*snap));
+    snap->terrarium_id = id;
+    snprintf(snap->scientific_name, sizeof(snap->scientific_name), "%s", names[id % 4][0]);
+    snprintf(snap->common_name, sizeof(snap->common_name), "%s", names[id % 4][1]);
+    snap->temp_day_c = 30.0f + (float)(id % 5);
+    snap->temp_night_c = 22.0f;
+    snap->humidity_day_pct = 60.0f;
+    snap->humidity_night_pct = 70.0f;
+    snap->lux_day = 400.0f;
+    snap->lux_night = 5.0f;
+    snap->hydration_pct = 90.0f;
+    snap->stress_pct = 15.0f;
+    snap->health_pct = 95.0f;
+    snap->last_feeding_timestamp = 1700000000u;
+    snap->activity_score = 0.5f;
+}
+
+// Same drift as link_bench: a quarter of the terrariums move between publications.
+static void step_core_frame(uint32_t epoch)
+{
+    s_core_frame->epoch_seconds = epoch;
+    s_core_frame->sample_us = esp_timer_get_time();
+    for (uint8_t i = 0; i < s_core_frame->terrarium_count; ++i) {
+        if ((i + epoch) % 4 != 0 && i != epoch % s_core_frame->terrarium_count) {
+            continue;
+        }
+        core_link_terrarium_snapshot_t *snap = &s_core_frame->terrariums[i];
+        snap->temp_day_c += (epoch & 1) ? 0.05f : -0.05f;
+        snap->humidity_day_pct += (epoch & 2) ? 0.2f : -0.2f;
+        snap->activity_score = 0.3f + (float)((epoch + i) % 10) * 0.05f;
+    }
+}
+
+static void display_send(scripted_display_t *display, core_link_msg_type_t type, const void *payload, uint16_t length)
+{
+    uint8_t frame[CORE_LINK_FRAME_MAX_SIZE];
+    size_t written = core_link_frame_encode(frame, sizeof(frame), (uint8_t)type, payload, length);
+    pthread_mutex_lock(&display->write_lock);
+    core_link_transport_write(&display->transport, frame, written);
+    pthread_mutex_unlock(&display->write_lock);
+}
+
+static void display_handle(scripted_display_t *display, const core_link_stream_frame_t *frame)
+{
+    switch (frame->type) {
+        case CORE_LINK_MSG_HELLO: {
+            // Unsequenced replies are accepted whatever the negotiated framing.
+            const uint8_t ack[] = {CORE_LINK_PROTOCOL_VERSION, BENCH_DISPLAY_CAPS, BENCH_DISPLAY_CAPS_EXT, 0, 0};
+            const uint8_t ready[] = {0x00, 0x04, 0x58, 0x02, CORE_LINK_PROTOCOL_VERSION}; /* 1024x600 */
+            display_send(display, CORE_LINK_MSG_HELLO_ACK, ack, sizeof(ack));
+            display_send(display, CORE_LINK_MSG_DISPLAY_READY, ready, sizeof(ready));
+            break;
+        }
+        case CORE_LINK_MSG_PING:
+            display_send(display, CORE_LINK_MSG_PONG, frame->payload, frame->length);
+            break;
+        case CORE_LINK_MSG_STATE_FULL:
+        case CORE_LINK_MSG_STATE_DELTA:
+        case CORE_LINK_MSG_STATE_FULL_COMPACT:
+        case CORE_LINK_MSG_STATE_DELTA_COMPACT:
+        case CORE_LINK_MSG_STATE_FRAGMENT:
+        case CORE_LINK_MSG_STATE_FULL_COMPRESSED:
+        case CORE_LINK_MSG_NAME_TABLE:
+            atomic_fetch_add(&display->state_frames, 1);
+            atomic_fetch_add(&display->state_bytes, frame->length);
+            break;
+        default:
+            break;
+    }
+}
+
+static void *display_thread(void *arg)
+{
+    scripted_display_t *display = arg;
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, display->rx_storage, sizeof(display->rx_storage));
+    while (true) {
+        uint8_t *window = NULL;
+        size_t room = core_link_stream_write_window(&stream, &window);
+        int got = room > 0 ? core_link_transport_read(&display->transport, window, room, 50) : 0;
+        if (got > 0) {
+            core_link_stream_commit(&stream, (size_t)got);
+        }
+        core_link_stream_frame_t frame;
+        while (core_link_stream_next(&stream, &frame)) {
+            // A panel that is still powered off: HELLOs go unanswered.
+            if (atomic_load(&display->enabled)) {
+                display_handle(display, &frame);
+            }
+        }
+    }
+    return NULL;
+}
+
+static void display_subscribe(scripted_display_t *display, const core_link_subscription_t *sub)
+{
+    uint8_t payload[CORE_LINK_SUBSCRIBE_HEADER_SIZE + CORE_LINK_MAX_TERRARIUMS];
+    size_t length = core_link_subscription_encode(sub, payload, sizeof(payload));
+    display_send(display, CORE_LINK_MSG_SUBSCRIBE, payload, (uint16_t)length);
+}
+
+static int64_t thread_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+typedef struct {
+    double cpu_us;        /* par publication */
+    double bytes_per_display;
+} run_result_t;
+
+// Publishes `frames` states and charges the publisher thread's CPU time to them.
+static bool run_publications(unsigned displays, unsigned frames, uint32_t *epoch, run_result_t *out)
+{
+    uint32_t bytes_before = 0;
+    for (unsigned i = 0; i < displays; ++i) {
+        bytes_before += atomic_load(&s_displays[i].state_bytes);
+    }
+    int64_t cpu_ns = 0;
+    for (unsigned n = 0; n < frames; ++n) {
+        step_core_frame(++*epoch);
+        int64_t start = thread_cpu_ns();
+        esp_err_t err = core_host_link_send_state(s_core_frame);
+        cpu_ns += thread_cpu_ns() - start;
+        if (err != ESP_OK) {
+            fprintf(stderr, "publication %u failed: %s\n", (unsigned)*epoch, esp_err_to_name(err));
+            return false;
+        }
+        // Lets the TX tasks drain so no frame waits on a full queue.
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    vTaskDelay(pdMS_TO_TICKS(BENCH_SETTLE_MS));
+    uint32_t bytes_after = 0;
+    for (unsigned i = 0; i < displays; ++i) {
+        bytes_after += atomic_load(&s_displays[i].state_bytes);
+    }
+    out->cpu_us = (double)cpu_ns / 1000.0 / frames;
+    out->bytes_per_display = (double)(bytes_after - bytes_before) / frames / displays;
+    return true;
+}
+
+static bool wait_for_first_state(scripted_display_t *display)
+{
+    for (int waited = 0; waited < BENCH_WAIT_MS; waited += 10) {
+        if (atomic_load(&display->state_frames) > 0) {
+            return true;
+        }
+        // Only displays without a handshake get the HELLO.
+        core_host_link_send_hello();
+        vTaskDelay(pdMS_TO_TICKS(10));
+        if (core_host_link_is_display_ready()) {
+            core_host_link_send_state(s_core_frame);
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    bench_options_t opt;
+    if (!parse_options(argc, argv, &opt)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    (void)esp_timer_get_time();
+
+    for (unsigned i = 0; i < BENCH_DISPLAYS; ++i) {
+        scripted_display_t *display = &s_displays[i];
+        display->index = (uint8_t)i;
+        pthread_mutex_init(&display->write_lock, NULL);
+        if (!core_link_transport_posix_pair(CORE_LINK_POSIX_SOCKETPAIR, 0, &display->transport,
+                                            &display->transport_state, &display->core_transport,
+                                            &display->core_state)) {
+            perror("transport");
+            return EXIT_FAILURE;
+        }
+    }
+
+    s_core_frame = calloc(1, CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS));
+    if (!s_core_frame) {
+        return EXIT_FAILURE;
+    }
+    core_link_state_frame_init(s_core_frame, CORE_LINK_MAX_TERRARIUMS);
+    s_core_frame->terrarium_count = (uint8_t)opt.terrariums;
+    for (uint8_t i = 0; i < opt.terrariums; ++i) {
+        fill_snapshot(&s_core_frame->terrariums[i], i);
+    }
+    s_core_frame->epoch_seconds = 1;
+
+    core_host_link_config_t core_cfg = {
+        .task_stack_size = 4096,
+        .task_priority = 6,
+        .handshake_timeout_ticks = pdMS_TO_TICKS(BENCH_WAIT_MS),
+        .transport = &s_displays[0].core_transport,
+    };
+    if (core_host_link_init(&core_cfg) != ESP_OK) {
+        return EXIT_FAILURE;
+    }
+    for (unsigned i = 1; i < BENCH_DISPLAYS; ++i) {
+        core_host_display_config_t display_cfg = {.transport = &s_displays[i].core_transport};
+        if (core_host_link_add_display(&display_cfg) != ESP_OK) {
+            return EXIT_FAILURE;
+        }
+    }
+    if (core_host_link_start() != ESP_OK) {
+        return EXIT_FAILURE;
+    }
+    for (unsigned i = 0; i < BENCH_DISPLAYS; ++i) {
+        pthread_create(&s_displays[i].thread, NULL, display_thread, &s_displays[i]);
+    }
+
+    printf("fanout_bench: socketpair, unpaced, %u terrariums, %u publications per run\n", opt.terrariums, opt.frames);
+    printf("   displays | all fields: CPU/publish  state B/display | 1 terrarium each: CPU/publish  state B/display\n");
+
+    uint32_t epoch = 1;
+    for (unsigned n = 1; n <= BENCH_DISPLAYS; ++n) {
+        scripted_display_t *joining = &s_displays[n - 1];
+        atomic_store(&joining->enabled, true);
+        if (!wait_for_first_state(joining)) {
+            fprintf(stderr, "display %u never received a state\n", n - 1);
+            return EXIT_FAILURE;
+        }
+
+        // Shared: every display holds the same baseline once it is past its first full frame.
+        run_result_t shared;
+        core_link_subscription_t all;
+        core_link_subscription_all(&all);
+        if (!run_publications(n, opt.frames, &epoch, &shared)) {
+            return EXIT_FAILURE;
+        }
+
+        // Per display: distinct subscriptions filter each delta differently.
+        for (unsigned i = 0; i < n; ++i) {
+            core_link_subscription_t sub;
+            core_link_subscription_none(&sub, CORE_LINK_DELTA_FIELD_ALL, 0);
+            core_link_subscription_add_terrarium(&sub, (uint8_t)i);
+            display_subscribe(&s_displays[i], &sub);
+        }
+        vTaskDelay(pdMS_TO_TICKS(BENCH_SETTLE_MS));
+        run_result_t filtered;
+        if (!run_publications(n, opt.frames, &epoch, &filtered)) {
+            return EXIT_FAILURE;
+        }
+        for (unsigned i = 0; i < n; ++i) {
+            display_subscribe(&s_displays[i], &all);
+        }
+        vTaskDelay(pdMS_TO_TICKS(BENCH_SETTLE_MS));
+
+        printf("   %8u | %19.1f us  %15.1f | %25.1f us  %15.1f\n", n, shared.cpu_us, shared.bytes_per_display,
+               filtered.cpu_us, filtered.bytes_per_display);
+    }
+
+    for (size_t i = 0; i < core_host_link_get_display_count(); ++i) {
+        core_link_tx_stats_t tx;
+        if (core_host_link_get_tx_stats_for(i, &tx) != ESP_OK) {
+            return EXIT_FAILURE;
+        }
+        const core_link_tx_class_stats_t *state = &tx.classes[CORE_LINK_TX_PRIO_STATE];
+        double mean_ms = state->sent ? (double)state->total_latency_us / (double)state->sent / 1000.0 : 0.0;
+        printf("   display %u TX   : queue high-water %u/%u, %u state frames sent, %u dropped, send latency mean "
+               "%.2f ms, max %.2f ms\n",
+               (unsigned)i, (unsigned)tx.max_depth, (unsigned)tx.capacity, (unsigned)state->sent,
+               (unsigned)state->dropped, mean_ms, (double)state->max_latency_us / 1000.0);
+    }
+    return EXIT_SUCCESS;
+}
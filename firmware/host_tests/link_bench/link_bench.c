@@ -0,0 +1,516 @@
+/*
+ * Banc de bout en bout du Core Link : core_link.c (afficheur) et
+ * core_host_link.c (cœur) tournent dans le même processus, reliés par une
+ * paire pty ou socketpair cadencée au débit UART demandé.
+ *
+ *   link_bench [--baud N] [--baud-max N] [--pty] [--terrariums N] [--frames N] [--verbose]
+ *
+ * Mesures : latence de poignée de main (premier HELLO -> DISPLAY_READY vu
+ * par le cœur), latence et débit des deltas d'état, durée d'une
+ * resynchronisation (REQUEST_STATE -> trame complète appliquée), octets par
+ * delta quand l'afficheur ne s'abonne qu'à un champ d'un terrarium (et
+ * vérification qu'un abonnement vide, celui de Docs, ne reçoit aucune donnée
+ * de terrarium même au rafraîchissement périodique), RTT des
+ * PING horodatés et compteurs de télémétrie des deux extrémités. `--baud 0`
+ * supprime le cadencement pour isoler le coût logiciel. `--baud-max` laisse
+ * le cœur négocier un débit plus élevé avant les mesures (le socketpair ne
+ * corrompt jamais rien : chaque palier est confirmé au premier essai).
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include "link/core_host_link.h"
+#include "link/core_link.h"
+#include "link/core_link_transport_posix.h"
+
+#define BENCH_DEFAULT_BAUD 2000000U
+#define BENCH_DEFAULT_TERRARIUMS 16U
+#define BENCH_DEFAULT_FRAMES 500U
+#define BENCH_LATENCY_FRAMES 50U
+#define BENCH_RTT_PINGS 20U
+#define BENCH_REFRESH_FRAMES 30U /* one epoch second per frame: three periodic refreshes */
+#define BENCH_CLOCK_WAIT_MS 3000U
+#define BENCH_WAIT_MS 5000
+#define BENCH_BAUD_WAIT_MS 30000
+
+typedef struct {
+    uint32_t baud;
+    uint32_t baud_max;
+    bool pty;
+    unsigned terrariums;
+    unsigned frames;
+} bench_options_t;
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_cond = PTHREAD_COND_INITIALIZER;
+static uint32_t s_last_epoch;
+static uint32_t s_states_received;
+static int64_t s_last_state_us;
+static core_link_state_frame_t *s_core_frame;
+static core_link_state_frame_t *s_display_frame; /* last state handed to the UI, under s_lock */
+static pthread_mutex_t s_core_frame_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [--baud N] [--baud-max N] [--pty] [--terrariums N] [--frames N] [--verbose]\n", argv0);
+}
+
+static bool parse_options(int argc, char **argv, bench_options_t *out)
+{
+    *out = (bench_options_t){
+        .baud = BENCH_DEFAULT_BAUD,
+        .terrariums = BENCH_DEFAULT_TERRARIUMS,
+        .frames = BENCH_DEFAULT_FRAMES,
+    };
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--baud") == 0 && i + 1 < argc) {
+            out->baud = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--baud-max") == 0 && i + 1 < argc) {
+            out->baud_max = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--pty") == 0) {
+            out->pty = true;
+        } else if (strcmp(argv[i], "--terrariums") == 0 && i + 1 < argc) {
+            out->terrariums = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            out->frames = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            host_log_level = 3;
+        } else {
+            return false;
+        }
+    }
+    return out->terrariums >= 1 && out->terrariums <= CORE_LINK_MAX_TERRARIUMS && out->frames > 0;
+}
+
+static double elapsed_ms(int64_t start_us, int64_t end_us)
+{
+    return (double)(end_us - start_us) / 1000.0;
+}
+
+static void fill_snapshot(core_link_terrarium_snapshot_t *snap, uint8_t id)
+{
+    static const char *names[][2] = {
+        {"Python regius", "Python royal"},
+        {"Pogona vitticeps", "Dragon barbu"},
+        {"Correlophus ciliatus", "Gecko a crete"},
+        {"Eublepharis macularius", "Gecko leopard"},
+    };
+    memset(snap, 0, sizeof(*snap));
+    snap->terrarium_id = id;
+    snprintf(snap->scientific_name, sizeof(snap->scientific_name), "%s", names[id % 4][0]);
+    snprintf(snap->common_name, sizeof(snap->common_name), "%s", names[id % 4][1]);
+    snap->temp_day_c = 30.0f + (float)(id % 5);
+    snap->temp_night_c = 22.0f;
+    snap->humidity_day_pct = 60.0f;
+    snap->humidity_night_pct = 70.0f;
+    snap->lux_day = 400.0f;
+    snap->lux_night = 5.0f;
+    snap->hydration_pct = 90.0f;
+    snap->stress_pct = 15.0f;
+    snap->health_pct = 95.0f;
+    snap->last_feeding_timestamp = 1700000000u;
+    snap->activity_score = 0.5f;
+}
+
+// One simulation step: a few terrariums drift, as between two real publications.
+static void step_core_frame(uint32_t epoch)
+{
+    pthread_mutex_lock(&s_core_frame_lock);
+    s_core_frame->epoch_seconds = epoch;
+    s_core_frame->sample_us = esp_timer_get_time();
+    for (uint8_t i = 0; i < s_core_frame->terrarium_count; ++i) {
+        if ((i + epoch) % 4 != 0 && i != epoch % s_core_frame->terrarium_count) {
+            continue;
+        }
+        core_link_terrarium_snapshot_t *snap = &s_core_frame->terrariums[i];
+        snap->temp_day_c += (epoch & 1) ? 0.05f : -0.05f;
+        snap->humidity_day_pct += (epoch & 2) ? 0.2f : -0.2f;
+        snap->activity_score = 0.3f + (float)((epoch + i) % 10) * 0.05f;
+    }
+    pthread_mutex_unlock(&s_core_frame_lock);
+}
+
+static esp_err_t publish_core_frame(void)
+{
+    pthread_mutex_lock(&s_core_frame_lock);
+    esp_err_t err = core_host_link_send_state(s_core_frame);
+    pthread_mutex_unlock(&s_core_frame_lock);
+    return err;
+}
+
+static void on_display_state(const core_link_state_frame_t *frame, void *ctx)
+{
+    (void)ctx;
+    pthread_mutex_lock(&s_lock);
+    s_last_epoch = frame->epoch_seconds;
+    s_states_received++;
+    s_display_frame->terrarium_count = frame->terrarium_count;
+    memcpy(s_display_frame->terrariums, frame->terrariums, (size_t)frame->terrarium_count * sizeof(frame->terrariums[0]));
+    s_last_state_us = esp_timer_get_time();
+    // No LVGL here: "on screen" is the moment the UI callback runs.
+    core_link_record_display_latency(frame->sample_us);
+    pthread_cond_broadcast(&s_cond);
+    pthread_mutex_unlock(&s_lock);
+}
+
+// The core application publishes a forced snapshot on DISPLAY_READY and REQUEST_STATE.
+static void on_core_display_ready(const core_host_display_info_t *info, void *ctx)
+{
+    (void)info;
+    (void)ctx;
+    publish_core_frame();
+}
+
+static void on_core_state_request(void *ctx)
+{
+    (void)ctx;
+    // The display asks for state while booting; DISPLAY_READY answers that one.
+    if (core_host_link_is_display_ready()) {
+        publish_core_frame();
+    }
+}
+
+static bool wait_for_epoch(uint32_t epoch, int64_t *out_us)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += BENCH_WAIT_MS / 1000;
+    bool ok = true;
+    pthread_mutex_lock(&s_lock);
+    while (s_last_epoch != epoch) {
+        if (pthread_cond_timedwait(&s_cond, &s_lock, &deadline) != 0) {
+            ok = s_last_epoch == epoch;
+            break;
+        }
+    }
+    if (out_us) {
+        *out_us = s_last_state_us;
+    }
+    pthread_mutex_unlock(&s_lock);
+    return ok;
+}
+
+static uint32_t state_bytes_sent(void)
+{
+    core_link_tx_stats_t stats;
+    core_host_link_get_tx_stats(&stats);
+    return stats.bytes_sent;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+int main(int argc, char **argv)
+{
+    bench_options_t opt;
+    if (!parse_options(argc, argv, &opt)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    (void)esp_timer_get_time();
+
+    static core_link_posix_transport_t display_end;
+    static core_link_posix_transport_t core_end;
+    core_link_transport_t display_transport;
+    core_link_transport_t core_transport;
+    if (!core_link_transport_posix_pair(opt.pty ? CORE_LINK_POSIX_PTY : CORE_LINK_POSIX_SOCKETPAIR, opt.baud,
+                                        &display_transport, &display_end, &core_transport, &core_end)) {
+        perror("transport");
+        return EXIT_FAILURE;
+    }
+
+    s_core_frame = calloc(1, CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS));
+    s_display_frame = calloc(1, CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS));
+    core_link_state_frame_t *held = calloc(1, CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS));
+    if (!s_core_frame || !s_display_frame || !held) {
+        return EXIT_FAILURE;
+    }
+    core_link_state_frame_init(s_core_frame, CORE_LINK_MAX_TERRARIUMS);
+    s_core_frame->terrarium_count = (uint8_t)opt.terrariums;
+    for (uint8_t i = 0; i < opt.terrariums; ++i) {
+        fill_snapshot(&s_core_frame->terrariums[i], i);
+    }
+    s_core_frame->epoch_seconds = 1;
+
+    core_link_config_t display_cfg = {
+        .baud_rate = (int)opt.baud,
+        .baud_rate_max = (int)opt.baud_max,
+        .task_stack_size = 4096,
+        .task_priority = 6,
+        .handshake_timeout_ticks = pdMS_TO_TICKS(BENCH_WAIT_MS),
+        .transport = &display_transport,
+    };
+    core_host_link_config_t core_cfg = {
+        .baud_rate = (int)opt.baud,
+        .baud_rate_max = (int)opt.baud_max,
+        .task_stack_size = 4096,
+        .task_priority = 6,
+        .handshake_timeout_ticks = pdMS_TO_TICKS(BENCH_WAIT_MS),
+        .transport = &core_transport,
+    };
+    if (core_link_init(&display_cfg) != ESP_OK || core_host_link_init(&core_cfg) != ESP_OK) {
+        return EXIT_FAILURE;
+    }
+    core_link_register_state_callback(on_display_state, NULL);
+    core_host_link_register_display_ready_cb(on_core_display_ready, NULL);
+    core_host_link_register_request_cb(on_core_state_request, NULL);
+    if (core_link_start() != ESP_OK || core_host_link_start() != ESP_OK) {
+        return EXIT_FAILURE;
+    }
+
+    printf("link_bench: %s, %s, %u terrariums\n", opt.pty ? "pty" : "socketpair",
+           opt.baud ? "paced" : "unpaced", opt.terrariums);
+    if (opt.baud) {
+        printf("   wire rate %u bps (8N1)\n", (unsigned)opt.baud);
+    }
+
+    // Handshake: HELLO until acknowledged, then DISPLAY_READY and the first full frame.
+    int64_t t0 = esp_timer_get_time();
+    while (!core_host_link_is_handshake_complete()) {
+        core_host_link_send_hello();
+        if (core_link_wait_for_handshake(pdMS_TO_TICKS(100)) == ESP_OK) {
+            break;
+        }
+    }
+    core_link_send_display_ready();
+    if (core_host_link_wait_for_display_ready(pdMS_TO_TICKS(BENCH_WAIT_MS)) != ESP_OK) {
+        fprintf(stderr, "display never became ready\n");
+        return EXIT_FAILURE;
+    }
+    int64_t t_ready = esp_timer_get_time();
+    int64_t t_first_state = 0;
+    if (!wait_for_epoch(1, &t_first_state)) {
+        fprintf(stderr, "initial state never reached the display\n");
+        return EXIT_FAILURE;
+    }
+    printf("   handshake      : %8.2f ms to DISPLAY_READY, %8.2f ms to first state (peer v%u)\n",
+           elapsed_ms(t0, t_ready), elapsed_ms(t0, t_first_state), core_host_link_get_peer_version());
+
+    uint32_t epoch = 1;
+    if (opt.baud && opt.baud_max > opt.baud) {
+        // The core steps up one rate every few clean windows until both ends top out.
+        core_link_stats_snapshot_t snap;
+        int64_t begin = esp_timer_get_time();
+        do {
+            // Keep publishing so the display's state watchdog stays quiet.
+            step_core_frame(++epoch);
+            publish_core_frame();
+            vTaskDelay(pdMS_TO_TICKS(50));
+            core_host_link_get_link_stats(&snap);
+        } while (snap.counters[CORE_LINK_STAT_BAUD_RATE] < opt.baud_max &&
+                 elapsed_ms(begin, esp_timer_get_time()) < BENCH_BAUD_WAIT_MS);
+        printf("   baud rate      : %u -> %u bps in %.1f s (%u switches)\n", (unsigned)opt.baud,
+               (unsigned)snap.counters[CORE_LINK_STAT_BAUD_RATE], elapsed_ms(begin, esp_timer_get_time()) / 1000.0,
+               (unsigned)snap.counters[CORE_LINK_STAT_BAUD_SWITCHES]);
+    }
+
+    // Delta latency: one publication at a time, send -> display callback.
+    // The display probes the RTT on its own timer; its first PONG syncs the clocks,
+    // after which STATE frames carry a sample time the display can convert.
+    core_link_clock_estimate_t clock = {0};
+    for (unsigned i = 0; i < BENCH_CLOCK_WAIT_MS / 10U; ++i) {
+        if (core_link_get_clock_estimate(&clock) == ESP_OK) {
+            break;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    double latencies[BENCH_LATENCY_FRAMES];
+    for (unsigned i = 0; i < BENCH_LATENCY_FRAMES; ++i) {
+        step_core_frame(++epoch);
+        int64_t start = esp_timer_get_time();
+        int64_t done = 0;
+        if (publish_core_frame() != ESP_OK || !wait_for_epoch(epoch, &done)) {
+            fprintf(stderr, "delta %u lost\n", (unsigned)epoch);
+            return EXIT_FAILURE;
+        }
+        latencies[i] = elapsed_ms(start, done);
+    }
+    qsort(latencies, BENCH_LATENCY_FRAMES, sizeof(latencies[0]), compare_double);
+    printf("   delta latency  : p50 %6.3f ms, p95 %6.3f ms, max %6.3f ms\n", latencies[BENCH_LATENCY_FRAMES / 2],
+           latencies[BENCH_LATENCY_FRAMES * 95 / 100], latencies[BENCH_LATENCY_FRAMES - 1]);
+
+    // Delta throughput: back-to-back publications, bounded by the TX queue.
+    uint32_t bytes_before = state_bytes_sent();
+    pthread_mutex_lock(&s_lock);
+    uint32_t received_before = s_states_received;
+    pthread_mutex_unlock(&s_lock);
+    int64_t start = esp_timer_get_time();
+    for (unsigned i = 0; i < opt.frames; ++i) {
+        step_core_frame(++epoch);
+        if (publish_core_frame() != ESP_OK) {
+            fprintf(stderr, "publish %u failed\n", (unsigned)epoch);
+            return EXIT_FAILURE;
+        }
+    }
+    int64_t done = 0;
+    if (!wait_for_epoch(epoch, &done)) {
+        fprintf(stderr, "last delta never reached the display\n");
+        return EXIT_FAILURE;
+    }
+    uint32_t bytes = state_bytes_sent() - bytes_before;
+    pthread_mutex_lock(&s_lock);
+    uint32_t applied = s_states_received - received_before;
+    pthread_mutex_unlock(&s_lock);
+    double seconds = (double)(done - start) / 1e6;
+    printf("   delta stream   : %u frames in %.1f ms -> %.0f frames/s, %.0f B/frame, %.1f kB/s on the wire\n",
+           applied, seconds * 1000.0, (double)applied / seconds, (double)bytes / (double)opt.frames,
+           (double)bytes / seconds / 1000.0);
+
+    // Same stream while the display only subscribes to one terrarium's day temperature.
+    core_link_subscription_t sub;
+    core_link_subscription_none(&sub, CORE_LINK_DELTA_FIELD_TEMP_DAY, 0);
+    core_link_subscription_add_terrarium(&sub, 0);
+    if (core_link_subscribe(&sub) != ESP_OK) {
+        fprintf(stderr, "subscribe failed\n");
+        return EXIT_FAILURE;
+    }
+    vTaskDelay(pdMS_TO_TICKS(50));
+    bytes_before = state_bytes_sent();
+    for (unsigned i = 0; i < opt.frames; ++i) {
+        step_core_frame(++epoch);
+        if (publish_core_frame() != ESP_OK) {
+            fprintf(stderr, "publish %u failed\n", (unsigned)epoch);
+            return EXIT_FAILURE;
+        }
+    }
+    if (!wait_for_epoch(epoch, NULL)) {
+        fprintf(stderr, "last subscribed delta never reached the display\n");
+        return EXIT_FAILURE;
+    }
+    uint32_t subscribed_bytes = state_bytes_sent() - bytes_before;
+    printf("   subscribed     : %.0f B/frame (1 terrarium, TEMP_DAY only; periodic refresh included)\n",
+           (double)subscribed_bytes / (double)opt.frames);
+
+    // Docs, Settings and About subscribe to nothing: across periodic refreshes the
+    // display must not get a single terrarium field, nor any STATE_FULL.
+    core_link_subscription_none(&sub, 0, 0);
+    if (core_link_subscribe(&sub) != ESP_OK) {
+        fprintf(stderr, "subscribe failed\n");
+        return EXIT_FAILURE;
+    }
+    vTaskDelay(pdMS_TO_TICKS(50));
+    core_link_stats_snapshot_t fulls_before;
+    core_host_link_get_link_stats(&fulls_before);
+    pthread_mutex_lock(&s_lock);
+    held->terrarium_count = s_display_frame->terrarium_count;
+    memcpy(held->terrariums, s_display_frame->terrariums, (size_t)held->terrarium_count * sizeof(held->terrariums[0]));
+    pthread_mutex_unlock(&s_lock);
+    bytes_before = state_bytes_sent();
+    for (unsigned i = 0; i < BENCH_REFRESH_FRAMES; ++i) {
+        step_core_frame(++epoch);
+        if (publish_core_frame() != ESP_OK) {
+            fprintf(stderr, "publish %u failed\n", (unsigned)epoch);
+            return EXIT_FAILURE;
+        }
+    }
+    if (!wait_for_epoch(epoch, NULL)) {
+        fprintf(stderr, "last docs delta never reached the display\n");
+        return EXIT_FAILURE;
+    }
+    uint32_t docs_bytes = state_bytes_sent() - bytes_before;
+    core_link_stats_snapshot_t fulls_after;
+    core_host_link_get_link_stats(&fulls_after);
+    pthread_mutex_lock(&s_lock);
+    bool untouched = s_display_frame->terrarium_count == held->terrarium_count &&
+                     memcmp(s_display_frame->terrariums, held->terrariums,
+                            (size_t)held->terrarium_count * sizeof(held->terrariums[0])) == 0;
+    pthread_mutex_unlock(&s_lock);
+    uint32_t docs_fulls = fulls_after.counters[CORE_LINK_STAT_STATE_FULL] - fulls_before.counters[CORE_LINK_STAT_STATE_FULL];
+    printf("   docs           : %.0f B/frame (no terrarium, no field; %u frames, %u STATE_FULL)\n",
+           (double)docs_bytes / (double)BENCH_REFRESH_FRAMES, BENCH_REFRESH_FRAMES, docs_fulls);
+    if (!untouched || docs_fulls != 0) {
+        fprintf(stderr, "docs subscription still received terrarium data\n");
+        return EXIT_FAILURE;
+    }
+    core_link_subscription_all(&sub);
+    core_link_subscribe(&sub);
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    // Resync: the display asks for a baseline, the core answers with a full frame.
+    double resync_ms = 0.0;
+    const unsigned resyncs = 10;
+    for (unsigned i = 0; i < resyncs; ++i) {
+        step_core_frame(++epoch);
+        pthread_mutex_lock(&s_lock);
+        uint32_t before = s_states_received;
+        pthread_mutex_unlock(&s_lock);
+        int64_t begin = esp_timer_get_time();
+        if (core_link_request_state_sync() != ESP_OK || !wait_for_epoch(epoch, &done)) {
+            fprintf(stderr, "resync %u failed\n", i);
+            return EXIT_FAILURE;
+        }
+        pthread_mutex_lock(&s_lock);
+        bool single = s_states_received == before + 1;
+        pthread_mutex_unlock(&s_lock);
+        if (!single) {
+            fprintf(stderr, "resync %u applied more than one state\n", i);
+        }
+        resync_ms += elapsed_ms(begin, done);
+    }
+    printf("   resync         : %8.2f ms average (REQUEST_STATE -> full frame applied)\n", resync_ms / resyncs);
+
+    // Round trip: timestamped PINGs from the core feed its log2 RTT histogram.
+    for (unsigned i = 0; i < BENCH_RTT_PINGS; ++i) {
+        core_host_link_send_ping();
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    vTaskDelay(pdMS_TO_TICKS(20));
+    core_link_stats_snapshot_t core_stats;
+    core_link_stats_snapshot_t display_stats;
+    core_host_link_get_link_stats(&core_stats);
+    core_link_get_link_stats(&display_stats);
+    printf("   ping RTT       : p50 <= %u us, p95 <= %u us, max %u us over %u PONGs\n",
+           (unsigned)core_link_stats_rtt_percentile_us(&core_stats, 50),
+           (unsigned)core_link_stats_rtt_percentile_us(&core_stats, 95), (unsigned)core_stats.rtt_max_us,
+           (unsigned)core_link_stats_rtt_samples(&core_stats));
+    printf("   counters       : core %u full (%u XOR, %u B saved) / %u delta / %u resync, display %u frames rx, "
+           "%u checksum errors\n",
+           (unsigned)core_stats.counters[CORE_LINK_STAT_STATE_FULL],
+           (unsigned)core_stats.counters[CORE_LINK_STAT_FULL_COMPRESSED],
+           (unsigned)core_stats.counters[CORE_LINK_STAT_FULL_BYTES_SAVED],
+           (unsigned)core_stats.counters[CORE_LINK_STAT_STATE_DELTA],
+           (unsigned)core_stats.counters[CORE_LINK_STAT_RESYNCS],
+           (unsigned)display_stats.counters[CORE_LINK_STAT_FRAMES_RX],
+           (unsigned)display_stats.counters[CORE_LINK_STAT_CHECKSUM_ERRORS]);
+
+    core_link_get_clock_estimate(&clock);
+    if (clock.synced) {
+        // Both ends share one process clock: the offset is the estimator's own error.
+        printf("   clock sync     : offset %+lld us (+/- %u us), drift %d ppb over %u PONGs\n",
+               (long long)clock.offset_us, (unsigned)(clock.min_rtt_us / 2U), (int)clock.drift_ppb,
+               (unsigned)clock.samples);
+    } else {
+        printf("   clock sync     : no PONG from the display's RTT probe\n");
+    }
+    printf("   sample latency : p50 <= %u us, p95 <= %u us, max %u us over %u states\n",
+           (unsigned)core_link_stats_latency_percentile_us(&display_stats, 50),
+           (unsigned)core_link_stats_latency_percentile_us(&display_stats, 95), (unsigned)display_stats.latency_max_us,
+           (unsigned)core_link_stats_latency_samples(&display_stats));
+
+    core_link_tx_stats_t core_tx;
+    core_link_tx_stats_t display_tx;
+    core_host_link_get_tx_stats(&core_tx);
+    core_link_get_tx_stats(&display_tx);
+    const core_link_tx_class_stats_t *state = &core_tx.classes[CORE_LINK_TX_PRIO_STATE];
+    printf("   core TX        : %u state frames, queue high-water %u/%u, max send latency %.2f ms, %u dropped\n",
+           (unsigned)state->sent, (unsigned)core_tx.max_depth, (unsigned)core_tx.capacity,
+           (double)state->max_latency_us / 1000.0, (unsigned)state->dropped);
+    printf("   display TX     : %u frames, queue high-water %u/%u\n",
+           (unsigned)(display_tx.classes[CORE_LINK_TX_PRIO_URGENT].sent + display_tx.classes[CORE_LINK_TX_PRIO_PING].sent),
+           (unsigned)display_tx.max_depth, (unsigned)display_tx.capacity);
+    return EXIT_SUCCESS;
+}
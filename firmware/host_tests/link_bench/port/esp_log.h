@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdio.h>
+
+/* Niveau courant : 0 aucun, 1 erreurs, 2 avertissements, 3 infos, 4 debug, 5 verbeux. */
+extern int host_log_level;
+
+#define HOST_LOG(level, letter, tag, fmt, ...)                                   \
+    do {                                                                         \
+        if (host_log_level >= (level)) {                                         \
+            fprintf(stderr, letter " (%s) " fmt "\n", tag, ##__VA_ARGS__);       \
+        }                                                                        \
+    } while (0)
+
+#define ESP_LOGE(tag, fmt, ...) HOST_LOG(1, "E", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) HOST_LOG(2, "W", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) HOST_LOG(3, "I", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) HOST_LOG(4, "D", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...) HOST_LOG(5, "V", tag, fmt, ##__VA_ARGS__)
@@ -0,0 +1,552 @@
+// pthread-backed emulation of the FreeRTOS/ESP-IDF subset used by the link modules.
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+
+int host_log_level = 2;
+
+struct host_task {
+    TaskFunction_t fn;
+    void *arg;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify;
+};
+
+struct host_semaphore {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    UBaseType_t count;
+    UBaseType_t max;
+};
+
+struct host_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint8_t *items;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+struct host_event_group {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    EventBits_t bits;
+};
+
+struct host_timer {
+    struct host_timer *next;
+    TimerCallbackFunction_t callback;
+    TickType_t period;
+    bool auto_reload;
+    bool active;
+    int64_t deadline_us;
+};
+
+static __thread TaskHandle_t s_current_task;
+static pthread_mutex_t s_timer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_timer_cond;
+static struct host_timer *s_timers;
+static TaskHandle_t s_timer_task;
+
+static int64_t monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+static struct timespec deadline_in(TickType_t ticks)
+{
+    int64_t deadline = monotonic_us() + (int64_t)ticks * 1000;
+    struct timespec ts = {
+        .tv_sec = (time_t)(deadline / 1000000),
+        .tv_nsec = (long)(deadline % 1000000) * 1000,
+    };
+    return ts;
+}
+
+// Waits on `cond` until `ready(ctx)` holds; false once `ticks` expire. `lock` is held.
+static bool wait_until(pthread_cond_t *cond, pthread_mutex_t *lock, TickType_t ticks, bool (*ready)(void *), void *ctx)
+{
+    struct timespec deadline = deadline_in(ticks == portMAX_DELAY ? 0 : ticks);
+    while (!ready(ctx)) {
+        if (ticks == 0) {
+            return false;
+        }
+        if (ticks == portMAX_DELAY) {
+            pthread_cond_wait(cond, lock);
+        } else if (pthread_cond_timedwait(cond, lock, &deadline) == ETIMEDOUT) {
+            return ready(ctx);
+        }
+    }
+    return true;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    static int64_t s_boot_us;
+    if (s_boot_us == 0) {
+        s_boot_us = monotonic_us();
+    }
+    return monotonic_us() - s_boot_us;
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+        case ESP_OK:
+            return "ESP_OK";
+        case ESP_FAIL:
+            return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:
+            return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:
+            return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:
+            return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:
+            return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:
+            return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED:
+            return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:
+            return "ESP_ERR_TIMEOUT";
+        default:
+            return "UNKNOWN_ERROR";
+    }
+}
+
+/* Tasks ----------------------------------------------------------------- */
+
+static TaskHandle_t task_alloc(void)
+{
+    TaskHandle_t task = calloc(1, sizeof(*task));
+    if (task) {
+        pthread_mutex_init(&task->lock, NULL);
+        cond_init(&task->cond);
+    }
+    return task;
+}
+
+static void *task_trampoline(void *arg)
+{
+    TaskHandle_t task = arg;
+    s_current_task = task;
+    task->fn(task->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *out_handle, BaseType_t core_id)
+{
+    (void)name;
+    (void)stack_depth;
+    (void)priority;
+    (void)core_id;
+    TaskHandle_t task = task_alloc();
+    if (!task) {
+        return pdFAIL;
+    }
+    task->fn = fn;
+    task->arg = arg;
+    // Published before the thread runs, as FreeRTOS does.
+    if (out_handle) {
+        *out_handle = task;
+    }
+    if (pthread_create(&task->thread, NULL, task_trampoline, task) != 0) {
+        if (out_handle) {
+            *out_handle = NULL;
+        }
+        free(task);
+        return pdFAIL;
+    }
+    pthread_detach(task->thread);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t priority,
+                       TaskHandle_t *out_handle)
+{
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, arg, priority, out_handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if (!task || task == xTaskGetCurrentTaskHandle()) {
+        pthread_exit(NULL);
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec ts = {.tv_sec = ticks / 1000, .tv_nsec = (long)(ticks % 1000) * 1000000};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if (!s_current_task) {
+        // Threads not created through xTaskCreate (main) get a handle on first use.
+        s_current_task = task_alloc();
+    }
+    return s_current_task;
+}
+
+static bool notify_ready(void *ctx)
+{
+    return ((TaskHandle_t)ctx)->notify > 0;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait)
+{
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    pthread_mutex_lock(&task->lock);
+    wait_until(&task->cond, &task->lock, ticks_to_wait, notify_ready, task);
+    uint32_t value = task->notify;
+    if (value > 0) {
+        task->notify = clear_on_exit ? 0 : value - 1;
+    }
+    pthread_mutex_unlock(&task->lock);
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    pthread_mutex_lock(&task->lock);
+    task->notify++;
+    pthread_cond_signal(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+    return pdPASS;
+}
+
+/* Semaphores ------------------------------------------------------------ */
+
+static SemaphoreHandle_t semaphore_create(UBaseType_t max, UBaseType_t initial)
+{
+    SemaphoreHandle_t sem = calloc(1, sizeof(*sem));
+    if (sem) {
+        pthread_mutex_init(&sem->lock, NULL);
+        cond_init(&sem->cond);
+        sem->max = max;
+        sem->count = initial;
+    }
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return semaphore_create(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return semaphore_create(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count)
+{
+    return semaphore_create(max_count, initial_count);
+}
+
+static bool semaphore_ready(void *ctx)
+{
+    return ((SemaphoreHandle_t)ctx)->count > 0;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks_to_wait)
+{
+    pthread_mutex_lock(&sem->lock);
+    bool ok = wait_until(&sem->cond, &sem->lock, ticks_to_wait, semaphore_ready, sem);
+    if (ok) {
+        sem->count--;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return ok ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    pthread_mutex_lock(&sem->lock);
+    bool ok = sem->count < sem->max;
+    if (ok) {
+        sem->count++;
+        pthread_cond_signal(&sem->cond);
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return ok ? pdTRUE : pdFALSE;
+}
+
+/* Queues ---------------------------------------------------------------- */
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    QueueHandle_t queue = calloc(1, sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+    queue->items = calloc(length, item_size);
+    if (!queue->items) {
+        free(queue);
+        return NULL;
+    }
+    pthread_mutex_init(&queue->lock, NULL);
+    cond_init(&queue->cond);
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+static bool queue_has_room(void *ctx)
+{
+    QueueHandle_t queue = ctx;
+    return queue->count < queue->length;
+}
+
+static bool queue_has_item(void *ctx)
+{
+    return ((QueueHandle_t)ctx)->count > 0;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait)
+{
+    pthread_mutex_lock(&queue->lock);
+    bool ok = wait_until(&queue->cond, &queue->lock, ticks_to_wait, queue_has_room, queue);
+    if (ok) {
+        UBaseType_t tail = (queue->head + queue->count) % queue->length;
+        memcpy(queue->items + tail * queue->item_size, item, queue->item_size);
+        queue->count++;
+        pthread_cond_broadcast(&queue->cond);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return ok ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *out_item, TickType_t ticks_to_wait)
+{
+    pthread_mutex_lock(&queue->lock);
+    bool ok = wait_until(&queue->cond, &queue->lock, ticks_to_wait, queue_has_item, queue);
+    if (ok) {
+        memcpy(out_item, queue->items + queue->head * queue->item_size, queue->item_size);
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        pthread_cond_broadcast(&queue->cond);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return ok ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    queue->head = 0;
+    queue->count = 0;
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->lock);
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    UBaseType_t count = queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
+
+/* Event groups ---------------------------------------------------------- */
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    EventGroupHandle_t group = calloc(1, sizeof(*group));
+    if (group) {
+        pthread_mutex_init(&group->lock, NULL);
+        cond_init(&group->cond);
+    }
+    return group;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    pthread_mutex_lock(&group->lock);
+    group->bits |= bits;
+    EventBits_t value = group->bits;
+    pthread_cond_broadcast(&group->cond);
+    pthread_mutex_unlock(&group->lock);
+    return value;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    pthread_mutex_lock(&group->lock);
+    EventBits_t value = group->bits;
+    group->bits &= ~bits;
+    pthread_mutex_unlock(&group->lock);
+    return value;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group)
+{
+    pthread_mutex_lock(&group->lock);
+    EventBits_t value = group->bits;
+    pthread_mutex_unlock(&group->lock);
+    return value;
+}
+
+typedef struct {
+    EventGroupHandle_t group;
+    EventBits_t bits;
+    bool all;
+} event_wait_t;
+
+static bool event_ready(void *ctx)
+{
+    const event_wait_t *wait = ctx;
+    EventBits_t set = wait->group->bits & wait->bits;
+    return wait->all ? set == wait->bits : set != 0;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clear_on_exit,
+                                BaseType_t wait_for_all, TickType_t ticks_to_wait)
+{
+    event_wait_t wait = {.group = group, .bits = bits, .all = wait_for_all != pdFALSE};
+    pthread_mutex_lock(&group->lock);
+    bool ok = wait_until(&group->cond, &group->lock, ticks_to_wait, event_ready, &wait);
+    EventBits_t value = group->bits;
+    if (ok && clear_on_exit) {
+        group->bits &= ~bits;
+    }
+    pthread_mutex_unlock(&group->lock);
+    return value;
+}
+
+/* Software timers ------------------------------------------------------- */
+
+static void timer_daemon(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&s_timer_lock);
+    while (true) {
+        int64_t now = monotonic_us();
+        int64_t next = INT64_MAX;
+        struct host_timer *due = NULL;
+        for (struct host_timer *timer = s_timers; timer; timer = timer->next) {
+            if (!timer->active) {
+                continue;
+            }
+            if (timer->deadline_us <= now) {
+                due = timer;
+                break;
+            }
+            if (timer->deadline_us < next) {
+                next = timer->deadline_us;
+            }
+        }
+        if (due) {
+            if (due->auto_reload) {
+                due->deadline_us += (int64_t)due->period * 1000;
+            } else {
+                due->active = false;
+            }
+            // Callbacks run unlocked, on the daemon task, like the FreeRTOS timer service.
+            pthread_mutex_unlock(&s_timer_lock);
+            due->callback(due);
+            pthread_mutex_lock(&s_timer_lock);
+            continue;
+        }
+        if (next == INT64_MAX) {
+            pthread_cond_wait(&s_timer_cond, &s_timer_lock);
+        } else {
+            struct timespec ts = {.tv_sec = (time_t)(next / 1000000), .tv_nsec = (long)(next % 1000000) * 1000};
+            pthread_cond_timedwait(&s_timer_cond, &s_timer_lock, &ts);
+        }
+    }
+}
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, BaseType_t auto_reload, void *id,
+                           TimerCallbackFunction_t callback)
+{
+    (void)name;
+    (void)id;
+    TimerHandle_t timer = calloc(1, sizeof(*timer));
+    if (!timer) {
+        return NULL;
+    }
+    timer->callback = callback;
+    timer->period = period;
+    timer->auto_reload = auto_reload != pdFALSE;
+
+    pthread_mutex_lock(&s_timer_lock);
+    if (!s_timer_task) {
+        cond_init(&s_timer_cond);
+        xTaskCreate(timer_daemon, "Tmr Svc", 0, NULL, 0, &s_timer_task);
+    }
+    timer->next = s_timers;
+    s_timers = timer;
+    pthread_mutex_unlock(&s_timer_lock);
+    return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    pthread_mutex_lock(&s_timer_lock);
+    timer->active = true;
+    timer->deadline_us = monotonic_us() + (int64_t)timer->period * 1000;
+    pthread_cond_signal(&s_timer_cond);
+    pthread_mutex_unlock(&s_timer_lock);
+    return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    pthread_mutex_lock(&s_timer_lock);
+    timer->active = false;
+    pthread_mutex_unlock(&s_timer_lock);
+    return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer)
+{
+    pthread_mutex_lock(&s_timer_lock);
+    bool active = timer->active;
+    pthread_mutex_unlock(&s_timer_lock);
+    return active ? pdTRUE : pdFALSE;
+}
+
+TaskHandle_t xTimerGetTimerDaemonTaskHandle(void)
+{
+    return s_timer_task;
+}
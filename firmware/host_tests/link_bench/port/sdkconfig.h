@@ -0,0 +1,17 @@
+#pragma once
+
+/* Valeurs par défaut des Kconfig de l'afficheur et du cœur utilisées par les modules de liaison. */
+#define CONFIG_APP_CORE_LINK_STATE_TIMEOUT_MS 4000
+#define CONFIG_APP_CORE_LINK_FULL_REFRESH_TIMEOUT_MS 12000
+#define CONFIG_APP_CORE_LINK_PING_TIMEOUT_MS 800
+#define CONFIG_APP_CORE_LINK_COMMAND_TIMEOUT_MS 5000
+#define CONFIG_APP_CORE_LINK_RTT_PROBE_INTERVAL_MS 2000
+#define CONFIG_CORE_APP_LINK_STATE_TIMEOUT_MS 4000
+#define CONFIG_CORE_APP_LINK_PING_TIMEOUT_MS 800
+#define CONFIG_CORE_APP_LINK_STATS_INTERVAL_MS 5000
+#define CONFIG_CORE_APP_LINK_DISPLAY_COUNT 3
+#define CONFIG_CORE_APP_STATE_PUBLISH_MAX_INTERVAL_MS 2000
+#define CONFIG_CORE_APP_LINK_FULL_COMPRESSED 1
+#define CONFIG_CORE_APP_LINK_BAUD_ERROR_THRESHOLD 3
+/* Fenêtre minimale : une montée de débit complète tient dans le banc. */
+#define CONFIG_CORE_APP_LINK_BAUD_WINDOW_MS 500
@@ -0,0 +1,162 @@
+#include <string.h>
+
+#include "compression_rle.h"
+#include "host_test.h"
+#include "link/core_link_baseline.h"
+#include "link/core_link_stream.h"
+
+#define PAYLOAD_SIZE 1800U
+
+static uint8_t s_baseline_buffer[PAYLOAD_SIZE];
+static uint8_t s_previous[PAYLOAD_SIZE];
+static uint8_t s_next[PAYLOAD_SIZE];
+static uint8_t s_diff[PAYLOAD_SIZE];
+static uint8_t s_encoded[COMPRESSION_RLE_WORST_CASE(PAYLOAD_SIZE)];
+static uint8_t s_decoded[PAYLOAD_SIZE];
+
+// Stand-in for a STATE_FULL payload: 16 records of names, then values.
+static void fill_payload(uint8_t *out, uint32_t step)
+{
+    memset(out, 0, PAYLOAD_SIZE);
+    for (size_t record = 0; record < 16; ++record) {
+        uint8_t *entry = out + 6 + record * 111;
+        entry[0] = (uint8_t)record;
+        memcpy(entry + 1, "Pogona vitticeps", 16);
+        memcpy(entry + 33, "Bearded dragon", 14);
+        for (size_t field = 0; field < 11; ++field) {
+            uint32_t value = 0x41A00000U + (uint32_t)(record * 977U + field * 131U);
+            if (field < 3) {
+                value += step * 37U; // a few drifting values per record
+            }
+            memcpy(entry + 65 + field * 4, &value, sizeof(value));
+        }
+    }
+}
+
+static size_t s_encoded_size;
+
+static void roundtrip(const uint8_t *input, size_t length)
+{
+    size_t encoded = compression_rle_encode(input, length, s_encoded, sizeof(s_encoded));
+    s_encoded_size = encoded;
+    HOST_TEST_ASSERT(encoded > 0);
+    HOST_TEST_ASSERT(encoded <= COMPRESSION_RLE_WORST_CASE(length));
+    size_t produced = 0;
+    HOST_TEST_ASSERT(compression_rle_decode(s_encoded, encoded, s_decoded, sizeof(s_decoded), &produced));
+    HOST_TEST_ASSERT_EQ(length, produced);
+    HOST_TEST_ASSERT(memcmp(input, s_decoded, length) == 0);
+}
+
+static void test_rle_roundtrip(void)
+{
+    uint8_t data[700];
+    memset(data, 0, sizeof(data));
+    roundtrip(data, sizeof(data));
+    HOST_TEST_ASSERT(s_encoded_size <= 12);
+
+    // Incompressible stretches longer than one literal block, pairs, and runs at the edges.
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t)(i * 167U + (i >> 3));
+    }
+    memset(data + 300, 0xAB, 2);
+    memset(data + 400, 0x00, 131);
+    memset(data + sizeof(data) - 3, 0x7F, 3);
+    roundtrip(data, sizeof(data));
+    roundtrip(data, 1);
+
+    // Too little room fails cleanly instead of truncating.
+    HOST_TEST_ASSERT_EQ(0, compression_rle_encode(data, sizeof(data), s_encoded, 100));
+}
+
+static void test_rle_rejects_malformed_input(void)
+{
+    size_t produced = 0;
+    const uint8_t truncated_literal[] = {0x04, 1, 2};
+    HOST_TEST_ASSERT(!compression_rle_decode(truncated_literal, sizeof(truncated_literal), s_decoded,
+                                             sizeof(s_decoded), &produced));
+    const uint8_t truncated_run[] = {0x81};
+    HOST_TEST_ASSERT(!compression_rle_decode(truncated_run, sizeof(truncated_run), s_decoded, sizeof(s_decoded),
+                                             &produced));
+    const uint8_t overflow[] = {0xFF, 0x00};
+    HOST_TEST_ASSERT(!compression_rle_decode(overflow, sizeof(overflow), s_decoded, 100, &produced));
+}
+
+static void test_periodic_full_compresses(void)
+{
+    core_link_baseline_t baseline;
+    core_link_baseline_init(&baseline, s_baseline_buffer, sizeof(s_baseline_buffer));
+    HOST_TEST_ASSERT(!baseline.valid);
+
+    fill_payload(s_previous, 0);
+    fill_payload(s_next, 20);
+    HOST_TEST_ASSERT(core_link_baseline_store(&baseline, s_previous, PAYLOAD_SIZE));
+    HOST_TEST_ASSERT_EQ(core_link_crc16_update(0xFFFF, s_previous, PAYLOAD_SIZE), baseline.crc);
+
+    // Core side: XOR against the previous full, then compress.
+    memcpy(s_diff, s_next, PAYLOAD_SIZE);
+    core_link_baseline_xor(&baseline, s_diff, PAYLOAD_SIZE);
+    size_t encoded = compression_rle_encode(s_diff, PAYLOAD_SIZE, s_encoded, sizeof(s_encoded));
+    HOST_TEST_ASSERT(encoded > 0);
+    HOST_TEST_ASSERT(encoded * 4 < PAYLOAD_SIZE);
+
+    // Display side: same baseline, inverse steps.
+    size_t produced = 0;
+    HOST_TEST_ASSERT(compression_rle_decode(s_encoded, encoded, s_decoded, sizeof(s_decoded), &produced));
+    core_link_baseline_xor(&baseline, s_decoded, produced);
+    HOST_TEST_ASSERT(memcmp(s_decoded, s_next, PAYLOAD_SIZE) == 0);
+}
+
+static void test_length_change_and_overflow(void)
+{
+    core_link_baseline_t baseline;
+    core_link_baseline_init(&baseline, s_baseline_buffer, sizeof(s_baseline_buffer));
+    fill_payload(s_previous, 0);
+    fill_payload(s_next, 1);
+    HOST_TEST_ASSERT(core_link_baseline_store(&baseline, s_previous, 600));
+
+    // A terrarium was added: the tail past the reference travels as is.
+    memcpy(s_diff, s_next, 900);
+    core_link_baseline_xor(&baseline, s_diff, 900);
+    HOST_TEST_ASSERT(memcmp(s_diff + 600, s_next + 600, 300) == 0);
+    core_link_baseline_xor(&baseline, s_diff, 900);
+    HOST_TEST_ASSERT(memcmp(s_diff, s_next, 900) == 0);
+
+    // A payload that does not fit leaves no stale reference behind.
+    HOST_TEST_ASSERT(!core_link_baseline_store(&baseline, s_next, sizeof(s_baseline_buffer) + 1));
+    HOST_TEST_ASSERT(!baseline.valid);
+}
+
+static void test_header_roundtrip(void)
+{
+    core_link_full_compressed_header_t header = {
+        .inner_type = CORE_LINK_MSG_STATE_FULL_COMPACT,
+        .codec = 4,
+        .baseline_crc = 0xBEEF,
+        .length = 7118,
+        .crc = 0x1234,
+    };
+    uint8_t wire[CORE_LINK_FULL_COMPRESSED_HEADER_SIZE];
+    core_link_full_compressed_header_write(wire, &header);
+
+    core_link_full_compressed_header_t decoded;
+    HOST_TEST_ASSERT(core_link_full_compressed_header_read(wire, sizeof(wire), &decoded));
+    HOST_TEST_ASSERT_EQ(header.inner_type, decoded.inner_type);
+    HOST_TEST_ASSERT_EQ(header.codec, decoded.codec);
+    HOST_TEST_ASSERT_EQ(header.baseline_crc, decoded.baseline_crc);
+    HOST_TEST_ASSERT_EQ(header.length, decoded.length);
+    HOST_TEST_ASSERT_EQ(header.crc, decoded.crc);
+
+    HOST_TEST_ASSERT(!core_link_full_compressed_header_read(wire, sizeof(wire) - 1, &decoded));
+    wire[0] = CORE_LINK_MSG_STATE_DELTA;
+    HOST_TEST_ASSERT(!core_link_full_compressed_header_read(wire, sizeof(wire), &decoded));
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_rle_roundtrip);
+    HOST_TEST_RUN(test_rle_rejects_malformed_input);
+    HOST_TEST_RUN(test_periodic_full_compresses);
+    HOST_TEST_RUN(test_length_change_and_overflow);
+    HOST_TEST_RUN(test_header_roundtrip);
+    return HOST_TEST_EXIT();
+}
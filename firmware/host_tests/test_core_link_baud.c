@@ -0,0 +1,131 @@
+#include "host_test.h"
+#include "link/core_link_baud.h"
+
+#define THRESHOLD 3U
+
+static core_link_baud_policy_t s_policy;
+static uint8_t s_target;
+
+// Runs clean windows until the policy asks for a faster rate, then confirms it.
+static void climb_once(void)
+{
+    core_link_baud_action_t action = CORE_LINK_BAUD_HOLD;
+    for (int i = 0; i < CORE_LINK_BAUD_CLEAN_WINDOWS && action == CORE_LINK_BAUD_HOLD; ++i) {
+        action = core_link_baud_policy_evaluate(&s_policy, 0, &s_target);
+    }
+    HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_STEP_UP, action);
+    core_link_baud_policy_commit(&s_policy, s_target);
+}
+
+static void test_rate_table(void)
+{
+    HOST_TEST_ASSERT_EQ(115200, core_link_baud_rate(0));
+    HOST_TEST_ASSERT_EQ(0, core_link_baud_rate(CORE_LINK_BAUD_RATE_COUNT));
+    HOST_TEST_ASSERT_EQ(6, core_link_baud_index(2000000));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_INDEX_NONE, core_link_baud_index(2000001));
+    // 460800 .. 2000000: 460800, 921600, 1000000, 1500000, 2000000.
+    HOST_TEST_ASSERT_EQ(0x007C, core_link_baud_mask(460800, 2000000));
+    HOST_TEST_ASSERT(!core_link_baud_policy_init(&s_policy, 123456, 2000000, THRESHOLD));
+}
+
+static void test_holds_until_peer_announces(void)
+{
+    HOST_TEST_ASSERT(core_link_baud_policy_init(&s_policy, 460800, 3000000, THRESHOLD));
+    for (int i = 0; i < 10; ++i) {
+        HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_HOLD, core_link_baud_policy_evaluate(&s_policy, 0, &s_target));
+    }
+    HOST_TEST_ASSERT_EQ(460800, core_link_baud_policy_rate(&s_policy));
+
+    // A peer that cannot run at our safe rate leaves nothing to negotiate.
+    core_link_baud_policy_set_peer(&s_policy, core_link_baud_mask(921600, 3000000));
+    HOST_TEST_ASSERT_EQ(0, s_policy.common_mask);
+}
+
+static void test_steps_up_to_common_ceiling(void)
+{
+    HOST_TEST_ASSERT(core_link_baud_policy_init(&s_policy, 460800, 3000000, THRESHOLD));
+    // The display stops at 2 Mbit/s and skips 1 Mbit/s.
+    uint16_t peer = core_link_baud_mask(115200, 2000000) & (uint16_t)~(1U << core_link_baud_index(1000000));
+    core_link_baud_policy_set_peer(&s_policy, peer);
+
+    const uint32_t expected[] = {921600, 1500000, 2000000};
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i) {
+        climb_once();
+        HOST_TEST_ASSERT_EQ(expected[i], core_link_baud_policy_rate(&s_policy));
+    }
+    // A few errors under the threshold do not stop a clean link; the top rate just holds.
+    for (int i = 0; i < 10; ++i) {
+        HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_HOLD, core_link_baud_policy_evaluate(&s_policy, THRESHOLD - 1, &s_target));
+    }
+    HOST_TEST_ASSERT_EQ(2000000, core_link_baud_policy_rate(&s_policy));
+}
+
+static void test_errors_step_down_and_hold_off(void)
+{
+    HOST_TEST_ASSERT(core_link_baud_policy_init(&s_policy, 460800, 3000000, THRESHOLD));
+    core_link_baud_policy_set_peer(&s_policy, core_link_baud_mask(115200, 5000000));
+    climb_once();
+    climb_once();
+    climb_once();
+    HOST_TEST_ASSERT_EQ(1500000, core_link_baud_policy_rate(&s_policy));
+
+    HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_STEP_DOWN, core_link_baud_policy_evaluate(&s_policy, THRESHOLD, &s_target));
+    HOST_TEST_ASSERT_EQ(1000000, core_link_baud_rate(s_target));
+    core_link_baud_policy_commit(&s_policy, s_target);
+
+    // The abandoned rate stays out of reach for the penalty period, then is retried.
+    int windows = 0;
+    core_link_baud_action_t action = CORE_LINK_BAUD_HOLD;
+    while (action == CORE_LINK_BAUD_HOLD && windows < 100) {
+        action = core_link_baud_policy_evaluate(&s_policy, 0, &s_target);
+        ++windows;
+    }
+    HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_STEP_UP, action);
+    HOST_TEST_ASSERT_EQ(1500000, core_link_baud_rate(s_target));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_PENALTY_WINDOWS, windows);
+
+    // Never below the safe rate, however bad the line.
+    HOST_TEST_ASSERT(core_link_baud_policy_init(&s_policy, 460800, 3000000, THRESHOLD));
+    core_link_baud_policy_set_peer(&s_policy, core_link_baud_mask(115200, 5000000));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_HOLD, core_link_baud_policy_evaluate(&s_policy, 100, &s_target));
+    HOST_TEST_ASSERT_EQ(460800, core_link_baud_policy_rate(&s_policy));
+}
+
+static void test_failed_probe_and_link_loss(void)
+{
+    HOST_TEST_ASSERT(core_link_baud_policy_init(&s_policy, 460800, 3000000, THRESHOLD));
+    core_link_baud_policy_set_peer(&s_policy, core_link_baud_mask(115200, 5000000));
+    climb_once();
+    HOST_TEST_ASSERT_EQ(921600, core_link_baud_policy_rate(&s_policy));
+
+    // The peer never answered at 1 Mbit/s: stay at 921600 and do not retry at once.
+    core_link_baud_action_t action = CORE_LINK_BAUD_HOLD;
+    for (int i = 0; i < CORE_LINK_BAUD_CLEAN_WINDOWS; ++i) {
+        action = core_link_baud_policy_evaluate(&s_policy, 0, &s_target);
+    }
+    HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_STEP_UP, action);
+    core_link_baud_policy_failed(&s_policy, s_target);
+    HOST_TEST_ASSERT_EQ(921600, core_link_baud_policy_rate(&s_policy));
+    for (int i = 0; i < CORE_LINK_BAUD_PENALTY_WINDOWS - 1; ++i) {
+        HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_HOLD, core_link_baud_policy_evaluate(&s_policy, 0, &s_target));
+    }
+
+    // Link lost at 921600: back to the safe rate, and the lost rate waits out a penalty again.
+    core_link_baud_policy_fall_back(&s_policy);
+    HOST_TEST_ASSERT_EQ(460800, core_link_baud_policy_rate(&s_policy));
+    for (int i = 0; i < CORE_LINK_BAUD_PENALTY_WINDOWS - 1; ++i) {
+        HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_HOLD, core_link_baud_policy_evaluate(&s_policy, 0, &s_target));
+    }
+    HOST_TEST_ASSERT_EQ(CORE_LINK_BAUD_STEP_UP, core_link_baud_policy_evaluate(&s_policy, 0, &s_target));
+    HOST_TEST_ASSERT_EQ(921600, core_link_baud_rate(s_target));
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_rate_table);
+    HOST_TEST_RUN(test_holds_until_peer_announces);
+    HOST_TEST_RUN(test_steps_up_to_common_ceiling);
+    HOST_TEST_RUN(test_errors_step_down_and_hold_off);
+    HOST_TEST_RUN(test_failed_probe_and_link_loss);
+    return HOST_TEST_EXIT();
+}
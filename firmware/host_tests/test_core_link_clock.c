@@ -0,0 +1,100 @@
+#include <stdlib.h>
+
+#include "host_test.h"
+#include "link/core_link_clock.h"
+
+static core_link_clock_t s_clock;
+
+// Core clock as seen from the display: booted 42 s earlier, crystal `drift_ppb` fast.
+static int64_t remote_at(int64_t local_us, int32_t drift_ppb)
+{
+    return local_us + 42000000LL + local_us * drift_ppb / 1000000000LL;
+}
+
+static void exchange(int64_t t1, uint32_t out_us, uint32_t back_us, int32_t drift_ppb)
+{
+    int64_t t2 = remote_at(t1 + out_us, drift_ppb);
+    core_link_clock_add_sample(&s_clock, t1, t2, t1 + out_us + back_us);
+}
+
+static void test_unsynced_until_first_pong(void)
+{
+    core_link_clock_reset(&s_clock);
+    core_link_clock_estimate_t estimate;
+    core_link_clock_get(&s_clock, 0, &estimate);
+    HOST_TEST_ASSERT(!estimate.synced);
+    int64_t local = 0;
+    HOST_TEST_ASSERT(!core_link_clock_to_local(&s_clock, 1000, &local));
+    HOST_TEST_ASSERT(!core_link_clock_add_sample(&s_clock, 2000, 0, 1000));
+    core_link_clock_get(&s_clock, 0, &estimate);
+    HOST_TEST_ASSERT(!estimate.synced);
+}
+
+static void test_symmetric_path_is_exact(void)
+{
+    core_link_clock_reset(&s_clock);
+    exchange(5000000, 400, 400, 0);
+    core_link_clock_estimate_t estimate;
+    core_link_clock_get(&s_clock, 5000400, &estimate);
+    HOST_TEST_ASSERT(estimate.synced);
+    HOST_TEST_ASSERT_EQ(42000000, estimate.offset_us);
+    HOST_TEST_ASSERT_EQ(800, estimate.min_rtt_us);
+    HOST_TEST_ASSERT_EQ(0, estimate.drift_ppb);
+
+    int64_t local = 0;
+    HOST_TEST_ASSERT(core_link_clock_to_local(&s_clock, 47000000, &local));
+    HOST_TEST_ASSERT_EQ(5000000, local);
+}
+
+static void test_congested_exchanges_are_filtered(void)
+{
+    core_link_clock_reset(&s_clock);
+    // A fast exchange, then several stuck behind a fragmented STATE_FULL on the way back.
+    exchange(1000000, 300, 300, 0);
+    for (int i = 1; i <= 5; ++i) {
+        exchange(1000000 + i * 2000000LL, 300, 40000, 0);
+    }
+    core_link_clock_estimate_t estimate;
+    core_link_clock_get(&s_clock, 11000000, &estimate);
+    HOST_TEST_ASSERT_EQ(1, estimate.samples);
+    HOST_TEST_ASSERT_EQ(600, estimate.min_rtt_us);
+    HOST_TEST_ASSERT_EQ(42000000, estimate.offset_us);
+}
+
+static void test_drift_is_tracked(void)
+{
+    const int32_t drift_ppb = 35000; // 35 ppm, two cheap crystals in opposite corners
+    core_link_clock_reset(&s_clock);
+    srand(7);
+    int64_t t = 3000000;
+    for (int i = 0; i < 40; ++i, t += 2000000) {
+        // Jittery, asymmetric path: up to 1 ms each way, plus a congested exchange now and then.
+        uint32_t out = 200 + (uint32_t)(rand() % 1000);
+        uint32_t back = 200 + (uint32_t)(rand() % 1000) + (i % 7 == 3 ? 30000U : 0U);
+        exchange(t, out, back, drift_ppb);
+    }
+
+    core_link_clock_estimate_t estimate;
+    core_link_clock_get(&s_clock, t, &estimate);
+    HOST_TEST_ASSERT(estimate.synced);
+    HOST_TEST_ASSERT(estimate.samples >= 8);
+    HOST_TEST_ASSERT(llabs((long long)estimate.drift_ppb - drift_ppb) < 5000);
+    // The estimate stays within the path asymmetry bound.
+    int64_t true_offset = remote_at(t, drift_ppb) - t;
+    HOST_TEST_ASSERT(llabs((long long)(estimate.offset_us - true_offset)) < 600);
+
+    // Converting a core timestamp back lands within the same bound.
+    int64_t sample_local = t - 150000;
+    int64_t converted = 0;
+    HOST_TEST_ASSERT(core_link_clock_to_local(&s_clock, remote_at(sample_local, drift_ppb), &converted));
+    HOST_TEST_ASSERT(llabs((long long)(converted - sample_local)) < 600);
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_unsynced_until_first_pong);
+    HOST_TEST_RUN(test_symmetric_path_is_exact);
+    HOST_TEST_RUN(test_congested_exchanges_are_filtered);
+    HOST_TEST_RUN(test_drift_is_tracked);
+    return HOST_TEST_EXIT();
+}
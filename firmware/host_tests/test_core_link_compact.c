@@ -0,0 +1,169 @@
+#include <math.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_compact.h"
+#include "link/core_link_fields.h"
+
+#define V1_SNAPSHOT_WIRE_SIZE sizeof(core_link_snapshot_wire_t)
+#define STATE_HEADER_SIZE 5U
+#define ENTRY_HEADER_SIZE 3U
+
+static void make_snapshot(core_link_terrarium_snapshot_t *snap, uint8_t id, const char *scientific, const char *common)
+{
+    memset(snap, 0, sizeof(*snap));
+    snap->terrarium_id = id;
+    strncpy(snap->scientific_name, scientific, CORE_LINK_NAME_MAX_LEN);
+    strncpy(snap->common_name, common, CORE_LINK_NAME_MAX_LEN);
+    snap->temp_day_c = 31.27f + id;
+    snap->temp_night_c = 23.91f - id;
+    snap->humidity_day_pct = 61.34f;
+    snap->humidity_night_pct = 72.05f;
+    snap->lux_day = 412.6f;
+    snap->lux_night = 5.2f;
+    snap->hydration_pct = 88.04f;
+    snap->stress_pct = 17.66f;
+    snap->health_pct = 93.98f;
+    snap->last_feeding_timestamp = 1700000123u + id;
+    snap->activity_score = 0.537f;
+}
+
+static void test_round_trip_accuracy(void)
+{
+    static const struct {
+        core_link_delta_field_mask_t field;
+        size_t offset;
+        float min;
+        float max;
+        float scale;
+    } cases[] = {
+        {CORE_LINK_DELTA_FIELD_TEMP_DAY, offsetof(core_link_terrarium_snapshot_t, temp_day_c), -40.0f, 80.0f, CORE_LINK_Q_TEMP_SCALE},
+        {CORE_LINK_DELTA_FIELD_HUMIDITY_NIGHT, offsetof(core_link_terrarium_snapshot_t, humidity_night_pct), 0.0f, 100.0f, CORE_LINK_Q_PCT_SCALE},
+        {CORE_LINK_DELTA_FIELD_LUX_DAY, offsetof(core_link_terrarium_snapshot_t, lux_day), 0.0f, 60000.0f, CORE_LINK_Q_LUX_SCALE},
+        {CORE_LINK_DELTA_FIELD_STRESS, offsetof(core_link_terrarium_snapshot_t, stress_pct), 0.0f, 100.0f, CORE_LINK_Q_PCT_SCALE},
+        {CORE_LINK_DELTA_FIELD_ACTIVITY, offsetof(core_link_terrarium_snapshot_t, activity_score), 0.0f, 1.0f, CORE_LINK_Q_ACTIVITY_SCALE},
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+        float worst = 0.0f;
+        for (unsigned step = 0; step <= 10000; ++step) {
+            float value = cases[c].min + (cases[c].max - cases[c].min) * (float)step / 10000.0f;
+            core_link_terrarium_snapshot_t in = {0};
+            core_link_terrarium_snapshot_t out = {0};
+            memcpy((uint8_t *)&in + cases[c].offset, &value, sizeof(value));
+
+            uint8_t buffer[8];
+            size_t written = core_link_compact_encode_fields(buffer, sizeof(buffer), cases[c].field, &in);
+            HOST_TEST_ASSERT(written > 0);
+            size_t offset = 0;
+            HOST_TEST_ASSERT(core_link_compact_decode_fields(buffer, written, &offset, cases[c].field, &out));
+            HOST_TEST_ASSERT_EQ(written, offset);
+
+            float decoded;
+            memcpy(&decoded, (uint8_t *)&out + cases[c].offset, sizeof(decoded));
+            float error = fabsf(decoded - value);
+            if (error > worst) {
+                worst = error;
+            }
+        }
+        // Rounding keeps the error within half a quantization step (plus float noise).
+        HOST_TEST_ASSERT(worst <= 0.5f / cases[c].scale + fabsf(cases[c].max) * 1e-6f);
+    }
+}
+
+static void test_saturation_and_non_finite(void)
+{
+    core_link_terrarium_snapshot_t in = {0};
+    core_link_terrarium_snapshot_t out = {0};
+    in.temp_day_c = 1000.0f;
+    in.temp_night_c = NAN;
+    in.humidity_day_pct = -5.0f;
+    in.activity_score = 3.0f;
+
+    core_link_delta_field_mask_t mask = CORE_LINK_DELTA_FIELD_TEMP_DAY | CORE_LINK_DELTA_FIELD_TEMP_NIGHT |
+                                        CORE_LINK_DELTA_FIELD_HUMIDITY_DAY | CORE_LINK_DELTA_FIELD_ACTIVITY;
+    uint8_t buffer[16];
+    size_t written = core_link_compact_encode_fields(buffer, sizeof(buffer), mask, &in);
+    HOST_TEST_ASSERT_EQ(7, written);
+    size_t offset = 0;
+    HOST_TEST_ASSERT(core_link_compact_decode_fields(buffer, written, &offset, mask, &out));
+    HOST_TEST_ASSERT(fabsf(out.temp_day_c - 327.67f) < 0.001f);
+    HOST_TEST_ASSERT(out.temp_night_c == 0.0f);
+    HOST_TEST_ASSERT(out.humidity_day_pct == 0.0f);
+    HOST_TEST_ASSERT(fabsf(out.activity_score - 255.0f / CORE_LINK_Q_ACTIVITY_SCALE) < 1e-6f);
+}
+
+static void test_names_and_truncation(void)
+{
+    core_link_terrarium_snapshot_t in;
+    make_snapshot(&in, 2, "Correlophus ciliatus", "Gecko \xc3\xa0 cr\xc3\xaate");
+    uint8_t buffer[128];
+    size_t written = core_link_compact_encode_fields(buffer, sizeof(buffer), CORE_LINK_DELTA_FIELD_ALL, &in);
+    HOST_TEST_ASSERT_EQ(core_link_compact_fields_size(CORE_LINK_DELTA_FIELD_ALL, &in), written);
+
+    core_link_terrarium_snapshot_t out;
+    memset(&out, 0xAA, sizeof(out));
+    size_t offset = 0;
+    HOST_TEST_ASSERT(core_link_compact_decode_fields(buffer, written, &offset, CORE_LINK_DELTA_FIELD_ALL, &out));
+    HOST_TEST_ASSERT(strcmp(out.scientific_name, in.scientific_name) == 0);
+    HOST_TEST_ASSERT(strcmp(out.common_name, in.common_name) == 0);
+    HOST_TEST_ASSERT_EQ(in.last_feeding_timestamp, out.last_feeding_timestamp);
+
+    for (size_t cut = 0; cut < written; ++cut) {
+        offset = 0;
+        HOST_TEST_ASSERT(!core_link_compact_decode_fields(buffer, cut, &offset, CORE_LINK_DELTA_FIELD_ALL, &out));
+    }
+    HOST_TEST_ASSERT_EQ(0, core_link_compact_encode_fields(buffer, written - 1, CORE_LINK_DELTA_FIELD_ALL, &in));
+}
+
+static void test_diff_mask_ignores_sub_resolution_noise(void)
+{
+    core_link_terrarium_snapshot_t a;
+    make_snapshot(&a, 0, "Python regius", "Python royal");
+    core_link_terrarium_snapshot_t b = a;
+    b.temp_day_c += 0.001f;
+    b.stress_pct += 0.01f;
+    HOST_TEST_ASSERT_EQ(0, core_link_compact_diff_mask(&b, &a));
+
+    b.humidity_day_pct += 0.2f;
+    b.last_feeding_timestamp += 1;
+    strcpy(b.common_name, "Python boule");
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_FIELD_HUMIDITY_DAY | CORE_LINK_DELTA_FIELD_LAST_FEED |
+                            CORE_LINK_DELTA_FIELD_COMMON_NAME,
+                        core_link_compact_diff_mask(&b, &a));
+}
+
+static void test_full_frame_shrinks_by_more_than_half(void)
+{
+    static const char *names[4][2] = {
+        {"Python regius", "Python royal"},
+        {"Pogona vitticeps", "Dragon barbu"},
+        {"Correlophus ciliatus", "Gecko \xc3\xa0 cr\xc3\xaate"},
+        {"Eublepharis macularius", "Gecko l\xc3\xa9opard"},
+    };
+    size_t v1 = STATE_HEADER_SIZE;
+    size_t compact = STATE_HEADER_SIZE;
+    size_t compact_with_names = STATE_HEADER_SIZE;
+    for (uint8_t i = 0; i < 4; ++i) {
+        core_link_terrarium_snapshot_t snap;
+        make_snapshot(&snap, i, names[i][0], names[i][1]);
+        v1 += V1_SNAPSHOT_WIRE_SIZE;
+        compact += ENTRY_HEADER_SIZE +
+                   core_link_compact_fields_size(CORE_LINK_DELTA_FIELD_ALL & ~CORE_LINK_DELTA_FIELD_NAMES, &snap);
+        compact_with_names += ENTRY_HEADER_SIZE + core_link_compact_fields_size(CORE_LINK_DELTA_FIELD_ALL, &snap);
+    }
+    printf("   STATE_FULL x4: v1=%zu compact=%zu compact+names=%zu bytes\n", v1, compact, compact_with_names);
+    HOST_TEST_ASSERT_EQ(441, v1);
+    HOST_TEST_ASSERT(compact * 2 < v1);
+    HOST_TEST_ASSERT(compact_with_names < v1);
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_round_trip_accuracy);
+    HOST_TEST_RUN(test_saturation_and_non_finite);
+    HOST_TEST_RUN(test_names_and_truncation);
+    HOST_TEST_RUN(test_diff_mask_ignores_sub_resolution_noise);
+    HOST_TEST_RUN(test_full_frame_shrinks_by_more_than_half);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,143 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_compact.h"
+#include "link/core_link_fields.h"
+
+static void make_snapshot(core_link_terrarium_snapshot_t *snap, uint8_t id)
+{
+    memset(snap, 0, sizeof(*snap));
+    snap->terrarium_id = id;
+    strncpy(snap->scientific_name, "Eublepharis macularius", CORE_LINK_NAME_MAX_LEN);
+    strncpy(snap->common_name, "Gecko l\xc3\xa9opard", CORE_LINK_NAME_MAX_LEN);
+    snap->name_ids[0] = 4;
+    snap->name_ids[1] = 9;
+    snap->temp_day_c = 30.5f + id;
+    snap->temp_night_c = 22.25f;
+    snap->humidity_day_pct = 41.0f;
+    snap->humidity_night_pct = 55.5f;
+    snap->lux_day = 380.0f;
+    snap->lux_night = 3.0f;
+    snap->hydration_pct = 91.5f;
+    snap->stress_pct = 12.0f;
+    snap->health_pct = 97.25f;
+    snap->last_feeding_timestamp = 1700000456u;
+    snap->activity_score = 0.75f;
+}
+
+static void test_wire_layout_follows_table(void)
+{
+    // STATE_FULL v1 keeps the historical layout: id, two 33-byte names, then 4-byte values.
+    HOST_TEST_ASSERT_EQ(1U + 2U * CORE_LINK_DELTA_STRING_BYTES + 11U * 4U, sizeof(core_link_snapshot_wire_t));
+    HOST_TEST_ASSERT_EQ(1U + CORE_LINK_DELTA_STRING_BYTES, offsetof(core_link_snapshot_wire_t, common_name));
+    HOST_TEST_ASSERT_EQ(sizeof(core_link_snapshot_wire_t) - 4U, offsetof(core_link_snapshot_wire_t, activity_score));
+    HOST_TEST_ASSERT_EQ(sizeof(core_link_snapshot_wire_t) - 1U, core_link_fields_v1_size(CORE_LINK_DELTA_FIELD_ALL));
+    HOST_TEST_ASSERT_EQ(0, core_link_fields_v1_size(CORE_LINK_DELTA_FIELD_NAME_IDS));
+    HOST_TEST_ASSERT_EQ(8, core_link_fields_v1_size(CORE_LINK_DELTA_FIELD_LUX_DAY | CORE_LINK_DELTA_FIELD_LAST_FEED));
+
+    core_link_terrarium_snapshot_t in;
+    make_snapshot(&in, 3);
+    core_link_snapshot_wire_t wire;
+    core_link_fields_to_wire(&wire, &in);
+    HOST_TEST_ASSERT_EQ(3, wire.terrarium_id);
+    HOST_TEST_ASSERT(strcmp(wire.common_name, in.common_name) == 0);
+    HOST_TEST_ASSERT(wire.health_pct == in.health_pct);
+    HOST_TEST_ASSERT_EQ(in.last_feeding_timestamp, wire.last_feeding_timestamp);
+
+    core_link_terrarium_snapshot_t out;
+    memset(&out, 0, sizeof(out));
+    core_link_fields_from_wire(&out, &wire);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_NAME_ID_NONE, out.name_ids[0]);
+    out.name_ids[0] = in.name_ids[0];
+    out.name_ids[1] = in.name_ids[1];
+    HOST_TEST_ASSERT(memcmp(&in, &out, sizeof(in)) == 0);
+}
+
+static void test_v1_partial_mask_roundtrip(void)
+{
+    core_link_terrarium_snapshot_t in;
+    make_snapshot(&in, 1);
+    const core_link_delta_field_mask_t mask = CORE_LINK_DELTA_FIELD_COMMON_NAME | CORE_LINK_DELTA_FIELD_HUMIDITY_NIGHT |
+                                              CORE_LINK_DELTA_FIELD_ACTIVITY;
+    uint8_t buffer[64];
+    size_t written = core_link_fields_v1_encode(buffer, sizeof(buffer), mask, &in);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_STRING_BYTES + 8U, written);
+    HOST_TEST_ASSERT_EQ(core_link_fields_v1_size(mask), written);
+
+    core_link_terrarium_snapshot_t out;
+    make_snapshot(&out, 1);
+    strcpy(out.common_name, "?");
+    out.humidity_night_pct = 0.0f;
+    out.activity_score = 0.0f;
+    out.temp_day_c = -1.0f;
+    size_t offset = 0;
+    HOST_TEST_ASSERT(core_link_fields_v1_decode(buffer, written, &offset, mask, &out));
+    HOST_TEST_ASSERT_EQ(written, offset);
+    HOST_TEST_ASSERT(strcmp(out.common_name, in.common_name) == 0);
+    HOST_TEST_ASSERT(out.humidity_night_pct == in.humidity_night_pct);
+    HOST_TEST_ASSERT(out.activity_score == in.activity_score);
+    HOST_TEST_ASSERT(out.temp_day_c == -1.0f); // outside the mask: untouched
+}
+
+static void test_v1_truncation_leaves_snapshot_untouched(void)
+{
+    core_link_terrarium_snapshot_t in;
+    make_snapshot(&in, 0);
+    uint8_t buffer[sizeof(core_link_snapshot_wire_t)];
+    size_t written = core_link_fields_v1_encode(buffer, sizeof(buffer), CORE_LINK_DELTA_FIELD_ALL, &in);
+    HOST_TEST_ASSERT(written > 0);
+    HOST_TEST_ASSERT_EQ(0, core_link_fields_v1_encode(buffer, written - 1, CORE_LINK_DELTA_FIELD_ALL, &in));
+
+    core_link_terrarium_snapshot_t out;
+    memset(&out, 0x5A, sizeof(out));
+    core_link_terrarium_snapshot_t before = out;
+    for (size_t cut = 0; cut < written; ++cut) {
+        size_t offset = 0;
+        HOST_TEST_ASSERT(!core_link_fields_v1_decode(buffer, cut, &offset, CORE_LINK_DELTA_FIELD_ALL, &out));
+        HOST_TEST_ASSERT_EQ(0, offset);
+    }
+    HOST_TEST_ASSERT(memcmp(&before, &out, sizeof(out)) == 0);
+
+    // An offset past the end is rejected rather than wrapped.
+    size_t offset = written + 1;
+    HOST_TEST_ASSERT(!core_link_fields_v1_decode(buffer, written, &offset, CORE_LINK_DELTA_FIELD_TEMP_DAY, &out));
+}
+
+static void test_compact_size_prediction(void)
+{
+    core_link_terrarium_snapshot_t in;
+    make_snapshot(&in, 2);
+    // temp ×2 (i16), 7 × u16, u32, u8.
+    HOST_TEST_ASSERT_EQ(4U + 14U + 4U + 1U, core_link_fields_compact_fixed_size(CORE_LINK_DELTA_FIELD_ALL));
+    HOST_TEST_ASSERT_EQ(2U, core_link_fields_compact_fixed_size(CORE_LINK_DELTA_FIELD_NAME_IDS));
+
+    const core_link_delta_field_mask_t masks[] = {
+        CORE_LINK_DELTA_FIELD_ALL,
+        CORE_LINK_DELTA_FIELD_ALL & (core_link_delta_field_mask_t)~CORE_LINK_DELTA_FIELD_NAMES,
+        (CORE_LINK_DELTA_FIELD_ALL & (core_link_delta_field_mask_t)~CORE_LINK_DELTA_FIELD_NAMES) |
+            CORE_LINK_DELTA_FIELD_NAME_IDS,
+        CORE_LINK_DELTA_FIELD_SCIENTIFIC_NAME | CORE_LINK_DELTA_FIELD_STRESS,
+    };
+    for (size_t i = 0; i < sizeof(masks) / sizeof(masks[0]); ++i) {
+        uint8_t buffer[128];
+        size_t written = core_link_compact_encode_fields(buffer, sizeof(buffer), masks[i], &in);
+        HOST_TEST_ASSERT(written > 0);
+        HOST_TEST_ASSERT_EQ(core_link_compact_fields_size(masks[i], &in), written);
+
+        core_link_terrarium_snapshot_t out;
+        memset(&out, 0, sizeof(out));
+        size_t offset = 0;
+        HOST_TEST_ASSERT(core_link_compact_decode_fields(buffer, written, &offset, masks[i], &out));
+        HOST_TEST_ASSERT_EQ(written, offset);
+    }
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_wire_layout_follows_table);
+    HOST_TEST_RUN(test_v1_partial_mask_roundtrip);
+    HOST_TEST_RUN(test_v1_truncation_leaves_snapshot_untouched);
+    HOST_TEST_RUN(test_compact_size_prediction);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,144 @@
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_compact.h"
+#include "link/core_link_fragment.h"
+
+static uint8_t s_source[CORE_LINK_STATE_MAX_PAYLOAD];
+static uint8_t s_target[CORE_LINK_STATE_MAX_PAYLOAD];
+
+static void fill_source(size_t length, uint8_t seed)
+{
+    for (size_t i = 0; i < length; ++i) {
+        s_source[i] = (uint8_t)(seed + i * 13U);
+    }
+}
+
+/* Pousse les fragments `first`..`count - 1` et renvoie le dernier statut. */
+static core_link_reassembly_status_t push_range(core_link_reassembly_t *r, uint8_t type, uint8_t transfer_id,
+                                                size_t length, size_t first, size_t count)
+{
+    core_link_reassembly_status_t status = CORE_LINK_REASSEMBLY_ERROR;
+    for (size_t i = first; i < count; ++i) {
+        uint8_t fragment[CORE_LINK_MAX_PAYLOAD];
+        size_t n = core_link_fragment_build(fragment, sizeof(fragment), type, transfer_id, s_source, length, (uint8_t)i);
+        if (n == 0) {
+            return CORE_LINK_REASSEMBLY_ERROR;
+        }
+        status = core_link_reassembly_push(r, fragment, n);
+    }
+    return status;
+}
+
+static void test_fragment_count(void)
+{
+    HOST_TEST_ASSERT_EQ(1, core_link_fragment_count(0));
+    HOST_TEST_ASSERT_EQ(1, core_link_fragment_count(CORE_LINK_FRAGMENT_DATA_MAX));
+    HOST_TEST_ASSERT_EQ(2, core_link_fragment_count(CORE_LINK_FRAGMENT_DATA_MAX + 1));
+    HOST_TEST_ASSERT_EQ(0, core_link_fragment_count((size_t)CORE_LINK_FRAGMENT_DATA_MAX * 256U));
+
+    uint8_t fragment[CORE_LINK_MAX_PAYLOAD];
+    fill_source(1000, 1);
+    HOST_TEST_ASSERT_EQ(0, core_link_fragment_build(fragment, sizeof(fragment), CORE_LINK_MSG_STATE_FULL, 1, s_source, 1000, 2));
+    HOST_TEST_ASSERT_EQ(0, core_link_fragment_build(fragment, 100, CORE_LINK_MSG_STATE_FULL, 1, s_source, 1000, 0));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_MAX_PAYLOAD,
+                        core_link_fragment_build(fragment, sizeof(fragment), CORE_LINK_MSG_STATE_FULL, 1, s_source, 1000, 0));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_FRAGMENT_HEADER_SIZE + 1000 - CORE_LINK_FRAGMENT_DATA_MAX,
+                        core_link_fragment_build(fragment, sizeof(fragment), CORE_LINK_MSG_STATE_FULL, 1, s_source, 1000, 1));
+    HOST_TEST_ASSERT_EQ(1, fragment[2]);
+    HOST_TEST_ASSERT_EQ(2, fragment[3]);
+}
+
+static void test_round_trip_worst_case(void)
+{
+    core_link_reassembly_t r;
+    core_link_reassembly_init(&r, s_target, sizeof(s_target));
+    const size_t length = CORE_LINK_STATE_MAX_PAYLOAD;
+    const size_t count = core_link_fragment_count(length);
+    fill_source(length, 7);
+
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_PENDING, push_range(&r, CORE_LINK_MSG_STATE_DELTA, 9, length, 0, count - 1));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_COMPLETE, push_range(&r, CORE_LINK_MSG_STATE_DELTA, 9, length, count - 1, count));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_MSG_STATE_DELTA, r.inner_type);
+    HOST_TEST_ASSERT_EQ(length, r.length);
+    HOST_TEST_ASSERT(memcmp(s_target, s_source, length) == 0);
+
+    // A single-fragment transfer completes immediately.
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_COMPLETE, push_range(&r, CORE_LINK_MSG_STATE_FULL, 10, 40, 0, 1));
+    HOST_TEST_ASSERT_EQ(40, r.length);
+}
+
+static void test_gap_and_foreign_transfer_rejected(void)
+{
+    core_link_reassembly_t r;
+    core_link_reassembly_init(&r, s_target, sizeof(s_target));
+    const size_t length = 3000;
+    fill_source(length, 3);
+    uint8_t fragment[CORE_LINK_MAX_PAYLOAD];
+
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_PENDING, push_range(&r, CORE_LINK_MSG_STATE_FULL, 1, length, 0, 2));
+    size_t n = core_link_fragment_build(fragment, sizeof(fragment), CORE_LINK_MSG_STATE_FULL, 1, s_source, length, 3);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_ERROR, core_link_reassembly_push(&r, fragment, n));
+    // Once abandoned, the rest of the transfer is rejected until a new first fragment.
+    n = core_link_fragment_build(fragment, sizeof(fragment), CORE_LINK_MSG_STATE_FULL, 1, s_source, length, 2);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_ERROR, core_link_reassembly_push(&r, fragment, n));
+
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_PENDING, push_range(&r, CORE_LINK_MSG_STATE_FULL, 2, length, 0, 1));
+    n = core_link_fragment_build(fragment, sizeof(fragment), CORE_LINK_MSG_STATE_FULL, 3, s_source, length, 1);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_ERROR, core_link_reassembly_push(&r, fragment, n));
+
+    // A new first fragment restarts cleanly, even over a pending transfer.
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_PENDING, push_range(&r, CORE_LINK_MSG_STATE_FULL, 4, length, 0, 3));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_COMPLETE,
+                        push_range(&r, CORE_LINK_MSG_STATE_FULL, 5, length, 0, core_link_fragment_count(length)));
+    HOST_TEST_ASSERT(memcmp(s_target, s_source, length) == 0);
+}
+
+static void test_malformed_fragments_rejected(void)
+{
+    uint8_t small[64];
+    core_link_reassembly_t r;
+    core_link_reassembly_init(&r, small, sizeof(small));
+    fill_source(2000, 5);
+
+    // Larger than the reassembly buffer.
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_ERROR, push_range(&r, CORE_LINK_MSG_STATE_FULL, 1, 2000, 0, 1));
+
+    core_link_reassembly_init(&r, s_target, sizeof(s_target));
+    uint8_t fragment[CORE_LINK_MAX_PAYLOAD];
+    size_t n = core_link_fragment_build(fragment, sizeof(fragment), CORE_LINK_MSG_STATE_FULL, 1, s_source, 2000, 0);
+    // Truncated non-final fragment, nested fragment, index beyond count, header only.
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_ERROR, core_link_reassembly_push(&r, fragment, n - 1));
+    fragment[0] = CORE_LINK_MSG_STATE_FRAGMENT;
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_ERROR, core_link_reassembly_push(&r, fragment, n));
+    fragment[0] = CORE_LINK_MSG_STATE_FULL;
+    fragment[2] = fragment[3];
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_ERROR, core_link_reassembly_push(&r, fragment, n));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REASSEMBLY_ERROR, core_link_reassembly_push(&r, fragment, CORE_LINK_FRAGMENT_HEADER_SIZE - 1));
+}
+
+static void test_64_terrariums_fit_state_payload(void)
+{
+    // Worst-case v1 frame and a compact frame with every name both fit the reassembly buffer.
+    size_t v1_full = 5U + CORE_LINK_MAX_TERRARIUMS * (1U + 2U * CORE_LINK_DELTA_STRING_BYTES + 11U * 4U);
+    HOST_TEST_ASSERT(v1_full <= CORE_LINK_STATE_MAX_PAYLOAD);
+
+    core_link_terrarium_snapshot_t snap = {0};
+    memset(snap.scientific_name, 'x', CORE_LINK_NAME_MAX_LEN);
+    memset(snap.common_name, 'y', CORE_LINK_NAME_MAX_LEN);
+    size_t compact_full = 5U + CORE_LINK_MAX_TERRARIUMS * (3U + core_link_compact_fields_size(CORE_LINK_DELTA_FIELD_ALL, &snap));
+    HOST_TEST_ASSERT(compact_full <= CORE_LINK_STATE_MAX_PAYLOAD);
+    printf("   64 terrariums: v1 full=%zu (%zu fragments), compact+names=%zu (%zu fragments)\n", v1_full,
+           core_link_fragment_count(v1_full), compact_full, core_link_fragment_count(compact_full));
+    HOST_TEST_ASSERT(core_link_fragment_count(CORE_LINK_STATE_MAX_PAYLOAD) <= 16);
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_fragment_count);
+    HOST_TEST_RUN(test_round_trip_worst_case);
+    HOST_TEST_RUN(test_gap_and_foreign_transfer_rejected);
+    HOST_TEST_RUN(test_malformed_fragments_rejected);
+    HOST_TEST_RUN(test_64_terrariums_fit_state_payload);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,120 @@
+#include <math.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_history.h"
+
+static void test_request_roundtrip_drops_unknown_fields(void)
+{
+    core_link_history_request_t request = {
+        .terrarium_id = 42,
+        .tier = CORE_LINK_HISTORY_TIER_QUARTER,
+        .field_mask = CORE_LINK_DELTA_FIELD_TEMP_DAY | CORE_LINK_DELTA_FIELD_STRESS | CORE_LINK_DELTA_FIELD_NAMES,
+        .before_epoch = 0x12345678U,
+        .max_buckets = 30,
+    };
+    uint8_t payload[CORE_LINK_HISTORY_REQUEST_SIZE];
+    HOST_TEST_ASSERT_EQ(0, core_link_history_request_encode(&request, payload, sizeof(payload) - 1));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_REQUEST_SIZE, core_link_history_request_encode(&request, payload, sizeof(payload)));
+
+    core_link_history_request_t out;
+    HOST_TEST_ASSERT(!core_link_history_request_decode(payload, sizeof(payload) - 1, &out));
+    HOST_TEST_ASSERT(core_link_history_request_decode(payload, sizeof(payload), &out));
+    HOST_TEST_ASSERT_EQ(42, out.terrarium_id);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_TIER_QUARTER, out.tier);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_FIELD_TEMP_DAY | CORE_LINK_DELTA_FIELD_STRESS, out.field_mask);
+    HOST_TEST_ASSERT_EQ(0x12345678U, out.before_epoch);
+    HOST_TEST_ASSERT_EQ(30, out.max_buckets);
+}
+
+static void test_chunk_roundtrip_keeps_selected_fields(void)
+{
+    core_link_delta_field_mask_t mask = CORE_LINK_DELTA_FIELD_TEMP_NIGHT | CORE_LINK_DELTA_FIELD_ACTIVITY;
+    core_link_history_bucket_t buckets[2];
+    memset(buckets, 0, sizeof(buckets));
+    for (size_t b = 0; b < 2; ++b) {
+        buckets[b].samples = (uint16_t)(600 - b);
+        for (size_t m = 0; m < CORE_LINK_HISTORY_METRIC_COUNT; ++m) {
+            buckets[b].min[m] = (uint16_t)(100 * b + m);
+            buckets[b].max[m] = (uint16_t)(200 * b + m);
+            buckets[b].mean[m] = (uint16_t)(300 * b + m);
+        }
+    }
+
+    uint8_t payload[CORE_LINK_HISTORY_CHUNK_HEADER_SIZE + 2 * 14];
+    HOST_TEST_ASSERT_EQ(14, core_link_history_bucket_size(mask));
+    size_t length = CORE_LINK_HISTORY_CHUNK_HEADER_SIZE;
+    for (size_t b = 0; b < 2; ++b) {
+        length += core_link_history_bucket_encode(mask, &buckets[b], &payload[length], sizeof(payload) - length);
+    }
+    HOST_TEST_ASSERT_EQ(sizeof(payload), length);
+    HOST_TEST_ASSERT_EQ(0, core_link_history_bucket_encode(mask, &buckets[0], payload, 13));
+
+    core_link_history_chunk_t chunk = {
+        .terrarium_id = 7,
+        .tier = CORE_LINK_HISTORY_TIER_SIX_HOURS,
+        .field_mask = mask,
+        .end_epoch = 86400U,
+        .count = 2,
+        .flags = CORE_LINK_HISTORY_FLAG_MORE,
+    };
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_CHUNK_HEADER_SIZE, core_link_history_chunk_encode_header(&chunk, payload, length));
+
+    core_link_history_chunk_t out;
+    HOST_TEST_ASSERT(core_link_history_chunk_decode(payload, length, &out));
+    HOST_TEST_ASSERT_EQ(7, out.terrarium_id);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_TIER_SIX_HOURS, out.tier);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_OK, out.status);
+    HOST_TEST_ASSERT_EQ(mask, out.field_mask);
+    HOST_TEST_ASSERT_EQ(86400U, out.end_epoch);
+    HOST_TEST_ASSERT_EQ(2, out.count);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_FLAG_MORE, out.flags);
+
+    core_link_history_bucket_t bucket;
+    core_link_history_chunk_bucket(&out, 1, &bucket);
+    HOST_TEST_ASSERT_EQ(599, bucket.samples);
+    HOST_TEST_ASSERT_EQ(101, bucket.min[1]); // temp_night
+    HOST_TEST_ASSERT_EQ(209, bucket.max[9]); // activity
+    HOST_TEST_ASSERT_EQ(309, bucket.mean[9]);
+    HOST_TEST_ASSERT_EQ(0, bucket.min[0]); // not requested
+    HOST_TEST_ASSERT_EQ(0, bucket.mean[7]);
+}
+
+static void test_truncated_chunk_is_rejected(void)
+{
+    core_link_history_chunk_t chunk = {
+        .field_mask = CORE_LINK_DELTA_FIELD_HEALTH,
+        .count = 3,
+    };
+    uint8_t payload[CORE_LINK_HISTORY_CHUNK_HEADER_SIZE + 3 * 8];
+    memset(payload, 0, sizeof(payload));
+    core_link_history_chunk_encode_header(&chunk, payload, sizeof(payload));
+    core_link_history_chunk_t out;
+    HOST_TEST_ASSERT(core_link_history_chunk_decode(payload, sizeof(payload), &out));
+    HOST_TEST_ASSERT(!core_link_history_chunk_decode(payload, sizeof(payload) - 1, &out));
+    HOST_TEST_ASSERT(!core_link_history_chunk_decode(payload, CORE_LINK_HISTORY_CHUNK_HEADER_SIZE - 1, &out));
+}
+
+static void test_quantize_matches_compact_scales(void)
+{
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_FIELD_TEMP_DAY, core_link_history_metric_field(0));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_FIELD_ACTIVITY, core_link_history_metric_field(9));
+
+    uint16_t raw = core_link_history_quantize(0, -12.34f);
+    HOST_TEST_ASSERT_EQ(-1234, (int16_t)raw);
+    HOST_TEST_ASSERT(core_link_history_value(0, raw) > -12.345f && core_link_history_value(0, raw) < -12.335f);
+    HOST_TEST_ASSERT_EQ(INT16_MAX, (int16_t)core_link_history_quantize(0, 1000.0f));
+    HOST_TEST_ASSERT_EQ(655, core_link_history_quantize(2, 65.5f));
+    HOST_TEST_ASSERT_EQ(0, core_link_history_quantize(2, -3.0f));
+    HOST_TEST_ASSERT_EQ(UINT16_MAX, core_link_history_quantize(4, 1e9f));
+    HOST_TEST_ASSERT_EQ(0, core_link_history_quantize(7, NAN));
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_request_roundtrip_drops_unknown_fields);
+    HOST_TEST_RUN(test_chunk_roundtrip_keeps_selected_fields);
+    HOST_TEST_RUN(test_truncated_chunk_is_rejected);
+    HOST_TEST_RUN(test_quantize_matches_compact_scales);
+    return HOST_TEST_EXIT();
+}
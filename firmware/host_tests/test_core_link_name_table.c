@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_compact.h"
+#include "link/core_link_name_table.h"
+#include "link/core_link_stream.h"
+
+static core_link_name_table_t s_core_table;
+static core_link_name_table_t s_display_table;
+
+/* Sérialise toute la table comme le cœur, message par message. */
+static bool replicate(uint8_t first_id, bool reset, size_t capacity, size_t *out_messages)
+{
+    uint8_t payload[CORE_LINK_MAX_PAYLOAD];
+    uint8_t next_id = first_id;
+    size_t messages = 0;
+    do {
+        size_t written = core_link_name_table_encode(&s_core_table, &next_id, reset, payload, capacity);
+        if (written == 0 || !core_link_name_table_apply(&s_display_table, payload, written, NULL)) {
+            return false;
+        }
+        reset = false;
+        ++messages;
+    } while (next_id < s_core_table.count);
+    if (out_messages) {
+        *out_messages = messages;
+    }
+    return true;
+}
+
+static void test_intern_is_stable(void)
+{
+    core_link_name_table_reset(&s_core_table, 1);
+    HOST_TEST_ASSERT_EQ(0, core_link_name_table_intern(&s_core_table, "Python regius"));
+    HOST_TEST_ASSERT_EQ(1, core_link_name_table_intern(&s_core_table, "Python royal"));
+    HOST_TEST_ASSERT_EQ(0, core_link_name_table_intern(&s_core_table, "Python regius"));
+    HOST_TEST_ASSERT_EQ(2, core_link_name_table_intern(&s_core_table, ""));
+    HOST_TEST_ASSERT_EQ(2, core_link_name_table_intern(&s_core_table, ""));
+    HOST_TEST_ASSERT_EQ(3, s_core_table.count);
+    HOST_TEST_ASSERT(strcmp(core_link_name_table_lookup(&s_core_table, 1), "Python royal") == 0);
+    HOST_TEST_ASSERT(core_link_name_table_lookup(&s_core_table, 3) == NULL);
+
+    // Names are capped at CORE_LINK_NAME_MAX_LEN, so a longer spelling maps to the same entry.
+    char longer[CORE_LINK_NAME_MAX_LEN + 8];
+    memset(longer, 'a', sizeof(longer) - 1);
+    longer[sizeof(longer) - 1] = '\0';
+    uint8_t id = core_link_name_table_intern(&s_core_table, longer);
+    longer[CORE_LINK_NAME_MAX_LEN] = '\0';
+    HOST_TEST_ASSERT_EQ(id, core_link_name_table_intern(&s_core_table, longer));
+
+    core_link_name_table_reset(&s_core_table, 2);
+    for (unsigned i = 0; i < CORE_LINK_NAME_TABLE_MAX; ++i) {
+        char name[16];
+        snprintf(name, sizeof(name), "espece %u", i);
+        HOST_TEST_ASSERT_EQ(i, core_link_name_table_intern(&s_core_table, name));
+    }
+    HOST_TEST_ASSERT_EQ(CORE_LINK_NAME_ID_NONE, core_link_name_table_intern(&s_core_table, "une de trop"));
+    HOST_TEST_ASSERT_EQ(5, core_link_name_table_intern(&s_core_table, "espece 5"));
+}
+
+static void test_full_table_replicates_in_chunks(void)
+{
+    core_link_name_table_reset(&s_core_table, 7);
+    for (unsigned i = 0; i < CORE_LINK_NAME_TABLE_MAX; ++i) {
+        char name[CORE_LINK_NAME_MAX_LEN + 1];
+        snprintf(name, sizeof(name), "Espece numero %03u de la serie", i);
+        core_link_name_table_intern(&s_core_table, name);
+    }
+    memset(&s_display_table, 0, sizeof(s_display_table));
+
+    size_t messages = 0;
+    HOST_TEST_ASSERT(replicate(0, true, CORE_LINK_MAX_PAYLOAD, &messages));
+    printf("   %u names of 30 bytes: %zu NAME_TABLE message(s)\n", (unsigned)CORE_LINK_NAME_TABLE_MAX, messages);
+    HOST_TEST_ASSERT(messages > 1);
+    HOST_TEST_ASSERT_EQ(7, s_display_table.generation);
+    HOST_TEST_ASSERT_EQ(s_core_table.count, s_display_table.count);
+    for (uint8_t id = 0; id < s_core_table.count; ++id) {
+        HOST_TEST_ASSERT(strcmp(core_link_name_table_lookup(&s_core_table, id),
+                                core_link_name_table_lookup(&s_display_table, id)) == 0);
+    }
+}
+
+static void test_incremental_and_generation_checks(void)
+{
+    core_link_name_table_reset(&s_core_table, 3);
+    core_link_name_table_intern(&s_core_table, "Pogona vitticeps");
+    memset(&s_display_table, 0, sizeof(s_display_table));
+    HOST_TEST_ASSERT(replicate(0, true, CORE_LINK_MAX_PAYLOAD, NULL));
+
+    // Only the new entry travels the second time.
+    uint8_t added = core_link_name_table_intern(&s_core_table, "Dragon barbu");
+    uint8_t payload[CORE_LINK_MAX_PAYLOAD];
+    uint8_t next_id = 1;
+    size_t written = core_link_name_table_encode(&s_core_table, &next_id, false, payload, sizeof(payload));
+    HOST_TEST_ASSERT_EQ(3U + 2U + strlen("Dragon barbu"), written);
+    bool reset = true;
+    HOST_TEST_ASSERT(core_link_name_table_apply(&s_display_table, payload, written, &reset));
+    HOST_TEST_ASSERT(!reset);
+    HOST_TEST_ASSERT(strcmp(core_link_name_table_lookup(&s_display_table, added), "Dragon barbu") == 0);
+    HOST_TEST_ASSERT(strcmp(core_link_name_table_lookup(&s_display_table, 0), "Pogona vitticeps") == 0);
+
+    // A later generation without RESET, or a truncated payload, is refused untouched.
+    payload[0] = 4;
+    HOST_TEST_ASSERT(!core_link_name_table_apply(&s_display_table, payload, written, NULL));
+    payload[0] = 3;
+    for (size_t cut = 0; cut < written; ++cut) {
+        HOST_TEST_ASSERT(!core_link_name_table_apply(&s_display_table, payload, cut, NULL));
+    }
+    HOST_TEST_ASSERT_EQ(2, s_display_table.count);
+
+    // RELOAD_PROFILES: the core opens a new generation, the display starts over.
+    core_link_name_table_reset(&s_core_table, 4);
+    core_link_name_table_intern(&s_core_table, "Eublepharis macularius");
+    HOST_TEST_ASSERT(replicate(0, true, CORE_LINK_MAX_PAYLOAD, NULL));
+    HOST_TEST_ASSERT_EQ(1, s_display_table.count);
+    HOST_TEST_ASSERT(core_link_name_table_lookup(&s_display_table, 1) == NULL);
+}
+
+static void test_name_ids_shrink_full_frames(void)
+{
+    core_link_terrarium_snapshot_t snap = {0};
+    strcpy(snap.scientific_name, "Correlophus ciliatus");
+    strcpy(snap.common_name, "Gecko \xc3\xa0 cr\xc3\xaate");
+    snap.name_ids[0] = 12;
+    snap.name_ids[1] = 13;
+    snap.temp_day_c = 28.5f;
+
+    const core_link_delta_field_mask_t with_ids =
+        (CORE_LINK_DELTA_FIELD_ALL & ~CORE_LINK_DELTA_FIELD_NAMES) | CORE_LINK_DELTA_FIELD_NAME_IDS;
+    uint8_t buffer[128];
+    size_t written = core_link_compact_encode_fields(buffer, sizeof(buffer), with_ids, &snap);
+    HOST_TEST_ASSERT_EQ(core_link_compact_fields_size(with_ids, &snap), written);
+
+    core_link_terrarium_snapshot_t out = {0};
+    size_t offset = 0;
+    HOST_TEST_ASSERT(core_link_compact_decode_fields(buffer, written, &offset, with_ids, &out));
+    HOST_TEST_ASSERT_EQ(12, out.name_ids[0]);
+    HOST_TEST_ASSERT_EQ(13, out.name_ids[1]);
+    HOST_TEST_ASSERT(out.scientific_name[0] == '\0');
+
+    // Both IDs follow a rename together in the delta mask.
+    core_link_terrarium_snapshot_t renamed = snap;
+    renamed.name_ids[1] = 14;
+    HOST_TEST_ASSERT(core_link_compact_diff_mask(&renamed, &snap) & CORE_LINK_DELTA_FIELD_NAME_IDS);
+
+    size_t inline_names = core_link_compact_fields_size(CORE_LINK_DELTA_FIELD_ALL, &snap);
+    printf("   STATE_FULL_COMPACT x%u: %zu bytes with inline names, %zu with name IDs\n", CORE_LINK_MAX_TERRARIUMS,
+           (size_t)CORE_LINK_MAX_TERRARIUMS * (3U + inline_names), (size_t)CORE_LINK_MAX_TERRARIUMS * (3U + written));
+    HOST_TEST_ASSERT(inline_names > written + 30U);
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_intern_is_stable);
+    HOST_TEST_RUN(test_full_table_replicates_in_chunks);
+    HOST_TEST_RUN(test_incremental_and_generation_checks);
+    HOST_TEST_RUN(test_name_ids_shrink_full_frames);
+    return HOST_TEST_EXIT();
+}
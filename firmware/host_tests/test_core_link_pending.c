@@ -0,0 +1,136 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_pending.h"
+
+typedef struct {
+    int calls;
+} counter_t;
+
+static void count_cb(core_link_command_opcode_t opcode, int status, uint8_t terrarium_count, void *ctx)
+{
+    (void)opcode;
+    (void)status;
+    (void)terrarium_count;
+    ((counter_t *)ctx)->calls++;
+}
+
+static void test_ids_are_unique_and_never_none(void)
+{
+    core_link_pending_t table;
+    core_link_pending_init(&table);
+    uint16_t ids[CORE_LINK_PENDING_MAX];
+    for (size_t i = 0; i < CORE_LINK_PENDING_MAX; ++i) {
+        ids[i] = core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, 0, 100, NULL, NULL);
+        HOST_TEST_ASSERT(ids[i] != CORE_LINK_REQUEST_ID_NONE);
+        for (size_t j = 0; j < i; ++j) {
+            HOST_TEST_ASSERT(ids[i] != ids[j]);
+        }
+    }
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PENDING_MAX, core_link_pending_count(&table));
+    // Full table: the caller must refuse the command.
+    HOST_TEST_ASSERT_EQ(CORE_LINK_REQUEST_ID_NONE,
+                        core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, 0, 100, NULL, NULL));
+
+    // Wrapping the counter skips 0 and the IDs still held.
+    HOST_TEST_ASSERT(core_link_pending_take(&table, ids[1], NULL));
+    table.next_id = 0xFFFF;
+    uint16_t wrapped = core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, 0, 100, NULL, NULL);
+    HOST_TEST_ASSERT_EQ(0xFFFF, wrapped);
+    HOST_TEST_ASSERT(core_link_pending_take(&table, ids[2], NULL));
+    uint16_t next = core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, 0, 100, NULL, NULL);
+    HOST_TEST_ASSERT(next != CORE_LINK_REQUEST_ID_NONE);
+    HOST_TEST_ASSERT(next != ids[0]);
+    HOST_TEST_ASSERT(next != wrapped);
+}
+
+static void test_take_by_id_out_of_order(void)
+{
+    core_link_pending_t table;
+    core_link_pending_init(&table);
+    counter_t counters[3] = {{0}};
+    uint16_t ids[3];
+    for (size_t i = 0; i < 3; ++i) {
+        ids[i] = core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, 10, 100, count_cb, &counters[i]);
+    }
+
+    core_link_pending_entry_t entry;
+    HOST_TEST_ASSERT(core_link_pending_take(&table, ids[2], &entry));
+    HOST_TEST_ASSERT_EQ(ids[2], entry.request_id);
+    HOST_TEST_ASSERT(entry.ctx == &counters[2]);
+    entry.cb(entry.opcode, 0, 0, entry.ctx);
+    HOST_TEST_ASSERT_EQ(1, counters[2].calls);
+    HOST_TEST_ASSERT_EQ(0, counters[0].calls);
+
+    // A duplicate or stale ACK finds nothing.
+    HOST_TEST_ASSERT(!core_link_pending_take(&table, ids[2], &entry));
+    HOST_TEST_ASSERT(!core_link_pending_take(&table, CORE_LINK_REQUEST_ID_NONE, &entry));
+    HOST_TEST_ASSERT_EQ(2, core_link_pending_count(&table));
+}
+
+static void test_legacy_ack_takes_oldest_of_opcode(void)
+{
+    core_link_pending_t table;
+    core_link_pending_init(&table);
+    uint16_t first = core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, 0, 100, NULL, NULL);
+    uint16_t other = core_link_pending_add(&table, 0x42, 0, 100, NULL, NULL);
+    uint16_t second = core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, 0, 100, NULL, NULL);
+    // Reuse the first slot so slot order no longer matches send order.
+    HOST_TEST_ASSERT(core_link_pending_take(&table, first, NULL));
+    uint16_t third = core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, 0, 100, NULL, NULL);
+
+    core_link_pending_entry_t entry;
+    HOST_TEST_ASSERT(core_link_pending_take_opcode(&table, CORE_LINK_CMD_RELOAD_PROFILES, &entry));
+    HOST_TEST_ASSERT_EQ(second, entry.request_id);
+    HOST_TEST_ASSERT(core_link_pending_take_opcode(&table, CORE_LINK_CMD_RELOAD_PROFILES, &entry));
+    HOST_TEST_ASSERT_EQ(third, entry.request_id);
+    HOST_TEST_ASSERT(!core_link_pending_take_opcode(&table, CORE_LINK_CMD_RELOAD_PROFILES, &entry));
+    HOST_TEST_ASSERT(core_link_pending_take_opcode(&table, 0x42, &entry));
+    HOST_TEST_ASSERT_EQ(other, entry.request_id);
+}
+
+static void test_expiry_is_wrap_safe(void)
+{
+    core_link_pending_t table;
+    core_link_pending_init(&table);
+    const uint32_t start = UINT32_MAX - 50;
+    uint16_t soon = core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, start, 40, NULL, NULL);
+    uint16_t late = core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, start, 200, NULL, NULL);
+
+    core_link_pending_entry_t entry;
+    HOST_TEST_ASSERT(!core_link_pending_take_expired(&table, start + 39, &entry));
+    HOST_TEST_ASSERT(core_link_pending_take_expired(&table, start + 40, &entry));
+    HOST_TEST_ASSERT_EQ(soon, entry.request_id);
+    // The tick counter wraps between send and deadline.
+    HOST_TEST_ASSERT(!core_link_pending_take_expired(&table, start + 120, &entry));
+    HOST_TEST_ASSERT(core_link_pending_take_expired(&table, start + 260, &entry));
+    HOST_TEST_ASSERT_EQ(late, entry.request_id);
+    HOST_TEST_ASSERT_EQ(0, core_link_pending_count(&table));
+}
+
+static void test_take_any_drains(void)
+{
+    core_link_pending_t table;
+    core_link_pending_init(&table);
+    for (int i = 0; i < 5; ++i) {
+        core_link_pending_add(&table, CORE_LINK_CMD_RELOAD_PROFILES, 0, 100, NULL, NULL);
+    }
+    core_link_pending_entry_t entry;
+    int drained = 0;
+    while (core_link_pending_take_any(&table, &entry)) {
+        ++drained;
+    }
+    HOST_TEST_ASSERT_EQ(5, drained);
+    HOST_TEST_ASSERT_EQ(0, core_link_pending_count(&table));
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_ids_are_unique_and_never_none);
+    HOST_TEST_RUN(test_take_by_id_out_of_order);
+    HOST_TEST_RUN(test_legacy_ack_takes_oldest_of_opcode);
+    HOST_TEST_RUN(test_expiry_is_wrap_safe);
+    HOST_TEST_RUN(test_take_any_drains);
+    return HOST_TEST_EXIT();
+}
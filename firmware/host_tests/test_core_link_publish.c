@@ -0,0 +1,167 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_publish.h"
+
+#define TEST_TERRARIUMS 4U
+
+static uint8_t s_reference_storage[CORE_LINK_STATE_FRAME_SIZE(TEST_TERRARIUMS)];
+static uint8_t s_frame_storage[CORE_LINK_STATE_FRAME_SIZE(TEST_TERRARIUMS)];
+
+static const core_link_publish_policy_t s_policy = {
+    .deadband = CORE_LINK_PUBLISH_DEADBANDS_DEFAULT,
+    .min_interval_ms = 200,
+    .max_interval_ms = 2000,
+    .alert_health_below_pct = 40.0f,
+    .alert_hydration_below_pct = 30.0f,
+    .alert_stress_above_pct = 70.0f,
+};
+
+static core_link_state_frame_t *setup(core_link_publish_scheduler_t *sched)
+{
+    core_link_publish_init(sched, &s_policy, (core_link_state_frame_t *)s_reference_storage, TEST_TERRARIUMS);
+    core_link_state_frame_t *frame = (core_link_state_frame_t *)s_frame_storage;
+    core_link_state_frame_init(frame, TEST_TERRARIUMS);
+    frame->terrarium_count = TEST_TERRARIUMS;
+    for (uint8_t i = 0; i < TEST_TERRARIUMS; ++i) {
+        core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
+        snap->terrarium_id = i;
+        snprintf(snap->scientific_name, sizeof(snap->scientific_name), "Espece %u", i);
+        snap->temp_day_c = 30.0f;
+        snap->humidity_day_pct = 60.0f;
+        snap->lux_day = 400.0f;
+        snap->hydration_pct = 80.0f;
+        snap->stress_pct = 20.0f;
+        snap->health_pct = 90.0f;
+        snap->activity_score = 0.5f;
+    }
+    return frame;
+}
+
+static void test_first_publish_is_forced(void)
+{
+    core_link_publish_scheduler_t sched;
+    core_link_state_frame_t *frame = setup(&sched);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_FORCED, core_link_publish_evaluate(&sched, frame, 0));
+    core_link_publish_mark_published(&sched, frame, 0);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_NONE, core_link_publish_evaluate(&sched, frame, 100));
+}
+
+static void test_deadband_accumulates_drift(void)
+{
+    core_link_publish_scheduler_t sched;
+    core_link_state_frame_t *frame = setup(&sched);
+    core_link_publish_mark_published(&sched, frame, 0);
+
+    // Each step is below the band, but the drift against the last publication is not.
+    uint32_t now = 0;
+    core_link_publish_reason_t reason = CORE_LINK_PUBLISH_NONE;
+    unsigned steps = 0;
+    while (reason == CORE_LINK_PUBLISH_NONE && steps < 100) {
+        now += 100;
+        frame->terrariums[2].temp_day_c += 0.02f;
+        reason = core_link_publish_evaluate(&sched, frame, now);
+        ++steps;
+    }
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_CHANGE, reason);
+    HOST_TEST_ASSERT(steps >= 4 && steps <= 6);
+}
+
+static void test_min_interval_and_heartbeat(void)
+{
+    core_link_publish_scheduler_t sched;
+    core_link_state_frame_t *frame = setup(&sched);
+    core_link_publish_mark_published(&sched, frame, 1000);
+
+    frame->terrariums[0].humidity_day_pct += 3.0f;
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_NONE, core_link_publish_evaluate(&sched, frame, 1100));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_CHANGE, core_link_publish_evaluate(&sched, frame, 1200));
+    core_link_publish_mark_published(&sched, frame, 1200);
+
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_NONE, core_link_publish_evaluate(&sched, frame, 3199));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_HEARTBEAT, core_link_publish_evaluate(&sched, frame, 3200));
+
+    // Millisecond counter wrap-around.
+    core_link_publish_mark_published(&sched, frame, UINT32_MAX - 50U);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_NONE, core_link_publish_evaluate(&sched, frame, 100));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_HEARTBEAT, core_link_publish_evaluate(&sched, frame, 2000));
+}
+
+static void test_alerts_bypass_min_interval(void)
+{
+    core_link_publish_scheduler_t sched;
+    core_link_state_frame_t *frame = setup(&sched);
+    core_link_publish_mark_published(&sched, frame, 0);
+
+    frame->terrariums[1].stress_pct = 70.2f;
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_ALERT, core_link_publish_evaluate(&sched, frame, 10));
+    core_link_publish_mark_published(&sched, frame, 10);
+
+    // Leaving the alert zone is just as urgent.
+    frame->terrariums[1].stress_pct = 69.9f;
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_ALERT, core_link_publish_evaluate(&sched, frame, 20));
+    core_link_publish_mark_published(&sched, frame, 20);
+
+    frame->terrariums[3].health_pct = 39.0f;
+    frame->terrariums[3].hydration_pct = 29.0f;
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_ALERT, core_link_publish_evaluate(&sched, frame, 30));
+}
+
+static void test_structure_changes_are_significant(void)
+{
+    core_link_publish_scheduler_t sched;
+    core_link_state_frame_t *frame = setup(&sched);
+    core_link_publish_mark_published(&sched, frame, 0);
+
+    frame->terrariums[0].last_feeding_timestamp = 1700000000u;
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_CHANGE, core_link_publish_evaluate(&sched, frame, 500));
+    core_link_publish_mark_published(&sched, frame, 500);
+
+    strcpy(frame->terrariums[2].common_name, "Gecko");
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_CHANGE, core_link_publish_evaluate(&sched, frame, 1000));
+    core_link_publish_mark_published(&sched, frame, 1000);
+
+    frame->terrarium_count = 3;
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_CHANGE, core_link_publish_evaluate(&sched, frame, 1500));
+    core_link_publish_mark_published(&sched, frame, 1500);
+
+    frame->terrariums[1].activity_score = NAN;
+    HOST_TEST_ASSERT_EQ(CORE_LINK_PUBLISH_CHANGE, core_link_publish_evaluate(&sched, frame, 2000));
+}
+
+static void test_steady_state_publishes_less_than_fixed_timer(void)
+{
+    core_link_publish_scheduler_t sched;
+    core_link_state_frame_t *frame = setup(&sched);
+
+    // One minute of 100 ms simulation steps: slow temperature drift plus sub-band noise.
+    unsigned published = 0;
+    for (uint32_t step = 0; step < 600; ++step) {
+        uint32_t now = step * 100U;
+        float noise = (step % 2U) ? 0.01f : -0.01f;
+        for (uint8_t i = 0; i < TEST_TERRARIUMS; ++i) {
+            frame->terrariums[i].temp_day_c = 30.0f + 0.001f * (float)step + noise;
+            frame->terrariums[i].stress_pct = 20.0f - noise;
+        }
+        if (core_link_publish_evaluate(&sched, frame, now) != CORE_LINK_PUBLISH_NONE) {
+            core_link_publish_mark_published(&sched, frame, now);
+            ++published;
+        }
+    }
+    printf("   60 s steady state: %u publications (fixed 500 ms timer: 120)\n", published);
+    HOST_TEST_ASSERT(published > 0);
+    HOST_TEST_ASSERT(published <= 40);
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_first_publish_is_forced);
+    HOST_TEST_RUN(test_deadband_accumulates_drift);
+    HOST_TEST_RUN(test_min_interval_and_heartbeat);
+    HOST_TEST_RUN(test_alerts_bypass_min_interval);
+    HOST_TEST_RUN(test_structure_changes_are_significant);
+    HOST_TEST_RUN(test_steady_state_publishes_less_than_fixed_timer);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,133 @@
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_stats.h"
+
+static core_link_stats_t s_stats;
+
+static void test_rtt_buckets(void)
+{
+    HOST_TEST_ASSERT_EQ(0, core_link_stats_rtt_bucket(0));
+    HOST_TEST_ASSERT_EQ(0, core_link_stats_rtt_bucket(1));
+    HOST_TEST_ASSERT_EQ(1, core_link_stats_rtt_bucket(2));
+    HOST_TEST_ASSERT_EQ(1, core_link_stats_rtt_bucket(3));
+    HOST_TEST_ASSERT_EQ(9, core_link_stats_rtt_bucket(1000));
+    HOST_TEST_ASSERT_EQ(10, core_link_stats_rtt_bucket(1024));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_RTT_BUCKETS - 1, core_link_stats_rtt_bucket(1U << 19));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_RTT_BUCKETS - 1, core_link_stats_rtt_bucket(UINT32_MAX));
+}
+
+static void test_rtt_percentiles(void)
+{
+    core_link_stats_reset(&s_stats);
+    core_link_stats_snapshot_t snap;
+    core_link_stats_snapshot(&s_stats, 0, &snap);
+    HOST_TEST_ASSERT_EQ(0, core_link_stats_rtt_percentile_us(&snap, 50));
+
+    // 90 fast round trips around 300 µs, 10 slow ones around 5 ms.
+    for (int i = 0; i < 90; ++i) {
+        core_link_stats_record_rtt(&s_stats, 300);
+    }
+    for (int i = 0; i < 10; ++i) {
+        core_link_stats_record_rtt(&s_stats, 5000);
+    }
+    core_link_stats_snapshot(&s_stats, 0, &snap);
+    HOST_TEST_ASSERT_EQ(100, core_link_stats_rtt_samples(&snap));
+    HOST_TEST_ASSERT_EQ(5000, snap.rtt_max_us);
+    HOST_TEST_ASSERT_EQ(5000, snap.rtt_last_us);
+    HOST_TEST_ASSERT_EQ(512, core_link_stats_rtt_percentile_us(&snap, 50));
+    HOST_TEST_ASSERT_EQ(512, core_link_stats_rtt_percentile_us(&snap, 90));
+    // Bucket [4096, 8192) is capped by the worst round trip observed.
+    HOST_TEST_ASSERT_EQ(5000, core_link_stats_rtt_percentile_us(&snap, 95));
+    HOST_TEST_ASSERT_EQ(5000, core_link_stats_rtt_percentile_us(&snap, 100));
+}
+
+static void test_latency_histogram_is_separate(void)
+{
+    core_link_stats_reset(&s_stats);
+    core_link_stats_record_rtt(&s_stats, 900);
+    for (int i = 0; i < 19; ++i) {
+        core_link_stats_record_latency(&s_stats, 30000);
+    }
+    core_link_stats_record_latency(&s_stats, 250000);
+    core_link_stats_snapshot_t snap;
+    core_link_stats_snapshot(&s_stats, 0, &snap);
+    HOST_TEST_ASSERT_EQ(1, core_link_stats_rtt_samples(&snap));
+    HOST_TEST_ASSERT_EQ(20, core_link_stats_latency_samples(&snap));
+    HOST_TEST_ASSERT_EQ(32768, core_link_stats_latency_percentile_us(&snap, 50));
+    HOST_TEST_ASSERT_EQ(250000, core_link_stats_latency_percentile_us(&snap, 100));
+    HOST_TEST_ASSERT_EQ(900, core_link_stats_rtt_percentile_us(&snap, 100));
+
+    // Display-local: LINK_STATS does not carry it.
+    uint8_t payload[CORE_LINK_STATS_PAYLOAD_SIZE];
+    core_link_stats_snapshot_t decoded;
+    HOST_TEST_ASSERT(core_link_stats_encode(&snap, payload, sizeof(payload)) > 0);
+    HOST_TEST_ASSERT(core_link_stats_decode(payload, sizeof(payload), &decoded));
+    HOST_TEST_ASSERT_EQ(0, core_link_stats_latency_samples(&decoded));
+}
+
+static void test_rates_survive_wrap(void)
+{
+    core_link_stats_snapshot_t prev;
+    core_link_stats_snapshot_t cur;
+    memset(&prev, 0, sizeof(prev));
+    memset(&cur, 0, sizeof(cur));
+    prev.uptime_ms = UINT32_MAX - 499U;
+    cur.uptime_ms = 1500U;
+    prev.counters[CORE_LINK_STAT_BYTES_RX] = UINT32_MAX - 999U;
+    cur.counters[CORE_LINK_STAT_BYTES_RX] = 3000U;
+    HOST_TEST_ASSERT_EQ(2000, core_link_stats_rate(&prev, &cur, CORE_LINK_STAT_BYTES_RX));
+    HOST_TEST_ASSERT_EQ(0, core_link_stats_rate(&cur, &cur, CORE_LINK_STAT_BYTES_RX));
+}
+
+static void test_payload_round_trip(void)
+{
+    core_link_stats_reset(&s_stats);
+    for (uint32_t i = 0; i < CORE_LINK_STAT_COUNT; ++i) {
+        core_link_stats_add(&s_stats, (core_link_stat_id_t)i, 1000U + i);
+    }
+    core_link_stats_record_rtt(&s_stats, 700);
+    core_link_stats_snapshot_t snap;
+    core_link_stats_snapshot(&s_stats, 123456U, &snap);
+
+    uint8_t payload[CORE_LINK_STATS_PAYLOAD_SIZE];
+    HOST_TEST_ASSERT_EQ(0, core_link_stats_encode(&snap, payload, sizeof(payload) - 1));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_STATS_PAYLOAD_SIZE, core_link_stats_encode(&snap, payload, sizeof(payload)));
+
+    core_link_stats_snapshot_t decoded;
+    HOST_TEST_ASSERT(core_link_stats_decode(payload, sizeof(payload), &decoded));
+    HOST_TEST_ASSERT(memcmp(&snap, &decoded, sizeof(snap)) == 0);
+    HOST_TEST_ASSERT(!core_link_stats_decode(payload, sizeof(payload) - 1, &decoded));
+}
+
+static void test_payload_from_older_peer(void)
+{
+    // A peer that only knows the first two counters and four buckets.
+    uint8_t payload[2 + 4 * (3 + 2 + 4)];
+    memset(payload, 0, sizeof(payload));
+    payload[0] = 2;
+    payload[1] = 4;
+    payload[2] = 0x10;    /* uptime_ms = 16 */
+    payload[14] = 7;      /* FRAMES_TX */
+    payload[18] = 9;      /* FRAMES_RX */
+    payload[22 + 12] = 3; /* seau 3 */
+    core_link_stats_snapshot_t decoded;
+    HOST_TEST_ASSERT(core_link_stats_decode(payload, sizeof(payload), &decoded));
+    HOST_TEST_ASSERT_EQ(16, decoded.uptime_ms);
+    HOST_TEST_ASSERT_EQ(7, decoded.counters[CORE_LINK_STAT_FRAMES_TX]);
+    HOST_TEST_ASSERT_EQ(9, decoded.counters[CORE_LINK_STAT_FRAMES_RX]);
+    HOST_TEST_ASSERT_EQ(0, decoded.counters[CORE_LINK_STAT_RESYNCS]);
+    HOST_TEST_ASSERT_EQ(3, decoded.rtt_buckets[3]);
+    HOST_TEST_ASSERT_EQ(3, core_link_stats_rtt_samples(&decoded));
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_rtt_buckets);
+    HOST_TEST_RUN(test_rtt_percentiles);
+    HOST_TEST_RUN(test_latency_histogram_is_separate);
+    HOST_TEST_RUN(test_rates_survive_wrap);
+    HOST_TEST_RUN(test_payload_round_trip);
+    HOST_TEST_RUN(test_payload_from_older_peer);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,231 @@
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_stream.h"
+
+#define TEST_RING_SIZE 1024
+
+static uint8_t s_storage[CORE_LINK_STREAM_STORAGE_SIZE(TEST_RING_SIZE)];
+
+static size_t make_frame(uint8_t *out, uint8_t type, uint16_t length, uint8_t seed)
+{
+    uint8_t payload[CORE_LINK_MAX_PAYLOAD];
+    for (uint16_t i = 0; i < length; ++i) {
+        payload[i] = (uint8_t)(seed + i * 7U);
+    }
+    return core_link_frame_encode(out, CORE_LINK_FRAME_MAX_SIZE, type, payload, length);
+}
+
+static void test_single_frame(void)
+{
+    core_link_stream_t stream;
+    HOST_TEST_ASSERT(core_link_stream_init(&stream, s_storage, sizeof(s_storage)));
+
+    uint8_t frame[CORE_LINK_FRAME_MAX_SIZE];
+    size_t len = make_frame(frame, 0x10, 64, 3);
+    HOST_TEST_ASSERT_EQ(len, core_link_stream_push(&stream, frame, len));
+
+    core_link_stream_frame_t out;
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(0x10, out.type);
+    HOST_TEST_ASSERT_EQ(64, out.length);
+    HOST_TEST_ASSERT(memcmp(out.payload, frame + CORE_LINK_FRAME_HEADER_SIZE, 64) == 0);
+    HOST_TEST_ASSERT(!core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(0, core_link_stream_buffered(&stream));
+}
+
+static void test_byte_by_byte(void)
+{
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, s_storage, sizeof(s_storage));
+
+    uint8_t frame[CORE_LINK_FRAME_MAX_SIZE];
+    size_t len = make_frame(frame, 0x11, 200, 9);
+    core_link_stream_frame_t out;
+    for (size_t i = 0; i < len; ++i) {
+        HOST_TEST_ASSERT(!core_link_stream_next(&stream, &out));
+        core_link_stream_push(&stream, &frame[i], 1);
+    }
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(200, out.length);
+}
+
+static void test_frames_across_wrap(void)
+{
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, s_storage, sizeof(s_storage));
+
+    static uint8_t bytes[40 * CORE_LINK_FRAME_MAX_SIZE];
+    size_t offsets[40];
+    size_t total = 0;
+    for (unsigned n = 0; n < 40; ++n) {
+        offsets[n] = total;
+        uint16_t length = (uint16_t)(100 + (n * 37U) % 400U);
+        total += make_frame(bytes + total, (uint8_t)n, length, (uint8_t)n);
+    }
+
+    unsigned received = 0;
+    for (size_t pos = 0; pos < total; pos += 333) {
+        size_t chunk = total - pos < 333 ? total - pos : 333;
+        HOST_TEST_ASSERT_EQ(chunk, core_link_stream_push(&stream, bytes + pos, chunk));
+        core_link_stream_frame_t out;
+        while (core_link_stream_next(&stream, &out)) {
+            HOST_TEST_ASSERT_EQ(received, out.type);
+            HOST_TEST_ASSERT(memcmp(out.payload, bytes + offsets[received] + CORE_LINK_FRAME_HEADER_SIZE, out.length) == 0);
+            received++;
+        }
+    }
+    HOST_TEST_ASSERT_EQ(40, received);
+    HOST_TEST_ASSERT(stream.stats.wrapped_frames > 0);
+    HOST_TEST_ASSERT_EQ(0, stream.stats.checksum_errors);
+}
+
+static void test_garbage_and_corruption_keep_following_frames(void)
+{
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, s_storage, sizeof(s_storage));
+
+    uint8_t bytes[3 * CORE_LINK_FRAME_MAX_SIZE];
+    size_t len = 0;
+    const uint8_t garbage[] = {0x00, 0x13, CORE_LINK_SOF, 0xFF};
+    memcpy(bytes, garbage, sizeof(garbage));
+    len += sizeof(garbage);
+
+    size_t corrupt_at = len;
+    len += make_frame(bytes + len, 0x20, 40, 1);
+    bytes[corrupt_at + CORE_LINK_FRAME_HEADER_SIZE + 5] ^= 0x40;
+
+    len += make_frame(bytes + len, 0x21, 12, 2);
+    len += make_frame(bytes + len, 0x22, 0, 0);
+    core_link_stream_push(&stream, bytes, len);
+
+    core_link_stream_frame_t out;
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(0x21, out.type);
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(0x22, out.type);
+    HOST_TEST_ASSERT_EQ(0, out.length);
+    HOST_TEST_ASSERT(!core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT(stream.stats.checksum_errors >= 1);
+}
+
+static void test_truncated_frame_recovers_after_skip(void)
+{
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, s_storage, sizeof(s_storage));
+
+    uint8_t frame[CORE_LINK_FRAME_MAX_SIZE];
+    size_t len = make_frame(frame, 0x30, 300, 4);
+    core_link_stream_push(&stream, frame, 20);
+
+    core_link_stream_frame_t out;
+    HOST_TEST_ASSERT(!core_link_stream_next(&stream, &out));
+    core_link_stream_skip_partial(&stream);
+
+    len = make_frame(frame, 0x31, 8, 5);
+    core_link_stream_push(&stream, frame, len);
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(0x31, out.type);
+}
+
+static void test_oversize_length_is_skipped(void)
+{
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, s_storage, sizeof(s_storage));
+
+    const uint8_t bogus[] = {CORE_LINK_SOF, 0x10, 0xFF, 0x7F};
+    core_link_stream_push(&stream, bogus, sizeof(bogus));
+    uint8_t frame[CORE_LINK_FRAME_MAX_SIZE];
+    size_t len = make_frame(frame, 0x1F, 4, 6);
+    core_link_stream_push(&stream, frame, len);
+
+    core_link_stream_frame_t out;
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(0x1F, out.type);
+    HOST_TEST_ASSERT_EQ(1, stream.stats.oversize_errors);
+}
+
+static void test_v2_frame_round_trip(void)
+{
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, s_storage, sizeof(s_storage));
+
+    uint8_t payload[CORE_LINK_MAX_PAYLOAD];
+    for (unsigned i = 0; i < sizeof(payload); ++i) {
+        payload[i] = (uint8_t)(i * 13U);
+    }
+    uint8_t frame[CORE_LINK_FRAME_MAX_SIZE];
+    size_t len = core_link_frame_encode_v2(frame, sizeof(frame), 0x11, 0xBEEF, payload, CORE_LINK_MAX_PAYLOAD);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_FRAME_MAX_SIZE, len);
+    uint16_t crc = core_link_frame_crc16(0x11, CORE_LINK_MAX_PAYLOAD, 0xBEEF, payload);
+    HOST_TEST_ASSERT_EQ(crc, frame[len - 2] | (frame[len - 1] << 8));
+
+    core_link_stream_push(&stream, frame, len);
+    core_link_stream_frame_t out;
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(2, out.version);
+    HOST_TEST_ASSERT_EQ(0x11, out.type);
+    HOST_TEST_ASSERT_EQ(0xBEEF, out.seq);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_MAX_PAYLOAD, out.length);
+    HOST_TEST_ASSERT(memcmp(out.payload, payload, CORE_LINK_MAX_PAYLOAD) == 0);
+}
+
+static void test_crc16_check_value(void)
+{
+    const uint8_t check[] = "123456789";
+    HOST_TEST_ASSERT_EQ(0x29B1, core_link_crc16_update(0xFFFF, check, 9));
+}
+
+static void test_v2_corruption_and_mixed_versions(void)
+{
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, s_storage, sizeof(s_storage));
+
+    uint8_t payload[64];
+    memset(payload, 0x5C, sizeof(payload));
+    uint8_t bytes[4 * CORE_LINK_FRAME_MAX_SIZE];
+    size_t len = 0;
+    len += make_frame(bytes + len, 0x1F, 4, 1);
+    size_t corrupt_at = len;
+    len += core_link_frame_encode_v2(bytes + len, sizeof(bytes) - len, 0x10, 7, payload, sizeof(payload));
+    // A flipped sequence byte must be caught: the CRC covers the whole header.
+    bytes[corrupt_at + 4] ^= 0x01;
+    len += core_link_frame_encode_v2(bytes + len, sizeof(bytes) - len, 0x11, 8, payload, 10);
+    len += make_frame(bytes + len, 0x20, 4, 2);
+    core_link_stream_push(&stream, bytes, len);
+
+    core_link_stream_frame_t out;
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(1, out.version);
+    HOST_TEST_ASSERT_EQ(0, out.seq);
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(2, out.version);
+    HOST_TEST_ASSERT_EQ(8, out.seq);
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT_EQ(0x20, out.type);
+    HOST_TEST_ASSERT(!core_link_stream_next(&stream, &out));
+    HOST_TEST_ASSERT(stream.stats.checksum_errors >= 1);
+}
+
+static void test_seq_arithmetic_skips_zero(void)
+{
+    HOST_TEST_ASSERT_EQ(1, core_link_seq_next(0xFFFF));
+    HOST_TEST_ASSERT_EQ(1, core_link_seq_diff(1, 0xFFFF));
+    HOST_TEST_ASSERT_EQ(-3, core_link_seq_diff(0xFFFE, 2));
+    HOST_TEST_ASSERT_EQ(5, core_link_seq_diff(105, 100));
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_single_frame);
+    HOST_TEST_RUN(test_byte_by_byte);
+    HOST_TEST_RUN(test_frames_across_wrap);
+    HOST_TEST_RUN(test_garbage_and_corruption_keep_following_frames);
+    HOST_TEST_RUN(test_truncated_frame_recovers_after_skip);
+    HOST_TEST_RUN(test_oversize_length_is_skipped);
+    HOST_TEST_RUN(test_v2_frame_round_trip);
+    HOST_TEST_RUN(test_crc16_check_value);
+    HOST_TEST_RUN(test_v2_corruption_and_mixed_versions);
+    HOST_TEST_RUN(test_seq_arithmetic_skips_zero);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,133 @@
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_compact.h"
+#include "link/core_link_subscription.h"
+
+static void make_snapshot(core_link_terrarium_snapshot_t *snap, uint8_t id, float temp)
+{
+    memset(snap, 0, sizeof(*snap));
+    snap->terrarium_id = id;
+    strncpy(snap->scientific_name, "Python regius", CORE_LINK_NAME_MAX_LEN);
+    strncpy(snap->common_name, "Python royal", CORE_LINK_NAME_MAX_LEN);
+    snap->name_ids[0] = 1;
+    snap->name_ids[1] = 2;
+    snap->temp_day_c = temp;
+    snap->humidity_day_pct = 60.0f;
+    snap->hydration_pct = 80.0f;
+    snap->stress_pct = 10.0f;
+    snap->health_pct = 95.0f;
+}
+
+static void test_encode_decode_roundtrip(void)
+{
+    core_link_subscription_t sub;
+    core_link_subscription_none(&sub, CORE_LINK_DELTA_FIELD_TEMP_DAY | CORE_LINK_DELTA_FIELD_STRESS, 1000);
+    core_link_subscription_add_terrarium(&sub, 3);
+    core_link_subscription_add_terrarium(&sub, 0);
+    core_link_subscription_add_terrarium(&sub, 200);
+
+    uint8_t payload[CORE_LINK_SUBSCRIBE_HEADER_SIZE + CORE_LINK_MAX_TERRARIUMS];
+    size_t length = core_link_subscription_encode(&sub, payload, sizeof(payload));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_SUBSCRIBE_HEADER_SIZE + 3U, length);
+    HOST_TEST_ASSERT_EQ(3, payload[4]);
+    HOST_TEST_ASSERT_EQ(0, payload[5]); // identifiers go out in ascending order
+    HOST_TEST_ASSERT_EQ(200, payload[7]);
+
+    core_link_subscription_t out;
+    core_link_subscription_all(&out);
+    HOST_TEST_ASSERT(core_link_subscription_decode(payload, length, &out));
+    HOST_TEST_ASSERT(!out.all_terrariums);
+    HOST_TEST_ASSERT_EQ(1000, out.min_interval_ms);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_FIELD_TEMP_DAY | CORE_LINK_DELTA_FIELD_STRESS, core_link_subscription_mask(&out, 3));
+    HOST_TEST_ASSERT_EQ(0, core_link_subscription_mask(&out, 4));
+    HOST_TEST_ASSERT(core_link_subscription_mask(&out, 200) != 0);
+
+    core_link_subscription_all(&sub);
+    length = core_link_subscription_encode(&sub, payload, sizeof(payload));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_SUBSCRIBE_HEADER_SIZE, length);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_SUBSCRIBE_ALL, payload[4]);
+    HOST_TEST_ASSERT(core_link_subscription_decode(payload, length, &out));
+    HOST_TEST_ASSERT(out.all_terrariums);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_FIELD_ALL, core_link_subscription_mask(&out, 250));
+}
+
+static void test_malformed_payload_is_rejected(void)
+{
+    core_link_subscription_t sub;
+    core_link_subscription_none(&sub, CORE_LINK_DELTA_FIELD_ALL, 0);
+    core_link_subscription_add_terrarium(&sub, 1);
+    core_link_subscription_add_terrarium(&sub, 2);
+    uint8_t payload[16];
+    size_t length = core_link_subscription_encode(&sub, payload, sizeof(payload));
+    HOST_TEST_ASSERT(length > 0);
+    // Too small for the identifier list.
+    HOST_TEST_ASSERT_EQ(0, core_link_subscription_encode(&sub, payload, CORE_LINK_SUBSCRIBE_HEADER_SIZE + 1U));
+
+    core_link_subscription_t out;
+    core_link_subscription_all(&out);
+    for (size_t cut = 0; cut < length; ++cut) {
+        HOST_TEST_ASSERT(!core_link_subscription_decode(payload, cut, &out));
+    }
+    HOST_TEST_ASSERT(out.all_terrariums); // untouched by the failed decodes
+}
+
+static void test_filter_freezes_unsubscribed_fields(void)
+{
+    core_link_subscription_t sub;
+    core_link_subscription_none(&sub, CORE_LINK_DELTA_FIELD_TEMP_DAY, 0);
+    core_link_subscription_add_terrarium(&sub, 1);
+
+    core_link_terrarium_snapshot_t sent;
+    make_snapshot(&sent, 1, 30.0f);
+    core_link_terrarium_snapshot_t next;
+    make_snapshot(&next, 1, 31.0f);
+    next.stress_pct = 55.0f;
+    strncpy(next.common_name, "Python boule", CORE_LINK_NAME_MAX_LEN);
+    next.name_ids[1] = 7;
+
+    core_link_subscription_filter(&sub, &next, &sent);
+    HOST_TEST_ASSERT(next.temp_day_c == 31.0f);
+    HOST_TEST_ASSERT(next.stress_pct == sent.stress_pct);
+    HOST_TEST_ASSERT(strcmp(next.common_name, sent.common_name) == 0);
+    HOST_TEST_ASSERT_EQ(sent.name_ids[1], next.name_ids[1]);
+    // Only the subscribed change reaches the delta.
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_FIELD_TEMP_DAY, core_link_compact_diff_mask(&next, &sent));
+
+    // An unsubscribed terrarium produces no delta entry at all.
+    core_link_terrarium_snapshot_t other_sent;
+    make_snapshot(&other_sent, 2, 25.0f);
+    core_link_terrarium_snapshot_t other;
+    make_snapshot(&other, 2, 28.0f);
+    other.health_pct = 50.0f;
+    core_link_subscription_filter(&sub, &other, &other_sent);
+    HOST_TEST_ASSERT_EQ(0, core_link_compact_diff_mask(&other, &other_sent));
+}
+
+static void test_widening_releases_pending_changes(void)
+{
+    core_link_subscription_t narrow;
+    core_link_subscription_none(&narrow, 0, 1000);
+    core_link_terrarium_snapshot_t sent;
+    make_snapshot(&sent, 0, 30.0f);
+    core_link_terrarium_snapshot_t next;
+    make_snapshot(&next, 0, 33.0f);
+    core_link_subscription_filter(&narrow, &next, &sent);
+    HOST_TEST_ASSERT_EQ(0, core_link_compact_diff_mask(&next, &sent));
+
+    // `sent` is still what the display holds: the next full-mask delta carries the change.
+    core_link_subscription_t all;
+    core_link_subscription_all(&all);
+    make_snapshot(&next, 0, 33.0f);
+    core_link_subscription_filter(&all, &next, &sent);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_FIELD_TEMP_DAY, core_link_compact_diff_mask(&next, &sent));
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_encode_decode_roundtrip);
+    HOST_TEST_RUN(test_malformed_payload_is_rejected);
+    HOST_TEST_RUN(test_filter_freezes_unsubscribed_fields);
+    HOST_TEST_RUN(test_widening_releases_pending_changes);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,152 @@
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_touch.h"
+
+static core_link_touch_slots_t s_slots;
+static core_link_touch_event_t s_out[CORE_LINK_TOUCH_BATCH_MAX];
+
+static bool sample(core_link_touch_type_t type, uint8_t id, uint16_t x, uint16_t y)
+{
+    core_link_touch_event_t event = {.type = type, .point_id = id, .x = x, .y = y};
+    return core_link_touch_slots_update(&s_slots, &event);
+}
+
+static size_t collect(void)
+{
+    return core_link_touch_slots_collect(&s_slots, s_out, CORE_LINK_TOUCH_BATCH_MAX);
+}
+
+static void assert_event(size_t index, core_link_touch_type_t type, uint8_t id, uint16_t x, uint16_t y)
+{
+    HOST_TEST_ASSERT_EQ(type, s_out[index].type);
+    HOST_TEST_ASSERT_EQ(id, s_out[index].point_id);
+    HOST_TEST_ASSERT_EQ(x, s_out[index].x);
+    HOST_TEST_ASSERT_EQ(y, s_out[index].y);
+}
+
+static void test_drag_is_coalesced(void)
+{
+    core_link_touch_slots_init(&s_slots);
+    HOST_TEST_ASSERT(sample(CORE_LINK_TOUCH_DOWN, 0, 10, 20));
+    HOST_TEST_ASSERT_EQ(1, collect());
+    assert_event(0, CORE_LINK_TOUCH_DOWN, 0, 10, 20);
+
+    // Several I2C samples between two passes: only the last position leaves.
+    for (uint16_t i = 1; i <= 10; ++i) {
+        HOST_TEST_ASSERT(sample(CORE_LINK_TOUCH_MOVE, 0, (uint16_t)(10 + i), 20));
+    }
+    HOST_TEST_ASSERT_EQ(1, collect());
+    assert_event(0, CORE_LINK_TOUCH_MOVE, 0, 20, 20);
+
+    // Same position again: nothing to wake up for, nothing to send.
+    HOST_TEST_ASSERT(!sample(CORE_LINK_TOUCH_MOVE, 0, 20, 20));
+    HOST_TEST_ASSERT_EQ(0, collect());
+}
+
+static void test_type_normalization(void)
+{
+    core_link_touch_slots_init(&s_slots);
+    HOST_TEST_ASSERT(!sample(CORE_LINK_TOUCH_UP, 1, 5, 5));
+    HOST_TEST_ASSERT(sample(CORE_LINK_TOUCH_MOVE, 1, 5, 5));
+    HOST_TEST_ASSERT_EQ(1, collect());
+    assert_event(0, CORE_LINK_TOUCH_DOWN, 1, 5, 5);
+
+    HOST_TEST_ASSERT(sample(CORE_LINK_TOUCH_DOWN, 1, 6, 5));
+    HOST_TEST_ASSERT_EQ(1, collect());
+    assert_event(0, CORE_LINK_TOUCH_MOVE, 1, 6, 5);
+}
+
+static void test_transitions_survive_coalescing(void)
+{
+    core_link_touch_slots_init(&s_slots);
+    // A full tap between two passes.
+    sample(CORE_LINK_TOUCH_DOWN, 2, 100, 100);
+    sample(CORE_LINK_TOUCH_MOVE, 2, 101, 100);
+    sample(CORE_LINK_TOUCH_UP, 2, 102, 100);
+    HOST_TEST_ASSERT_EQ(2, collect());
+    assert_event(0, CORE_LINK_TOUCH_DOWN, 2, 102, 100);
+    assert_event(1, CORE_LINK_TOUCH_UP, 2, 102, 100);
+
+    // Press, then release and press again before the next pass.
+    sample(CORE_LINK_TOUCH_DOWN, 2, 1, 1);
+    HOST_TEST_ASSERT_EQ(1, collect());
+    sample(CORE_LINK_TOUCH_UP, 2, 1, 1);
+    sample(CORE_LINK_TOUCH_DOWN, 2, 300, 400);
+    HOST_TEST_ASSERT_EQ(2, collect());
+    assert_event(0, CORE_LINK_TOUCH_UP, 2, 300, 400);
+    assert_event(1, CORE_LINK_TOUCH_DOWN, 2, 300, 400);
+
+    // Release, tap, release: the core ends up released.
+    sample(CORE_LINK_TOUCH_UP, 2, 300, 400);
+    sample(CORE_LINK_TOUCH_DOWN, 2, 7, 8);
+    sample(CORE_LINK_TOUCH_UP, 2, 7, 8);
+    HOST_TEST_ASSERT_EQ(3, collect());
+    assert_event(0, CORE_LINK_TOUCH_UP, 2, 7, 8);
+    assert_event(1, CORE_LINK_TOUCH_DOWN, 2, 7, 8);
+    assert_event(2, CORE_LINK_TOUCH_UP, 2, 7, 8);
+}
+
+static void test_multi_touch_batch(void)
+{
+    core_link_touch_slots_init(&s_slots);
+    for (uint8_t id = 0; id < CORE_LINK_TOUCH_MAX_POINTS; ++id) {
+        sample(CORE_LINK_TOUCH_DOWN, id, (uint16_t)(id * 100), 50);
+    }
+    HOST_TEST_ASSERT(!sample(CORE_LINK_TOUCH_DOWN, CORE_LINK_TOUCH_MAX_POINTS, 0, 0));
+    size_t count = collect();
+    HOST_TEST_ASSERT_EQ(CORE_LINK_TOUCH_MAX_POINTS, count);
+
+    uint8_t payload[CORE_LINK_TOUCH_BATCH_PAYLOAD_MAX];
+    size_t length = core_link_touch_batch_encode(s_out, count, payload, sizeof(payload));
+    HOST_TEST_ASSERT_EQ(1 + count * CORE_LINK_TOUCH_BATCH_ENTRY_SIZE, length);
+
+    core_link_touch_event_t decoded[CORE_LINK_TOUCH_BATCH_MAX];
+    HOST_TEST_ASSERT_EQ(count, core_link_touch_batch_decode(payload, length, decoded, CORE_LINK_TOUCH_BATCH_MAX));
+    for (size_t i = 0; i < count; ++i) {
+        HOST_TEST_ASSERT_EQ(CORE_LINK_TOUCH_DOWN, decoded[i].type);
+        HOST_TEST_ASSERT_EQ(i, decoded[i].point_id);
+        HOST_TEST_ASSERT_EQ(i * 100, decoded[i].x);
+        HOST_TEST_ASSERT_EQ(50, decoded[i].y);
+    }
+    HOST_TEST_ASSERT_EQ(0, core_link_touch_batch_decode(payload, length - 1, decoded, CORE_LINK_TOUCH_BATCH_MAX));
+    payload[2] = 7; /* type inconnu */
+    HOST_TEST_ASSERT_EQ(0, core_link_touch_batch_decode(payload, length, decoded, CORE_LINK_TOUCH_BATCH_MAX));
+}
+
+static void test_small_capacity_defers_points(void)
+{
+    core_link_touch_slots_init(&s_slots);
+    sample(CORE_LINK_TOUCH_DOWN, 0, 1, 1);
+    sample(CORE_LINK_TOUCH_DOWN, 3, 3, 3);
+    HOST_TEST_ASSERT_EQ(1, core_link_touch_slots_collect(&s_slots, s_out, 3));
+    assert_event(0, CORE_LINK_TOUCH_DOWN, 0, 1, 1);
+    HOST_TEST_ASSERT_EQ(1, collect());
+    assert_event(0, CORE_LINK_TOUCH_DOWN, 3, 3, 3);
+}
+
+static void test_reset_forgets_contacts(void)
+{
+    core_link_touch_slots_init(&s_slots);
+    sample(CORE_LINK_TOUCH_DOWN, 0, 1, 1);
+    HOST_TEST_ASSERT_EQ(1, collect());
+    sample(CORE_LINK_TOUCH_MOVE, 0, 2, 2);
+    core_link_touch_slots_reset(&s_slots);
+    HOST_TEST_ASSERT_EQ(0, collect());
+
+    // After a link loss the ongoing contact starts over with a DOWN.
+    sample(CORE_LINK_TOUCH_MOVE, 0, 3, 3);
+    HOST_TEST_ASSERT_EQ(1, collect());
+    assert_event(0, CORE_LINK_TOUCH_DOWN, 0, 3, 3);
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_drag_is_coalesced);
+    HOST_TEST_RUN(test_type_normalization);
+    HOST_TEST_RUN(test_transitions_survive_coalescing);
+    HOST_TEST_RUN(test_multi_touch_batch);
+    HOST_TEST_RUN(test_small_capacity_defers_points);
+    HOST_TEST_RUN(test_reset_forgets_contacts);
+    return HOST_TEST_EXIT();
+}
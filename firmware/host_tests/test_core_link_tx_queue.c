@@ -0,0 +1,121 @@
+#include <string.h>
+
+#include "host_test.h"
+#include "link/core_link_stream.h"
+#include "link/core_link_tx_queue.h"
+
+#define SLOTS 8
+
+static core_link_tx_slot_t s_slots[SLOTS];
+
+static core_link_tx_slot_t *queue_frame(core_link_tx_queue_t *queue, core_link_msg_type_t type, uint16_t seq,
+                                        int64_t now_us)
+{
+    core_link_tx_slot_t *slot = core_link_tx_queue_acquire(queue);
+    if (!slot) {
+        return NULL;
+    }
+    uint8_t payload[2] = {(uint8_t)seq, (uint8_t)(seq >> 8)};
+    slot->length = (uint16_t)core_link_frame_encode_v2(slot->data, sizeof(slot->data), (uint8_t)type, seq, payload,
+                                                        sizeof(payload));
+    core_link_tx_queue_push(queue, slot, core_link_tx_priority_for(type), now_us);
+    return slot;
+}
+
+static void test_priority_classes(void)
+{
+    HOST_TEST_ASSERT_EQ(CORE_LINK_TX_PRIO_URGENT, core_link_tx_priority_for(CORE_LINK_MSG_TOUCH_EVENT));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_TX_PRIO_URGENT, core_link_tx_priority_for(CORE_LINK_MSG_NAK));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_TX_PRIO_URGENT, core_link_tx_priority_for(CORE_LINK_MSG_COMMAND_ACK));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_TX_PRIO_PING, core_link_tx_priority_for(CORE_LINK_MSG_PONG));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_TX_PRIO_STATE, core_link_tx_priority_for(CORE_LINK_MSG_STATE_FRAGMENT));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_TX_PRIO_STATE, core_link_tx_priority_for(CORE_LINK_MSG_NAME_TABLE));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_TX_PRIO_BULK, core_link_tx_priority_for(CORE_LINK_MSG_COMMAND));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_TX_PRIO_BULK, core_link_tx_priority_for(CORE_LINK_MSG_LINK_STATS));
+}
+
+static void test_pop_order(void)
+{
+    core_link_tx_queue_t queue;
+    core_link_tx_queue_init(&queue, s_slots, SLOTS);
+
+    HOST_TEST_ASSERT(queue_frame(&queue, CORE_LINK_MSG_COMMAND, 1, 0));
+    HOST_TEST_ASSERT(queue_frame(&queue, CORE_LINK_MSG_STATE_DELTA_COMPACT, 2, 0));
+    HOST_TEST_ASSERT(queue_frame(&queue, CORE_LINK_MSG_STATE_FRAGMENT, 3, 0));
+    HOST_TEST_ASSERT(queue_frame(&queue, CORE_LINK_MSG_PING, 4, 0));
+    HOST_TEST_ASSERT(queue_frame(&queue, CORE_LINK_MSG_TOUCH_EVENT, 5, 0));
+    HOST_TEST_ASSERT(queue_frame(&queue, CORE_LINK_MSG_STATE_FRAGMENT, 6, 0));
+
+    // Class first, then arrival order: state frames keep their sequence order.
+    static const uint16_t expected[] = {5, 4, 2, 3, 6, 1};
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i) {
+        core_link_tx_slot_t *slot = core_link_tx_queue_pop(&queue);
+        HOST_TEST_ASSERT(slot);
+        HOST_TEST_ASSERT_EQ(expected[i], slot->data[4] | (slot->data[5] << 8));
+        core_link_tx_queue_complete(&queue, slot, 0);
+    }
+    HOST_TEST_ASSERT(core_link_tx_queue_pop(&queue) == NULL);
+}
+
+static void test_frames_are_contiguous(void)
+{
+    core_link_tx_queue_t queue;
+    core_link_tx_queue_init(&queue, s_slots, SLOTS);
+    HOST_TEST_ASSERT(queue_frame(&queue, CORE_LINK_MSG_STATE_DELTA_COMPACT, 42, 0));
+
+    core_link_tx_slot_t *slot = core_link_tx_queue_pop(&queue);
+    HOST_TEST_ASSERT(slot);
+    static uint8_t storage[CORE_LINK_STREAM_STORAGE_SIZE(CORE_LINK_FRAME_MAX_SIZE)];
+    core_link_stream_t stream;
+    HOST_TEST_ASSERT(core_link_stream_init(&stream, storage, sizeof(storage)));
+    // A single write of the slot carries header, payload and CRC.
+    HOST_TEST_ASSERT_EQ(slot->length, core_link_stream_push(&stream, slot->data, slot->length));
+    core_link_stream_frame_t frame;
+    HOST_TEST_ASSERT(core_link_stream_next(&stream, &frame));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_MSG_STATE_DELTA_COMPACT, frame.type);
+    HOST_TEST_ASSERT_EQ(42, frame.seq);
+    core_link_tx_queue_complete(&queue, slot, 0);
+}
+
+static void test_capacity_and_metrics(void)
+{
+    core_link_tx_queue_t queue;
+    core_link_tx_queue_init(&queue, s_slots, SLOTS);
+    for (uint16_t i = 0; i < SLOTS; ++i) {
+        HOST_TEST_ASSERT(queue_frame(&queue, CORE_LINK_MSG_STATE_FRAGMENT, (uint16_t)(i + 1), 1000));
+    }
+    HOST_TEST_ASSERT(core_link_tx_queue_acquire(&queue) == NULL);
+    core_link_tx_queue_note_drop(&queue, CORE_LINK_TX_PRIO_STATE);
+    HOST_TEST_ASSERT_EQ(SLOTS, queue.stats.depth);
+    HOST_TEST_ASSERT_EQ(SLOTS, queue.stats.classes[CORE_LINK_TX_PRIO_STATE].max_depth);
+
+    // Latency covers the whole wait: the last frame leaves after the others.
+    for (int64_t n = 1; n <= SLOTS; ++n) {
+        core_link_tx_slot_t *slot = core_link_tx_queue_pop(&queue);
+        HOST_TEST_ASSERT(slot);
+        core_link_tx_queue_complete(&queue, slot, 1000 + n * 250);
+    }
+    const core_link_tx_class_stats_t *state = &queue.stats.classes[CORE_LINK_TX_PRIO_STATE];
+    HOST_TEST_ASSERT_EQ(SLOTS, state->enqueued);
+    HOST_TEST_ASSERT_EQ(SLOTS, state->sent);
+    HOST_TEST_ASSERT_EQ(1, state->dropped);
+    HOST_TEST_ASSERT_EQ(0, state->depth);
+    HOST_TEST_ASSERT_EQ(SLOTS * 250, state->max_latency_us);
+    HOST_TEST_ASSERT_EQ(250 * SLOTS * (SLOTS + 1) / 2, state->total_latency_us);
+    HOST_TEST_ASSERT_EQ(0, queue.stats.depth);
+    HOST_TEST_ASSERT_EQ(SLOTS, queue.stats.max_depth);
+
+    core_link_tx_slot_t *slot = core_link_tx_queue_acquire(&queue);
+    HOST_TEST_ASSERT(slot);
+    core_link_tx_queue_abort(&queue, slot);
+    HOST_TEST_ASSERT_EQ(0, queue.stats.depth);
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_priority_classes);
+    HOST_TEST_RUN(test_pop_order);
+    HOST_TEST_RUN(test_frames_are_contiguous);
+    HOST_TEST_RUN(test_capacity_and_metrics);
+    return HOST_TEST_EXIT();
+}
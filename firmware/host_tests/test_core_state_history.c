@@ -0,0 +1,224 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "state/core_state_history.h"
+
+#define SLOTS 3U
+#define BASE_EPOCH (21600U * 100U) // aligned on every tier
+
+enum { TEMP_DAY = 0, HYDRATION = 6 };
+
+static const uint16_t k_depth[CORE_STATE_HISTORY_TIERS] = {8, 4, 2};
+
+static core_state_soa_t s_soa;
+static void *s_soa_storage;
+static core_state_history_t s_history;
+static void *s_history_storage;
+
+static void setup(void)
+{
+    memset(s_soa_storage, 0, core_state_soa_storage_size(SLOTS));
+    core_state_soa_init(&s_soa, s_soa_storage, SLOTS);
+    s_soa.count = SLOTS;
+    core_state_history_init(&s_history, s_history_storage, k_depth, SLOTS, NULL);
+}
+
+static void record(uint32_t epoch, float temp, float hydration)
+{
+    for (size_t slot = 0; slot < SLOTS; ++slot) {
+        s_soa.temp_day[slot] = temp + (float)slot;
+        s_soa.hydration[slot] = hydration;
+    }
+    core_state_history_record(&s_history, &s_soa, epoch);
+}
+
+static void test_minute_bucket_tracks_min_max_mean(void)
+{
+    setup();
+    record(BASE_EPOCH, 20.0f, 50.0f);
+    record(BASE_EPOCH + 10, 22.0f, 50.0f);
+    record(BASE_EPOCH + 20, 24.0f, 50.0f);
+
+    core_link_history_bucket_t bucket;
+    HOST_TEST_ASSERT(!core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_MINUTE, 0, &bucket));
+    record(BASE_EPOCH + 60, 30.0f, 50.0f);
+    HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 1, CORE_LINK_HISTORY_TIER_MINUTE, 0, &bucket));
+    HOST_TEST_ASSERT_EQ(3, bucket.samples);
+    HOST_TEST_ASSERT_EQ(2100, bucket.min[TEMP_DAY]);
+    HOST_TEST_ASSERT_EQ(2500, bucket.max[TEMP_DAY]);
+    HOST_TEST_ASSERT_EQ(2300, bucket.mean[TEMP_DAY]);
+    HOST_TEST_ASSERT_EQ(500, bucket.mean[HYDRATION]);
+    HOST_TEST_ASSERT(!core_state_history_bucket(&s_history, 1, CORE_LINK_HISTORY_TIER_MINUTE, 1, &bucket));
+}
+
+static void test_closed_minutes_fold_into_quarter(void)
+{
+    setup();
+    for (uint32_t minute = 0; minute < 15; ++minute) {
+        record(BASE_EPOCH + minute * 60U, 20.0f, (float)minute);
+        record(BASE_EPOCH + minute * 60U + 30U, 20.0f, (float)minute + 1.0f);
+    }
+    record(BASE_EPOCH + 900U, 20.0f, 0.0f);
+
+    core_link_history_bucket_t bucket;
+    HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_QUARTER, 0, &bucket));
+    HOST_TEST_ASSERT_EQ(30, bucket.samples);
+    HOST_TEST_ASSERT_EQ(0, bucket.min[HYDRATION]);
+    HOST_TEST_ASSERT_EQ(150, bucket.max[HYDRATION]);
+    HOST_TEST_ASSERT_EQ(75, bucket.mean[HYDRATION]); // every sample, not the mean of minute means
+    HOST_TEST_ASSERT(!core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_SIX_HOURS, 0, &bucket));
+}
+
+static void test_gap_leaves_empty_buckets(void)
+{
+    setup();
+    record(BASE_EPOCH, 20.0f, 50.0f);
+    record(BASE_EPOCH + 5U * 60U, 20.0f, 50.0f);
+
+    core_link_history_bucket_t bucket;
+    for (size_t index = 0; index < 4; ++index) {
+        HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_MINUTE, index, &bucket));
+        HOST_TEST_ASSERT_EQ(0, bucket.samples);
+    }
+    HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_MINUTE, 4, &bucket));
+    HOST_TEST_ASSERT_EQ(1, bucket.samples);
+
+    // A gap longer than the ring wipes it without looping over every minute.
+    record(BASE_EPOCH + 1000U * 60U, 20.0f, 50.0f);
+    for (size_t index = 0; index < k_depth[0]; ++index) {
+        HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_MINUTE, index, &bucket));
+        HOST_TEST_ASSERT_EQ(0, bucket.samples);
+    }
+}
+
+static void test_ring_keeps_the_newest_buckets(void)
+{
+    setup();
+    for (uint32_t minute = 0; minute <= 12; ++minute) {
+        record(BASE_EPOCH + minute * 60U, (float)minute, 50.0f);
+    }
+    core_link_history_bucket_t bucket;
+    HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_MINUTE, 0, &bucket));
+    HOST_TEST_ASSERT_EQ(1100, bucket.mean[TEMP_DAY]);
+    HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_MINUTE, 7, &bucket));
+    HOST_TEST_ASSERT_EQ(400, bucket.mean[TEMP_DAY]);
+    HOST_TEST_ASSERT(!core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_MINUTE, 8, &bucket));
+}
+
+static void test_chunks_page_backwards(void)
+{
+    setup();
+    for (uint32_t minute = 0; minute <= 6; ++minute) {
+        record(BASE_EPOCH + minute * 60U, (float)minute, 50.0f);
+    }
+    core_link_history_request_t request = {
+        .terrarium_id = 9,
+        .tier = CORE_LINK_HISTORY_TIER_MINUTE,
+        .field_mask = CORE_LINK_DELTA_FIELD_TEMP_DAY | CORE_LINK_DELTA_FIELD_LAST_FEED,
+        .max_buckets = 4,
+    };
+    uint8_t payload[512];
+    core_link_history_chunk_t chunk;
+    core_link_history_bucket_t bucket;
+
+    size_t length = core_state_history_encode_chunk(&s_history, 2, &request, payload, sizeof(payload));
+    HOST_TEST_ASSERT(core_link_history_chunk_decode(payload, length, &chunk));
+    HOST_TEST_ASSERT_EQ(9, chunk.terrarium_id);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_OK, chunk.status);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_DELTA_FIELD_TEMP_DAY, chunk.field_mask);
+    HOST_TEST_ASSERT_EQ(BASE_EPOCH + 6U * 60U, chunk.end_epoch);
+    HOST_TEST_ASSERT_EQ(4, chunk.count);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_FLAG_MORE, chunk.flags);
+    core_link_history_chunk_bucket(&chunk, 0, &bucket);
+    HOST_TEST_ASSERT_EQ(700, bucket.mean[TEMP_DAY]); // minute 5, slot 2
+
+    request.before_epoch = chunk.end_epoch - chunk.count * 60U;
+    length = core_state_history_encode_chunk(&s_history, 2, &request, payload, sizeof(payload));
+    HOST_TEST_ASSERT(core_link_history_chunk_decode(payload, length, &chunk));
+    HOST_TEST_ASSERT_EQ(BASE_EPOCH + 2U * 60U, chunk.end_epoch);
+    HOST_TEST_ASSERT_EQ(2, chunk.count);
+    HOST_TEST_ASSERT_EQ(0, chunk.flags);
+    core_link_history_chunk_bucket(&chunk, 1, &bucket);
+    HOST_TEST_ASSERT_EQ(200, bucket.mean[TEMP_DAY]); // minute 0
+
+    // The payload bounds the chunk as much as max_buckets does.
+    request.before_epoch = 0;
+    length = core_state_history_encode_chunk(&s_history, 2, &request, payload, CORE_LINK_HISTORY_CHUNK_HEADER_SIZE + 17);
+    HOST_TEST_ASSERT(core_link_history_chunk_decode(payload, length, &chunk));
+    HOST_TEST_ASSERT_EQ(2, chunk.count);
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_FLAG_MORE, chunk.flags);
+}
+
+static void test_statuses(void)
+{
+    setup();
+    record(BASE_EPOCH, 20.0f, 50.0f);
+    core_link_history_request_t request = {.terrarium_id = 4, .field_mask = CORE_LINK_HISTORY_FIELDS, .max_buckets = 8};
+    uint8_t payload[64];
+    core_link_history_chunk_t chunk;
+
+    size_t length = core_state_history_encode_chunk(&s_history, SIZE_MAX, &request, payload, sizeof(payload));
+    HOST_TEST_ASSERT(core_link_history_chunk_decode(payload, length, &chunk));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_UNKNOWN_TERRARIUM, chunk.status);
+    HOST_TEST_ASSERT_EQ(0, chunk.count);
+
+    request.tier = CORE_LINK_HISTORY_TIER_COUNT;
+    length = core_state_history_encode_chunk(&s_history, 0, &request, payload, sizeof(payload));
+    HOST_TEST_ASSERT(core_link_history_chunk_decode(payload, length, &chunk));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_UNAVAILABLE, chunk.status);
+
+    core_state_history_t disabled;
+    core_state_history_init(&disabled, NULL, k_depth, 0, NULL);
+    core_state_history_record(&disabled, &s_soa, BASE_EPOCH);
+    request.tier = CORE_LINK_HISTORY_TIER_MINUTE;
+    length = core_state_history_encode_chunk(&disabled, 0, &request, payload, sizeof(payload));
+    HOST_TEST_ASSERT(core_link_history_chunk_decode(payload, length, &chunk));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_HISTORY_UNAVAILABLE, chunk.status);
+
+    HOST_TEST_ASSERT_EQ(0, core_state_history_encode_chunk(&s_history, 0, &request, payload, 10));
+}
+
+static void test_moved_slot_keeps_its_history(void)
+{
+    setup();
+    record(BASE_EPOCH, 20.0f, 50.0f);
+    record(BASE_EPOCH + 60U, 20.0f, 50.0f);
+
+    // Reload: slot 2 becomes slot 0 of a two-slot pool.
+    void *storage = malloc(core_state_history_storage_size(k_depth, 2));
+    core_state_history_t next;
+    core_state_history_init(&next, storage, k_depth, 2, &s_history);
+    core_state_history_move_slot(&next, 0, &s_history, 2);
+    s_history = next;
+    s_soa.count = 2;
+    record(BASE_EPOCH + 90U, 30.0f, 50.0f);
+    record(BASE_EPOCH + 120U, 30.0f, 50.0f);
+
+    core_link_history_bucket_t bucket;
+    HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_MINUTE, 1, &bucket));
+    HOST_TEST_ASSERT_EQ(2200, bucket.mean[TEMP_DAY]);
+    HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 0, CORE_LINK_HISTORY_TIER_MINUTE, 0, &bucket));
+    HOST_TEST_ASSERT_EQ(2600, bucket.mean[TEMP_DAY]); // 22 before the reload, 30 after
+    HOST_TEST_ASSERT(core_state_history_bucket(&s_history, 1, CORE_LINK_HISTORY_TIER_MINUTE, 0, &bucket));
+    HOST_TEST_ASSERT_EQ(1, bucket.samples); // new slot: only what followed the reload
+    HOST_TEST_ASSERT_EQ(3100, bucket.mean[TEMP_DAY]);
+    free(storage);
+}
+
+int main(void)
+{
+    s_soa_storage = aligned_alloc(16, core_state_soa_storage_size(SLOTS));
+    s_history_storage = malloc(core_state_history_storage_size(k_depth, SLOTS));
+    HOST_TEST_RUN(test_minute_bucket_tracks_min_max_mean);
+    HOST_TEST_RUN(test_closed_minutes_fold_into_quarter);
+    HOST_TEST_RUN(test_gap_leaves_empty_buckets);
+    HOST_TEST_RUN(test_ring_keeps_the_newest_buckets);
+    HOST_TEST_RUN(test_chunks_page_backwards);
+    HOST_TEST_RUN(test_statuses);
+    HOST_TEST_RUN(test_moved_slot_keeps_its_history);
+    free(s_history_storage);
+    free(s_soa_storage);
+    return HOST_TEST_EXIT();
+}
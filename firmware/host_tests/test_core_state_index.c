@@ -0,0 +1,77 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "state/core_state_index.h"
+
+#define CAPACITY 300U
+
+static core_state_soa_t s_soa;
+static void *s_storage;
+static core_state_index_t s_index;
+
+static void setup(const uint8_t *ids, size_t count)
+{
+    memset(s_storage, 0, core_state_soa_storage_size(CAPACITY));
+    core_state_soa_init(&s_soa, s_storage, CAPACITY);
+    for (size_t i = 0; i < count; ++i) {
+        s_soa.info[i].id = ids[i];
+    }
+    s_soa.count = count;
+}
+
+static void test_empty_pool_finds_nothing(void)
+{
+    setup(NULL, 0);
+    HOST_TEST_ASSERT_EQ(0, core_state_index_build(&s_index, &s_soa));
+    for (unsigned id = 0; id < 256U; ++id) {
+        HOST_TEST_ASSERT_EQ(CORE_STATE_INDEX_NONE, core_state_index_find(&s_index, (uint8_t)id));
+    }
+}
+
+static void test_sparse_ids_map_to_their_slots(void)
+{
+    static const uint8_t ids[] = {12, 0, 255, 7, 128};
+    setup(ids, sizeof(ids));
+    HOST_TEST_ASSERT_EQ(0, core_state_index_build(&s_index, &s_soa));
+    for (size_t i = 0; i < sizeof(ids); ++i) {
+        HOST_TEST_ASSERT_EQ(i, core_state_index_find(&s_index, ids[i]));
+    }
+    HOST_TEST_ASSERT_EQ(CORE_STATE_INDEX_NONE, core_state_index_find(&s_index, 1));
+    HOST_TEST_ASSERT_EQ(CORE_STATE_INDEX_NONE, core_state_index_find(&s_index, 254));
+}
+
+static void test_first_duplicate_wins(void)
+{
+    static const uint8_t ids[] = {3, 4, 3, 3};
+    setup(ids, sizeof(ids));
+    HOST_TEST_ASSERT_EQ(2, core_state_index_build(&s_index, &s_soa));
+    HOST_TEST_ASSERT_EQ(0, core_state_index_find(&s_index, 3));
+    HOST_TEST_ASSERT_EQ(1, core_state_index_find(&s_index, 4));
+}
+
+static void test_full_id_space_beyond_256_slots(void)
+{
+    uint8_t ids[CAPACITY];
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        ids[i] = (uint8_t)(255U - i % 256U);
+    }
+    setup(ids, CAPACITY);
+    // Slots 256 and above repeat an id: they stay reachable by index only.
+    HOST_TEST_ASSERT_EQ(CAPACITY - 256U, core_state_index_build(&s_index, &s_soa));
+    for (size_t i = 0; i < 256U; ++i) {
+        HOST_TEST_ASSERT_EQ(i, core_state_index_find(&s_index, ids[i]));
+    }
+}
+
+int main(void)
+{
+    s_storage = aligned_alloc(16, core_state_soa_storage_size(CAPACITY));
+    HOST_TEST_RUN(test_empty_pool_finds_nothing);
+    HOST_TEST_RUN(test_sparse_ids_map_to_their_slots);
+    HOST_TEST_RUN(test_first_duplicate_wins);
+    HOST_TEST_RUN(test_full_id_space_beyond_256_slots);
+    free(s_storage);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,199 @@
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "core_state_reference.h"
+#include "host_test.h"
+#include "state/core_state_kernel.h"
+
+#define SLOT_COUNT 203U /* not a multiple of the vector width */
+#define BASE_EPOCH 1700000000U
+
+static core_state_slot_t s_reference[SLOT_COUNT];
+static core_state_soa_t s_soa;
+static void *s_storage;
+
+static void make_slot(core_state_slot_t *slot, size_t idx)
+{
+    memset(slot, 0, sizeof(*slot));
+    slot->id = (uint8_t)idx;
+    snprintf(slot->scientific_name, sizeof(slot->scientific_name), "Species %zu", idx);
+    snprintf(slot->common_name, sizeof(slot->common_name), "Terrarium %zu", idx);
+    float f = (float)(idx % 17U);
+    slot->base_temp_day = 26.0f + f * 0.5f;
+    slot->base_temp_night = 20.0f + f * 0.3f;
+    slot->base_humidity_day = 30.0f + f * 4.0f; /* reaches both humidity clamps */
+    slot->base_humidity_night = 45.0f + f * 3.0f;
+    slot->base_lux_day = 40.0f + f * 60.0f;     /* reaches both lux clamps */
+    slot->base_lux_night = f;
+    slot->current_temp_day = slot->base_temp_day;
+    slot->current_temp_night = slot->base_temp_night;
+    slot->current_humidity_day = slot->base_humidity_day;
+    slot->current_humidity_night = slot->base_humidity_night;
+    slot->current_lux_day = slot->base_lux_day;
+    slot->current_lux_night = slot->base_lux_night;
+    slot->hydration_pct = 60.0f + (float)(idx % 40U);
+    slot->stress_pct = (float)(idx % 70U);
+    slot->health_pct = 70.0f + (float)(idx % 30U);
+    slot->activity_score = 0.5f;
+    slot->target_hydration_pct = slot->hydration_pct;
+    slot->target_stress_pct = slot->stress_pct;
+    slot->target_health_pct = slot->health_pct;
+    slot->feeding_interval_hours = 0.05f + 0.01f * (float)(idx % 9U); /* several meals per run */
+    slot->feeding_intake_pct = 40.0f + (float)(idx % 60U);
+    slot->cycle_speed = 0.02f + 0.001f * (float)(idx % 31U);
+    slot->phase_offset = 0.1f * (float)(idx % 63U);
+    slot->enrichment_factor = 0.4f + 0.05f * (float)(idx % 23U);
+    slot->last_feeding_timestamp = BASE_EPOCH - (uint32_t)(idx * 7U);
+}
+
+static void setup(size_t count)
+{
+    free(s_storage);
+    size_t size = core_state_soa_storage_size(SLOT_COUNT);
+    s_storage = aligned_alloc(16, (size + 15U) & ~(size_t)15U);
+    memset(s_storage, 0, size);
+    core_state_soa_init(&s_soa, s_storage, SLOT_COUNT);
+    for (size_t i = 0; i < count; ++i) {
+        make_slot(&s_reference[i], i);
+        core_state_soa_store(&s_soa, i, &s_reference[i]);
+    }
+    s_soa.count = count;
+}
+
+static void assert_close(float expected, float actual, float tolerance)
+{
+    if (fabsf(expected - actual) > tolerance) {
+        fprintf(stderr, "expected %.6f, got %.6f\n", (double)expected, (double)actual);
+    }
+    HOST_TEST_ASSERT(fabsf(expected - actual) <= tolerance);
+}
+
+static void test_layout(void)
+{
+    setup(SLOT_COUNT);
+    const float *arrays[] = {s_soa.cycle_speed, s_soa.base_lux_night, s_soa.feeding_recovery, s_soa.activity};
+    for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); ++i) {
+        HOST_TEST_ASSERT_EQ(0, (uintptr_t)arrays[i] % 16U);
+    }
+    HOST_TEST_ASSERT_EQ(0, (uintptr_t)s_soa.last_feeding % 16U);
+    HOST_TEST_ASSERT((const uint8_t *)(s_soa.last_feeding + SLOT_COUNT) <=
+                     (const uint8_t *)s_storage + core_state_soa_storage_size(SLOT_COUNT));
+    HOST_TEST_ASSERT((const uint8_t *)(s_soa.info + SLOT_COUNT) <= (const uint8_t *)s_soa.cycle_speed);
+}
+
+static void test_store_load_roundtrip(void)
+{
+    setup(SLOT_COUNT);
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        core_state_slot_t loaded;
+        core_state_soa_load(&s_soa, i, &loaded);
+        HOST_TEST_ASSERT(memcmp(&loaded, &s_reference[i], sizeof(loaded)) == 0);
+    }
+}
+
+static void test_matches_reference(void)
+{
+    setup(SLOT_COUNT);
+    const float delta = 0.5f;
+    // The kernel rotates its phasors before reading them: start one step early.
+    core_state_soa_anchor(&s_soa, 0, SLOT_COUNT, 1000.0 - delta);
+    for (unsigned step = 0; step < 4000; ++step) {
+        float time_s = 1000.0f + delta * (float)step;
+        uint32_t now = BASE_EPOCH + step / 2U;
+        core_state_reference_update(s_reference, SLOT_COUNT, time_s, delta, now);
+        core_state_step_t kernel_step = {.advance_s = delta, .delta_seconds = delta, .now_epoch = now};
+        core_state_kernel_update(&s_soa, 0, SLOT_COUNT, &kernel_step);
+        if (step % 32U == 31U) {
+            core_state_kernel_renormalize(&s_soa, 0, SLOT_COUNT);
+        }
+    }
+
+    // The reference itself rounds a float absolute time: ~1e-5 rad at t = 3000 s,
+    // scaled by wave amplitudes of up to 80 (lux).
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        const core_state_slot_t *ref = &s_reference[i];
+        assert_close(ref->current_temp_day, s_soa.temp_day[i], 1e-3f);
+        assert_close(ref->current_temp_night, s_soa.temp_night[i], 1e-3f);
+        assert_close(ref->current_humidity_day, s_soa.humidity_day[i], 1e-3f);
+        assert_close(ref->current_humidity_night, s_soa.humidity_night[i], 1e-3f);
+        assert_close(ref->current_lux_day, s_soa.lux_day[i], 2e-2f);
+        assert_close(ref->current_lux_night, s_soa.lux_night[i], 1e-3f);
+        assert_close(ref->hydration_pct, s_soa.hydration[i], 1e-3f);
+        assert_close(ref->stress_pct, s_soa.stress[i], 2e-3f);
+        assert_close(ref->health_pct, s_soa.health[i], 1e-3f);
+        assert_close(ref->activity_score, s_soa.activity[i], 1e-4f);
+        HOST_TEST_ASSERT_EQ(ref->last_feeding_timestamp, s_soa.last_feeding[i]);
+    }
+}
+
+static void test_outputs_stay_clamped(void)
+{
+    setup(SLOT_COUNT);
+    for (unsigned step = 0; step < 500; ++step) {
+        core_state_step_t kernel_step = {.advance_s = 1.0f, .delta_seconds = 2.0f,
+                                         .now_epoch = BASE_EPOCH + step * 60U};
+        core_state_kernel_update(&s_soa, 0, SLOT_COUNT, &kernel_step);
+        core_state_kernel_renormalize(&s_soa, 0, SLOT_COUNT);
+        for (size_t i = 0; i < SLOT_COUNT; ++i) {
+            HOST_TEST_ASSERT(s_soa.humidity_day[i] >= 30.0f && s_soa.humidity_day[i] <= 95.0f);
+            HOST_TEST_ASSERT(s_soa.humidity_night[i] >= 40.0f && s_soa.humidity_night[i] <= 98.0f);
+            HOST_TEST_ASSERT(s_soa.lux_day[i] >= 50.0f && s_soa.lux_day[i] <= 900.0f);
+            HOST_TEST_ASSERT(s_soa.lux_night[i] >= 0.0f && s_soa.lux_night[i] <= 20.0f);
+            HOST_TEST_ASSERT(s_soa.hydration[i] >= 0.0f && s_soa.hydration[i] <= 100.0f);
+            HOST_TEST_ASSERT(s_soa.stress[i] >= 0.0f && s_soa.stress[i] <= 100.0f);
+            HOST_TEST_ASSERT(s_soa.health[i] >= 0.0f && s_soa.health[i] <= 100.0f);
+            HOST_TEST_ASSERT(s_soa.activity[i] >= 0.0f && s_soa.activity[i] <= 1.0f);
+        }
+    }
+}
+
+static void test_feeding_event(void)
+{
+    setup(1);
+    // Interval of 0.05 h = 180 s: one second short of due, then due.
+    s_soa.last_feeding[0] = BASE_EPOCH;
+    core_state_step_t step = {.advance_s = 0.5f, .delta_seconds = 0.5f, .now_epoch = BASE_EPOCH + 179U};
+    core_state_kernel_update(&s_soa, 0, 1, &step);
+    HOST_TEST_ASSERT_EQ(BASE_EPOCH, s_soa.last_feeding[0]);
+
+    step.now_epoch = BASE_EPOCH + 180U;
+    core_state_kernel_update(&s_soa, 0, 1, &step);
+    HOST_TEST_ASSERT_EQ(BASE_EPOCH + 180U, s_soa.last_feeding[0]);
+    // A meal lifts hydration above its target by the intake-driven recovery.
+    assert_close(fminf(s_reference[0].target_hydration_pct + s_soa.feeding_recovery[0], 100.0f), s_soa.hydration[0],
+                 1e-4f);
+
+    // A clock that went backwards never counts as elapsed time.
+    step.now_epoch = BASE_EPOCH;
+    core_state_kernel_update(&s_soa, 0, 1, &step);
+    HOST_TEST_ASSERT_EQ(BASE_EPOCH + 180U, s_soa.last_feeding[0]);
+}
+
+static void test_range_bounds(void)
+{
+    setup(SLOT_COUNT);
+    core_state_step_t step = {.advance_s = 1.0f, .delta_seconds = 1.0f, .now_epoch = BASE_EPOCH};
+    core_state_kernel_update(&s_soa, 10, 20, &step);
+    HOST_TEST_ASSERT(s_soa.temp_day[9] == s_reference[9].current_temp_day);
+    HOST_TEST_ASSERT(s_soa.temp_day[10] != s_reference[10].current_temp_day);
+    HOST_TEST_ASSERT(s_soa.temp_day[20] == s_reference[20].current_temp_day);
+
+    // Ranges past the live count are clipped to it.
+    s_soa.count = 30;
+    core_state_kernel_update(&s_soa, 25, SLOT_COUNT, &step);
+    HOST_TEST_ASSERT(s_soa.temp_day[29] != s_reference[29].current_temp_day);
+    HOST_TEST_ASSERT(s_soa.temp_day[30] == s_reference[30].current_temp_day);
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_layout);
+    HOST_TEST_RUN(test_store_load_roundtrip);
+    HOST_TEST_RUN(test_matches_reference);
+    HOST_TEST_RUN(test_outputs_stay_clamped);
+    HOST_TEST_RUN(test_feeding_event);
+    HOST_TEST_RUN(test_range_bounds);
+    free(s_storage);
+    return HOST_TEST_EXIT();
+}
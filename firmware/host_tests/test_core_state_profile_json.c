@@ -0,0 +1,235 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "state/core_state_profile_json.h"
+
+static const char k_full_profile[] =
+    "{\n"
+    "  \"id\": 7,\n"
+    "  \"scientific_name\": \"Python regius\",\n"
+    "  \"common_name\": \"Python royal\",\n"
+    "  \"environment\": {\n"
+    "    \"temp_day_c\": 31.5, \"temp_night_c\": 24,\n"
+    "    \"humidity_day_pct\": 60, \"humidity_night_pct\": 70,\n"
+    "    \"lux_day\": 4.0e2, \"lux_night\": 5\n"
+    "  },\n"
+    "  \"cycle_speed\": 0.03, \"phase_offset\": -1.25, \"enrichment_factor\": 1.2,\n"
+    "  \"hydration_pct\": 50, \"stress_pct\": 20,\n"
+    "  \"last_feeding_timestamp\": 1704000000,\n"
+    "  \"notes\": [\"shed\", {\"date\": null, \"ok\": true}, [1, 2.5, false]],\n"
+    "  \"metrics\": {\n"
+    "    \"hydration_pct\": 80, \"health_pct\": 91, \"activity_score\": 0.4,\n"
+    "    \"feeding\": {\"interval_hours\": 96, \"intake_pct\": 60, \"last_timestamp\": 1704100000}\n"
+    "  }\n"
+    "}\n";
+
+static void check_full_profile(const core_state_slot_t *slot)
+{
+    HOST_TEST_ASSERT_EQ(7, slot->id);
+    HOST_TEST_ASSERT(strcmp(slot->scientific_name, "Python regius") == 0);
+    HOST_TEST_ASSERT(strcmp(slot->common_name, "Python royal") == 0);
+    HOST_TEST_ASSERT(slot->base_temp_day == 31.5f && slot->base_temp_night == 24.0f);
+    HOST_TEST_ASSERT(slot->base_humidity_day == 60.0f && slot->base_humidity_night == 70.0f);
+    HOST_TEST_ASSERT(slot->base_lux_day == 400.0f && slot->base_lux_night == 5.0f);
+    HOST_TEST_ASSERT(slot->cycle_speed == 0.03f && slot->phase_offset == -1.25f && slot->enrichment_factor == 1.2f);
+    // metrics.* win over the root keys, the root value stays when metrics lacks one.
+    HOST_TEST_ASSERT(slot->hydration_pct == 80.0f && slot->target_hydration_pct == 80.0f);
+    HOST_TEST_ASSERT(slot->stress_pct == 20.0f && slot->target_stress_pct == 20.0f);
+    HOST_TEST_ASSERT(slot->health_pct == 91.0f && slot->target_health_pct == 91.0f);
+    HOST_TEST_ASSERT(slot->activity_score == 0.4f);
+    HOST_TEST_ASSERT(slot->feeding_interval_hours == 96.0f && slot->feeding_intake_pct == 60.0f);
+    HOST_TEST_ASSERT_EQ(1704100000U, slot->last_feeding_timestamp);
+    // Derived by core_state_manager, never by the parser.
+    HOST_TEST_ASSERT(slot->current_temp_day == 0.0f);
+}
+
+static void test_full_schema(void)
+{
+    core_state_slot_t slot;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(k_full_profile, strlen(k_full_profile), &slot, 3));
+    check_full_profile(&slot);
+}
+
+static void test_any_chunking_gives_the_same_slot(void)
+{
+    core_state_slot_t whole;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(k_full_profile, strlen(k_full_profile), &whole, 3));
+    for (size_t chunk = 1; chunk <= 17; ++chunk) {
+        core_state_profile_json_t parser;
+        core_state_profile_json_init(&parser);
+        for (size_t pos = 0; pos < strlen(k_full_profile); pos += chunk) {
+            size_t len = strlen(k_full_profile) - pos < chunk ? strlen(k_full_profile) - pos : chunk;
+            HOST_TEST_ASSERT(core_state_profile_json_feed(&parser, k_full_profile + pos, len));
+        }
+        core_state_slot_t slot;
+        HOST_TEST_ASSERT(core_state_profile_json_finish(&parser, &slot, 3));
+        HOST_TEST_ASSERT(memcmp(&slot, &whole, sizeof(slot)) == 0);
+    }
+}
+
+static void test_missing_fields_keep_defaults(void)
+{
+    static const char json[] = "{\"metrics\": {}}";
+    core_state_slot_t slot;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(json, strlen(json), &slot, 5));
+    HOST_TEST_ASSERT_EQ(5, slot.id);
+    HOST_TEST_ASSERT(strcmp(slot.scientific_name, "Unknown species") == 0);
+    HOST_TEST_ASSERT(strcmp(slot.common_name, "Terrarium") == 0);
+    HOST_TEST_ASSERT(slot.base_temp_day == 0.0f && slot.base_lux_night == 0.0f);
+    HOST_TEST_ASSERT(isnan(slot.cycle_speed) && isnan(slot.phase_offset) && isnan(slot.enrichment_factor));
+    HOST_TEST_ASSERT(isnan(slot.hydration_pct) && isnan(slot.target_hydration_pct));
+    HOST_TEST_ASSERT(isnan(slot.health_pct) && isnan(slot.activity_score));
+    HOST_TEST_ASSERT(isnan(slot.feeding_interval_hours) && isnan(slot.feeding_intake_pct));
+    HOST_TEST_ASSERT_EQ(0, slot.last_feeding_timestamp);
+}
+
+static void test_first_duplicate_wins_and_types_are_checked(void)
+{
+    static const char json[] =
+        "{\"id\": \"seven\", \"id\": 9,"
+        " \"environment\": {\"temp_day_c\": 30, \"temp_day_c\": 99},"
+        " \"environment\": {\"temp_night_c\": 20},"
+        " \"hydration_pct\": \"high\", \"stress_pct\": null,"
+        " \"last_feeding_timestamp\": -5,"
+        " \"metrics\": 4, \"common_name\": 12,"
+        " \"scientific_name\": \"First\", \"scientific_name\": \"Second\"}";
+    core_state_slot_t slot;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(json, strlen(json), &slot, 2));
+    // The first "id" is a string: the key is taken, the index remains.
+    HOST_TEST_ASSERT_EQ(2, slot.id);
+    HOST_TEST_ASSERT(slot.base_temp_day == 30.0f && slot.base_temp_night == 0.0f);
+    HOST_TEST_ASSERT(isnan(slot.hydration_pct) && isnan(slot.stress_pct));
+    HOST_TEST_ASSERT_EQ(0, slot.last_feeding_timestamp);
+    HOST_TEST_ASSERT(strcmp(slot.common_name, "Terrarium") == 0);
+    HOST_TEST_ASSERT(strcmp(slot.scientific_name, "First") == 0);
+}
+
+static void test_keys_are_scoped_to_their_object(void)
+{
+    static const char json[] =
+        "{\"environment\": {\"hydration_pct\": 10, \"extra\": {\"temp_day_c\": 50}},"
+        " \"other\": {\"metrics\": {\"health_pct\": 1}},"
+        " \"temp_day_c\": 40, \"feeding\": {\"interval_hours\": 3},"
+        " \"metrics\": {\"feeding\": {\"last_timestamp\": 1700000000}, \"interval_hours\": 8}}";
+    core_state_slot_t slot;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(json, strlen(json), &slot, 0));
+    HOST_TEST_ASSERT(slot.base_temp_day == 0.0f);
+    HOST_TEST_ASSERT(isnan(slot.hydration_pct) && isnan(slot.health_pct));
+    HOST_TEST_ASSERT(isnan(slot.feeding_interval_hours));
+    HOST_TEST_ASSERT_EQ(1700000000U, slot.last_feeding_timestamp);
+}
+
+static void test_root_feeding_keys(void)
+{
+    static const char json[] = "{\"feeding_interval_hours\": 48, \"feeding_intake_pct\": 55,"
+                               " \"metrics\": {\"feeding\": {\"intake_pct\": 65}}}";
+    core_state_slot_t slot;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(json, strlen(json), &slot, 0));
+    HOST_TEST_ASSERT(slot.feeding_interval_hours == 48.0f);
+    HOST_TEST_ASSERT(slot.feeding_intake_pct == 65.0f);
+}
+
+static void test_string_escapes(void)
+{
+    static const char json[] = "{\"common_name\": \"Dragon \\\"barbu\\\" \\u00e9\\u20ac\\ud83e\\udd8e\\/\\t\","
+                               " \"scientific_name\": \"Pogona\\u0020vitticeps\"}";
+    core_state_slot_t slot;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(json, strlen(json), &slot, 0));
+    HOST_TEST_ASSERT(strcmp(slot.common_name, "Dragon \"barbu\" \xC3\xA9\xE2\x82\xAC\xF0\x9F\xA6\x8E/\t") == 0);
+    HOST_TEST_ASSERT(strcmp(slot.scientific_name, "Pogona vitticeps") == 0);
+}
+
+static void test_long_strings_are_truncated(void)
+{
+    char json[512];
+    char name[200];
+    memset(name, 'x', sizeof(name) - 1U);
+    name[sizeof(name) - 1U] = '\0';
+    // A truncated key never matches, even when its prefix is a schema key.
+    snprintf(json, sizeof(json), "{\"common_name\": \"%s\", \"id%s\": 4}", name, name);
+    core_state_slot_t slot;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(json, strlen(json), &slot, 1));
+    HOST_TEST_ASSERT_EQ(CORE_LINK_NAME_MAX_LEN, strlen(slot.common_name));
+    HOST_TEST_ASSERT_EQ(1, slot.id);
+}
+
+static void test_trailing_text_is_ignored(void)
+{
+    static const char json[] = "{\"id\": 3} garbage";
+    core_state_slot_t slot;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(json, strlen(json), &slot, 0));
+    HOST_TEST_ASSERT_EQ(3, slot.id);
+}
+
+static void test_invalid_documents(void)
+{
+    static const char *const invalid[] = {
+        "",
+        "   ",
+        "{",
+        "{\"id\": 3",
+        "{\"id\" 3}",
+        "{\"id\": 3,}",
+        "{\"a\": [1, 2,]}",
+        "{\"a\": [1, 2}",
+        "{\"a\": tru}",
+        "{\"a\": nul}",
+        "{\"a\": 1.2.3}",
+        "{\"a\": -}",
+        "{\"a\": \"\\x\"}",
+        "{\"a\": \"\\u12g4\"}",
+        "{\"a\": \"\\udd8e\"}",
+        "{\"a\": \"\\ud83ex\"}",
+        "{id: 3}",
+        "{\"a\": 'b'}",
+        "]",
+    };
+    core_state_slot_t slot;
+    memset(&slot, 0xA5, sizeof(slot));
+    core_state_slot_t untouched = slot;
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        if (core_state_profile_json_parse(invalid[i], strlen(invalid[i]), &slot, 0)) {
+            fprintf(stderr, "accepted: %s\n", invalid[i]);
+            HOST_TEST_ASSERT(false);
+        }
+    }
+    HOST_TEST_ASSERT(memcmp(&slot, &untouched, sizeof(slot)) == 0);
+}
+
+static void test_nesting_limit(void)
+{
+    char json[2 * CORE_STATE_PROFILE_JSON_MAX_DEPTH + 8];
+    size_t len = 0;
+    for (size_t depth = 0; depth < CORE_STATE_PROFILE_JSON_MAX_DEPTH; ++depth) {
+        json[len++] = '[';
+    }
+    for (size_t depth = 0; depth < CORE_STATE_PROFILE_JSON_MAX_DEPTH; ++depth) {
+        json[len++] = ']';
+    }
+    core_state_slot_t slot;
+    HOST_TEST_ASSERT(core_state_profile_json_parse(json, len, &slot, 0));
+
+    memmove(json + 1, json, len);
+    json[0] = '[';
+    json[len + 1] = ']';
+    HOST_TEST_ASSERT(!core_state_profile_json_parse(json, len + 2, &slot, 0));
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_full_schema);
+    HOST_TEST_RUN(test_any_chunking_gives_the_same_slot);
+    HOST_TEST_RUN(test_missing_fields_keep_defaults);
+    HOST_TEST_RUN(test_first_duplicate_wins_and_types_are_checked);
+    HOST_TEST_RUN(test_keys_are_scoped_to_their_object);
+    HOST_TEST_RUN(test_root_feeding_keys);
+    HOST_TEST_RUN(test_string_escapes);
+    HOST_TEST_RUN(test_long_strings_are_truncated);
+    HOST_TEST_RUN(test_trailing_text_is_ignored);
+    HOST_TEST_RUN(test_invalid_documents);
+    HOST_TEST_RUN(test_nesting_limit);
+    return HOST_TEST_EXIT();
+}
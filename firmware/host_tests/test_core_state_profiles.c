@@ -0,0 +1,301 @@
+#define _GNU_SOURCE
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include "host_test.h"
+#include "state/core_state_profiles.h"
+
+#define CAPACITY 8U
+
+static char s_dir[64];
+static char s_cache_path[80];
+static core_state_profile_cache_t *s_cache;
+
+static void write_text(const char *name, const char *text)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "%s/%s", s_dir, name);
+    FILE *file = fopen(path, "wb");
+    fputs(text, file);
+    fclose(file);
+}
+
+static void remove_all(void)
+{
+    DIR *dir = opendir(s_dir);
+    struct dirent *entry = NULL;
+    while (dir && (entry = readdir(dir)) != NULL) {
+        char path[sizeof(entry->d_name) + 64];
+        snprintf(path, sizeof(path), "%s/%s", s_dir, entry->d_name);
+        if (entry->d_name[0] != '.') {
+            unlink(path);
+        }
+    }
+    if (dir) {
+        closedir(dir);
+    }
+    rmdir(s_dir);
+    unlink(s_cache_path);
+}
+
+static void setup(void)
+{
+    if (s_dir[0] != '\0') {
+        remove_all();
+    }
+    strcpy(s_dir, "/tmp/profilesXXXXXX");
+    mkdtemp(s_dir);
+    core_state_profiles_cache_path(s_dir, s_cache_path, sizeof(s_cache_path));
+    write_text("b_pogona.json", "{\"common_name\": \"Dragon barbu\", \"environment\": {\"temp_day_c\": 35}}");
+    write_text("A_python.JSON", "{\"common_name\": \"Python royal\", \"environment\": {\"temp_day_c\": 31}}");
+    write_text("c_broken.json", "{\"common_name\": ");
+    write_text("d_gecko.json", "{\"common_name\": \"Gecko\", \"id\": 12}");
+    write_text("notes.txt", "not a profile");
+}
+
+static core_state_profiles_status_t load(core_state_profiles_stats_t *stats)
+{
+    return core_state_profiles_load(s_dir, s_cache_path, NULL, s_cache, CAPACITY, stats);
+}
+
+static void test_cache_path_is_next_to_the_directory(void)
+{
+    char path[32];
+    HOST_TEST_ASSERT(core_state_profiles_cache_path("/sdcard/profiles/", path, sizeof(path)));
+    HOST_TEST_ASSERT(strcmp(path, "/sdcard/profiles.bin") == 0);
+    HOST_TEST_ASSERT(!core_state_profiles_cache_path("/sdcard/profiles", path, 16));
+}
+
+static void test_crc32_reference_value(void)
+{
+    HOST_TEST_ASSERT_EQ(0xCBF43926UL, core_state_profiles_crc32(0, "123456789", 9));
+    uint32_t crc = core_state_profiles_crc32(0, "1234", 4);
+    HOST_TEST_ASSERT_EQ(0xCBF43926UL, core_state_profiles_crc32(crc, "56789", 5));
+}
+
+static void test_first_load_parses_and_writes_the_cache(void)
+{
+    setup();
+    core_state_profiles_stats_t stats;
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(!stats.cache_hit && stats.cache_written);
+    HOST_TEST_ASSERT_EQ(4, stats.files);
+    HOST_TEST_ASSERT_EQ(3, stats.valid);
+    HOST_TEST_ASSERT_EQ(4, s_cache->count);
+    // Sorted without case; without history, ids default to the lowest free ones.
+    HOST_TEST_ASSERT(strcmp(s_cache->entries[0].name, "A_python.JSON") == 0);
+    HOST_TEST_ASSERT(strcmp(s_cache->entries[1].slot.common_name, "Dragon barbu") == 0);
+    HOST_TEST_ASSERT_EQ(1, s_cache->entries[1].slot.id);
+    HOST_TEST_ASSERT(!s_cache->entries[2].valid);
+    HOST_TEST_ASSERT_EQ(12, s_cache->entries[3].slot.id);
+    HOST_TEST_ASSERT(s_cache->entries[0].slot.base_temp_day == 31.0f);
+
+    struct stat st;
+    HOST_TEST_ASSERT(stat(s_cache_path, &st) == 0);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILE_CACHE_SIZE(4), st.st_size);
+}
+
+static void test_unchanged_directory_hits_the_cache(void)
+{
+    setup();
+    core_state_profiles_stats_t stats;
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    core_state_profile_entry_t parsed[4];
+    memcpy(parsed, s_cache->entries, sizeof(parsed));
+
+    memset(s_cache, 0xA5, CORE_STATE_PROFILE_CACHE_SIZE(CAPACITY));
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(stats.cache_hit && !stats.cache_written);
+    HOST_TEST_ASSERT_EQ(4, stats.files);
+    HOST_TEST_ASSERT_EQ(3, stats.valid);
+    HOST_TEST_ASSERT_EQ(4, s_cache->count);
+    HOST_TEST_ASSERT(memcmp(parsed, s_cache->entries, sizeof(parsed)) == 0);
+}
+
+static void test_changed_size_or_mtime_rebuilds(void)
+{
+    setup();
+    core_state_profiles_stats_t stats;
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+
+    write_text("b_pogona.json", "{\"common_name\": \"Dragon barbu\", \"environment\": {\"temp_day_c\": 36.5}}");
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(!stats.cache_hit && stats.cache_written);
+    HOST_TEST_ASSERT(s_cache->entries[1].slot.base_temp_day == 36.5f);
+
+    // Same size, new content: only the modification time tells.
+    char path[128];
+    snprintf(path, sizeof(path), "%s/b_pogona.json", s_dir);
+    struct stat st;
+    stat(path, &st);
+    write_text("b_pogona.json", "{\"common_name\": \"Dragon barbu\", \"environment\": {\"temp_day_c\": 37.5}}");
+    struct utimbuf times = {.actime = st.st_atime, .modtime = st.st_mtime + 10};
+    utime(path, &times);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(!stats.cache_hit);
+    HOST_TEST_ASSERT(s_cache->entries[1].slot.base_temp_day == 37.5f);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(stats.cache_hit);
+}
+
+static void test_added_or_removed_file_rebuilds(void)
+{
+    setup();
+    core_state_profiles_stats_t stats;
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+
+    write_text("e_boa.json", "{\"common_name\": \"Boa\"}");
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(!stats.cache_hit);
+    HOST_TEST_ASSERT_EQ(5, stats.files);
+
+    char path[128];
+    snprintf(path, sizeof(path), "%s/d_gecko.json", s_dir);
+    unlink(path);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(!stats.cache_hit);
+    HOST_TEST_ASSERT_EQ(4, stats.files);
+    HOST_TEST_ASSERT(strcmp(s_cache->entries[3].slot.common_name, "Boa") == 0);
+}
+
+static void test_corrupt_cache_is_rebuilt(void)
+{
+    setup();
+    core_state_profiles_stats_t stats;
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+
+    FILE *file = fopen(s_cache_path, "r+b");
+    fseek(file, (long)(sizeof(core_state_profile_cache_t) + 100U), SEEK_SET);
+    fputc(0x5A, file);
+    fclose(file);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(!stats.cache_hit && stats.cache_written);
+
+    // A write cut short by a power loss.
+    HOST_TEST_ASSERT(truncate(s_cache_path, (off_t)CORE_STATE_PROFILE_CACHE_SIZE(2)) == 0);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(!stats.cache_hit && stats.cache_written);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT(stats.cache_hit);
+}
+
+static void test_previous_result_spares_unchanged_files(void)
+{
+    setup();
+    core_state_profiles_stats_t stats;
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    core_state_profile_cache_t *previous = malloc(CORE_STATE_PROFILE_CACHE_SIZE(CAPACITY));
+    memcpy(previous, s_cache, CORE_STATE_PROFILE_CACHE_SIZE(CAPACITY));
+
+    // A new file sorts first and a profile changes: the other two are taken as is.
+    write_text("0_boa.json", "{\"common_name\": \"Boa\"}");
+    write_text("b_pogona.json", "{\"common_name\": \"Dragon barbu\", \"environment\": {\"temp_day_c\": 38.5}}");
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK,
+                        core_state_profiles_load(s_dir, s_cache_path, previous, s_cache, CAPACITY, &stats));
+    HOST_TEST_ASSERT(!stats.cache_hit && stats.cache_written);
+    HOST_TEST_ASSERT_EQ(5, stats.files);
+    HOST_TEST_ASSERT_EQ(3, stats.reused);
+    HOST_TEST_ASSERT_EQ(4, stats.valid);
+    HOST_TEST_ASSERT(s_cache->entries[2].slot.base_temp_day == 38.5f);
+    // Existing profiles keep their ids, modified or not; the new one takes the first free id.
+    HOST_TEST_ASSERT_EQ(2, s_cache->entries[0].slot.id);
+    HOST_TEST_ASSERT_EQ(0, s_cache->entries[1].slot.id);
+    HOST_TEST_ASSERT_EQ(1, s_cache->entries[2].slot.id);
+    HOST_TEST_ASSERT(!s_cache->entries[3].valid);
+    HOST_TEST_ASSERT_EQ(12, s_cache->entries[4].slot.id);
+
+    // The rewritten cache matches a full parse, save for the ids it hands out.
+    core_state_profile_entry_t merged[5];
+    memcpy(merged, s_cache->entries, sizeof(merged));
+    unlink(s_cache_path);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    HOST_TEST_ASSERT_EQ(0, stats.reused);
+    HOST_TEST_ASSERT_EQ(0, s_cache->entries[0].slot.id);
+    for (size_t i = 0; i < 5; ++i) {
+        s_cache->entries[i].slot.id = merged[i].slot.id;
+    }
+    HOST_TEST_ASSERT(memcmp(merged, s_cache->entries, sizeof(merged)) == 0);
+    free(previous);
+}
+
+static void test_ids_survive_removals_and_yield_to_explicit_ones(void)
+{
+    setup();
+    core_state_profiles_stats_t stats;
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, load(&stats));
+    core_state_profile_cache_t *previous = malloc(CORE_STATE_PROFILE_CACHE_SIZE(CAPACITY));
+    memcpy(previous, s_cache, CORE_STATE_PROFILE_CACHE_SIZE(CAPACITY));
+
+    // Removing the first profile leaves the second one at id 1.
+    char path[128];
+    snprintf(path, sizeof(path), "%s/A_python.JSON", s_dir);
+    unlink(path);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK,
+                        core_state_profiles_load(s_dir, s_cache_path, previous, s_cache, CAPACITY, &stats));
+    HOST_TEST_ASSERT(strcmp(s_cache->entries[0].name, "b_pogona.json") == 0);
+    HOST_TEST_ASSERT_EQ(1, s_cache->entries[0].slot.id);
+    memcpy(previous, s_cache, CORE_STATE_PROFILE_CACHE_SIZE(CAPACITY));
+
+    // A profile that claims id 1 explicitly wins it; the other one moves to a free id.
+    write_text("e_boa.json", "{\"common_name\": \"Boa\", \"id\": 1}");
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK,
+                        core_state_profiles_load(s_dir, s_cache_path, previous, s_cache, CAPACITY, &stats));
+    HOST_TEST_ASSERT_EQ(4, s_cache->count);
+    HOST_TEST_ASSERT_EQ(0, s_cache->entries[0].slot.id);
+    HOST_TEST_ASSERT_EQ(12, s_cache->entries[2].slot.id);
+    HOST_TEST_ASSERT_EQ(1, s_cache->entries[3].slot.id);
+    free(previous);
+}
+
+static void test_capacity_limit_skips_the_cache(void)
+{
+    setup();
+    core_state_profiles_stats_t stats;
+    unlink(s_cache_path);
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_OK, core_state_profiles_load(s_dir, s_cache_path, NULL, s_cache, 2, &stats));
+    HOST_TEST_ASSERT(stats.truncated && !stats.cache_written);
+    HOST_TEST_ASSERT_EQ(2, s_cache->count);
+    HOST_TEST_ASSERT(access(s_cache_path, F_OK) != 0);
+}
+
+static void test_missing_or_empty_directories(void)
+{
+    setup();
+    core_state_profiles_stats_t stats;
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_NOT_FOUND,
+                        core_state_profiles_load("/nonexistent/profiles", NULL, NULL, s_cache, CAPACITY, &stats));
+
+    remove_all();
+    mkdir(s_dir, 0755);
+    write_text("notes.txt", "not a profile");
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_NOT_FOUND, load(&stats));
+
+    write_text("broken.json", "{");
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_EMPTY, load(&stats));
+    HOST_TEST_ASSERT_EQ(CORE_STATE_PROFILES_EMPTY, load(&stats));
+    HOST_TEST_ASSERT(stats.cache_hit);
+}
+
+int main(void)
+{
+    s_cache = malloc(CORE_STATE_PROFILE_CACHE_SIZE(CAPACITY));
+    HOST_TEST_RUN(test_cache_path_is_next_to_the_directory);
+    HOST_TEST_RUN(test_crc32_reference_value);
+    HOST_TEST_RUN(test_first_load_parses_and_writes_the_cache);
+    HOST_TEST_RUN(test_unchanged_directory_hits_the_cache);
+    HOST_TEST_RUN(test_changed_size_or_mtime_rebuilds);
+    HOST_TEST_RUN(test_added_or_removed_file_rebuilds);
+    HOST_TEST_RUN(test_corrupt_cache_is_rebuilt);
+    HOST_TEST_RUN(test_previous_result_spares_unchanged_files);
+    HOST_TEST_RUN(test_ids_survive_removals_and_yield_to_explicit_ones);
+    HOST_TEST_RUN(test_capacity_limit_skips_the_cache);
+    HOST_TEST_RUN(test_missing_or_empty_directories);
+    remove_all();
+    free(s_cache);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,311 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "state/core_state_sim.h"
+
+#define SLOT_COUNT 4U
+#define STEP_MS 100U
+#define BASE_EPOCH 1704067200U
+#define TRACE_STEPS (2U * 86400U * 1000U / STEP_MS) /* two simulated days */
+#define TRACE_EVERY_STEPS (6U * 3600U * 1000U / STEP_MS)
+#define TRACE_ROWS (TRACE_STEPS / TRACE_EVERY_STEPS)
+
+// The four built-in profiles of core_state_manager, after apply_slot_defaults().
+static const struct {
+    float temp_day, temp_night, humidity_day, humidity_night, lux_day, lux_night;
+    float cycle_speed, phase_offset, enrichment;
+} k_profiles[SLOT_COUNT] = {
+    {31.0f, 24.0f, 60.0f, 70.0f, 400.0f, 5.0f, 0.03f, 0.0f, 1.0f},
+    {35.0f, 22.0f, 40.0f, 50.0f, 650.0f, 10.0f, 0.045f, 1.1f, 1.3f},
+    {27.0f, 21.0f, 70.0f, 85.0f, 220.0f, 3.0f, 0.038f, 2.4f, 0.8f},
+    {33.0f, 23.0f, 45.0f, 55.0f, 320.0f, 6.0f, 0.033f, 3.1f, 1.1f},
+};
+
+typedef struct {
+    float temp_day;
+    float humidity_day;
+    float lux_day;
+    float hydration;
+    float stress;
+    float health;
+    float activity;
+    uint32_t last_feeding;
+} trace_row_t;
+
+// Recorded every 6 simulated hours from the run above. A deliberate change of
+// the model regenerates it with `test_core_state_sim --golden`.
+static const trace_row_t k_golden[TRACE_ROWS][SLOT_COUNT] = {
+    {
+        {32.3306f, 62.1145f, 459.1370f, 86.0001f, 13.8283f, 93.9387f, 0.86554f, 1704045600U},
+        {33.7167f, 34.0001f, 592.9647f, 82.4826f, 18.9090f, 91.4651f, 0.59005f, 1704024000U},
+        {27.1845f, 74.9073f, 228.2015f, 76.0001f, 24.1414f, 88.4417f, 0.85431f, 1704002400U},
+        {32.3271f, 50.9981f, 290.0940f, 72.9395f, 31.0661f, 85.8039f, 0.81041f, 1703980800U},
+    },
+    {
+        {32.7922f, 55.4904f, 479.6543f, 85.0001f, 9.4024f, 94.7812f, 0.63086f, 1704045600U},
+        {34.2102f, 41.4240f, 614.8987f, 81.6434f, 16.5934f, 91.8828f, 0.87694f, 1704024000U},
+        {25.5390f, 66.5813f, 155.0671f, 74.5001f, 29.6878f, 86.7973f, 0.80808f, 1704002400U},
+        {34.1932f, 39.8173f, 373.0308f, 71.7274f, 26.0098f, 86.7466f, 0.80456f, 1703980800U},
+    },
+    {
+        {32.0834f, 54.7069f, 448.1532f, 84.0001f, 18.0742f, 92.3919f, 0.87137f, 1704045600U},
+        {36.7845f, 45.3086f, 729.3110f, 80.8043f, 14.9364f, 92.1489f, 0.66874f, 1704024000U},
+        {28.7564f, 71.5120f, 298.0634f, 73.0001f, 29.6460f, 86.5756f, 0.72179f, 1704002400U},
+        {31.4243f, 47.8210f, 249.9703f, 70.5153f, 24.4995f, 86.9692f, 0.65788f, 1703980800U},
+    },
+    {
+        {30.6671f, 60.7788f, 385.2054f, 83.0001f, 19.5528f, 91.8936f, 0.70045f, 1704045600U},
+        {34.6573f, 35.9987f, 634.7695f, 79.9651f, 14.3914f, 92.1446f, 0.76152f, 1704024000U},
+        {26.1275f, 70.5795f, 181.2239f, 71.5001f, 24.0510f, 87.7113f, 0.63452f, 1704002400U},
+        {34.7761f, 45.3824f, 398.9389f, 69.3031f, 31.9438f, 84.8064f, 0.51593f, 1703980800U},
+    },
+    {
+        {29.4682f, 65.8420f, 331.9193f, 82.0001f, 10.3784f, 93.9842f, 0.70209f, 1704045600U},
+        {33.4330f, 36.6342f, 580.3545f, 79.1260f, 15.1076f, 91.8251f, 0.80479f, 1704024000U},
+        {26.4027f, 67.3998f, 193.4515f, 70.0001f, 17.5778f, 89.0047f, 0.57880f, 1704002400U},
+        {31.2286f, 41.5284f, 241.2707f, 88.0000f, 21.6030f, 87.3353f, 0.64671f, 1704175200U},
+    },
+    {
+        {29.2696f, 63.3389f, 323.0935f, 81.0001f, 12.0179f, 93.3041f, 0.89914f, 1704045600U},
+        {36.3371f, 45.6355f, 709.4285f, 78.2868f, 16.8890f, 91.2320f, 0.61902f, 1704024000U},
+        {28.6660f, 74.3029f, 294.0463f, 68.5001f, 15.6353f, 89.1244f, 0.57108f, 1704002400U},
+        {34.5621f, 50.5251f, 389.4250f, 77.7880f, 30.4618f, 86.9295f, 0.74590f, 1704175200U},
+    },
+    {
+        {30.2011f, 56.5114f, 364.4918f, 80.0001f, 20.6351f, 90.9766f, 0.58586f, 1704045600U},
+        {35.7185f, 40.6297f, 681.9315f, 77.4476f, 19.2481f, 90.4816f, 0.87384f, 1704024000U},
+        {25.3840f, 64.5205f, 148.1762f, 91.0000f, 17.7214f, 87.9863f, 0.67822f, 1704218400U},
+        {31.8277f, 39.0698f, 267.8990f, 76.5759f, 26.8428f, 87.5076f, 0.84715f, 1704175200U},
+    },
+    {
+        {31.6543f, 54.2022f, 429.0788f, 79.0001f, 16.0668f, 91.9798f, 0.81589f, 1704045600U},
+        {33.2069f, 34.0588f, 570.3074f, 76.6085f, 21.5393f, 89.7335f, 0.57333f, 1704024000U},
+        {27.4809f, 75.9861f, 241.3731f, 80.5001f, 26.6927f, 88.7137f, 0.72013f, 1704218400U},
+        {33.6471f, 49.5660f, 348.7584f, 75.3637f, 23.7868f, 88.1130f, 0.78115f, 1704175200U},
+    },
+};
+
+static core_state_soa_t s_soa;
+static void *s_storage;
+static core_state_sim_t s_sim;
+static trace_row_t s_trace[TRACE_ROWS][SLOT_COUNT];
+
+static void setup(void)
+{
+    free(s_storage);
+    size_t size = core_state_soa_storage_size(SLOT_COUNT);
+    s_storage = aligned_alloc(16, (size + 15U) & ~(size_t)15U);
+    memset(s_storage, 0, size);
+    core_state_soa_init(&s_soa, s_storage, SLOT_COUNT);
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        core_state_slot_t slot;
+        memset(&slot, 0, sizeof(slot));
+        slot.id = (uint8_t)i;
+        slot.base_temp_day = slot.current_temp_day = k_profiles[i].temp_day;
+        slot.base_temp_night = slot.current_temp_night = k_profiles[i].temp_night;
+        slot.base_humidity_day = slot.current_humidity_day = k_profiles[i].humidity_day;
+        slot.base_humidity_night = slot.current_humidity_night = k_profiles[i].humidity_night;
+        slot.base_lux_day = slot.current_lux_day = k_profiles[i].lux_day;
+        slot.base_lux_night = slot.current_lux_night = k_profiles[i].lux_night;
+        slot.hydration_pct = slot.target_hydration_pct = 88.0f - (float)i * 3.0f;
+        slot.stress_pct = slot.target_stress_pct = 15.0f + (float)i * 4.0f;
+        slot.health_pct = slot.target_health_pct = 94.0f - (float)i * 2.0f;
+        slot.activity_score = 0.5f;
+        slot.feeding_interval_hours = 72.0f - (float)i * 6.0f;
+        slot.feeding_intake_pct = 75.0f;
+        slot.cycle_speed = k_profiles[i].cycle_speed;
+        slot.phase_offset = k_profiles[i].phase_offset;
+        slot.enrichment_factor = k_profiles[i].enrichment;
+        slot.last_feeding_timestamp = BASE_EPOCH - (uint32_t)(6 * 3600 * (i + 1));
+        core_state_soa_store(&s_soa, i, &slot);
+    }
+    s_soa.count = SLOT_COUNT;
+    core_state_sim_init(&s_sim, STEP_MS, BASE_EPOCH);
+}
+
+static void record(size_t row)
+{
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        s_trace[row][i] = (trace_row_t){
+            .temp_day = s_soa.temp_day[i],
+            .humidity_day = s_soa.humidity_day[i],
+            .lux_day = s_soa.lux_day[i],
+            .hydration = s_soa.hydration[i],
+            .stress = s_soa.stress[i],
+            .health = s_soa.health[i],
+            .activity = s_soa.activity[i],
+            .last_feeding = s_soa.last_feeding[i],
+        };
+    }
+}
+
+// Runs every due step in slices of `chunk` slots, as core_state_manager_advance()
+// does under its lock, and records the trace rows reached.
+static uint64_t run_due_steps(size_t chunk)
+{
+    uint64_t steps = 0;
+    core_state_sim_tick_t tick;
+    while (core_state_sim_next(&s_sim, &tick)) {
+        for (size_t begin = 0; begin < s_soa.count; begin += chunk) {
+            core_state_sim_apply(&tick, &s_soa, begin, begin + chunk);
+        }
+        if (s_sim.steps % TRACE_EVERY_STEPS == 0 && s_sim.steps <= TRACE_STEPS) {
+            record(s_sim.steps / TRACE_EVERY_STEPS - 1U);
+        }
+        ++steps;
+    }
+    return steps;
+}
+
+// Feeds the two days in late, uneven slices: 0 to 2.5 s, and now and then a
+// 40 s stall, the way a starved update task would.
+static void run_jittered(size_t chunk)
+{
+    uint32_t lcg = 2024U;
+    uint64_t total_us = (uint64_t)TRACE_STEPS * STEP_MS * 1000U;
+    uint64_t fed_us = 0;
+    while (fed_us < total_us) {
+        lcg = lcg * 1664525U + 1013904223U;
+        uint64_t slice_us = (lcg >> 8) % 2500000U;
+        if ((lcg >> 28) == 0U) {
+            slice_us = 40000000U;
+        }
+        if (slice_us > total_us - fed_us) {
+            slice_us = total_us - fed_us;
+        }
+        core_state_sim_add_time(&s_sim, slice_us);
+        fed_us += slice_us;
+        run_due_steps(chunk);
+    }
+}
+
+static bool same_state(const void *reference)
+{
+    return memcmp(reference, s_storage, core_state_soa_storage_size(SLOT_COUNT)) == 0;
+}
+
+static void test_leftover_is_carried(void)
+{
+    setup();
+    core_state_sim_add_time(&s_sim, 60000U);
+    HOST_TEST_ASSERT_EQ(0, run_due_steps(SLOT_COUNT));
+    core_state_sim_add_time(&s_sim, 60000U);
+    HOST_TEST_ASSERT_EQ(1, run_due_steps(SLOT_COUNT));
+    HOST_TEST_ASSERT_EQ(20000U, s_sim.pending_us);
+
+    // Late ticks are caught up, not dropped.
+    core_state_sim_add_time(&s_sim, 1230000U);
+    HOST_TEST_ASSERT_EQ(12, core_state_sim_pending_steps(&s_sim));
+    HOST_TEST_ASSERT_EQ(12, run_due_steps(SLOT_COUNT));
+    HOST_TEST_ASSERT_EQ(BASE_EPOCH + 1U, core_state_sim_epoch(&s_sim));
+    HOST_TEST_ASSERT(fabs(core_state_sim_time_s(&s_sim) - 1.3) < 1e-12);
+}
+
+static void test_step_is_clamped(void)
+{
+    core_state_sim_init(&s_sim, 5000U, BASE_EPOCH);
+    HOST_TEST_ASSERT_EQ(1000000U, s_sim.step_us);
+    core_state_sim_init(&s_sim, 0U, BASE_EPOCH);
+    HOST_TEST_ASSERT_EQ(1000U, s_sim.step_us);
+}
+
+static void test_partition_is_bit_exact(void)
+{
+    // One call for the whole span, over the whole range...
+    setup();
+    core_state_sim_add_time(&s_sim, (uint64_t)TRACE_STEPS * STEP_MS * 1000U);
+    HOST_TEST_ASSERT_EQ(TRACE_STEPS, run_due_steps(SLOT_COUNT));
+    size_t size = core_state_soa_storage_size(SLOT_COUNT);
+    void *whole = malloc(size);
+    memcpy(whole, s_storage, size);
+
+    // ...or late, uneven slices over slot slices that split the vector lanes.
+    setup();
+    run_jittered(3);
+    HOST_TEST_ASSERT_EQ(TRACE_STEPS, s_sim.steps);
+    HOST_TEST_ASSERT(same_state(whole));
+    free(whole);
+}
+
+static void test_golden_trace(void)
+{
+    setup();
+    run_jittered(SLOT_COUNT);
+    for (size_t row = 0; row < TRACE_ROWS; ++row) {
+        for (size_t i = 0; i < SLOT_COUNT; ++i) {
+            const trace_row_t *want = &k_golden[row][i];
+            const trace_row_t *got = &s_trace[row][i];
+            // Bit-exact on one toolchain; the slack only covers another libm or
+            // FP contraction, far below any real change of the model.
+            const float pairs[][3] = {
+                {want->temp_day, got->temp_day, 1e-3f},   {want->humidity_day, got->humidity_day, 1e-3f},
+                {want->lux_day, got->lux_day, 2e-2f},     {want->hydration, got->hydration, 1e-3f},
+                {want->stress, got->stress, 1e-3f},       {want->health, got->health, 1e-3f},
+                {want->activity, got->activity, 1e-4f},
+            };
+            for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); ++p) {
+                if (fabsf(pairs[p][0] - pairs[p][1]) > pairs[p][2]) {
+                    fprintf(stderr, "row %zu slot %zu field %zu: expected %.4f, got %.4f\n", row, i, p,
+                            (double)pairs[p][0], (double)pairs[p][1]);
+                }
+                HOST_TEST_ASSERT(fabsf(pairs[p][0] - pairs[p][1]) <= pairs[p][2]);
+            }
+            HOST_TEST_ASSERT_EQ(want->last_feeding, got->last_feeding);
+        }
+    }
+}
+
+static void test_fast_forward(void)
+{
+    // A month at full speed, as core_state_manager_advance() runs it.
+    setup();
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    core_state_sim_add_time(&s_sim, 30ULL * 86400ULL * 1000000ULL);
+    uint64_t steps = run_due_steps(SLOT_COUNT);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double ms = (double)(t1.tv_sec - t0.tv_sec) * 1e3 + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-6;
+    printf("  30 days (%llu steps, %u slots) in %.0f ms\n", (unsigned long long)steps, SLOT_COUNT, ms);
+    HOST_TEST_ASSERT_EQ(30U * 864000U, steps);
+    HOST_TEST_ASSERT_EQ(BASE_EPOCH + 30U * 86400U, core_state_sim_epoch(&s_sim));
+    for (size_t i = 0; i < SLOT_COUNT; ++i) {
+        HOST_TEST_ASSERT(isfinite(s_soa.temp_day[i]) && isfinite(s_soa.health[i]));
+        HOST_TEST_ASSERT(BASE_EPOCH + 30U * 86400U - s_soa.last_feeding[i] <= 72U * 3600U);
+    }
+}
+
+static void print_golden(void)
+{
+    setup();
+    run_jittered(SLOT_COUNT);
+    for (size_t row = 0; row < TRACE_ROWS; ++row) {
+        printf("    {\n");
+        for (size_t i = 0; i < SLOT_COUNT; ++i) {
+            const trace_row_t *r = &s_trace[row][i];
+            printf("        {%.4ff, %.4ff, %.4ff, %.4ff, %.4ff, %.4ff, %.5ff, %uU},\n", (double)r->temp_day,
+                   (double)r->humidity_day, (double)r->lux_day, (double)r->hydration, (double)r->stress,
+                   (double)r->health, (double)r->activity, r->last_feeding);
+        }
+        printf("    },\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--golden") == 0) {
+        print_golden();
+        free(s_storage);
+        return 0;
+    }
+    HOST_TEST_RUN(test_leftover_is_carried);
+    HOST_TEST_RUN(test_step_is_clamped);
+    HOST_TEST_RUN(test_partition_is_bit_exact);
+    HOST_TEST_RUN(test_golden_trace);
+    HOST_TEST_RUN(test_fast_forward);
+    free(s_storage);
+    return HOST_TEST_EXIT();
+}
@@ -0,0 +1,201 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "host_test.h"
+#include "state/core_state_snapshot.h"
+
+#define CAPACITY 64U
+#define READER_COUNT 3U
+#define PUBLICATIONS 50000U
+
+static core_state_snapshot_t s_snapshot;
+static core_link_state_frame_t *s_frames[2];
+static atomic_bool s_writer_done;
+
+typedef struct {
+    core_link_state_frame_t *frame;
+    uint32_t reads;
+    uint32_t torn;
+    uint32_t regressions;
+    uint32_t last_seq;
+} reader_ctx_t;
+
+static core_link_state_frame_t *alloc_frame(size_t capacity)
+{
+    core_link_state_frame_t *frame = malloc(CORE_LINK_STATE_FRAME_SIZE(capacity));
+    core_link_state_frame_init(frame, (uint8_t)capacity);
+    return frame;
+}
+
+static void setup(void)
+{
+    for (size_t i = 0; i < 2; ++i) {
+        free(s_frames[i]);
+        s_frames[i] = alloc_frame(CAPACITY);
+    }
+    core_state_snapshot_init(&s_snapshot, s_frames[0], s_frames[1]);
+    atomic_store(&s_writer_done, false);
+}
+
+// Publication n: every field of every entry derives from n, the count varies.
+static void fill(core_link_state_frame_t *frame, uint32_t n)
+{
+    frame->epoch_seconds = n;
+    frame->sample_us = (int64_t)n * 100000;
+    frame->terrarium_count = (uint8_t)(1U + n % CAPACITY);
+    for (size_t i = 0; i < frame->terrarium_count; ++i) {
+        core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
+        snap->terrarium_id = (uint8_t)i;
+        snprintf(snap->common_name, sizeof(snap->common_name), "T%zu-%u", i, (unsigned)n);
+        float value = (float)(n % 65536U) + (float)i;
+        snap->temp_day_c = value;
+        snap->temp_night_c = value;
+        snap->humidity_day_pct = value;
+        snap->humidity_night_pct = value;
+        snap->lux_day = value;
+        snap->lux_night = value;
+        snap->hydration_pct = value;
+        snap->stress_pct = value;
+        snap->health_pct = value;
+        snap->activity_score = value;
+        snap->last_feeding_timestamp = n;
+    }
+}
+
+static bool consistent(const core_link_state_frame_t *frame)
+{
+    uint32_t n = frame->epoch_seconds;
+    if (frame->sample_us != (int64_t)n * 100000) {
+        return false;
+    }
+    size_t count = 1U + n % CAPACITY;
+    if (count > frame->terrarium_capacity) {
+        count = frame->terrarium_capacity;
+    }
+    if (n != 0 && frame->terrarium_count != count) {
+        return false;
+    }
+    for (size_t i = 0; i < frame->terrarium_count; ++i) {
+        const core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
+        char name[sizeof(snap->common_name)];
+        snprintf(name, sizeof(name), "T%zu-%u", i, (unsigned)n);
+        float value = (float)(n % 65536U) + (float)i;
+        if (snap->last_feeding_timestamp != n || strcmp(snap->common_name, name) != 0 ||
+            snap->temp_day_c != value || snap->lux_night != value || snap->activity_score != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void *writer_main(void *arg)
+{
+    (void)arg;
+    for (uint32_t n = 1; n <= PUBLICATIONS; ++n) {
+        fill(core_state_snapshot_begin(&s_snapshot), n);
+        core_state_snapshot_publish(&s_snapshot);
+    }
+    atomic_store(&s_writer_done, true);
+    return NULL;
+}
+
+static void *reader_main(void *arg)
+{
+    reader_ctx_t *ctx = arg;
+    bool last_pass = false;
+    while (!last_pass) {
+        last_pass = atomic_load(&s_writer_done);
+        uint32_t seq = core_state_snapshot_read(&s_snapshot, ctx->frame);
+        ++ctx->reads;
+        if (!consistent(ctx->frame) || ctx->frame->epoch_seconds != seq) {
+            ++ctx->torn;
+        }
+        if (seq < ctx->last_seq) {
+            ++ctx->regressions;
+        }
+        ctx->last_seq = seq;
+    }
+    return NULL;
+}
+
+static void test_empty_before_first_publication(void)
+{
+    setup();
+    core_link_state_frame_t *dst = alloc_frame(CAPACITY);
+    HOST_TEST_ASSERT_EQ(0, core_state_snapshot_read(&s_snapshot, dst));
+    HOST_TEST_ASSERT_EQ(0, dst->terrarium_count);
+    free(dst);
+}
+
+static void test_read_truncates_to_capacity(void)
+{
+    setup();
+    fill(core_state_snapshot_begin(&s_snapshot), 40);
+    core_state_snapshot_publish(&s_snapshot);
+    core_link_state_frame_t *dst = alloc_frame(4);
+    HOST_TEST_ASSERT_EQ(1, core_state_snapshot_read(&s_snapshot, dst));
+    HOST_TEST_ASSERT_EQ(4, dst->terrarium_count);
+    HOST_TEST_ASSERT_EQ(40, dst->epoch_seconds);
+    HOST_TEST_ASSERT(strcmp(dst->terrariums[3].common_name, "T3-40") == 0);
+    free(dst);
+}
+
+static void test_writer_alternates_buffers(void)
+{
+    setup();
+    core_link_state_frame_t *first = core_state_snapshot_begin(&s_snapshot);
+    core_state_snapshot_publish(&s_snapshot);
+    core_link_state_frame_t *second = core_state_snapshot_begin(&s_snapshot);
+    core_state_snapshot_publish(&s_snapshot);
+    // Never the published buffer, which readers may be copying.
+    HOST_TEST_ASSERT(first == s_frames[1]);
+    HOST_TEST_ASSERT(second == s_frames[0]);
+    HOST_TEST_ASSERT(core_state_snapshot_begin(&s_snapshot) == s_frames[1]);
+}
+
+static void test_concurrent_readers_never_see_torn_frames(void)
+{
+    setup();
+    reader_ctx_t readers[READER_COUNT];
+    pthread_t reader_threads[READER_COUNT];
+    memset(readers, 0, sizeof(readers));
+    for (size_t i = 0; i < READER_COUNT; ++i) {
+        readers[i].frame = alloc_frame(CAPACITY);
+        pthread_create(&reader_threads[i], NULL, reader_main, &readers[i]);
+    }
+    pthread_t writer;
+    pthread_create(&writer, NULL, writer_main, NULL);
+    pthread_join(writer, NULL);
+
+    uint32_t reads = 0;
+    uint32_t torn = 0;
+    uint32_t regressions = 0;
+    for (size_t i = 0; i < READER_COUNT; ++i) {
+        pthread_join(reader_threads[i], NULL);
+        reads += readers[i].reads;
+        torn += readers[i].torn;
+        regressions += readers[i].regressions;
+        free(readers[i].frame);
+    }
+    printf("  %u publications, %u reads by %u readers\n", PUBLICATIONS, reads, READER_COUNT);
+    HOST_TEST_ASSERT_EQ(0, torn);
+    HOST_TEST_ASSERT_EQ(0, regressions);
+    // Each reader made its final pass after the last publication.
+    for (size_t i = 0; i < READER_COUNT; ++i) {
+        HOST_TEST_ASSERT_EQ(PUBLICATIONS, readers[i].last_seq);
+    }
+}
+
+int main(void)
+{
+    HOST_TEST_RUN(test_empty_before_first_publication);
+    HOST_TEST_RUN(test_read_truncates_to_capacity);
+    HOST_TEST_RUN(test_writer_alternates_buffers);
+    HOST_TEST_RUN(test_concurrent_readers_never_see_torn_frames);
+    free(s_frames[0]);
+    free(s_frames[1]);
+    return HOST_TEST_EXIT();
+}
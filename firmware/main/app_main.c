@@ -17,7 +17,6 @@
 #include "sim/sim_engine.h"
 #include "tts/tts_stub.h"
 #include "ui/ui_root.h"
-#include "ui/ui_settings.h"
 #include "updates/updates_manager.h"
 
 #include "sdkconfig.h"
@@ -50,6 +49,7 @@ void app_main(void)
         .tx_gpio = CONFIG_APP_CORE_LINK_UART_TX_PIN,
         .rx_gpio = CONFIG_APP_CORE_LINK_UART_RX_PIN,
         .baud_rate = CONFIG_APP_CORE_LINK_UART_BAUD,
+        .baud_rate_max = CONFIG_APP_CORE_LINK_UART_BAUD_MAX,
         .task_stack_size = 4096,
         .task_priority = 6,
         .handshake_timeout_ticks = pdMS_TO_TICKS(CONFIG_APP_CORE_LINK_HANDSHAKE_TIMEOUT_MS),
@@ -173,8 +173,7 @@ static void handle_command_ack(core_link_command_opcode_t opcode, esp_err_t stat
         return;
     }
 
-    ui_settings_on_profiles_reload(status, terrarium_count);
-
+    // The settings screen tracks its own request; this hook only resyncs.
     if (status == ESP_OK || status == ESP_ERR_NOT_FOUND) {
         sim_engine_hint_remote_count(terrarium_count);
         if (core_link_is_ready()) {
@@ -1,36 +1,67 @@
 #include "link/core_link.h"
 
+#include <stdio.h>
 #include <string.h>
 
-#include "driver/uart.h"
+#include "compression_if.h"
 #include "esp_check.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/event_groups.h"
-#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "freertos/timers.h"
+#include "link/core_link_baseline.h"
+#include "link/core_link_baud.h"
+#include "link/core_link_clock.h"
+#include "link/core_link_compact.h"
+#include "link/core_link_fields.h"
+#include "link/core_link_fragment.h"
+#include "link/core_link_history.h"
+#include "link/core_link_name_table.h"
+#include "link/core_link_pending.h"
+#include "link/core_link_stats.h"
+#include "link/core_link_stream.h"
+#include "link/core_link_subscription.h"
+#include "link/core_link_touch.h"
+#include "link/core_link_transport.h"
+#ifdef ESP_PLATFORM
+#include "link/core_link_transport_uart.h"
+#endif
+#include "link/core_link_tx_queue.h"
 #include "sdkconfig.h"
 
-#define CORE_LINK_SOF 0xA5
-#define CORE_LINK_MAX_PAYLOAD 512
 #define CORE_LINK_EVENT_HANDSHAKE BIT0
-#define CORE_LINK_TOUCH_QUEUE_LENGTH 8
 #define CORE_LINK_TOUCH_DISPATCH_STACK 3072
-#define CORE_LINK_TOUCH_MAX_POINTS 5
+#define CORE_LINK_RX_RING_SIZE 2048
+// Absorbs a fragmented STATE_FULL burst while LVGL keeps the RX task busy.
+#define CORE_LINK_UART_RX_BUFFER_SIZE (CORE_LINK_MAX_PAYLOAD * 8)
+#define CORE_LINK_RX_STALL_MS 50U
+#define CORE_LINK_REORDER_SLOTS 4
+#define CORE_LINK_SEQ_GAP_TIMEOUT_TICKS pdMS_TO_TICKS(300)
+#define CORE_LINK_TX_SLOTS 16
+#define CORE_LINK_TX_TASK_STACK 3072
+#define CORE_LINK_TX_ENQUEUE_TIMEOUT_TICKS pdMS_TO_TICKS(200)
+#define CORE_LINK_RTT_PROBE_TICKS pdMS_TO_TICKS(CONFIG_APP_CORE_LINK_RTT_PROBE_INTERVAL_MS)
 
 static const char *TAG = "core_link";
 
-typedef struct __attribute__((packed)) {
-    uint8_t sof;
-    uint8_t type;
-    uint16_t length;
-} core_link_frame_header_t;
-
 typedef struct __attribute__((packed)) {
     uint8_t protocol_version;
     uint8_t capabilities;
+    uint8_t capabilities_ext;
+    uint16_t baud_mask; /* avec CORE_LINK_CAP_EXT_BAUD_SWITCH */
 } core_link_hello_ack_payload_t;
 
+typedef struct {
+    bool used;
+    uint8_t type;
+    uint16_t seq;
+    uint16_t length;
+    uint8_t payload[CORE_LINK_MAX_PAYLOAD];
+} core_link_parked_frame_t;
+
 typedef struct __attribute__((packed)) {
     uint16_t width;
     uint16_t height;
@@ -38,6 +69,10 @@ typedef struct __attribute__((packed)) {
 } core_link_display_ready_payload_t;
 
 static core_link_config_t s_config;
+static core_link_transport_t s_transport;
+#ifdef ESP_PLATFORM
+static core_link_uart_transport_t s_uart_transport;
+#endif
 static bool s_initialized = false;
 static bool s_started = false;
 static bool s_handshake_done = false;
@@ -51,6 +86,8 @@ static core_link_status_cb_t s_status_cb = NULL;
 static void *s_status_ctx = NULL;
 static core_link_command_ack_cb_t s_command_cb = NULL;
 static void *s_command_ctx = NULL;
+static core_link_history_cb_t s_history_cb = NULL;
+static void *s_history_ctx = NULL;
 static TimerHandle_t s_watchdog_timer = NULL;
 static TickType_t s_last_state_tick = 0;
 static TickType_t s_last_full_tick = 0;
@@ -60,45 +97,112 @@ static bool s_state_timeout_logged = false;
 static bool s_watchdog_triggered = false;
 static bool s_full_frame_received = false;
 static bool s_full_resync_pending = false;
-static QueueHandle_t s_touch_queue = NULL;
 static TaskHandle_t s_touch_dispatch_task = NULL;
-static portMUX_TYPE s_touch_queue_lock = portMUX_INITIALIZER_UNLOCKED;
-static core_link_touch_event_t s_touch_last_sent[CORE_LINK_TOUCH_MAX_POINTS] = {0};
-static bool s_touch_last_sent_valid[CORE_LINK_TOUCH_MAX_POINTS] = {0};
-static bool s_touch_active_expected[CORE_LINK_TOUCH_MAX_POINTS] = {0};
-static core_link_state_frame_t s_cached_state = {0};
+static core_link_touch_slots_t s_touch_slots;
+static bool s_peer_touch_batch = false;
+static core_link_state_frame_t *s_cached_state = NULL;
+static core_link_state_frame_t *s_rx_state = NULL;
 static bool s_cached_state_valid = false;
+static core_link_reassembly_t s_reassembly;
+static core_link_name_table_t *s_name_table = NULL;
+static bool s_name_table_valid = false;
+static uint16_t s_name_generation = 0;
+static uint8_t s_rx_storage[CORE_LINK_STREAM_STORAGE_SIZE(CORE_LINK_RX_RING_SIZE)];
+static bool s_frame_v2 = false;
+static uint16_t s_rx_expected_seq = 0;
+static uint16_t s_rx_nak_high = 0;
+static TickType_t s_rx_gap_tick = 0;
+static core_link_parked_frame_t s_parked[CORE_LINK_REORDER_SLOTS];
+// Resets asked for outside the RX task, which owns the sequence window, the
+// reassembly buffer and the cached baseline: it runs them before its next frame.
+#define CORE_LINK_RX_RESET_SEQ BIT0  /* sequence window, reassembly, cached baseline */
+#define CORE_LINK_RX_RESET_LINK BIT1 /* plus cached state, STATE_FULL baseline and name table */
+static portMUX_TYPE s_rx_reset_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_rx_reset_pending = 0;
+static size_t s_parked_count = 0;
+static core_link_tx_queue_t s_tx_queue;
+static portMUX_TYPE s_tx_queue_lock = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t s_tx_free = NULL;
+static TaskHandle_t s_tx_task = NULL;
+static core_link_stats_t s_stats;
+static core_link_stats_snapshot_t s_peer_stats;
+static bool s_peer_stats_valid = false;
+static TickType_t s_peer_stats_tick = 0;
+static portMUX_TYPE s_peer_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static TickType_t s_last_probe_tick = 0;
+static bool s_peer_sample_time = false;
+// Written by the RX task (PONG), read by the UI through core_link_get_clock_estimate().
+static core_link_clock_t s_clock;
+static portMUX_TYPE s_clock_lock = portMUX_INITIALIZER_UNLOCKED;
+// Sample time of the frame being decoded, already in the display clock (0 = unknown).
+static int64_t s_rx_sample_us = 0;
+static bool s_peer_full_compressed = false;
+static core_link_baseline_t s_full_baseline;
+static uint8_t *s_full_scratch = NULL;
+// Baud negotiation is driven by the core; we follow BAUD_SWITCH and undo it if the core goes quiet.
+static SemaphoreHandle_t s_transport_lock = NULL;
+static portMUX_TYPE s_baud_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint16_t s_baud_local_mask = 0;
+static bool s_peer_baud_switch = false;
+static uint32_t s_link_baud = 0;
+static uint32_t s_baud_previous_bps = 0;
+static bool s_baud_probe_active = false;
+static TickType_t s_baud_probe_tick = 0;
+// Commands awaiting their ACK; completions always run outside the lock.
+static portMUX_TYPE s_pending_lock = portMUX_INITIALIZER_UNLOCKED;
+static core_link_pending_t s_pending;
+static bool s_peer_request_id = false;
+// Last subscription asked for by the UI, replayed to the core after every handshake.
+static portMUX_TYPE s_subscription_lock = portMUX_INITIALIZER_UNLOCKED;
+static core_link_subscription_t s_subscription;
+static bool s_peer_subscribe = false;
+static bool s_peer_history = false;
 
 #define CORE_LINK_WATCHDOG_PERIOD_MS 250
+#define CORE_LINK_SUBSCRIBE_MAX_INTERVAL_MS (CONFIG_APP_CORE_LINK_STATE_TIMEOUT_MS / 4)
 #define CORE_LINK_STATE_TIMEOUT_TICKS pdMS_TO_TICKS(CONFIG_APP_CORE_LINK_STATE_TIMEOUT_MS)
 #define CORE_LINK_FULL_TIMEOUT_TICKS pdMS_TO_TICKS(CONFIG_APP_CORE_LINK_FULL_REFRESH_TIMEOUT_MS)
 #define CORE_LINK_PING_TIMEOUT_TICKS pdMS_TO_TICKS(CONFIG_APP_CORE_LINK_PING_TIMEOUT_MS)
+#define CORE_LINK_COMMAND_TIMEOUT_TICKS pdMS_TO_TICKS(CONFIG_APP_CORE_LINK_COMMAND_TIMEOUT_MS)
 #define CORE_LINK_WATCHDOG_PERIOD_TICKS pdMS_TO_TICKS(CORE_LINK_WATCHDOG_PERIOD_MS)
 
-static uint8_t checksum_compute(uint8_t type, uint16_t length, const uint8_t *payload);
-static esp_err_t uart_send_frame(core_link_msg_type_t type, const void *payload, uint16_t length);
+static esp_err_t send_frame(core_link_msg_type_t type, const void *payload, uint16_t length);
+static esp_err_t tx_enqueue(core_link_msg_type_t type, const void *payload, uint16_t length,
+                            core_link_tx_priority_t priority);
+static void tx_task(void *arg);
 static void rx_task(void *arg);
-static esp_err_t handle_state_full_frame(const uint8_t *payload, uint16_t length);
-static esp_err_t handle_state_delta_frame(const uint8_t *payload, uint16_t length);
+static void *alloc_link_buffer(size_t size);
+static esp_err_t handle_state_full_frame(const uint8_t *payload, size_t length);
+static esp_err_t handle_state_full_compact_frame(const uint8_t *payload, size_t length);
+static esp_err_t handle_state_delta_frame(const uint8_t *payload, size_t length, bool compact);
+static void commit_rx_state(void);
+static esp_err_t handle_name_table_frame(const uint8_t *payload, size_t length);
+static esp_err_t resolve_snapshot_names(core_link_terrarium_snapshot_t *snap, core_link_delta_field_mask_t mask);
+static esp_err_t dispatch_state_frame(uint8_t type, const uint8_t *payload, size_t length);
 static void dispatch_frame(core_link_msg_type_t type, const uint8_t *payload, uint16_t length);
+static void handle_sequenced_frame(const core_link_stream_frame_t *frame);
+static void rx_seq_reset(void);
+static void rx_request_reset(uint32_t what);
+static void rx_run_pending_resets(void);
+static void rx_seq_check_gap(void);
 static void update_link_alive(bool alive);
+static void apply_link_baud(uint32_t bits_per_second);
+static void handle_baud_switch(const uint8_t *payload, uint16_t length);
+static void baud_confirm(void);
+static void baud_probe_check(TickType_t now);
+static void baud_fall_back(void);
 static void watchdog_timer_cb(TimerHandle_t timer);
+static void pending_complete(const core_link_pending_entry_t *entry, esp_err_t status, uint8_t terrarium_count);
+static void pending_expire(TickType_t now);
+static void pending_fail_all(esp_err_t status);
+static esp_err_t send_subscription(void);
 static void touch_dispatch_task(void *arg);
-static void touch_queue_reset(void);
+static esp_err_t send_ping(void);
+static void handle_pong(const uint8_t *payload, uint16_t length);
+static void handle_link_stats(const uint8_t *payload, uint16_t length);
+static void handle_history_chunk(const uint8_t *payload, uint16_t length);
 static core_link_terrarium_snapshot_t *find_cached_snapshot(core_link_state_frame_t *frame, uint8_t terrarium_id);
 
-static void touch_queue_reset(void)
-{
-    portENTER_CRITICAL(&s_touch_queue_lock);
-    if (s_touch_queue) {
-        xQueueReset(s_touch_queue);
-    }
-    memset(s_touch_last_sent, 0, sizeof(s_touch_last_sent));
-    memset(s_touch_last_sent_valid, 0, sizeof(s_touch_last_sent_valid));
-    memset(s_touch_active_expected, 0, sizeof(s_touch_active_expected));
-    portEXIT_CRITICAL(&s_touch_queue_lock);
-}
-
 esp_err_t core_link_init(const core_link_config_t *config)
 {
     ESP_RETURN_ON_FALSE(config, ESP_ERR_INVALID_ARG, TAG, "config is null");
@@ -114,38 +218,102 @@ esp_err_t core_link_init(const core_link_config_t *config)
         s_config.task_priority = 5;
     }
 
-    uart_config_t uart_cfg = {
-        .baud_rate = s_config.baud_rate,
-        .data_bits = UART_DATA_8_BITS,
-        .parity = UART_PARITY_DISABLE,
-        .stop_bits = UART_STOP_BITS_1,
-        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
-        .source_clk = UART_SCLK_REF_TICK,
-    };
-
-    ESP_RETURN_ON_ERROR(uart_driver_install(s_config.uart_port, CORE_LINK_MAX_PAYLOAD * 2, 0, 0, NULL, 0), TAG, "uart_driver_install failed");
-    ESP_RETURN_ON_ERROR(uart_param_config(s_config.uart_port, &uart_cfg), TAG, "uart_param_config failed");
-    ESP_RETURN_ON_ERROR(uart_set_pin(s_config.uart_port, s_config.tx_gpio, s_config.rx_gpio, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE), TAG, "uart_set_pin failed");
+    if (s_config.transport) {
+        s_transport = *s_config.transport;
+    } else {
+#ifdef ESP_PLATFORM
+        core_link_uart_transport_config_t uart_cfg = {
+            .uart_port = s_config.uart_port,
+            .tx_gpio = s_config.tx_gpio,
+            .rx_gpio = s_config.rx_gpio,
+            .baud_rate = s_config.baud_rate,
+            .rx_buffer_size = CORE_LINK_UART_RX_BUFFER_SIZE,
+        };
+        ESP_RETURN_ON_ERROR(core_link_transport_uart_open(&s_transport, &s_uart_transport, &uart_cfg), TAG, "UART transport init failed");
+#else
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_ARG, TAG, "no transport configured");
+#endif
+    }
 
     if (!s_events) {
         s_events = xEventGroupCreate();
         ESP_RETURN_ON_FALSE(s_events, ESP_ERR_NO_MEM, TAG, "event group alloc failed");
     }
 
+    if (!s_transport_lock) {
+        s_transport_lock = xSemaphoreCreateMutex();
+        ESP_RETURN_ON_FALSE(s_transport_lock, ESP_ERR_NO_MEM, TAG, "transport lock alloc failed");
+    }
+
     if (!s_watchdog_timer) {
         s_watchdog_timer = xTimerCreate("core_link_wd", CORE_LINK_WATCHDOG_PERIOD_TICKS, pdTRUE, NULL, watchdog_timer_cb);
         ESP_RETURN_ON_FALSE(s_watchdog_timer, ESP_ERR_NO_MEM, TAG, "watchdog timer alloc failed");
     }
 
-    if (!s_touch_queue) {
-        s_touch_queue = xQueueCreate(CORE_LINK_TOUCH_QUEUE_LENGTH, sizeof(core_link_touch_event_t));
-        ESP_RETURN_ON_FALSE(s_touch_queue, ESP_ERR_NO_MEM, TAG, "touch queue alloc failed");
+    core_link_touch_slots_init(&s_touch_slots);
+
+    if (!s_tx_free) {
+        core_link_tx_slot_t *slots = alloc_link_buffer(CORE_LINK_TX_SLOTS * sizeof(core_link_tx_slot_t));
+        ESP_RETURN_ON_FALSE(slots, ESP_ERR_NO_MEM, TAG, "tx queue alloc failed");
+        core_link_tx_queue_init(&s_tx_queue, slots, CORE_LINK_TX_SLOTS);
+        s_tx_free = xSemaphoreCreateCounting(CORE_LINK_TX_SLOTS, CORE_LINK_TX_SLOTS);
+        ESP_RETURN_ON_FALSE(s_tx_free, ESP_ERR_NO_MEM, TAG, "tx semaphore alloc failed");
+    }
+
+    // Decoded state is double-buffered so a rejected frame never corrupts the cache.
+    if (!s_cached_state) {
+        s_cached_state = alloc_link_buffer(CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS));
+        ESP_RETURN_ON_FALSE(s_cached_state, ESP_ERR_NO_MEM, TAG, "state cache alloc failed");
+        core_link_state_frame_init(s_cached_state, CORE_LINK_MAX_TERRARIUMS);
+    }
+    if (!s_rx_state) {
+        s_rx_state = alloc_link_buffer(CORE_LINK_STATE_FRAME_SIZE(CORE_LINK_MAX_TERRARIUMS));
+        ESP_RETURN_ON_FALSE(s_rx_state, ESP_ERR_NO_MEM, TAG, "state frame alloc failed");
+        core_link_state_frame_init(s_rx_state, CORE_LINK_MAX_TERRARIUMS);
+    }
+    if (!s_reassembly.buffer) {
+        uint8_t *buffer = alloc_link_buffer(CORE_LINK_STATE_BUFFER_SIZE);
+        ESP_RETURN_ON_FALSE(buffer, ESP_ERR_NO_MEM, TAG, "reassembly buffer alloc failed");
+        core_link_reassembly_init(&s_reassembly, buffer, CORE_LINK_STATE_BUFFER_SIZE);
+    }
+    if (!s_full_scratch) {
+        s_full_scratch = alloc_link_buffer(CORE_LINK_STATE_BUFFER_SIZE);
+        ESP_RETURN_ON_FALSE(s_full_scratch, ESP_ERR_NO_MEM, TAG, "full scratch alloc failed");
+        uint8_t *baseline = alloc_link_buffer(CORE_LINK_STATE_BUFFER_SIZE);
+        ESP_RETURN_ON_FALSE(baseline, ESP_ERR_NO_MEM, TAG, "full baseline alloc failed");
+        core_link_baseline_init(&s_full_baseline, baseline, CORE_LINK_STATE_BUFFER_SIZE);
+    }
+    if (!s_name_table) {
+        s_name_table = alloc_link_buffer(sizeof(*s_name_table));
+        ESP_RETURN_ON_FALSE(s_name_table, ESP_ERR_NO_MEM, TAG, "name table alloc failed");
     }
-    touch_queue_reset();
+    s_name_table_valid = false;
+    core_link_stats_reset(&s_stats);
+    core_link_clock_reset(&s_clock);
+    s_peer_sample_time = false;
+    s_peer_full_compressed = false;
+    core_link_baseline_reset(&s_full_baseline);
+    s_peer_stats_valid = false;
+    s_link_baud = (uint32_t)s_config.baud_rate;
+    core_link_stats_set(&s_stats, CORE_LINK_STAT_BAUD_RATE, s_link_baud);
+    s_baud_local_mask = 0;
+    if (s_config.baud_rate_max > s_config.baud_rate && s_transport.ops->set_baud &&
+        core_link_baud_index(s_link_baud) != CORE_LINK_BAUD_INDEX_NONE) {
+        s_baud_local_mask = core_link_baud_mask(s_link_baud, (uint32_t)s_config.baud_rate_max);
+    }
+    s_peer_baud_switch = false;
+    s_baud_probe_active = false;
+    s_peer_request_id = false;
+    core_link_pending_init(&s_pending);
+    s_peer_subscribe = false;
+    core_link_subscription_all(&s_subscription);
+    s_peer_history = false;
+    s_rx_reset_pending = 0;
 
     s_last_state_tick = xTaskGetTickCount();
     s_last_full_tick = s_last_state_tick;
     s_last_ping_tick = s_last_state_tick;
+    s_last_probe_tick = s_last_state_tick;
     s_ping_in_flight = false;
     s_state_timeout_logged = false;
     s_watchdog_triggered = false;
@@ -165,6 +333,11 @@ esp_err_t core_link_start(void)
         return ESP_OK;
     }
 
+    if (!s_tx_task) {
+        BaseType_t tx_ok = xTaskCreatePinnedToCore(tx_task, "core_link_tx", CORE_LINK_TX_TASK_STACK, NULL,
+                                                   s_config.task_priority, &s_tx_task, 0);
+        ESP_RETURN_ON_FALSE(tx_ok == pdPASS, ESP_ERR_NO_MEM, TAG, "tx task creation failed");
+    }
     BaseType_t task_ok = xTaskCreatePinnedToCore(rx_task, "core_link_rx", s_config.task_stack_size, NULL, s_config.task_priority, &s_rx_task, 0);
     ESP_RETURN_ON_FALSE(task_ok == pdPASS, ESP_ERR_NO_MEM, TAG, "rx task creation failed");
 
@@ -207,141 +380,29 @@ esp_err_t core_link_register_command_ack_callback(core_link_command_ack_cb_t cb,
     return ESP_OK;
 }
 
+esp_err_t core_link_register_history_callback(core_link_history_cb_t cb, void *ctx)
+{
+    s_history_cb = cb;
+    s_history_ctx = ctx;
+    return ESP_OK;
+}
+
 esp_err_t core_link_queue_touch_event(const core_link_touch_event_t *event)
 {
     ESP_RETURN_ON_FALSE(event, ESP_ERR_INVALID_ARG, TAG, "touch event null");
+    ESP_RETURN_ON_FALSE(s_initialized, ESP_ERR_INVALID_STATE, TAG, "core link not ready");
 
-    ESP_RETURN_ON_FALSE(s_initialized && s_touch_queue, ESP_ERR_INVALID_STATE, TAG, "core link not ready");
-
-    uint8_t id = event->point_id;
-    if (id >= CORE_LINK_TOUCH_MAX_POINTS) {
-        return ESP_OK;
-    }
-
-    core_link_touch_event_t normalized = *event;
-
-    portENTER_CRITICAL(&s_touch_queue_lock);
-
-    bool drop_event = false;
-    bool prev_expected = s_touch_active_expected[id];
-    bool expected_after = prev_expected;
-
-    switch (event->type) {
-        case CORE_LINK_TOUCH_DOWN:
-            if (prev_expected) {
-                normalized.type = CORE_LINK_TOUCH_MOVE;
-                expected_after = prev_expected;
-            } else {
-                normalized.type = CORE_LINK_TOUCH_DOWN;
-                expected_after = true;
-            }
-            break;
-        case CORE_LINK_TOUCH_MOVE:
-            if (!prev_expected) {
-                normalized.type = CORE_LINK_TOUCH_DOWN;
-                expected_after = true;
-            } else {
-                normalized.type = CORE_LINK_TOUCH_MOVE;
-                expected_after = prev_expected;
-            }
-            break;
-        case CORE_LINK_TOUCH_UP:
-            if (!prev_expected) {
-                drop_event = true;
-                normalized.type = CORE_LINK_TOUCH_UP;
-                expected_after = prev_expected;
-            } else {
-                normalized.type = CORE_LINK_TOUCH_UP;
-                expected_after = false;
-            }
-            break;
-        default:
-            drop_event = true;
-            break;
-    }
-
-    core_link_touch_event_t queue_buffer[CORE_LINK_TOUCH_QUEUE_LENGTH] = {0};
-    size_t queue_len = 0;
-    while (queue_len < CORE_LINK_TOUCH_QUEUE_LENGTH && s_touch_queue &&
-           xQueueReceive(s_touch_queue, &queue_buffer[queue_len], 0) == pdTRUE) {
-        queue_len++;
-    }
-
-    bool coalesced = false;
-
-    if (!drop_event) {
-        for (size_t i = 0; i < queue_len; ++i) {
-            core_link_touch_event_t *existing = &queue_buffer[i];
-            if (existing->point_id != id) {
-                continue;
-            }
-            if (existing->type == normalized.type) {
-                if (existing->x == normalized.x && existing->y == normalized.y) {
-                    drop_event = true;
-                } else {
-                    *existing = normalized;
-                    coalesced = true;
-                }
-                break;
-            }
-        }
-    }
-
-    if (!drop_event && queue_len == 0 && s_touch_last_sent_valid[id] &&
-        s_touch_last_sent[id].type == normalized.type && s_touch_last_sent[id].x == normalized.x &&
-        s_touch_last_sent[id].y == normalized.y) {
-        drop_event = true;
-    }
-
-    if (!drop_event && !coalesced) {
-        if (queue_len == CORE_LINK_TOUCH_QUEUE_LENGTH) {
-            bool removed = false;
-            for (size_t i = 0; i < queue_len; ++i) {
-                if (queue_buffer[i].point_id == id) {
-                    for (size_t j = i; j + 1 < queue_len; ++j) {
-                        queue_buffer[j] = queue_buffer[j + 1];
-                    }
-                    queue_len--;
-                    removed = true;
-                    break;
-                }
-            }
-            if (!removed && queue_len > 0) {
-                for (size_t j = 0; j + 1 < queue_len; ++j) {
-                    queue_buffer[j] = queue_buffer[j + 1];
-                }
-                queue_len--;
-            }
-        }
-        if (queue_len < CORE_LINK_TOUCH_QUEUE_LENGTH) {
-            queue_buffer[queue_len++] = normalized;
-        } else {
-            drop_event = true;
-        }
+    // Called for every I2C sample: only the point's slot and the dirty bitmap are touched.
+    if (core_link_touch_slots_update(&s_touch_slots, event) && s_touch_dispatch_task) {
+        xTaskNotifyGive(s_touch_dispatch_task);
     }
-
-    for (size_t i = 0; i < queue_len; ++i) {
-        if (s_touch_queue && xQueueSend(s_touch_queue, &queue_buffer[i], 0) != pdTRUE) {
-            ESP_LOGW(TAG, "Touch queue overflow");
-            drop_event = true;
-        }
-    }
-
-    if (!drop_event) {
-        s_touch_active_expected[id] = expected_after;
-    } else {
-        s_touch_active_expected[id] = prev_expected;
-    }
-
-    portEXIT_CRITICAL(&s_touch_queue_lock);
-
     return ESP_OK;
 }
 
 esp_err_t core_link_send_touch_event(const core_link_touch_event_t *event)
 {
     ESP_RETURN_ON_FALSE(event, ESP_ERR_INVALID_ARG, TAG, "touch event null");
-    return uart_send_frame(CORE_LINK_MSG_TOUCH_EVENT, event, sizeof(*event));
+    return send_frame(CORE_LINK_MSG_TOUCH_EVENT, event, sizeof(*event));
 }
 
 esp_err_t core_link_send_display_ready(void)
@@ -351,43 +412,79 @@ esp_err_t core_link_send_display_ready(void)
         .height = 600,
         .protocol_version = CORE_LINK_PROTOCOL_VERSION,
     };
-    return uart_send_frame(CORE_LINK_MSG_DISPLAY_READY, &payload, sizeof(payload));
+    return send_frame(CORE_LINK_MSG_DISPLAY_READY, &payload, sizeof(payload));
 }
 
 esp_err_t core_link_request_state_sync(void)
 {
-    s_cached_state_valid = false;
+    rx_request_reset(CORE_LINK_RX_RESET_SEQ);
     if (s_started) {
         TickType_t now = xTaskGetTickCount();
         s_last_full_tick = now;
     }
     s_full_frame_received = false;
-    esp_err_t err = uart_send_frame(CORE_LINK_MSG_REQUEST_STATE, NULL, 0);
+    // Without a usable name table the core must resend it before the baseline; a
+    // link reset the RX task has not run yet drops it too.
+    portENTER_CRITICAL(&s_rx_reset_lock);
+    bool names_valid = s_name_table_valid && !(s_rx_reset_pending & CORE_LINK_RX_RESET_LINK);
+    portEXIT_CRITICAL(&s_rx_reset_lock);
+    uint8_t flags = names_valid ? 0 : CORE_LINK_REQUEST_STATE_NAMES;
+    esp_err_t err = send_frame(CORE_LINK_MSG_REQUEST_STATE, &flags, sizeof(flags));
     if (err == ESP_OK) {
         s_full_resync_pending = true;
+        core_link_stats_add(&s_stats, CORE_LINK_STAT_RESYNCS, 1);
     }
     return err;
 }
 
 esp_err_t core_link_send_command(core_link_command_opcode_t opcode, const char *argument)
 {
-    ESP_RETURN_ON_FALSE(s_started, ESP_ERR_INVALID_STATE, TAG, "link not started");
+    return core_link_send_command_async(opcode, argument, 0, NULL, NULL, NULL);
+}
 
-    core_link_command_payload_t payload = {
-        .opcode = (uint8_t)opcode,
-        .argument = {0},
-    };
+esp_err_t core_link_send_command_async(core_link_command_opcode_t opcode, const char *argument,
+                                       TickType_t timeout_ticks, core_link_pending_cb_t cb, void *ctx,
+                                       uint16_t *out_request_id)
+{
+    ESP_RETURN_ON_FALSE(s_started, ESP_ERR_INVALID_STATE, TAG, "link not started");
 
-    uint16_t payload_len = 1;
+    if (timeout_ticks == 0) {
+        timeout_ticks = CORE_LINK_COMMAND_TIMEOUT_TICKS;
+    }
+    portENTER_CRITICAL(&s_pending_lock);
+    uint16_t request_id =
+        core_link_pending_add(&s_pending, (uint8_t)opcode, (uint32_t)xTaskGetTickCount(), (uint32_t)timeout_ticks, cb, ctx);
+    portEXIT_CRITICAL(&s_pending_lock);
+    ESP_RETURN_ON_FALSE(request_id != CORE_LINK_REQUEST_ID_NONE, ESP_ERR_NO_MEM, TAG,
+                        "too many commands in flight (%d)", CORE_LINK_PENDING_MAX);
+
+    uint8_t payload[1 + CORE_LINK_REQUEST_ID_SIZE + CORE_LINK_COMMAND_MAX_ARG_LEN];
+    uint16_t payload_len = 0;
+    payload[payload_len++] = (uint8_t)opcode;
+    // Cores without request IDs expect the argument right after the opcode.
+    if (s_peer_request_id) {
+        payload[payload_len++] = (uint8_t)(request_id & 0xFF);
+        payload[payload_len++] = (uint8_t)(request_id >> 8);
+    }
     if (argument && argument[0] != '\0') {
-        strlcpy(payload.argument, argument, sizeof(payload.argument));
-        size_t arg_len = strnlen(payload.argument, sizeof(payload.argument));
-        if (arg_len > 0) {
-            payload_len = (uint16_t)(1 + arg_len + 1);
-        }
+        size_t arg_len = strnlen(argument, CORE_LINK_COMMAND_MAX_ARG_LEN - 1);
+        memcpy(&payload[payload_len], argument, arg_len);
+        payload_len += (uint16_t)arg_len;
+        payload[payload_len++] = '\0';
     }
 
-    return uart_send_frame(CORE_LINK_MSG_COMMAND, &payload, payload_len);
+    esp_err_t err = send_frame(CORE_LINK_MSG_COMMAND, payload, payload_len);
+    if (err != ESP_OK) {
+        // Never sent: the caller gets the error, not a later completion.
+        portENTER_CRITICAL(&s_pending_lock);
+        core_link_pending_take(&s_pending, request_id, NULL);
+        portEXIT_CRITICAL(&s_pending_lock);
+        return err;
+    }
+    if (out_request_id) {
+        *out_request_id = request_id;
+    }
+    return ESP_OK;
 }
 
 esp_err_t core_link_request_profile_reload(const char *base_path)
@@ -395,6 +492,66 @@ esp_err_t core_link_request_profile_reload(const char *base_path)
     return core_link_send_command(CORE_LINK_CMD_RELOAD_PROFILES, base_path);
 }
 
+esp_err_t core_link_request_profile_reload_async(const char *base_path, core_link_pending_cb_t cb, void *ctx)
+{
+    return core_link_send_command_async(CORE_LINK_CMD_RELOAD_PROFILES, base_path, 0, cb, ctx, NULL);
+}
+
+esp_err_t core_link_request_feeding(uint8_t terrarium_id)
+{
+    // Full argument size: send_command reads up to CORE_LINK_COMMAND_MAX_ARG_LEN bytes.
+    char argument[CORE_LINK_COMMAND_MAX_ARG_LEN];
+    snprintf(argument, sizeof(argument), "%u", (unsigned)terrarium_id);
+    return core_link_send_command(CORE_LINK_CMD_FEED_TERRARIUM, argument);
+}
+
+esp_err_t core_link_request_history(const core_link_history_request_t *request)
+{
+    ESP_RETURN_ON_FALSE(request, ESP_ERR_INVALID_ARG, TAG, "history request null");
+    ESP_RETURN_ON_FALSE(s_started && s_handshake_done, ESP_ERR_INVALID_STATE, TAG, "link not ready");
+    if (!s_peer_history) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    uint8_t payload[CORE_LINK_HISTORY_REQUEST_SIZE];
+    size_t length = core_link_history_request_encode(request, payload, sizeof(payload));
+    return send_frame(CORE_LINK_MSG_HISTORY_REQUEST, payload, (uint16_t)length);
+}
+
+esp_err_t core_link_subscribe(const core_link_subscription_t *subscription)
+{
+    ESP_RETURN_ON_FALSE(subscription, ESP_ERR_INVALID_ARG, TAG, "subscription null");
+    ESP_RETURN_ON_FALSE(s_initialized, ESP_ERR_INVALID_STATE, TAG, "core_link_init not called");
+
+    core_link_subscription_t sub = *subscription;
+    if (sub.min_interval_ms > CORE_LINK_SUBSCRIBE_MAX_INTERVAL_MS) {
+        sub.min_interval_ms = CORE_LINK_SUBSCRIBE_MAX_INTERVAL_MS;
+    }
+    portENTER_CRITICAL(&s_subscription_lock);
+    s_subscription = sub;
+    portEXIT_CRITICAL(&s_subscription_lock);
+
+    if (!s_started || !s_handshake_done) {
+        return ESP_OK; // goes out with the handshake
+    }
+    return send_subscription();
+}
+
+static esp_err_t send_subscription(void)
+{
+    if (!s_peer_subscribe) {
+        return ESP_OK;
+    }
+    core_link_subscription_t sub;
+    portENTER_CRITICAL(&s_subscription_lock);
+    sub = s_subscription;
+    portEXIT_CRITICAL(&s_subscription_lock);
+
+    uint8_t payload[CORE_LINK_SUBSCRIBE_HEADER_SIZE + CORE_LINK_MAX_TERRARIUMS];
+    size_t length = core_link_subscription_encode(&sub, payload, sizeof(payload));
+    ESP_RETURN_ON_FALSE(length > 0, ESP_ERR_INVALID_SIZE, TAG, "subscription lists too many terrariums");
+    return send_frame(CORE_LINK_MSG_SUBSCRIBE, payload, (uint16_t)length);
+}
+
 esp_err_t core_link_wait_for_handshake(TickType_t ticks_to_wait)
 {
     ESP_RETURN_ON_FALSE(s_started, ESP_ERR_INVALID_STATE, TAG, "core_link_start not called");
@@ -415,35 +572,279 @@ uint8_t core_link_get_peer_version(void)
     return s_peer_version;
 }
 
-static uint8_t checksum_compute(uint8_t type, uint16_t length, const uint8_t *payload)
+static void *alloc_link_buffer(size_t size)
 {
-    uint32_t sum = type + (length & 0xFF) + (length >> 8);
-    if (payload && length) {
-        for (uint16_t i = 0; i < length; ++i) {
-            sum += payload[i];
-        }
+    void *buffer = heap_caps_calloc(1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!buffer) {
+        buffer = heap_caps_calloc(1, size, MALLOC_CAP_8BIT);
     }
-    return (uint8_t)(sum & 0xFF);
+    return buffer;
 }
 
-static esp_err_t uart_send_frame(core_link_msg_type_t type, const void *payload, uint16_t length)
+static esp_err_t send_frame(core_link_msg_type_t type, const void *payload, uint16_t length)
+{
+    return tx_enqueue(type, payload, length, core_link_tx_priority_for(type));
+}
+
+static esp_err_t tx_enqueue(core_link_msg_type_t type, const void *payload, uint16_t length,
+                            core_link_tx_priority_t priority)
 {
     ESP_RETURN_ON_FALSE(s_started, ESP_ERR_INVALID_STATE, TAG, "link not started");
-    core_link_frame_header_t header = {
-        .sof = CORE_LINK_SOF,
-        .type = (uint8_t)type,
-        .length = length,
-    };
-    uint8_t checksum = checksum_compute(header.type, header.length, payload);
+    // The timer service task (watchdog ping) must never block on a full queue.
+    TickType_t wait = xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle() ? 0 : CORE_LINK_TX_ENQUEUE_TIMEOUT_TICKS;
+    if (xSemaphoreTake(s_tx_free, wait) != pdTRUE) {
+        portENTER_CRITICAL(&s_tx_queue_lock);
+        core_link_tx_queue_note_drop(&s_tx_queue, priority);
+        portEXIT_CRITICAL(&s_tx_queue_lock);
+        core_link_stats_add(&s_stats, CORE_LINK_STAT_TX_DROPPED, 1);
+        ESP_LOGW(TAG, "TX queue full, dropping frame 0x%02x", (unsigned)type);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    portENTER_CRITICAL(&s_tx_queue_lock);
+    core_link_tx_slot_t *slot = core_link_tx_queue_acquire(&s_tx_queue);
+    portEXIT_CRITICAL(&s_tx_queue_lock);
+    if (!slot) {
+        xSemaphoreGive(s_tx_free);
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Serialised outside the critical section, straight into the buffer the TX task writes.
+    // The display never sequences its own frames: v2 frames carry seq 0.
+    size_t written = s_frame_v2 ? core_link_frame_encode_v2(slot->data, sizeof(slot->data), (uint8_t)type, 0, payload, length)
+                                : core_link_frame_encode(slot->data, sizeof(slot->data), (uint8_t)type, payload, length);
+    portENTER_CRITICAL(&s_tx_queue_lock);
+    if (written == 0) {
+        core_link_tx_queue_abort(&s_tx_queue, slot);
+    } else {
+        slot->length = (uint16_t)written;
+        core_link_tx_queue_push(&s_tx_queue, slot, priority, esp_timer_get_time());
+    }
+    portEXIT_CRITICAL(&s_tx_queue_lock);
+    if (written == 0) {
+        xSemaphoreGive(s_tx_free);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    xTaskNotifyGive(s_tx_task);
+    return ESP_OK;
+}
+
+static void tx_task(void *arg)
+{
+    (void)arg;
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (true) {
+            portENTER_CRITICAL(&s_tx_queue_lock);
+            core_link_tx_slot_t *slot = core_link_tx_queue_pop(&s_tx_queue);
+            portEXIT_CRITICAL(&s_tx_queue_lock);
+            if (!slot) {
+                break;
+            }
+            // Sole writer of the UART: one contiguous write per frame.
+            xSemaphoreTake(s_transport_lock, portMAX_DELAY);
+            core_link_transport_write(&s_transport, slot->data, slot->length);
+            xSemaphoreGive(s_transport_lock);
+            core_link_stats_add(&s_stats, CORE_LINK_STAT_FRAMES_TX, 1);
+            core_link_stats_add(&s_stats, CORE_LINK_STAT_BYTES_TX, slot->length);
+            portENTER_CRITICAL(&s_tx_queue_lock);
+            core_link_tx_queue_complete(&s_tx_queue, slot, esp_timer_get_time());
+            portEXIT_CRITICAL(&s_tx_queue_lock);
+            xSemaphoreGive(s_tx_free);
+        }
+    }
+}
+
+esp_err_t core_link_get_tx_stats(core_link_tx_stats_t *out_stats)
+{
+    ESP_RETURN_ON_FALSE(out_stats, ESP_ERR_INVALID_ARG, TAG, "stats null");
+    ESP_RETURN_ON_FALSE(s_initialized, ESP_ERR_INVALID_STATE, TAG, "core_link_init not called");
+    portENTER_CRITICAL(&s_tx_queue_lock);
+    *out_stats = s_tx_queue.stats;
+    portEXIT_CRITICAL(&s_tx_queue_lock);
+    return ESP_OK;
+}
+
+esp_err_t core_link_get_link_stats(core_link_stats_snapshot_t *out_stats)
+{
+    ESP_RETURN_ON_FALSE(out_stats, ESP_ERR_INVALID_ARG, TAG, "stats null");
+    // Static block: readable (all zeros) even when the link never started.
+    core_link_stats_snapshot(&s_stats, (uint32_t)(esp_timer_get_time() / 1000LL), out_stats);
+    return ESP_OK;
+}
 
-    uart_write_bytes(s_config.uart_port, (const char *)&header, sizeof(header));
-    if (payload && length > 0) {
-        uart_write_bytes(s_config.uart_port, (const char *)payload, length);
+esp_err_t core_link_get_peer_link_stats(core_link_stats_snapshot_t *out_stats, uint32_t *out_age_ms)
+{
+    ESP_RETURN_ON_FALSE(out_stats, ESP_ERR_INVALID_ARG, TAG, "stats null");
+    portENTER_CRITICAL(&s_peer_stats_lock);
+    bool valid = s_peer_stats_valid;
+    if (valid) {
+        *out_stats = s_peer_stats;
+    }
+    TickType_t received = s_peer_stats_tick;
+    portEXIT_CRITICAL(&s_peer_stats_lock);
+    if (!valid) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (out_age_ms) {
+        *out_age_ms = (uint32_t)((xTaskGetTickCount() - received) * portTICK_PERIOD_MS);
     }
-    uart_write_bytes(s_config.uart_port, (const char *)&checksum, sizeof(checksum));
     return ESP_OK;
 }
 
+static esp_err_t send_ping(void)
+{
+    // The core echoes the payload: the PONG carries our send time back.
+    uint32_t now_us = (uint32_t)esp_timer_get_time();
+    uint8_t payload[CORE_LINK_PING_TIMESTAMP_SIZE] = {
+        (uint8_t)now_us, (uint8_t)(now_us >> 8), (uint8_t)(now_us >> 16), (uint8_t)(now_us >> 24),
+    };
+    return send_frame(CORE_LINK_MSG_PING, payload, sizeof(payload));
+}
+
+static void handle_pong(const uint8_t *payload, uint16_t length)
+{
+    if (length < CORE_LINK_PING_TIMESTAMP_SIZE) {
+        return;
+    }
+    uint32_t sent_us = (uint32_t)payload[0] | ((uint32_t)payload[1] << 8) | ((uint32_t)payload[2] << 16) |
+                       ((uint32_t)payload[3] << 24);
+    int64_t now_us = esp_timer_get_time();
+    uint32_t rtt_us = (uint32_t)now_us - sent_us;
+    core_link_stats_record_rtt(&s_stats, rtt_us);
+    if (length < CORE_LINK_PING_TIMESTAMP_SIZE + CORE_LINK_PONG_CLOCK_SIZE) {
+        return; // Older core: plain echo, no clock
+    }
+    int64_t core_us = (int64_t)core_link_get_le64(payload + CORE_LINK_PING_TIMESTAMP_SIZE);
+    portENTER_CRITICAL(&s_clock_lock);
+    core_link_clock_add_sample(&s_clock, now_us - rtt_us, core_us, now_us);
+    portEXIT_CRITICAL(&s_clock_lock);
+}
+
+esp_err_t core_link_get_clock_estimate(core_link_clock_estimate_t *out_estimate)
+{
+    ESP_RETURN_ON_FALSE(out_estimate, ESP_ERR_INVALID_ARG, TAG, "estimate null");
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_clock_lock);
+    core_link_clock_get(&s_clock, now_us, out_estimate);
+    portEXIT_CRITICAL(&s_clock_lock);
+    return out_estimate->synced ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+void core_link_record_display_latency(int64_t sample_us)
+{
+    if (sample_us <= 0) {
+        return;
+    }
+    int64_t latency_us = esp_timer_get_time() - sample_us;
+    // A negative age only means the clock estimate is off by more than the latency.
+    if (latency_us >= 0 && latency_us <= UINT32_MAX) {
+        core_link_stats_record_latency(&s_stats, (uint32_t)latency_us);
+    }
+}
+
+static void handle_link_stats(const uint8_t *payload, uint16_t length)
+{
+    core_link_stats_snapshot_t report;
+    if (!core_link_stats_decode(payload, length, &report)) {
+        ESP_LOGW(TAG, "Malformed LINK_STATS (%u bytes)", (unsigned)length);
+        return;
+    }
+    portENTER_CRITICAL(&s_peer_stats_lock);
+    s_peer_stats = report;
+    s_peer_stats_valid = true;
+    s_peer_stats_tick = xTaskGetTickCount();
+    portEXIT_CRITICAL(&s_peer_stats_lock);
+}
+
+static void handle_history_chunk(const uint8_t *payload, uint16_t length)
+{
+    core_link_history_chunk_t chunk;
+    if (!core_link_history_chunk_decode(payload, length, &chunk)) {
+        ESP_LOGW(TAG, "Malformed HISTORY_CHUNK (%u bytes)", (unsigned)length);
+        return;
+    }
+    if (s_history_cb) {
+        s_history_cb(&chunk, s_history_ctx);
+    }
+}
+
+static void apply_link_baud(uint32_t bits_per_second)
+{
+    xSemaphoreTake(s_transport_lock, portMAX_DELAY);
+    if (core_link_transport_set_baud(&s_transport, bits_per_second) == 0) {
+        s_link_baud = bits_per_second;
+    }
+    xSemaphoreGive(s_transport_lock);
+    core_link_stats_set(&s_stats, CORE_LINK_STAT_BAUD_RATE, s_link_baud);
+}
+
+static void handle_baud_switch(const uint8_t *payload, uint16_t length)
+{
+    if (length < CORE_LINK_BAUD_SWITCH_PAYLOAD_SIZE || !s_peer_baud_switch) {
+        return;
+    }
+    uint8_t index = payload[0];
+    uint32_t bps = (uint32_t)payload[1] | ((uint32_t)payload[2] << 8) | ((uint32_t)payload[3] << 16) |
+                   ((uint32_t)payload[4] << 24);
+    if (index >= CORE_LINK_BAUD_RATE_COUNT || core_link_baud_rate(index) != bps || !(s_baud_local_mask & (1U << index))) {
+        // No ACK: the core times out and stays where it is.
+        ESP_LOGW(TAG, "Refusing baud switch to %u bps", (unsigned)bps);
+        return;
+    }
+    // The core already switched behind its BAUD_SWITCH; the ACK goes out at the new rate.
+    portENTER_CRITICAL(&s_baud_lock);
+    s_baud_previous_bps = s_link_baud;
+    s_baud_probe_active = true;
+    s_baud_probe_tick = xTaskGetTickCount();
+    portEXIT_CRITICAL(&s_baud_lock);
+    apply_link_baud(bps);
+    send_frame(CORE_LINK_MSG_BAUD_SWITCH_ACK, payload, CORE_LINK_BAUD_SWITCH_PAYLOAD_SIZE);
+    ESP_LOGI(TAG, "Link switched from %u to %u bps", (unsigned)s_baud_previous_bps, (unsigned)bps);
+}
+
+static void baud_confirm(void)
+{
+    bool confirmed = false;
+    portENTER_CRITICAL(&s_baud_lock);
+    if (s_baud_probe_active) {
+        s_baud_probe_active = false;
+        confirmed = true;
+    }
+    portEXIT_CRITICAL(&s_baud_lock);
+    if (confirmed) {
+        core_link_stats_add(&s_stats, CORE_LINK_STAT_BAUD_SWITCHES, 1);
+    }
+}
+
+static void baud_probe_check(TickType_t now)
+{
+    uint32_t revert_bps = 0;
+    portENTER_CRITICAL(&s_baud_lock);
+    if (s_baud_probe_active && now - s_baud_probe_tick >= pdMS_TO_TICKS(CORE_LINK_BAUD_SWITCH_TIMEOUT_MS)) {
+        s_baud_probe_active = false;
+        revert_bps = s_baud_previous_bps;
+    }
+    portEXIT_CRITICAL(&s_baud_lock);
+    if (revert_bps != 0) {
+        ESP_LOGW(TAG, "Nothing received at %u bps, back to %u bps", (unsigned)s_link_baud, (unsigned)revert_bps);
+        apply_link_baud(revert_bps);
+    }
+}
+
+static void baud_fall_back(void)
+{
+    portENTER_CRITICAL(&s_baud_lock);
+    s_baud_probe_active = false;
+    portEXIT_CRITICAL(&s_baud_lock);
+    if (s_link_baud != (uint32_t)s_config.baud_rate) {
+        // The core does the same when its watchdog fires: both meet at the start rate.
+        ESP_LOGW(TAG, "Link lost at %u bps, falling back to %d bps", (unsigned)s_link_baud, s_config.baud_rate);
+        apply_link_baud((uint32_t)s_config.baud_rate);
+        core_link_stats_add(&s_stats, CORE_LINK_STAT_BAUD_SWITCHES, 1);
+    }
+}
+
 static void update_link_alive(bool alive)
 {
     if (s_link_alive == alive) {
@@ -461,9 +862,10 @@ static void update_link_alive(bool alive)
         s_full_frame_received = false;
         s_full_resync_pending = false;
         s_last_full_tick = xTaskGetTickCount();
-        touch_queue_reset();
-        s_cached_state_valid = false;
-        memset(&s_cached_state, 0, sizeof(s_cached_state));
+        core_link_touch_slots_reset(&s_touch_slots);
+        rx_request_reset(CORE_LINK_RX_RESET_LINK);
+        baud_fall_back();
+        pending_fail_all(ESP_ERR_INVALID_STATE);
     } else {
         if (s_watchdog_triggered) {
             s_watchdog_triggered = false;
@@ -485,14 +887,55 @@ static void update_link_alive(bool alive)
     }
 }
 
+static void pending_complete(const core_link_pending_entry_t *entry, esp_err_t status, uint8_t terrarium_count)
+{
+    if (entry->cb) {
+        entry->cb((core_link_command_opcode_t)entry->opcode, status, terrarium_count, entry->ctx);
+    }
+}
+
+static void pending_expire(TickType_t now)
+{
+    core_link_pending_entry_t entry;
+    for (;;) {
+        portENTER_CRITICAL(&s_pending_lock);
+        bool expired = core_link_pending_take_expired(&s_pending, (uint32_t)now, &entry);
+        portEXIT_CRITICAL(&s_pending_lock);
+        if (!expired) {
+            break;
+        }
+        ESP_LOGW(TAG, "Command 0x%02X (id=%u) timed out", entry.opcode, (unsigned)entry.request_id);
+        pending_complete(&entry, ESP_ERR_TIMEOUT, 0);
+    }
+}
+
+static void pending_fail_all(esp_err_t status)
+{
+    core_link_pending_entry_t entry;
+    for (;;) {
+        portENTER_CRITICAL(&s_pending_lock);
+        bool taken = core_link_pending_take_any(&s_pending, &entry);
+        portEXIT_CRITICAL(&s_pending_lock);
+        if (!taken) {
+            break;
+        }
+        pending_complete(&entry, status, 0);
+    }
+}
+
 static void watchdog_timer_cb(TimerHandle_t timer)
 {
     (void)timer;
-    if (!s_started || !s_handshake_done || !s_link_alive) {
+    if (!s_started || !s_handshake_done) {
         return;
     }
-
     TickType_t now = xTaskGetTickCount();
+    baud_probe_check(now);
+    pending_expire(now);
+    if (!s_link_alive) {
+        return;
+    }
+
     TickType_t state_elapsed = now - s_last_state_tick;
     TickType_t full_elapsed = now - s_last_full_tick;
     bool state_timeout = state_elapsed >= CORE_LINK_STATE_TIMEOUT_TICKS;
@@ -500,11 +943,16 @@ static void watchdog_timer_cb(TimerHandle_t timer)
     bool waiting_first_full = !s_full_frame_received;
 
     if (!state_timeout && !full_timeout) {
+        // Healthy link: a periodic PING only feeds the RTT histogram.
+        if (CORE_LINK_RTT_PROBE_TICKS > 0 && now - s_last_probe_tick >= CORE_LINK_RTT_PROBE_TICKS) {
+            s_last_probe_tick = now;
+            send_ping();
+        }
         return;
     }
 
     if (!s_ping_in_flight) {
-        esp_err_t err = uart_send_frame(CORE_LINK_MSG_PING, NULL, 0);
+        esp_err_t err = send_ping();
         if (err == ESP_OK) {
             s_ping_in_flight = true;
             s_last_ping_tick = now;
@@ -559,68 +1007,35 @@ static void watchdog_timer_cb(TimerHandle_t timer)
 static void touch_dispatch_task(void *arg)
 {
     (void)arg;
+    core_link_touch_event_t events[CORE_LINK_TOUCH_BATCH_MAX];
+    uint8_t payload[CORE_LINK_TOUCH_BATCH_PAYLOAD_MAX];
 
     while (true) {
-        if (!s_touch_queue) {
-            vTaskDelay(pdMS_TO_TICKS(10));
-            continue;
-        }
-
-        core_link_touch_event_t event;
-        if (xQueueReceive(s_touch_queue, &event, portMAX_DELAY) != pdTRUE) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        size_t count = core_link_touch_slots_collect(&s_touch_slots, events, CORE_LINK_TOUCH_BATCH_MAX);
+        if (count == 0) {
             continue;
         }
 
-        esp_err_t err = core_link_send_touch_event(&event);
-        if (err == ESP_OK) {
-            portENTER_CRITICAL(&s_touch_queue_lock);
-            if (event.point_id < CORE_LINK_TOUCH_MAX_POINTS) {
-                s_touch_last_sent[event.point_id] = event;
-                s_touch_last_sent_valid[event.point_id] = true;
-            }
-            portEXIT_CRITICAL(&s_touch_queue_lock);
-        } else if (err == ESP_ERR_INVALID_STATE) {
-            ESP_LOGD(TAG, "Queued touch event dropped (link not ready)");
+        esp_err_t err = ESP_OK;
+        if (s_peer_touch_batch) {
+            // Every dirty point in one frame: a multi-touch gesture costs a single UART write.
+            size_t length = core_link_touch_batch_encode(events, count, payload, sizeof(payload));
+            err = send_frame(CORE_LINK_MSG_TOUCH_EVENT, payload, (uint16_t)length);
         } else {
-            ESP_LOGW(TAG, "Failed to dispatch touch event: %s", esp_err_to_name(err));
+            for (size_t i = 0; i < count && err == ESP_OK; ++i) {
+                err = core_link_send_touch_event(&events[i]);
+            }
+        }
+        if (err == ESP_ERR_INVALID_STATE) {
+            ESP_LOGD(TAG, "Touch events dropped (link not ready)");
+        } else if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to dispatch touch events: %s", esp_err_to_name(err));
         }
     }
 }
 
-typedef struct __attribute__((packed)) {
-    uint32_t epoch_seconds;
-    uint8_t terrarium_count;
-} core_link_state_header_wire_t;
-
-typedef struct __attribute__((packed)) {
-    uint8_t terrarium_id;
-    char scientific_name[CORE_LINK_NAME_MAX_LEN + 1];
-    char common_name[CORE_LINK_NAME_MAX_LEN + 1];
-    float temp_day_c;
-    float temp_night_c;
-    float humidity_day_pct;
-    float humidity_night_pct;
-    float lux_day;
-    float lux_night;
-    float hydration_pct;
-    float stress_pct;
-    float health_pct;
-    uint32_t last_feeding_timestamp;
-    float activity_score;
-} core_link_snapshot_wire_t;
-
-typedef struct __attribute__((packed)) {
-    uint32_t epoch_seconds;
-    uint8_t terrarium_count;
-    uint8_t changed_count;
-} core_link_state_delta_header_wire_t;
-
-typedef struct __attribute__((packed)) {
-    uint8_t terrarium_id;
-    core_link_delta_field_mask_t field_mask;
-} core_link_state_delta_entry_wire_t;
-
-static esp_err_t handle_state_full_frame(const uint8_t *payload, uint16_t length)
+static esp_err_t handle_state_full_frame(const uint8_t *payload, size_t length)
 {
     if (length < sizeof(core_link_state_header_wire_t)) {
         return ESP_ERR_INVALID_SIZE;
@@ -628,81 +1043,108 @@ static esp_err_t handle_state_full_frame(const uint8_t *payload, uint16_t length
 
     core_link_state_header_wire_t header;
     memcpy(&header, payload, sizeof(header));
-    if (header.terrarium_count > CORE_LINK_MAX_TERRARIUMS) {
+    core_link_state_frame_t *frame = s_rx_state;
+    if (header.terrarium_count > frame->terrarium_capacity) {
         ESP_LOGW(TAG, "Terrarium count %u exceeds max", header.terrarium_count);
-        header.terrarium_count = CORE_LINK_MAX_TERRARIUMS;
+        header.terrarium_count = frame->terrarium_capacity;
     }
 
     size_t expected_length = sizeof(core_link_state_header_wire_t) + header.terrarium_count * sizeof(core_link_snapshot_wire_t);
     if (length < expected_length) {
-        ESP_LOGW(TAG, "State frame length mismatch (%u < %zu)", length, expected_length);
+        ESP_LOGW(TAG, "State frame length mismatch (%zu < %zu)", length, expected_length);
         return ESP_ERR_INVALID_SIZE;
     }
 
-    core_link_state_frame_t frame = {
-        .epoch_seconds = header.epoch_seconds,
-        .terrarium_count = header.terrarium_count,
-    };
-
-    const uint8_t *cursor = payload + sizeof(core_link_state_header_wire_t);
-    for (uint8_t i = 0; i < frame.terrarium_count; ++i) {
-        core_link_snapshot_wire_t wire;
-        memcpy(&wire, cursor, sizeof(wire));
-        cursor += sizeof(wire);
-        frame.terrariums[i].terrarium_id = wire.terrarium_id;
-        strncpy(frame.terrariums[i].scientific_name, wire.scientific_name, CORE_LINK_NAME_MAX_LEN);
-        frame.terrariums[i].scientific_name[CORE_LINK_NAME_MAX_LEN] = '\0';
-        strncpy(frame.terrariums[i].common_name, wire.common_name, CORE_LINK_NAME_MAX_LEN);
-        frame.terrariums[i].common_name[CORE_LINK_NAME_MAX_LEN] = '\0';
-        frame.terrariums[i].temp_day_c = wire.temp_day_c;
-        frame.terrariums[i].temp_night_c = wire.temp_night_c;
-        frame.terrariums[i].humidity_day_pct = wire.humidity_day_pct;
-        frame.terrariums[i].humidity_night_pct = wire.humidity_night_pct;
-        frame.terrariums[i].lux_day = wire.lux_day;
-        frame.terrariums[i].lux_night = wire.lux_night;
-        frame.terrariums[i].hydration_pct = wire.hydration_pct;
-        frame.terrariums[i].stress_pct = wire.stress_pct;
-        frame.terrariums[i].health_pct = wire.health_pct;
-        frame.terrariums[i].last_feeding_timestamp = wire.last_feeding_timestamp;
-        frame.terrariums[i].activity_score = wire.activity_score;
-    }
-
-    s_cached_state = frame;
-    s_cached_state_valid = true;
+    frame->epoch_seconds = header.epoch_seconds;
+    frame->terrarium_count = header.terrarium_count;
 
-    if (s_state_cb) {
-        s_state_cb(&frame, s_state_ctx);
+    const core_link_snapshot_wire_t *entries = (const core_link_snapshot_wire_t *)(payload + sizeof(core_link_state_header_wire_t));
+    for (uint8_t i = 0; i < frame->terrarium_count; ++i) {
+        core_link_fields_from_wire(&frame->terrariums[i], &entries[i]);
     }
+
+    commit_rx_state();
     return ESP_OK;
 }
 
-static esp_err_t handle_state_delta_frame(const uint8_t *payload, uint16_t length)
+static esp_err_t handle_state_full_compact_frame(const uint8_t *payload, size_t length)
 {
-    if (length < sizeof(core_link_state_delta_header_wire_t)) {
+    if (length < sizeof(core_link_state_header_wire_t)) {
         return ESP_ERR_INVALID_SIZE;
     }
 
-    if (!s_cached_state_valid) {
-        ESP_LOGW(TAG, "STATE_DELTA received without baseline");
-        return ESP_ERR_INVALID_STATE;
-    }
+    core_link_state_header_wire_t header;
+    memcpy(&header, payload, sizeof(header));
+    core_link_state_frame_t *frame = s_rx_state;
+    if (header.terrarium_count > frame->terrarium_capacity) {
+        ESP_LOGW(TAG, "Terrarium count %u exceeds max", header.terrarium_count);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    frame->epoch_seconds = header.epoch_seconds;
+    frame->terrarium_count = header.terrarium_count;
+
+    size_t offset = sizeof(header);
+    for (uint8_t i = 0; i < frame->terrarium_count; ++i) {
+        if (offset + sizeof(core_link_state_delta_entry_wire_t) > length) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        core_link_state_delta_entry_wire_t entry;
+        memcpy(&entry, payload + offset, sizeof(entry));
+        offset += sizeof(entry);
+
+        core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
+        snap->terrarium_id = entry.terrarium_id;
+        snap->name_ids[0] = CORE_LINK_NAME_ID_NONE;
+        snap->name_ids[1] = CORE_LINK_NAME_ID_NONE;
+        if (!(entry.field_mask & CORE_LINK_DELTA_FIELD_NAME_IDS) &&
+            (entry.field_mask & CORE_LINK_DELTA_FIELD_NAMES) != CORE_LINK_DELTA_FIELD_NAMES) {
+            // Names are omitted once known: reuse them even from a baseline being resynchronised.
+            const core_link_terrarium_snapshot_t *known = find_cached_snapshot(s_cached_state, entry.terrarium_id);
+            if (!known) {
+                ESP_LOGW(TAG, "STATE_FULL_COMPACT without names for unknown terrarium %u", entry.terrarium_id);
+                return ESP_ERR_INVALID_STATE;
+            }
+            memcpy(snap->scientific_name, known->scientific_name, sizeof(snap->scientific_name));
+            memcpy(snap->common_name, known->common_name, sizeof(snap->common_name));
+        }
+        if (!core_link_compact_decode_fields(payload, length, &offset, entry.field_mask, snap)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        ESP_RETURN_ON_ERROR(resolve_snapshot_names(snap, entry.field_mask), TAG, "unknown name ID");
+    }
+
+    commit_rx_state();
+    return ESP_OK;
+}
+
+static esp_err_t handle_state_delta_frame(const uint8_t *payload, size_t length, bool compact)
+{
+    if (length < sizeof(core_link_state_delta_header_wire_t)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    if (!s_cached_state_valid) {
+        ESP_LOGW(TAG, "STATE_DELTA received without baseline");
+        return ESP_ERR_INVALID_STATE;
+    }
 
     core_link_state_delta_header_wire_t header;
     memcpy(&header, payload, sizeof(header));
 
-    if (header.terrarium_count != s_cached_state.terrarium_count) {
-        ESP_LOGW(TAG, "STATE_DELTA terrarium mismatch (%u != %u)", header.terrarium_count, s_cached_state.terrarium_count);
+    if (header.terrarium_count != s_cached_state->terrarium_count) {
+        ESP_LOGW(TAG, "STATE_DELTA terrarium mismatch (%u != %u)", header.terrarium_count, s_cached_state->terrarium_count);
         return ESP_ERR_INVALID_SIZE;
     }
 
     size_t offset = sizeof(header);
-    core_link_state_frame_t next = s_cached_state;
-    next.epoch_seconds = header.epoch_seconds;
-    next.terrarium_count = header.terrarium_count;
+    core_link_state_frame_t *next = s_rx_state;
+    core_link_state_frame_copy(next, s_cached_state);
+    next->epoch_seconds = header.epoch_seconds;
 
-    if (header.changed_count > next.terrarium_count) {
-        ESP_LOGW(TAG, "STATE_DELTA change count %u exceeds terrariums %u", header.changed_count, next.terrarium_count);
-        header.changed_count = next.terrarium_count;
+    if (header.changed_count > next->terrarium_count) {
+        ESP_LOGW(TAG, "STATE_DELTA change count %u exceeds terrariums %u", header.changed_count, next->terrarium_count);
+        header.changed_count = next->terrarium_count;
     }
 
     for (uint8_t i = 0; i < header.changed_count; ++i) {
@@ -714,7 +1156,7 @@ static esp_err_t handle_state_delta_frame(const uint8_t *payload, uint16_t lengt
         memcpy(&entry, payload + offset, sizeof(entry));
         offset += sizeof(entry);
 
-        core_link_terrarium_snapshot_t *snap = find_cached_snapshot(&next, entry.terrarium_id);
+        core_link_terrarium_snapshot_t *snap = find_cached_snapshot(next, entry.terrarium_id);
         if (!snap) {
             ESP_LOGW(TAG, "STATE_DELTA unknown terrarium id %u", entry.terrarium_id);
             return ESP_ERR_INVALID_STATE;
@@ -722,109 +1164,79 @@ static esp_err_t handle_state_delta_frame(const uint8_t *payload, uint16_t lengt
 
         core_link_delta_field_mask_t mask = entry.field_mask;
 
-        if (mask & CORE_LINK_DELTA_FIELD_SCIENTIFIC_NAME) {
-            if (offset + CORE_LINK_DELTA_STRING_BYTES > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(snap->scientific_name, payload + offset, CORE_LINK_DELTA_STRING_BYTES);
-            snap->scientific_name[CORE_LINK_NAME_MAX_LEN] = '\0';
-            offset += CORE_LINK_DELTA_STRING_BYTES;
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_COMMON_NAME) {
-            if (offset + CORE_LINK_DELTA_STRING_BYTES > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(snap->common_name, payload + offset, CORE_LINK_DELTA_STRING_BYTES);
-            snap->common_name[CORE_LINK_NAME_MAX_LEN] = '\0';
-            offset += CORE_LINK_DELTA_STRING_BYTES;
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_TEMP_DAY) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->temp_day_c, payload + offset, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_TEMP_NIGHT) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->temp_night_c, payload + offset, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_HUMIDITY_DAY) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->humidity_day_pct, payload + offset, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_HUMIDITY_NIGHT) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->humidity_night_pct, payload + offset, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_LUX_DAY) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->lux_day, payload + offset, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_LUX_NIGHT) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->lux_night, payload + offset, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_HYDRATION) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->hydration_pct, payload + offset, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_STRESS) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->stress_pct, payload + offset, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_HEALTH) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->health_pct, payload + offset, sizeof(float));
-            offset += sizeof(float);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_LAST_FEED) {
-            if (offset + sizeof(uint32_t) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->last_feeding_timestamp, payload + offset, sizeof(uint32_t));
-            offset += sizeof(uint32_t);
-        }
-        if (mask & CORE_LINK_DELTA_FIELD_ACTIVITY) {
-            if (offset + sizeof(float) > length) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(&snap->activity_score, payload + offset, sizeof(float));
-            offset += sizeof(float);
+        bool decoded = compact ? core_link_compact_decode_fields(payload, length, &offset, mask, snap)
+                               : core_link_fields_v1_decode(payload, length, &offset, mask, snap);
+        if (!decoded) {
+            return ESP_ERR_INVALID_SIZE;
         }
+        // v1 has no name IDs: a stray NAME_IDS bit must not trigger a table lookup.
+        core_link_delta_field_mask_t applied = compact ? mask : (mask & CORE_LINK_DELTA_FIELD_ALL);
+        ESP_RETURN_ON_ERROR(resolve_snapshot_names(snap, applied), TAG, "unknown name ID");
     }
 
-    s_cached_state = next;
+    commit_rx_state();
+    return ESP_OK;
+}
+
+static void commit_rx_state(void)
+{
+    // The decoded frame becomes the cache; the previous cache is the next scratch buffer.
+    core_link_state_frame_t *previous = s_cached_state;
+    s_rx_state->name_generation = s_name_generation;
+    s_rx_state->sample_us = s_rx_sample_us;
+    s_cached_state = s_rx_state;
+    s_rx_state = previous;
     s_cached_state_valid = true;
 
     if (s_state_cb) {
-        core_link_state_frame_t frame = next;
-        s_state_cb(&frame, s_state_ctx);
+        s_state_cb(s_cached_state, s_state_ctx);
+    }
+}
+
+static esp_err_t handle_name_table_frame(const uint8_t *payload, size_t length)
+{
+    // Additions are only meaningful on top of a table this display actually holds.
+    bool carries_reset = length >= 2 && (payload[1] & CORE_LINK_NAME_TABLE_FLAG_RESET);
+    if (!s_name_table_valid && !carries_reset) {
+        return ESP_ERR_INVALID_STATE;
     }
 
+    bool reset = false;
+    if (!core_link_name_table_apply(s_name_table, payload, length, &reset)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (reset) {
+        // A new generation reassigns IDs: the cached baseline cannot take deltas any more.
+        if (++s_name_generation == 0) {
+            s_name_generation = 1;
+        }
+        s_name_table_valid = true;
+        s_cached_state_valid = false;
+        ESP_LOGI(TAG, "Name table generation %u (%u names)", payload[0], s_name_table->count);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t resolve_snapshot_names(core_link_terrarium_snapshot_t *snap, core_link_delta_field_mask_t mask)
+{
+    if (mask & CORE_LINK_DELTA_FIELD_NAME_IDS) {
+        const char *scientific = core_link_name_table_lookup(s_name_table, snap->name_ids[0]);
+        const char *common = core_link_name_table_lookup(s_name_table, snap->name_ids[1]);
+        if (!s_name_table_valid || !scientific || !common) {
+            s_name_table_valid = false;
+            return ESP_ERR_INVALID_STATE;
+        }
+        memcpy(snap->scientific_name, scientific, sizeof(snap->scientific_name));
+        memcpy(snap->common_name, common, sizeof(snap->common_name));
+        return ESP_OK;
+    }
+    // Inline names are not interned: drop the stale IDs so consumers copy them.
+    if (mask & CORE_LINK_DELTA_FIELD_SCIENTIFIC_NAME) {
+        snap->name_ids[0] = CORE_LINK_NAME_ID_NONE;
+    }
+    if (mask & CORE_LINK_DELTA_FIELD_COMMON_NAME) {
+        snap->name_ids[1] = CORE_LINK_NAME_ID_NONE;
+    }
     return ESP_OK;
 }
 
@@ -843,8 +1255,172 @@ static core_link_terrarium_snapshot_t *find_cached_snapshot(core_link_state_fram
     return NULL;
 }
 
+static void request_resync(const char *reason)
+{
+    if (s_full_resync_pending) {
+        return;
+    }
+    ESP_LOGW(TAG, "%s, requesting resync", reason);
+    esp_err_t err = core_link_request_state_sync();
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "State resync request failed: %s", esp_err_to_name(err));
+    }
+}
+
+// Rebuilds the STATE_FULL a STATE_FULL_COMPRESSED stands for, in s_full_scratch.
+static bool expand_full_compressed(uint8_t *type, const uint8_t **payload, size_t *length)
+{
+    core_link_full_compressed_header_t header;
+    if (!core_link_full_compressed_header_read(*payload, *length, &header) || !s_full_baseline.valid ||
+        header.baseline_crc != s_full_baseline.crc || header.length > s_full_baseline.capacity) {
+        return false;
+    }
+    size_t produced = 0;
+    esp_err_t err = compression_if_decompress((compression_codec_t)header.codec,
+                                              *payload + CORE_LINK_FULL_COMPRESSED_HEADER_SIZE,
+                                              *length - CORE_LINK_FULL_COMPRESSED_HEADER_SIZE, s_full_scratch,
+                                              header.length, NULL, &produced);
+    if (err != ESP_OK || produced != header.length) {
+        return false;
+    }
+    core_link_baseline_xor(&s_full_baseline, s_full_scratch, produced);
+    if (core_link_crc16_update(0xFFFF, s_full_scratch, produced) != header.crc) {
+        return false;
+    }
+    *type = header.inner_type;
+    *payload = s_full_scratch;
+    *length = produced;
+    return true;
+}
+
+static esp_err_t dispatch_state_frame(uint8_t type, const uint8_t *payload, size_t length)
+{
+    TickType_t now = xTaskGetTickCount();
+    s_last_state_tick = now;
+    s_last_ping_tick = now;
+    s_ping_in_flight = false;
+    s_state_timeout_logged = false;
+    update_link_alive(true);
+
+    if (type == CORE_LINK_MSG_STATE_FRAGMENT) {
+        core_link_reassembly_status_t progress = core_link_reassembly_push(&s_reassembly, payload, length);
+        if (progress == CORE_LINK_REASSEMBLY_PENDING) {
+            return ESP_OK;
+        }
+        if (progress == CORE_LINK_REASSEMBLY_ERROR) {
+            request_resync("STATE_FRAGMENT out of order");
+            return ESP_ERR_INVALID_STATE;
+        }
+        type = s_reassembly.inner_type;
+        payload = s_reassembly.buffer;
+        length = s_reassembly.length;
+    }
+
+    size_t compressed_length = 0;
+    if (type == CORE_LINK_MSG_STATE_FULL_COMPRESSED) {
+        compressed_length = length;
+        if (!expand_full_compressed(&type, &payload, &length)) {
+            core_link_baseline_reset(&s_full_baseline);
+            request_resync("STATE_FULL_COMPRESSED does not match the local baseline");
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
+    // Plain payload as the core built it, sample time included: the next baseline.
+    const uint8_t *full_payload = payload;
+    size_t full_length = length;
+
+    s_rx_sample_us = 0;
+    bool snapshot = core_link_msg_is_state_full(type) || type == CORE_LINK_MSG_STATE_DELTA ||
+                    type == CORE_LINK_MSG_STATE_DELTA_COMPACT;
+    if (snapshot && s_peer_sample_time) {
+        if (length < CORE_LINK_SAMPLE_TIME_SIZE) {
+            request_resync("State frame without sample time");
+            return ESP_ERR_INVALID_SIZE;
+        }
+        length -= CORE_LINK_SAMPLE_TIME_SIZE;
+        int64_t core_us = (int64_t)core_link_get_le64(payload + length);
+        portENTER_CRITICAL(&s_clock_lock);
+        if (!core_link_clock_to_local(&s_clock, core_us, &s_rx_sample_us)) {
+            s_rx_sample_us = 0;
+        }
+        portEXIT_CRITICAL(&s_clock_lock);
+    }
+
+    esp_err_t status = ESP_ERR_NOT_SUPPORTED;
+    switch (type) {
+        case CORE_LINK_MSG_NAME_TABLE:
+            status = handle_name_table_frame(payload, length);
+            if (status != ESP_OK) {
+                s_name_table_valid = false;
+                request_resync("NAME_TABLE rejected");
+            }
+            break;
+        case CORE_LINK_MSG_STATE_FULL:
+        case CORE_LINK_MSG_STATE_FULL_COMPACT:
+            status = (type == CORE_LINK_MSG_STATE_FULL_COMPACT) ? handle_state_full_compact_frame(payload, length)
+                                                                : handle_state_full_frame(payload, length);
+            if (status == ESP_ERR_INVALID_STATE) {
+                // Names missing locally: REQUEST_STATE makes the core resend them.
+                s_name_table_valid = false;
+                esp_err_t err = core_link_request_state_sync();
+                if (err != ESP_OK) {
+                    ESP_LOGW(TAG, "State resync request failed: %s", esp_err_to_name(err));
+                }
+            } else if (status != ESP_OK) {
+                ESP_LOGW(TAG, "Invalid STATE_FULL frame received");
+            } else {
+                s_last_full_tick = now;
+                s_full_frame_received = true;
+                s_full_resync_pending = false;
+                core_link_stats_add(&s_stats, CORE_LINK_STAT_STATE_FULL, 1);
+                if (compressed_length > 0) {
+                    core_link_stats_add(&s_stats, CORE_LINK_STAT_FULL_COMPRESSED, 1);
+                    core_link_stats_add(&s_stats, CORE_LINK_STAT_FULL_BYTES_SAVED,
+                                        (uint32_t)(full_length - compressed_length));
+                }
+            }
+            if (status != ESP_OK || !s_peer_full_compressed) {
+                core_link_baseline_reset(&s_full_baseline);
+            } else {
+                core_link_baseline_store(&s_full_baseline, full_payload, full_length);
+            }
+            break;
+        case CORE_LINK_MSG_STATE_DELTA:
+        case CORE_LINK_MSG_STATE_DELTA_COMPACT:
+            status = handle_state_delta_frame(payload, length, type == CORE_LINK_MSG_STATE_DELTA_COMPACT);
+            if (status != ESP_OK) {
+                ESP_LOGW(TAG, "Invalid STATE_DELTA received, requesting resync");
+                s_cached_state_valid = false;
+                s_full_frame_received = false;
+                s_last_full_tick = now;
+                esp_err_t err = core_link_request_state_sync();
+                if (err != ESP_OK) {
+                    ESP_LOGW(TAG, "State resync request failed: %s", esp_err_to_name(err));
+                }
+            } else {
+                core_link_stats_add(&s_stats, CORE_LINK_STAT_STATE_DELTA, 1);
+                // While the subscription narrows the view, the core refreshes it with
+                // deltas: a STATE_FULL only comes back on resync.
+                portENTER_CRITICAL(&s_subscription_lock);
+                bool narrowed = s_peer_subscribe && !core_link_subscription_is_all(&s_subscription);
+                portEXIT_CRITICAL(&s_subscription_lock);
+                if (narrowed) {
+                    s_last_full_tick = now;
+                }
+            }
+            break;
+        default:
+            ESP_LOGW(TAG, "Unexpected reassembled frame type 0x%02X", type);
+            break;
+    }
+    return status;
+}
+
 static void dispatch_frame(core_link_msg_type_t type, const uint8_t *payload, uint16_t length)
 {
+    if (type != CORE_LINK_MSG_BAUD_SWITCH) {
+        baud_confirm();
+    }
     switch (type) {
         case CORE_LINK_MSG_HELLO: {
             if (length >= 1) {
@@ -852,18 +1428,46 @@ static void dispatch_frame(core_link_msg_type_t type, const uint8_t *payload, ui
             } else {
                 s_peer_version = 0;
             }
+            // Older cores send the version byte only: they keep talking v1.
+            uint8_t peer_caps = length >= 2 ? payload[1] : 0;
+            uint8_t peer_caps_ext = length >= 3 ? payload[2] : 0;
             core_link_hello_ack_payload_t ack = {
                 .protocol_version = CORE_LINK_PROTOCOL_VERSION,
-                .capabilities = 0x01, // display endpoint
+                .capabilities = CORE_LINK_CAP_DISPLAY | CORE_LINK_CAP_FRAME_V2 | CORE_LINK_CAP_COMPACT_STATE |
+                                CORE_LINK_CAP_FRAGMENTS | CORE_LINK_CAP_NAME_TABLE | CORE_LINK_CAP_LINK_STATS |
+                                CORE_LINK_CAP_TOUCH_BATCH,
+                .capabilities_ext = CORE_LINK_CAP_EXT_SAMPLE_TIME | CORE_LINK_CAP_EXT_FULL_COMPRESSED |
+                                    CORE_LINK_CAP_EXT_REQUEST_ID |
+                                    (s_baud_local_mask ? CORE_LINK_CAP_EXT_BAUD_SWITCH : 0),
+                .baud_mask = s_baud_local_mask,
             };
-            uart_send_frame(CORE_LINK_MSG_HELLO_ACK, &ack, sizeof(ack));
+            // The core may have rebooted: its name IDs restart from scratch.
+            s_name_table_valid = false;
+            s_frame_v2 = false;
+            rx_seq_reset();
+            send_frame(CORE_LINK_MSG_HELLO_ACK, &ack, sizeof(ack));
+            s_frame_v2 = (peer_caps & CORE_LINK_CAP_FRAME_V2) != 0;
+            s_peer_touch_batch = (peer_caps & CORE_LINK_CAP_TOUCH_BATCH) != 0;
+            s_peer_sample_time = (peer_caps_ext & CORE_LINK_CAP_EXT_SAMPLE_TIME) != 0;
+            s_peer_full_compressed = (peer_caps_ext & CORE_LINK_CAP_EXT_FULL_COMPRESSED) != 0;
+            s_peer_request_id = (peer_caps_ext & CORE_LINK_CAP_EXT_REQUEST_ID) != 0;
+            s_peer_subscribe = (peer_caps_ext & CORE_LINK_CAP_EXT_SUBSCRIBE) != 0;
+            s_peer_history = (peer_caps_ext & CORE_LINK_CAP_EXT_HISTORY) != 0;
+            // The core restarts unfiltered on every handshake.
+            send_subscription();
+            s_peer_baud_switch = s_baud_local_mask != 0 && (peer_caps_ext & CORE_LINK_CAP_EXT_BAUD_SWITCH) != 0;
+            core_link_baseline_reset(&s_full_baseline);
+            // A (re)booted core restarted its clock: earlier exchanges no longer apply.
+            portENTER_CRITICAL(&s_clock_lock);
+            core_link_clock_reset(&s_clock);
+            portEXIT_CRITICAL(&s_clock_lock);
 
             if (!s_handshake_done) {
                 s_handshake_done = true;
                 xEventGroupSetBits(s_events, CORE_LINK_EVENT_HANDSHAKE);
-                ESP_LOGI(TAG, "Handshake complete (peer protocol v%u)", s_peer_version);
+                ESP_LOGI(TAG, "Handshake complete (peer protocol v%u, frames v%u)", s_peer_version, s_frame_v2 ? 2 : 1);
             } else {
-                ESP_LOGI(TAG, "Handshake refreshed (peer protocol v%u)", s_peer_version);
+                ESP_LOGI(TAG, "Handshake refreshed (peer protocol v%u, frames v%u)", s_peer_version, s_frame_v2 ? 2 : 1);
             }
 
             TickType_t now = xTaskGetTickCount();
@@ -883,42 +1487,15 @@ static void dispatch_frame(core_link_msg_type_t type, const uint8_t *payload, ui
             }
             break;
         }
-        case CORE_LINK_MSG_STATE_FULL: {
-            TickType_t now = xTaskGetTickCount();
-            s_last_state_tick = now;
-            s_last_ping_tick = now;
-            s_ping_in_flight = false;
-            s_state_timeout_logged = false;
-            update_link_alive(true);
-            esp_err_t status = handle_state_full_frame(payload, length);
-            if (status != ESP_OK) {
-                ESP_LOGW(TAG, "Invalid STATE_FULL frame received");
-            } else {
-                s_last_full_tick = now;
-                s_full_frame_received = true;
-                s_full_resync_pending = false;
-            }
+        case CORE_LINK_MSG_STATE_FULL:
+        case CORE_LINK_MSG_STATE_FULL_COMPACT:
+        case CORE_LINK_MSG_STATE_DELTA:
+        case CORE_LINK_MSG_STATE_DELTA_COMPACT:
+        case CORE_LINK_MSG_STATE_FRAGMENT:
+        case CORE_LINK_MSG_NAME_TABLE:
+        case CORE_LINK_MSG_STATE_FULL_COMPRESSED:
+            dispatch_state_frame((uint8_t)type, payload, length);
             break;
-        }
-        case CORE_LINK_MSG_STATE_DELTA: {
-            TickType_t now = xTaskGetTickCount();
-            s_last_state_tick = now;
-            s_last_ping_tick = now;
-            s_ping_in_flight = false;
-            s_state_timeout_logged = false;
-            update_link_alive(true);
-            if (handle_state_delta_frame(payload, length) != ESP_OK) {
-                ESP_LOGW(TAG, "Invalid STATE_DELTA received, requesting resync");
-                s_cached_state_valid = false;
-                s_full_frame_received = false;
-                s_last_full_tick = now;
-                esp_err_t err = core_link_request_state_sync();
-                if (err != ESP_OK) {
-                    ESP_LOGW(TAG, "State resync request failed: %s", esp_err_to_name(err));
-                }
-            }
-            break;
-        }
         case CORE_LINK_MSG_COMMAND_ACK: {
             if (length < sizeof(core_link_command_ack_payload_t)) {
                 ESP_LOGW(TAG, "Command ACK too short (%u)", length);
@@ -927,70 +1504,320 @@ static void dispatch_frame(core_link_msg_type_t type, const uint8_t *payload, ui
             core_link_command_ack_payload_t ack;
             memcpy(&ack, payload, sizeof(ack));
             esp_err_t status = (esp_err_t)ack.status;
-            ESP_LOGI(TAG, "Command ACK opcode=0x%02X status=%s terrariums=%u", ack.opcode, esp_err_to_name(status),
-                     (unsigned)ack.terrarium_count);
+            uint16_t request_id = CORE_LINK_REQUEST_ID_NONE;
+            if (s_peer_request_id && length >= sizeof(ack) + CORE_LINK_REQUEST_ID_SIZE) {
+                request_id = (uint16_t)(payload[sizeof(ack)] | (payload[sizeof(ack) + 1] << 8));
+            }
+            ESP_LOGI(TAG, "Command ACK opcode=0x%02X id=%u status=%s terrariums=%u", ack.opcode, (unsigned)request_id,
+                     esp_err_to_name(status), (unsigned)ack.terrarium_count);
+
+            core_link_pending_entry_t entry;
+            portENTER_CRITICAL(&s_pending_lock);
+            bool matched = request_id != CORE_LINK_REQUEST_ID_NONE
+                               ? core_link_pending_take(&s_pending, request_id, &entry)
+                               : core_link_pending_take_opcode(&s_pending, ack.opcode, &entry);
+            portEXIT_CRITICAL(&s_pending_lock);
+            if (!matched) {
+                // Already timed out, or sent before a display reboot.
+                ESP_LOGW(TAG, "Command ACK opcode=0x%02X id=%u matches no pending command", ack.opcode,
+                         (unsigned)request_id);
+            }
             if (s_command_cb) {
                 s_command_cb((core_link_command_opcode_t)ack.opcode, status, ack.terrarium_count, s_command_ctx);
             }
+            if (matched) {
+                pending_complete(&entry, status, ack.terrarium_count);
+            }
             break;
         }
         case CORE_LINK_MSG_PING:
-            uart_send_frame(CORE_LINK_MSG_PONG, payload, length);
+            send_frame(CORE_LINK_MSG_PONG, payload, length);
             break;
         case CORE_LINK_MSG_PONG: {
             TickType_t now = xTaskGetTickCount();
             s_ping_in_flight = false;
             s_last_ping_tick = now;
+            handle_pong(payload, length);
             update_link_alive(true);
             break;
         }
+        case CORE_LINK_MSG_LINK_STATS:
+            handle_link_stats(payload, length);
+            break;
+        case CORE_LINK_MSG_HISTORY_CHUNK:
+            handle_history_chunk(payload, length);
+            break;
+        case CORE_LINK_MSG_BAUD_SWITCH:
+            handle_baud_switch(payload, length);
+            break;
         default:
             ESP_LOGW(TAG, "Unhandled frame type 0x%02X", type);
             break;
     }
 }
 
-static void rx_task(void *arg)
+static void rx_seq_reset(void)
 {
-    uint8_t header_buf[sizeof(core_link_frame_header_t)];
-    uint8_t payload_buf[CORE_LINK_MAX_PAYLOAD];
-    while (true) {
-        int read = uart_read_bytes(s_config.uart_port, header_buf, 1, portMAX_DELAY);
-        if (read != 1) {
-            continue;
+    core_link_reassembly_reset(&s_reassembly);
+    s_rx_expected_seq = 0;
+    s_rx_nak_high = 0;
+    for (size_t i = 0; i < CORE_LINK_REORDER_SLOTS; ++i) {
+        s_parked[i].used = false;
+    }
+    s_parked_count = 0;
+}
+
+static void rx_apply_reset(uint32_t what)
+{
+    if (what & CORE_LINK_RX_RESET_LINK) {
+        core_link_state_frame_init(s_cached_state, CORE_LINK_MAX_TERRARIUMS);
+        core_link_baseline_reset(&s_full_baseline);
+        s_name_table_valid = false;
+    }
+    s_cached_state_valid = false;
+    rx_seq_reset();
+}
+
+// The RX task resets right away; the watchdog timer and UI tasks leave it to the
+// RX task, which may be halfway through a frame using that state.
+static void rx_request_reset(uint32_t what)
+{
+    if (!s_rx_task || xTaskGetCurrentTaskHandle() == s_rx_task) {
+        rx_apply_reset(what);
+        return;
+    }
+    portENTER_CRITICAL(&s_rx_reset_lock);
+    s_rx_reset_pending |= what;
+    portEXIT_CRITICAL(&s_rx_reset_lock);
+}
+
+static void rx_run_pending_resets(void)
+{
+    portENTER_CRITICAL(&s_rx_reset_lock);
+    uint32_t what = s_rx_reset_pending;
+    s_rx_reset_pending = 0;
+    portEXIT_CRITICAL(&s_rx_reset_lock);
+    if (what) {
+        rx_apply_reset(what);
+    }
+}
+
+static void rx_seq_fallback(const char *reason)
+{
+    ESP_LOGW(TAG, "Sequence recovery abandoned (%s), requesting STATE_FULL", reason);
+    esp_err_t err = core_link_request_state_sync();
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "State resync request failed: %s", esp_err_to_name(err));
+    }
+}
+
+static void rx_seq_accept(uint8_t type, uint16_t seq, const uint8_t *payload, uint16_t length)
+{
+    if (dispatch_state_frame(type, payload, length) != ESP_OK) {
+        // Rejected frame: dispatch_state_frame() already asked for a resync if needed.
+        rx_seq_reset();
+        return;
+    }
+    s_rx_expected_seq = core_link_seq_next(seq);
+}
+
+static void rx_seq_drain(void)
+{
+    bool progressed = true;
+    while (progressed && s_parked_count > 0 && s_rx_expected_seq != 0) {
+        progressed = false;
+        for (size_t i = 0; i < CORE_LINK_REORDER_SLOTS; ++i) {
+            core_link_parked_frame_t *slot = &s_parked[i];
+            if (!slot->used) {
+                continue;
+            }
+            int32_t diff = core_link_seq_diff(slot->seq, s_rx_expected_seq);
+            if (diff < 0) {
+                slot->used = false;
+                s_parked_count--;
+            } else if (diff == 0) {
+                slot->used = false;
+                s_parked_count--;
+                rx_seq_accept(slot->type, slot->seq, slot->payload, slot->length);
+                progressed = true;
+                break;
+            }
         }
-        if (header_buf[0] != CORE_LINK_SOF) {
-            continue;
+    }
+    if (s_parked_count == 0) {
+        s_rx_nak_high = 0;
+    }
+}
+
+static bool rx_seq_is_parked(uint16_t seq)
+{
+    for (size_t i = 0; i < CORE_LINK_REORDER_SLOTS; ++i) {
+        if (s_parked[i].used && s_parked[i].seq == seq) {
+            return true;
         }
-        int remaining = uart_read_bytes(s_config.uart_port, header_buf + 1, sizeof(core_link_frame_header_t) - 1, pdMS_TO_TICKS(50));
-        if (remaining != (int)(sizeof(core_link_frame_header_t) - 1)) {
+    }
+    return false;
+}
+
+static bool rx_seq_park(const core_link_stream_frame_t *frame)
+{
+    for (size_t i = 0; i < CORE_LINK_REORDER_SLOTS; ++i) {
+        core_link_parked_frame_t *slot = &s_parked[i];
+        if (slot->used) {
             continue;
         }
-        core_link_frame_header_t header;
-        memcpy(&header, header_buf, sizeof(header));
-        if (header.length > CORE_LINK_MAX_PAYLOAD) {
-            ESP_LOGW(TAG, "Frame payload too large: %u", header.length);
-            uart_flush_input(s_config.uart_port);
-            continue;
+        slot->used = true;
+        slot->type = frame->type;
+        slot->seq = frame->seq;
+        slot->length = frame->length;
+        memcpy(slot->payload, frame->payload, frame->length);
+        if (s_parked_count++ == 0) {
+            s_rx_gap_tick = xTaskGetTickCount();
         }
-        if (header.length > 0) {
-            int got = uart_read_bytes(s_config.uart_port, payload_buf, header.length, pdMS_TO_TICKS(50));
-            if (got != header.length) {
-                ESP_LOGW(TAG, "Failed to read payload (%d/%u)", got, header.length);
-                continue;
-            }
+        return true;
+    }
+    return false;
+}
+
+static void rx_seq_send_nak(uint16_t up_to)
+{
+    uint8_t payload[1 + CORE_LINK_NAK_MAX_SEQS * sizeof(uint16_t)];
+    uint8_t count = 0;
+    uint16_t seq = s_rx_expected_seq;
+    if (s_rx_nak_high != 0 && core_link_seq_diff(s_rx_nak_high, seq) >= 0) {
+        seq = core_link_seq_next(s_rx_nak_high);
+    }
+    while (core_link_seq_diff(up_to, seq) > 0 && count < CORE_LINK_NAK_MAX_SEQS) {
+        if (!rx_seq_is_parked(seq)) {
+            payload[1 + count * 2] = (uint8_t)(seq & 0xFF);
+            payload[2 + count * 2] = (uint8_t)(seq >> 8);
+            ++count;
         }
-        uint8_t rx_checksum = 0;
-        int chk = uart_read_bytes(s_config.uart_port, &rx_checksum, 1, pdMS_TO_TICKS(20));
-        if (chk != 1) {
-            ESP_LOGW(TAG, "Missing checksum byte");
-            continue;
+        s_rx_nak_high = seq;
+        seq = core_link_seq_next(seq);
+    }
+    if (count == 0) {
+        return;
+    }
+    payload[0] = count;
+    esp_err_t err = send_frame(CORE_LINK_MSG_NAK, payload, (uint16_t)(1 + count * 2));
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to send NAK: %s", esp_err_to_name(err));
+    } else {
+        core_link_stats_add(&s_stats, CORE_LINK_STAT_NAKS, 1);
+        ESP_LOGD(TAG, "NAK sent for %u frame(s) before seq %u", count, up_to);
+    }
+}
+
+static bool rx_seq_starts_baseline(const core_link_stream_frame_t *frame)
+{
+    if (core_link_msg_is_state_full(frame->type)) {
+        return true;
+    }
+    // The first fragment of a fragmented STATE_FULL rebases just like an unfragmented one.
+    return frame->type == CORE_LINK_MSG_STATE_FRAGMENT && frame->length >= CORE_LINK_FRAGMENT_HEADER_SIZE &&
+           core_link_msg_is_state_full(frame->payload[0]) && frame->payload[2] == 0;
+}
+
+static void handle_sequenced_frame(const core_link_stream_frame_t *frame)
+{
+    if (rx_seq_starts_baseline(frame)) {
+        if (s_rx_expected_seq != 0 && core_link_seq_diff(frame->seq, s_rx_expected_seq) < 0) {
+            return; // late retransmission of a baseline already superseded
         }
-        uint8_t computed = checksum_compute(header.type, header.length, payload_buf);
-        if (computed != rx_checksum) {
-            ESP_LOGW(TAG, "Checksum mismatch (got 0x%02X expected 0x%02X)", rx_checksum, computed);
-            continue;
+        rx_seq_accept(frame->type, frame->seq, frame->payload, frame->length);
+        rx_seq_drain();
+        return;
+    }
+
+    if (s_rx_expected_seq == 0) {
+        // The core sends its name table right before the baseline it resyncs with.
+        if (!s_full_resync_pending || frame->type == CORE_LINK_MSG_NAME_TABLE) {
+            dispatch_state_frame(frame->type, frame->payload, frame->length);
+        }
+        return;
+    }
+
+    int32_t gap = core_link_seq_diff(frame->seq, s_rx_expected_seq);
+    if (gap < 0) {
+        return; // duplicate of an applied delta
+    }
+    if (gap == 0) {
+        rx_seq_accept(frame->type, frame->seq, frame->payload, frame->length);
+        rx_seq_drain();
+        return;
+    }
+
+    // Keep the link alive and the watchdog quiet while the gap is repaired.
+    s_last_state_tick = xTaskGetTickCount();
+    if (gap > CORE_LINK_NAK_MAX_SEQS || rx_seq_is_parked(frame->seq)) {
+        if (gap > CORE_LINK_NAK_MAX_SEQS) {
+            rx_seq_fallback("gap too large");
+        }
+        return;
+    }
+    if (!rx_seq_park(frame)) {
+        rx_seq_fallback("reorder buffer full");
+        return;
+    }
+    rx_seq_send_nak(frame->seq);
+}
+
+static void rx_seq_check_gap(void)
+{
+    if (s_parked_count == 0) {
+        return;
+    }
+    if ((xTaskGetTickCount() - s_rx_gap_tick) >= CORE_LINK_SEQ_GAP_TIMEOUT_TICKS) {
+        rx_seq_fallback("retransmission timeout");
+    }
+}
+
+static void rx_task(void *arg)
+{
+    (void)arg;
+    core_link_stream_t stream;
+    core_link_stream_init(&stream, s_rx_storage, sizeof(s_rx_storage));
+    uint32_t reported_errors = 0;
+
+    while (true) {
+        uint8_t *window = NULL;
+        size_t room = core_link_stream_write_window(&stream, &window);
+
+        // The transport drains a whole burst per call; a partial frame or a sequence
+        // gap only waits for the stall timeout so the gap check keeps running.
+        uint32_t wait_ms = CORE_LINK_TRANSPORT_WAIT_FOREVER;
+        if (core_link_stream_buffered(&stream) > 0 || s_parked_count > 0) {
+            wait_ms = CORE_LINK_RX_STALL_MS;
+        }
+        int got = (room > 0) ? core_link_transport_read(&s_transport, window, room, wait_ms) : 0;
+        if (got > 0) {
+            core_link_stream_commit(&stream, (size_t)got);
+            core_link_stats_add(&s_stats, CORE_LINK_STAT_BYTES_RX, (uint32_t)got);
+        } else if (core_link_stream_buffered(&stream) > 0) {
+            // Partial frame stalled: discard its SOF and rescan the bytes behind it.
+            core_link_stream_skip_partial(&stream);
+        }
+
+        // Before any frame read in: the reply to a REQUEST_STATE may already be here.
+        rx_run_pending_resets();
+        core_link_stream_frame_t frame;
+        while (core_link_stream_next(&stream, &frame)) {
+            core_link_stats_add(&s_stats, CORE_LINK_STAT_FRAMES_RX, 1);
+            if (frame.seq != 0 && core_link_msg_is_state(frame.type)) {
+                handle_sequenced_frame(&frame);
+            } else {
+                dispatch_frame((core_link_msg_type_t)frame.type, frame.payload, frame.length);
+            }
+        }
+        rx_seq_check_gap();
+
+        uint32_t errors = stream.stats.checksum_errors + stream.stats.oversize_errors;
+        if (errors != reported_errors) {
+            ESP_LOGW(TAG, "Dropped %u corrupted frame header(s) (%u bytes skipped so far)",
+                     (unsigned)(errors - reported_errors), (unsigned)stream.stats.bytes_skipped);
+            core_link_stats_add(&s_stats, CORE_LINK_STAT_CHECKSUM_ERRORS, errors - reported_errors);
+            reported_errors = errors;
         }
-        dispatch_frame((core_link_msg_type_t)header.type, payload_buf, header.length);
     }
 }
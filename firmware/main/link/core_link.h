@@ -4,7 +4,14 @@
 
 #include "freertos/FreeRTOS.h"
 
+#include "link/core_link_clock.h"
+#include "link/core_link_history.h"
+#include "link/core_link_pending.h"
 #include "link/core_link_protocol.h"
+#include "link/core_link_stats.h"
+#include "link/core_link_subscription.h"
+#include "link/core_link_transport.h"
+#include "link/core_link_tx_queue.h"
 #include "core_link_protocol.h"
 #include "esp_err.h"
 
@@ -16,15 +23,19 @@ typedef void (*core_link_state_cb_t)(const core_link_state_frame_t *frame, void
 typedef void (*core_link_status_cb_t)(bool connected, void *ctx);
 typedef void (*core_link_command_ack_cb_t)(core_link_command_opcode_t opcode, esp_err_t status, uint8_t terrarium_count,
                                            void *ctx);
+/* `chunk->data` n'est valable que pendant l'appel, depuis la tâche de réception. */
+typedef void (*core_link_history_cb_t)(const core_link_history_chunk_t *chunk, void *ctx);
 
 typedef struct {
     int uart_port;
     int tx_gpio;
     int rx_gpio;
-    int baud_rate;
+    int baud_rate;      /* débit de démarrage et de repli */
+    int baud_rate_max;  /* plafond de la négociation (≤ baud_rate : débit fixe) */
     int task_stack_size;
     int task_priority;
     TickType_t handshake_timeout_ticks;
+    const core_link_transport_t *transport; /* NULL : UART décrite par les champs ci-dessus */
 } core_link_config_t;
 
 esp_err_t core_link_init(const core_link_config_t *config);
@@ -32,15 +43,76 @@ esp_err_t core_link_start(void);
 esp_err_t core_link_register_state_callback(core_link_state_cb_t cb, void *ctx);
 esp_err_t core_link_register_status_callback(core_link_status_cb_t cb, void *ctx);
 esp_err_t core_link_register_command_ack_callback(core_link_command_ack_cb_t cb, void *ctx);
+esp_err_t core_link_register_history_callback(core_link_history_cb_t cb, void *ctx);
 esp_err_t core_link_queue_touch_event(const core_link_touch_event_t *event);
 esp_err_t core_link_send_touch_event(const core_link_touch_event_t *event);
 esp_err_t core_link_send_display_ready(void);
 esp_err_t core_link_request_state_sync(void);
 esp_err_t core_link_send_command(core_link_command_opcode_t opcode, const char *argument);
+/**
+ * \brief Émet une commande suivie jusqu'à son acquittement.
+ *
+ * Plusieurs commandes peuvent être en vol (CORE_LINK_PENDING_MAX). `cb` est
+ * appelé une seule fois : à l'acquittement, avec ESP_ERR_TIMEOUT après
+ * `timeout_ticks` (0 : CONFIG_APP_CORE_LINK_COMMAND_TIMEOUT_MS) ou avec
+ * ESP_ERR_INVALID_STATE si le lien tombe. Le rappel global enregistré par
+ * core_link_register_command_ack_callback voit toujours passer l'acquittement.
+ * @param out_request_id Facultatif : identifiant attribué à la commande.
+ * @return ESP_ERR_NO_MEM si trop de commandes sont déjà en vol.
+ */
+esp_err_t core_link_send_command_async(core_link_command_opcode_t opcode, const char *argument,
+                                       TickType_t timeout_ticks, core_link_pending_cb_t cb, void *ctx,
+                                       uint16_t *out_request_id);
 esp_err_t core_link_request_profile_reload(const char *base_path);
+esp_err_t core_link_request_profile_reload_async(const char *base_path, core_link_pending_cb_t cb, void *ctx);
+/** Demande au cœur de nourrir le terrarium `terrarium_id` (CORE_LINK_CMD_FEED_TERRARIUM). */
+esp_err_t core_link_request_feeding(uint8_t terrarium_id);
+/**
+ * \brief Demande au cœur un morceau de l'historique d'un terrarium (HISTORY_REQUEST).
+ *
+ * Le cœur répond par un seul HISTORY_CHUNK, remis au callback de
+ * core_link_register_history_callback. Pour remonter dans le temps, redemander
+ * avec `before_epoch = end_epoch - count · durée du palier` tant que
+ * CORE_LINK_HISTORY_FLAG_MORE est levé : une requête à la fois laisse passer
+ * les trames d'état.
+ * @return ESP_ERR_NOT_SUPPORTED si le cœur n'annonce pas CORE_LINK_CAP_EXT_HISTORY.
+ */
+esp_err_t core_link_request_history(const core_link_history_request_t *request);
+/**
+ * \brief Déclare au cœur ce que la vue courante affiche (message SUBSCRIBE).
+ *
+ * L'abonnement est retenu et renvoyé après chaque poignée de main ; un cœur
+ * sans CORE_LINK_CAP_EXT_SUBSCRIBE continue de tout envoyer. L'intervalle est
+ * borné à CONFIG_APP_CORE_LINK_STATE_TIMEOUT_MS / 4 pour ne pas réveiller le
+ * chien de garde d'état.
+ */
+esp_err_t core_link_subscribe(const core_link_subscription_t *subscription);
 esp_err_t core_link_wait_for_handshake(TickType_t ticks_to_wait);
 bool core_link_is_ready(void);
 uint8_t core_link_get_peer_version(void);
+/** Profondeur de la file d'émission et latence d'envoi par classe de priorité. */
+esp_err_t core_link_get_tx_stats(core_link_tx_stats_t *out_stats);
+/** Compteurs de télémétrie de l'afficheur (trames, octets, erreurs, RTT). */
+esp_err_t core_link_get_link_stats(core_link_stats_snapshot_t *out_stats);
+/**
+ * \brief Derniers compteurs publiés par le cœur (LINK_STATS).
+ * @param out_age_ms Facultatif : âge de la publication en millisecondes.
+ * @return ESP_ERR_NOT_FOUND tant que le cœur n'a rien publié.
+ */
+esp_err_t core_link_get_peer_link_stats(core_link_stats_snapshot_t *out_stats, uint32_t *out_age_ms);
+/**
+ * \brief Décalage et dérive estimés de l'horloge du cœur (PING/PONG horodatés).
+ * @return ESP_ERR_NOT_FOUND tant qu'aucun PONG horodaté n'est revenu.
+ */
+esp_err_t core_link_get_clock_estimate(core_link_clock_estimate_t *out_estimate);
+/**
+ * \brief Enregistre qu'une valeur échantillonnée à `sample_us` (horloge de
+ * l'afficheur, voir core_link_state_frame_t) vient d'atteindre l'écran.
+ *
+ * À appeler à la fin du flush LVGL qui l'affiche ; alimente l'histogramme de
+ * latence des compteurs de l'afficheur. Sans effet si `sample_us` vaut 0.
+ */
+void core_link_record_display_latency(int64_t sample_us);
 
 #ifdef __cplusplus
 }
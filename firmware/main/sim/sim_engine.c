@@ -28,6 +28,7 @@ static size_t s_terrarium_count = 0;
 static float s_time_accumulator = 0.0f;
 static double s_simulated_seconds = 0.0;
 static bool s_remote_active = false;
+static int64_t s_remote_sample_us = 0;
 static bool s_watchdog_fault_latched = false;
 static portMUX_TYPE s_state_lock = portMUX_INITIALIZER_UNLOCKED;
 static const reptile_profile_t *s_default_profiles[MAX_TERRARIUMS];
@@ -35,6 +36,8 @@ static reptile_profile_t s_remote_profiles[MAX_TERRARIUMS];
 static reptile_profile_t s_manual_profiles[MAX_TERRARIUMS];
 static char s_remote_scientific_names[MAX_TERRARIUMS][CORE_LINK_NAME_MAX_LEN + 1];
 static char s_remote_common_names[MAX_TERRARIUMS][CORE_LINK_NAME_MAX_LEN + 1];
+static uint8_t s_remote_name_ids[MAX_TERRARIUMS][2];
+static uint16_t s_remote_name_generation = 0;
 static char s_manual_scientific_names[MAX_TERRARIUMS][CORE_LINK_NAME_MAX_LEN + 1];
 static char s_manual_common_names[MAX_TERRARIUMS][CORE_LINK_NAME_MAX_LEN + 1];
 static sim_runtime_state_t s_runtime[MAX_TERRARIUMS];
@@ -55,6 +58,7 @@ void sim_engine_init(void)
     memset(s_manual_profiles, 0, sizeof(s_manual_profiles));
     memset(s_remote_scientific_names, 0, sizeof(s_remote_scientific_names));
     memset(s_remote_common_names, 0, sizeof(s_remote_common_names));
+    memset(s_remote_name_ids, CORE_LINK_NAME_ID_NONE, sizeof(s_remote_name_ids));
     memset(s_manual_scientific_names, 0, sizeof(s_manual_scientific_names));
     memset(s_manual_common_names, 0, sizeof(s_manual_common_names));
     s_remote_active = false;
@@ -232,6 +236,14 @@ void sim_engine_step(float delta_seconds)
     portEXIT_CRITICAL(&s_state_lock);
 }
 
+int64_t sim_engine_get_remote_sample_us(void)
+{
+    portENTER_CRITICAL(&s_state_lock);
+    int64_t sample_us = s_remote_active ? s_remote_sample_us : 0;
+    portEXIT_CRITICAL(&s_state_lock);
+    return sample_us;
+}
+
 size_t sim_engine_get_count(void)
 {
     size_t count = 0;
@@ -340,14 +352,25 @@ esp_err_t sim_engine_apply_remote_snapshot(const core_link_state_frame_t *frame)
     }
 
     portENTER_CRITICAL(&s_state_lock);
+    if (frame->name_generation != s_remote_name_generation) {
+        memset(s_remote_name_ids, CORE_LINK_NAME_ID_NONE, sizeof(s_remote_name_ids));
+        s_remote_name_generation = frame->name_generation;
+    }
     s_terrarium_count = count;
     for (size_t i = 0; i < count; ++i) {
         sim_engine_reset_manual_profile(i);
         const core_link_terrarium_snapshot_t *snap = &frame->terrariums[i];
-        strncpy(s_remote_scientific_names[i], snap->scientific_name, CORE_LINK_NAME_MAX_LEN);
-        s_remote_scientific_names[i][CORE_LINK_NAME_MAX_LEN] = '\0';
-        strncpy(s_remote_common_names[i], snap->common_name, CORE_LINK_NAME_MAX_LEN);
-        s_remote_common_names[i][CORE_LINK_NAME_MAX_LEN] = '\0';
+        // Interned names only change along with their ID: steady-state frames skip the copy.
+        if (snap->name_ids[0] == CORE_LINK_NAME_ID_NONE || snap->name_ids[0] != s_remote_name_ids[i][0]) {
+            strncpy(s_remote_scientific_names[i], snap->scientific_name, CORE_LINK_NAME_MAX_LEN);
+            s_remote_scientific_names[i][CORE_LINK_NAME_MAX_LEN] = '\0';
+            s_remote_name_ids[i][0] = snap->name_ids[0];
+        }
+        if (snap->name_ids[1] == CORE_LINK_NAME_ID_NONE || snap->name_ids[1] != s_remote_name_ids[i][1]) {
+            strncpy(s_remote_common_names[i], snap->common_name, CORE_LINK_NAME_MAX_LEN);
+            s_remote_common_names[i][CORE_LINK_NAME_MAX_LEN] = '\0';
+            s_remote_name_ids[i][1] = snap->name_ids[1];
+        }
 
         s_remote_profiles[i].scientific_name = s_remote_scientific_names[i];
         s_remote_profiles[i].common_name = s_remote_common_names[i];
@@ -380,10 +403,12 @@ esp_err_t sim_engine_apply_remote_snapshot(const core_link_state_frame_t *frame)
         memset(&s_remote_profiles[i], 0, sizeof(s_remote_profiles[i]));
         memset(s_remote_scientific_names[i], 0, sizeof(s_remote_scientific_names[i]));
         memset(s_remote_common_names[i], 0, sizeof(s_remote_common_names[i]));
+        memset(s_remote_name_ids[i], CORE_LINK_NAME_ID_NONE, sizeof(s_remote_name_ids[i]));
         memset(&s_terrariums[i], 0, sizeof(s_terrariums[i]));
     }
 
     s_remote_active = count > 0;
+    s_remote_sample_us = frame->sample_us;
     if (frame->epoch_seconds != 0U) {
         s_simulated_seconds = frame->epoch_seconds;
         s_time_accumulator = (float)s_simulated_seconds;
@@ -412,6 +437,7 @@ void sim_engine_hint_remote_count(size_t count)
                 memset(&s_remote_profiles[i], 0, sizeof(s_remote_profiles[i]));
                 memset(s_remote_scientific_names[i], 0, sizeof(s_remote_scientific_names[i]));
                 memset(s_remote_common_names[i], 0, sizeof(s_remote_common_names[i]));
+                memset(s_remote_name_ids[i], CORE_LINK_NAME_ID_NONE, sizeof(s_remote_name_ids[i]));
                 memset(&s_terrariums[i], 0, sizeof(s_terrariums[i]));
             }
         } else {
@@ -420,6 +446,7 @@ void sim_engine_hint_remote_count(size_t count)
                 memset(&s_remote_profiles[i], 0, sizeof(s_remote_profiles[i]));
                 memset(s_remote_scientific_names[i], 0, sizeof(s_remote_scientific_names[i]));
                 memset(s_remote_common_names[i], 0, sizeof(s_remote_common_names[i]));
+                memset(s_remote_name_ids[i], CORE_LINK_NAME_ID_NONE, sizeof(s_remote_name_ids[i]));
                 memset(&s_terrariums[i], 0, sizeof(s_terrariums[i]));
                 s_terrariums[i].profile = NULL;
             }
@@ -445,6 +472,7 @@ const char *sim_engine_handle_link_status(bool connected)
         memset(s_remote_profiles, 0, sizeof(s_remote_profiles));
         memset(s_remote_scientific_names, 0, sizeof(s_remote_scientific_names));
         memset(s_remote_common_names, 0, sizeof(s_remote_common_names));
+        memset(s_remote_name_ids, CORE_LINK_NAME_ID_NONE, sizeof(s_remote_name_ids));
         sim_engine_load_defaults_locked();
         alert = i18n_manager_get_string("alert_link_lost");
         s_watchdog_fault_latched = true;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "esp_err.h"
 #include "link/core_link_protocol.h"
@@ -28,6 +29,8 @@ esp_err_t sim_engine_restore_slot(size_t index, const sim_saved_slot_t *state);
 esp_err_t sim_engine_apply_remote_snapshot(const core_link_state_frame_t *frame);
 const char *sim_engine_handle_link_status(bool connected);
 void sim_engine_hint_remote_count(size_t count);
+/** Instant d'échantillonnage (horloge locale, µs) du dernier instantané du cœur ; 0 hors mode distant. */
+int64_t sim_engine_get_remote_sample_us(void);
 
 #ifdef __cplusplus
 }
@@ -1,10 +1,13 @@
 #include "ui/ui_about.h"
 
+#include <string.h>
+
 #include "bsp/waveshare_7b.h"
 #include "esp_app_desc.h"
 #include "esp_err.h"
 #include "esp_log.h"
 #include "i18n/i18n_manager.h"
+#include "link/core_link.h"
 #include "ui/ui_theme.h"
 
 static const char *TAG = "ui_about";
@@ -16,8 +19,22 @@ static lv_obj_t *s_legal = NULL;
 static lv_obj_t *s_version = NULL;
 static lv_obj_t *s_build = NULL;
 static lv_obj_t *s_battery = NULL;
+static lv_obj_t *s_link_display = NULL;
+static lv_obj_t *s_link_core = NULL;
+static lv_obj_t *s_link_clock = NULL;
+
+// Two successive snapshots of one link end; rates are computed between them.
+typedef struct {
+    core_link_stats_snapshot_t prev;
+    core_link_stats_snapshot_t last;
+    bool valid;
+} ui_about_link_sample_t;
+
+static ui_about_link_sample_t s_display_sample;
+static ui_about_link_sample_t s_core_sample;
 
 static void ui_about_update_version(void);
+static void ui_about_update_link(void);
 
 void ui_about_create(lv_obj_t *parent)
 {
@@ -50,6 +67,21 @@ void ui_about_create(lv_obj_t *parent)
     s_battery = lv_label_create(s_root);
     ui_theme_apply_label_style(s_battery, true);
 
+    s_link_display = lv_label_create(s_root);
+    ui_theme_apply_label_style(s_link_display, false);
+    lv_label_set_long_mode(s_link_display, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(s_link_display, LV_PCT(100));
+
+    s_link_core = lv_label_create(s_root);
+    ui_theme_apply_label_style(s_link_core, false);
+    lv_label_set_long_mode(s_link_core, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(s_link_core, LV_PCT(100));
+
+    s_link_clock = lv_label_create(s_root);
+    ui_theme_apply_label_style(s_link_clock, false);
+    lv_label_set_long_mode(s_link_clock, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(s_link_clock, LV_PCT(100));
+
     s_legal = lv_label_create(s_root);
     ui_theme_apply_label_style(s_legal, false);
     lv_label_set_long_mode(s_legal, LV_LABEL_LONG_WRAP);
@@ -108,11 +140,90 @@ static void ui_about_update_version(void)
     }
 }
 
+static void link_sample_push(ui_about_link_sample_t *sample, const core_link_stats_snapshot_t *snapshot)
+{
+    if (!sample->valid) {
+        // First sample: rates are averaged since boot.
+        memset(&sample->prev, 0, sizeof(sample->prev));
+        sample->last = *snapshot;
+        sample->valid = true;
+    } else if (snapshot->uptime_ms != sample->last.uptime_ms) {
+        sample->prev = sample->last;
+        sample->last = *snapshot;
+    }
+}
+
+static void format_link_label(lv_obj_t *label, const char *side, const ui_about_link_sample_t *sample)
+{
+    const char *fmt = i18n_manager_get_string("about_link_fmt");
+    if (!fmt || !side) {
+        return;
+    }
+    const core_link_stats_snapshot_t *cur = &sample->last;
+    uint32_t frames = core_link_stats_rate(&sample->prev, cur, CORE_LINK_STAT_FRAMES_TX) +
+                      core_link_stats_rate(&sample->prev, cur, CORE_LINK_STAT_FRAMES_RX);
+    char buffer[320];
+    snprintf(buffer, sizeof(buffer), fmt, side, (unsigned)frames,
+             (unsigned)core_link_stats_rate(&sample->prev, cur, CORE_LINK_STAT_BYTES_TX),
+             (unsigned)core_link_stats_rate(&sample->prev, cur, CORE_LINK_STAT_BYTES_RX),
+             (unsigned)cur->counters[CORE_LINK_STAT_CHECKSUM_ERRORS], (unsigned)cur->counters[CORE_LINK_STAT_STATE_FULL],
+             (unsigned)cur->counters[CORE_LINK_STAT_STATE_DELTA], (unsigned)cur->counters[CORE_LINK_STAT_RESYNCS],
+             core_link_stats_rtt_percentile_us(cur, 50) / 1000.0f, core_link_stats_rtt_percentile_us(cur, 95) / 1000.0f,
+             (unsigned)(cur->counters[CORE_LINK_STAT_BAUD_RATE] / 1000U), (unsigned)cur->counters[CORE_LINK_STAT_BAUD_SWITCHES]);
+    lv_label_set_text(label, buffer);
+}
+
+static void format_clock_label(const core_link_stats_snapshot_t *display)
+{
+    core_link_clock_estimate_t clock;
+    if (core_link_get_clock_estimate(&clock) != ESP_OK) {
+        const char *waiting = i18n_manager_get_string("about_link_clock_waiting");
+        if (waiting) {
+            lv_label_set_text(s_link_clock, waiting);
+        }
+        return;
+    }
+    const char *fmt = i18n_manager_get_string("about_link_clock_fmt");
+    if (!fmt) {
+        return;
+    }
+    char buffer[192];
+    snprintf(buffer, sizeof(buffer), fmt, clock.offset_us / 1000.0f, clock.min_rtt_us / 2000.0f,
+             clock.drift_ppb / 1000.0f, core_link_stats_latency_percentile_us(display, 50) / 1000.0f,
+             core_link_stats_latency_percentile_us(display, 95) / 1000.0f);
+    lv_label_set_text(s_link_clock, buffer);
+}
+
+static void ui_about_update_link(void)
+{
+    if (!s_link_display || !s_link_core || !s_link_clock) {
+        return;
+    }
+
+    core_link_stats_snapshot_t snapshot;
+    if (core_link_get_link_stats(&snapshot) == ESP_OK) {
+        link_sample_push(&s_display_sample, &snapshot);
+        format_link_label(s_link_display, i18n_manager_get_string("about_link_display"), &s_display_sample);
+        format_clock_label(&snapshot);
+    }
+
+    if (core_link_get_peer_link_stats(&snapshot, NULL) == ESP_OK) {
+        link_sample_push(&s_core_sample, &snapshot);
+        format_link_label(s_link_core, i18n_manager_get_string("about_link_core"), &s_core_sample);
+    } else {
+        const char *waiting = i18n_manager_get_string("about_link_core_waiting");
+        if (waiting) {
+            lv_label_set_text(s_link_core, waiting);
+        }
+    }
+}
+
 void ui_about_update(void)
 {
     if (!s_battery) {
         return;
     }
+    ui_about_update_link();
     uint16_t mv = 0;
     esp_err_t err = bsp_battery_read_mv(&mv);
     if (err != ESP_OK) {
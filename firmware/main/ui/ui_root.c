@@ -2,6 +2,7 @@
 
 #include "esp_log.h"
 #include "i18n/i18n_manager.h"
+#include "link/core_link.h"
 #include "sdkconfig.h"
 #include "lvgl.h"
 #include "lvgl_port.h"
@@ -16,6 +17,11 @@
 
 static const char *TAG = "ui_root";
 #define UI_ROOT_ALERT_TEXT_MAX 192
+// Views without live terrarium widgets only need the link heartbeat.
+#define UI_ROOT_BACKGROUND_INTERVAL_MS 1000
+#define UI_ROOT_SLOTS_FIELDS                                                                                    \
+    (CORE_LINK_DELTA_FIELD_COMMON_NAME | CORE_LINK_DELTA_FIELD_TEMP_DAY | CORE_LINK_DELTA_FIELD_HUMIDITY_DAY | \
+     CORE_LINK_DELTA_FIELD_HYDRATION | CORE_LINK_DELTA_FIELD_STRESS)
 
 static lv_obj_t *s_screen_boot = NULL;
 static lv_obj_t *s_screen_disclaimer = NULL;
@@ -37,6 +43,10 @@ static lv_obj_t *s_disclaimer_button_label = NULL;
 static ui_root_view_t s_active_view = UI_ROOT_VIEW_BOOT_SPLASH;
 static bool s_alert_visible = false;
 static char s_alert_message[UI_ROOT_ALERT_TEXT_MAX] = "";
+// Sample time of the core values pushed into the widgets, waiting for their flush.
+// Both accesses run with the LVGL lock held.
+static int64_t s_shown_sample_us = 0;
+static int64_t s_pending_sample_us = 0;
 
 static void ui_root_build_boot_screen(void);
 static void ui_root_build_disclaimer_screen(void);
@@ -45,6 +55,8 @@ static void ui_root_on_disclaimer_accepted(lv_event_t *event);
 static void ui_root_on_tab_changed(lv_event_t *event);
 static void ui_root_apply_tab_names(void);
 static const char *ui_root_get_default_alert(void);
+static void ui_root_on_flush_done(void *ctx);
+static void ui_root_subscribe_view(ui_root_view_t view);
 
 esp_err_t ui_root_init(void)
 {
@@ -61,6 +73,7 @@ esp_err_t ui_root_init(void)
     ui_root_build_disclaimer_screen();
     ui_root_build_main_screen();
     ui_root_refresh_language();
+    lvgl_port_set_flush_done_cb(ui_root_on_flush_done, NULL);
 
     s_active_view = UI_ROOT_VIEW_BOOT_SPLASH;
     if (s_screen_boot) {
@@ -162,9 +175,24 @@ void ui_root_update(void)
     ui_dashboard_refresh(terrarium_count, first_state);
     ui_slots_refresh();
     ui_about_update();
+    int64_t sample_us = sim_engine_get_remote_sample_us();
+    if (sample_us != s_shown_sample_us) {
+        // Newer core values just reached the widgets: the next flush puts them on screen.
+        s_shown_sample_us = sample_us;
+        s_pending_sample_us = sample_us;
+    }
     lvgl_port_unlock();
 }
 
+static void ui_root_on_flush_done(void *ctx)
+{
+    (void)ctx;
+    if (s_pending_sample_us != 0) {
+        core_link_record_display_latency(s_pending_sample_us);
+        s_pending_sample_us = 0;
+    }
+}
+
 esp_err_t ui_root_set_view(ui_root_view_t view)
 {
     lv_obj_t *target = NULL;
@@ -214,6 +242,7 @@ esp_err_t ui_root_set_view(ui_root_view_t view)
 
     lv_screen_load(target);
     s_active_view = view;
+    ui_root_subscribe_view(view);
     lvgl_port_unlock();
     return ESP_OK;
 }
@@ -389,6 +418,30 @@ static void ui_root_on_tab_changed(lv_event_t *event)
     default:
         break;
     }
+    ui_root_subscribe_view(s_active_view);
+}
+
+static void ui_root_subscribe_view(ui_root_view_t view)
+{
+    core_link_subscription_t sub;
+    switch (view) {
+    case UI_ROOT_VIEW_SLOTS:
+        core_link_subscription_none(&sub, UI_ROOT_SLOTS_FIELDS, UI_ROOT_BACKGROUND_INTERVAL_MS);
+        sub.all_terrariums = true;
+        break;
+    case UI_ROOT_VIEW_DOCS:
+    case UI_ROOT_VIEW_SETTINGS:
+    case UI_ROOT_VIEW_ABOUT:
+        core_link_subscription_none(&sub, 0, UI_ROOT_BACKGROUND_INTERVAL_MS);
+        break;
+    default:
+        core_link_subscription_all(&sub);
+        break;
+    }
+    esp_err_t err = core_link_subscribe(&sub);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Subscription update failed: %s", esp_err_to_name(err));
+    }
 }
 
 static void ui_root_apply_tab_names(void)
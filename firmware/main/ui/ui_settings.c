@@ -76,7 +76,7 @@ static updates_manifest_info_t s_update_info;
 static ui_settings_update_status_t s_update_state = UI_SETTINGS_UPDATE_STATUS_IDLE;
 static esp_err_t s_update_last_error = ESP_OK;
 static bool s_profiles_status_initialized = false;
-static bool s_profiles_pending = false;
+static uint8_t s_profiles_pending = 0; // reloads still awaiting their ACK
 static esp_err_t s_profiles_last_status = ESP_OK;
 static uint8_t s_profiles_last_count = 0;
 
@@ -567,6 +567,14 @@ static void ui_settings_updates_apply_cb(lv_event_t *event)
     ui_settings_updates_refresh_last_flash();
 }
 
+static void ui_settings_profiles_reload_done(core_link_command_opcode_t opcode, int status, uint8_t terrarium_count,
+                                             void *ctx)
+{
+    (void)opcode;
+    (void)ctx;
+    ui_settings_on_profiles_reload((esp_err_t)status, terrarium_count);
+}
+
 static void ui_settings_profiles_reload_cb(lv_event_t *event)
 {
     (void)event;
@@ -574,9 +582,11 @@ static void ui_settings_profiles_reload_cb(lv_event_t *event)
         return;
     }
 
-    esp_err_t err = core_link_request_profile_reload(NULL);
+    // Each request completes on its own (ACK, timeout or link loss), so
+    // repeated taps no longer get confused with an earlier reload's answer.
+    esp_err_t err = core_link_request_profile_reload_async(NULL, ui_settings_profiles_reload_done, NULL);
     if (err == ESP_OK) {
-        s_profiles_pending = true;
+        s_profiles_pending++;
         s_profiles_status_initialized = false;
         const char *text = i18n_manager_get_string("settings_profiles_reload_request");
         if (!text) {
@@ -584,23 +594,26 @@ static void ui_settings_profiles_reload_cb(lv_event_t *event)
         }
         lv_label_set_text(s_profiles_status_label, text);
     } else {
-        s_profiles_pending = false;
-        s_profiles_status_initialized = true;
-        s_profiles_last_status = err;
-        s_profiles_last_count = 0;
-        ui_settings_update_profiles_status();
+        // Keep the "requested" text while earlier reloads are still in flight.
+        if (s_profiles_pending == 0) {
+            s_profiles_status_initialized = true;
+            s_profiles_last_status = err;
+            s_profiles_last_count = 0;
+            ui_settings_update_profiles_status();
+        }
         ESP_LOGW(TAG, "Profile reload request failed: %s", esp_err_to_name(err));
     }
 }
 
 void ui_settings_on_profiles_reload(esp_err_t status, uint8_t terrarium_count)
 {
-    s_profiles_pending = false;
+    lvgl_port_lock();
+    if (s_profiles_pending > 0) {
+        s_profiles_pending--;
+    }
     s_profiles_status_initialized = true;
     s_profiles_last_status = status;
     s_profiles_last_count = terrarium_count;
-
-    lvgl_port_lock();
     ui_settings_update_profiles_status();
     lvgl_port_unlock();
 }
@@ -754,7 +767,7 @@ static void ui_settings_update_profiles_status(void)
         return;
     }
 
-    if (s_profiles_pending) {
+    if (s_profiles_pending > 0) {
         const char *text = i18n_manager_get_string("settings_profiles_reload_request");
         if (!text) {
             text = "Reload requested...";